@@ -0,0 +1,93 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#include "TestUtil.h"
+
+#include <engine/Util/ETHAllocationTracker.h>
+
+#include <Platform/Thread.h>
+#include <Platform/MonotonicClock.h>
+
+#include <vector>
+
+// Checks that ZeroAllocationScope only counts the allocations of the thread that opened it,
+// while another thread keeps allocating in the background the way the logger, audio and
+// save threads do. Built with ETH_ALLOCATION_TRACKING
+
+namespace {
+
+volatile long g_stop = 0;
+
+void AllocateInBackground(void*)
+{
+	while (!Platform::AtomicLoad(&g_stop))
+	{
+		std::vector<int> v(16);
+		v[0] = 1;
+	}
+}
+
+// waits without allocating until the background thread has allocated at least 'count' more times
+void WaitForOtherThreadAllocations(const boost::uint64_t count)
+{
+	const boost::uint64_t start = ETHAllocationTracker::GetNumAllocations();
+	const boost::uint64_t startUS = Platform::MonotonicClock::GetCurrentTimeUS();
+	while (ETHAllocationTracker::GetNumAllocations() - start < count
+		&& Platform::MonotonicClock::GetCurrentTimeUS() - startUS < 5000000)
+	{
+		Platform::SleepMicroseconds(100);
+	}
+}
+
+void TestScopeIgnoresOtherThreads()
+{
+	Platform::Thread thread;
+	ETH_CHECK(thread.Start(AllocateInBackground, 0));
+	{
+		const boost::uint64_t totalBefore = ETHAllocationTracker::GetNumAllocations();
+		ETHAllocationTracker::ZeroAllocationScope scope("idle main thread");
+		WaitForOtherThreadAllocations(1000);
+		ETH_CHECK(ETHAllocationTracker::GetNumAllocations() - totalBefore >= 1000);
+		ETH_CHECK(scope.GetNumAllocations() == 0);
+	}
+	Platform::AtomicStore(&g_stop, 1);
+	thread.Join();
+}
+
+void TestScopeCountsOwnAllocations()
+{
+	ETHAllocationTracker::ZeroAllocationScope scope("allocating main thread");
+	std::vector<int>* v = new std::vector<int>(4);
+	ETH_CHECK(scope.GetNumAllocations() == 2);
+	delete v;
+	ETH_CHECK(scope.GetNumAllocations() == 2);
+}
+
+} // namespace
+
+int main()
+{
+	ETH_CHECK(ETHAllocationTracker::IsEnabled());
+	TestScopeIgnoresOtherThreads();
+	TestScopeCountsOwnAllocations();
+	return TestUtil::Report("AllocationTrackerTest");
+}
@@ -0,0 +1,297 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#include "TestUtil.h"
+
+#include <device_mixer.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/time.h>
+
+#include <vector>
+
+// Drives audiere's MixerDevice by hand, through a null output that calls read()
+// directly. Checks the mix against the integer math of the original mixer, that
+// each playback fires exactly one stop event, and times 256 voices
+
+using namespace audiere;
+
+namespace {
+
+const int RATE = 44100;
+
+class NullMixerDevice : public MixerDevice
+{
+public:
+	NullMixerDevice() : MixerDevice(RATE) {}
+	void ADR_CALL update() {}
+	const char* ADR_CALL getName() { return "nullmixer"; }
+	int Mix(const int frameCount, s16* samples) { return read(frameCount, samples); }
+};
+
+class StopCounter : public RefImplementation<StopCallback>
+{
+public:
+	StopCounter() : m_called(0), m_ended(0) {}
+
+	void ADR_CALL streamStopped(StopEvent* event)
+	{
+		SYNCHRONIZED(&m_mutex);
+		if (event->getReason() == StopEvent::STOP_CALLED)
+			++m_called;
+		else
+			++m_ended;
+	}
+
+	// events are delivered by the device's event thread
+	void WaitAndRead(int& called, int& ended)
+	{
+		usleep(50000);
+		SYNCHRONIZED(&m_mutex);
+		called = m_called;
+		ended = m_ended;
+		m_called = m_ended = 0;
+	}
+
+private:
+	Mutex m_mutex;
+	int m_called;
+	int m_ended;
+};
+
+double Now()
+{
+	timeval time;
+	gettimeofday(&time, 0);
+	return time.tv_sec + time.tv_usec * 1e-6;
+}
+
+// the original mixer scaled each stream with 8-bit volume and pan, truncating
+int ScaleSample(const int sample, const float volume, const float pan, const bool right)
+{
+	const int intVolume = int(volume * 255.0f + 0.5f);
+	const int intPan = int(pan * 255.0f);
+	int channelVolume;
+	if (intPan < 0)
+		channelVolume = right ? (255 + intPan) : 255;
+	else
+		channelVolume = right ? 255 : (255 - intPan);
+	return sample * (channelVolume * intVolume) / 255 / 255;
+}
+
+void CheckMixMatchesReference(NullMixerDevice* device)
+{
+	const int FRAMES = 4000;
+	const int VOICES = 8;
+	static s16 samples[VOICES][FRAMES];
+	float volumes[VOICES], pans[VOICES];
+	std::vector<OutputStreamPtr> streams;
+	for (int v = 0; v < VOICES; v++)
+	{
+		for (int f = 0; f < FRAMES; f++)
+			samples[v][f] = s16(((f * 7919 + v * 104729) % 65536) - 32768);
+		volumes[v] = (v == 0) ? 1.0f : (v * 0.13f);
+		pans[v] = (v % 3 == 0) ? 0.0f : ((v % 3 == 1) ? -0.37f : 0.81f);
+
+		OutputStreamPtr stream = device->openBuffer(samples[v], FRAMES, 1, RATE, SF_S16);
+		stream->setVolume(volumes[v]);
+		stream->setPan(pans[v]);
+		stream->play();
+		streams.push_back(stream);
+	}
+
+	std::vector<s16> out(FRAMES * 2);
+	ETH_CHECK(device->Mix(FRAMES, &out[0]) == FRAMES);
+
+	int mismatches = 0, clamped = 0;
+	for (int f = 0; f < FRAMES; f++)
+	{
+		for (int c = 0; c < 2; c++)
+		{
+			int expected = 0;
+			for (int v = 0; v < VOICES; v++)
+				expected += ScaleSample(samples[v][f], volumes[v], pans[v], c == 1);
+			if (expected < -32768 || expected > 32767)
+			{
+				expected = (expected < 0) ? -32768 : 32767;
+				++clamped;
+			}
+			if (out[f * 2 + c] != expected)
+				++mismatches;
+		}
+	}
+	ETH_CHECK(mismatches == 0);
+	ETH_CHECK(clamped > 0);
+	if (mismatches > 0)
+		printf("AudiereMixerTest: %d of %d samples differ from the reference mix\n", mismatches, FRAMES * 2);
+
+	for (int v = 0; v < VOICES; v++)
+		streams[v]->stop();
+	device->Mix(16, &out[0]);
+}
+
+void CheckStopEvents(NullMixerDevice* device, StopCounter* counter)
+{
+	const int FRAMES = 2048;
+	static s16 samples[FRAMES];
+	for (int f = 0; f < FRAMES; f++)
+		samples[f] = s16(1000 * sin(f * 0.05));
+
+	std::vector<s16> out(FRAMES * 2 * 2);
+	int called, ended;
+	counter->WaitAndRead(called, ended);
+
+	OutputStreamPtr stream = device->openBuffer(samples, FRAMES, 1, RATE, SF_S16);
+
+	// stopped while playing
+	stream->play();
+	device->Mix(256, &out[0]);
+	stream->stop();
+	ETH_CHECK(!stream->isPlaying());
+	device->Mix(256, &out[0]);
+	counter->WaitAndRead(called, ended);
+	ETH_CHECK(called == 1 && ended == 0);
+
+	// stopping a stopped stream fires nothing
+	stream->stop();
+	device->Mix(256, &out[0]);
+	counter->WaitAndRead(called, ended);
+	ETH_CHECK(called == 0 && ended == 0);
+
+	// played through to the end, noticed by the read after the last frame
+	stream->reset();
+	stream->play();
+	device->Mix(FRAMES * 2, &out[0]);
+	device->Mix(256, &out[0]);
+	ETH_CHECK(!stream->isPlaying());
+	counter->WaitAndRead(called, ended);
+	ETH_CHECK(called == 0 && ended == 1);
+
+	// stop() lands when the source has nothing left: only one of the two events
+	stream->reset();
+	stream->play();
+	device->Mix(FRAMES, &out[0]);
+	stream->stop();
+	device->Mix(FRAMES, &out[0]);
+	counter->WaitAndRead(called, ended);
+	ETH_CHECK(called + ended == 1);
+
+	// ...and stop() after the end fires nothing else
+	stream->reset();
+	stream->play();
+	device->Mix(FRAMES * 2, &out[0]);
+	device->Mix(256, &out[0]);
+	stream->stop();
+	device->Mix(FRAMES, &out[0]);
+	counter->WaitAndRead(called, ended);
+	ETH_CHECK(called == 0 && ended == 1);
+
+	// a stream released with its stop still queued must not reach the event thread
+	stream->reset();
+	stream->play();
+	device->Mix(256, &out[0]);
+	stream->stop();
+	stream = 0;
+	device->Mix(256, &out[0]);
+	counter->WaitAndRead(called, ended);
+	ETH_CHECK(called == 0 && ended == 0);
+}
+
+const int BENCHMARK_VOICES = 256;
+OutputStream* g_benchmarkStreams[BENCHMARK_VOICES];
+volatile bool g_benchmarkDone = false;
+double g_worstSetTime = 0.0;
+
+// changes every voice's volume and pan once per game frame
+void* GameThread(void*)
+{
+	for (int frame = 0; !g_benchmarkDone; frame++)
+	{
+		for (int v = 0; v < BENCHMARK_VOICES; v++)
+		{
+			const double start = Now();
+			g_benchmarkStreams[v]->setVolume(((frame + v) % 100) / 100.0f);
+			g_benchmarkStreams[v]->setPan((((frame + v) % 200) - 100) / 100.0f);
+			const double elapsed = Now() - start;
+			if (elapsed > g_worstSetTime)
+				g_worstSetTime = elapsed;
+		}
+		usleep(16000);
+	}
+	return 0;
+}
+
+void RunBenchmark(NullMixerDevice* device)
+{
+	// one second of a decaying tone, a quarter of the voices at half the device rate
+	static s16 samples[RATE];
+	for (int f = 0; f < RATE; f++)
+		samples[f] = s16(8000 * sin(f * 0.05) * (1.0 - f / double(RATE)));
+
+	for (int v = 0; v < BENCHMARK_VOICES; v++)
+	{
+		g_benchmarkStreams[v] = device->openBuffer(samples, RATE, 1, (v % 4 == 0) ? RATE / 2 : RATE, SF_S16);
+		g_benchmarkStreams[v]->ref();
+		g_benchmarkStreams[v]->setRepeat(true);
+		g_benchmarkStreams[v]->play();
+	}
+
+	pthread_t thread;
+	pthread_create(&thread, 0, GameThread, 0);
+
+	const int BLOCK = 1024, BLOCKS = 500;
+	std::vector<s16> out(BLOCK * 2);
+	const double start = Now();
+	for (int b = 0; b < BLOCKS; b++)
+		device->Mix(BLOCK, &out[0]);
+	const double elapsed = Now() - start;
+
+	g_benchmarkDone = true;
+	pthread_join(thread, 0);
+
+	printf("AudiereMixerTest: %d voices, %.3f ms per %d-frame block (%.1fx real time), worst setVolume/setPan pair %.3f ms\n",
+		BENCHMARK_VOICES, elapsed / BLOCKS * 1000.0, BLOCK, (BLOCKS * BLOCK / double(RATE)) / elapsed, g_worstSetTime * 1000.0);
+
+	for (int v = 0; v < BENCHMARK_VOICES; v++)
+		g_benchmarkStreams[v]->unref();
+}
+
+} // namespace
+
+int main()
+{
+	RefPtr<NullMixerDevice> device(new NullMixerDevice);
+	RefPtr<StopCounter> counter(new StopCounter);
+	device->registerCallback(counter.get());
+
+	CheckMixMatchesReference(device.get());
+	CheckStopEvents(device.get(), counter.get());
+
+	device->unregisterCallback(counter.get());
+	RunBenchmark(device.get());
+
+	return TestUtil::Report("AudiereMixerTest");
+}
@@ -0,0 +1,190 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#include "TestUtil.h"
+
+#include <Audio/Audiere/AudiereVoicePool.h>
+#include <device_null.h>
+
+#include <stdio.h>
+
+// Runs the sound effect voice pool on audiere's null device, which plays streams
+// silently in real time. Checks the voice limit, which voice is stolen once the
+// pool is full, and that finished voices stop being counted
+
+using namespace audiere;
+
+namespace gs2d {
+
+class AudiereVoicePoolTest
+{
+public:
+	static float GetVoiceVolume(const AudiereVoicePool& pool, const std::size_t index)
+	{
+		return pool.m_voices[index].volume;
+	}
+
+	static bool IsVoicePlaying(const AudiereVoicePool& pool, const std::size_t index)
+	{
+		return pool.m_voices[index].output->isPlaying();
+	}
+
+	static float GetVoicePan(const AudiereVoicePool& pool, const std::size_t index)
+	{
+		return pool.m_voices[index].output->getPan();
+	}
+
+	static std::size_t GetNumVoices(const AudiereVoicePool& pool)
+	{
+		return pool.m_voices.size();
+	}
+};
+
+} // namespace gs2d
+
+using gs2d::AudiereVoicePool;
+using gs2d::AudiereVoicePoolTest;
+
+namespace {
+
+const int RATE = 22050;
+
+// returns the volumes of the voices that are playing, in pool order
+std::vector<float> GetPlayingVolumes(const AudiereVoicePool& pool)
+{
+	std::vector<float> volumes;
+	for (std::size_t t = 0; t < AudiereVoicePoolTest::GetNumVoices(pool); t++)
+	{
+		if (AudiereVoicePoolTest::IsVoicePlaying(pool, t))
+			volumes.push_back(AudiereVoicePoolTest::GetVoiceVolume(pool, t));
+	}
+	return volumes;
+}
+
+bool HasVolume(const std::vector<float>& volumes, const float volume)
+{
+	for (std::size_t t = 0; t < volumes.size(); t++)
+	{
+		if (volumes[t] == volume)
+			return true;
+	}
+	return false;
+}
+
+void TestLimitAndStealing(const AudioDevicePtr& device, const SampleBufferPtr& buffer)
+{
+	AudiereVoicePool pool(device, buffer);
+	ETH_CHECK(pool.GetMaxVoices() == gs2d::AudioSample::DEFAULT_MAX_VOICES);
+
+	pool.SetMaxVoices(3);
+	ETH_CHECK(pool.Play(0.5f, 0.0f, 1.0f));
+	ETH_CHECK(pool.Play(0.2f, -1.0f, 1.0f));
+	ETH_CHECK(pool.Play(0.8f, 1.0f, 1.5f));
+	ETH_CHECK(pool.GetNumActiveVoices() == 3);
+
+	// the quietest voice makes room
+	ETH_CHECK(pool.Play(0.9f, 0.0f, 1.0f));
+	std::vector<float> volumes = GetPlayingVolumes(pool);
+	ETH_CHECK(pool.GetNumActiveVoices() == 3);
+	ETH_CHECK(AudiereVoicePoolTest::GetNumVoices(pool) == 3);
+	ETH_CHECK(!HasVolume(volumes, 0.2f));
+	ETH_CHECK(HasVolume(volumes, 0.5f) && HasVolume(volumes, 0.8f) && HasVolume(volumes, 0.9f));
+
+	// lowering the limit cuts voices right away
+	pool.SetMaxVoices(1);
+	ETH_CHECK(pool.GetNumActiveVoices() == 1);
+	ETH_CHECK(AudiereVoicePoolTest::GetNumVoices(pool) == 1);
+	ETH_CHECK(GetPlayingVolumes(pool) == std::vector<float>(1, 0.9f));
+
+	pool.SetMaxVoices(0);
+	ETH_CHECK(!pool.Play(1.0f, 0.0f, 1.0f));
+	ETH_CHECK(pool.GetNumActiveVoices() == 0);
+}
+
+void TestEquallyLoudVoices(const AudioDevicePtr& device, const SampleBufferPtr& buffer)
+{
+	AudiereVoicePool pool(device, buffer);
+	pool.SetMaxVoices(2);
+
+	// the oldest of two equally quiet voices makes room, told apart by their pan
+	ETH_CHECK(pool.Play(0.3f, -0.5f, 1.0f));
+	ETH_CHECK(pool.Play(0.3f, 0.5f, 1.0f));
+	ETH_CHECK(pool.Play(0.7f, 0.0f, 1.0f));
+	ETH_CHECK(pool.GetNumActiveVoices() == 2);
+
+	bool newerVoiceKept = false;
+	for (std::size_t t = 0; t < AudiereVoicePoolTest::GetNumVoices(pool); t++)
+	{
+		ETH_CHECK(AudiereVoicePoolTest::GetVoicePan(pool, t) != -0.5f);
+		if (AudiereVoicePoolTest::GetVoicePan(pool, t) == 0.5f)
+			newerVoiceKept = true;
+	}
+	ETH_CHECK(newerVoiceKept);
+}
+
+void TestFinishedVoices(const AudioDevicePtr& device, const SampleBufferPtr& buffer)
+{
+	AudiereVoicePool pool(device, buffer);
+	for (int t = 0; t < 4; t++)
+	{
+		ETH_CHECK(pool.Play(1.0f, 0.0f, 1.0f));
+	}
+	ETH_CHECK(pool.GetNumActiveVoices() == 4);
+
+	// each update sleeps 50 ms and the effect is 100 ms long
+	for (int t = 0; t < 10 && pool.GetNumActiveVoices() > 0; t++)
+	{
+		device->update();
+	}
+	ETH_CHECK(pool.GetNumActiveVoices() == 0);
+
+	// finished voices are reused instead of growing the pool
+	ETH_CHECK(pool.Play(1.0f, 0.0f, 1.0f));
+	ETH_CHECK(pool.GetNumActiveVoices() == 1);
+	ETH_CHECK(AudiereVoicePoolTest::GetNumVoices(pool) == 4);
+
+	pool.StopAll();
+	ETH_CHECK(pool.GetNumActiveVoices() == 0);
+}
+
+} // namespace
+
+int main()
+{
+	AudioDevicePtr device = NullAudioDevice::create(ParameterList(""));
+	ETH_CHECK(device);
+	if (!device)
+		return TestUtil::Report("AudiereVoicePoolTest");
+
+	std::vector<s16> samples(RATE / 10);
+	for (std::size_t t = 0; t < samples.size(); t++)
+	{
+		samples[t] = static_cast<s16>((t % 100) * 300 - 15000);
+	}
+	SampleBufferPtr buffer = CreateSampleBuffer(&samples[0], static_cast<int>(samples.size()), 1, RATE, SF_S16);
+	ETH_CHECK(buffer);
+
+	TestLimitAndStealing(device, buffer);
+	TestEquallyLoudVoices(device, buffer);
+	TestFinishedVoices(device, buffer);
+	return TestUtil::Report("AudiereVoicePoolTest");
+}
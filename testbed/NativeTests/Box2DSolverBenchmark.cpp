@@ -0,0 +1,170 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#include "TestUtil.h"
+
+#include <Box2D/Box2D.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/time.h>
+
+// Steps the same headless scene with the island solver on 1, 2, 4 and as many threads
+// as the host has, and prints the step and solve times with their speedup over one
+// thread. Only the island solve runs in parallel, so the step speedup is lower. Every
+// thread count must leave the scene in exactly the same state. Scene size and step
+// count can be passed as arguments: Box2DSolverBenchmark [stacks] [height] [steps]
+
+namespace {
+
+struct SCENE_RESULT
+{
+	double totalMS;
+	double solveMS;
+	unsigned long long stateHash;
+	int awakeBodies;
+};
+
+double GetTimeMS()
+{
+	timeval tv;
+	gettimeofday(&tv, 0);
+	return tv.tv_sec * 1000.0 + tv.tv_usec / 1000.0;
+}
+
+unsigned long long HashFloat(const unsigned long long hash, const float value)
+{
+	unsigned int bits;
+	memcpy(&bits, &value, sizeof(bits));
+	return (hash ^ bits) * 1099511628211ULL;
+}
+
+// separate box stacks on one ground, every fourth one next to a jointed chain hanging from a
+// static anchor, so that the world splits into many islands of different sizes
+void BuildScene(b2World& world, const int stacks, const int height)
+{
+	b2BodyDef groundDef;
+	b2Body* ground = world.CreateBody(&groundDef);
+	b2EdgeShape edge;
+	edge.Set(b2Vec2(-10.0f, 0.0f), b2Vec2(stacks * 3.0f + 10.0f, 0.0f));
+	ground->CreateFixture(&edge, 0.0f);
+
+	b2PolygonShape box;
+	box.SetAsBox(0.5f, 0.5f);
+	b2PolygonShape link;
+	link.SetAsBox(0.5f, 0.1f);
+	for (int s = 0; s < stacks; s++)
+	{
+		const float x = s * 3.0f;
+		for (int h = 0; h < height; h++)
+		{
+			b2BodyDef bodyDef;
+			bodyDef.type = b2_dynamicBody;
+			bodyDef.position.Set(x + (h % 2) * 0.05f, 0.5f + h * 1.01f);
+			world.CreateBody(&bodyDef)->CreateFixture(&box, 1.0f);
+		}
+
+		if (s % 4 != 0)
+			continue;
+
+		b2BodyDef anchorDef;
+		anchorDef.position.Set(x + 1.5f, 30.0f);
+		b2Body* previous = world.CreateBody(&anchorDef);
+		for (int k = 0; k < 5; k++)
+		{
+			b2BodyDef bodyDef;
+			bodyDef.type = b2_dynamicBody;
+			bodyDef.position.Set(x + 2.5f + k, 30.0f);
+			b2Body* body = world.CreateBody(&bodyDef);
+			body->CreateFixture(&link, 1.0f);
+
+			b2RevoluteJointDef jointDef;
+			jointDef.Initialize(previous, body, b2Vec2(x + 2.0f + k, 30.0f));
+			world.CreateJoint(&jointDef);
+			previous = body;
+		}
+	}
+}
+
+SCENE_RESULT RunScene(const int threads, const int stacks, const int height, const int steps)
+{
+	b2World world(b2Vec2(0.0f,-10.0f), true);
+	world.SetSolverThreadCount(threads);
+	BuildScene(world, stacks, height);
+
+	SCENE_RESULT result;
+	result.solveMS = 0.0;
+	const double start = GetTimeMS();
+	for (int t = 0; t < steps; t++)
+	{
+		world.Step(1.0f / 60.0f, 8, 3);
+		result.solveMS += world.GetProfile().solve;
+	}
+	result.totalMS = GetTimeMS() - start;
+
+	result.stateHash = 1469598103934665603ULL;
+	result.awakeBodies = 0;
+	for (b2Body* body = world.GetBodyList(); body; body = body->GetNext())
+	{
+		result.stateHash = HashFloat(result.stateHash, body->GetPosition().x);
+		result.stateHash = HashFloat(result.stateHash, body->GetPosition().y);
+		result.stateHash = HashFloat(result.stateHash, body->GetAngle());
+		result.stateHash = HashFloat(result.stateHash, body->GetLinearVelocity().x);
+		result.stateHash = HashFloat(result.stateHash, body->GetLinearVelocity().y);
+		if (body->IsAwake())
+			++result.awakeBodies;
+	}
+	return result;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+	const int stacks = (argc > 1) ? atoi(argv[1]) : 200;
+	const int height = (argc > 2) ? atoi(argv[2]) : 10;
+	const int steps  = (argc > 3) ? atoi(argv[3]) : 200;
+
+	const long cores = sysconf(_SC_NPROCESSORS_ONLN);
+	int threadCounts[] = { 1, 2, 4, static_cast<int>(cores) };
+	const int numThreadCounts = (cores > 4) ? 4 : 3;
+
+	printf("Box2DSolverBenchmark: %d stacks of %d boxes, %d steps, %ld cores\n", stacks, height, steps, cores);
+	SCENE_RESULT single;
+	for (int t = 0; t < numThreadCounts; t++)
+	{
+		const SCENE_RESULT result = RunScene(threadCounts[t], stacks, height, steps);
+		if (t == 0)
+			single = result;
+
+		printf("%2d threads: step %8.1f ms (%.2fx), solve %8.1f ms (%.2fx), %d awake bodies, state %016llx\n",
+			threadCounts[t], result.totalMS, single.totalMS / result.totalMS,
+			result.solveMS, single.solveMS / result.solveMS, result.awakeBodies, result.stateHash);
+
+		// islands are solved independently, so the thread count must not change a single bit
+		ETH_CHECK(result.stateHash == single.stateHash);
+		ETH_CHECK(result.awakeBodies == single.awakeBodies);
+	}
+	return TestUtil::Report("Box2DSolverBenchmark");
+}
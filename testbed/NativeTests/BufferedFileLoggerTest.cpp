@@ -0,0 +1,265 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#include "TestUtil.h"
+
+#include <Platform/BufferedFileLogger.h>
+#include <Platform/MonotonicClock.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Checks that messages logged from several threads at once all reach the file in order,
+// the per-key rate limit and its summaries, the level filter, the background flush, and
+// that a process that crashes, aborts or terminates still writes what it logged
+
+using Platform::BufferedFileLogger;
+using Platform::Logger;
+
+namespace Platform {
+
+gs2d::str_type::string FileLogger::GetLogDirectory()
+{
+	return "build/";
+}
+
+} // namespace Platform
+
+namespace {
+
+const int NUM_PRODUCERS = 4;
+const int MESSAGES_PER_PRODUCER = 2500;
+
+// skips the header FileLogger writes when it creates the file
+std::vector<std::string> ReadMessages(const std::string& fileName)
+{
+	std::vector<std::string> lines;
+	std::ifstream ifs(fileName.c_str());
+	std::string line;
+	std::getline(ifs, line);
+	while (std::getline(ifs, line))
+		lines.push_back(line);
+	return lines;
+}
+
+bool Contains(const std::vector<std::string>& lines, const std::string& line)
+{
+	for (std::size_t t = 0; t < lines.size(); t++)
+	{
+		if (lines[t] == line)
+			return true;
+	}
+	return false;
+}
+
+struct PRODUCER
+{
+	const BufferedFileLogger* logger;
+	int index;
+};
+
+void Produce(void* arg)
+{
+	const PRODUCER* producer = static_cast<const PRODUCER*>(arg);
+	for (int t = 0; t < MESSAGES_PER_PRODUCER; t++)
+	{
+		std::stringstream ss;
+		ss << producer->index << " " << t;
+		producer->logger->Log(ss.str(), Logger::INFO);
+	}
+}
+
+void TestConcurrentProducers()
+{
+	const std::string fileName = "build/producers.log.txt";
+	{
+		// a small ring makes the producers drain it themselves every now and then
+		BufferedFileLogger logger(fileName, 64);
+		logger.SetRateLimit(NUM_PRODUCERS * MESSAGES_PER_PRODUCER, 1000);
+
+		PRODUCER producers[NUM_PRODUCERS];
+		Platform::Thread threads[NUM_PRODUCERS];
+		for (int t = 0; t < NUM_PRODUCERS; t++)
+		{
+			producers[t].logger = &logger;
+			producers[t].index = t;
+			ETH_CHECK(threads[t].Start(Produce, &producers[t]));
+		}
+		for (int t = 0; t < NUM_PRODUCERS; t++)
+		{
+			threads[t].Join();
+		}
+		ETH_CHECK(logger.Flush());
+		ETH_CHECK(logger.GetNumDiscardedMessages() == 0);
+	}
+
+	const std::vector<std::string> lines = ReadMessages(fileName);
+	ETH_CHECK(lines.size() == static_cast<std::size_t>(NUM_PRODUCERS * MESSAGES_PER_PRODUCER));
+
+	// every producer's messages come out complete and in the order it logged them
+	int next[NUM_PRODUCERS] = { 0 };
+	bool ordered = true;
+	for (std::size_t t = 0; t < lines.size(); t++)
+	{
+		int producer = -1, index = -1;
+		std::stringstream ss(lines[t]);
+		ss >> producer >> index;
+		if (producer < 0 || producer >= NUM_PRODUCERS || index != next[producer]++)
+			ordered = false;
+	}
+	ETH_CHECK(ordered);
+	for (int t = 0; t < NUM_PRODUCERS; t++)
+	{
+		ETH_CHECK(next[t] == MESSAGES_PER_PRODUCER);
+	}
+}
+
+void TestRateLimit()
+{
+	const std::string fileName = "build/ratelimit.log.txt";
+	BufferedFileLogger logger(fileName);
+	logger.SetRateLimit(3, 100);
+	ETH_CHECK(logger.GetRateLimit() == 3 && logger.GetRateWindow() == 100);
+
+	// the numbers are masked, so all of these share one key
+	for (int t = 0; t < 10; t++)
+	{
+		std::stringstream ss;
+		ss << "entity " << t << " not found";
+		logger.Log(ss.str(), Logger::INFO);
+	}
+	logger.Log("scene loaded", Logger::INFO);
+	logger.Log("first", Logger::INFO, "explicit key");
+	logger.Log("second", Logger::INFO, "explicit key");
+	logger.Flush();
+
+	std::vector<std::string> lines = ReadMessages(fileName);
+	ETH_CHECK(lines.size() == 6);
+	ETH_CHECK(Contains(lines, "entity 0 not found") && Contains(lines, "entity 2 not found"));
+	ETH_CHECK(!Contains(lines, "entity 3 not found"));
+	ETH_CHECK(Contains(lines, "scene loaded") && Contains(lines, "first") && Contains(lines, "second"));
+	ETH_CHECK(logger.GetNumDiscardedMessages() == 7);
+
+	// the summary is written once the window is over, and the key may log again
+	Platform::SleepMicroseconds(150000);
+	logger.Log("entity 11 not found", Logger::INFO);
+	logger.Flush();
+	lines = ReadMessages(fileName);
+	ETH_CHECK(lines.size() == 8);
+	ETH_CHECK(Contains(lines, "(7 more messages like \"entity # not found\" were suppressed)"));
+	ETH_CHECK(!lines.empty() && lines.back() == "entity 11 not found");
+}
+
+void TestLevelAndBackgroundFlush()
+{
+	const std::string fileName = "build/level.log.txt";
+	BufferedFileLogger logger(fileName);
+	logger.SetLevel(Logger::WARNING);
+	ETH_CHECK(logger.GetLevel() == Logger::WARNING);
+
+	logger.Log("filtered out", Logger::INFO);
+	logger.Log("kept", Logger::WARNING);
+	ETH_CHECK(logger.GetNumDiscardedMessages() == 1);
+
+	// nobody calls Flush: the background thread writes it
+	const boost::uint64_t start = Platform::MonotonicClock::GetCurrentTimeUS();
+	while (ReadMessages(fileName).empty() && Platform::MonotonicClock::GetCurrentTimeUS() - start < 2000000)
+		Platform::SleepMicroseconds(10000);
+
+	const std::vector<std::string> lines = ReadMessages(fileName);
+	ETH_CHECK(lines.size() == 1 && lines[0] == "kept");
+}
+
+enum CRASH
+{
+	SEGMENTATION_FAULT,
+	ABORT,
+	UNCAUGHT_EXCEPTION
+};
+
+void Crash(const CRASH crash)
+{
+	switch (crash)
+	{
+	case SEGMENTATION_FAULT:
+		*static_cast<volatile int*>(0) = 1;
+		break;
+	case ABORT:
+		abort();
+		break;
+	case UNCAUGHT_EXCEPTION:
+		throw 1;
+	}
+}
+
+void TestCrashFlush(const CRASH crash, const int expectedSignal)
+{
+	std::stringstream fileNameStream;
+	fileNameStream << "build/crash" << crash << ".log.txt";
+	const std::string fileName = fileNameStream.str();
+
+	const pid_t child = fork();
+	if (child == 0)
+	{
+		// messages still in the ring when the process goes down
+		BufferedFileLogger logger(fileName);
+		for (int t = 0; t < 5; t++)
+		{
+			std::stringstream ss;
+			ss << "message " << t << " before the crash";
+			logger.Log(ss.str(), Logger::INFO);
+		}
+		Crash(crash);
+		_exit(0);
+	}
+
+	int status = 0;
+	ETH_CHECK(waitpid(child, &status, 0) == child);
+	ETH_CHECK(WIFSIGNALED(status) && WTERMSIG(status) == expectedSignal);
+
+	const std::vector<std::string> lines = ReadMessages(fileName);
+	ETH_CHECK(lines.size() == 5);
+	ETH_CHECK(Contains(lines, "message 0 before the crash") && Contains(lines, "message 4 before the crash"));
+}
+
+} // namespace
+
+int main()
+{
+	// the crashing children are forked before this process starts any thread of its own
+	TestCrashFlush(SEGMENTATION_FAULT, SIGSEGV);
+	TestCrashFlush(ABORT, SIGABRT);
+	TestCrashFlush(UNCAUGHT_EXCEPTION, SIGABRT);
+
+	TestConcurrentProducers();
+	TestRateLimit();
+	TestLevelAndBackgroundFlush();
+	return TestUtil::Report("BufferedFileLoggerTest");
+}
@@ -0,0 +1,125 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#include <engine/Entity/ETHEntity.h>
+#include <engine/Entity/ETHRenderEntity.h>
+#include <engine/Resource/ETHResourceProvider.h>
+#include <engine/Shader/ETHShaderManager.h>
+#include <engine/Util/ETHASUtil.h>
+
+// the particle code references entity and resource code that would drag in the whole
+// engine. The headless tests never get there (their managers have no provider and
+// nothing is saved or drawn), so these only have to link
+
+float ETHEntity::ComputeDepth(const float height, const float maxHeight, const float minHeight)
+{
+	GS2D_UNUSED_ARGUMENT(height);
+	GS2D_UNUSED_ARGUMENT(maxHeight);
+	GS2D_UNUSED_ARGUMENT(minHeight);
+	return 0.0f;
+}
+
+ETH_BOOL ETHEntityProperties::ReadBooleanPropertyFromXmlElement(TiXmlElement*, const str_type::string&, const ETH_BOOL defaultValue)
+{
+	return defaultValue;
+}
+
+void ETHEntityProperties::ReadVector2PropertyFromXmlElement(TiXmlElement*, const str_type::string&, Vector2&) {}
+void ETHEntityProperties::ReadVector2iPropertyFromXmlElement(TiXmlElement*, const str_type::string&, Vector2i&) {}
+void ETHEntityProperties::ReadVector3PropertyFromXmlElement(TiXmlElement*, const str_type::string&, Vector3&) {}
+void ETHEntityProperties::ReadColorPropertyFromXmlElement(TiXmlElement*, const str_type::string&, Vector4&) {}
+void ETHEntityProperties::ReadColorPropertyFromXmlElement(TiXmlElement*, const str_type::string&, Vector3&) {}
+void ETHEntityProperties::SetVector2PropertyToXmlElement(TiXmlElement*, const str_type::string&, const Vector2&) {}
+void ETHEntityProperties::SetVector2iPropertyToXmlElement(TiXmlElement*, const str_type::string&, const Vector2i&) {}
+void ETHEntityProperties::SetVector3PropertyToXmlElement(TiXmlElement*, const str_type::string&, const Vector3&) {}
+void ETHEntityProperties::SetColorPropertyToXmlElement(TiXmlElement*, const str_type::string&, const Vector3&) {}
+void ETHEntityProperties::SetColorPropertyToXmlElement(TiXmlElement*, const str_type::string&, const Vector4&) {}
+
+SpritePtr ETHGraphicResourceManager::GetPointer(VideoPtr, const str_type::string&, const str_type::string&,
+	const str_type::string&, const bool, const bool)
+{
+	return SpritePtr();
+}
+
+void ETHResourceProvider::Log(const str_type::string& str, const Platform::Logger::TYPE& type)
+{
+	GS2D_UNUSED_ARGUMENT(type);
+	printf("%s\n", str.c_str());
+}
+
+ETHGraphicResourceManagerPtr ETHResourceProvider::GetGraphicResourceManager()
+{
+	return ETHGraphicResourceManagerPtr();
+}
+
+const VideoPtr& ETHResourceProvider::GetVideo()
+{
+	static const VideoPtr video;
+	return video;
+}
+
+const Platform::FileManagerPtr& ETHResourceProvider::GetFileManager()
+{
+	static const Platform::FileManagerPtr fileManager;
+	return fileManager;
+}
+
+Platform::FileIOHubPtr ETHResourceProvider::GetFileIOHub()
+{
+	return Platform::FileIOHubPtr();
+}
+
+// the shadow test only calls the math in ETHRenderEntity.Shadow.cpp and
+// ETHProjShadowBatch::ProjectShadows; the rest of the batch and ETHLight link against these
+
+bool ETHRenderEntity::ComputeProjShadow(const float, const float, const ETHSceneProperties&, const ETHLight&,
+	ETHSpriteEntity*, const bool, const bool, const float, const Vector3&, PROJ_SHADOW&) const
+{
+	return false;
+}
+
+SpritePtr ETHSpriteEntity::GetSprite()
+{
+	return SpritePtr();
+}
+
+boost::shared_ptr<ETHShaderManager> ETHResourceProvider::GetShaderManager()
+{
+	return boost::shared_ptr<ETHShaderManager>();
+}
+
+SpritePtr ETHShaderManager::GetProjShadow()
+{
+	return SpritePtr();
+}
+
+bool ETHGlobal::ToBool(const ETH_BOOL b)
+{
+	return (b != 0);
+}
+
+Vector2 ETHGlobal::ToScreenPos(const Vector3& v3Pos, const Vector2& zAxisDirection)
+{
+	GS2D_UNUSED_ARGUMENT(v3Pos);
+	GS2D_UNUSED_ARGUMENT(zAxisDirection);
+	return Vector2();
+}
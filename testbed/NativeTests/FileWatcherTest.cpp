@@ -0,0 +1,180 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#include "TestUtil.h"
+
+#include <Platform/FileWatcher.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include <vector>
+
+// Exercises Platform::FileWatcher against a scratch directory. The Makefile builds it
+// twice: with inotify, and with GS2D_NO_INOTIFY to cover the polling fallback
+
+using Platform::FileWatcher;
+
+namespace {
+
+void WriteFile(const std::string& path, const char* content)
+{
+	FILE* file = fopen(path.c_str(), "wb");
+	if (file)
+	{
+		fputs(content, file);
+		fclose(file);
+	}
+}
+
+// gives the kernel time to queue the events and forces the next poll to run
+void Settle(FileWatcher& watcher)
+{
+	usleep(20000);
+	watcher.SetPollInterval(0);
+	watcher.Update();
+}
+
+} // namespace
+
+int main()
+{
+	char directoryTemplate[] = "/tmp/eth_filewatcher_XXXXXX";
+	if (!mkdtemp(directoryTemplate))
+	{
+		printf("FileWatcherTest: couldn't create a scratch directory\n");
+		return 1;
+	}
+	const std::string dir = std::string(directoryTemplate) + "/";
+
+	WriteFile(dir + "a.as", "a");
+	WriteFile(dir + "b.as", "b");
+	mkdir((dir + "sub").c_str(), 0755);
+
+	FileWatcher watcher;
+	#ifdef GS2D_USE_INOTIFY
+		ETH_CHECK(watcher.IsUsingNativeNotifications());
+	#else
+		ETH_CHECK(!watcher.IsUsingNativeNotifications());
+	#endif
+
+	const FileWatcher::WATCH_ID a = watcher.AddFile(dir + "a.as");
+	const FileWatcher::WATCH_ID b = watcher.AddFile(dir + "b.as");
+	const FileWatcher::WATCH_ID c = watcher.AddFile(dir + "c.as");
+	const FileWatcher::WATCH_ID sub = watcher.AddDirectory(dir + "sub");
+
+	std::vector<FileWatcher::WATCH_ID> includes;
+	for (int t = 0; t < 300; t++)
+	{
+		char name[64];
+		sprintf(name, "include%d.as", t);
+		WriteFile(dir + name, "x");
+		includes.push_back(watcher.AddFile(dir + name));
+	}
+
+	// nothing happened yet
+	std::vector<FileWatcher::WATCH_ID> changes;
+	Settle(watcher);
+	watcher.ConsumeChanges(changes);
+	ETH_CHECK(changes.empty());
+
+	// modify: many writes coalesce into a single notification
+	for (int t = 0; t < 10; t++)
+	{
+		WriteFile(dir + "a.as", (t % 2) ? "aaa" : "aa");
+	}
+	Settle(watcher);
+	changes.clear();
+	watcher.ConsumeChanges(changes);
+	ETH_CHECK(changes.size() == 1 && changes[0] == a);
+	ETH_CHECK(!watcher.ConsumeChange(a));
+
+	// create: the watched file didn't exist when it was added
+	WriteFile(dir + "c.as", "c");
+	Settle(watcher);
+	ETH_CHECK(watcher.ConsumeChange(c));
+	ETH_CHECK(!watcher.ConsumeChange(b));
+
+	// rename: editors that save to a temporary file and move it over the original
+	WriteFile(dir + "b.tmp", "bbbb");
+	rename((dir + "b.tmp").c_str(), (dir + "b.as").c_str());
+	Settle(watcher);
+	ETH_CHECK(watcher.ConsumeChange(b));
+	ETH_CHECK(!watcher.ConsumeChange(a));
+
+	// rename away from the watched name reports the watch too
+	rename((dir + "b.as").c_str(), (dir + "b.old").c_str());
+	Settle(watcher);
+	ETH_CHECK(watcher.ConsumeChange(b));
+
+	// directory watches report new and modified entries
+	WriteFile(dir + "sub/x", "1");
+	Settle(watcher);
+	ETH_CHECK(watcher.ConsumeChange(sub));
+	WriteFile(dir + "sub/x", "22");
+	Settle(watcher);
+	ETH_CHECK(watcher.ConsumeChange(sub));
+	ETH_CHECK(!watcher.ConsumeChange(a));
+
+	// only the touched watch is reported among many
+	WriteFile(dir + "include150.as", "yy");
+	Settle(watcher);
+	changes.clear();
+	watcher.ConsumeChanges(changes);
+	ETH_CHECK(changes.size() == 1 && changes[0] == includes[150]);
+
+	// delete
+	unlink((dir + "a.as").c_str());
+	Settle(watcher);
+	ETH_CHECK(watcher.ConsumeChange(a));
+
+	// a removed watch stops reporting
+	watcher.RemoveWatch(c);
+	WriteFile(dir + "c.as", "cccc");
+	Settle(watcher);
+	ETH_CHECK(!watcher.ConsumeChange(c));
+
+	// removing a watched directory drops its native watch, and polling takes over
+	unlink((dir + "sub/x").c_str());
+	rmdir((dir + "sub").c_str());
+	Settle(watcher);
+	ETH_CHECK(watcher.ConsumeChange(sub));
+	mkdir((dir + "sub").c_str(), 0755);
+	WriteFile(dir + "sub/y", "1");
+	usleep(20000);
+	Settle(watcher);
+	ETH_CHECK(watcher.ConsumeChange(sub));
+
+	ETH_CHECK(watcher.GetNumWatches() == 303);
+
+	const std::string command = "rm -rf " + dir;
+	if (system(command.c_str()) != 0)
+		printf("FileWatcherTest: couldn't remove %s\n", dir.c_str());
+
+	#ifdef GS2D_USE_INOTIFY
+		return TestUtil::Report("FileWatcherTest (inotify)");
+	#else
+		return TestUtil::Report("FileWatcherTest (polling)");
+	#endif
+}
@@ -0,0 +1,131 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#include "TestUtil.h"
+
+#include <Math/GameMath.h>
+
+#include <stdio.h>
+#include <math.h>
+
+#include <vector>
+
+// Checks the SSE/NEON paths of the math kernels against plain scalar code. The kernels
+// keep multiplies and adds separate, so any difference beyond rounding noise is a bug
+
+using namespace gs2d::math;
+
+namespace {
+
+const float TOLERANCE = 1e-5f;
+
+float RelativeError(const float a, const float b)
+{
+	return fabsf(a - b) / Max(1.0f, fabsf(b));
+}
+
+float Noise(unsigned int& seed)
+{
+	seed = seed * 1664525u + 1013904223u;
+	return static_cast<float>(seed >> 8) / static_cast<float>(1 << 24) * 200.0f - 100.0f;
+}
+
+void CheckMatrixMultiply()
+{
+	unsigned int seed = 7;
+	float maxError = 0.0f;
+	for (int n = 0; n < 100; n++)
+	{
+		Matrix4x4 a, b;
+		for (int i = 0; i < 4; i++)
+		{
+			for (int j = 0; j < 4; j++)
+			{
+				a.m[i][j] = Noise(seed);
+				b.m[i][j] = Noise(seed);
+			}
+		}
+
+		const Matrix4x4 r = Multiply(a, b);
+		for (int i = 0; i < 4; i++)
+		{
+			for (int j = 0; j < 4; j++)
+			{
+				float expected = 0.0f;
+				for (int k = 0; k < 4; k++)
+				{
+					expected += a.m[i][k] * b.m[k][j];
+				}
+				maxError = Max(maxError, RelativeError(r.m[i][j], expected));
+			}
+		}
+	}
+	printf("Matrix4x4 multiply: max relative error %g\n", maxError);
+	ETH_CHECK(maxError <= TOLERANCE);
+}
+
+// odd counts exercise the scalar tail after the two-at-a-time loop
+void CheckRotateAndScale(const std::size_t count, const bool inPlace)
+{
+	unsigned int seed = static_cast<unsigned int>(count) + 1;
+	std::vector<Vector2> in(count), out(count);
+	for (std::size_t t = 0; t < count; t++)
+	{
+		in[t] = Vector2(Noise(seed), Noise(seed));
+	}
+
+	const float angle = 0.7f;
+	const Vector2 scale(1.5f,-0.25f), translate(30.0f,-12.0f);
+	if (inPlace)
+	{
+		out = in;
+		RotateAndScale(&out[0], &out[0], count, angle, scale, translate);
+	}
+	else
+	{
+		RotateAndScale(&in[0], &out[0], count, angle, scale, translate);
+	}
+
+	float maxError = 0.0f;
+	const float c = cosf(angle), s = sinf(angle);
+	for (std::size_t t = 0; t < count; t++)
+	{
+		const Vector2 p(in[t].x * scale.x, in[t].y * scale.y);
+		maxError = Max(maxError, RelativeError(out[t].x, p.x * c - p.y * s + translate.x));
+		maxError = Max(maxError, RelativeError(out[t].y, p.x * s + p.y * c + translate.y));
+	}
+	printf("RotateAndScale, %u positions%s: max relative error %g\n",
+		static_cast<unsigned int>(count), inPlace ? " in place" : "", maxError);
+	ETH_CHECK(maxError <= TOLERANCE);
+}
+
+} // namespace
+
+int main()
+{
+	CheckMatrixMultiply();
+	CheckRotateAndScale(1, false);
+	CheckRotateAndScale(4, false);
+	CheckRotateAndScale(37, false);
+	CheckRotateAndScale(37, true);
+	return TestUtil::Report("GameMathTest");
+}
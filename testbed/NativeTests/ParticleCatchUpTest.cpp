@@ -0,0 +1,170 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#include "TestUtil.h"
+
+#include <engine/Particles/ETHParticleManager.h>
+
+#include <stdio.h>
+#include <math.h>
+
+#include <algorithm>
+
+// Runs two copies of the same particle system side by side: one integrated frame by
+// frame, the other skipping its updates while asleep and catching up in closed form
+// on WakeUp. Both must end up with the same particles
+
+class ETHParticleManagerTest
+{
+public:
+	// largest difference between matching particles, with the fields brought to comparable scales
+	static float Compare(const ETHParticleManager& a, const ETHParticleManager& b, int& mismatches)
+	{
+		float error = 0.0f;
+		for (std::size_t t = 0; t < a.m_particles.size(); t++)
+		{
+			const ETHParticleManager::PARTICLE& p = a.m_particles[t];
+			const ETHParticleManager::PARTICLE& q = b.m_particles[t];
+			if (p.repeat != q.repeat || p.released != q.released || p.currentFrame != q.currentFrame)
+				++mismatches;
+
+			error = std::max(error, fabsf(p.pos.x - q.pos.x));
+			error = std::max(error, fabsf(p.pos.y - q.pos.y));
+			error = std::max(error, fabsf(p.size - q.size));
+			error = std::max(error, fabsf(p.angle - q.angle));
+			error = std::max(error, fabsf(p.color.w - q.color.w) * 100.0f);
+			error = std::max(error, fabsf(p.elapsed - q.elapsed) / 10.0f);
+		}
+		return error;
+	}
+
+	static void WakeUp(ETHParticleManager& manager)
+	{
+		manager.WakeUp();
+	}
+};
+
+namespace {
+
+const float MAX_ERROR = 1e-2f;
+
+ETHParticleSystem MakeSystem(const int repeat)
+{
+	ETHParticleSystem system;
+	system.nParticles = 37;
+	system.lifeTime = 911.3f;
+	system.repeat = repeat;
+	system.gravityVector = Vector2(0.05f, 0.2f);
+	system.directionVector = Vector2(1.5f,-4.0f);
+	system.size = 10.0f;
+	system.growth = 0.3f;
+	system.maxSize = 40.0f;
+	system.minSize = 0.0f;
+	system.angleDir = 2.0f;
+	system.color0 = Vector4(1, 1, 1, 1);
+	system.color1 = Vector4(1, 0, 0, 0);
+	system.spriteCut = Vector2i(4, 4);
+	system.animationMode = ETHParticleSystem::PLAY_ANIMATION;
+
+	// no randomness, so that both copies launch identical particles
+	system.randomizeDir = Vector2(0, 0);
+	system.randStartPoint = Vector2(0, 0);
+	system.randAngle = 0.0f;
+	system.randomizeSize = 0.0f;
+	system.randAngleStart = 0.0f;
+	system.randomizeLifeTime = 0.0f;
+	return system;
+}
+
+// alternates awake and asleep periods of different lengths
+void CheckCatchUpMatchesStepping(const int repeat, const float frameTime)
+{
+	const ETHParticleSystem system(MakeSystem(repeat));
+	const Vector2 pos(100.0f, 200.0f);
+	const Vector3 pos3(pos, 0.0f);
+	ETHParticleManager stepped(ETHResourceProviderPtr(), system, pos, pos3, 0.0f, 1.0f);
+	ETHParticleManager sleeper(ETHResourceProviderPtr(), system, pos, pos3, 0.0f, 1.0f);
+
+	float maxError = 0.0f;
+	int mismatches = 0;
+	for (int period = 0; period < 12; period++)
+	{
+		const int frames = 5 + period * 37 % 97;
+		const bool asleep = (period % 2 == 1);
+		for (int f = 0; f < frames; f++)
+		{
+			stepped.UpdateParticleSystem(pos, pos3, 0.0f, frameTime);
+			if (asleep)
+				sleeper.SkipUpdate(pos, pos3, 0.0f, frameTime);
+			else
+				sleeper.UpdateParticleSystem(pos, pos3, 0.0f, frameTime);
+		}
+		ETHParticleManagerTest::WakeUp(sleeper);
+		maxError = std::max(maxError, ETHParticleManagerTest::Compare(stepped, sleeper, mismatches));
+	}
+
+	printf("repeat %d, %.2f ms frames: max error %g, %d mismatches\n", repeat, frameTime, maxError, mismatches);
+	ETH_CHECK(maxError <= MAX_ERROR);
+	ETH_CHECK(mismatches == 0);
+	ETH_CHECK(stepped.Finished() == sleeper.Finished());
+}
+
+// a finite system that sleeps through its whole run must finish about when the stepped one does
+void CheckSleeperFinishes()
+{
+	const ETHParticleSystem system(MakeSystem(2));
+	const Vector2 pos(0.0f, 0.0f);
+	const Vector3 pos3(pos, 0.0f);
+	ETHParticleManager stepped(ETHResourceProviderPtr(), system, pos, pos3, 0.0f, 1.0f);
+	ETHParticleManager sleeper(ETHResourceProviderPtr(), system, pos, pos3, 0.0f, 1.0f);
+
+	int steppedFinish = -1, sleeperFinish = -1;
+	for (int f = 0; f < 2000 && (steppedFinish < 0 || sleeperFinish < 0); f++)
+	{
+		stepped.UpdateParticleSystem(pos, pos3, 0.0f, 16.0f);
+		sleeper.SkipUpdate(pos, pos3, 0.0f, 16.0f);
+		if (steppedFinish < 0 && stepped.Finished())
+			steppedFinish = f;
+		if (sleeperFinish < 0 && sleeper.Finished())
+			sleeperFinish = f;
+	}
+
+	printf("always asleep: stepped system finished at frame %d, sleeping one at frame %d\n", steppedFinish, sleeperFinish);
+	ETH_CHECK(steppedFinish >= 0);
+	ETH_CHECK(sleeperFinish >= steppedFinish && sleeperFinish <= steppedFinish + 5);
+}
+
+} // namespace
+
+int main()
+{
+	const float frameTimes[] = { 1000.0f / 60.0f, 1000.0f / 30.0f, 7.0f };
+	for (int repeat = 0; repeat <= 3; repeat += 3)
+	{
+		for (std::size_t t = 0; t < sizeof(frameTimes) / sizeof(frameTimes[0]); t++)
+		{
+			CheckCatchUpMatchesStepping(repeat, frameTimes[t]);
+		}
+	}
+	CheckSleeperFinishes();
+	return TestUtil::Report("ParticleCatchUpTest");
+}
@@ -0,0 +1,175 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#include "TestUtil.h"
+
+#include <engine/Entity/ETHRenderEntity.h>
+#include <engine/Renderer/ETHProjShadowBatch.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include <vector>
+
+// Casts shadows from random casters and lights with ETHRenderEntity::ComputeProjShadow,
+// then projects them all at once with ETHProjShadowBatch::ProjectShadows. Every vertex
+// must land where the per-shadow path puts it: dynaShadowVS run by DrawShaped on a
+// three-triangle sprite of (width, 1) pixels with origin ETH_PROJ_SHADOW_ORIGIN
+
+static const unsigned int NUM_CASTERS = 10000;
+// a hundredth of a pixel leaves room for float rounding on coordinates a few thousand pixels out
+static const double MAX_ERROR = 0.01;
+
+static float Random(const float min, const float max)
+{
+	return min + (max - min) * (static_cast<float>(rand()) / static_cast<float>(RAND_MAX));
+}
+
+// dynaShadowVS transliterated in double precision. The screen-space transform cancels out
+// once the vertex is mapped back to render target pixels
+static void ShadeVertex(
+	const ETHRenderEntity::PROJ_SHADOW& shadow,
+	const Vector2& cameraPos,
+	const double vertexX,
+	const double vertexY,
+	double& outX,
+	double& outY)
+{
+	const Vector2 origin = ETH_PROJ_SHADOW_ORIGIN;
+
+	// DrawShaped is handed the angle in degrees and turns it back into radians
+	const double angle = DegreeToRadian(RadianToDegree(shadow.angle));
+	const double c = cos(angle), s = sin(angle);
+	const double x = (vertexX - origin.x) * shadow.width;
+	const double y = (vertexY - origin.y);
+	double posX = c * x + s * y + shadow.pos.x;
+	double posY =-s * x + c * y + shadow.pos.y;
+
+	double lightVecX = shadow.pos.x - shadow.lightPos.x;
+	double lightVecY = shadow.pos.y - shadow.lightPos.y;
+	const double lightVecLength = sqrt(lightVecX * lightVecX + lightVecY * lightVecY);
+	lightVecX /= lightVecLength;
+	lightVecY /= lightVecLength;
+
+	double dirX = posX - shadow.lightPos.x;
+	double dirY = posY - shadow.lightPos.y;
+	const double dirLength = sqrt(dirX * dirX + dirY * dirY);
+	const double extrude = (1.0 - vertexY) * shadow.length;
+	dirX = dirX / dirLength * extrude;
+	dirY = dirY / dirLength * extrude;
+
+	const double pushBack = (shadow.length / 6.0) - shadow.entityZ;
+	posX += dirX - lightVecX * pushBack;
+	posY += dirY - lightVecY * pushBack;
+
+	outX = posX - cameraPos.x;
+	outY = posY - cameraPos.y - shadow.shadowZ;
+}
+
+int main()
+{
+	srand(46);
+
+	ETHSceneProperties sceneProps;
+	sceneProps.ambient = Vector3(0.1f, 0.1f, 0.15f);
+
+	std::vector<ETHRenderEntity::PROJ_SHADOW> shadows;
+	for (unsigned int t = 0; t < NUM_CASTERS; t++)
+	{
+		ETHRenderEntity::PROJ_SHADOW_CASTER caster;
+		caster.pos = Vector3(Random(-2000.0f, 2000.0f), Random(-2000.0f, 2000.0f), Random(0.0f, 8.0f));
+		caster.size = Vector2(Random(8.0f, 200.0f), Random(16.0f, 200.0f));
+		caster.shadowZ = Random(0.0f, 30.0f);
+		caster.shadowScale = Random(0.0f, 2.0f);
+		caster.shadowOpacity = Random(0.0f, 1.0f);
+		caster.shadowLengthScale = Random(0.5f, 2.0f);
+		caster.depth = Random(0.0f, 1.0f);
+
+		const float lightAngle = Random(0.0f, gs2d::math::constant::PI * 2.0f);
+		const float lightDistance = Random(5.0f, 500.0f);
+		ETHLight light(true);
+		light.pos = Vector3(caster.pos.x + cosf(lightAngle) * lightDistance, caster.pos.y + sinf(lightAngle) * lightDistance, Random(0.0f, 400.0f));
+		light.color = Vector3(Random(0.0f, 1.0f), Random(0.0f, 1.0f), Random(0.0f, 1.0f));
+		light.range = Random(100.0f, 800.0f);
+
+		ETHRenderEntity::PROJ_SHADOW shadow;
+		if (ETHRenderEntity::ComputeProjShadow(caster, sceneProps, light, light.pos, (t % 4) == 0, false, 0.0f, Vector3(0, 0, 0), shadow))
+		{
+			shadows.push_back(shadow);
+		}
+	}
+
+	const std::size_t numShadows = shadows.size();
+	printf("%u of %u casters cast shadows\n", static_cast<unsigned int>(numShadows), NUM_CASTERS);
+	ETH_CHECK(numShadows >= NUM_CASTERS / 4);
+
+	// laid out the way ETHProjShadowBatch::Add packs them
+	std::vector<float> posX, posY, width, length, entityZ, shadowZ, lightX, lightY, cosAngle, sinAngle;
+	for (std::size_t t = 0; t < numShadows; t++)
+	{
+		const ETHRenderEntity::PROJ_SHADOW& shadow = shadows[t];
+		posX.push_back(shadow.pos.x);
+		posY.push_back(shadow.pos.y);
+		width.push_back(shadow.width);
+		length.push_back(shadow.length);
+		entityZ.push_back(shadow.entityZ);
+		shadowZ.push_back(shadow.shadowZ);
+		lightX.push_back(shadow.lightPos.x);
+		lightY.push_back(shadow.lightPos.y);
+		cosAngle.push_back(cosf(shadow.angle));
+		sinAngle.push_back(sinf(shadow.angle));
+	}
+
+	const Vector2 cameraPos(123.5f,-77.25f);
+	const unsigned int numVertices = ETHProjShadowBatch::SHADOW_VERTEX_COUNT;
+	std::vector<float> outX(numShadows * numVertices), outY(numShadows * numVertices);
+	ETHProjShadowBatch::ProjectShadows(
+		numShadows,
+		&posX[0], &posY[0],
+		&width[0], &length[0],
+		&entityZ[0], &shadowZ[0],
+		&lightX[0], &lightY[0],
+		&cosAngle[0], &sinAngle[0],
+		cameraPos,
+		&outX[0], &outY[0]);
+
+	// the quad vertices DrawShaped emits in RM_THREE_TRIANGLES mode, in ProjectShadows order
+	static const double VERTEX_X[ETHProjShadowBatch::SHADOW_VERTEX_COUNT] = { 0.0, 0.0, 0.5, 1.0, 1.0 };
+	static const double VERTEX_Y[ETHProjShadowBatch::SHADOW_VERTEX_COUNT] = { 0.0, 1.0, 0.0, 1.0, 0.0 };
+
+	double maxError = 0.0;
+	for (std::size_t t = 0; t < numShadows; t++)
+	{
+		for (unsigned int v = 0; v < numVertices; v++)
+		{
+			double x, y;
+			ShadeVertex(shadows[t], cameraPos, VERTEX_X[v], VERTEX_Y[v], x, y);
+			maxError = Max(maxError, fabs(x - outX[v * numShadows + t]));
+			maxError = Max(maxError, fabs(y - outY[v * numShadows + t]));
+		}
+	}
+	printf("largest vertex difference: %g px\n", maxError);
+	ETH_CHECK(maxError <= MAX_ERROR);
+
+	return TestUtil::Report("ProjShadowTest");
+}
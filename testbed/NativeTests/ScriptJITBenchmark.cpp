@@ -0,0 +1,390 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#include "TestUtil.h"
+
+#include <angelscript.h>
+#include <engine/Script/ETHJITCompiler.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include <string>
+#include <vector>
+
+// Runs the same scripts on the interpreter and with ETHJITCompiler, checks that both
+// print exactly the same, raise the same exceptions and suspend at the same places,
+// and prints the time each bench function takes on both. Functions named test* are
+// only compared; bench* are compared and timed
+
+namespace {
+
+const char* SCRIPT =
+	"int g_counter = 0;\n"
+	"float g_f = 1.5f;\n"
+	"uint g_u = 7;\n"
+	"\n"
+	"int fib(int n) { if (n < 2) return n; return fib(n - 1) + fib(n - 2); }\n"
+	"\n"
+	"void testInt()\n"
+	"{\n"
+	"	int a = 7, b = -3;\n"
+	"	print(a + b); print(a - b); print(a * b); print(a / b); print(a % b); print(-a);\n"
+	"	print(a & b); print(a | b); print(a ^ b); print(~a); print(a << 3); print(b >> 1); print(b >>> 1);\n"
+	"	int s = 0;\n"
+	"	for (int i = 0; i < 100; i++) { s += i * i - (i % 7); if (s > 1000) s -= 999; }\n"
+	"	print(s);\n"
+	"	int k = 10; while (k-- > 0) { g_counter++; }\n"
+	"	print(g_counter);\n"
+	"	uint u = 4000000000; uint v = 3;\n"
+	"	print(u / v); print(u % v); print(u > v); print(float(u)); print(double(u));\n"
+	"	int8 c8 = -5; int16 c16 = -300; uint8 u8 = 250; uint16 u16 = 65000;\n"
+	"	int w = c8 + c16 + u8 + u16; print(w); print(int(int8(w)));\n"
+	"	g_u += 5; print(g_u);\n"
+	"	int64 big = 5000000000; print(big * -3); print(int(big)); print(big > int64(-7));\n"
+	"}\n"
+	"\n"
+	"void testFloat()\n"
+	"{\n"
+	"	float x = 1.25f, y = -0.5f;\n"
+	"	print(x + y); print(x - y); print(x * y); print(x / y); print(-x); print(x * 2.5f);\n"
+	"	double d = 3.0; double e = 7.0;\n"
+	"	print(d / e); print(-d); print(float(d / e)); print(int(e / d));\n"
+	"	print(x < y); print(x == y); print(x >= 1.3f); print(d < e);\n"
+	"	g_f *= 2; print(g_f);\n"
+	"}\n"
+	"\n"
+	"void testNativeCalls()\n"
+	"{\n"
+	"	print(nativeSqr(1.5f) + genericSqr(-2.0f));\n"
+	"	print(nativeMix(3, 5000000000, 0.25f, 0.125));\n"
+	"	Accumulator acc;\n"
+	"	acc.total = 1;\n"
+	"	for (int i = 0; i < 10; i++)\n"
+	"		acc.add(float(i));\n"
+	"	print(acc.total);\n"
+	"	float sum = 0;\n"
+	"	for (int i = 0; i < 5; i++) { suspend(); sum += nativeSqr(float(i)); }\n"
+	"	print(sum);\n"
+	"}\n"
+	"\n"
+	"void testDivisionByZero()\n"
+	"{\n"
+	"	int a = 10; int b = 0;\n"
+	"	print(1);\n"
+	"	print(a / b);\n"
+	"}\n"
+	"\n"
+	"void testNativeException()\n"
+	"{\n"
+	"	print(nativeSqr(2.0f));\n"
+	"	fail();\n"
+	"	print(3);\n"
+	"}\n"
+	"\n"
+	"void benchInt()\n"
+	"{\n"
+	"	int s = 0;\n"
+	"	for (int i = 0; i < 10000000; i++)\n"
+	"	{\n"
+	"		s = (s * 31 + i) ^ (i >> 3);\n"
+	"		if ((s & 1) == 0) s += 7; else s -= 3;\n"
+	"	}\n"
+	"	print(s);\n"
+	"}\n"
+	"\n"
+	"void benchFloat()\n"
+	"{\n"
+	"	float acc = 0;\n"
+	"	for (int i = 0; i < 5000000; i++)\n"
+	"	{\n"
+	"		float x = float(i) * 0.001f;\n"
+	"		acc += x * x - acc * 0.5f;\n"
+	"		if (acc > 1000.0f) acc -= 1000.0f;\n"
+	"	}\n"
+	"	print(acc);\n"
+	"}\n"
+	"\n"
+	"void benchNativeCalls()\n"
+	"{\n"
+	"	float acc = 0;\n"
+	"	for (int i = 0; i < 1000000; i++)\n"
+	"		acc += nativeSqr(float(i % 100)) * 0.01f + genericSqr(0.5f);\n"
+	"	print(acc);\n"
+	"}\n"
+	"\n"
+	"void benchMethodCalls()\n"
+	"{\n"
+	"	Accumulator acc;\n"
+	"	acc.total = 0;\n"
+	"	for (int i = 0; i < 1000000; i++)\n"
+	"		acc.add(float(i % 10));\n"
+	"	print(acc.total);\n"
+	"}\n"
+	"\n"
+	"void benchScriptCalls()\n"
+	"{\n"
+	"	print(fib(27));\n"
+	"}\n";
+
+std::string g_output;
+
+void Print(const char* format, const double value)
+{
+	char buffer[64];
+	sprintf(buffer, format, value);
+	g_output += buffer;
+}
+
+void PrintInt(const int value) { Print("i %.0f\n", value); }
+void PrintUInt(const unsigned int value) { Print("u %.0f\n", value); }
+void PrintInt64(const asINT64 value) { Print("l %.0f\n", static_cast<double>(value)); }
+void PrintFloat(const float value) { Print("f %.9g\n", value); }
+void PrintDouble(const double value) { Print("d %.17g\n", value); }
+void PrintBool(const bool value) { g_output += value ? "b true\n" : "b false\n"; }
+
+float NativeSqr(const float value)
+{
+	return value * value;
+}
+
+double NativeMix(const int a, const asINT64 b, const float c, const double d)
+{
+	return static_cast<double>(a) + static_cast<double>(b) * c + d;
+}
+
+void GenericSqr(asIScriptGeneric* generic)
+{
+	const float value = generic->GetArgFloat(0);
+	generic->SetReturnFloat(value * value);
+}
+
+void Fail()
+{
+	asGetActiveContext()->SetException("fail() was called");
+}
+
+void Suspend()
+{
+	asGetActiveContext()->Suspend();
+}
+
+struct Accumulator
+{
+	float total;
+
+	void Add(const float value)
+	{
+		total += value;
+	}
+};
+
+void MessageCallback(const asSMessageInfo* message, void*)
+{
+	printf("%s (%d, %d): %s\n", message->section, message->row, message->col, message->message);
+}
+
+int g_lines = 0;
+
+void LineCallback(asIScriptContext* context, void*)
+{
+	if (++g_lines % 100003 == 0)
+		context->Suspend();
+}
+
+double GetTimeMS()
+{
+	timeval t;
+	gettimeofday(&t, 0);
+	return t.tv_sec * 1000.0 + t.tv_usec / 1000.0;
+}
+
+struct RUN
+{
+	std::string name;
+	std::string output;
+	double timeMS;
+	unsigned int suspensions;
+};
+
+enum MODE
+{
+	INTERPRETER,
+	INTERPRETER_WITH_JIT_ENTRIES,
+	JIT
+};
+
+class ScriptRunner
+{
+public:
+	ScriptRunner(const MODE mode) :
+		m_engine(asCreateScriptEngine(ANGELSCRIPT_VERSION)),
+		m_module(0)
+	{
+		m_engine->SetMessageCallback(asFUNCTION(MessageCallback), 0, asCALL_CDECL);
+		if (mode != INTERPRETER)
+			m_engine->SetEngineProperty(asEP_INCLUDE_JIT_INSTRUCTIONS, 1);
+		if (mode == JIT)
+			m_engine->SetJITCompiler(&m_compiler);
+
+		int r = 0;
+		r |= m_engine->RegisterGlobalFunction("void print(int)", asFUNCTION(PrintInt), asCALL_CDECL);
+		r |= m_engine->RegisterGlobalFunction("void print(uint)", asFUNCTION(PrintUInt), asCALL_CDECL);
+		r |= m_engine->RegisterGlobalFunction("void print(int64)", asFUNCTION(PrintInt64), asCALL_CDECL);
+		r |= m_engine->RegisterGlobalFunction("void print(float)", asFUNCTION(PrintFloat), asCALL_CDECL);
+		r |= m_engine->RegisterGlobalFunction("void print(double)", asFUNCTION(PrintDouble), asCALL_CDECL);
+		r |= m_engine->RegisterGlobalFunction("void print(bool)", asFUNCTION(PrintBool), asCALL_CDECL);
+		r |= m_engine->RegisterGlobalFunction("float nativeSqr(float)", asFUNCTION(NativeSqr), asCALL_CDECL);
+		r |= m_engine->RegisterGlobalFunction("double nativeMix(int, int64, float, double)", asFUNCTION(NativeMix), asCALL_CDECL);
+		r |= m_engine->RegisterGlobalFunction("float genericSqr(float)", asFUNCTION(GenericSqr), asCALL_GENERIC);
+		r |= m_engine->RegisterGlobalFunction("void fail()", asFUNCTION(Fail), asCALL_CDECL);
+		r |= m_engine->RegisterGlobalFunction("void suspend()", asFUNCTION(Suspend), asCALL_CDECL);
+		r |= m_engine->RegisterObjectType("Accumulator", sizeof(Accumulator), asOBJ_VALUE | asOBJ_POD | asOBJ_APP_PRIMITIVE);
+		r |= m_engine->RegisterObjectProperty("Accumulator", "float total", asOFFSET(Accumulator, total));
+		r |= m_engine->RegisterObjectMethod("Accumulator", "void add(float)", asMETHOD(Accumulator, Add), asCALL_THISCALL);
+		ETH_CHECK(r >= 0);
+
+		m_module = m_engine->GetModule("benchmark", asGM_ALWAYS_CREATE);
+		m_module->AddScriptSection("benchmark", SCRIPT, strlen(SCRIPT));
+		ETH_CHECK(m_module->Build() >= 0);
+	}
+
+	~ScriptRunner()
+	{
+		m_engine->Release();
+	}
+
+	const ETHJITCompiler& GetCompiler() const
+	{
+		return m_compiler;
+	}
+
+	// runs every test and bench function, suspending on the line callback if asked to
+	std::vector<RUN> Run(const bool lineCallback)
+	{
+		std::vector<RUN> runs;
+		m_module->ResetGlobalVars();
+		asIScriptContext* context = m_engine->CreateContext();
+		if (lineCallback)
+			context->SetLineCallback(asFUNCTION(LineCallback), 0, asCALL_CDECL);
+
+		for (asUINT t = 0; t < m_module->GetFunctionCount(); t++)
+		{
+			asIScriptFunction* function = m_module->GetFunctionByIndex(t);
+			if (strncmp(function->GetName(), "test", 4) != 0 && strncmp(function->GetName(), "bench", 5) != 0)
+				continue;
+
+			RUN run;
+			run.name = function->GetName();
+			run.suspensions = 0;
+			g_output.clear();
+			g_lines = 0;
+
+			context->Prepare(function);
+			const double start = GetTimeMS();
+			int r = context->Execute();
+			while (r == asEXECUTION_SUSPENDED)
+			{
+				// where it stopped, so both runs must suspend at the very same places
+				char buffer[32];
+				sprintf(buffer, "suspended at line %d\n", context->GetLineNumber());
+				g_output += buffer;
+				run.suspensions++;
+				r = context->Execute();
+			}
+			run.timeMS = GetTimeMS() - start;
+
+			if (r == asEXECUTION_EXCEPTION)
+			{
+				char buffer[32];
+				sprintf(buffer, " at line %d", context->GetExceptionLineNumber());
+				g_output += std::string("exception: ") + context->GetExceptionString() + buffer + "\n";
+			}
+			run.output = g_output;
+			runs.push_back(run);
+		}
+		context->Release();
+		return runs;
+	}
+
+private:
+	ETHJITCompiler m_compiler;
+	asIScriptEngine* m_engine;
+	asIScriptModule* m_module;
+};
+
+void Compare(const std::vector<RUN>& interpreted, const std::vector<RUN>& compiled)
+{
+	ETH_CHECK(interpreted.size() == compiled.size());
+	for (std::size_t t = 0; t < interpreted.size() && t < compiled.size(); t++)
+	{
+		if (interpreted[t].output != compiled[t].output)
+		{
+			printf("%s differs:\n-- interpreter\n%s-- JIT\n%s",
+				interpreted[t].name.c_str(), interpreted[t].output.c_str(), compiled[t].output.c_str());
+		}
+		ETH_CHECK(interpreted[t].output == compiled[t].output);
+	}
+}
+
+} // namespace
+
+int main()
+{
+	if (!ETHJITCompiler::IsSupported())
+	{
+		printf("ScriptJITBenchmark: the JIT isn't available on this host\n");
+		return TestUtil::Report("ScriptJITBenchmark");
+	}
+
+	ScriptRunner interpreter(INTERPRETER);
+	ScriptRunner jit(JIT);
+	ETH_CHECK(jit.GetCompiler().GetNumCompiledFunctions() > 0);
+
+	const std::vector<RUN> interpreted = interpreter.Run(false);
+	const std::vector<RUN> compiled = jit.Run(false);
+	Compare(interpreted, compiled);
+
+	// the suspend() calls in testNativeCalls must stop the JIT right after the call too
+	for (std::size_t t = 0; t < compiled.size(); t++)
+	{
+		if (compiled[t].name == "testNativeCalls")
+			ETH_CHECK(compiled[t].suspensions == 5);
+	}
+
+	// line callbacks send every SUSPEND instruction and every call back to the interpreter. The
+	// JitEntry instructions change where the compiler places line cues, so the reference has them too
+	ScriptRunner reference(INTERPRETER_WITH_JIT_ENTRIES);
+	Compare(reference.Run(true), jit.Run(true));
+
+	printf("ScriptJITBenchmark: %u functions compiled to %u bytes\n",
+		jit.GetCompiler().GetNumCompiledFunctions(), static_cast<unsigned int>(jit.GetCompiler().GetNativeCodeSize()));
+	for (std::size_t t = 0; t < interpreted.size() && t < compiled.size(); t++)
+	{
+		if (interpreted[t].name.compare(0, 5, "bench") != 0)
+			continue;
+		printf(" %-18s interpreter %8.1f ms, JIT %8.1f ms (%.2fx)\n", interpreted[t].name.c_str(),
+			interpreted[t].timeMS, compiled[t].timeMS, interpreted[t].timeMS / compiled[t].timeMS);
+	}
+	return TestUtil::Report("ScriptJITBenchmark");
+}
@@ -0,0 +1,59 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#ifndef ETH_NATIVE_TEST_UTIL_H_
+#define ETH_NATIVE_TEST_UTIL_H_
+
+#include <stdio.h>
+
+// Minimal check helpers shared by the native tests. Each test is a standalone
+// program that prints every failed check and exits with the number of failures
+
+namespace TestUtil {
+
+inline int& FailureCount()
+{
+	static int failures = 0;
+	return failures;
+}
+
+inline void Fail(const char* file, const int line, const char* expression)
+{
+	printf("%s(%d): check failed: %s\n", file, line, expression);
+	++FailureCount();
+}
+
+inline int Report(const char* testName)
+{
+	if (FailureCount() > 0)
+		printf("%s FAILED (%d checks)\n", testName, FailureCount());
+	else
+		printf("%s passed\n", testName);
+	return FailureCount();
+}
+
+} // namespace TestUtil
+
+#define ETH_CHECK(expression) \
+	do { if (!(expression)) TestUtil::Fail(__FILE__, __LINE__, #expression); } while (0)
+
+#endif
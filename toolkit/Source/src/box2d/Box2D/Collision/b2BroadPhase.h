@@ -100,6 +100,15 @@ public:
 	/// Get the quality metric of the embedded tree.
 	float32 GetTreeQuality() const;
 
+	/// Keep new proxies out of the embedded tree until EndBulkInsert builds
+	/// it in one pass. See b2DynamicTree::BeginBulkInsert.
+	void BeginBulkInsert();
+	void EndBulkInsert();
+	bool IsBulkInserting() const;
+
+	/// Rebuild the embedded tree from scratch. See b2DynamicTree::RebuildTopDown.
+	void RebuildTree();
+
 private:
 
 	friend class b2DynamicTree;
@@ -177,6 +186,26 @@ inline float32 b2BroadPhase::GetTreeQuality() const
 	return m_tree.GetAreaRatio();
 }
 
+inline void b2BroadPhase::BeginBulkInsert()
+{
+	m_tree.BeginBulkInsert();
+}
+
+inline void b2BroadPhase::EndBulkInsert()
+{
+	m_tree.EndBulkInsert();
+}
+
+inline bool b2BroadPhase::IsBulkInserting() const
+{
+	return m_tree.IsBulkInserting();
+}
+
+inline void b2BroadPhase::RebuildTree()
+{
+	m_tree.RebuildTopDown();
+}
+
 template <typename T>
 void b2BroadPhase::UpdatePairs(T* callback)
 {
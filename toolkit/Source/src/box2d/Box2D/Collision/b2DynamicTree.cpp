@@ -19,6 +19,7 @@
 #include <Box2D/Collision/b2DynamicTree.h>
 #include <cstring>
 #include <cfloat>
+#include <algorithm>
 using namespace std;
 
 
@@ -44,6 +45,9 @@ b2DynamicTree::b2DynamicTree()
 	m_path = 0;
 
 	m_insertionCount = 0;
+
+	m_bulkInsert = false;
+	m_detachedCount = 0;
 }
 
 b2DynamicTree::~b2DynamicTree()
@@ -116,6 +120,12 @@ int32 b2DynamicTree::CreateProxy(const b2AABB& aabb, void* userData)
 	m_nodes[proxyId].userData = userData;
 	m_nodes[proxyId].height = 0;
 
+	if (m_bulkInsert)
+	{
+		++m_detachedCount;
+		return proxyId;
+	}
+
 	InsertLeaf(proxyId);
 
 	return proxyId;
@@ -126,10 +136,24 @@ void b2DynamicTree::DestroyProxy(int32 proxyId)
 	b2Assert(0 <= proxyId && proxyId < m_nodeCapacity);
 	b2Assert(m_nodes[proxyId].IsLeaf());
 
-	RemoveLeaf(proxyId);
+	if (IsDetached(proxyId))
+	{
+		--m_detachedCount;
+	}
+	else
+	{
+		RemoveLeaf(proxyId);
+	}
 	FreeNode(proxyId);
 }
 
+// A proxy waiting for the end of a bulk insert is the only kind of
+// leaf that has no parent and is not the root.
+bool b2DynamicTree::IsDetached(int32 proxyId) const
+{
+	return m_detachedCount > 0 && m_nodes[proxyId].parent == b2_nullNode && proxyId != m_root;
+}
+
 bool b2DynamicTree::MoveProxy(int32 proxyId, const b2AABB& aabb, const b2Vec2& displacement)
 {
 	b2Assert(0 <= proxyId && proxyId < m_nodeCapacity);
@@ -141,7 +165,11 @@ bool b2DynamicTree::MoveProxy(int32 proxyId, const b2AABB& aabb, const b2Vec2& d
 		return false;
 	}
 
-	RemoveLeaf(proxyId);
+	bool detached = IsDetached(proxyId);
+	if (detached == false)
+	{
+		RemoveLeaf(proxyId);
+	}
 
 	// Extend AABB.
 	b2AABB b = aabb;
@@ -172,7 +200,10 @@ bool b2DynamicTree::MoveProxy(int32 proxyId, const b2AABB& aabb, const b2Vec2& d
 
 	m_nodes[proxyId].aabb = b;
 
-	InsertLeaf(proxyId);
+	if (detached == false)
+	{
+		InsertLeaf(proxyId);
+	}
 	return true;
 }
 
@@ -769,3 +800,294 @@ void b2DynamicTree::RebuildBottomUp()
 
 	Validate();
 }
+
+void b2DynamicTree::BeginBulkInsert()
+{
+	m_bulkInsert = true;
+}
+
+void b2DynamicTree::EndBulkInsert()
+{
+	m_bulkInsert = false;
+	if (m_detachedCount > 0)
+	{
+		RebuildTopDown();
+	}
+}
+
+bool b2DynamicTree::IsBulkInserting() const
+{
+	return m_bulkInsert;
+}
+
+const int32 b2_treeBinCount = 16;
+
+struct b2TreeBuildLeaf
+{
+	b2AABB aabb;
+	b2Vec2 center;
+	int32 id;
+};
+
+struct b2TreeBin
+{
+	b2AABB aabb;
+	b2Vec2 minCenter;
+	b2Vec2 maxCenter;
+	int32 count;
+
+	b2TreeBin()
+	{
+		aabb.lowerBound.SetZero();
+		aabb.upperBound.SetZero();
+		minCenter.SetZero();
+		maxCenter.SetZero();
+		count = 0;
+	}
+
+	void Add(const b2TreeBuildLeaf& leaf)
+	{
+		if (count == 0)
+		{
+			aabb = leaf.aabb;
+			minCenter = leaf.center;
+			maxCenter = leaf.center;
+		}
+		else
+		{
+			aabb.Combine(leaf.aabb);
+			minCenter = b2Min(minCenter, leaf.center);
+			maxCenter = b2Max(maxCenter, leaf.center);
+		}
+		++count;
+	}
+
+	void Add(const b2TreeBin& bin)
+	{
+		if (bin.count == 0)
+		{
+			return;
+		}
+
+		if (count == 0)
+		{
+			*this = bin;
+			return;
+		}
+
+		aabb.Combine(bin.aabb);
+		minCenter = b2Min(minCenter, bin.minCenter);
+		maxCenter = b2Max(maxCenter, bin.maxCenter);
+		count += bin.count;
+	}
+};
+
+// A range of leaves still to be split, with the bounds of their boxes and centers.
+struct b2TreeBuildEntry
+{
+	b2TreeBin bounds;
+	int32 start;
+	int32 parent;
+	bool firstChild;
+};
+
+// Sort leaves into bins along the longer axis of their centers and partition
+// them where perimeter(left) * count(left) + perimeter(right) * count(right)
+// is lowest. Returns how many leaves go to the first child and their bounds.
+static int32 b2SplitLeaves(b2TreeBuildLeaf* leaves, const b2TreeBin& bounds, b2TreeBin* left, b2TreeBin* right)
+{
+	int32 count = bounds.count;
+	b2Vec2 extent = bounds.maxCenter - bounds.minCenter;
+	int32 axis = extent.x >= extent.y ? 0 : 1;
+	float32 axisExtent = axis == 0 ? extent.x : extent.y;
+	float32 axisMin = axis == 0 ? bounds.minCenter.x : bounds.minCenter.y;
+
+	int32 leftCount = count / 2;
+	int32 bestPlane = -1;
+	b2TreeBin bins[b2_treeBinCount];
+	float32 binScale = 0.0f;
+
+	// Coincident centers cannot be told apart; those ranges are just halved.
+	if (axisExtent > b2_epsilon)
+	{
+		binScale = b2_treeBinCount / axisExtent;
+		for (int32 i = 0; i < count; ++i)
+		{
+			float32 c = axis == 0 ? leaves[i].center.x : leaves[i].center.y;
+			int32 bin = b2Min(int32(binScale * (c - axisMin)), b2_treeBinCount - 1);
+			bins[bin].Add(leaves[i]);
+		}
+
+		// Sweep from the right to get the cost of everything past each plane.
+		b2TreeBin suffix[b2_treeBinCount];
+		suffix[b2_treeBinCount - 1] = bins[b2_treeBinCount - 1];
+		for (int32 i = b2_treeBinCount - 2; i > 0; --i)
+		{
+			suffix[i] = suffix[i + 1];
+			suffix[i].Add(bins[i]);
+		}
+
+		float32 bestCost = b2_maxFloat;
+		b2TreeBin prefix;
+		for (int32 i = 0; i < b2_treeBinCount - 1; ++i)
+		{
+			prefix.Add(bins[i]);
+			if (prefix.count == 0 || prefix.count == count)
+			{
+				continue;
+			}
+
+			float32 cost = prefix.aabb.GetPerimeter() * prefix.count + suffix[i + 1].aabb.GetPerimeter() * suffix[i + 1].count;
+			if (cost < bestCost)
+			{
+				bestCost = cost;
+				bestPlane = i;
+				*left = prefix;
+				*right = suffix[i + 1];
+			}
+		}
+	}
+
+	if (bestPlane < 0)
+	{
+		left->count = 0;
+		right->count = 0;
+		for (int32 i = 0; i < leftCount; ++i)
+		{
+			left->Add(leaves[i]);
+		}
+		for (int32 i = leftCount; i < count; ++i)
+		{
+			right->Add(leaves[i]);
+		}
+		return leftCount;
+	}
+
+	// Partition in place, leaves up to and including the best bin first.
+	int32 i = 0;
+	int32 j = count - 1;
+	while (i <= j)
+	{
+		float32 c = axis == 0 ? leaves[i].center.x : leaves[i].center.y;
+		int32 bin = b2Min(int32(binScale * (c - axisMin)), b2_treeBinCount - 1);
+		if (bin <= bestPlane)
+		{
+			++i;
+		}
+		else
+		{
+			b2Swap(leaves[i], leaves[j]);
+			--j;
+		}
+	}
+
+	b2Assert(i == left->count);
+	return i;
+}
+
+void b2DynamicTree::RebuildTopDown()
+{
+	b2TreeBuildLeaf* leaves = (b2TreeBuildLeaf*)b2Alloc(b2Max(m_nodeCount, 1) * sizeof(b2TreeBuildLeaf));
+	b2TreeBuildEntry rootEntry;
+	rootEntry.start = 0;
+	rootEntry.parent = b2_nullNode;
+	rootEntry.firstChild = true;
+
+	// Gather the leaves, detached ones included. Free the rest.
+	for (int32 i = 0; i < m_nodeCapacity; ++i)
+	{
+		if (m_nodes[i].height < 0)
+		{
+			// free node in pool
+			continue;
+		}
+
+		if (m_nodes[i].IsLeaf())
+		{
+			m_nodes[i].parent = b2_nullNode;
+			b2TreeBuildLeaf& leaf = leaves[rootEntry.bounds.count];
+			leaf.aabb = m_nodes[i].aabb;
+			leaf.center = leaf.aabb.GetCenter();
+			leaf.id = i;
+			rootEntry.bounds.Add(leaf);
+		}
+		else
+		{
+			FreeNode(i);
+		}
+	}
+
+	int32 leafCount = rootEntry.bounds.count;
+	m_root = b2_nullNode;
+	m_detachedCount = 0;
+
+	if (leafCount == 0)
+	{
+		b2Free(leaves);
+		return;
+	}
+
+	// Internal nodes in creation order, parents before children, so their
+	// heights can be filled in afterwards by walking it backwards.
+	int32* internals = (int32*)b2Alloc(b2Max(leafCount - 1, 1) * sizeof(int32));
+	int32 internalCount = 0;
+
+	b2GrowableStack<b2TreeBuildEntry, 64> stack;
+	stack.Push(rootEntry);
+
+	while (stack.GetCount() > 0)
+	{
+		b2TreeBuildEntry entry = stack.Pop();
+
+		int32 nodeId;
+		if (entry.bounds.count == 1)
+		{
+			nodeId = leaves[entry.start].id;
+		}
+		else
+		{
+			b2TreeBuildEntry child1, child2;
+			int32 leftCount = b2SplitLeaves(leaves + entry.start, entry.bounds, &child1.bounds, &child2.bounds);
+
+			nodeId = AllocateNode();
+			m_nodes[nodeId].aabb = entry.bounds.aabb;
+			internals[internalCount++] = nodeId;
+
+			child1.start = entry.start;
+			child1.parent = nodeId;
+			child1.firstChild = true;
+
+			child2.start = entry.start + leftCount;
+			child2.parent = nodeId;
+			child2.firstChild = false;
+
+			stack.Push(child2);
+			stack.Push(child1);
+		}
+
+		m_nodes[nodeId].parent = entry.parent;
+		if (entry.parent == b2_nullNode)
+		{
+			m_root = nodeId;
+		}
+		else if (entry.firstChild)
+		{
+			m_nodes[entry.parent].child1 = nodeId;
+		}
+		else
+		{
+			m_nodes[entry.parent].child2 = nodeId;
+		}
+	}
+
+	for (int32 i = internalCount - 1; i >= 0; --i)
+	{
+		b2TreeNode* node = m_nodes + internals[i];
+		node->height = 1 + b2Max(m_nodes[node->child1].height, m_nodes[node->child2].height);
+	}
+
+	b2Free(internals);
+	b2Free(leaves);
+
+	Validate();
+}
@@ -118,6 +118,23 @@ public:
 	/// Build an optimal tree. Very expensive. For testing.
 	void RebuildBottomUp();
 
+	/// Rebuild the whole tree top-down, splitting each node where the binned
+	/// surface area heuristic (perimeter in 2D) is lowest. This is O(n log n)
+	/// and gives a much better tree than incremental insertion, so use it after
+	/// loading a level or making large edits. Proxy ids are kept.
+	void RebuildTopDown();
+
+	/// Stop linking new proxies into the tree. EndBulkInsert then builds the
+	/// tree in one pass with RebuildTopDown. Until then queries and ray casts
+	/// do not see the new proxies; moving and destroying them is fine.
+	void BeginBulkInsert();
+
+	/// Link the proxies created since BeginBulkInsert by rebuilding the tree.
+	void EndBulkInsert();
+
+	/// Is BeginBulkInsert in effect.
+	bool IsBulkInserting() const;
+
 private:
 
 	int32 AllocateNode();
@@ -128,6 +145,8 @@ private:
 
 	int32 Balance(int32 index);
 
+	bool IsDetached(int32 proxyId) const;
+
 	int32 ComputeHeight() const;
 	int32 ComputeHeight(int32 nodeId) const;
 
@@ -146,6 +165,10 @@ private:
 	uint32 m_path;
 
 	int32 m_insertionCount;
+
+	// Proxies created during a bulk insert stay out of the tree until it ends.
+	bool m_bulkInsert;
+	int32 m_detachedCount;
 };
 
 inline void* b2DynamicTree::GetUserData(int32 proxyId) const
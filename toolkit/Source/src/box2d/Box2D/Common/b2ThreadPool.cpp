@@ -0,0 +1,299 @@
+/*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include <Box2D/Common/b2ThreadPool.h>
+#include <Box2D/Common/b2Math.h>
+#include <new>
+
+#if defined(WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <pthread.h>
+#endif
+
+struct b2ThreadPoolWorker
+{
+	b2ThreadPool* pool;
+	int32 index;
+};
+
+struct b2ThreadPoolState
+{
+	b2ThreadPoolWorker* workers;
+	int32 workerCount;
+
+	b2ThreadPool::b2TaskCallback* callback;
+	void* context;
+	int32 taskCount;
+
+	volatile long nextTask;
+	volatile long busyWorkers;
+	bool stopping;
+
+#if defined(WIN32)
+	HANDLE* threads;
+	HANDLE start;
+	HANDLE done;
+
+	static DWORD WINAPI Routine(LPVOID parameter);
+#else
+	pthread_t* threads;
+	pthread_mutex_t mutex;
+	pthread_cond_t start;
+	pthread_cond_t done;
+	int32 generation;
+
+	static void* Routine(void* parameter);
+#endif
+
+	void WorkerLoop(const b2ThreadPoolWorker& worker);
+};
+
+static long b2AtomicIncrement(volatile long* value)
+{
+#if defined(WIN32)
+	return InterlockedIncrement(value);
+#else
+	return __sync_add_and_fetch(value, 1);
+#endif
+}
+
+#if defined(WIN32)
+
+DWORD WINAPI b2ThreadPoolState::Routine(LPVOID parameter)
+{
+	b2ThreadPoolWorker* worker = (b2ThreadPoolWorker*)parameter;
+	worker->pool->m_state->WorkerLoop(*worker);
+	return 0;
+}
+
+void b2ThreadPoolState::WorkerLoop(const b2ThreadPoolWorker& worker)
+{
+	for (;;)
+	{
+		// Run releases one count per worker. A worker that finishes early may
+		// take a second count of the same batch; it then finds no task left and
+		// still signs off once, so the batch ends after workerCount sign-offs.
+		WaitForSingleObject(start, INFINITE);
+		if (stopping)
+		{
+			break;
+		}
+
+		worker.pool->Execute(worker.index);
+
+		if (InterlockedDecrement(&busyWorkers) == 0)
+		{
+			SetEvent(done);
+		}
+	}
+}
+
+#else
+
+void* b2ThreadPoolState::Routine(void* parameter)
+{
+	b2ThreadPoolWorker* worker = (b2ThreadPoolWorker*)parameter;
+	worker->pool->m_state->WorkerLoop(*worker);
+	return NULL;
+}
+
+void b2ThreadPoolState::WorkerLoop(const b2ThreadPoolWorker& worker)
+{
+	int32 seenGeneration = 0;
+	pthread_mutex_lock(&mutex);
+	for (;;)
+	{
+		while (generation == seenGeneration && stopping == false)
+		{
+			pthread_cond_wait(&start, &mutex);
+		}
+
+		if (stopping)
+		{
+			break;
+		}
+
+		seenGeneration = generation;
+		pthread_mutex_unlock(&mutex);
+
+		worker.pool->Execute(worker.index);
+
+		pthread_mutex_lock(&mutex);
+		if (--busyWorkers == 0)
+		{
+			pthread_cond_signal(&done);
+		}
+	}
+	pthread_mutex_unlock(&mutex);
+}
+
+#endif
+
+b2ThreadPool::b2ThreadPool(int32 threadCount)
+{
+	m_threadCount = b2Max(threadCount, 1);
+
+	m_state = (b2ThreadPoolState*)b2Alloc(sizeof(b2ThreadPoolState));
+	b2ThreadPoolState* state = new (m_state) b2ThreadPoolState;
+	state->workerCount = m_threadCount - 1;
+	state->callback = NULL;
+	state->context = NULL;
+	state->taskCount = 0;
+	state->nextTask = 0;
+	state->busyWorkers = 0;
+	state->stopping = false;
+
+	state->workers = (b2ThreadPoolWorker*)b2Alloc(b2Max(state->workerCount, 1) * sizeof(b2ThreadPoolWorker));
+
+#if defined(WIN32)
+	state->threads = (HANDLE*)b2Alloc(b2Max(state->workerCount, 1) * sizeof(HANDLE));
+	state->start = CreateSemaphore(NULL, 0, state->workerCount + 1, NULL);
+	state->done = CreateEvent(NULL, FALSE, FALSE, NULL);
+#else
+	state->threads = (pthread_t*)b2Alloc(b2Max(state->workerCount, 1) * sizeof(pthread_t));
+	pthread_mutex_init(&state->mutex, NULL);
+	pthread_cond_init(&state->start, NULL);
+	pthread_cond_init(&state->done, NULL);
+	state->generation = 0;
+#endif
+
+	int32 started = 0;
+	for (int32 i = 0; i < state->workerCount; ++i)
+	{
+		state->workers[i].pool = this;
+		state->workers[i].index = i + 1;
+#if defined(WIN32)
+		state->threads[i] = CreateThread(NULL, 0, b2ThreadPoolState::Routine, &state->workers[i], 0, NULL);
+		if (state->threads[i] == NULL)
+		{
+			break;
+		}
+#else
+		if (pthread_create(&state->threads[i], NULL, b2ThreadPoolState::Routine, &state->workers[i]) != 0)
+		{
+			break;
+		}
+#endif
+		++started;
+	}
+
+	// Carry on with whatever could be started.
+	state->workerCount = started;
+	m_threadCount = started + 1;
+}
+
+b2ThreadPool::~b2ThreadPool()
+{
+	b2ThreadPoolState* state = m_state;
+
+#if defined(WIN32)
+	state->stopping = true;
+	ReleaseSemaphore(state->start, state->workerCount, NULL);
+	for (int32 i = 0; i < state->workerCount; ++i)
+	{
+		WaitForSingleObject(state->threads[i], INFINITE);
+		CloseHandle(state->threads[i]);
+	}
+	CloseHandle(state->done);
+	CloseHandle(state->start);
+#else
+	pthread_mutex_lock(&state->mutex);
+	state->stopping = true;
+	pthread_cond_broadcast(&state->start);
+	pthread_mutex_unlock(&state->mutex);
+	for (int32 i = 0; i < state->workerCount; ++i)
+	{
+		pthread_join(state->threads[i], NULL);
+	}
+	pthread_cond_destroy(&state->done);
+	pthread_cond_destroy(&state->start);
+	pthread_mutex_destroy(&state->mutex);
+#endif
+
+	b2Free(state->threads);
+	b2Free(state->workers);
+	state->~b2ThreadPoolState();
+	b2Free(state);
+}
+
+int32 b2ThreadPool::GetThreadCount() const
+{
+	return m_threadCount;
+}
+
+void b2ThreadPool::Run(b2TaskCallback* callback, void* context, int32 taskCount)
+{
+	if (taskCount <= 0)
+	{
+		return;
+	}
+
+	b2ThreadPoolState* state = m_state;
+	if (state->workerCount == 0 || taskCount == 1)
+	{
+		for (int32 i = 0; i < taskCount; ++i)
+		{
+			callback(context, i, 0);
+		}
+		return;
+	}
+
+	state->callback = callback;
+	state->context = context;
+	state->taskCount = taskCount;
+	state->nextTask = 0;
+
+#if defined(WIN32)
+	state->busyWorkers = state->workerCount;
+	ReleaseSemaphore(state->start, state->workerCount, NULL);
+
+	Execute(0);
+
+	WaitForSingleObject(state->done, INFINITE);
+#else
+	pthread_mutex_lock(&state->mutex);
+	state->busyWorkers = state->workerCount;
+	++state->generation;
+	pthread_cond_broadcast(&state->start);
+	pthread_mutex_unlock(&state->mutex);
+
+	Execute(0);
+
+	pthread_mutex_lock(&state->mutex);
+	while (state->busyWorkers > 0)
+	{
+		pthread_cond_wait(&state->done, &state->mutex);
+	}
+	pthread_mutex_unlock(&state->mutex);
+#endif
+}
+
+void b2ThreadPool::Execute(int32 threadIndex)
+{
+	b2ThreadPoolState* state = m_state;
+	for (;;)
+	{
+		int32 task = int32(b2AtomicIncrement(&state->nextTask) - 1);
+		if (task >= state->taskCount)
+		{
+			break;
+		}
+
+		state->callback(state->context, task, threadIndex);
+	}
+}
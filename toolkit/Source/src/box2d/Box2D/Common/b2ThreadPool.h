@@ -0,0 +1,55 @@
+/*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef B2_THREAD_POOL_H
+#define B2_THREAD_POOL_H
+
+#include <Box2D/Common/b2Settings.h>
+
+struct b2ThreadPoolState;
+
+/// Runs batches of independent tasks on a few worker threads together with
+/// the calling thread. Tasks are handed out one at a time through an atomic
+/// counter, so which thread runs a task is not predictable.
+class b2ThreadPool
+{
+public:
+
+	/// Called once per task. Thread 0 is the thread that called Run.
+	typedef void b2TaskCallback(void* context, int32 taskIndex, int32 threadIndex);
+
+	/// Starts threadCount - 1 worker threads.
+	b2ThreadPool(int32 threadCount);
+	~b2ThreadPool();
+
+	/// The number of threads taking part in a batch, including the caller.
+	int32 GetThreadCount() const;
+
+	/// Run every task in [0, taskCount) and return once all of them are done.
+	/// Not reentrant: only one batch may be running at a time.
+	void Run(b2TaskCallback* callback, void* context, int32 taskCount);
+
+private:
+
+	friend struct b2ThreadPoolState;
+
+	void Execute(int32 threadIndex);
+
+	b2ThreadPoolState* m_state;
+	int32 m_threadCount;
+};
+
+#endif
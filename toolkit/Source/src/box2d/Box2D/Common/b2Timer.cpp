@@ -72,14 +72,16 @@ void b2Timer::Reset()
     timeval t;
     gettimeofday(&t, 0);
     m_start_sec = t.tv_sec;
-    m_start_msec = t.tv_usec * 0.001f;
+    m_start_usec = t.tv_usec;
 }
 
 float32 b2Timer::GetMilliseconds() const
 {
     timeval t;
     gettimeofday(&t, 0);
-    return (t.tv_sec - m_start_sec) * 1000 + t.tv_usec * 0.001f - m_start_msec;
+    // keep the microseconds: truncating the start to whole milliseconds made every
+    // reading up to 1 ms too long, which swamps the sub-millisecond solver timings
+    return (t.tv_sec - m_start_sec) * 1000 + (static_cast<long>(t.tv_usec) - static_cast<long>(m_start_usec)) * 0.001f;
 }
 
 #else
@@ -25,6 +25,7 @@
 
 class b2Contact;
 class b2Body;
+class b2Island;
 class b2StackAllocator;
 struct b2ContactPositionConstraint;
 
@@ -63,6 +64,7 @@ struct b2ContactSolverDef
 	b2Position* positions;
 	b2Velocity* velocities;
 	b2StackAllocator* allocator;
+	const b2Island* island;
 };
 
 class b2ContactSolver
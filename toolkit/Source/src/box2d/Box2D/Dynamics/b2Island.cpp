@@ -26,6 +26,7 @@
 #include <Box2D/Dynamics/Joints/b2Joint.h>
 #include <Box2D/Common/b2StackAllocator.h>
 #include <Box2D/Common/b2Timer.h>
+#include <algorithm>
 
 /*
 Position Correction Notes
@@ -168,10 +169,75 @@ b2Island::b2Island(
 
 	m_velocities = (b2Velocity*)m_allocator->Allocate(m_bodyCapacity * sizeof(b2Velocity));
 	m_positions = (b2Position*)m_allocator->Allocate(m_bodyCapacity * sizeof(b2Position));
+
+	m_statics = NULL;
+	m_staticCount = 0;
+	m_concurrent = false;
+}
+
+static bool b2CompareStaticIndex(const b2IslandStaticIndex& a, const b2IslandStaticIndex& b)
+{
+	return a.body < b.body;
+}
+
+b2Island::b2Island(const b2Island& collection, const b2IslandRange& range, b2StackAllocator* allocator)
+{
+	m_bodyCapacity = range.bodyCount;
+	m_contactCapacity = range.contactCount;
+	m_jointCapacity = range.jointCount;
+	m_bodyCount = range.bodyCount;
+	m_contactCount = range.contactCount;
+	m_jointCount = range.jointCount;
+
+	m_allocator = allocator;
+	m_listener = NULL;
+
+	m_bodies = collection.m_bodies + range.bodyStart;
+	m_contacts = collection.m_contacts + range.contactStart;
+	m_joints = collection.m_joints + range.jointStart;
+	m_velocities = collection.m_velocities + range.bodyStart;
+	m_positions = collection.m_positions + range.bodyStart;
+
+	m_staticCount = 0;
+	for (int32 i = 0; i < m_bodyCount; ++i)
+	{
+		if (m_bodies[i]->m_type == b2_staticBody)
+		{
+			++m_staticCount;
+		}
+	}
+
+	m_statics = (b2IslandStaticIndex*)m_allocator->Allocate(m_staticCount * sizeof(b2IslandStaticIndex));
+	m_concurrent = true;
+
+	// Other bodies belong to this island alone, so their index can be rewritten.
+	int32 staticIndex = 0;
+	for (int32 i = 0; i < m_bodyCount; ++i)
+	{
+		b2Body* b = m_bodies[i];
+		if (b->m_type == b2_staticBody)
+		{
+			m_statics[staticIndex].body = b;
+			m_statics[staticIndex].index = i;
+			++staticIndex;
+		}
+		else
+		{
+			b->m_islandIndex = i;
+		}
+	}
+
+	std::sort(m_statics, m_statics + m_staticCount, b2CompareStaticIndex);
 }
 
 b2Island::~b2Island()
 {
+	if (m_concurrent)
+	{
+		m_allocator->Free(m_statics);
+		return;
+	}
+
 	// Warning: the order should reverse the constructor order.
 	m_allocator->Free(m_positions);
 	m_allocator->Free(m_velocities);
@@ -180,6 +246,31 @@ b2Island::~b2Island()
 	m_allocator->Free(m_bodies);
 }
 
+int32 b2Island::FindStaticIndex(const b2Body* body) const
+{
+	int32 low = 0;
+	int32 high = m_staticCount - 1;
+	while (low <= high)
+	{
+		int32 mid = (low + high) >> 1;
+		if (m_statics[mid].body < body)
+		{
+			low = mid + 1;
+		}
+		else if (body < m_statics[mid].body)
+		{
+			high = mid - 1;
+		}
+		else
+		{
+			return m_statics[mid].index;
+		}
+	}
+
+	b2Assert(false);
+	return body->m_islandIndex;
+}
+
 void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& gravity, bool allowSleep)
 {
 	b2Timer timer;
@@ -197,8 +288,11 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 		float32 w = b->m_angularVelocity;
 
 		// Store positions for continuous collision.
-		b->m_sweep.c0 = b->m_sweep.c;
-		b->m_sweep.a0 = b->m_sweep.a;
+		if (IsShared(b) == false)
+		{
+			b->m_sweep.c0 = b->m_sweep.c;
+			b->m_sweep.a0 = b->m_sweep.a;
+		}
 
 		if (b->m_type == b2_dynamicBody)
 		{
@@ -230,6 +324,7 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 	solverData.step = step;
 	solverData.positions = m_positions;
 	solverData.velocities = m_velocities;
+	solverData.island = this;
 
 	// Initialize velocity constraints.
 	b2ContactSolverDef contactSolverDef;
@@ -239,6 +334,7 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 	contactSolverDef.positions = m_positions;
 	contactSolverDef.velocities = m_velocities;
 	contactSolverDef.allocator = m_allocator;
+	contactSolverDef.island = this;
 
 	b2ContactSolver contactSolver(&contactSolverDef);
 	contactSolver.InitializeVelocityConstraints();
@@ -326,10 +422,15 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 		}
 	}
 
-	// Copy state buffers back to the bodies
+	// Copy state buffers back to the bodies. Static bodies did not move.
 	for (int32 i = 0; i < m_bodyCount; ++i)
 	{
 		b2Body* body = m_bodies[i];
+		if (IsShared(body))
+		{
+			continue;
+		}
+
 		body->m_sweep.c = m_positions[i].c;
 		body->m_sweep.a = m_positions[i].a;
 		body->m_linearVelocity = m_velocities[i].v;
@@ -372,10 +473,14 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 
 		if (minSleepTime >= b2_timeToSleep && positionSolved)
 		{
+			// b2World puts shared static bodies to sleep in island order.
 			for (int32 i = 0; i < m_bodyCount; ++i)
 			{
 				b2Body* b = m_bodies[i];
-				b->SetAwake(false);
+				if (IsShared(b) == false)
+				{
+					b->SetAwake(false);
+				}
 			}
 		}
 	}
@@ -403,6 +508,7 @@ void b2Island::SolveTOI(const b2TimeStep& subStep, int32 toiIndexA, int32 toiInd
 	contactSolverDef.step = subStep;
 	contactSolverDef.positions = m_positions;
 	contactSolverDef.velocities = m_velocities;
+	contactSolverDef.island = this;
 	b2ContactSolver contactSolver(&contactSolverDef);
 
 	// Solve position constraints.
@@ -28,7 +28,26 @@ class b2Joint;
 class b2StackAllocator;
 class b2ContactListener;
 struct b2ContactVelocityConstraint;
-struct b2Profile;
+
+/// One island out of a collection, recorded by b2World when islands are
+/// solved concurrently. This is an internal structure.
+struct b2IslandRange
+{
+	int32 bodyStart;
+	int32 bodyCount;
+	int32 contactStart;
+	int32 contactCount;
+	int32 jointStart;
+	int32 jointCount;
+	b2Profile profile;
+};
+
+/// This is an internal structure.
+struct b2IslandStaticIndex
+{
+	const b2Body* body;
+	int32 index;
+};
 
 /// This is an internal class.
 class b2Island
@@ -36,6 +55,13 @@ class b2Island
 public:
 	b2Island(int32 bodyCapacity, int32 contactCapacity, int32 jointCapacity,
 			b2StackAllocator* allocator, b2ContactListener* listener);
+
+	/// Wraps one island out of a collection so it can be solved concurrently with
+	/// the others. The body, contact, joint and state arrays are shared with the
+	/// collection; the allocator only serves this island's solver. Static bodies
+	/// are left untouched and contacts are not reported.
+	b2Island(const b2Island& collection, const b2IslandRange& range, b2StackAllocator* allocator);
+
 	~b2Island();
 
 	void Clear()
@@ -71,6 +97,25 @@ public:
 
 	void Report(const b2ContactVelocityConstraint* constraints);
 
+	/// Index of a body in the solver arrays. A static body may be part of several
+	/// islands solved at the same time, so its index is looked up per island.
+	int32 GetIndex(const b2Body* body) const
+	{
+		if (m_staticCount == 0 || body->m_type != b2_staticBody)
+		{
+			return body->m_islandIndex;
+		}
+		return FindStaticIndex(body);
+	}
+
+	int32 FindStaticIndex(const b2Body* body) const;
+
+	/// Concurrent islands must not write to static bodies they share.
+	bool IsShared(const b2Body* body) const
+	{
+		return m_concurrent && body->m_type == b2_staticBody;
+	}
+
 	b2StackAllocator* m_allocator;
 	b2ContactListener* m_listener;
 
@@ -88,6 +133,10 @@ public:
 	int32 m_bodyCapacity;
 	int32 m_contactCapacity;
 	int32 m_jointCapacity;
+
+	b2IslandStaticIndex* m_statics;
+	int32 m_staticCount;
+	bool m_concurrent;
 };
 
 #endif
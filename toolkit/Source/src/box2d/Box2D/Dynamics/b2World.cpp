@@ -32,6 +32,8 @@
 #include <Box2D/Collision/b2TimeOfImpact.h>
 #include <Box2D/Common/b2Draw.h>
 #include <Box2D/Common/b2Timer.h>
+#include <Box2D/Common/b2ThreadPool.h>
+#include <algorithm>
 #include <new>
 
 b2World::b2World(const b2Vec2& gravity, bool doSleep)
@@ -61,10 +63,15 @@ b2World::b2World(const b2Vec2& gravity, bool doSleep)
 	m_contactManager.m_allocator = &m_blockAllocator;
 
 	memset(&m_profile, 0, sizeof(b2Profile));
+
+	m_threadPool = NULL;
+	m_threadAllocators = NULL;
 }
 
 b2World::~b2World()
 {
+	SetSolverThreadCount(1);
+
 	// Some shapes allocate using b2Alloc.
 	b2Body* b = m_bodyList;
 	while (b)
@@ -104,6 +111,57 @@ void b2World::SetDebugDraw(b2Draw* debugDraw)
 	m_debugDraw = debugDraw;
 }
 
+void b2World::SetSolverThreadCount(int32 count)
+{
+	b2Assert(IsLocked() == false);
+	if (IsLocked())
+	{
+		return;
+	}
+
+	count = b2Max(count, 1);
+	if (count == GetSolverThreadCount())
+	{
+		return;
+	}
+
+	if (m_threadPool)
+	{
+		int32 workerCount = m_threadPool->GetThreadCount() - 1;
+		for (int32 i = 0; i < workerCount; ++i)
+		{
+			m_threadAllocators[i].~b2StackAllocator();
+		}
+		b2Free(m_threadAllocators);
+		m_threadAllocators = NULL;
+
+		m_threadPool->~b2ThreadPool();
+		b2Free(m_threadPool);
+		m_threadPool = NULL;
+	}
+
+	if (count == 1)
+	{
+		return;
+	}
+
+	void* mem = b2Alloc(sizeof(b2ThreadPool));
+	m_threadPool = new (mem) b2ThreadPool(count);
+
+	// The pool may have started fewer threads than asked for.
+	int32 workerCount = m_threadPool->GetThreadCount() - 1;
+	m_threadAllocators = (b2StackAllocator*)b2Alloc(b2Max(workerCount, 1) * sizeof(b2StackAllocator));
+	for (int32 i = 0; i < workerCount; ++i)
+	{
+		new (m_threadAllocators + i) b2StackAllocator;
+	}
+}
+
+int32 b2World::GetSolverThreadCount() const
+{
+	return m_threadPool ? m_threadPool->GetThreadCount() : 1;
+}
+
 b2Body* b2World::CreateBody(const b2BodyDef* def)
 {
 	b2Assert(IsLocked() == false);
@@ -371,8 +429,18 @@ void b2World::Solve(const b2TimeStep& step)
 	m_profile.solveVelocity = 0.0f;
 	m_profile.solvePosition = 0.0f;
 
+	// When islands are solved concurrently they are all collected into this one
+	// first. Static bodies can then appear once per island touching them, but
+	// never more often than the contacts and joints that lead to them.
+	const bool concurrent = (m_threadPool != NULL);
+	int32 bodyCapacity = m_bodyCount;
+	if (concurrent)
+	{
+		bodyCapacity += m_contactManager.m_contactCount + m_jointCount;
+	}
+
 	// Size the island for the worst case.
-	b2Island island(m_bodyCount,
+	b2Island island(bodyCapacity,
 					m_contactManager.m_contactCount,
 					m_jointCount,
 					&m_stackAllocator,
@@ -395,6 +463,13 @@ void b2World::Solve(const b2TimeStep& step)
 	// Build and simulate all awake islands.
 	int32 stackSize = m_bodyCount;
 	b2Body** stack = (b2Body**)m_stackAllocator.Allocate(stackSize * sizeof(b2Body*));
+	b2IslandRange* ranges = NULL;
+	int32 rangeCount = 0;
+	if (concurrent)
+	{
+		ranges = (b2IslandRange*)m_stackAllocator.Allocate(m_bodyCount * sizeof(b2IslandRange));
+	}
+
 	for (b2Body* seed = m_bodyList; seed; seed = seed->m_next)
 	{
 		if (seed->m_flags & b2Body::e_islandFlag)
@@ -414,7 +489,13 @@ void b2World::Solve(const b2TimeStep& step)
 		}
 
 		// Reset island and stack.
-		island.Clear();
+		if (concurrent == false)
+		{
+			island.Clear();
+		}
+		int32 bodyStart = island.m_bodyCount;
+		int32 contactStart = island.m_contactCount;
+		int32 jointStart = island.m_jointCount;
 		int32 stackCount = 0;
 		stack[stackCount++] = seed;
 		seed->m_flags |= b2Body::e_islandFlag;
@@ -509,14 +590,27 @@ void b2World::Solve(const b2TimeStep& step)
 			}
 		}
 
-		b2Profile profile;
-		island.Solve(&profile, step, m_gravity, m_allowSleep);
-		m_profile.solveInit += profile.solveInit;
-		m_profile.solveVelocity += profile.solveVelocity;
-		m_profile.solvePosition += profile.solvePosition;
+		if (concurrent)
+		{
+			b2IslandRange* range = ranges + rangeCount++;
+			range->bodyStart = bodyStart;
+			range->bodyCount = island.m_bodyCount - bodyStart;
+			range->contactStart = contactStart;
+			range->contactCount = island.m_contactCount - contactStart;
+			range->jointStart = jointStart;
+			range->jointCount = island.m_jointCount - jointStart;
+		}
+		else
+		{
+			b2Profile profile;
+			island.Solve(&profile, step, m_gravity, m_allowSleep);
+			m_profile.solveInit += profile.solveInit;
+			m_profile.solveVelocity += profile.solveVelocity;
+			m_profile.solvePosition += profile.solvePosition;
+		}
 
 		// Post solve cleanup.
-		for (int32 i = 0; i < island.m_bodyCount; ++i)
+		for (int32 i = bodyStart; i < island.m_bodyCount; ++i)
 		{
 			// Allow static bodies to participate in other islands.
 			b2Body* b = island.m_bodies[i];
@@ -527,6 +621,12 @@ void b2World::Solve(const b2TimeStep& step)
 		}
 	}
 
+	if (concurrent)
+	{
+		SolveIslands(island, ranges, rangeCount, step);
+		m_stackAllocator.Free(ranges);
+	}
+
 	m_stackAllocator.Free(stack);
 
 	{
@@ -555,6 +655,118 @@ void b2World::Solve(const b2TimeStep& step)
 	}
 }
 
+struct b2IslandTaskContext
+{
+	const b2Island* collection;
+	b2IslandRange* ranges;
+	const int32* order;
+	b2StackAllocator* callerAllocator;
+	b2StackAllocator* workerAllocators;
+	b2TimeStep step;
+	b2Vec2 gravity;
+	bool allowSleep;
+};
+
+static void b2SolveIslandTask(void* context, int32 taskIndex, int32 threadIndex)
+{
+	b2IslandTaskContext* ctx = (b2IslandTaskContext*)context;
+	b2IslandRange* range = ctx->ranges + ctx->order[taskIndex];
+	b2StackAllocator* allocator = (threadIndex == 0) ? ctx->callerAllocator : ctx->workerAllocators + (threadIndex - 1);
+
+	b2Island island(*ctx->collection, *range, allocator);
+	island.Solve(&range->profile, ctx->step, ctx->gravity, ctx->allowSleep);
+}
+
+// Largest islands first, so that a big one does not start last and keep
+// the other threads waiting.
+struct b2IslandSizeGreater
+{
+	const b2IslandRange* ranges;
+
+	bool operator()(int32 a, int32 b) const
+	{
+		int32 sizeA = ranges[a].bodyCount + ranges[a].contactCount + ranges[a].jointCount;
+		int32 sizeB = ranges[b].bodyCount + ranges[b].contactCount + ranges[b].jointCount;
+		if (sizeA != sizeB)
+		{
+			return sizeA > sizeB;
+		}
+		return a < b;
+	}
+};
+
+// Solve the collected islands on the thread pool. Each island only writes to
+// its own bodies, contacts and joints, so the outcome does not depend on which
+// thread solves it or when. Everything an island shares with the others or
+// hands to the user is applied here afterwards, in the order the islands were
+// found, the same order the sequential solver uses.
+void b2World::SolveIslands(const b2Island& collection, b2IslandRange* ranges, int32 rangeCount, const b2TimeStep& step)
+{
+	int32* order = (int32*)m_stackAllocator.Allocate(rangeCount * sizeof(int32));
+	for (int32 i = 0; i < rangeCount; ++i)
+	{
+		order[i] = i;
+	}
+	b2IslandSizeGreater greater;
+	greater.ranges = ranges;
+	std::sort(order, order + rangeCount, greater);
+
+	b2IslandTaskContext context;
+	context.collection = &collection;
+	context.ranges = ranges;
+	context.order = order;
+	context.callerAllocator = &m_stackAllocator;
+	context.workerAllocators = m_threadAllocators;
+	context.step = step;
+	context.gravity = m_gravity;
+	context.allowSleep = m_allowSleep;
+	m_threadPool->Run(b2SolveIslandTask, &context, rangeCount);
+
+	m_stackAllocator.Free(order);
+
+	b2ContactListener* listener = m_contactManager.m_contactListener;
+	for (int32 i = 0; i < rangeCount; ++i)
+	{
+		const b2IslandRange& range = ranges[i];
+		m_profile.solveInit += range.profile.solveInit;
+		m_profile.solveVelocity += range.profile.solveVelocity;
+		m_profile.solvePosition += range.profile.solvePosition;
+
+		// The seed comes first and is never static, so it tells whether the
+		// island fell asleep. Its static bodies follow the last island touching them.
+		b2Body** bodies = collection.m_bodies + range.bodyStart;
+		bool awake = bodies[0]->IsAwake();
+		for (int32 j = 1; j < range.bodyCount; ++j)
+		{
+			if (bodies[j]->GetType() == b2_staticBody)
+			{
+				bodies[j]->SetAwake(awake);
+			}
+		}
+
+		// StoreImpulses left the solved impulses in the manifolds.
+		if (listener)
+		{
+			b2Contact** contacts = collection.m_contacts + range.contactStart;
+			for (int32 j = 0; j < range.contactCount; ++j)
+			{
+				b2Contact* c = contacts[j];
+				const b2Manifold* manifold = c->GetManifold();
+
+				b2ContactImpulse impulse;
+				impulse.count = manifold->pointCount;
+				for (int32 k = 0; k < manifold->pointCount; ++k)
+				{
+					impulse.normalImpulses[k] = manifold->points[k].normalImpulse;
+					impulse.tangentImpulses[k] = manifold->points[k].tangentImpulse;
+				}
+
+				listener->PostSolve(c, &impulse);
+			}
+		}
+	}
+}
+
 // Find TOI contacts and solve them.
 void b2World::SolveTOI(const b2TimeStep& step)
 {
@@ -880,6 +1092,11 @@ void b2World::Step(float32 dt, int32 velocityIterations, int32 positionIteration
 {
 	b2Timer stepTimer;
 
+	if (m_contactManager.m_broadPhase.IsBulkInserting())
+	{
+		EndBulkLoad();
+	}
+
 	// If new fixtures were added, we need to find the new contacts.
 	if (m_flags & e_newFixture)
 	{
@@ -1237,3 +1454,24 @@ float32 b2World::GetTreeQuality() const
 {
 	return m_contactManager.m_broadPhase.GetTreeQuality();
 }
+
+void b2World::BeginBulkLoad()
+{
+	m_contactManager.m_broadPhase.BeginBulkInsert();
+}
+
+void b2World::EndBulkLoad()
+{
+	m_contactManager.m_broadPhase.EndBulkInsert();
+}
+
+void b2World::RebuildBroadPhase()
+{
+	b2Assert(IsLocked() == false);
+	if (IsLocked())
+	{
+		return;
+	}
+
+	m_contactManager.m_broadPhase.RebuildTree();
+}
@@ -34,6 +34,9 @@ class b2Body;
 class b2Draw;
 class b2Fixture;
 class b2Joint;
+class b2Island;
+class b2ThreadPool;
+struct b2IslandRange;
 
 /// The world class manages all physics entities, dynamic simulation,
 /// and asynchronous queries. The world also contains efficient memory
@@ -151,6 +154,17 @@ public:
 	/// Enable/disable single stepped continuous physics. For testing.
 	void SetSubStepping(bool flag) { m_subStepping = flag; }
 
+	/// Solve awake islands on this many threads, the calling one included.
+	/// All islands are found first and then solved concurrently, each thread
+	/// with its own stack allocator. Contact reports and sleep state shared
+	/// through static bodies are applied afterwards in island order, so the
+	/// result does not depend on the thread count. 1 (the default) solves
+	/// every island on the calling thread as it is found.
+	void SetSolverThreadCount(int32 count);
+
+	/// Get the number of threads islands are solved on.
+	int32 GetSolverThreadCount() const;
+
 	/// Get the number of broad-phase proxies.
 	int32 GetProxyCount() const;
 
@@ -173,6 +187,17 @@ public:
 	/// The minimum is 1.
 	float32 GetTreeQuality() const;
 
+	/// Use this around the creation of many bodies, such as a level load.
+	/// New fixtures stay out of the broad-phase tree until EndBulkLoad, which
+	/// builds the whole tree at once. Queries and ray casts in between do not
+	/// see them. Step ends a bulk load that is still open.
+	void BeginBulkLoad();
+	void EndBulkLoad();
+
+	/// Rebuild the broad-phase tree from scratch, for instance after many
+	/// fixtures were destroyed or moved far.
+	void RebuildBroadPhase();
+
 	/// Change the global gravity vector.
 	void SetGravity(const b2Vec2& gravity);
 	
@@ -210,6 +235,7 @@ private:
 	friend class b2Controller;
 
 	void Solve(const b2TimeStep& step);
+	void SolveIslands(const b2Island& collection, b2IslandRange* ranges, int32 rangeCount, const b2TimeStep& step);
 	void SolveTOI(const b2TimeStep& step);
 
 	void DrawJoint(b2Joint* joint);
@@ -246,6 +272,11 @@ private:
 	bool m_stepComplete;
 
 	b2Profile m_profile;
+
+	// Only created when islands are solved concurrently, with one stack
+	// allocator per worker thread.
+	b2ThreadPool* m_threadPool;
+	b2StackAllocator* m_threadAllocators;
 };
 
 inline b2Body* b2World::GetBodyList()
@@ -17,6 +17,7 @@ commonSources := \
 	Box2D/Common/b2Draw.cpp \
 	Box2D/Common/b2Settings.cpp \
 	Box2D/Common/b2StackAllocator.cpp \
+	Box2D/Common/b2ThreadPool.cpp \
 	Box2D/Dynamics/b2Body.cpp \
 	Box2D/Dynamics/b2ContactManager.cpp \
 	Box2D/Dynamics/b2Fixture.cpp \
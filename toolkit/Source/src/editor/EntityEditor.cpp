@@ -1269,7 +1269,7 @@ bool EntityEditor::CheckForFileUpdate()
 void EntityEditor::CreateFileUpdateDetector(const str_type::string& fullFilePath)
 {
 	m_fileChangeDetector = ETHFileChangeDetectorPtr(
-		new ETHFileChangeDetector(m_provider->GetVideo(), fullFilePath, ETHFileChangeDetector::UTF16_WITH_BOM));
+		new ETHFileChangeDetector(fullFilePath));
 	if (!m_fileChangeDetector->IsValidFile())
 		m_fileChangeDetector.reset();
 }
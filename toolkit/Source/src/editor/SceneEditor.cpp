@@ -442,7 +442,7 @@ bool SceneEditor::CheckForFileUpdate()
 void SceneEditor::CreateFileUpdateDetector(const str_type::string& fullFilePath)
 {
 	m_fileChangeDetector = ETHFileChangeDetectorPtr(
-		new ETHFileChangeDetector(m_provider->GetVideo(), fullFilePath, ETHFileChangeDetector::UTF16_WITH_BOM));
+		new ETHFileChangeDetector(fullFilePath));
 	if (!m_fileChangeDetector->IsValidFile())
 		m_fileChangeDetector.reset();
 }
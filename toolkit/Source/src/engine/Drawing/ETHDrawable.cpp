@@ -38,7 +38,7 @@ ETHTextDrawer::ETHTextDrawer(
 	this->font = font;
 	this->color = color;
 	this->timeMS = time;
-	this->elapsedTimeMS = 0;
+	this->elapsedTimeMS = 0.0f;
 	this->provider = provider;
 	this->scale = scale;
 }
@@ -56,19 +56,19 @@ ETHTextDrawer::ETHTextDrawer(
 	this->font = font;
 	this->color = color;
 	this->timeMS = 0;
-	this->elapsedTimeMS = 0;
+	this->elapsedTimeMS = 0.0f;
 	this->provider = provider;
 	this->scale = scale;
 }
 
-bool ETHTextDrawer::Draw(const unsigned long lastFrameElapsedTimeMS)
+bool ETHTextDrawer::Draw(const float lastFrameElapsedTimeMS)
 {
 	elapsedTimeMS += lastFrameElapsedTimeMS;
 	Color color = this->color;
 
 	if (timeMS > 0)
 	{
-		const float fade = 1.0f - Clamp((float)elapsedTimeMS / (float)this->timeMS, 0.0f, 1.0f);
+		const float fade = 1.0f - Clamp(elapsedTimeMS / (float)this->timeMS, 0.0f, 1.0f);
 		color.a = (GS_BYTE)(fade * 255.0f);
 	}
 	return provider->GetVideo()->DrawBitmapText(v2Pos, text, font, color, scale);
@@ -115,7 +115,7 @@ ETHRectangleDrawer::ETHRectangleDrawer(
 	this->provider = provider;
 }
 
-bool ETHRectangleDrawer::Draw(const unsigned long lastFrameElapsedTimeMS)
+bool ETHRectangleDrawer::Draw(const float lastFrameElapsedTimeMS)
 {
 	GS2D_UNUSED_ARGUMENT(lastFrameElapsedTimeMS);
 	return provider->GetVideo()->DrawRectangle(v2Pos, v2Size, color0, color1, color2, color3, 0.0f);
@@ -142,7 +142,7 @@ ETHLineDrawer::ETHLineDrawer(
 	this->provider = provider;
 }
 
-bool ETHLineDrawer::Draw(const unsigned long lastFrameElapsedTimeMS)
+bool ETHLineDrawer::Draw(const float lastFrameElapsedTimeMS)
 {
 	GS2D_UNUSED_ARGUMENT(lastFrameElapsedTimeMS);
 	VideoPtr video = provider->GetVideo();
@@ -179,7 +179,7 @@ ETHSpriteDrawer::ETHSpriteDrawer(
 		this->v2Origin = sprite->GetOrigin();
 }
 
-bool ETHSpriteDrawer::Draw(const unsigned long lastFrameElapsedTimeMS)
+bool ETHSpriteDrawer::Draw(const float lastFrameElapsedTimeMS)
 {
 	GS2D_UNUSED_ARGUMENT(lastFrameElapsedTimeMS);
 	if (sprite)
@@ -29,7 +29,7 @@
 class ETHDrawable
 {
 public:
-	virtual bool Draw(const unsigned long lastFrameElapsedTimeMS) = 0;
+	virtual bool Draw(const float lastFrameElapsedTimeMS) = 0;
 	virtual bool IsAlive() const = 0;
 };
 
@@ -53,7 +53,7 @@ public:
 		const GS_DWORD color,
 		const float scale);
 
-	bool Draw(const unsigned long lastFrameElapsedTimeMS);
+	bool Draw(const float lastFrameElapsedTimeMS);
 	bool IsAlive() const;
 
 private:
@@ -62,7 +62,7 @@ private:
 	str_type::string font;
 	GS_DWORD color;
 	unsigned long timeMS;
-	unsigned long elapsedTimeMS;
+	float elapsedTimeMS;
 	float scale;
 	ETHResourceProviderPtr provider;
 };
@@ -85,7 +85,7 @@ public:
 		const Color& color2,
 		const Color& color3);
 
-	bool Draw(const unsigned long lastFrameElapsedTimeMS);
+	bool Draw(const float lastFrameElapsedTimeMS);
 	bool IsAlive() const;
 
 private:
@@ -107,7 +107,7 @@ public:
 		const Color& color1,
 		const float width);
 
-	bool Draw(const unsigned long lastFrameElapsedTimeMS);
+	bool Draw(const float lastFrameElapsedTimeMS);
 	bool IsAlive() const;
 
 private:
@@ -129,7 +129,7 @@ public:
 		const float angle,
 		const unsigned int frame);
 
-	bool Draw(const unsigned long lastFrameElapsedTimeMS);
+	bool Draw(const float lastFrameElapsedTimeMS);
 	bool IsAlive() const;
 
 private:
@@ -31,7 +31,7 @@ class ETHDrawableManager
 	std::list<boost::shared_ptr<ETHDrawable> > m_drawableList;
 
 public:
-	void DrawTopLayer(const unsigned long lastFrameElapsedTimeMS, const VideoPtr& video);
+	void DrawTopLayer(const float lastFrameElapsedTimeMS, const VideoPtr& video);
 	void Insert(const boost::shared_ptr<ETHDrawable>& newItem);
 	void Clear();
 	void RemoveTheDead();
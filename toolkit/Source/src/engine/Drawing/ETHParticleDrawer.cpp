@@ -22,33 +22,34 @@
 
 #include "ETHParticleDrawer.h"
 #include "../Resource/ETHResourceProvider.h"
-#include "../Resource/ETHDirectories.h"
 
 ETHParticleDrawer::ETHParticleDrawer(
 	const ETHResourceProviderPtr& provider,
-	ETHGraphicResourceManagerPtr graphicResources,
 	ETHShaderManagerPtr shaderManager,
-	const str_type::string& resourceDirectory,
+	const ETHParticleEffectPtr& effect,
 	const str_type::string& fileName,
 	const Vector2& pos,
 	const float angle,
 	const float scale) :
+	m_provider(provider),
+	m_effect(effect),
 	m_shaderManager(shaderManager),
 	m_pos(pos),
 	m_angle(angle),
-	m_provider(provider),
 	m_fileName(fileName)
 {
-	ETHParticleSystem particleSystem;
-	particleSystem.ReadFromFile(resourceDirectory + ETHDirectories::GetEffectsDirectory() + fileName, provider->GetFileManager());
 	const Vector2 startPos(m_pos + provider->GetVideo()->GetCameraPos());
-	m_particleManager = ETHParticleManagerPtr(
-		new ETHParticleManager(provider, particleSystem, startPos, Vector3(startPos, 0.0f), angle, scale));
+	m_particleManager = m_effect->Acquire(provider, startPos, angle, scale);
+}
+
+ETHParticleDrawer::~ETHParticleDrawer()
+{
+	m_effect->Recycle(m_particleManager);
 }
 
-bool ETHParticleDrawer::Draw(const unsigned long lastFrameElapsedTimeMS)
+bool ETHParticleDrawer::Draw(const float lastFrameElapsedTimeMS)
 {
-	m_particleManager->UpdateParticleSystem(m_pos, Vector3(m_pos, 0.0f), m_angle, static_cast<float>(lastFrameElapsedTimeMS));
+	m_particleManager->UpdateParticleSystem(m_pos, Vector3(m_pos, 0.0f), m_angle, lastFrameElapsedTimeMS);
 
 	if (m_shaderManager->BeginParticlePass(*m_particleManager->GetSystem()))
 	{
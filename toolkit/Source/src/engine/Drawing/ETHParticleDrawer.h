@@ -24,7 +24,7 @@
 #define ETH_PARTICLE_DRAWER_H_
 
 #include "ETHDrawable.h"
-#include "../Particles/ETHParticleManager.h"
+#include "../Particles/ETHParticleEffectCache.h"
 #include "../Shader/ETHShaderManager.h"
 
 class ETHParticleDrawer : public ETHDrawable
@@ -32,19 +32,22 @@ class ETHParticleDrawer : public ETHDrawable
 public:
 	ETHParticleDrawer(
 		const ETHResourceProviderPtr& provider,
-		ETHGraphicResourceManagerPtr graphicResources,
 		ETHShaderManagerPtr shaderManager,
-		const str_type::string& resourceDirectory,
+		const ETHParticleEffectPtr& effect,
 		const str_type::string& fileName,
 		const Vector2& pos,
 		const float angle,
 		const float scale);
 
-	bool Draw(const unsigned long lastFrameElapsedTimeMS);
+	/// Hands the particle manager back to its effect so the next spawn can restart it
+	~ETHParticleDrawer();
+
+	bool Draw(const float lastFrameElapsedTimeMS);
 	bool IsAlive() const;
 
 private:
 	ETHResourceProviderPtr m_provider;
+	ETHParticleEffectPtr m_effect;
 	ETHParticleManagerPtr m_particleManager;
 	ETHShaderManagerPtr m_shaderManager;
 	Vector2 m_pos;
@@ -69,6 +69,8 @@ ETHEngine::ETHEngine(const bool testing, const bool compileAndRun) :
 ETHEngine::~ETHEngine()
 {
 	m_pScene.reset(); // destroy the scene first, so the script engine is free to run garbage collection
+	ClearEntityPool();
+	ClearParticleEffectCache();
 	if (m_pScriptContext)
 	{
 		m_pScriptContext->Release();
@@ -76,6 +78,9 @@ ETHEngine::~ETHEngine()
 	}
 	m_pASEngine->Release();
 	m_pASEngine = 0;
+
+	// the script engine releases its JIT functions when destroyed, so the compiler must outlive it
+	m_jitCompiler.reset();
 }
 
 ETHResourceProviderPtr ETHEngine::GetProvider()
@@ -113,13 +118,28 @@ void ETHEngine::Start(VideoPtr video, InputPtr input, AudioPtr audio)
 	{
 		video->SetBGColor(gs2d::constant::BLACK);
 
+		m_frameLimiter.SetMaxFrameRate(file.GetMaxFrameRate());
+
 		GS2D_COUT << GS_L("AngelScript v") << asGetLibraryVersion() << GS_L(" options: ") << asGetLibraryOptions() << std::endl;
-		if (!PrepareScriptingEngine(file.GetDefinedWords()))
+		// "-jit" and "-nojit" on the command line override the app.enml setting
+		bool enableJIT = file.IsJITEnabled();
+		for (int t = 0; t < GetArgc(); t++)
+		{
+			const str_type::string arg = GetArgv(t);
+			if (arg == GS_L("-jit"))
+				enableJIT = true;
+			else if (arg == GS_L("-nojit"))
+				enableJIT = false;
+		}
+
+		if (!PrepareScriptingEngine(file.GetDefinedWords(), enableJIT))
 		{
 			Abort();
 			return;
 		}
 
+		PrepareEntityTemplates(file.IsEntityPreloadEnabled());
+
 		if (m_compileAndRun)
 		{
 			if (!RunMainFunction(GetMainFunction()))
@@ -141,13 +161,21 @@ void ETHEngine::Start(VideoPtr video, InputPtr input, AudioPtr audio)
 Application::APP_STATUS ETHEngine::Update(
 	const float lastFrameDeltaTimeMS)
 {
+	const boost::uint64_t updateStartTime = Platform::MonotonicClock::GetCurrentTimeUS();
+	m_frameTimeHistogram.Add(lastFrameDeltaTimeMS);
+	ETHAllocationTracker::BeginFrame();
+	ETH_ALLOCATION_SCOPE(SCENE);
+
 	// removes dead elements on top layer to fill the list once again
 	m_drawableManager.RemoveTheDead();
 
-	SetLastFrameElapsedTime(static_cast<unsigned long>(lastFrameDeltaTimeMS));
+	SetLastFrameElapsedTime(lastFrameDeltaTimeMS);
 
 	// run garbage collector
-	GarbageCollect(m_gcMode, m_pASEngine);
+	{
+		ETH_ALLOCATION_SCOPE(SCRIPT);
+		GarbageCollect(m_gcMode, m_pASEngine);
+	}
 
 	// process scene load request
 	if (!LoadNextSceneIfRequested())
@@ -165,6 +193,8 @@ Application::APP_STATUS ETHEngine::Update(
 	if (m_pScene)
 		m_pScene->Update(lastFrameDeltaTimeMS, m_backBuffer, m_onSceneUpdateFunction);
 
+	m_updateTimeHistogram.Add(static_cast<float>(Platform::MonotonicClock::GetCurrentTimeUS() - updateStartTime) / 1000.0f);
+
 	if (Aborted())
 		return Application::APP_QUIT;
 	else
@@ -192,6 +222,9 @@ bool ETHEngine::LoadNextSceneIfRequested()
 
 void ETHEngine::RenderFrame()
 {
+	const boost::uint64_t renderStartTime = Platform::MonotonicClock::GetCurrentTimeUS();
+	ETH_ALLOCATION_SCOPE(RENDER);
+
 	m_backBuffer->BeginRendering();
 
 	// draw scene (if there's any)
@@ -202,11 +235,23 @@ void ETHEngine::RenderFrame()
 	m_v2LastCamPos = GetCameraPos();
 
 	// draw sprites, rects, lines and texts
-	DrawTopLayer(GetLastFrameElapsedTime());
+	DrawTopLayer(GetLastFrameElapsedTimeF());
 
 	m_backBuffer->EndRendering();
 
 	m_backBuffer->Present();
+
+	m_renderTimeHistogram.Add(static_cast<float>(Platform::MonotonicClock::GetCurrentTimeUS() - renderStartTime) / 1000.0f);
+
+	// give the collector whatever is left of the frame period before sleeping it off
+	if (m_gcMode == ADAPTIVE)
+	{
+		ETH_ALLOCATION_SCOPE(SCRIPT);
+		m_garbageCollector.CollectDuringIdleTime(m_pASEngine, m_frameLimiter.GetTimeLeftUS());
+	}
+
+	// sleep off whatever is left of the frame period when the frame rate is capped
+	m_frameLimiter.Wait();
 }
 
 bool ETHEngine::RunOnResumeFunction() const
@@ -233,9 +278,20 @@ void ETHEngine::Destroy()
 	m_provider->GetGraphicResourceManager()->ReleaseResources();
 	m_provider->GetAudioResourceManager()->ReleaseResources();
 	m_backBuffer.reset();
+
+	// saves still queued must reach the disk before the process goes away
+	ETHSaveDataWriter::Shutdown();
+
+	#if defined(_DEBUG) || defined(DEBUG)
+	LogFrameTimeStats();
+	if (ETHAllocationTracker::IsEnabled())
+		LogAllocationStats();
+	#endif
+
+	m_provider->FlushLog();
 }
 
-bool ETHEngine::PrepareScriptingEngine(const std::vector<gs2d::str_type::string>& definedWords)
+bool ETHEngine::PrepareScriptingEngine(const std::vector<gs2d::str_type::string>& definedWords, const bool enableJIT)
 {
 	m_pASEngine = asCreateScriptEngine(ANGELSCRIPT_VERSION);
 	if (!m_pASEngine)
@@ -262,6 +318,26 @@ bool ETHEngine::PrepareScriptingEngine(const std::vector<gs2d::str_type::string>
 	ETHGlobal::RegisterAllObjects(m_pASEngine);
 	RegisterGlobalFunctions(m_pASEngine);
 
+	// the JIT needs the JitEntry instructions in the bytecode, so it must be installed before building
+	if (enableJIT)
+	{
+		if (ETHJITCompiler::IsSupported())
+		{
+			m_jitCompiler = ETHJITCompilerPtr(new ETHJITCompiler);
+			r = m_pASEngine->SetEngineProperty(asEP_INCLUDE_JIT_INSTRUCTIONS, 1);
+			if (!CheckAngelScriptError((r < 0), GS_L("Failed while enabling JIT instructions.")))
+				return false;
+
+			r = m_pASEngine->SetJITCompiler(m_jitCompiler.get());
+			if (!CheckAngelScriptError((r < 0), GS_L("Failed while setting the JIT compiler.")))
+				return false;
+		}
+		else
+		{
+			m_provider->Log(GS_L("The script JIT compiler isn't available on this platform"), Platform::Logger::WARNING);
+		}
+	}
+
 	m_pScriptContext = m_pASEngine->CreateContext();
 
 	// Exception callback
@@ -272,8 +348,16 @@ bool ETHEngine::PrepareScriptingEngine(const std::vector<gs2d::str_type::string>
 	if (!BuildModule(definedWords))
 		return false;
 
-	// Always collect all garbage by default
-	SetFastGarbageCollector(false);
+	if (m_jitCompiler)
+	{
+		ETH_STREAM_DECL(ss) << GS_L("JIT: ") << m_jitCompiler->GetNumCompiledFunctions() << GS_L(" script functions compiled to ")
+			<< m_jitCompiler->GetNativeCodeSize() << GS_L(" bytes of native code");
+		m_provider->Log(ss.str(), Platform::Logger::INFO);
+	}
+
+	// spread the collection over frames by default. SetFastGarbageCollector
+	// and SetGarbageCollectorBudget change it from scripts
+	m_gcMode = ADAPTIVE;
 
 	return true;
 }
@@ -320,6 +404,40 @@ static void RegisterDefinedWords(const std::vector<gs2d::str_type::string>& defi
 	}
 }
 
+void ETHEngine::PrepareEntityTemplates(const bool preload)
+{
+	const str_type::string resourcePath = m_provider->GetFileIOHub()->GetResourceDirectory();
+	const str_type::string entityPath = resourcePath + ETHDirectories::GetEntityDirectory();
+	const Platform::FileManagerPtr& fileManager = m_provider->GetFileManager();
+
+	// the bundle follows the script byte code: compile-only runs write it, and only games
+	// shipped without their script source read it back, since a stale bundle would hide
+	// the .ent files being edited during development
+	if (!m_compileAndRun)
+	{
+		if (fileManager->IsPacked())
+			return;
+
+		const str_type::string bundleFile = m_provider->GetByteCodeSaveDirectory() + ETHEntityTemplateBundle::DEFAULT_FILE_NAME;
+		const int numTemplates = ETHEntityTemplateBundle::Compile(entityPath, bundleFile, fileManager);
+		if (numTemplates >= 0)
+		{
+			ETH_STREAM_DECL(ss) << GS_L("Entity bundle: ") << numTemplates << GS_L(" templates written to ") << bundleFile;
+			m_provider->Log(ss.str(), Platform::Logger::INFO);
+		}
+	}
+	else if (!ETHGlobal::FileExists(resourcePath + ETH_DEFAULT_MAIN_SCRIPT_FILE, fileManager))
+	{
+		const boost::uint64_t startTime = Platform::MonotonicClock::GetCurrentTimeUS();
+		if (m_entityCache.LoadBundle(resourcePath + ETHEntityTemplateBundle::DEFAULT_FILE_NAME, entityPath, fileManager, preload))
+		{
+			ETH_STREAM_DECL(ss) << GS_L("Entity bundle: templates ") << (preload ? GS_L("parsed") : GS_L("indexed")) << GS_L(" in ")
+				<< static_cast<float>(Platform::MonotonicClock::GetCurrentTimeUS() - startTime) / 1000.0f << GS_L("ms");
+			m_provider->Log(ss.str(), Platform::Logger::INFO);
+		}
+	}
+}
+
 bool ETHEngine::BuildModule(const std::vector<gs2d::str_type::string>& definedWords)
 {
 	const str_type::string resourcePath = m_provider->GetFileIOHub()->GetResourceDirectory();
@@ -429,7 +547,7 @@ bool ETHEngine::CheckAngelScriptError(const bool error, const str_type::string &
 	}
 }
 
-void ETHEngine::DrawTopLayer(const unsigned long lastFrameElapsedTimeMS)
+void ETHEngine::DrawTopLayer(const float lastFrameElapsedTimeMS)
 {
 	m_drawableManager.DrawTopLayer(lastFrameElapsedTimeMS, m_provider->GetVideo());
 }
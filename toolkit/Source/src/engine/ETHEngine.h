@@ -26,6 +26,7 @@
 #include <BaseApplication.h>
 #include "Resource/ETHResourceProvider.h"
 #include "Script/ETHScriptWrapper.h"
+#include "Script/ETHJITCompiler.h"
 #include "Shader/ETHShaderManager.h"
 
 #define _ETH_DEFAULT_MAIN_SCRIPT_FILE (GS_L("main.angelscript"))
@@ -47,6 +48,7 @@ class ETHEngine : public gs2d::BaseApplication, public ETHScriptWrapper
 	const str_type::string ETH_MAIN_FUNCTION;
 
 	Platform::FileIOHubPtr m_fileIOHub;
+	ETHJITCompilerPtr m_jitCompiler;
 
 	const bool m_testing, m_compileAndRun;
 	bool m_hasBeenResumed;
@@ -58,14 +60,15 @@ class ETHEngine : public gs2d::BaseApplication, public ETHScriptWrapper
 
 	ETHEngine &operator=(const ETHEngine &other);
 
-	bool PrepareScriptingEngine(const std::vector<gs2d::str_type::string>& definedWords);
+	bool PrepareScriptingEngine(const std::vector<gs2d::str_type::string>& definedWords, const bool enableJIT);
 	bool BuildModule(const std::vector<gs2d::str_type::string>& definedWords);
+	void PrepareEntityTemplates(const bool preload);
 	asIScriptFunction* GetMainFunction() const;
 	bool RunOnResumeFunction() const;
 	bool RunFunction(asIScriptFunction* func) const;
 	bool LoadNextSceneIfRequested();
 
-	void DrawTopLayer(const unsigned long lastFrameElapsedTimeMS);
+	void DrawTopLayer(const float lastFrameElapsedTimeMS);
 
 public:
 	static const str_type::string ETH_SCRIPT_MODULE;
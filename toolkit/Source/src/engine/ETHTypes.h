@@ -52,6 +52,7 @@ using namespace gs2d;
 #define _ETH_SHADOW_SCALEY (8.0f)
 #define _ETH_SHADOW_FAKE_STRETCH (2.2f)
 #define _ETH_SHADOW_SIZE_TOLERANCE (0.95f)
+#define ETH_PROJ_SHADOW_ORIGIN (Vector2(0.5f, 0.79f))
 #define _ETH_DEFAULT_LIGHT_INTENSITY (2.0f)
 #define _ETH_DEFAULT_AMBIENT_LIGHT (0.3f)
 #define _ETH_MIN_BUCKET_SIZE (128.0f)
@@ -63,9 +64,11 @@ using namespace gs2d;
 
 #define ETH_CALLBACK_PREFIX GS_L("ETHCallback_")
 #define ETH_CONSTRUCTOR_CALLBACK_PREFIX GS_L("ETHConstructorCallback_")
+#define ETH_BATCH_CALLBACK_PREFIX GS_L("ETHBatchCallback_")
 #define ETH_DESTRUCTOR_CALLBACK_PREFIX GS_L("ETHDestructorCallback_")
 
 #define ETH_INLINE inline
+#define ETH_RESTRICT __restrict
 
 typedef long ETH_INT;
 typedef unsigned char ETH_BOOL;
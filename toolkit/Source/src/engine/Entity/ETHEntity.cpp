@@ -104,6 +104,36 @@ void ETHEntity::Zero()
 	m_gcDict = 0;
 }
 
+void ETHEntity::ReleasePooledResources()
+{
+	if (m_gcDict)
+	{
+		m_gcDict->Release();
+		m_gcDict = 0;
+	}
+	m_controller->Destroy();
+}
+
+void ETHEntity::ResetPooledState(const ETHEntityProperties& properties)
+{
+	Revive();
+	Zero();
+	m_id = -1;
+	m_properties = properties;
+
+	// physics controllers are bound to a Box2D body and can't outlive it, but the plain
+	// controller is just position and callback handles, so reuse it
+	ETHRawEntityControllerPtr rawController = boost::dynamic_pointer_cast<ETHRawEntityController>(m_controller);
+	if (rawController && !dynamic_cast<ETHPhysicsEntityController*>(rawController.get()))
+	{
+		rawController->Reset(Vector3(0, 0, 0), 0.0f);
+	}
+	else
+	{
+		m_controller = ETHEntityControllerPtr(new ETHRawEntityController(Vector3(0, 0, 0), 0.0f));
+	}
+}
+
 void ETHEntity::SetAngelScriptObject(const str_type::string &name, void *value, int typeId)
 {
 	if (!m_gcDict)
@@ -784,6 +814,21 @@ bool ETHEntity::RunCallbackScript()
 	return m_controller->RunCallback(this);
 }
 
+bool ETHEntity::RunConstructorCallbackScript()
+{
+	return m_controller->RunConstructorCallback(this);
+}
+
+asIScriptFunction* ETHEntity::GetCallbackFunction() const
+{
+	return m_controller->GetCallback();
+}
+
+asIScriptFunction* ETHEntity::GetBatchCallbackFunction() const
+{
+	return m_controller->GetBatchCallback();
+}
+
 float ETHEntity::GetSpecularPower() const
 {
 	return m_properties.specularPower;
@@ -138,6 +138,9 @@ public:
 	bool HasHalo() const;
 
 	bool RunCallbackScript();
+	bool RunConstructorCallbackScript();
+	asIScriptFunction* GetCallbackFunction() const;
+	asIScriptFunction* GetBatchCallbackFunction() const;
 
 	float GetSpecularPower() const;
 	float GetSpecularBrightness() const;
@@ -243,6 +246,12 @@ private:
 	void InstantiateDictionary();
 
 protected:
+	/// Releases script objects and controller resources held by an entity that is about to be pooled
+	void ReleasePooledResources();
+
+	/// Restores the state a freshly constructed entity would have from these properties
+	void ResetPooledState(const ETHEntityProperties& properties);
+
 	ETHEntityControllerPtr m_controller;
 	ETHEntityProperties m_properties;
 	unsigned int m_spriteFrame;
@@ -22,6 +22,7 @@
 
 #include "ETHEntityArray.h"
 #include <set>
+#include <algorithm>
 
 ETHEntityArray::ETHEntityArray()
 {
@@ -144,4 +145,204 @@ void ETHEntityArray::removeDeadEntities()
 			++iter;
 		}
 	}
-}
\ No newline at end of file
+}
+
+void ETHEntityArray::SetColor(const Vector3& color)
+{
+	for (std::vector<ETHEntityRawPtr>::iterator iter = m_vector.begin(); iter != m_vector.end(); ++iter)
+	{
+		if ((*iter)->IsAlive())
+			(*iter)->SetColor(color);
+	}
+}
+
+void ETHEntityArray::SetAlpha(const float alpha)
+{
+	for (std::vector<ETHEntityRawPtr>::iterator iter = m_vector.begin(); iter != m_vector.end(); ++iter)
+	{
+		if ((*iter)->IsAlive())
+			(*iter)->SetAlpha(alpha);
+	}
+}
+
+void ETHEntityArray::Hide(const bool hide)
+{
+	for (std::vector<ETHEntityRawPtr>::iterator iter = m_vector.begin(); iter != m_vector.end(); ++iter)
+	{
+		if ((*iter)->IsAlive())
+			(*iter)->Hide(hide);
+	}
+}
+
+void ETHEntityArray::Scale(const float scale)
+{
+	for (std::vector<ETHEntityRawPtr>::iterator iter = m_vector.begin(); iter != m_vector.end(); ++iter)
+	{
+		if ((*iter)->IsAlive())
+			(*iter)->Scale(scale);
+	}
+}
+
+void ETHEntityArray::SetScale(const Vector2& scale)
+{
+	for (std::vector<ETHEntityRawPtr>::iterator iter = m_vector.begin(); iter != m_vector.end(); ++iter)
+	{
+		if ((*iter)->IsAlive())
+			(*iter)->SetScale(scale);
+	}
+}
+
+void ETHEntityArray::SetAngle(const float angle)
+{
+	for (std::vector<ETHEntityRawPtr>::iterator iter = m_vector.begin(); iter != m_vector.end(); ++iter)
+	{
+		if ((*iter)->IsAlive())
+			(*iter)->SetAngle(angle);
+	}
+}
+
+void ETHEntityArray::AddToAngle(const float angle)
+{
+	for (std::vector<ETHEntityRawPtr>::iterator iter = m_vector.begin(); iter != m_vector.end(); ++iter)
+	{
+		if ((*iter)->IsAlive())
+			(*iter)->SetAngle((*iter)->GetAngle() + angle);
+	}
+}
+
+namespace {
+
+struct DistanceKey
+{
+	float squaredDistance;
+	ETHEntityRawPtr entity;
+	bool operator<(const DistanceKey& other) const { return squaredDistance < other.squaredDistance; }
+};
+
+} // namespace
+
+void ETHEntityArray::SortByDistance(const Vector2& point)
+{
+	// compute every distance once instead of twice per comparison
+	std::vector<DistanceKey> keys(m_vector.size());
+	for (std::size_t t = 0; t < m_vector.size(); t++)
+	{
+		const Vector2 diff(m_vector[t]->GetPositionXY() - point);
+		keys[t].squaredDistance = (diff.x * diff.x) + (diff.y * diff.y);
+		keys[t].entity = m_vector[t];
+	}
+	std::stable_sort(keys.begin(), keys.end());
+	for (std::size_t t = 0; t < m_vector.size(); t++)
+	{
+		m_vector[t] = keys[t].entity;
+	}
+}
+
+template <class Predicate>
+void ETHEntityArray::Filter(const Predicate& predicate)
+{
+	// compact in place, releasing the entities that don't pass
+	std::vector<ETHEntityRawPtr>::iterator out = m_vector.begin();
+	for (std::vector<ETHEntityRawPtr>::iterator iter = m_vector.begin(); iter != m_vector.end(); ++iter)
+	{
+		if ((*iter)->IsAlive() && predicate(*iter))
+			*out++ = *iter;
+		else
+			(*iter)->Release();
+	}
+	m_vector.erase(out, m_vector.end());
+}
+
+namespace {
+
+struct WithinDistance
+{
+	Vector2 point;
+	float squaredRadius;
+	bool operator()(const ETHEntityRawPtr entity) const
+	{
+		const Vector2 diff(entity->GetPositionXY() - point);
+		return ((diff.x * diff.x) + (diff.y * diff.y)) <= squaredRadius;
+	}
+};
+
+struct NameEquals
+{
+	const str_type::string* name;
+	bool operator()(const ETHEntityRawPtr entity) const { return entity->GetEntityName() == *name; }
+};
+
+struct FloatInRange
+{
+	const str_type::string* name;
+	float minValue, maxValue;
+	bool operator()(const ETHEntityRawPtr entity) const
+	{
+		if (entity->CheckCustomData(*name) != ETHCustomData::DT_FLOAT)
+			return false;
+		const float value = entity->GetFloat(*name);
+		return (value >= minValue && value <= maxValue);
+	}
+};
+
+struct IntEquals
+{
+	const str_type::string* name;
+	int value;
+	bool operator()(const ETHEntityRawPtr entity) const
+	{
+		return (entity->CheckCustomData(*name) == ETHCustomData::DT_INT && entity->GetInt(*name) == value);
+	}
+};
+
+struct StringEquals
+{
+	const str_type::string* name;
+	const str_type::string* value;
+	bool operator()(const ETHEntityRawPtr entity) const
+	{
+		return (entity->CheckCustomData(*name) == ETHCustomData::DT_STRING && entity->GetString(*name) == *value);
+	}
+};
+
+} // namespace
+
+void ETHEntityArray::FilterByDistance(const Vector2& point, const float radius)
+{
+	WithinDistance predicate;
+	predicate.point = point;
+	predicate.squaredRadius = radius * radius;
+	Filter(predicate);
+}
+
+void ETHEntityArray::FilterByEntityName(const str_type::string& name)
+{
+	NameEquals predicate;
+	predicate.name = &name;
+	Filter(predicate);
+}
+
+void ETHEntityArray::FilterByFloat(const str_type::string& name, const float minValue, const float maxValue)
+{
+	FloatInRange predicate;
+	predicate.name = &name;
+	predicate.minValue = minValue;
+	predicate.maxValue = maxValue;
+	Filter(predicate);
+}
+
+void ETHEntityArray::FilterByInt(const str_type::string& name, const int value)
+{
+	IntEquals predicate;
+	predicate.name = &name;
+	predicate.value = value;
+	Filter(predicate);
+}
+
+void ETHEntityArray::FilterByString(const str_type::string& name, const str_type::string& value)
+{
+	StringEquals predicate;
+	predicate.name = &name;
+	predicate.value = &value;
+	Filter(predicate);
+}
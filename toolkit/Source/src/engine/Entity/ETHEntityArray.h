@@ -49,7 +49,26 @@ public:
 	void unique();
 	void removeDeadEntities();
 
+	// bulk operations: each one runs as a single native loop over the living entities
+	// in the array, so scripts don't have to cross into the engine once per entity
+	void SetColor(const Vector3& color);
+	void SetAlpha(const float alpha);
+	void Hide(const bool hide);
+	void Scale(const float scale);
+	void SetScale(const Vector2& scale);
+	void SetAngle(const float angle);
+	void AddToAngle(const float angle);
+
+	void SortByDistance(const Vector2& point);
+	void FilterByDistance(const Vector2& point, const float radius);
+	void FilterByEntityName(const str_type::string& name);
+	void FilterByFloat(const str_type::string& name, const float minValue, const float maxValue);
+	void FilterByInt(const str_type::string& name, const int value);
+	void FilterByString(const str_type::string& name, const str_type::string& value);
+
 private:
+	template <class Predicate> void Filter(const Predicate& predicate);
+
 	std::vector<ETHEntityRawPtr> m_vector;
 	int m_ref;
 };
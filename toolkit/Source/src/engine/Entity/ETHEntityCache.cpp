@@ -34,7 +34,19 @@ const ETHEntityProperties* ETHEntityCache::Get(const str_type::string& fileName,
 	else
 	{
 		const str_type::string fullFilePath = filePath + fileName;
-		
+
+		// bundled templates are already in memory, so there's no file to probe or read
+		str_type::string content;
+		if (m_bundle.GetTemplate(fileName, content))
+		{
+			ETHEntityProperties props;
+			if (props.ReadFromXMLString(content, fullFilePath))
+			{
+				m_props[fileName] = props;
+				return &(m_props[fileName]);
+			}
+		}
+
 		if (fileManager->FileExists(fullFilePath))
 		{
 			ETHEntityProperties props(fullFilePath, fileManager);
@@ -47,3 +59,20 @@ const ETHEntityProperties* ETHEntityCache::Get(const str_type::string& fileName,
 	}
 	return 0;
 }
+
+bool ETHEntityCache::LoadBundle(const str_type::string& bundleFile, const str_type::string& entityPath,
+	const Platform::FileManagerPtr& fileManager, const bool preload)
+{
+	if (!m_bundle.Load(bundleFile, fileManager))
+		return false;
+
+	if (preload)
+	{
+		const unsigned int numTemplates = m_bundle.GetNumTemplates();
+		for (unsigned int t = 0; t < numTemplates; t++)
+		{
+			Get(m_bundle.GetTemplateName(t), entityPath, fileManager);
+		}
+	}
+	return true;
+}
@@ -24,6 +24,7 @@
 #define ETH_ENTITY_CACHE_H_
 
 #include "ETHEntityProperties.h"
+#include "ETHEntityTemplateBundle.h"
 
 #include <map>
 
@@ -31,8 +32,18 @@ class ETHEntityCache
 {
 public:
 	const ETHEntityProperties* Get(const str_type::string& fileName, const str_type::string& filePath, const Platform::FileManagerPtr& fileManager);
+
+	/**
+	 * Makes Get() look templates up in a bundle written by ETHEntityTemplateBundle::Compile
+	 * before falling back to .ent files. With preload, every template in the bundle
+	 * is parsed right away, so no entity spawn ever has to parse one
+	 */
+	bool LoadBundle(const str_type::string& bundleFile, const str_type::string& entityPath,
+		const Platform::FileManagerPtr& fileManager, const bool preload);
+
 private:
 	std::map<str_type::string, ETHEntityProperties> m_props;
+	ETHEntityTemplateBundle m_bundle;
 };
 
 #endif
@@ -29,6 +29,7 @@ ETHRawEntityController::ETHRawEntityController(const Vector3& pos, const float a
 	m_pContext(0),
 	m_callback(0),
 	m_constructorCallback(0),
+	m_batchCallback(0),
 	m_hadRunConstructor(false)
 {
 }
@@ -37,10 +38,12 @@ ETHRawEntityController::ETHRawEntityController(
 	const ETHEntityControllerPtr& old,
 	asIScriptContext *pContext,
 	asIScriptFunction* callback,
-	asIScriptFunction* constructorCallback) :
+	asIScriptFunction* constructorCallback,
+	asIScriptFunction* batchCallback) :
 	m_pContext(pContext),
 	m_callback(callback),
 	m_constructorCallback(constructorCallback),
+	m_batchCallback(batchCallback),
 	m_hadRunConstructor(false)
 {
 	m_pos = old->GetPos();
@@ -149,11 +152,9 @@ void ETHRawEntityController::AddToAngle(const float angle)
 
 bool ETHRawEntityController::RunCallback(ETHScriptEntity* entity)
 {
-	if (HasConstructorCallback() && !m_hadRunConstructor)
-	{
-		ETHGlobal::RunEntityCallback(m_pContext, entity, m_constructorCallback);
-		m_hadRunConstructor = true;
-	}
+	RunConstructorCallback(entity);
+
+	// batch callbacks take an ETHEntityArray and can only be run by ETHEntityCallbackDispatcher
 	if (HasCallback())
 	{
 		ETHGlobal::RunEntityCallback(m_pContext, entity, m_callback);
@@ -161,6 +162,17 @@ bool ETHRawEntityController::RunCallback(ETHScriptEntity* entity)
 	return true;
 }
 
+bool ETHRawEntityController::RunConstructorCallback(ETHScriptEntity* entity)
+{
+	if (HasConstructorCallback() && !m_hadRunConstructor)
+	{
+		ETHGlobal::RunEntityCallback(m_pContext, entity, m_constructorCallback);
+		m_hadRunConstructor = true;
+		return true;
+	}
+	return false;
+}
+
 asIScriptContext* ETHRawEntityController::GetScriptContext()
 {
 	return m_pContext;
@@ -176,6 +188,31 @@ asIScriptFunction* ETHRawEntityController::GetConstructorCallback()
 	return m_constructorCallback;
 }
 
+asIScriptFunction* ETHRawEntityController::GetBatchCallback()
+{
+	return m_batchCallback;
+}
+
+void ETHRawEntityController::SetCallbacks(
+	asIScriptContext *pContext,
+	asIScriptFunction* callback,
+	asIScriptFunction* constructorCallback,
+	asIScriptFunction* batchCallback)
+{
+	m_pContext = pContext;
+	m_callback = callback;
+	m_constructorCallback = constructorCallback;
+	m_batchCallback = batchCallback;
+	m_hadRunConstructor = false;
+}
+
+void ETHRawEntityController::Reset(const Vector3& pos, const float angle)
+{
+	SetCallbacks(0, 0, 0);
+	m_pos = pos;
+	m_angle = angle;
+}
+
 void ETHRawEntityController::Destroy()
 {
 }
@@ -58,6 +58,9 @@ public:
 	virtual void SetAngle(const float angle) = 0;
 	virtual bool HasAnyCallbackFunction() const = 0;
 	virtual bool RunCallback(ETHScriptEntity* entity) = 0;
+	virtual bool RunConstructorCallback(ETHScriptEntity* entity) = 0;
+	virtual asIScriptFunction* GetCallback() = 0;
+	virtual asIScriptFunction* GetBatchCallback() = 0;
 
 	virtual void Destroy() = 0;
 	virtual void Scale(const Vector2& scale, ETHEntity* entity) = 0;
@@ -70,6 +73,7 @@ class ETHRawEntityController : public ETHEntityController
 protected:
 	asIScriptFunction* m_callback;
 	asIScriptFunction* m_constructorCallback;
+	asIScriptFunction* m_batchCallback;
 	asIScriptContext *m_pContext;
 	Vector3 m_pos;
 	float m_angle;
@@ -78,7 +82,8 @@ protected:
 public:
 	ETHRawEntityController(const Vector3& pos, const float angle);
 	ETHRawEntityController(const ETHEntityControllerPtr& old, asIScriptContext *pContext,
-						   asIScriptFunction* callback, asIScriptFunction* constructorCallback);
+						   asIScriptFunction* callback, asIScriptFunction* constructorCallback,
+						   asIScriptFunction* batchCallback = 0);
 	virtual ~ETHRawEntityController();
 	void Update(const float lastFrameElapsedTime, ETHBucketManager& buckets);
 	Vector3 GetPos() const;
@@ -89,14 +94,20 @@ public:
 
 	bool HasConstructorCallback() const { return (m_constructorCallback != 0); }
 	bool HasCallback() const { return (m_callback != 0); }
-	bool HasAnyCallbackFunction() const { return (HasCallback() || HasConstructorCallback()); }
+	bool HasBatchCallback() const { return (m_batchCallback != 0); }
+	bool HasAnyCallbackFunction() const { return (HasCallback() || HasConstructorCallback() || HasBatchCallback()); }
 	bool RunCallback(ETHScriptEntity* entity);
+	bool RunConstructorCallback(ETHScriptEntity* entity);
 
 	void AddToPos(const Vector3& pos);
 	void AddToAngle(const float angle);
 	asIScriptContext* GetScriptContext();
 	asIScriptFunction* GetCallback();
 	asIScriptFunction* GetConstructorCallback();
+	asIScriptFunction* GetBatchCallback();
+	void SetCallbacks(asIScriptContext *pContext, asIScriptFunction* callback, asIScriptFunction* constructorCallback,
+		asIScriptFunction* batchCallback = 0);
+	void Reset(const Vector3& pos, const float angle);
 	void Destroy();
 	void Scale(const Vector2& scale, ETHEntity* entity);
 
@@ -0,0 +1,149 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#include "ETHEntityPool.h"
+
+#include "ETHRenderEntity.h"
+
+ETHEntityPool::STATS::STATS() :
+	hits(0),
+	misses(0),
+	recycled(0),
+	discarded(0)
+{
+}
+
+ETHEntityPool::TEMPLATE_POOL::TEMPLATE_POOL() :
+	maxSize(0)
+{
+}
+
+ETHEntityPool::ETHEntityPool()
+{
+}
+
+ETHEntityPool::~ETHEntityPool()
+{
+	Clear();
+}
+
+void ETHEntityPool::SetPoolSize(const str_type::string& templateName, const unsigned int size)
+{
+	TEMPLATE_POOL& pool = m_pools[templateName];
+	pool.maxSize = size;
+
+	// shrink right away if the pool got smaller
+	while (pool.idle.size() > static_cast<std::size_t>(size))
+	{
+		delete pool.idle.back();
+		pool.idle.pop_back();
+		++pool.stats.discarded;
+	}
+	pool.idle.reserve(size);
+}
+
+unsigned int ETHEntityPool::GetPoolSize(const str_type::string& templateName) const
+{
+	TemplatePoolMap::const_iterator iter = m_pools.find(templateName);
+	return (iter != m_pools.end()) ? iter->second.maxSize : 0;
+}
+
+bool ETHEntityPool::IsPooled(const str_type::string& templateName) const
+{
+	return (GetPoolSize(templateName) > 0);
+}
+
+ETHRenderEntity* ETHEntityPool::Acquire(const str_type::string& templateName)
+{
+	TemplatePoolMap::iterator iter = m_pools.find(templateName);
+	if (iter == m_pools.end() || iter->second.maxSize == 0)
+		return 0;
+
+	TEMPLATE_POOL& pool = iter->second;
+	if (pool.idle.empty())
+	{
+		++pool.stats.misses;
+		return 0;
+	}
+
+	ETHRenderEntity* entity = pool.idle.back();
+	pool.idle.pop_back();
+	++pool.stats.hits;
+	return entity;
+}
+
+bool ETHEntityPool::Recycle(ETHRenderEntity* entity)
+{
+	TemplatePoolMap::iterator iter = m_pools.find(entity->GetPoolTemplateName());
+	if (iter == m_pools.end())
+		return false;
+
+	TEMPLATE_POOL& pool = iter->second;
+	if (pool.idle.size() >= static_cast<std::size_t>(pool.maxSize))
+	{
+		++pool.stats.discarded;
+		return false;
+	}
+
+	entity->Recycle();
+	pool.idle.push_back(entity);
+	++pool.stats.recycled;
+	return true;
+}
+
+unsigned int ETHEntityPool::GetNumIdleEntities(const str_type::string& templateName) const
+{
+	TemplatePoolMap::const_iterator iter = m_pools.find(templateName);
+	return (iter != m_pools.end()) ? static_cast<unsigned int>(iter->second.idle.size()) : 0;
+}
+
+ETHEntityPool::STATS ETHEntityPool::GetStats(const str_type::string& templateName) const
+{
+	TemplatePoolMap::const_iterator iter = m_pools.find(templateName);
+	return (iter != m_pools.end()) ? iter->second.stats : STATS();
+}
+
+ETHEntityPool::STATS ETHEntityPool::GetTotalStats() const
+{
+	STATS r;
+	for (TemplatePoolMap::const_iterator iter = m_pools.begin(); iter != m_pools.end(); ++iter)
+	{
+		r.hits      += iter->second.stats.hits;
+		r.misses    += iter->second.stats.misses;
+		r.recycled  += iter->second.stats.recycled;
+		r.discarded += iter->second.stats.discarded;
+	}
+	return r;
+}
+
+void ETHEntityPool::Clear()
+{
+	for (TemplatePoolMap::iterator iter = m_pools.begin(); iter != m_pools.end(); ++iter)
+	{
+		std::vector<ETHRenderEntity*>& idle = iter->second.idle;
+		for (std::size_t t = 0; t < idle.size(); t++)
+		{
+			delete idle[t];
+		}
+		idle.clear();
+	}
+}
@@ -0,0 +1,89 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#ifndef ETH_ENTITY_POOL_H_
+#define ETH_ENTITY_POOL_H_
+
+#include <Types.h>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
+
+#include <map>
+#include <vector>
+
+class ETHRenderEntity;
+
+/// Keeps released entities of the same template around so they can be handed out
+/// again by AddEntity instead of being reconstructed. Pooling is opt-in per template.
+class ETHEntityPool
+{
+public:
+	struct STATS
+	{
+		STATS();
+		unsigned int hits;
+		unsigned int misses;
+		unsigned int recycled;
+		unsigned int discarded;
+	};
+
+	ETHEntityPool();
+	~ETHEntityPool();
+
+	/// Sets how many idle entities of this template may be kept. Zero disables pooling
+	void SetPoolSize(const gs2d::str_type::string& templateName, const unsigned int size);
+	unsigned int GetPoolSize(const gs2d::str_type::string& templateName) const;
+	bool IsPooled(const gs2d::str_type::string& templateName) const;
+
+	/// Returns an idle entity, or 0 if none is available. The caller must revive it
+	/// through ETHRenderEntity::Reuse before adding it to a scene
+	ETHRenderEntity* Acquire(const gs2d::str_type::string& templateName);
+
+	/// Takes ownership of an entity whose reference count reached zero. Returns false if
+	/// the pool is full and the caller must destroy the entity itself
+	bool Recycle(ETHRenderEntity* entity);
+
+	unsigned int GetNumIdleEntities(const gs2d::str_type::string& templateName) const;
+	STATS GetStats(const gs2d::str_type::string& templateName) const;
+	STATS GetTotalStats() const;
+
+	/// Destroys every idle entity but keeps the configured pool sizes
+	void Clear();
+
+private:
+	struct TEMPLATE_POOL
+	{
+		TEMPLATE_POOL();
+		std::vector<ETHRenderEntity*> idle;
+		unsigned int maxSize;
+		STATS stats;
+	};
+
+	typedef std::map<gs2d::str_type::string, TEMPLATE_POOL> TemplatePoolMap;
+	TemplatePoolMap m_pools;
+};
+
+typedef boost::shared_ptr<ETHEntityPool> ETHEntityPoolPtr;
+typedef boost::weak_ptr<ETHEntityPool> ETHEntityPoolWeakPtr;
+
+#endif
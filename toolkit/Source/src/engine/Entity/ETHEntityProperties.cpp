@@ -138,14 +138,19 @@ ETHEntityProperties::ETHEntityProperties(const str_type::string& filePath, const
 	ETHEntityMaterial::Reset();
 	Reset();
 
-	TiXmlDocument doc(filePath);
 	str_type::string content;
 	fileManager->GetUTFFileString(filePath, content);
+	ReadFromXMLString(content, filePath);
+}
+
+bool ETHEntityProperties::ReadFromXMLString(const str_type::string& content, const str_type::string& filePath)
+{
+	TiXmlDocument doc(filePath);
 	if (!doc.LoadFile(content, TIXML_ENCODING_LEGACY))
 	{
 		ETH_STREAM_DECL(ss) << GS_L("Couldn't load file: ") << filePath;
 		ETHResourceProvider::Log(ss.str(), Platform::Logger::ERROR);
-		return;
+		return false;
 	}
 
 	TiXmlHandle hDoc(&doc);
@@ -156,12 +161,12 @@ ETHEntityProperties::ETHEntityProperties(const str_type::string& filePath, const
 	{
 		ETH_STREAM_DECL(ss) << GS_L("The current file seems to be invalid: ") << filePath;
 		ETHResourceProvider::Log(ss.str(), Platform::Logger::ERROR);
-		return;
+		return false;
 	}
 
 	hRoot = TiXmlHandle(pElem);
 	entityName = Platform::GetFileName(filePath);
-	ReadFromXMLFile(hRoot.FirstChildElement().Element());
+	return ReadFromXMLFile(hRoot.FirstChildElement().Element());
 }
 
 void ETHEntityProperties::Reset()
@@ -116,6 +116,9 @@ public:
 		const str_type::string &entityPath,
 		Platform::FileManagerPtr fileManager);
 	bool ReadFromXMLFile(TiXmlElement *pElement);
+
+	/// Reads a whole .ent document that is already in memory. filePath names the template and its error messages
+	bool ReadFromXMLString(const str_type::string& content, const str_type::string& filePath);
 	bool IsSuccessfullyLoaded() const;
 
 	bool WriteContentToXMLFile(TiXmlElement *pHeadRoot) const;
@@ -0,0 +1,235 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#include "ETHEntityTemplateBundle.h"
+
+#include "../Resource/ETHResourceProvider.h"
+
+#include <Platform/FileWatcher.h>
+
+#include <stdio.h>
+#include <string.h>
+
+const str_type::string ETHEntityTemplateBundle::DEFAULT_FILE_NAME(GS_L("entities.bin"));
+
+const char ETHEntityTemplateBundle::MAGIC[4] = { 'E', 'T', 'H', 'B' };
+const boost::uint32_t ETHEntityTemplateBundle::VERSION(1);
+
+// magic, version and number of templates
+const std::size_t ETHEntityTemplateBundle::HEADER_SIZE(12);
+
+// name offset, name size, data offset and data size
+const std::size_t ETHEntityTemplateBundle::ENTRY_SIZE(16);
+
+// the bundle is always little-endian, whatever platform compiled it
+static void AppendUInt32(std::string& out, const boost::uint32_t value)
+{
+	out.push_back(static_cast<char>(value & 0xFF));
+	out.push_back(static_cast<char>((value >> 8) & 0xFF));
+	out.push_back(static_cast<char>((value >> 16) & 0xFF));
+	out.push_back(static_cast<char>((value >> 24) & 0xFF));
+}
+
+static boost::uint32_t ReadUInt32(const unsigned char* data)
+{
+	return static_cast<boost::uint32_t>(data[0])
+		| (static_cast<boost::uint32_t>(data[1]) << 8)
+		| (static_cast<boost::uint32_t>(data[2]) << 16)
+		| (static_cast<boost::uint32_t>(data[3]) << 24);
+}
+
+ETHEntityTemplateBundle::ETHEntityTemplateBundle() :
+	m_numTemplates(0)
+{
+}
+
+int ETHEntityTemplateBundle::Compile(
+	const str_type::string& entityDirectory,
+	const str_type::string& outputFile,
+	const Platform::FileManagerPtr& fileManager)
+{
+	std::map<str_type::string, Platform::FileWatcher::FILE_STATE> entries;
+	Platform::FileWatcher::ReadDirectoryState(Platform::AddLastSlash(entityDirectory), entries);
+
+	// std::map keeps the names sorted, which is the order the index must be in
+	std::vector<str_type::string> names, contents;
+	for (std::map<str_type::string, Platform::FileWatcher::FILE_STATE>::const_iterator iter = entries.begin();
+		iter != entries.end(); ++iter)
+	{
+		if (!Platform::IsExtensionRight(iter->first, GS_L(".ent")))
+			continue;
+
+		const str_type::string filePath = Platform::AddLastSlash(entityDirectory) + iter->first;
+		str_type::string content;
+		TiXmlDocument doc(filePath);
+		if (!fileManager->GetUTFFileString(filePath, content) || !doc.LoadFile(content, TIXML_ENCODING_LEGACY))
+		{
+			ETH_STREAM_DECL(ss) << GS_L("Entity template left out of the bundle, it couldn't be parsed: ") << filePath;
+			ETHResourceProvider::Log(ss.str(), Platform::Logger::WARNING);
+			continue;
+		}
+		names.push_back(iter->first);
+		contents.push_back(content);
+	}
+
+	const std::size_t numTemplates = names.size();
+	std::string index, data;
+	std::size_t offset = HEADER_SIZE + (numTemplates * ENTRY_SIZE);
+	for (std::size_t t = 0; t < numTemplates; t++)
+	{
+		AppendUInt32(index, static_cast<boost::uint32_t>(offset));
+		AppendUInt32(index, static_cast<boost::uint32_t>(names[t].size()));
+		offset += names[t].size();
+		AppendUInt32(index, static_cast<boost::uint32_t>(offset));
+		AppendUInt32(index, static_cast<boost::uint32_t>(contents[t].size()));
+		offset += contents[t].size();
+
+		data.append(names[t]);
+		data.append(contents[t]);
+	}
+
+	std::string header(MAGIC, sizeof(MAGIC));
+	AppendUInt32(header, VERSION);
+	AppendUInt32(header, static_cast<boost::uint32_t>(numTemplates));
+
+	FILE* file = fopen(outputFile.c_str(), "wb");
+	if (!file)
+	{
+		ETH_STREAM_DECL(ss) << GS_L("Failed while writing the entity bundle file ") << outputFile;
+		ETHResourceProvider::Log(ss.str(), Platform::Logger::ERROR);
+		return -1;
+	}
+	const bool written = (fwrite(header.c_str(), 1, header.size(), file) == header.size())
+		&& (fwrite(index.c_str(), 1, index.size(), file) == index.size())
+		&& (fwrite(data.c_str(), 1, data.size(), file) == data.size());
+
+	// fclose flushes the buffered tail, so a full disk may only show up here
+	if (fclose(file) != 0 || !written)
+	{
+		// don't leave a truncated bundle behind for the next run to load
+		remove(outputFile.c_str());
+		ETH_STREAM_DECL(ss) << GS_L("Failed while writing the entity bundle file ") << outputFile;
+		ETHResourceProvider::Log(ss.str(), Platform::Logger::ERROR);
+		return -1;
+	}
+	return static_cast<int>(numTemplates);
+}
+
+bool ETHEntityTemplateBundle::Load(const str_type::string& fileName, const Platform::FileManagerPtr& fileManager)
+{
+	m_buffer.reset();
+	m_numTemplates = 0;
+
+	// projects that don't ship a bundle are not an error
+	if (!fileManager->FileExists(fileName))
+		return false;
+
+	Platform::FileBuffer buffer;
+	if (!fileManager->GetFileBuffer(fileName, buffer) || !buffer || buffer->GetBufferSize() < HEADER_SIZE)
+		return false;
+
+	const unsigned char* address = buffer->GetAddress();
+	if (memcmp(address, MAGIC, sizeof(MAGIC)) != 0 || ReadUInt32(address + 4) != VERSION)
+	{
+		ETH_STREAM_DECL(ss) << GS_L("Invalid or outdated entity bundle file: ") << fileName;
+		ETHResourceProvider::Log(ss.str(), Platform::Logger::ERROR);
+		return false;
+	}
+
+	// every entry must point inside the file, so lookups don't have to check it again
+	const std::size_t size = buffer->GetBufferSize();
+	const boost::uint32_t numTemplates = ReadUInt32(address + 8);
+	if (numTemplates > (size - HEADER_SIZE) / ENTRY_SIZE)
+		return false;
+	for (boost::uint32_t t = 0; t < numTemplates; t++)
+	{
+		const unsigned char* entry = address + HEADER_SIZE + (t * ENTRY_SIZE);
+		const std::size_t nameOffset = ReadUInt32(entry), nameSize = ReadUInt32(entry + 4);
+		const std::size_t dataOffset = ReadUInt32(entry + 8), dataSize = ReadUInt32(entry + 12);
+		if (nameOffset > size || nameSize > size - nameOffset || dataOffset > size || dataSize > size - dataOffset)
+		{
+			ETH_STREAM_DECL(ss) << GS_L("Corrupt entity bundle file: ") << fileName;
+			ETHResourceProvider::Log(ss.str(), Platform::Logger::ERROR);
+			return false;
+		}
+	}
+
+	m_buffer = buffer;
+	m_numTemplates = numTemplates;
+	return true;
+}
+
+bool ETHEntityTemplateBundle::IsLoaded() const
+{
+	return (m_buffer.get() != 0);
+}
+
+boost::uint32_t ETHEntityTemplateBundle::GetEntryField(const unsigned int index, const ENTRY_FIELD field) const
+{
+	return ReadUInt32(m_buffer->GetAddress() + HEADER_SIZE + (index * ENTRY_SIZE) + (field * 4));
+}
+
+int ETHEntityTemplateBundle::FindTemplate(const str_type::string& fileName) const
+{
+	int first = 0, last = static_cast<int>(m_numTemplates) - 1;
+	while (first <= last)
+	{
+		const int middle = first + ((last - first) / 2);
+		const char* name = reinterpret_cast<const char*>(m_buffer->GetAddress() + GetEntryField(middle, NAME_OFFSET));
+		const int comparison = fileName.compare(0, fileName.size(), name, GetEntryField(middle, NAME_SIZE));
+		if (comparison == 0)
+			return middle;
+		else if (comparison < 0)
+			last = middle - 1;
+		else
+			first = middle + 1;
+	}
+	return -1;
+}
+
+bool ETHEntityTemplateBundle::GetTemplate(const str_type::string& fileName, str_type::string& content) const
+{
+	if (!m_buffer)
+		return false;
+
+	const int index = FindTemplate(fileName);
+	if (index < 0)
+		return false;
+
+	const char* data = reinterpret_cast<const char*>(m_buffer->GetAddress() + GetEntryField(index, DATA_OFFSET));
+	content.assign(data, GetEntryField(index, DATA_SIZE));
+	return true;
+}
+
+unsigned int ETHEntityTemplateBundle::GetNumTemplates() const
+{
+	return m_numTemplates;
+}
+
+str_type::string ETHEntityTemplateBundle::GetTemplateName(const unsigned int index) const
+{
+	if (index >= m_numTemplates)
+		return GS_L("");
+
+	const char* name = reinterpret_cast<const char*>(m_buffer->GetAddress() + GetEntryField(index, NAME_OFFSET));
+	return str_type::string(name, GetEntryField(index, NAME_SIZE));
+}
@@ -0,0 +1,85 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#ifndef ETH_ENTITY_TEMPLATE_BUNDLE_H_
+#define ETH_ENTITY_TEMPLATE_BUNDLE_H_
+
+#include <Platform/FileManager.h>
+
+#include <boost/cstdint.hpp>
+
+using namespace gs2d;
+
+/**
+ * \brief Every entity template of a project packed in a single indexed file
+ *
+ * The file starts with a header and an index of entries sorted by template
+ * file name, each pointing at the name and the template text stored after
+ * it. Load() reads the whole file in one go, so looking up a template is a
+ * binary search in memory instead of a file probe and a file read. Templates
+ * keep their .ent markup; ETHEntityProperties still parses them.
+ */
+class ETHEntityTemplateBundle
+{
+public:
+	static const str_type::string DEFAULT_FILE_NAME;
+
+	/// Packs every .ent file directly inside entityDirectory. Returns the number of templates written, or -1 on failure
+	static int Compile(
+		const str_type::string& entityDirectory,
+		const str_type::string& outputFile,
+		const Platform::FileManagerPtr& fileManager);
+
+	ETHEntityTemplateBundle();
+
+	bool Load(const str_type::string& fileName, const Platform::FileManagerPtr& fileManager);
+	bool IsLoaded() const;
+
+	bool GetTemplate(const str_type::string& fileName, str_type::string& content) const;
+
+	unsigned int GetNumTemplates() const;
+	str_type::string GetTemplateName(const unsigned int index) const;
+
+private:
+	static const char MAGIC[4];
+	static const boost::uint32_t VERSION;
+	static const std::size_t HEADER_SIZE;
+	static const std::size_t ENTRY_SIZE;
+
+	enum ENTRY_FIELD
+	{
+		NAME_OFFSET = 0,
+		NAME_SIZE = 1,
+		DATA_OFFSET = 2,
+		DATA_SIZE = 3
+	};
+
+	boost::uint32_t GetEntryField(const unsigned int index, const ENTRY_FIELD field) const;
+	int FindTemplate(const str_type::string& fileName) const;
+
+	Platform::FileBuffer m_buffer;
+	unsigned int m_numTemplates;
+};
+
+typedef boost::shared_ptr<ETHEntityTemplateBundle> ETHEntityTemplateBundlePtr;
+
+#endif
@@ -0,0 +1,138 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of this
+	software and associated documentation files (the "Software"), to deal in the
+	Software without restriction, including without limitation the rights to use, copy,
+	modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+	and to permit persons to whom the Software is furnished to do so, subject to the
+	following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+	INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+	PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+	OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#include "ETHRenderEntity.h"
+
+// kept apart from the rest of ETHRenderEntity so it depends on math alone and the native
+// tests can compare the projected shadow batch with it headlessly
+bool ETHRenderEntity::ComputeProjShadow(
+	const PROJ_SHADOW_CASTER& caster,
+	const ETHSceneProperties& sceneProps,
+	const ETHLight& light,
+	const Vector3& lightPos,
+	const bool maxOpacity,
+	const bool drawToTarget,
+	const float targetAngle,
+	const Vector3& v3TargetPos,
+	PROJ_SHADOW& shadow)
+{
+	Vector3 v3LightPos = lightPos;
+	const Vector3 v3EntityPos = caster.pos;
+
+	// if the object is higher than the light, then the shadow shouldn't be cast on the floor
+	if (v3LightPos.z < v3EntityPos.z)
+	{
+		return false;
+	}
+
+	const float scale = (caster.shadowScale <= 0.0f) ? 1.0f : caster.shadowScale;
+	const float opacity = (caster.shadowOpacity <= 0.0f) ? 1.0f : caster.shadowOpacity;
+	const Vector2 v2Size = caster.size;
+	Vector2 v2ShadowSize(v2Size.x, v2Size.y);
+	Vector2 v2ShadowPos(v3EntityPos.x, v3EntityPos.y);
+
+	// if we are drawing to a target of a rotated entity
+	if (drawToTarget && targetAngle != 0)
+	{
+		// rotate the shadow position according to entity angle
+		Matrix4x4 matRot = RotateZ(-DegreeToRadian(targetAngle));
+		Vector3 newShadowPos(v2ShadowPos, 0);
+		newShadowPos = newShadowPos - v3TargetPos;
+		newShadowPos = Multiply(newShadowPos, matRot);
+		newShadowPos = newShadowPos + v3TargetPos;
+		v2ShadowPos.x = newShadowPos.x;
+		v2ShadowPos.y = newShadowPos.y;
+
+		// rotate the light source to cast it correctly
+		Vector3 newPos = v3LightPos - v3TargetPos;
+		newPos = Multiply(newPos, matRot);
+		v3LightPos = newPos + v3TargetPos;
+	}
+
+	Vector3 diff = v3EntityPos - v3LightPos;
+	const float squaredDist = DP3(diff, diff);
+	float squaredRange = light.range * light.range;
+
+	if (squaredDist > squaredRange)
+	{
+		return false;
+	}
+
+	v2ShadowSize.x *= _ETH_SHADOW_SCALEX * scale;
+
+	// calculate the correct shadow length according to the light height
+	if ((v3EntityPos.z+v2Size.y) < light.pos.z) // if the light is over the entity
+	{
+		const float planarDist = Distance(Vector2(v3EntityPos.x, v3EntityPos.y), Vector2(v3LightPos.x, v3LightPos.y));
+		const float verticalDist = Abs((v3EntityPos.z+v2Size.y)-v3LightPos.z);
+		const float totalDist = (planarDist/verticalDist)*Abs(v3LightPos.z);
+		v2ShadowSize.y = totalDist-planarDist;
+
+		// clamp shadow length to the object's height. This is not realistic
+		// but it looks better for the real-time shadows.
+		v2ShadowSize.y = Min(v2Size.y*_ETH_SHADOW_FAKE_STRETCH, v2ShadowSize.y);
+	}
+	else
+	{
+		v2ShadowSize.y *= ((drawToTarget) ? _ETH_SHADOW_SCALEY : _ETH_SHADOW_SCALEY/4);
+	}
+
+	// specify a minimum length for the shadow
+	v2ShadowSize.y = Max(v2ShadowSize.y, v2Size.y);
+
+	Vector2 lightPos2(v3LightPos.x, v3LightPos.y);
+	const float shadowAngle = ::GetAngle((lightPos2 - Vector2(v3EntityPos.x, v3EntityPos.y))) + DegreeToRadian(targetAngle);
+
+	squaredRange = Max(squaredDist, squaredRange);
+	float attenBias = 1;
+
+	// adjust brightness according to ambient light
+	if (!maxOpacity)
+	{
+		attenBias = (1-(squaredDist/squaredRange));
+		//fade the color according to the light brightness
+		const float colorLen = Max(Max(light.color.x, light.color.y), light.color.z);
+		attenBias *= Min(colorLen, 1.0f);
+
+		//fade the color according to the ambient light brightness
+		const Vector3 &ambientColor = sceneProps.ambient;
+		const float ambientColorLen = 1.0f - ((ambientColor.x + ambientColor.y + ambientColor.z) / 3.0f);
+		attenBias = Min(attenBias * ambientColorLen, 1.0f);
+		attenBias *= Max(Min((1 - (v3EntityPos.z / Max(v2Size.y, 1.0f))), 1.0f), 0.0f);
+	}
+
+	GS_BYTE alpha = static_cast<GS_BYTE>(attenBias*255.0f*opacity);
+
+	if (alpha < 8)
+		return false;
+
+	shadow.pos = v2ShadowPos;
+	shadow.width = v2ShadowSize.x;
+	shadow.length = v2ShadowSize.y * caster.shadowLengthScale;
+	shadow.entityZ = Max(caster.shadowZ, v3EntityPos.z);
+	shadow.shadowZ = caster.shadowZ;
+	shadow.lightPos = v3LightPos;
+	shadow.depth = caster.depth;
+	shadow.angle = shadowAngle;
+	shadow.color = Color(alpha,255,255,255);
+	return true;
+}
@@ -51,6 +51,29 @@ ETHRenderEntity::ETHRenderEntity(ETHResourceProviderPtr provider) :
 {
 }
 
+void ETHRenderEntity::Release()
+{
+	if (--m_ref == 0)
+	{
+		ETHEntityPoolPtr pool = m_pool.lock();
+		if (!pool || !pool->Recycle(this))
+		{
+			delete this;
+		}
+	}
+}
+
+void ETHRenderEntity::SetPool(const ETHEntityPoolPtr& pool, const str_type::string& templateName)
+{
+	m_pool = pool;
+	m_poolTemplateName = templateName;
+}
+
+const str_type::string& ETHRenderEntity::GetPoolTemplateName() const
+{
+	return m_poolTemplateName;
+}
+
 bool ETHRenderEntity::ShouldUseFourTriangles(const float parallaxIntensity) const
 {
 	if (!m_pSprite)
@@ -218,21 +241,54 @@ bool ETHRenderEntity::DrawProjShadow(
 	const float targetAngle,
 	const Vector3& v3TargetPos)
 {
+	static const Shader::CONSTANT_HANDLE SHADOW_LENGTH_HANDLE = Shader::GetConstantHandle(GS_L("shadowLength"));
+	static const Shader::CONSTANT_HANDLE ENTITY_Z_HANDLE = Shader::GetConstantHandle(GS_L("entityZ"));
+	static const Shader::CONSTANT_HANDLE SHADOW_Z_HANDLE = Shader::GetConstantHandle(GS_L("shadowZ"));
+	static const Shader::CONSTANT_HANDLE LIGHT_POS_HANDLE = Shader::GetConstantHandle(GS_L("lightPos"));
+
 	if (!m_pSprite || IsHidden())
 		return false;
 
+	PROJ_SHADOW shadow;
+	if (!ComputeProjShadow(maxHeight, minHeight, sceneProps, light, pParent, maxOpacity, drawToTarget, targetAngle, v3TargetPos, shadow))
+		return true;
+
 	VideoPtr video = m_provider->GetVideo();
-	ETHShaderManagerPtr shaderManager = m_provider->GetShaderManager();
-	SpritePtr pShadow = shaderManager->GetProjShadow();
+	SpritePtr pShadow = m_provider->GetShaderManager()->GetProjShadow();
 
-	Vector3 v3LightPos;
-	Vector3 v3ParentPos(0,0,0);
+	ShaderPtr pVS = video->GetVertexShader();
+	pVS->SetConstant(SHADOW_LENGTH_HANDLE, shadow.length);
+	pVS->SetConstant(ENTITY_Z_HANDLE, shadow.entityZ);
+	pVS->SetConstant(SHADOW_Z_HANDLE, shadow.shadowZ);
+	pVS->SetConstant(LIGHT_POS_HANDLE, shadow.lightPos);
+	video->SetSpriteDepth(shadow.depth);
 
-	const Vector3 v3EntityPos = GetPosition();
+	pShadow->SetOrigin(ETH_PROJ_SHADOW_ORIGIN);
+	pShadow->SetRectMode(Sprite::RM_THREE_TRIANGLES);
+	pShadow->DrawShaped(shadow.pos, Vector2(shadow.width, 1.0f),
+		shadow.color, shadow.color, shadow.color, shadow.color,
+		RadianToDegree(shadow.angle));
+	pShadow->SetRectMode(Sprite::RM_TWO_TRIANGLES);
 
+	return true;
+}
+
+bool ETHRenderEntity::ComputeProjShadow(
+	const float maxHeight,
+	const float minHeight,
+	const ETHSceneProperties& sceneProps,
+	const ETHLight& light,
+	ETHSpriteEntity *pParent,
+	const bool maxOpacity,
+	const bool drawToTarget,
+	const float targetAngle,
+	const Vector3& v3TargetPos,
+	PROJ_SHADOW& shadow) const
+{
+	Vector3 v3LightPos;
 	if (pParent)
 	{
-		v3ParentPos = pParent->GetPosition();
+		const Vector3 v3ParentPos = pParent->GetPosition();
 		v3LightPos = Vector3(v3ParentPos.x, v3ParentPos.y, 0) + light.pos;
 	}
 	else
@@ -240,115 +296,18 @@ bool ETHRenderEntity::DrawProjShadow(
 		v3LightPos = light.pos;
 	}
 
-	// if the object is higher than the light, then the shadow shouldn't be cast on the floor
-	if (v3LightPos.z < v3EntityPos.z)
-	{
-		return true;
-	}
-
-	const float scale = (m_properties.shadowScale <= 0.0f) ? 1.0f : m_properties.shadowScale;
-	const float opacity = (m_properties.shadowOpacity <= 0.0f) ? 1.0f : m_properties.shadowOpacity;
-	const Vector2 v2Size = GetCurrentSize();
-	Vector2 v2ShadowSize(v2Size.x, v2Size.y);
-	Vector2 v2ShadowPos(v3EntityPos.x, v3EntityPos.y);
-
-	// if we are drawing to a target of a rotated entity
-	if (drawToTarget && targetAngle != 0)
-	{
-		// rotate the shadow position according to entity angle
-		Matrix4x4 matRot = RotateZ(-DegreeToRadian(targetAngle));
-		Vector3 newShadowPos(v2ShadowPos, 0);
-		newShadowPos = newShadowPos - v3TargetPos;
-		newShadowPos = Multiply(newShadowPos, matRot);
-		newShadowPos = newShadowPos + v3TargetPos;
-		v2ShadowPos.x = newShadowPos.x;
-		v2ShadowPos.y = newShadowPos.y;
-
-		// rotate the light source to cast it correctly
-		Vector3 newPos = v3LightPos - v3TargetPos;
-		newPos = Multiply(newPos, matRot);
-		v3LightPos = newPos + v3TargetPos;
-	}
-
-	Vector3 diff = v3EntityPos - v3LightPos;
-	const float squaredDist = DP3(diff, diff);
-	float squaredRange = light.range * light.range;
-
-	if (squaredDist > squaredRange)
-	{
-		return true;
-	}
-
-	v2ShadowSize.x *= _ETH_SHADOW_SCALEX * scale;
-
-	// calculate the correct shadow length according to the light height
-	if ((GetPosition().z+v2Size.y) < light.pos.z) // if the light is over the entity
-	{
-		const float planarDist = Distance(GetPositionXY(), ETHGlobal::ToVector2(v3LightPos));
-		const float verticalDist = Abs((v3EntityPos.z+v2Size.y)-v3LightPos.z);
-		const float totalDist = (planarDist/verticalDist)*Abs(v3LightPos.z);
-		v2ShadowSize.y = totalDist-planarDist;
-
-		// clamp shadow length to the object's height. This is not realistic
-		// but it looks better for the real-time shadows.
-		v2ShadowSize.y = Min(v2Size.y*_ETH_SHADOW_FAKE_STRETCH, v2ShadowSize.y);
-	}
-	else
-	{
-		v2ShadowSize.y *= ((drawToTarget) ? _ETH_SHADOW_SCALEY : _ETH_SHADOW_SCALEY/4);
-	}
-
-	// specify a minimum length for the shadow
-	v2ShadowSize.y = Max(v2ShadowSize.y, v2Size.y);
-
-	ShaderPtr pVS = video->GetVertexShader();
-	pVS->SetConstant(GS_L("shadowLength"), v2ShadowSize.y * m_properties.shadowLengthScale);
-	pVS->SetConstant(GS_L("entityZ"), Max(m_shadowZ, v3EntityPos.z));
-	pVS->SetConstant(GS_L("shadowZ"), m_shadowZ);
-	pVS->SetConstant(GS_L("lightPos"), v3LightPos);
-	video->SetSpriteDepth(
-		(GetType() == ETHEntityProperties::ET_VERTICAL) ?
+	PROJ_SHADOW_CASTER caster;
+	caster.pos = GetPosition();
+	caster.size = GetCurrentSize();
+	caster.shadowZ = m_shadowZ;
+	caster.shadowScale = m_properties.shadowScale;
+	caster.shadowOpacity = m_properties.shadowOpacity;
+	caster.shadowLengthScale = m_properties.shadowLengthScale;
+	caster.depth = (GetType() == ETHEntityProperties::ET_VERTICAL) ?
 		ETHEntity::ComputeDepth(m_shadowZ, maxHeight, minHeight)
-		: Max(0.0f, ComputeDepth(maxHeight, minHeight) - m_layrableMinimumDepth));
-
-	v2ShadowSize.y = 1.0f;
-
-	Vector2 lightPos2(v3LightPos.x, v3LightPos.y);
-	const float shadowAngle = ::GetAngle((lightPos2 - Vector2(v3EntityPos.x, v3EntityPos.y))) + DegreeToRadian(targetAngle);
-
-	squaredRange = Max(squaredDist, squaredRange);
-	float attenBias = 1;
-
-	// adjust brightness according to ambient light
-	if (!maxOpacity)
-	{
-		attenBias = (1-(squaredDist/squaredRange));
-		//fade the color according to the light brightness
-		const float colorLen = Max(Max(light.color.x, light.color.y), light.color.z);
-		attenBias *= Min(colorLen, 1.0f);
-
-		//fade the color according to the ambient light brightness
-		const Vector3 &ambientColor = sceneProps.ambient;
-		const float ambientColorLen = 1.0f - ((ambientColor.x + ambientColor.y + ambientColor.z) / 3.0f);
-		attenBias = Min(attenBias * ambientColorLen, 1.0f);
-		attenBias *= Max(Min((1 - (GetPosition().z / Max(GetCurrentSize().y, 1.0f))), 1.0f), 0.0f);
-	}
+		: Max(0.0f, ComputeDepth(maxHeight, minHeight) - m_layrableMinimumDepth);
 
-	GS_BYTE alpha = static_cast<GS_BYTE>(attenBias*255.0f*opacity);
-
-	if (alpha < 8)
-		return true;
-
-	Color dwShadowColor(alpha,255,255,255);
-
-	pShadow->SetOrigin(Vector2(0.5f, 0.79f));
-	pShadow->SetRectMode(Sprite::RM_THREE_TRIANGLES);
-	pShadow->DrawShaped(v2ShadowPos, v2ShadowSize,
-		dwShadowColor, dwShadowColor, dwShadowColor, dwShadowColor,
-		RadianToDegree(shadowAngle));
-	pShadow->SetRectMode(Sprite::RM_TWO_TRIANGLES);
-
-	return true;
+	return ComputeProjShadow(caster, sceneProps, light, v3LightPos, maxOpacity, drawToTarget, targetAngle, v3TargetPos, shadow);
 }
 
 bool ETHRenderEntity::DrawHalo(
@@ -24,14 +24,13 @@
 #define ETH_RENDER_ENTITY_H_
 
 #include "ETHSpriteEntity.h"
+#include "ETHEntityPool.h"
 #include <boost/unordered/unordered_map.hpp>
 
 class ETHRenderEntity : public ETHSpriteEntity
 {
 	friend class ETHLightmapGen;
 
-	bool ShouldUseFourTriangles(const float parallaxIntensity) const;
-
 public:
 	ETHRenderEntity(const str_type::string& filePath, ETHResourceProviderPtr provider, const int nId =-1);
 	ETHRenderEntity(
@@ -42,7 +41,14 @@ public:
 	ETHRenderEntity(ETHResourceProviderPtr provider, const ETHEntityProperties& properties, const float angle, const float scale);
 	ETHRenderEntity(ETHResourceProviderPtr provider);
 
+	void Release();
+
+	/// Binds the entity to a pool, so it's handed back to it instead of being deleted
+	void SetPool(const ETHEntityPoolPtr& pool, const str_type::string& templateName);
+	const str_type::string& GetPoolTemplateName() const;
+
 	// rendering methods
+	bool ShouldUseFourTriangles(const float parallaxIntensity) const;
 	bool IsSpriteVisible(const ETHSceneProperties& sceneProps, const ETHBackBufferTargetManagerPtr& backBuffer) const;
 
 	bool DrawLightPass(const Vector2 &zAxisDirection, const float parallaxIntensity, const bool drawToTarget = false);
@@ -90,6 +96,61 @@ public:
 		const bool drawToTarget,
 		const float targetAngle,
 		const Vector3& v3TargetPos);
+
+	/// Everything the shadow vertex shader needs to project one shadow
+	struct PROJ_SHADOW
+	{
+		Vector2 pos;
+		float width;
+		float length;
+		float entityZ;
+		float shadowZ;
+		Vector3 lightPos;
+		float depth;
+		float angle;
+		Color color;
+	};
+
+	/// Returns false if the light casts no visible shadow of this entity
+	bool ComputeProjShadow(
+		const float maxHeight,
+		const float minHeight,
+		const ETHSceneProperties& sceneProps,
+		const ETHLight& light,
+		ETHSpriteEntity *pParent,
+		const bool maxOpacity,
+		const bool drawToTarget,
+		const float targetAngle,
+		const Vector3& v3TargetPos,
+		PROJ_SHADOW& shadow) const;
+
+	/// What ComputeProjShadow needs to know about the caster
+	struct PROJ_SHADOW_CASTER
+	{
+		Vector3 pos;
+		Vector2 size;
+		float shadowZ;
+		float shadowScale;
+		float shadowOpacity;
+		float shadowLengthScale;
+		float depth;
+	};
+
+	/// The shadow math itself, with the light position already offset by the parent's
+	static bool ComputeProjShadow(
+		const PROJ_SHADOW_CASTER& caster,
+		const ETHSceneProperties& sceneProps,
+		const ETHLight& light,
+		const Vector3& lightPos,
+		const bool maxOpacity,
+		const bool drawToTarget,
+		const float targetAngle,
+		const Vector3& v3TargetPos,
+		PROJ_SHADOW& shadow);
+
+private:
+	ETHEntityPoolWeakPtr m_pool;
+	str_type::string m_poolTemplateName;
 };
 
 #endif
\ No newline at end of file
@@ -28,6 +28,10 @@ ETHScriptEntity::ETHScriptEntity() :
 {
 }
 
+ETHScriptEntity::~ETHScriptEntity()
+{
+}
+
 void ETHScriptEntity::Kill()
 {
 	m_isAlive = false;
@@ -37,3 +41,9 @@ bool ETHScriptEntity::IsAlive() const
 {
 	return m_isAlive;
 }
+
+void ETHScriptEntity::Revive()
+{
+	m_ref = 1;
+	m_isAlive = true;
+}
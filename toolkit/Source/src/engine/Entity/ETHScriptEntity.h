@@ -42,8 +42,12 @@ class ETHScriptEntity
 
 protected:
 	ETHScriptEntity();
+	virtual ~ETHScriptEntity();
 	mutable int m_ref;
 
+	/// Brings a killed entity back to its newly constructed reference state
+	void Revive();
+
 public:
 	virtual ETHEntityProperties::ENTITY_TYPE GetType() const = 0;
 	virtual str_type::string GetEntityName() const = 0;
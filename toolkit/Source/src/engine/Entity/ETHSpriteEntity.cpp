@@ -104,7 +104,11 @@ void ETHSpriteEntity::Create()
 		m_pHalo = graphicResources->GetPointer(video, m_properties.light->haloBitmap, resourceDirectory, ETHDirectories::GetHaloDirectory(), true);
 
 	LoadParticleSystem();
+	SetupSpriteRects();
+}
 
+void ETHSpriteEntity::SetupSpriteRects()
+{
 	if (m_pSprite)
 	{
 		//TODO/TO-DO: Remove duplicated code
@@ -116,6 +120,66 @@ void ETHSpriteEntity::Create()
 	}
 }
 
+void ETHSpriteEntity::Recycle()
+{
+	ReleasePooledResources();
+	ReleaseLightmap();
+	m_preRenderedLightmapFilePath.clear();
+}
+
+bool ETHSpriteEntity::HasSameResources(const ETHEntityProperties& properties) const
+{
+	if (m_properties.spriteFile != properties.spriteFile
+		|| m_properties.normalFile != properties.normalFile
+		|| m_properties.glossFile != properties.glossFile
+		|| m_properties.particleSystems.size() != properties.particleSystems.size())
+	{
+		return false;
+	}
+
+	const str_type::string currentHalo = (m_properties.light) ? m_properties.light->haloBitmap : GS_L("");
+	const str_type::string newHalo = (properties.light) ? properties.light->haloBitmap : GS_L("");
+	return (currentHalo == newHalo);
+}
+
+void ETHSpriteEntity::Reuse(const ETHEntityProperties& properties, const float angle, const float scale)
+{
+	const bool sameResources = HasSameResources(properties);
+
+	ResetPooledState(properties);
+	m_properties.scale *= scale;
+	SetAngle(angle); // sets angle before restarting particles, just like the constructor
+
+	if (!sameResources || !m_provider->GetVideo() || !m_provider->GetGraphicResourceManager())
+	{
+		Create();
+		return;
+	}
+
+	// resources already resolved by the previous life: just restart the particle managers
+	const float particleScale = (GetScale().x + GetScale().y) / 2.0f;
+	for (std::size_t t = 0; t < m_particles.size(); t++)
+	{
+		const ETHParticleSystemPtr& system = m_properties.particleSystems[t];
+		if (system->nParticles <= 0)
+		{
+			m_particles[t].reset();
+		}
+		else if (m_particles[t])
+		{
+			// the template's definition is shared, so this is usually a restart in place
+			m_particles[t]->Restart(system, GetPositionXY(), GetPosition(), GetAngle(), particleScale);
+		}
+		else
+		{
+			m_particles[t] = ETHParticleManagerPtr(
+				new ETHParticleManager(m_provider, system, GetPositionXY(), GetPosition(),
+									   GetAngle(), particleScale));
+		}
+	}
+	SetupSpriteRects();
+}
+
 void ETHSpriteEntity::RecoverResources(const Platform::FileManagerPtr& expansionFileManager)
 {
 	Create();
@@ -315,7 +379,7 @@ void ETHSpriteEntity::LoadParticleSystem()
 
 			const float particleScale = (GetScale().x + GetScale().y) / 2.0f;
 			m_particles[t] = ETHParticleManagerPtr(
-				new ETHParticleManager(m_provider, *pSystem, GetPositionXY(), GetPosition(),
+				new ETHParticleManager(m_provider, m_properties.particleSystems[t], GetPositionXY(), GetPosition(),
 									   GetAngle(), particleScale));
 		}
 	}
@@ -450,13 +514,13 @@ bool ETHSpriteEntity::SaveLightmapToFile(const str_type::string& directory)
 	return true;
 }
 
-void ETHSpriteEntity::Update(const float lastFrameElapsedTime, const Vector2& zAxisDir, ETHBucketManager& buckets)
+void ETHSpriteEntity::Update(const float lastFrameElapsedTime, const Vector2& zAxisDir, ETHBucketManager& buckets, const bool particlesVisible)
 {
 	if (!IsStatic())
 	{
 		m_controller->Update(lastFrameElapsedTime, buckets);
 	}
-	UpdateParticleSystems(zAxisDir, lastFrameElapsedTime);
+	UpdateParticleSystems(zAxisDir, lastFrameElapsedTime, particlesVisible);
 }
 
 float ETHSpriteEntity::GetMaxHeight()
@@ -568,12 +632,17 @@ bool ETHSpriteEntity::AreParticlesOver() const
 	}
 }
 
-void ETHSpriteEntity::UpdateParticleSystems(const Vector2& zAxisDirection, const float lastFrameElapsedTime)
+void ETHSpriteEntity::UpdateParticleSystems(const Vector2& zAxisDirection, const float lastFrameElapsedTime, const bool visible)
 {
 	for (std::size_t t=0; t<m_particles.size(); t++)
 	{
-		if (m_particles[t])
+		if (!m_particles[t])
+			continue;
+
+		if (visible)
 			m_particles[t]->UpdateParticleSystem(ETHGlobal::ToScreenPos(GetPosition(), zAxisDirection), GetPosition(), GetAngle(), lastFrameElapsedTime);
+		else
+			m_particles[t]->SkipUpdate(ETHGlobal::ToScreenPos(GetPosition(), zAxisDirection), GetPosition(), GetAngle(), lastFrameElapsedTime);
 	}
 }
 
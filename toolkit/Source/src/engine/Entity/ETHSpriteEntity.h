@@ -45,6 +45,13 @@ public:
 
 	void Refresh(const ETHEntityProperties& properties);
 
+	/// Drops per-instance resources so the entity can wait in a pool
+	void Recycle();
+
+	/// Turns a recycled entity into a new instance of the given template. Sprite handles and
+	/// particle managers are kept whenever the template uses the same resources
+	void Reuse(const ETHEntityProperties& properties, const float angle, const float scale);
+
 	void AddRef();
 	void Release();
 
@@ -107,8 +114,10 @@ public:
 	str_type::string GetGlossName() const;
 	str_type::string GetHaloName() const;
 
-	void Update(const float lastFrameElapsedTime, const Vector2& zAxisDir, ETHBucketManager& buckets);
-	void UpdateParticleSystems(const Vector2& zAxisDirection, const float lastFrameElapsedTime);
+	void Update(const float lastFrameElapsedTime, const Vector2& zAxisDir, ETHBucketManager& buckets, const bool particlesVisible = true);
+
+	/// Invisible particle systems skip their simulation and catch up once they're visible again
+	void UpdateParticleSystems(const Vector2& zAxisDirection, const float lastFrameElapsedTime, const bool visible = true);
 
 	float ComputeLightIntensity();
 
@@ -139,6 +148,8 @@ protected:
 private:
 	void Create();
 	void Zero();
+	void SetupSpriteRects();
+	bool HasSameResources(const ETHEntityProperties& properties) const;
 };
 
 #endif
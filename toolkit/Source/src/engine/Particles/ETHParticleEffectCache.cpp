@@ -0,0 +1,137 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#include "ETHParticleEffectCache.h"
+
+const std::size_t ETHParticleEffect::MAX_IDLE_MANAGERS = 32;
+
+ETHParticleEffect::ETHParticleEffect(const ETHParticleSystem& system) :
+	m_system(new ETHParticleSystem(system)),
+	m_recycledSpawns(0),
+	m_allocatedManagers(0)
+{
+}
+
+const ETHParticleSystem& ETHParticleEffect::GetSystem() const
+{
+	return *m_system;
+}
+
+ETHParticleManagerPtr ETHParticleEffect::Acquire(
+	const ETHResourceProviderPtr& provider,
+	const Vector2& pos,
+	const float angle,
+	const float scale)
+{
+	if (!m_idle.empty())
+	{
+		ETHParticleManagerPtr manager = m_idle.back();
+		m_idle.pop_back();
+		manager->Restart(m_system, pos, Vector3(pos, 0.0f), angle, scale);
+		++m_recycledSpawns;
+		return manager;
+	}
+
+	++m_allocatedManagers;
+	return ETHParticleManagerPtr(new ETHParticleManager(provider, m_system, pos, Vector3(pos, 0.0f), angle, scale));
+}
+
+void ETHParticleEffect::Recycle(const ETHParticleManagerPtr& manager)
+{
+	if (manager && m_idle.size() < MAX_IDLE_MANAGERS)
+	{
+		m_idle.push_back(manager);
+	}
+}
+
+void ETHParticleEffect::ClearIdleManagers()
+{
+	m_idle.clear();
+}
+
+std::size_t ETHParticleEffect::GetNumIdleManagers() const
+{
+	return m_idle.size();
+}
+
+unsigned int ETHParticleEffect::GetNumRecycledSpawns() const
+{
+	return m_recycledSpawns;
+}
+
+unsigned int ETHParticleEffect::GetNumAllocatedManagers() const
+{
+	return m_allocatedManagers;
+}
+
+ETHParticleEffectCache::STATS::STATS() :
+	definitionHits(0),
+	definitionMisses(0),
+	recycledSpawns(0),
+	allocatedManagers(0)
+{
+}
+
+ETHParticleEffectPtr ETHParticleEffectCache::Get(const str_type::string& fullFilePath, const Platform::FileManagerPtr& fileManager)
+{
+	EffectMap::iterator iter = m_effects.find(fullFilePath);
+	if (iter != m_effects.end())
+	{
+		++m_stats.definitionHits;
+		return iter->second;
+	}
+
+	++m_stats.definitionMisses;
+	ETHParticleSystem system;
+	if (!system.ReadFromFile(fullFilePath, fileManager) || system.nParticles <= 0)
+	{
+		return ETHParticleEffectPtr();
+	}
+
+	ETHParticleEffectPtr effect(new ETHParticleEffect(system));
+	m_effects[fullFilePath] = effect;
+	return effect;
+}
+
+void ETHParticleEffectCache::ClearIdleManagers()
+{
+	for (EffectMap::iterator iter = m_effects.begin(); iter != m_effects.end(); ++iter)
+	{
+		iter->second->ClearIdleManagers();
+	}
+}
+
+void ETHParticleEffectCache::Clear()
+{
+	m_effects.clear();
+}
+
+ETHParticleEffectCache::STATS ETHParticleEffectCache::GetStats() const
+{
+	STATS stats = m_stats;
+	for (EffectMap::const_iterator iter = m_effects.begin(); iter != m_effects.end(); ++iter)
+	{
+		stats.recycledSpawns    += iter->second->GetNumRecycledSpawns();
+		stats.allocatedManagers += iter->second->GetNumAllocatedManagers();
+	}
+	return stats;
+}
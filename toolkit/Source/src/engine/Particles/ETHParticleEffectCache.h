@@ -0,0 +1,94 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#ifndef ETH_PARTICLE_EFFECT_CACHE_H_
+#define ETH_PARTICLE_EFFECT_CACHE_H_
+
+#include "ETHParticleManager.h"
+
+#include <map>
+#include <vector>
+
+/// Immutable particle system definition shared by every one-shot effect spawned from the
+/// same file. Managers of finished effects are kept and restarted by the next spawn, so a
+/// warmed-up effect costs neither file parsing nor particle buffer allocation
+class ETHParticleEffect
+{
+public:
+	static const std::size_t MAX_IDLE_MANAGERS;
+
+	ETHParticleEffect(const ETHParticleSystem& system);
+
+	const ETHParticleSystem& GetSystem() const;
+
+	/// Returns a manager started at the given position, restarting an idle one if possible
+	ETHParticleManagerPtr Acquire(
+		const ETHResourceProviderPtr& provider,
+		const Vector2& pos,
+		const float angle,
+		const float scale);
+
+	/// Gives back a manager previously handed out by Acquire
+	void Recycle(const ETHParticleManagerPtr& manager);
+
+	void ClearIdleManagers();
+	std::size_t GetNumIdleManagers() const;
+	unsigned int GetNumRecycledSpawns() const;
+	unsigned int GetNumAllocatedManagers() const;
+
+private:
+	const ETHParticleSystemPtr m_system;
+	std::vector<ETHParticleManagerPtr> m_idle;
+	unsigned int m_recycledSpawns;
+	unsigned int m_allocatedManagers;
+};
+
+typedef boost::shared_ptr<ETHParticleEffect> ETHParticleEffectPtr;
+
+/// Parsed particle effect definitions indexed by their full file path
+class ETHParticleEffectCache
+{
+public:
+	struct STATS
+	{
+		STATS();
+		unsigned int definitionHits;
+		unsigned int definitionMisses;
+		unsigned int recycledSpawns;
+		unsigned int allocatedManagers;
+	};
+
+	ETHParticleEffectPtr Get(const str_type::string& fullFilePath, const Platform::FileManagerPtr& fileManager);
+
+	/// Drops the idle managers, which also releases the particle bitmaps they still reference
+	void ClearIdleManagers();
+
+	void Clear();
+	STATS GetStats() const;
+
+private:
+	typedef std::map<str_type::string, ETHParticleEffectPtr> EffectMap;
+	EffectMap m_effects;
+	STATS m_stats;
+};
+
+#endif
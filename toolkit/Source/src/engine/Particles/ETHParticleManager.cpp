@@ -41,7 +41,12 @@ ETHParticleManager::ETHParticleManager(
 	const Vector2& v2Pos,
 	const Vector3& v3Pos,
 	const float angle) :
-	m_provider(provider)
+	m_provider(provider),
+	m_sleepingFrames(0),
+	m_sleepingTime(0.0f),
+	m_sleepFinishTime(-1.0f),
+	m_sleepingAngle(0.0f),
+	m_sourceScale(1.0f)
 {
 	ETHParticleSystem partSystem;
 	if (partSystem.ReadFromFile(file, m_provider->GetFileManager()))
@@ -62,11 +67,37 @@ ETHParticleManager::ETHParticleManager(
 	const Vector3& v3Pos,
 	const float angle,
 	const float scale) :
-	m_provider(provider)
+	m_provider(provider),
+	m_sleepingFrames(0),
+	m_sleepingTime(0.0f),
+	m_sleepFinishTime(-1.0f),
+	m_sleepingAngle(0.0f),
+	m_sourceScale(1.0f)
 {
 	CreateParticleSystem(partSystem, v2Pos, v3Pos, angle, scale);
 }
 
+ETHParticleManager::ETHParticleManager(
+	ETHResourceProviderPtr provider,
+	const ETHParticleSystemPtr& partSystem,
+	const Vector2& v2Pos,
+	const Vector3& v3Pos,
+	const float angle,
+	const float scale) :
+	m_provider(provider),
+	m_sleepingFrames(0),
+	m_sleepingTime(0.0f),
+	m_sleepFinishTime(-1.0f),
+	m_sleepingAngle(0.0f),
+	m_sourceScale(1.0f)
+{
+	if (CreateParticleSystem(*partSystem, v2Pos, v3Pos, angle, scale))
+	{
+		m_source = partSystem;
+		m_sourceScale = scale;
+	}
+}
+
 bool ETHParticleManager::CreateParticleSystem(
 	const ETHParticleSystem& partSystem,
 	const Vector2& v2Pos,
@@ -82,9 +113,7 @@ bool ETHParticleManager::CreateParticleSystem(
 		return false;
 	}
 
-	m_finished = false;
-	m_killed = false;
-	m_nActiveParticles = 0;
+	m_source.reset();
 	m_system = partSystem;
 
 	m_system.Scale(scale);
@@ -94,37 +123,74 @@ bool ETHParticleManager::CreateParticleSystem(
 		m_system.bitmapFile = ETH_DEFAULT_PARTICLE_BITMAP;
 	}
 
-	ETHGraphicResourceManagerPtr graphics = m_provider->GetGraphicResourceManager();
-	ETHAudioResourceManagerPtr samples = m_provider->GetAudioResourceManager();
-	Platform::FileIOHubPtr fileIOHub = m_provider->GetFileIOHub();
-	Platform::FileManagerPtr fileManager = m_provider->GetFileManager();
-
-	// if there's no resource path, search the current module's path
-	const str_type::string& resourcePath = fileIOHub->GetResourceDirectory();
-	const str_type::string& programPath  = fileIOHub->GetProgramDirectory();
-	const str_type::string currentPath = (resourcePath.empty() && !fileManager->IsPacked()) ? programPath : resourcePath;
+	// without a provider the system is only simulated, e.g. by headless tests
+	if (m_provider)
+	{
+		ETHGraphicResourceManagerPtr graphics = m_provider->GetGraphicResourceManager();
+		Platform::FileIOHubPtr fileIOHub = m_provider->GetFileIOHub();
+		Platform::FileManagerPtr fileManager = m_provider->GetFileManager();
 
-	m_pBMP = graphics->GetPointer(m_provider->GetVideo(), m_system.bitmapFile, currentPath,
-		ETHDirectories::GetParticlesDirectory(), (m_system.alphaMode == Video::AM_ADD));
+		// if there's no resource path, search the current module's path
+		const str_type::string& resourcePath = fileIOHub->GetResourceDirectory();
+		const str_type::string& programPath  = fileIOHub->GetProgramDirectory();
+		const str_type::string currentPath = (resourcePath.empty() && !fileManager->IsPacked()) ? programPath : resourcePath;
 
-	if (m_system.allAtOnce)
-	{
-		m_nActiveParticles = m_system.nParticles;
-	}
-	else
-	{
-		m_nActiveParticles = 0;
+		m_pBMP = graphics->GetPointer(m_provider->GetVideo(), m_system.bitmapFile, currentPath,
+			ETHDirectories::GetParticlesDirectory(), (m_system.alphaMode == Video::AM_ADD));
 	}
 
 	m_particles.resize(m_system.nParticles);
+	ResetParticles(v2Pos, Vector3(v2Pos,0), angle);
+	return true;
+}
+
+void ETHParticleManager::ResetParticles(const Vector2& v2Pos, const Vector3& v3Pos, const float angle)
+{
+	m_finished = false;
+	m_killed = false;
+	m_sleepingFrames = 0;
+	m_sleepingTime = 0.0f;
+	m_nActiveParticles = (m_system.allAtOnce) ? m_system.nParticles : 0;
 
 	Matrix4x4 rot = RotateZ(DegreeToRadian(angle));
 	for (int t = 0; t < m_system.nParticles; t++)
 	{
+		// a restarted buffer still holds the previous run's counters
+		m_particles[t] = PARTICLE();
 		m_particles[t].id = t;
-		m_particles[t].released = false;
-		ResetParticle(t, v2Pos, Vector3(v2Pos,0), angle, rot);
+		ResetParticle(t, v2Pos, v3Pos, angle, rot);
+	}
+}
+
+bool ETHParticleManager::IsCopyOf(const ETHParticleSystemPtr& partSystem, const float scale) const
+{
+	if (!m_source || m_source != partSystem || m_sourceScale != scale)
+		return false;
+
+	// entities may swap the bitmap of a definition they share, so that field is checked too
+	return (partSystem->bitmapFile.empty())
+		? (m_system.bitmapFile == ETH_DEFAULT_PARTICLE_BITMAP)
+		: (m_system.bitmapFile == partSystem->bitmapFile);
+}
+
+bool ETHParticleManager::Restart(
+	const ETHParticleSystemPtr& partSystem,
+	const Vector2& v2Pos,
+	const Vector3& v3Pos,
+	const float angle,
+	const float scale)
+{
+	if (IsCopyOf(partSystem, scale) && m_pBMP)
+	{
+		ResetParticles(v2Pos, Vector3(v2Pos,0), angle);
+		return true;
 	}
+
+	if (!CreateParticleSystem(*partSystem, v2Pos, v3Pos, angle, scale))
+		return false;
+
+	m_source = partSystem;
+	m_sourceScale = scale;
 	return true;
 }
 
@@ -135,6 +201,7 @@ Vector3 ETHParticleManager::GetStartPos() const
 
 void ETHParticleManager::SetStartPos(const Vector3& v3Pos)
 {
+	m_source.reset();
 	m_system.startPoint = v3Pos;
 }
 
@@ -150,17 +217,20 @@ str_type::string ETHParticleManager::GetBitmapName() const
 
 void ETHParticleManager::Kill(const bool kill)
 {
+	WakeUp();
 	m_killed = kill;
 }
 
 void ETHParticleManager::SetSystem(const ETHParticleSystem &partSystem)
 {
+	m_source.reset();
 	//partSystem.nParticles = m_system.nParticles;
 	m_system = partSystem;
 }
 
 void ETHParticleManager::SetParticleBitmap(SpritePtr pBMP)
 {
+	m_source.reset();
 	m_pBMP = pBMP;
 }
 
@@ -191,9 +261,10 @@ bool ETHParticleManager::UpdateParticleSystem(
 	const float angle,
 	const float lastFrameElapsedTime)
 {
+	WakeUp();
+
 	bool anythingDrawn = false;
-	const float cappedLastFrameElapsedTime = Min(lastFrameElapsedTime, 250.0f);
-	const float frameSpeed = static_cast<float>((static_cast<double>(cappedLastFrameElapsedTime) / 1000.0) * 60.0);
+	const float frameSpeed = ComputeFrameSpeed(lastFrameElapsedTime);
 
 	Matrix4x4 rot = RotateZ(DegreeToRadian(angle));
 	m_nActiveParticles = 0;
@@ -219,10 +290,7 @@ bool ETHParticleManager::UpdateParticleSystem(
 		if (!particle.released)
 		{
 			// if we shouldn't release all particles at the same time, check if it's time to release this particle
-			const float releaseTime = 
-				((m_system.lifeTime + m_system.randomizeLifeTime) * (static_cast<float>(particle.id) / static_cast<float>(m_system.nParticles)));
-
-			if (particle.elapsed > releaseTime || m_system.allAtOnce)
+			if (particle.elapsed > GetReleaseTime(particle) || m_system.allAtOnce)
 			{
 				particle.elapsed = 0.0f;
 				particle.released = true;
@@ -236,19 +304,7 @@ bool ETHParticleManager::UpdateParticleSystem(
 			particle.pos += (particle.dir * frameSpeed);
 			particle.angle += (particle.angleDir * frameSpeed);
 			particle.size  += (m_system.growth * frameSpeed);
-			const float w = particle.elapsed / particle.lifeTime;
-			particle.color = m_system.color0 + (m_system.color1 - m_system.color0) * w;
-
-			// update particle animation if there is any
-			if (m_system.spriteCut.x > 1 || m_system.spriteCut.y > 1)
-			{
-				if (m_system.animationMode == ETHParticleSystem::PLAY_ANIMATION)
-				{
-					particle.currentFrame = static_cast<unsigned int>(
-						Min(static_cast<int>(static_cast<float>(m_system.GetNumFrames()) * w),
-							m_system.GetNumFrames() - 1));
-				}
-			}
+			ComputeParticleColorAndFrame(particle);
 
 			particle.size = Min(particle.size, m_system.maxSize);
 			particle.size = Max(particle.size, m_system.minSize);
@@ -266,6 +322,218 @@ bool ETHParticleManager::UpdateParticleSystem(
 	return true;
 }
 
+void ETHParticleManager::SkipUpdate(
+	const Vector2& v2Pos,
+	const Vector3& v3Pos,
+	const float angle,
+	const float lastFrameElapsedTime)
+{
+	// killed systems keep counting repeats frame by frame, so they aren't worth putting to sleep
+	if (Killed() || m_finished)
+	{
+		UpdateParticleSystem(v2Pos, v3Pos, angle, lastFrameElapsedTime);
+		return;
+	}
+
+	if (m_sleepingFrames == 0)
+	{
+		m_sleepFinishTime = (m_system.repeat > 0) ? ComputeMaxRemainingTime(lastFrameElapsedTime) : -1.0f;
+	}
+
+	m_sleepingFrames++;
+	m_sleepingTime += lastFrameElapsedTime;
+	m_sleepingV2Pos = v2Pos;
+	m_sleepingV3Pos = v3Pos;
+	m_sleepingAngle = angle;
+
+	// temporary entities are removed once their particles finish, so finite systems
+	// must still find out when that happens
+	if (m_sleepFinishTime >= 0.0f && m_sleepingTime > m_sleepFinishTime)
+	{
+		WakeUp();
+		m_finished = HaveAllParticlesFinished();
+	}
+}
+
+bool ETHParticleManager::IsAsleep() const
+{
+	return (m_sleepingFrames > 0);
+}
+
+void ETHParticleManager::WakeUp()
+{
+	if (m_sleepingFrames == 0)
+		return;
+
+	const unsigned int frames = m_sleepingFrames;
+	const float frameTime = m_sleepingTime / static_cast<float>(frames);
+	m_sleepingFrames = 0;
+	m_sleepingTime = 0.0f;
+
+	if (frameTime <= 0.0f)
+		return;
+
+	const Matrix4x4 rot = RotateZ(DegreeToRadian(m_sleepingAngle));
+	for (int t = 0; t < m_system.nParticles; t++)
+	{
+		FastForwardParticle(t, frames, frameTime, m_sleepingV2Pos, m_sleepingV3Pos, m_sleepingAngle, rot);
+	}
+}
+
+void ETHParticleManager::FastForwardParticle(
+	const int t,
+	unsigned int frames,
+	const float frameTime,
+	const Vector2& v2Pos,
+	const Vector3& v3Pos,
+	const float angle,
+	const Matrix4x4& rotMatrix)
+{
+	const float frameSpeed = ComputeFrameSpeed(frameTime);
+	PARTICLE& particle = m_particles[t];
+
+	// replays UpdateParticleSystem one life cycle at a time instead of one frame at a time
+	while (frames > 0)
+	{
+		if (m_system.repeat > 0)
+			if (particle.repeat >= m_system.repeat)
+				return;
+
+		if (!particle.released)
+		{
+			const unsigned int releaseFrames = (m_system.allAtOnce)
+				? 1 : CountFramesUntilPassed(GetReleaseTime(particle) - particle.elapsed, frameTime, frames);
+
+			if (releaseFrames > frames)
+			{
+				particle.elapsed += frameTime * static_cast<float>(frames);
+				return;
+			}
+
+			// the particle is released and moved within the same frame
+			frames -= releaseFrames;
+			particle.elapsed = 0.0f;
+			particle.released = true;
+			PositionParticle(t, v2Pos, angle, rotMatrix, v3Pos);
+			AdvanceParticle(particle, 1, frameSpeed);
+			continue;
+		}
+
+		const unsigned int lifeFrames = CountFramesUntilPassed(particle.lifeTime - particle.elapsed, frameTime, frames);
+		if (lifeFrames > frames)
+		{
+			particle.elapsed += frameTime * static_cast<float>(frames);
+			AdvanceParticle(particle, frames, frameSpeed);
+			return;
+		}
+
+		frames -= lifeFrames;
+		particle.repeat++;
+		ResetParticle(t, v2Pos, v3Pos, angle, rotMatrix);
+
+		// an endless particle looks the same after any number of whole cycles, so long
+		// sleeps don't need to be replayed cycle by cycle
+		if (m_system.repeat <= 0)
+		{
+			const unsigned int cycleFrames = CountFramesUntilPassed(particle.lifeTime, frameTime, frames);
+			if (cycleFrames < frames)
+			{
+				const unsigned int skippedCycles = (frames / cycleFrames) - 1;
+				frames -= skippedCycles * cycleFrames;
+				particle.repeat += static_cast<int>(skippedCycles);
+			}
+		}
+	}
+}
+
+void ETHParticleManager::AdvanceParticle(PARTICLE& particle, const unsigned int frames, const float frameSpeed) const
+{
+	// dir(n) = dir + gravity * speed * n
+	// pos(n) = pos + dir * speed * n + gravity * speed^2 * n * (n + 1) / 2
+	const float n = static_cast<float>(frames);
+	const float distance = frameSpeed * n;
+	particle.pos   += (particle.dir * distance) + (m_system.gravityVector * (frameSpeed * frameSpeed * n * (n + 1.0f) * 0.5f));
+	particle.dir   += (m_system.gravityVector * distance);
+	particle.angle += (particle.angleDir * distance);
+	particle.size  += (m_system.growth * distance);
+	particle.size = Min(particle.size, m_system.maxSize);
+	particle.size = Max(particle.size, m_system.minSize);
+	ComputeParticleColorAndFrame(particle);
+}
+
+void ETHParticleManager::ComputeParticleColorAndFrame(PARTICLE& particle) const
+{
+	const float w = particle.elapsed / particle.lifeTime;
+	particle.color = m_system.color0 + (m_system.color1 - m_system.color0) * w;
+
+	// update particle animation if there is any
+	if (m_system.spriteCut.x > 1 || m_system.spriteCut.y > 1)
+	{
+		if (m_system.animationMode == ETHParticleSystem::PLAY_ANIMATION)
+		{
+			particle.currentFrame = static_cast<unsigned int>(
+				Min(static_cast<int>(static_cast<float>(m_system.GetNumFrames()) * w),
+					m_system.GetNumFrames() - 1));
+		}
+	}
+}
+
+float ETHParticleManager::GetReleaseTime(const PARTICLE& particle) const
+{
+	// particles are released one after the other along the first life cycle
+	return ((m_system.lifeTime + m_system.randomizeLifeTime) * (static_cast<float>(particle.id) / static_cast<float>(m_system.nParticles)));
+}
+
+bool ETHParticleManager::HaveAllParticlesFinished() const
+{
+	if (m_system.repeat <= 0)
+		return false;
+
+	for (int t = 0; t < m_system.nParticles; t++)
+	{
+		if (m_particles[t].repeat < m_system.repeat)
+			return false;
+	}
+	return true;
+}
+
+float ETHParticleManager::ComputeMaxRemainingTime(const float frameTime) const
+{
+	// a particle only dies on the first frame past its life time
+	const float maxLifeTime = m_system.lifeTime + (m_system.randomizeLifeTime / 2.0f) + frameTime;
+
+	float r = 0.0f;
+	for (int t = 0; t < m_system.nParticles; t++)
+	{
+		const PARTICLE& particle = m_particles[t];
+		if (particle.repeat >= m_system.repeat)
+			continue;
+
+		const float remainingCycles = static_cast<float>(m_system.repeat - particle.repeat);
+		const float remainingTime = (particle.released)
+			? Max(particle.lifeTime - particle.elapsed, 0.0f) + frameTime + (maxLifeTime * (remainingCycles - 1.0f))
+			: Max(GetReleaseTime(particle) - particle.elapsed, 0.0f) + frameTime + (maxLifeTime * remainingCycles);
+		r = Max(r, remainingTime);
+	}
+	return r;
+}
+
+unsigned int ETHParticleManager::CountFramesUntilPassed(const float time, const float frameTime, const unsigned int maxFrames)
+{
+	if (time < 0.0f)
+		return 1;
+
+	// the first frame whose accumulated time is greater than 'time', or maxFrames + 1 if none is
+	const float frames = floorf(time / frameTime) + 1.0f;
+	return (frames > static_cast<float>(maxFrames)) ? (maxFrames + 1) : static_cast<unsigned int>(frames);
+}
+
+float ETHParticleManager::ComputeFrameSpeed(const float lastFrameElapsedTime)
+{
+	const float cappedLastFrameElapsedTime = Min(lastFrameElapsedTime, 250.0f);
+	return static_cast<float>((static_cast<double>(cappedLastFrameElapsedTime) / 1000.0) * 60.0);
+}
+
 bool ETHParticleManager::Finished() const
 {
 	return m_finished;
@@ -275,6 +543,8 @@ bool ETHParticleManager::Play(const Vector2 &v2Pos, const Vector3 &v3Pos, const
 {
 	Matrix4x4 rot = RotateZ(DegreeToRadian(angle));
 	m_finished = false;
+	m_sleepingFrames = 0;
+	m_sleepingTime = 0.0f;
 	for (int t = 0; t < m_system.nParticles; t++)
 	{
 		m_particles[t].repeat = 0;
@@ -343,6 +613,10 @@ bool ETHParticleManager::DrawParticleSystem(
 	const Vector2& parallaxOffset,
 	const float ownerDepth)
 {
+	static const Shader::CONSTANT_HANDLE HIGHLIGHT_HANDLE = Shader::GetConstantHandle(GS_L("highlight"));
+
+	WakeUp();
+
 	if (!m_pBMP)
 	{
 		ETH_STREAM_DECL(ss) << GS_L("ETHParticleManager::DrawParticleSystem: Invalid particle system bitmap");
@@ -363,6 +637,18 @@ bool ETHParticleManager::DrawParticleSystem(
 	const bool shouldUseHightlightPS = m_system.ShouldUseHighlightPS();
 	const ShaderPtr& currentPS = m_provider->GetVideo()->GetPixelShader();
 
+	// every particle shares the system's z, so the in-screen offset and the ambient
+	// color are the same for the whole system
+	const Vector2 zAxisOffset(zAxisDirection * m_system.startPoint.z);
+	Vector3 finalAmbient(1, 1, 1);
+	if (m_system.alphaMode == Video::AM_PIXEL || m_system.alphaMode == Video::AM_ALPHA_TEST)
+	{
+		finalAmbient.x = Min(m_system.emissive.x + ambient.x, 1.0f);
+		finalAmbient.y = Min(m_system.emissive.y + ambient.y, 1.0f);
+		finalAmbient.z = Min(m_system.emissive.z + ambient.z, 1.0f);
+	}
+	const Vector4 finalAmbient4(finalAmbient, 1.0f);
+
 	m_pBMP->SetOrigin(Sprite::EO_CENTER);
 	for (int t = 0; t < m_system.nParticles; t++)
 	{
@@ -378,18 +664,10 @@ bool ETHParticleManager::DrawParticleSystem(
 		if (Killed() && particle.elapsed > particle.lifeTime)
 			continue;
 
-		Vector3 finalAmbient(1, 1, 1);
-		if (m_system.alphaMode == Video::AM_PIXEL || m_system.alphaMode == Video::AM_ALPHA_TEST)
-		{
-			finalAmbient.x = Min(m_system.emissive.x + ambient.x, 1.0f);
-			finalAmbient.y = Min(m_system.emissive.y + ambient.y, 1.0f);
-			finalAmbient.z = Min(m_system.emissive.z + ambient.z, 1.0f);
-		}
-
-		Vector4 finalColor = particle.color * Vector4(finalAmbient, 1.0f);
+		const Vector4 finalColor = particle.color * finalAmbient4;
 
 		// compute the right in-screen position
-		const Vector2 v2Pos = ETHGlobal::ToScreenPos(Vector3(particle.pos, m_system.startPoint.z), zAxisDirection);
+		const Vector2 v2Pos = particle.pos + zAxisOffset;
 
 		SetParticleDepth(ComputeParticleDepth(ownerType, ownerDepth, particle, maxHeight, minHeight));
 
@@ -407,7 +685,7 @@ bool ETHParticleManager::DrawParticleSystem(
 		
 		if (shouldUseHightlightPS)
 		{
-			currentPS->SetConstant(GS_L("highlight"), finalColor);
+			currentPS->SetConstant(HIGHLIGHT_HANDLE, finalColor);
 		}
 		
 		m_pBMP->DrawOptimal((v2Pos + parallaxOffset), finalColor, particle.angle, Vector2(particle.size, particle.size));
@@ -418,6 +696,7 @@ bool ETHParticleManager::DrawParticleSystem(
 
 void ETHParticleManager::SetZPosition(const float z)
 {
+	m_source.reset();
 	m_system.startPoint.z = z;
 }
 
@@ -443,6 +722,8 @@ bool ETHParticleManager::IsEndless() const
 
 void ETHParticleManager::ScaleParticleSystem(const float scale)
 {
+	WakeUp();
+	m_source.reset();
 	m_system.Scale(scale);
 	for (std::size_t t = 0; t < m_particles.size(); t++)
 	{
@@ -452,6 +733,8 @@ void ETHParticleManager::ScaleParticleSystem(const float scale)
 
 void ETHParticleManager::MirrorX(const bool mirrorGravity)
 {
+	WakeUp();
+	m_source.reset();
 	m_system.MirrorX(mirrorGravity);
 	for (int t = 0; t < m_system.nParticles; t++)
 	{
@@ -462,6 +745,8 @@ void ETHParticleManager::MirrorX(const bool mirrorGravity)
 
 void ETHParticleManager::MirrorY(const bool mirrorGravity)
 {
+	WakeUp();
+	m_source.reset();
 	m_system.MirrorY(mirrorGravity);
 	for (int t = 0; t < m_system.nParticles; t++)
 	{
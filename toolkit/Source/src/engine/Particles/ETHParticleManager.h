@@ -31,6 +31,9 @@
 
 class ETHParticleManager
 {
+	// checks the closed-form catch-up against the particle state
+	friend class ETHParticleManagerTest;
+
 public:
 	enum DEPTH_SORTING_MODE
 	{
@@ -55,6 +58,15 @@ public:
 		const float angle,
 		const float scale);
 
+	/// Create from a shared definition, which Restart can later start over without copying it again
+	ETHParticleManager(
+		ETHResourceProviderPtr provider,
+		const ETHParticleSystemPtr& partSystem,
+		const Vector2& v2Pos,
+		const Vector3& v3Pos,
+		const float angle,
+		const float scale);
+
 	/// Update the position, size and angle of all particles in the system (if they are active)
 	/// Must be called once every frame (only once). The new particles are positioned according
 	/// to v2Pos and it's starting position
@@ -64,6 +76,17 @@ public:
 		const float angle,
 		const float lastFrameElapsedTime);
 
+	/// Skip the simulation for this frame while the system is out of sight. The skipped frames
+	/// are evaluated in closed form as soon as the system is updated or drawn again
+	void SkipUpdate(
+		const Vector2& v2Pos,
+		const Vector3& v3Pos,
+		const float angle,
+		const float lastFrameElapsedTime);
+
+	/// Return true if there are skipped frames waiting to be evaluated
+	bool IsAsleep() const;
+
 	/// Draw all particles also considering it's ambient light color
 	bool DrawParticleSystem(
 		Vector3 v3Ambient,
@@ -81,6 +104,16 @@ public:
 	/// Restart the system execution by setting all particles repeat count to zero
 	bool Play(const Vector2 &v2Pos, const Vector3 &v3Pos, const float angle);
 
+	/// Start over with a new system configuration, reusing the particle buffer. Restarting
+	/// the definition it already runs, at the same scale, skips the system copy and the
+	/// bitmap lookup unless the manager was modified in the meantime
+	bool Restart(
+		const ETHParticleSystemPtr& partSystem,
+		const Vector2& v2Pos,
+		const Vector3& v3Pos,
+		const float angle,
+		const float scale);
+
 	/// Set another system configuration (it can be used during the animation)
 	void SetSystem(const ETHParticleSystem &partSystem);
 
@@ -186,6 +219,17 @@ private:
 	int m_nActiveParticles;
 	Vector2 m_v2Move;
 
+	unsigned int m_sleepingFrames;
+	float m_sleepingTime;
+	float m_sleepFinishTime;
+	Vector2 m_sleepingV2Pos;
+	Vector3 m_sleepingV3Pos;
+	float m_sleepingAngle;
+
+	// definition m_system was copied from, reset once m_system is changed in place
+	ETHParticleSystemPtr m_source;
+	float m_sourceScale;
+
 	static void Sort(std::vector<PARTICLE> &v);
 
 	/// Create a particle system
@@ -196,9 +240,39 @@ private:
 		const float angle,
 		const float scale);
 
+	/// Put every particle back to its starting state, as if the system had just been created
+	void ResetParticles(const Vector2& v2Pos, const Vector3& v3Pos, const float angle);
+
+	/// Return true if m_system is still an unmodified copy of partSystem at this scale
+	bool IsCopyOf(const ETHParticleSystemPtr& partSystem, const float scale) const;
+
 	void ResetParticle(const int t, const Vector2& v2Pos, const Vector3& v3Pos, const float angle, const Matrix4x4& rotMatrix);
 	void PositionParticle(const int t, const Vector2& v2Pos, const float angle, const Matrix4x4& rotMatrix, const Vector3& v3Pos);
 	void SetParticleDepth(const float depth);
+	void ComputeParticleColorAndFrame(PARTICLE& particle) const;
+	float GetReleaseTime(const PARTICLE& particle) const;
+	bool HaveAllParticlesFinished() const;
+
+	/// Evaluate every skipped frame at once, as if the emitter had stood still while asleep
+	void WakeUp();
+
+	/// Longest time the remaining repeats of a finite system may take
+	float ComputeMaxRemainingTime(const float frameTime) const;
+
+	void FastForwardParticle(
+		const int t,
+		unsigned int frames,
+		const float frameTime,
+		const Vector2& v2Pos,
+		const Vector3& v3Pos,
+		const float angle,
+		const Matrix4x4& rotMatrix);
+
+	/// Closed form of 'frames' integration steps of constant frame speed
+	void AdvanceParticle(PARTICLE& particle, const unsigned int frames, const float frameSpeed) const;
+
+	static unsigned int CountFramesUntilPassed(const float time, const float frameTime, const unsigned int maxFrames);
+	static float ComputeFrameSpeed(const float lastFrameElapsedTime);
 
 public:
 	static float ComputeParticleDepth(
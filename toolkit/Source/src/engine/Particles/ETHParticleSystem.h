@@ -87,4 +87,6 @@ public:
 	float randAngleStart;
 };
 
+typedef boost::shared_ptr<ETHParticleSystem> ETHParticleSystemPtr;
+
 #endif
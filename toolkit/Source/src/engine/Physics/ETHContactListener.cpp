@@ -26,13 +26,16 @@
 
 ETHContactListener::ETHContactListener() :
 	m_disableNextContact(false),
-	m_runningPreSolveContactCallback(false)
+	m_runningPreSolveContactCallback(false),
+	m_numEventsLastStep(0),
+	m_numCallbacksLastStep(0),
+	m_callbackTimeLastStepMS(0.0f)
 {
 }
 
 ETHContactListener::~ETHContactListener()
 {
-	ClearStackedEndContactCallbacks();
+	ClearEvents();
 }
 
 static bool GetContactData(
@@ -49,13 +52,15 @@ static bool GetContactData(
 	b2WorldManifold worldManifold; 
 	contact->GetWorldManifold(&worldManifold); 
 
-	const b2Body* bodyA = contact->GetFixtureA()->GetBody();
-	*entityA = static_cast<ETHEntity*>(bodyA->GetUserData());
+	// merged static colliders are resolved to the entity closest to the contact
+	const b2Fixture* fixtureA = contact->GetFixtureA();
+	const b2Fixture* fixtureB = contact->GetFixtureB();
+	const bool hasPoints = (contact->GetManifold()->pointCount > 0);
+	*entityA = ETHStaticColliderMerger::GetFixtureEntity(fixtureA, hasPoints ? worldManifold.points[0] : fixtureB->GetBody()->GetWorldCenter());
 
 	*controllerA = static_cast<ETHPhysicsEntityController*>((*entityA)->GetController().get());
 
-	const b2Body* bodyB = contact->GetFixtureB()->GetBody();
-	*entityB = static_cast<ETHEntity*>(bodyB->GetUserData());
+	*entityB = ETHStaticColliderMerger::GetFixtureEntity(fixtureB, hasPoints ? worldManifold.points[0] : fixtureA->GetBody()->GetWorldCenter());
 	*controllerB = static_cast<ETHPhysicsEntityController*>((*entityB)->GetController().get());
 
 	// if both entities don't have the current callback type assigned to it, don't even bother...
@@ -100,8 +105,7 @@ void ETHContactListener::BeginContact(b2Contact* contact)
 		normal,
 		ETHPhysicsEntityController::CONTACT_CALLBACKS::BEGIN))
 	{
-		controllerA->RunBeginContactCallback(entityB, point0, point1, normal);
-		controllerB->RunBeginContactCallback(entityA, point0, point1, normal);
+		RecordEvent(ETHPhysicsEntityController::CONTACT_CALLBACKS::BEGIN, entityA, entityB, point0, point1, normal);
 	}
 }
 
@@ -152,55 +156,98 @@ void ETHContactListener::EndContact(b2Contact* contact)
 		normal,
 		ETHPhysicsEntityController::CONTACT_CALLBACKS::END))
 	{
-		EndContactCallbackDataPtr data(new EndContactCallbackData);
+		RecordEvent(ETHPhysicsEntityController::CONTACT_CALLBACKS::END, entityA, entityB, point0, point1, normal);
+	}
+}
 
-		entityA->AddRef();
-		data->entityA = entityA;
-		entityB->AddRef();
-		data->entityB = entityB;
+void ETHContactListener::RecordEvent(
+	const ETHPhysicsEntityController::CONTACT_CALLBACKS::TYPE type,
+	ETHEntity* entityA,
+	ETHEntity* entityB,
+	const math::Vector2& point0,
+	const math::Vector2& point1,
+	const math::Vector2& normal)
+{
+	// both entities must stay alive until their callbacks run, even if the script deletes them
+	entityA->AddRef();
+	entityB->AddRef();
 
-		data->normal = normal;
-		data->point0 = point0;
-		data->point1 = point1;
+	m_events.resize(m_events.size() + 1);
+	CONTACT_EVENT& contactEvent = m_events.back();
+	contactEvent.type = type;
+	contactEvent.entityA = entityA;
+	contactEvent.entityB = entityB;
+	contactEvent.point0 = point0;
+	contactEvent.point1 = point1;
+	contactEvent.normal = normal;
+}
 
-		m_stackedEndContactCallbacks.push_back(data);
+void ETHContactListener::ClearEvents()
+{
+	for (std::size_t t = 0; t < m_events.size(); t++)
+	{
+		m_events[t].entityA->Release();
+		m_events[t].entityB->Release();
 	}
+	m_events.clear();
 }
 
-void ETHContactListener::ClearStackedEndContactCallbacks()
+bool ETHContactListener::RunRecordedCallback(const CONTACT_EVENT& contactEvent, ETHEntity* entity, ETHEntity* other)
 {
-	for (std::list<EndContactCallbackDataPtr>::iterator iter = m_stackedEndContactCallbacks.begin();
-		iter != m_stackedEndContactCallbacks.end(); ++iter)
+	ETHPhysicsEntityController* controller = static_cast<ETHPhysicsEntityController*>(entity->GetController().get());
+	if (!controller || !controller->HasBody())
+		return false;
+
+	Vector2 point0(contactEvent.point0), point1(contactEvent.point1), normal(contactEvent.normal);
+	if (contactEvent.type == ETHPhysicsEntityController::CONTACT_CALLBACKS::BEGIN)
 	{
-		EndContactCallbackDataPtr data = (*iter);
-		data->entityA->Release();
-		data->entityB->Release();
+		if (!controller->HasBeginContactCallback())
+			return false;
+		controller->RunBeginContactCallback(other, point0, point1, normal);
+	}
+	else
+	{
+		if (!controller->HasEndContactCallback())
+			return false;
+		controller->RunEndContactCallback(other, point0, point1, normal);
 	}
-	m_stackedEndContactCallbacks.clear();
+	return true;
 }
 
-void ETHContactListener::RunAndClearStackedEndContactCallbacks()
+void ETHContactListener::RunAndClearRecordedContactCallbacks(const VideoPtr& video)
 {
-	for (std::list<EndContactCallbackDataPtr>::iterator iter = m_stackedEndContactCallbacks.begin();
-		iter != m_stackedEndContactCallbacks.end(); ++iter)
+	const float startTime = video->GetElapsedTimeF();
+	m_numCallbacksLastStep = 0;
+
+	// callbacks may destroy bodies, which makes Box2D report more end contacts. They are
+	// appended to the buffer and run in this same loop, so events are copied before use
+	for (std::size_t t = 0; t < m_events.size(); t++)
 	{
-		EndContactCallbackDataPtr data = (*iter);
-		
-		ETHPhysicsEntityController* controllerA = static_cast<ETHPhysicsEntityController*>(data->entityA->GetController().get());
-		ETHPhysicsEntityController* controllerB = static_cast<ETHPhysicsEntityController*>(data->entityB->GetController().get());
+		const CONTACT_EVENT contactEvent = m_events[t];
+		if (RunRecordedCallback(contactEvent, contactEvent.entityA, contactEvent.entityB))
+			++m_numCallbacksLastStep;
+		if (RunRecordedCallback(contactEvent, contactEvent.entityB, contactEvent.entityA))
+			++m_numCallbacksLastStep;
+	}
 
-		if (controllerA)
-			if (controllerA->GetBody())
-				controllerA->RunEndContactCallback(data->entityB, data->point0, data->point1, data->normal);
+	m_numEventsLastStep = static_cast<unsigned int>(m_events.size());
+	ClearEvents();
+	m_callbackTimeLastStepMS = video->GetElapsedTimeF() - startTime;
+}
 
-		if (controllerB)
-			if (controllerB->GetBody())
-				controllerB->RunEndContactCallback(data->entityA, data->point0, data->point1, data->normal);
+unsigned int ETHContactListener::GetNumContactEventsLastStep() const
+{
+	return m_numEventsLastStep;
+}
 
-		data->entityA->Release();
-		data->entityB->Release();
-	}
-	m_stackedEndContactCallbacks.clear();
+unsigned int ETHContactListener::GetNumContactCallbacksLastStep() const
+{
+	return m_numCallbacksLastStep;
+}
+
+float ETHContactListener::GetContactCallbackTimeLastStepMS() const
+{
+	return m_callbackTimeLastStepMS;
 }
 
 void ETHContactListener::DisableNextContact()
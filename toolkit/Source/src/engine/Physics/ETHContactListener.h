@@ -23,7 +23,7 @@
 #ifndef ETH_CONTACT_LISTENER
 #define ETH_CONTACT_LISTENER
 
-#include "../Entity/ETHEntity.h"
+#include "ETHPhysicsEntityController.h"
 
 #include <Box2D/Box2D.h>
 
@@ -34,24 +34,42 @@ class ETHContactListener : public b2ContactListener
 	void PreSolve(b2Contact* contact, const b2Manifold* oldManifold);
 	bool m_disableNextContact, m_runningPreSolveContactCallback;
 
-	struct EndContactCallbackData
+	// begin and end contacts are recorded while b2World::Step runs and their callbacks
+	// are executed once it returns. The buffer keeps its capacity between steps, so
+	// recording contacts doesn't allocate once it has grown to the scene's needs
+	struct CONTACT_EVENT
 	{
+		ETHPhysicsEntityController::CONTACT_CALLBACKS::TYPE type;
 		math::Vector2 point0, point1, normal;
 		ETHEntity *entityA, *entityB;
 	};
 
-	typedef boost::shared_ptr<EndContactCallbackData> EndContactCallbackDataPtr;
+	std::vector<CONTACT_EVENT> m_events;
+	unsigned int m_numEventsLastStep;
+	unsigned int m_numCallbacksLastStep;
+	float m_callbackTimeLastStepMS;
 
-	std::list<EndContactCallbackDataPtr> m_stackedEndContactCallbacks;
+	void RecordEvent(
+		const ETHPhysicsEntityController::CONTACT_CALLBACKS::TYPE type,
+		ETHEntity* entityA,
+		ETHEntity* entityB,
+		const math::Vector2& point0,
+		const math::Vector2& point1,
+		const math::Vector2& normal);
 
-	void ClearStackedEndContactCallbacks();
+	void ClearEvents();
+	static bool RunRecordedCallback(const CONTACT_EVENT& contactEvent, ETHEntity* entity, ETHEntity* other);
 
 public:
 	ETHContactListener();
 	~ETHContactListener();
 	void DisableNextContact();
 	bool IsRunningPreSolveContactCallback() const;
-	void RunAndClearStackedEndContactCallbacks();
+	void RunAndClearRecordedContactCallbacks(const VideoPtr& video);
+
+	unsigned int GetNumContactEventsLastStep() const;
+	unsigned int GetNumContactCallbacksLastStep() const;
+	float GetContactCallbackTimeLastStepMS() const;
 };
 
 #endif
@@ -27,6 +27,8 @@ ETHPhysicsController::ETHPhysicsController(const ETHPhysicsEntityControllerPtr&
 	m_globalScaleManager(globalScaleManager),
 	m_ref(1)
 {
+	// scripts work on the entity's own body
+	m_controller->Unmerge();
 }
 
 void ETHPhysicsController::AddRef()
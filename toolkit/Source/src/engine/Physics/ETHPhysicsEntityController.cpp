@@ -48,13 +48,18 @@ ETHPhysicsEntityController::ETHPhysicsEntityController(
 	asIScriptContext* context) :
 	ETHRawEntityController(old, 0, 0, 0),
 	m_body(body),
-	m_world(world)
+	m_world(world),
+	m_previousAngle(0.0f),
+	m_interpolationAlpha(1.0f)
 {
+	SavePreviousTransform();
+
 	ETHRawEntityControllerPtr raw = boost::dynamic_pointer_cast<ETHRawEntityController>(old);
 	if (raw)
 	{
 		m_callback = raw->GetCallback();
 		m_constructorCallback = raw->GetConstructorCallback();
+		m_batchCallback = raw->GetBatchCallback();
 		m_pContext = context;
 		m_contactCallbacks.beginContact    = GetContactCallback(BEGIN_CONTACT_CALLBACK_PREFIX,    module);
 		m_contactCallbacks.endContact      = GetContactCallback(END_CONTACT_CALLBACK_PREFIX,      module);
@@ -79,14 +84,35 @@ void ETHPhysicsEntityController::Update(const float lastFrameElapsedTime, ETHBuc
 		return;
 
 	GS2D_UNUSED_ARGUMENT(lastFrameElapsedTime);
-	const Vector2 pos = ETHPhysicsSimulator::ScaleFromBox2D(m_body->GetPosition());
+	b2Vec2 bodyPos = m_body->GetPosition();
+	float32 bodyAngle = m_body->GetAngle();
+	if (m_interpolationAlpha < 1.0f)
+	{
+		bodyPos = m_previousPosition + m_interpolationAlpha * (bodyPos - m_previousPosition);
+		bodyAngle = m_previousAngle + m_interpolationAlpha * (bodyAngle - m_previousAngle);
+	}
+
+	const Vector2 pos = ETHPhysicsSimulator::ScaleFromBox2D(bodyPos);
 	const Vector2 oldPos = Vector2(m_pos.x, m_pos.y);
 	if (oldPos != pos)
 	{
 		m_pos = Vector3(pos, GetPos().z);
 		buckets.RequestBucketMove(static_cast<ETHEntity*>(m_body->GetUserData()), oldPos, pos);
 	}
-	m_angle =-RadianToDegree(m_body->GetAngle());
+	m_angle =-RadianToDegree(bodyAngle);
+}
+
+void ETHPhysicsEntityController::SavePreviousTransform()
+{
+	if (!m_body)
+		return;
+	m_previousPosition = m_body->GetPosition();
+	m_previousAngle = m_body->GetAngle();
+}
+
+void ETHPhysicsEntityController::SetInterpolationAlpha(const float alpha)
+{
+	m_interpolationAlpha = alpha;
 }
 
 void ETHPhysicsEntityController::SetPos(const Vector3& pos)
@@ -97,10 +123,12 @@ void ETHPhysicsEntityController::SetPos(const Vector3& pos)
 
 void ETHPhysicsEntityController::SetPosXY(const Vector2& pos)
 {
+	Unmerge();
 	if (m_body)
 	{
 		m_body->SetTransform(ETHPhysicsSimulator::ScaleToBox2D(pos), m_body->GetAngle());
 		m_body->SetAwake(true);
+		SavePreviousTransform();
 	}
 	m_pos.x = pos.x;
 	m_pos.y = pos.y;
@@ -134,10 +162,12 @@ void ETHPhysicsEntityController::AddToPosY(const float v)
 
 void ETHPhysicsEntityController::AddToPosXY(const Vector2& pos)
 {
+	Unmerge();
 	if (m_body)
 	{
 		m_body->SetTransform(ETHPhysicsSimulator::ScaleToBox2D(pos) + m_body->GetPosition(), m_body->GetAngle());
 		m_body->SetAwake(true);
+		SavePreviousTransform();
 	}
 	const Vector2 currentPos(ETHPhysicsSimulator::ScaleFromBox2D(m_body->GetPosition()));
 	m_pos.x = currentPos.x;
@@ -146,26 +176,32 @@ void ETHPhysicsEntityController::AddToPosXY(const Vector2& pos)
 
 void ETHPhysicsEntityController::AddToAngle(const float angle)
 {
+	Unmerge();
 	if (m_body)
 	{
 		m_body->SetTransform(m_body->GetPosition(),-DegreeToRadian(angle) + m_body->GetAngle());
 		m_body->SetAwake(true);
+		SavePreviousTransform();
 	}
 	m_angle += angle;
 }
 
 void ETHPhysicsEntityController::SetAngle(const float angle)
 {
+	Unmerge();
 	if (m_body)
 	{
 		m_body->SetTransform(m_body->GetPosition(),-DegreeToRadian(angle));
 		m_body->SetAwake(true);
+		SavePreviousTransform();
 	}
 	m_angle = angle;
 }
 
 void ETHPhysicsEntityController::Destroy()
 {
+	Unmerge();
+
 	// only kill joints. Box2D will destroy them automatically
 	for (std::size_t t = 0; t < m_joints.size(); t++)
 	{
@@ -190,6 +226,7 @@ void ETHPhysicsEntityController::Scale(const Vector2& scale, ETHEntity* entity)
 	GS2D_UNUSED_ARGUMENT(scale);
 	Destroy();
 	m_body = ETHPhysicsSimulator::CreateBody(entity, m_world);
+	SavePreviousTransform();
 }
 
 bool ETHPhysicsEntityController::HasBeginContactCallback() const
@@ -246,9 +283,44 @@ bool ETHPhysicsEntityController::IsValidFunction(asIScriptFunction* func) const
 
 b2Body* ETHPhysicsEntityController::GetBody()
 {
+	Unmerge();
 	return m_body;
 }
 
+bool ETHPhysicsEntityController::HasBody() const
+{
+	return (m_body != 0);
+}
+
+void ETHPhysicsEntityController::SetMergedCollider(const ETHStaticColliderMerger::MergedColliderPtr& collider)
+{
+	m_mergedCollider = collider;
+	if (m_body)
+		m_body->SetActive(false);
+}
+
+bool ETHPhysicsEntityController::IsMerged() const
+{
+	return static_cast<bool>(m_mergedCollider);
+}
+
+void ETHPhysicsEntityController::Unmerge()
+{
+	if (!m_mergedCollider)
+		return;
+
+	// keeps the collider alive while it resets every member, this one included
+	const ETHStaticColliderMerger::MergedColliderPtr collider(m_mergedCollider);
+	collider->Unmerge();
+}
+
+void ETHPhysicsEntityController::RestoreBody()
+{
+	m_mergedCollider.reset();
+	if (m_body)
+		m_body->SetActive(true);
+}
+
 bool ETHPhysicsEntityController::ResolveJoints(ETHEntityArray& entities, const ETHEntityProperties& properties, ETHPhysicsSimulator& simulator)
 {
 	if (properties.enmlJointDefinitions == GS_L(""))
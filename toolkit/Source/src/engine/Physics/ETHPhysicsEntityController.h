@@ -26,6 +26,7 @@
 #include "../Entity/ETHEntity.h"
 #include "../Entity/ETHEntityArray.h"
 #include "ETHJoint.h"
+#include "ETHStaticColliderMerger.h"
 
 using namespace gs2d::math;
 using namespace gs2d;
@@ -35,6 +36,7 @@ class ETHPhysicsController;
 class ETHPhysicsEntityController : public ETHRawEntityController
 {
 	friend class ETHPhysicsController;
+	friend class ETHStaticColliderMerger;
 	bool RunContactCallback(asIScriptFunction* func, ETHEntity* other, Vector2& point0, Vector2& point1, Vector2& normal);
 
 public:
@@ -82,6 +84,20 @@ public:
 	std::size_t GetNumJoints() const;
 	ETHJointPtr GetJoint(const std::size_t joindIdx);
 	b2Body* GetBody();
+	bool HasBody() const;
+
+	// static collider merging: while merged, the entity's own body is kept inactive and
+	// its collision is handled by a fixture shared with its neighbours. Anything that needs
+	// the body back (moving, scaling, joints, script access) restores it with Unmerge
+	void SetMergedCollider(const ETHStaticColliderMerger::MergedColliderPtr& collider);
+	bool IsMerged() const;
+	void Unmerge();
+	void RestoreBody();
+
+	// fixed time step interpolation: the entity is rendered between the body
+	// transform saved before the last physics step and the current one
+	void SavePreviousTransform();
+	void SetInterpolationAlpha(const float alpha);
 
 	void SetPosXY(const Vector2& pos);
 	void SetPosX(const float v);
@@ -95,6 +111,10 @@ protected:
 	boost::shared_ptr<b2World> m_world;
 	CONTACT_CALLBACKS m_contactCallbacks;
 	std::vector<ETHJointPtr> m_joints;
+	b2Vec2 m_previousPosition;
+	float32 m_previousAngle;
+	float m_interpolationAlpha;
+	ETHStaticColliderMerger::MergedColliderPtr m_mergedCollider;
 	asIScriptFunction* GetContactCallback(const str_type::string& prefix, asIScriptModule* module);
 	bool IsValidFunction(asIScriptFunction* func) const;
 };
@@ -27,6 +27,7 @@ const b2Vec2 ETHPhysicsSimulator::DEFAULT_GRAVITY(0, 10);
 const float ETHPhysicsSimulator::DEFAULT_SCALE(50.0f);
 int32 ETHPhysicsSimulator::m_velocityIterations(5);
 int32 ETHPhysicsSimulator::m_positionIterations(2);
+unsigned int ETHPhysicsSimulator::m_solverThreads(1);
 
 std::vector<b2Shape*> ETHPhysicsSimulator::GetBoxShape(const ETHCollisionBox& box, const float angle)
 {
@@ -126,18 +127,27 @@ ETHPhysicsSimulator::ETHPhysicsSimulator(ETHGlobalScaleManagerPtr globalScaleMan
 	m_fixedTimeStepValue(1.0f / 60.0f),
 	m_dynamicTimeStep(1.0f / currentFpsRate),
 	m_timeStepUpdateTime(0.0f),
+	m_fixedTimeStepInterpolation(false),
+	m_interpolatedLastFrame(false),
+	m_timeAccumulator(0.0f),
+	m_maxSubSteps(4),
+	m_numStepsLastFrame(0),
 	m_globalScaleManager(globalScaleManager)
 {
 	const bool doSleep = true; // just making it more readable
 	m_world = boost::shared_ptr<b2World>(new b2World((m_globalScaleManager->GetScale()) * DEFAULT_GRAVITY, doSleep));
 	m_world->SetContactListener(&m_contactListener);
 	m_world->SetDestructionListener(&m_destructionListener);
+	m_world->SetSolverThreadCount(static_cast<int32>(m_solverThreads));
 }
 
 ETHPhysicsSimulator::~ETHPhysicsSimulator()
 {
 	m_world->SetContactListener(NULL);
 	m_world->SetDestructionListener(NULL);
+
+	// gives the members their bodies, and their references, back while the world is still there
+	m_colliderMerger.UnmergeAll();
 	m_world.reset();
 }
 
@@ -153,13 +163,155 @@ ETHPhysicsEntityControllerPtr ETHPhysicsSimulator::CreatePhysicsController(
 	return ETHPhysicsEntityControllerPtr(new ETHPhysicsEntityController(entity->GetController(), body, world, module, context));
 }
 
-void ETHPhysicsSimulator::Update(const float lastFrameElapsedTime)
+void ETHPhysicsSimulator::Update(const float lastFrameElapsedTime, const VideoPtr& video)
 {
 	m_dynamicTimeStep = (static_cast<float32>(lastFrameElapsedTime) / 1000.0f);
-	const float step = (!m_fixedTimeStep) ? m_dynamicTimeStep : m_fixedTimeStepValue;
-	m_world->Step(step * m_timeStepScale, m_velocityIterations, m_positionIterations);
+	if (m_fixedTimeStep && m_fixedTimeStepInterpolation && m_fixedTimeStepValue > 0.0f)
+	{
+		StepAccumulatedTime();
+		m_interpolatedLastFrame = true;
+	}
+	else
+	{
+		// interpolation has just been turned off: put the entities back on their bodies
+		if (m_interpolatedLastFrame)
+		{
+			SetInterpolationAlpha(1.0f);
+			m_interpolatedLastFrame = false;
+			m_timeAccumulator = 0.0f;
+		}
+
+		const float step = (!m_fixedTimeStep) ? m_dynamicTimeStep : m_fixedTimeStepValue;
+		m_world->Step(step * m_timeStepScale, m_velocityIterations, m_positionIterations);
+		m_colliderMerger.ApplyPendingUnmerges();
+		m_numStepsLastFrame = 1;
+	}
+
+	// contacts recorded through all sub steps are dispatched at once
+	m_contactListener.RunAndClearRecordedContactCallbacks(video);
+}
+
+void ETHPhysicsSimulator::StepAccumulatedTime()
+{
+	m_timeAccumulator += m_dynamicTimeStep;
+
+	unsigned int numSteps = static_cast<unsigned int>(m_timeAccumulator / m_fixedTimeStepValue);
+	if (numSteps > m_maxSubSteps)
+	{
+		// the simulation can't keep up with real time. Drop the backlog rather than
+		// spending even longer frames catching up, which would only make it worse
+		numSteps = m_maxSubSteps;
+		m_timeAccumulator = m_fixedTimeStepValue * static_cast<float>(numSteps);
+	}
+
+	for (unsigned int t = 0; t < numSteps; t++)
+	{
+		// only the state before the last step is needed for interpolation
+		if (t == numSteps - 1)
+			SavePreviousBodyTransforms();
+
+		m_world->Step(m_fixedTimeStepValue * m_timeStepScale, m_velocityIterations, m_positionIterations);
+		m_colliderMerger.ApplyPendingUnmerges();
+		m_timeAccumulator -= m_fixedTimeStepValue;
+	}
+	m_timeAccumulator = Max(m_timeAccumulator, 0.0f);
+	m_numStepsLastFrame = numSteps;
+
+	SetInterpolationAlpha(Min(m_timeAccumulator / m_fixedTimeStepValue, 1.0f));
+}
+
+void ETHPhysicsSimulator::SavePreviousBodyTransforms()
+{
+	for (b2Body* body = m_world->GetBodyList(); body; body = body->GetNext())
+	{
+		if (body->GetType() == b2_staticBody)
+			continue;
+
+		ETHEntity* entity = static_cast<ETHEntity*>(body->GetUserData());
+		ETHPhysicsEntityControllerPtr controller = boost::dynamic_pointer_cast<ETHPhysicsEntityController>(entity->GetController());
+		if (controller)
+			controller->SavePreviousTransform();
+	}
+}
+
+void ETHPhysicsSimulator::SetInterpolationAlpha(const float alpha)
+{
+	for (b2Body* body = m_world->GetBodyList(); body; body = body->GetNext())
+	{
+		if (body->GetType() == b2_staticBody)
+			continue;
+
+		ETHEntity* entity = static_cast<ETHEntity*>(body->GetUserData());
+		ETHPhysicsEntityControllerPtr controller = boost::dynamic_pointer_cast<ETHPhysicsEntityController>(entity->GetController());
+		if (controller)
+			controller->SetInterpolationAlpha(alpha);
+	}
+}
+
+void ETHPhysicsSimulator::SetFixedTimeStepInterpolation(const bool enable)
+{
+	m_fixedTimeStepInterpolation = enable;
+}
+
+bool ETHPhysicsSimulator::IsFixedTimeStepInterpolationEnabled() const
+{
+	return m_fixedTimeStepInterpolation;
+}
+
+void ETHPhysicsSimulator::SetMaxSubSteps(const unsigned int maxSubSteps)
+{
+	m_maxSubSteps = Max(maxSubSteps, 1u);
+}
+
+unsigned int ETHPhysicsSimulator::GetMaxSubSteps() const
+{
+	return m_maxSubSteps;
+}
+
+unsigned int ETHPhysicsSimulator::GetNumStepsLastFrame() const
+{
+	return m_numStepsLastFrame;
+}
+
+void ETHPhysicsSimulator::SetSolverThreadCount(const unsigned int count)
+{
+	m_solverThreads = Max(count, 1u);
+	m_world->SetSolverThreadCount(static_cast<int32>(m_solverThreads));
+}
+
+unsigned int ETHPhysicsSimulator::GetSolverThreadCount() const
+{
+	return static_cast<unsigned int>(m_world->GetSolverThreadCount());
+}
 
-	m_contactListener.RunAndClearStackedEndContactCallbacks();
+void ETHPhysicsSimulator::BeginBulkLoad()
+{
+	m_world->BeginBulkLoad();
+}
+
+void ETHPhysicsSimulator::EndBulkLoad()
+{
+	m_world->EndBulkLoad();
+}
+
+void ETHPhysicsSimulator::RebuildBroadPhase()
+{
+	m_world->RebuildBroadPhase();
+}
+
+unsigned int ETHPhysicsSimulator::GetNumContactEventsLastStep() const
+{
+	return m_contactListener.GetNumContactEventsLastStep();
+}
+
+unsigned int ETHPhysicsSimulator::GetNumContactCallbacksLastStep() const
+{
+	return m_contactListener.GetNumContactCallbacksLastStep();
+}
+
+float ETHPhysicsSimulator::GetContactCallbackTimeLastStepMS() const
+{
+	return m_contactListener.GetContactCallbackTimeLastStepMS();
 }
 
 float ETHPhysicsSimulator::GetCurrentDynamicTimeStepMS() const
@@ -230,6 +382,11 @@ float ETHPhysicsSimulator::GetTimeStepScale() const
 	return m_timeStepScale;
 }
 
+unsigned int ETHPhysicsSimulator::MergeStaticColliders(ETHEntityArray& entities, const Vector2& regionSize)
+{
+	return m_colliderMerger.Merge(entities, m_world.get(), ScaleToBox2D(regionSize));
+}
+
 ETHEntity* ETHPhysicsSimulator::GetClosestContact(const Vector2& a, const Vector2& b, Vector2& point, Vector2& normal)
 {
 	if (a == b)
@@ -40,13 +40,24 @@ class ETHPhysicsSimulator
 	const static float  DEFAULT_SCALE;
 	static int32 m_velocityIterations;
 	static int32 m_positionIterations;
+	static unsigned int m_solverThreads;
 	float m_timeStepScale;
 	float m_dynamicTimeStep;
 	bool m_fixedTimeStep;
 	float m_fixedTimeStepValue;
 	float m_timeStepUpdateTime;
+	bool m_fixedTimeStepInterpolation;
+	bool m_interpolatedLastFrame;
+	float m_timeAccumulator;
+	unsigned int m_maxSubSteps;
+	unsigned int m_numStepsLastFrame;
 	ETHDestructionListener m_destructionListener;
 	ETHGlobalScaleManagerPtr m_globalScaleManager;
+	ETHStaticColliderMerger m_colliderMerger;
+
+	void StepAccumulatedTime();
+	void SavePreviousBodyTransforms();
+	void SetInterpolationAlpha(const float alpha);
 
 public:
 	ETHPhysicsSimulator(ETHGlobalScaleManagerPtr globalScaleManager, const float currentFpsRate);
@@ -61,7 +72,7 @@ public:
 	static b2Body* CreateBody(ETHEntity *entity, const boost::shared_ptr<b2World>& world);
 	static ETHPhysicsEntityControllerPtr CreatePhysicsController(ETHEntity *entity, const boost::shared_ptr<b2World>& world,
 		asIScriptModule* module, asIScriptContext* context);
-	void Update(const float lastFrameElapsedTime);
+	void Update(const float lastFrameElapsedTime, const VideoPtr& video);
 	static b2Vec2 ScaleToBox2D(const Vector2& v);
 	static Vector2 ScaleFromBox2D(const b2Vec2& v);
 	static float32 ScaleToBox2D(const float& v);
@@ -80,6 +91,31 @@ public:
 	void SetFixedTimeStep(const bool enable);
 	void SetFixedTimeStepValue(const float value);
 	float GetTimeStepScale() const;
+
+	/// When enabled along with the fixed time step, frame time is accumulated and consumed in
+	/// whole fixed steps, and physics entities are rendered interpolated between the last two steps
+	void SetFixedTimeStepInterpolation(const bool enable);
+	bool IsFixedTimeStepInterpolationEnabled() const;
+	void SetMaxSubSteps(const unsigned int maxSubSteps);
+	unsigned int GetMaxSubSteps() const;
+	unsigned int GetNumStepsLastFrame() const;
+
+	/// Solves independent groups of bodies (islands) on this many threads. The results do not depend
+	/// on the thread count. The setting is kept for scenes loaded afterwards; 1 solves on the main thread
+	void SetSolverThreadCount(const unsigned int count);
+	unsigned int GetSolverThreadCount() const;
+
+	/// Keeps new fixtures out of the broad-phase tree until EndBulkLoad builds it in one pass. Meant
+	/// for scene loading; queries and ray casts in between do not see the new bodies
+	void BeginBulkLoad();
+	void EndBulkLoad();
+
+	/// Rebuilds the broad-phase tree from scratch, e.g. after removing or moving many bodies
+	void RebuildBroadPhase();
+
+	/// Moves static colliders onto one body per region, merging adjacent boxes into a few fixtures. Meant to run once after a scene is loaded
+	unsigned int MergeStaticColliders(ETHEntityArray& entities, const Vector2& regionSize);
+
 	ETHEntity* GetClosestContact(const Vector2& a, const Vector2& b, Vector2& point, Vector2& normal);
 	ETHEntity* GetClosestContact(const Vector2& a, const Vector2& b, Vector2& point, Vector2& normal, const str_type::string& semicolonSeparatedIgnoreList);
 	bool GetContactEntities(const Vector2& a, const Vector2& b, ETHEntityArray& entities);
@@ -87,6 +123,10 @@ public:
 	b2Joint* CreateJoint(b2JointDef& jointDef);
 	void DisableNextContact();
 	bool IsRunningPreSolveContactCallback() const;
+
+	unsigned int GetNumContactEventsLastStep() const;
+	unsigned int GetNumContactCallbacksLastStep() const;
+	float GetContactCallbackTimeLastStepMS() const;
 };
 
 #endif
@@ -42,7 +42,14 @@ float32 ETHRayCastCallback::ReportFixture(b2Fixture* fixture, const b2Vec2& poin
 	GS2D_UNUSED_ARGUMENT(fraction);
 	const Vector2 v2Point(point.x, point.y);
 	const Vector2 v2Normal(normal.x, normal.y);
-	ETHEntity* entity = static_cast<ETHEntity*>(fixture->GetBody()->GetUserData());
+	const ETHStaticColliderMerger::MergedCollider* merged = static_cast<const ETHStaticColliderMerger::MergedCollider*>(fixture->GetUserData());
+	if (merged && merged->HasMergedBoxes())
+	{
+		ReportMergedFixture(merged);
+		return 1.0f;
+	}
+
+	ETHEntity* entity = ETHStaticColliderMerger::GetFixtureEntity(fixture, point);
 	if (m_chooser->Choose(entity))
 	{
 		m_contacts.insert(std::pair<float, Contact>(SquaredDistance(Vector2(m_a.x, m_a.y), v2Point), Contact(entity, ETHPhysicsSimulator::ScaleFromBox2D(point), v2Normal)));
@@ -50,6 +57,27 @@ float32 ETHRayCastCallback::ReportFixture(b2Fixture* fixture, const b2Vec2& poin
 	return 1.0f;
 }
 
+void ETHRayCastCallback::ReportMergedFixture(const ETHStaticColliderMerger::MergedCollider* merged)
+{
+	// a merged fixture is reported once, but every box the ray crosses is still a contact
+	b2RayCastInput input;
+	input.p1 = m_a;
+	input.p2 = m_b;
+	input.maxFraction = 1.0f;
+	const std::vector<ETHStaticColliderMerger::Member>& members = merged->GetMembers();
+	for (std::size_t t = 0; t < members.size(); t++)
+	{
+		b2RayCastOutput output;
+		if (!members[t].aabb.RayCast(&output, input) || !m_chooser->Choose(members[t].entity))
+			continue;
+
+		const b2Vec2 point(m_a + output.fraction * (m_b - m_a));
+		const Vector2 v2Point(point.x, point.y);
+		m_contacts.insert(std::pair<float, Contact>(SquaredDistance(Vector2(m_a.x, m_a.y), v2Point),
+			Contact(members[t].entity, ETHPhysicsSimulator::ScaleFromBox2D(point), Vector2(output.normal.x, output.normal.y))));
+	}
+}
+
 ETHEntity* ETHRayCastCallback::GetClosestContact(Vector2& point, Vector2& normal)
 {
 	std::multimap<float, Contact>::iterator iter = m_contacts.begin();
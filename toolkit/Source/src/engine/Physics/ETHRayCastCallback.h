@@ -26,6 +26,7 @@
 #include <Box2D/Box2D.h>
 #include "../Entity/ETHEntityArray.h"
 #include "../Entity/ETHEntityChooser.h"
+#include "ETHStaticColliderMerger.h"
 #include <Math/GameMath.h>
 #include <map>
 
@@ -45,6 +46,8 @@ class ETHRayCastCallback : public b2RayCastCallback
 	b2Vec2 m_a, m_b;
 	const ETHEntityChooser* m_chooser;
 
+	void ReportMergedFixture(const ETHStaticColliderMerger::MergedCollider* merged);
+
 public:
 	ETHRayCastCallback(const Vector2& a, const Vector2& b, const ETHEntityChooser* chooser);
 	float32 ReportFixture(b2Fixture* fixture, const b2Vec2& point, const b2Vec2& normal, float32 fraction);
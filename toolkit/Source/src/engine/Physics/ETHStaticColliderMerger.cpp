@@ -0,0 +1,518 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#include "ETHStaticColliderMerger.h"
+#include "ETHPhysicsEntityController.h"
+
+#include <map>
+#include <algorithm>
+
+ETHStaticColliderMerger::MergedCollider::MergedCollider(ETHStaticColliderMerger* merger, const std::vector<Member>& members, const bool mergedBoxes) :
+	m_merger(merger),
+	m_members(members),
+	m_mergedBoxes(mergedBoxes),
+	m_unmergePending(false)
+{
+	for (std::size_t t = 0; t < m_members.size(); t++)
+	{
+		m_members[t].entity->AddRef();
+	}
+}
+
+ETHStaticColliderMerger::MergedCollider::~MergedCollider()
+{
+	ReleaseMembers();
+}
+
+void ETHStaticColliderMerger::MergedCollider::ReleaseMembers()
+{
+	// copied first, since releasing the last reference may get back here through the entity's controller
+	std::vector<Member> members;
+	members.swap(m_members);
+	for (std::size_t t = 0; t < members.size(); t++)
+	{
+		members[t].entity->Release();
+	}
+}
+
+void ETHStaticColliderMerger::MergedCollider::AddFixture(b2Fixture* fixture)
+{
+	m_fixtures.push_back(fixture);
+}
+
+bool ETHStaticColliderMerger::MergedCollider::HasMergedBoxes() const
+{
+	return m_mergedBoxes;
+}
+
+bool ETHStaticColliderMerger::MergedCollider::IsUnmergePending() const
+{
+	return m_unmergePending;
+}
+
+bool ETHStaticColliderMerger::MergedCollider::IsMerged() const
+{
+	return !m_fixtures.empty();
+}
+
+const std::vector<ETHStaticColliderMerger::Member>& ETHStaticColliderMerger::MergedCollider::GetMembers() const
+{
+	return m_members;
+}
+
+static float32 DistanceToAABB(const b2AABB& aabb, const b2Vec2& point)
+{
+	const b2Vec2 closest(b2Clamp(point, aabb.lowerBound, aabb.upperBound));
+	return b2DistanceSquared(closest, point);
+}
+
+ETHEntity* ETHStaticColliderMerger::MergedCollider::GetEntityAt(const b2Vec2& point) const
+{
+	ETHEntity* closestEntity = 0;
+	float32 closestDistance = b2_maxFloat;
+	for (std::size_t t = 0; t < m_members.size(); t++)
+	{
+		const float32 distance = DistanceToAABB(m_members[t].aabb, point);
+		if (distance <= 0.0f)
+			return m_members[t].entity;
+
+		if (distance < closestDistance)
+		{
+			closestDistance = distance;
+			closestEntity = m_members[t].entity;
+		}
+	}
+	return closestEntity;
+}
+
+void ETHStaticColliderMerger::MergedCollider::Unmerge()
+{
+	if (m_fixtures.empty())
+		return;
+
+	b2World* world = m_fixtures[0]->GetBody()->GetWorld();
+
+	// fixtures can't be destroyed while the world is stepping
+	if (world->IsLocked())
+	{
+		if (!m_unmergePending)
+		{
+			m_unmergePending = true;
+			m_merger->SetDirty();
+		}
+		return;
+	}
+	m_unmergePending = false;
+
+	for (std::size_t t = 0; t < m_fixtures.size(); t++)
+	{
+		b2Body* body = m_fixtures[t]->GetBody();
+		body->DestroyFixture(m_fixtures[t]);
+		if (!body->GetFixtureList())
+			world->DestroyBody(body);
+	}
+	m_fixtures.clear();
+
+	// the caller must hold a reference, since the members drop theirs here
+	for (std::size_t t = 0; t < m_members.size(); t++)
+	{
+		ETHPhysicsEntityControllerPtr controller =
+			boost::dynamic_pointer_cast<ETHPhysicsEntityController>(m_members[t].entity->GetController());
+		if (controller)
+			controller->RestoreBody();
+	}
+	ReleaseMembers();
+	m_merger->SetDirty();
+}
+
+ETHStaticColliderMerger::ETHStaticColliderMerger() :
+	m_dirty(false)
+{
+}
+
+ETHStaticColliderMerger::~ETHStaticColliderMerger()
+{
+	UnmergeAll();
+}
+
+void ETHStaticColliderMerger::SetDirty()
+{
+	m_dirty = true;
+}
+
+void ETHStaticColliderMerger::ApplyPendingUnmerges()
+{
+	if (!m_dirty)
+		return;
+
+	// unmerged colliders are dropped here too, so that the list only holds live ones
+	std::vector<MergedColliderPtr> colliders;
+	colliders.swap(m_colliders);
+	for (std::size_t t = 0; t < colliders.size(); t++)
+	{
+		if (colliders[t]->IsUnmergePending())
+			colliders[t]->Unmerge();
+		if (colliders[t]->IsMerged())
+			m_colliders.push_back(colliders[t]);
+	}
+	m_dirty = false;
+}
+
+void ETHStaticColliderMerger::UnmergeAll()
+{
+	std::vector<MergedColliderPtr> colliders;
+	colliders.swap(m_colliders);
+	for (std::size_t t = 0; t < colliders.size(); t++)
+	{
+		colliders[t]->Unmerge();
+		if (colliders[t]->IsMerged())
+			m_colliders.push_back(colliders[t]);
+	}
+	m_dirty = !m_colliders.empty();
+}
+
+ETHEntity* ETHStaticColliderMerger::GetFixtureEntity(const b2Fixture* fixture, const b2Vec2& point)
+{
+	const MergedCollider* merged = static_cast<const MergedCollider*>(fixture->GetUserData());
+	if (merged)
+		return merged->GetEntityAt(point);
+	else
+		return static_cast<ETHEntity*>(fixture->GetBody()->GetUserData());
+}
+
+namespace {
+
+const float32 MERGE_EPSILON = b2_linearSlop * 0.1f;
+
+inline bool IsNear(const float32 a, const float32 b)
+{
+	return (b2Abs(a - b) <= MERGE_EPSILON);
+}
+
+bool IsHorizontalStripLess(const ETHStaticColliderMerger::Rect& a, const ETHStaticColliderMerger::Rect& b)
+{
+	if (!IsNear(a.aabb.lowerBound.y, b.aabb.lowerBound.y)) return a.aabb.lowerBound.y < b.aabb.lowerBound.y;
+	if (!IsNear(a.aabb.upperBound.y, b.aabb.upperBound.y)) return a.aabb.upperBound.y < b.aabb.upperBound.y;
+	return a.aabb.lowerBound.x < b.aabb.lowerBound.x;
+}
+
+bool IsVerticalStripLess(const ETHStaticColliderMerger::Rect& a, const ETHStaticColliderMerger::Rect& b)
+{
+	if (!IsNear(a.aabb.lowerBound.x, b.aabb.lowerBound.x)) return a.aabb.lowerBound.x < b.aabb.lowerBound.x;
+	if (!IsNear(a.aabb.upperBound.x, b.aabb.upperBound.x)) return a.aabb.upperBound.x < b.aabb.upperBound.x;
+	return a.aabb.lowerBound.y < b.aabb.lowerBound.y;
+}
+
+// merges rects that share both bounds along one axis and touch or overlap along the other
+void MergeAlongAxis(std::vector<ETHStaticColliderMerger::Rect>& rects, const bool horizontal)
+{
+	if (rects.size() < 2)
+		return;
+
+	std::sort(rects.begin(), rects.end(), horizontal ? IsHorizontalStripLess : IsVerticalStripLess);
+
+	std::vector<ETHStaticColliderMerger::Rect> merged;
+	merged.reserve(rects.size());
+	merged.push_back(rects[0]);
+	for (std::size_t t = 1; t < rects.size(); t++)
+	{
+		ETHStaticColliderMerger::Rect& last = merged.back();
+		const b2AABB& aabb = rects[t].aabb;
+		const bool sameBounds = horizontal
+			? (IsNear(last.aabb.lowerBound.y, aabb.lowerBound.y) && IsNear(last.aabb.upperBound.y, aabb.upperBound.y))
+			: (IsNear(last.aabb.lowerBound.x, aabb.lowerBound.x) && IsNear(last.aabb.upperBound.x, aabb.upperBound.x));
+		const bool touching = horizontal
+			? (aabb.lowerBound.x <= last.aabb.upperBound.x + MERGE_EPSILON)
+			: (aabb.lowerBound.y <= last.aabb.upperBound.y + MERGE_EPSILON);
+
+		if (sameBounds && touching)
+		{
+			last.aabb.Combine(aabb);
+			last.members.insert(last.members.end(), rects[t].members.begin(), rects[t].members.end());
+		}
+		else
+		{
+			merged.push_back(rects[t]);
+		}
+	}
+	rects.swap(merged);
+}
+
+struct GroupKey
+{
+	int regionX, regionY;
+	float32 friction, restitution;
+	b2Filter filter;
+
+	bool operator<(const GroupKey& other) const
+	{
+		if (regionX != other.regionX) return regionX < other.regionX;
+		if (regionY != other.regionY) return regionY < other.regionY;
+		if (friction != other.friction) return friction < other.friction;
+		if (restitution != other.restitution) return restitution < other.restitution;
+		if (filter.categoryBits != other.filter.categoryBits) return filter.categoryBits < other.filter.categoryBits;
+		if (filter.maskBits != other.filter.maskBits) return filter.maskBits < other.filter.maskBits;
+		return filter.groupIndex < other.filter.groupIndex;
+	}
+};
+
+// accepts static bodies holding a single axis aligned box and nothing attached to them
+bool GetMergeableAABB(ETHEntity* entity, b2Body* body, b2AABB& aabb)
+{
+	if (!entity->IsAlive() || entity->GetShape() != ETHEntityProperties::BS_BOX || entity->IsSensor())
+		return false;
+
+	if (!body || body->GetType() != b2_staticBody || !body->IsActive() || body->GetJointList())
+		return false;
+
+	const b2Fixture* fixture = body->GetFixtureList();
+	if (!fixture || fixture->GetNext() || fixture->IsSensor() || fixture->GetType() != b2Shape::e_polygon)
+		return false;
+
+	const b2PolygonShape* polygon = static_cast<const b2PolygonShape*>(fixture->GetShape());
+	if (polygon->GetVertexCount() != 4)
+		return false;
+
+	const b2Transform& transform = body->GetTransform();
+	b2Vec2 vertices[4];
+	aabb.lowerBound.Set(b2_maxFloat, b2_maxFloat);
+	aabb.upperBound.Set(-b2_maxFloat,-b2_maxFloat);
+	for (int32 t = 0; t < 4; t++)
+	{
+		vertices[t] = b2Mul(transform, polygon->GetVertex(t));
+		aabb.lowerBound = b2Min(aabb.lowerBound, vertices[t]);
+		aabb.upperBound = b2Max(aabb.upperBound, vertices[t]);
+	}
+
+	// every corner must sit on the bounding box corners, otherwise the box is rotated
+	for (int32 t = 0; t < 4; t++)
+	{
+		if (!IsNear(vertices[t].x, aabb.lowerBound.x) && !IsNear(vertices[t].x, aabb.upperBound.x))
+			return false;
+		if (!IsNear(vertices[t].y, aabb.lowerBound.y) && !IsNear(vertices[t].y, aabb.upperBound.y))
+			return false;
+	}
+	return true;
+}
+
+// accepts static polygon colliders that can't be merged as boxes. Their fixtures are moved onto the region body as they are
+bool GetMovableAABB(ETHEntity* entity, b2Body* body, b2AABB& aabb)
+{
+	if (!entity->IsAlive() || entity->IsSensor())
+		return false;
+
+	const ETHEntityProperties::BODY_SHAPE shape = entity->GetShape();
+	if (shape != ETHEntityProperties::BS_BOX && shape != ETHEntityProperties::BS_POLYGON && shape != ETHEntityProperties::BS_COMPOUND)
+		return false;
+
+	if (!body || body->GetType() != b2_staticBody || !body->IsActive() || body->GetJointList() || !body->GetFixtureList())
+		return false;
+
+	aabb.lowerBound.Set(b2_maxFloat, b2_maxFloat);
+	aabb.upperBound.Set(-b2_maxFloat,-b2_maxFloat);
+	for (const b2Fixture* fixture = body->GetFixtureList(); fixture; fixture = fixture->GetNext())
+	{
+		if (fixture->IsSensor())
+			return false;
+
+		const b2Shape::Type type = fixture->GetType();
+		if (type != b2Shape::e_polygon && type != b2Shape::e_circle)
+			return false;
+
+		b2AABB fixtureAABB;
+		fixture->GetShape()->ComputeAABB(&fixtureAABB, body->GetTransform(), 0);
+		aabb.Combine(fixtureAABB);
+	}
+	return true;
+}
+
+// creates a copy of the fixture in world coordinates on the region body, which sits at the origin
+b2Fixture* MoveFixture(const b2Fixture* fixture, b2Body* regionBody)
+{
+	const b2Transform& transform = fixture->GetBody()->GetTransform();
+
+	b2PolygonShape polygon;
+	b2CircleShape circle;
+	b2FixtureDef fixtureDef;
+	if (fixture->GetType() == b2Shape::e_polygon)
+	{
+		const b2PolygonShape* source = static_cast<const b2PolygonShape*>(fixture->GetShape());
+		b2Vec2 vertices[b2_maxPolygonVertices];
+		const int32 numVertices = source->GetVertexCount();
+		for (int32 t = 0; t < numVertices; t++)
+		{
+			vertices[t] = b2Mul(transform, source->GetVertex(t));
+		}
+		polygon.Set(vertices, numVertices);
+		fixtureDef.shape = &polygon;
+	}
+	else
+	{
+		const b2CircleShape* source = static_cast<const b2CircleShape*>(fixture->GetShape());
+		circle.m_radius = source->m_radius;
+		circle.m_p = b2Mul(transform, source->m_p);
+		fixtureDef.shape = &circle;
+	}
+	fixtureDef.density = 0.0f;
+	fixtureDef.friction = fixture->GetFriction();
+	fixtureDef.restitution = fixture->GetRestitution();
+	fixtureDef.filter = fixture->GetFilterData();
+	return regionBody->CreateFixture(&fixtureDef);
+}
+
+} // namespace
+
+void ETHStaticColliderMerger::MergeRects(std::vector<Rect>& rects)
+{
+	MergeAlongAxis(rects, true);
+	MergeAlongAxis(rects, false);
+}
+
+unsigned int ETHStaticColliderMerger::Merge(ETHEntityArray& entities, b2World* world, const b2Vec2& regionSize)
+{
+	typedef std::pair<int, int> Region;
+	typedef std::map<GroupKey, std::vector<Rect> > GroupMap;
+	typedef std::map<Region, std::vector<Member> > RegionMap;
+	GroupMap groups;
+	RegionMap movableMembers;
+
+	for (unsigned int t = 0; t < entities.size(); t++)
+	{
+		ETHEntity* entity = entities[t];
+		ETHPhysicsEntityControllerPtr controller = boost::dynamic_pointer_cast<ETHPhysicsEntityController>(entity->GetController());
+		if (!controller || controller->IsMerged() || controller->GetNumJoints() > 0)
+			continue;
+
+		Member member;
+		member.entity = entity;
+		if (GetMergeableAABB(entity, controller->m_body, member.aabb))
+		{
+			const b2Fixture* fixture = controller->m_body->GetFixtureList();
+			const b2Vec2 center(member.aabb.GetCenter());
+			GroupKey key;
+			key.regionX = static_cast<int>(floorf(center.x / regionSize.x));
+			key.regionY = static_cast<int>(floorf(center.y / regionSize.y));
+			key.friction = fixture->GetFriction();
+			key.restitution = fixture->GetRestitution();
+			key.filter = fixture->GetFilterData();
+
+			Rect rect;
+			rect.aabb = member.aabb;
+			rect.members.push_back(member);
+			groups[key].push_back(rect);
+		}
+		else if (GetMovableAABB(entity, controller->m_body, member.aabb))
+		{
+			const b2Vec2 center(member.aabb.GetCenter());
+			const Region region(static_cast<int>(floorf(center.x / regionSize.x)), static_cast<int>(floorf(center.y / regionSize.y)));
+			movableMembers[region].push_back(member);
+		}
+	}
+
+	unsigned int numFixtures = 0;
+	std::map<Region, b2Body*> regionBodies;
+	for (GroupMap::iterator iter = groups.begin(); iter != groups.end(); ++iter)
+	{
+		const GroupKey& key = iter->first;
+		std::vector<Rect>& rects = iter->second;
+		MergeRects(rects);
+
+		for (std::size_t r = 0; r < rects.size(); r++)
+		{
+			const Rect& rect = rects[r];
+
+			// nothing to gain from a single box
+			if (rect.members.size() < 2)
+				continue;
+
+			b2Body*& body = regionBodies[Region(key.regionX, key.regionY)];
+			if (!body)
+			{
+				b2BodyDef bodyDef;
+				bodyDef.type = b2_staticBody;
+				body = world->CreateBody(&bodyDef);
+			}
+
+			b2PolygonShape shape;
+			shape.SetAsBox(rect.aabb.GetExtents().x, rect.aabb.GetExtents().y, rect.aabb.GetCenter(), 0.0f);
+
+			b2FixtureDef fixtureDef;
+			fixtureDef.shape = &shape;
+			fixtureDef.density = 0.0f;
+			fixtureDef.friction = key.friction;
+			fixtureDef.restitution = key.restitution;
+			fixtureDef.filter = key.filter;
+
+			MergedColliderPtr collider(new MergedCollider(this, rect.members, true));
+			b2Fixture* fixture = body->CreateFixture(&fixtureDef);
+			fixture->SetUserData(collider.get());
+			collider->AddFixture(fixture);
+			AddCollider(collider);
+			numFixtures++;
+		}
+	}
+
+	// each moved entity keeps a collider of its own, so contacts and ray casts still hit its exact shape
+	for (RegionMap::iterator iter = movableMembers.begin(); iter != movableMembers.end(); ++iter)
+	{
+		const std::vector<Member>& members = iter->second;
+		b2Body*& body = regionBodies[iter->first];
+		if (members.size() < 2 && !body)
+			continue;
+
+		if (!body)
+		{
+			b2BodyDef bodyDef;
+			bodyDef.type = b2_staticBody;
+			body = world->CreateBody(&bodyDef);
+		}
+
+		for (std::size_t m = 0; m < members.size(); m++)
+		{
+			const std::vector<Member> single(1, members[m]);
+			MergedColliderPtr collider(new MergedCollider(this, single, false));
+			ETHPhysicsEntityControllerPtr controller =
+				boost::dynamic_pointer_cast<ETHPhysicsEntityController>(members[m].entity->GetController());
+			for (const b2Fixture* source = controller->m_body->GetFixtureList(); source; source = source->GetNext())
+			{
+				b2Fixture* fixture = MoveFixture(source, body);
+				fixture->SetUserData(collider.get());
+				collider->AddFixture(fixture);
+				numFixtures++;
+			}
+			AddCollider(collider);
+		}
+	}
+	return numFixtures;
+}
+
+void ETHStaticColliderMerger::AddCollider(const MergedColliderPtr& collider)
+{
+	m_colliders.push_back(collider);
+	const std::vector<Member>& members = collider->GetMembers();
+	for (std::size_t t = 0; t < members.size(); t++)
+	{
+		ETHPhysicsEntityControllerPtr controller =
+			boost::dynamic_pointer_cast<ETHPhysicsEntityController>(members[t].entity->GetController());
+		controller->SetMergedCollider(collider);
+	}
+}
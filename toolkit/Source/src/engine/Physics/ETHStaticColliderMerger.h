@@ -0,0 +1,114 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#ifndef ETH_STATIC_COLLIDER_MERGER_H_
+#define ETH_STATIC_COLLIDER_MERGER_H_
+
+#include <Box2D/Box2D.h>
+#include <boost/shared_ptr.hpp>
+#include <vector>
+
+class ETHEntity;
+class ETHEntityArray;
+
+/// Replaces the individual bodies of static colliders with fixtures shared by one static body
+/// per region. Adjacent boxes are merged into a few larger boxes, and other polygon colliders
+/// are moved onto the region body as they are. The original bodies are kept inactive so they
+/// can be restored whenever an entity needs its own body again (moved, scaled, deleted or
+/// accessed from scripts)
+class ETHStaticColliderMerger
+{
+public:
+	struct Member
+	{
+		ETHEntity* entity;
+		b2AABB aabb;
+	};
+
+	struct Rect
+	{
+		b2AABB aabb;
+		std::vector<Member> members;
+	};
+
+	/// Merged fixtures and the entities they stand for. Shared by the controllers of all members,
+	/// each member holds a reference to its entity until it gets its body back
+	class MergedCollider
+	{
+		ETHStaticColliderMerger* m_merger;
+		std::vector<b2Fixture*> m_fixtures;
+		std::vector<Member> m_members;
+		bool m_mergedBoxes;
+		bool m_unmergePending;
+
+		void ReleaseMembers();
+
+	public:
+		MergedCollider(ETHStaticColliderMerger* merger, const std::vector<Member>& members, const bool mergedBoxes);
+		~MergedCollider();
+		void AddFixture(b2Fixture* fixture);
+		const std::vector<Member>& GetMembers() const;
+		ETHEntity* GetEntityAt(const b2Vec2& point) const;
+
+		/// True when the fixture is a box made of several member boxes, false when it is a copy of one member's shape
+		bool HasMergedBoxes() const;
+
+		/// Destroys the merged fixtures and gives every member its own body back. While the world is
+		/// stepping, this is postponed until ApplyPendingUnmerges runs after the step
+		void Unmerge();
+		bool IsUnmergePending() const;
+		bool IsMerged() const;
+	};
+
+	typedef boost::shared_ptr<MergedCollider> MergedColliderPtr;
+
+	ETHStaticColliderMerger();
+
+	/// Gives every member its body back
+	~ETHStaticColliderMerger();
+
+	/// Moves the static colliders of the entities onto one static body per region, merging adjacent boxes.
+	/// Returns the number of fixtures created
+	unsigned int Merge(ETHEntityArray& entities, b2World* world, const b2Vec2& regionSize);
+
+	/// Runs the unmerges requested while the world was locked. Must be called after every world step
+	void ApplyPendingUnmerges();
+
+	void UnmergeAll();
+
+	/// Joins touching rectangles of equal height into strips, then strips of equal width into blocks
+	static void MergeRects(std::vector<Rect>& rects);
+
+	/// Returns the entity that owns the fixture. Merged fixtures resolve it from the point
+	static ETHEntity* GetFixtureEntity(const b2Fixture* fixture, const b2Vec2& point);
+
+private:
+	void AddCollider(const MergedColliderPtr& collider);
+
+	// flags that some collider was unmerged or is waiting to be
+	void SetDirty();
+
+	std::vector<MergedColliderPtr> m_colliders;
+	bool m_dirty;
+};
+
+#endif
@@ -36,20 +36,23 @@ ETHAppEnmlFile::ETHAppEnmlFile(
 	const str_type::string& fileName,
 	const Platform::FileManagerPtr& fileManager,
 	const gs2d::str_type::string& platformName) :
+	width(640),
+	height(480),
 	hdDensityValue(2.0f),
 	fullHdDensityValue(4.0f),
 	ldDensityValue(0.5f),
 	xldDensityValue(0.25f),
-	width(640),
-	height(480),
-	windowed(true),
-	vsync(true),
-	title(GS_L("Ethanon Engine")),
-	richLighting(true),
 	minScreenHeightForHdVersion(720),
 	minScreenHeightForFullHdVersion(1080),
 	maxScreenHeightBeforeNdVersion(480),
-	maxScreenHeightBeforeLdVersion(320)
+	maxScreenHeightBeforeLdVersion(320),
+	windowed(true),
+	vsync(true),
+	richLighting(true),
+	jit(false),
+	preloadEntities(false),
+	maxFrameRate(0.0f),
+	title(GS_L("Ethanon Engine"))
 {
 	str_type::string out;
 	fileManager->GetAnsiFileString(fileName, out);
@@ -119,10 +122,15 @@ void ETHAppEnmlFile::LoadProperties(const str_type::string& platformName, const
 	GetBoolean(file, platformName, GS_L("windowed"), windowed);
 	GetBoolean(file, platformName, GS_L("vsync"), vsync);
 	GetBoolean(file, platformName, GS_L("richLighting"), richLighting);
+	GetBoolean(file, platformName, GS_L("jit"), jit);
+	GetBoolean(file, platformName, GS_L("preloadEntities"), preloadEntities);
 
 	GetString(file, platformName, GS_L("fixedWidth"), fixedWidth);
 	GetString(file, platformName, GS_L("fixedHeight"), fixedHeight);
 
+	// zero (the default) leaves the frame rate uncapped
+	file.GetFloat(platformName, GS_L("maxFrameRate"), &maxFrameRate);
+
 	file.GetFloat(platformName, GS_L("hdDensityValue"), &hdDensityValue);
 	file.GetFloat(platformName, GS_L("fullHdDensityValue"), &fullHdDensityValue);
 	
@@ -222,6 +230,21 @@ bool ETHAppEnmlFile::IsRichLightingEnabled() const
 	return richLighting;
 }
 
+bool ETHAppEnmlFile::IsJITEnabled() const
+{
+	return jit;
+}
+
+bool ETHAppEnmlFile::IsEntityPreloadEnabled() const
+{
+	return preloadEntities;
+}
+
+float ETHAppEnmlFile::GetMaxFrameRate() const
+{
+	return maxFrameRate;
+}
+
 str_type::string ETHAppEnmlFile::GetTitle() const
 {
 	return title;
@@ -50,6 +50,9 @@ public:
 	bool IsWindowed() const;
 	bool IsVsyncEnabled() const;
 	bool IsRichLightingEnabled() const;
+	bool IsJITEnabled() const;
+	bool IsEntityPreloadEnabled() const;
+	float GetMaxFrameRate() const;
 	gs2d::str_type::string GetTitle() const;
 	gs2d::str_type::string GetFixedWidth() const;
 	gs2d::str_type::string GetFixedHeight() const;
@@ -73,6 +76,9 @@ private:
 
 	bool windowed, vsync;
 	bool richLighting;
+	bool jit;
+	bool preloadEntities;
+	float maxFrameRate;
 	gs2d::str_type::string title;
 	gs2d::str_type::string fixedWidth, fixedHeight;
 
@@ -33,6 +33,14 @@ ETHEntityPieceRenderer::~ETHEntityPieceRenderer()
 	m_entity->Release();
 }
 
+bool ETHEntityPieceRenderer::GetScreenBounds(const ETHSceneProperties& props, Vector2& outMin, Vector2& outMax) const
+{
+	GS2D_UNUSED_ARGUMENT(props);
+	GS2D_UNUSED_ARGUMENT(outMin);
+	GS2D_UNUSED_ARGUMENT(outMax);
+	return false;
+}
+
 ETHRenderEntity* ETHEntityPieceRenderer::GetEntity()
 {
 	return m_entity;
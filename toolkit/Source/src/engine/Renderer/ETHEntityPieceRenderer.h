@@ -36,6 +36,10 @@ public:
 	ETHEntityPieceRenderer(ETHRenderEntity* entity);
 	~ETHEntityPieceRenderer();
 	virtual void Render(const ETHSceneProperties& props, const float maxHeight, const float minHeight) = 0;
+
+	/// Fills the screen-space rect the piece may draw to. Returns false if it can't be known
+	virtual bool GetScreenBounds(const ETHSceneProperties& props, Vector2& outMin, Vector2& outMax) const;
+
 	ETHRenderEntity* GetEntity();
 };
 
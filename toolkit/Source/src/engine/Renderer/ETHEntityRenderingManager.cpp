@@ -27,19 +27,56 @@
 #include "../Renderer/ETHEntityHaloRenderer.h"
 
 ETHEntityRenderingManager::ETHEntityRenderingManager(ETHResourceProviderPtr provider) :
-	m_provider(provider)
+	m_provider(provider),
+	m_shadowBatch(provider),
+	m_staticRunMapped(false)
 {
 }
 
 void ETHEntityRenderingManager::RenderPieces(const ETHSceneProperties& props, const float minHeight, const float maxHeight)
 {
-	// Draw visible entities ordered in an alpha-friendly map
-	for (std::multimap<float, ETHEntityPieceRendererPtr>::iterator iter = m_piecesToRender.begin(); iter != m_piecesToRender.end(); ++iter)
+	static const ETHStaticRenderCache::PIECE_RUN emptyRun;
+	const ETHStaticRenderCache::PIECE_RUN& staticRun = (m_staticRunMapped) ? m_staticCache.GetRun() : emptyRun;
+
+	// Draw visible entities ordered in an alpha-friendly map, merging the
+	// cached static run (already sorted) with the pieces mapped this frame
+	std::multimap<float, ETHEntityPieceRendererPtr>::iterator iter = m_piecesToRender.begin();
+	std::size_t s = 0;
+	while (iter != m_piecesToRender.end() || s < staticRun.size())
 	{
-		iter->second->Render(props, maxHeight, minHeight);
+		if (s < staticRun.size() && (iter == m_piecesToRender.end() || staticRun[s].hash <= iter->first))
+		{
+			const ETHStaticRenderCache::PIECE& piece = staticRun[s++];
+			if (piece.visible || !piece.cullable)
+			{
+				FlushShadowsCoveredBy(piece.renderer, props);
+				piece.renderer->Render(props, maxHeight, minHeight);
+			}
+		}
+		else
+		{
+			FlushShadowsCoveredBy(iter->second.get(), props);
+			iter->second->Render(props, maxHeight, minHeight);
+			++iter;
+		}
 	}
+	m_shadowBatch.Flush();
 	ReleaseMappedPieces();
 	m_lights.clear();
+	m_staticRunMapped = false;
+}
+
+void ETHEntityRenderingManager::FlushShadowsCoveredBy(const ETHEntityPieceRenderer* piece, const ETHSceneProperties& props)
+{
+	if (m_shadowBatch.GetNumShadows() == 0)
+		return;
+
+	// pieces that might draw over the pending shadows must find them already drawn
+	Vector2 min, max;
+	if (!piece->GetScreenBounds(props, min, max) || m_shadowBatch.Overlaps(min, max))
+	{
+		m_shadowBatch.Flush();
+	}
 }
 
 void ETHEntityRenderingManager::AddDecomposedPieces(
@@ -64,7 +101,8 @@ void ETHEntityRenderingManager::AddDecomposedPieces(
 				video,
 				m_provider->AreLightmapsEnabled(),
 				m_provider->AreRealTimeShadowsEnabled(),
-				&m_lights));
+				&m_lights,
+				&m_shadowBatch));
 
 		// add this entity to the multimap to sort it for an alpha-friendly rendering list
 		const float depth = entity->ComputeDepth(maxHeight, minHeight);
@@ -85,6 +123,18 @@ void ETHEntityRenderingManager::AddDecomposedPieces(
 		m_piecesToRender.insert(std::pair<float, ETHEntityPieceRendererPtr>(drawHash, haloPiece));
 	}
 
+	AddParticlePieces(entity, minHeight, maxHeight);
+	AddEntityLight(entity, props);
+}
+
+void ETHEntityRenderingManager::AddParticlePieces(
+	ETHRenderEntity* entity,
+	const float minHeight,
+	const float maxHeight)
+{
+	const VideoPtr& video = m_provider->GetVideo();
+	const ETHShaderManagerPtr& shaderManager = m_provider->GetShaderManager();
+
 	// decompose the particle list for this entity
 	if (entity->HasParticleSystems())
 	{
@@ -106,7 +156,10 @@ void ETHEntityRenderingManager::AddDecomposedPieces(
 			m_piecesToRender.insert(std::pair<float, ETHEntityPieceRendererPtr>(drawHash, particlePiece));
 		}
 	}
+}
 
+void ETHEntityRenderingManager::AddEntityLight(ETHRenderEntity* entity, const ETHSceneProperties& props)
+{
 	// fill the light list for this frame
 	if (entity->HasLightSource() && m_provider->IsRichLightingEnabled())
 	{
@@ -143,6 +196,38 @@ float ETHEntityRenderingManager::ComputeDrawHash(VideoPtr video, const float ent
 	return drawHash;
 }
 
+void ETHEntityRenderingManager::BeginStaticMapping(
+	const ETHSpan<Vector2>& visibleBuckets,
+	const ETHBackBufferTargetManagerPtr& backBuffer,
+	const ETHSceneProperties& props)
+{
+	m_staticCache.BeginFrame(visibleBuckets, m_provider->GetVideo(), backBuffer, m_provider, props);
+}
+
+const ETHStaticRenderCache::BUCKET& ETHEntityRenderingManager::ValidateStaticBucket(
+	const Vector2& bucket,
+	const ETHEntityList& entities,
+	const unsigned int revision)
+{
+	return m_staticCache.ValidateBucket(bucket, entities, revision);
+}
+
+void ETHEntityRenderingManager::EndStaticMapping(
+	const ETHBackBufferTargetManagerPtr& backBuffer,
+	const ETHSceneProperties& props,
+	const float minHeight,
+	const float maxHeight)
+{
+	m_staticCache.EndFrame(*this, m_provider->GetVideo(), backBuffer, m_provider, &m_lights, &m_shadowBatch, props, minHeight, maxHeight);
+	m_staticRunMapped = true;
+}
+
+void ETHEntityRenderingManager::ClearStaticCache()
+{
+	m_staticCache.Clear();
+	m_staticRunMapped = false;
+}
+
 bool ETHEntityRenderingManager::IsEmpty() const
 {
 	return m_piecesToRender.empty();
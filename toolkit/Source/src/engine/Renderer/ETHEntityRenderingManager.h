@@ -24,6 +24,8 @@
 #define ETH_ENTITY_RENDERING_MANAGER_H_
 
 #include "ETHEntityPieceRenderer.h"
+#include "ETHStaticRenderCache.h"
+#include "ETHProjShadowBatch.h"
 
 #include "../Resource/ETHResourceProvider.h"
 
@@ -34,6 +36,11 @@ class ETHEntityRenderingManager
 	std::multimap<float, ETHEntityPieceRendererPtr> m_piecesToRender;
 	ETHResourceProviderPtr m_provider;
 	std::list<ETHLight> m_lights;
+	ETHStaticRenderCache m_staticCache;
+	ETHProjShadowBatch m_shadowBatch;
+	bool m_staticRunMapped;
+
+	void FlushShadowsCoveredBy(const ETHEntityPieceRenderer* piece, const ETHSceneProperties& props);
 
 public:
 
@@ -59,6 +66,33 @@ public:
 		const float maxHeight,
 		const ETHBackBufferTargetManagerPtr& backBuffer,
 		const ETHSceneProperties& props);
+
+	void AddParticlePieces(
+		ETHRenderEntity* entity,
+		const float minHeight,
+		const float maxHeight);
+
+	void AddEntityLight(ETHRenderEntity* entity, const ETHSceneProperties& props);
+
+	/// Static entities are mapped through a per-bucket cache. Validate every visible bucket
+	/// between these calls; the cached pieces are merged with the mapped ones in RenderPieces
+	void BeginStaticMapping(
+		const ETHSpan<Vector2>& visibleBuckets,
+		const ETHBackBufferTargetManagerPtr& backBuffer,
+		const ETHSceneProperties& props);
+
+	const ETHStaticRenderCache::BUCKET& ValidateStaticBucket(
+		const Vector2& bucket,
+		const ETHEntityList& entities,
+		const unsigned int revision);
+
+	void EndStaticMapping(
+		const ETHBackBufferTargetManagerPtr& backBuffer,
+		const ETHSceneProperties& props,
+		const float minHeight,
+		const float maxHeight);
+
+	void ClearStaticCache();
 };
 
 #endif
@@ -28,13 +28,15 @@ ETHEntitySpriteRenderer::ETHEntitySpriteRenderer(
 	const VideoPtr& video,
 	const bool lightmapEnabled,
 	const bool realTimeShadowsEnabled,
-	std::list<ETHLight>* lights) :
+	std::list<ETHLight>* lights,
+	ETHProjShadowBatch* shadowBatch) :
 	ETHEntityPieceRenderer(entity),
 	m_shaderManager(shaderManager),
 	m_video(video),
 	m_lightmapEnabled(lightmapEnabled),
 	m_realTimeShadowsEnabled(realTimeShadowsEnabled),
-	m_lights(lights)
+	m_lights(lights),
+	m_shadowBatch(shadowBatch)
 {
 }
 
@@ -44,6 +46,30 @@ void ETHEntitySpriteRenderer::Render(const ETHSceneProperties& props, const floa
 	RenderLightPass(props, maxHeight, minHeight);
 }
 
+bool ETHEntitySpriteRenderer::GetScreenBounds(const ETHSceneProperties& props, Vector2& outMin, Vector2& outMax) const
+{
+	// the parallax of vertical entities drawn with four triangles bends the sprite out of its rect
+	if (!m_entity->GetSprite() || m_entity->ShouldUseFourTriangles(m_shaderManager->GetParallaxIntensity()))
+		return false;
+
+	// one extra pixel on each side covers position rounding
+	const Vector2 margin(1.0f, 1.0f);
+	if (m_entity->GetType() == ETHEntityProperties::ET_VERTICAL || m_entity->GetAngle() == 0.0f)
+	{
+		const ETHEntityProperties::VIEW_RECT rect = m_entity->GetScreenRect(props);
+		outMin = rect.min - margin;
+		outMax = rect.max + margin;
+	}
+	else
+	{
+		const Vector2 center = m_entity->ComputeInScreenSpriteCenter(props);
+		const float halfDiagonal = m_entity->GetCurrentSize().Length() * 0.5f;
+		outMin = center - Vector2(halfDiagonal, halfDiagonal) - margin;
+		outMax = center + Vector2(halfDiagonal, halfDiagonal) + margin;
+	}
+	return true;
+}
+
 void ETHEntitySpriteRenderer::RenderAmbientPass(const ETHSceneProperties& props, const float maxHeight, const float minHeight)
 {
 	m_shaderManager->BeginAmbientPass(m_entity, maxHeight, minHeight);
@@ -62,8 +88,20 @@ void ETHEntitySpriteRenderer::RenderLightPass(const ETHSceneProperties& props, c
 {
 	if (m_shaderManager->IsRichLightingEnabled())
 	{
+		const bool batchShadows = (m_realTimeShadowsEnabled && m_shadowBatch && m_shadowBatch->IsEnabled());
 		for (std::list<ETHLight>::iterator iter = m_lights->begin(); iter != m_lights->end(); ++iter)
 		{
+			// the shadows this entity cast from the previous lights must cover the earlier
+			// light passes only, as they did when each shadow was drawn right away
+			if (batchShadows && m_shadowBatch->GetNumShadows() > 0)
+			{
+				Vector2 min, max;
+				if (!GetScreenBounds(props, min, max) || m_shadowBatch->Overlaps(min, max))
+				{
+					m_shadowBatch->Flush();
+				}
+			}
+
 			iter->SetLightScissor(m_video, props.zAxisDirection);
 			if (!m_entity->IsHidden())
 			{
@@ -77,7 +115,16 @@ void ETHEntitySpriteRenderer::RenderLightPass(const ETHSceneProperties& props, c
 					}
 
 					// shadow pass
-					if (m_realTimeShadowsEnabled)
+					if (batchShadows)
+					{
+						// projected and drawn along with the other pending shadows once something else
+						// has to be drawn over them, or at the end of the frame
+						if (m_entity->GetProperties()->castShadow && iter->castShadows && m_entity->IsCastShadow())
+						{
+							m_shadowBatch->Add(m_entity, &(*iter), props, maxHeight, minHeight);
+						}
+					}
+					else if (m_realTimeShadowsEnabled)
 					{
 						const bool roundUp = m_video->IsRoundingUpPosition();
 						if (m_entity->GetProperties()->castShadow)
@@ -25,6 +25,8 @@
 
 #include "ETHEntityPieceRenderer.h"
 
+#include "ETHProjShadowBatch.h"
+
 #include "../Shader/ETHShaderManager.h"
 
 class ETHEntitySpriteRenderer : public ETHEntityPieceRenderer
@@ -34,6 +36,7 @@ class ETHEntitySpriteRenderer : public ETHEntityPieceRenderer
 	bool m_lightmapEnabled;
 	bool m_realTimeShadowsEnabled;
 	std::list<ETHLight>* m_lights;
+	ETHProjShadowBatch* m_shadowBatch;
 
 	void RenderAmbientPass(const ETHSceneProperties& props, const float maxHeight, const float minHeight);
 	void RenderLightPass(const ETHSceneProperties& props, const float maxHeight, const float minHeight);
@@ -45,9 +48,11 @@ public:
 		const VideoPtr& video,
 		const bool lightmapEnabled,
 		const bool realTimeShadowsEnabled,
-		std::list<ETHLight>* lights);
+		std::list<ETHLight>* lights,
+		ETHProjShadowBatch* shadowBatch);
 
 	void Render(const ETHSceneProperties& props, const float maxHeight, const float minHeight);
+	bool GetScreenBounds(const ETHSceneProperties& props, Vector2& outMin, Vector2& outMax) const;
 };
 
 #endif
@@ -0,0 +1,280 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#include "ETHProjShadowBatch.h"
+
+#include "../Shader/ETHShaderManager.h"
+
+#include <math.h>
+
+// vertex positions and texture coordinates of Sprite::RM_THREE_TRIANGLES, drawn as a strip
+static const float SHADOW_VERTEX_X[ETHProjShadowBatch::SHADOW_VERTEX_COUNT] = { 0.0f, 0.0f, 0.5f, 1.0f, 1.0f };
+static const float SHADOW_VERTEX_Y[ETHProjShadowBatch::SHADOW_VERTEX_COUNT] = { 0.0f, 1.0f, 0.0f, 1.0f, 0.0f };
+
+// the same strip as a triangle list
+static const unsigned int SHADOW_TRIANGLE_LIST[] = { 0, 1, 2, 2, 1, 3, 2, 3, 4 };
+static const unsigned int SHADOW_TRIANGLE_LIST_SIZE = sizeof(SHADOW_TRIANGLE_LIST) / sizeof(SHADOW_TRIANGLE_LIST[0]);
+
+ETHProjShadowBatch::ETHProjShadowBatch(const ETHResourceProviderPtr& provider) :
+	m_provider(provider),
+	m_probed(false),
+	m_enabled(false)
+{
+}
+
+bool ETHProjShadowBatch::IsEnabled()
+{
+	if (!m_probed)
+	{
+		// an empty list tells whether the backend supports triangle lists at all
+		const SpritePtr& shadowSprite = m_provider->GetShaderManager()->GetProjShadow();
+		m_enabled = (shadowSprite && shadowSprite->DrawTriangles(0, 0));
+		m_probed = true;
+	}
+	return m_enabled;
+}
+
+void ETHProjShadowBatch::Add(
+	ETHRenderEntity* entity,
+	const ETHLight* light,
+	const ETHSceneProperties& props,
+	const float maxHeight,
+	const float minHeight)
+{
+	if (!entity->GetSprite() || entity->IsHidden())
+		return;
+
+	ETHRenderEntity::PROJ_SHADOW shadow;
+	if (!entity->ComputeProjShadow(maxHeight, minHeight, props, *light, 0, false, false, 0.0f, Vector3(0,0,0), shadow))
+		return;
+
+	// shadows come light by light for each entity, so the light is usually the last one seen
+	unsigned int lightIndex = static_cast<unsigned int>(m_lights.size());
+	for (std::size_t t = m_lights.size(); t > 0; t--)
+	{
+		if (m_lights[t - 1] == light)
+		{
+			lightIndex = static_cast<unsigned int>(t - 1);
+			break;
+		}
+	}
+	if (lightIndex == m_lights.size())
+	{
+		m_lights.push_back(light);
+	}
+
+	m_lightIndices.push_back(lightIndex);
+	m_posX.push_back(shadow.pos.x);
+	m_posY.push_back(shadow.pos.y);
+	m_width.push_back(shadow.width);
+	m_length.push_back(shadow.length);
+	m_entityZ.push_back(shadow.entityZ);
+	m_shadowZ.push_back(shadow.shadowZ);
+	m_lightX.push_back(shadow.lightPos.x);
+	m_lightY.push_back(shadow.lightPos.y);
+	m_cos.push_back(cosf(shadow.angle));
+	m_sin.push_back(sinf(shadow.angle));
+	m_depth.push_back(shadow.depth);
+	m_colors.push_back(shadow.color);
+
+	// no projected vertex gets farther from the caster than its width plus the extrusion and
+	// the push back applied by ProjectShadows, plus a pixel for the quad height
+	const float radius = shadow.width + shadow.length + fabsf((shadow.length / 6.0f) - shadow.entityZ) + 1.0f;
+	const Vector2 center(shadow.pos - m_provider->GetVideo()->GetCameraPos() - Vector2(0.0f, shadow.shadowZ));
+	const Vector2 min(center - Vector2(radius, radius)), max(center + Vector2(radius, radius));
+	m_boundsMin.push_back(min);
+	m_boundsMax.push_back(max);
+	if (m_boundsMin.size() == 1)
+	{
+		m_totalMin = min;
+		m_totalMax = max;
+	}
+	else
+	{
+		m_totalMin = Vector2(Min(m_totalMin.x, min.x), Min(m_totalMin.y, min.y));
+		m_totalMax = Vector2(Max(m_totalMax.x, max.x), Max(m_totalMax.y, max.y));
+	}
+}
+
+bool ETHProjShadowBatch::Overlaps(const Vector2& min, const Vector2& max) const
+{
+	if (m_boundsMin.empty() || min.x > m_totalMax.x || min.y > m_totalMax.y || max.x < m_totalMin.x || max.y < m_totalMin.y)
+	{
+		return false;
+	}
+
+	for (std::size_t t = 0; t < m_boundsMin.size(); t++)
+	{
+		if (min.x <= m_boundsMax[t].x && min.y <= m_boundsMax[t].y && max.x >= m_boundsMin[t].x && max.y >= m_boundsMin[t].y)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void ETHProjShadowBatch::ProjectShadows(
+	const std::size_t numShadows,
+	const float* posX,
+	const float* posY,
+	const float* width,
+	const float* length,
+	const float* entityZ,
+	const float* shadowZ,
+	const float* lightX,
+	const float* lightY,
+	const float* cosAngle,
+	const float* sinAngle,
+	const Vector2& cameraPos,
+	float* ETH_RESTRICT outX,
+	float* ETH_RESTRICT outY)
+{
+	const Vector2 origin = ETH_PROJ_SHADOW_ORIGIN;
+	const float cameraX = cameraPos.x, cameraY = cameraPos.y;
+
+	// one pass per quad vertex keeps the loads and stores contiguous, so the inner loop vectorizes
+	for (unsigned int v = 0; v < SHADOW_VERTEX_COUNT; v++)
+	{
+		// the quad is one pixel high; its upper vertices are extruded away from the light
+		const float vertexX = SHADOW_VERTEX_X[v] - origin.x;
+		const float vertexY = SHADOW_VERTEX_Y[v] - origin.y;
+		const float extrude = 1.0f - SHADOW_VERTEX_Y[v];
+		float* ETH_RESTRICT vertexOutX = outX + v * numShadows;
+		float* ETH_RESTRICT vertexOutY = outY + v * numShadows;
+		for (std::size_t t = 0; t < numShadows; t++)
+		{
+			// push back the shadow a little bit so it won't look odd
+			const float lightVecX = posX[t] - lightX[t];
+			const float lightVecY = posY[t] - lightY[t];
+			const float pushBack = ((length[t] / 6.0f) - entityZ[t]) / sqrtf(lightVecX * lightVecX + lightVecY * lightVecY);
+
+			const float x = vertexX * width[t];
+			const float rotX = cosAngle[t] * x + sinAngle[t] * vertexY + posX[t];
+			const float rotY =-sinAngle[t] * x + cosAngle[t] * vertexY + posY[t];
+			const float dirX = rotX - lightX[t];
+			const float dirY = rotY - lightY[t];
+			const float stretch = (extrude * length[t]) / sqrtf(dirX * dirX + dirY * dirY);
+			vertexOutX[t] = rotX + dirX * stretch - lightVecX * pushBack - cameraX;
+			vertexOutY[t] = rotY + dirY * stretch - lightVecY * pushBack - cameraY - shadowZ[t];
+		}
+	}
+}
+
+void ETHProjShadowBatch::Flush()
+{
+	const std::size_t numShadows = m_lightIndices.size();
+	if (numShadows == 0)
+	{
+		Clear();
+		return;
+	}
+
+	const VideoPtr& video = m_provider->GetVideo();
+	const SpritePtr& shadowSprite = m_provider->GetShaderManager()->GetProjShadow();
+
+	m_outX.resize(numShadows * SHADOW_VERTEX_COUNT);
+	m_outY.resize(numShadows * SHADOW_VERTEX_COUNT);
+	ProjectShadows(
+		numShadows,
+		&m_posX[0], &m_posY[0],
+		&m_width[0], &m_length[0],
+		&m_entityZ[0], &m_shadowZ[0],
+		&m_lightX[0], &m_lightY[0],
+		&m_cos[0], &m_sin[0],
+		video->GetCameraPos(),
+		&m_outX[0], &m_outY[0]);
+
+	// group the shadows by light, keeping the order they were added in
+	const std::size_t numLights = m_lights.size();
+	m_lightStart.assign(numLights + 1, 0);
+	for (std::size_t t = 0; t < numShadows; t++)
+	{
+		++m_lightStart[m_lightIndices[t] + 1];
+	}
+	for (std::size_t l = 0; l < numLights; l++)
+	{
+		m_lightStart[l + 1] += m_lightStart[l];
+	}
+	m_lightCursor.assign(m_lightStart.begin(), m_lightStart.end() - 1);
+	m_order.resize(numShadows);
+	for (std::size_t t = 0; t < numShadows; t++)
+	{
+		m_order[m_lightCursor[m_lightIndices[t]]++] = static_cast<unsigned int>(t);
+	}
+
+	const Video::ALPHA_MODE alphaMode = video->GetAlphaMode();
+	const ShaderPtr pixelShader = video->GetPixelShader();
+	video->SetAlphaMode(Video::AM_PIXEL);
+	video->SetPixelShader(ShaderPtr());
+
+	for (std::size_t l = 0; l < numLights; l++)
+	{
+		const unsigned int first = m_lightStart[l], last = m_lightStart[l + 1];
+		if (first == last)
+			continue;
+
+		m_vertices.resize((last - first) * SHADOW_TRIANGLE_LIST_SIZE);
+		Sprite::SCREEN_VERTEX* vertex = &m_vertices[0];
+		for (unsigned int s = first; s < last; s++)
+		{
+			const unsigned int t = m_order[s];
+			const float z = 1.0f - m_depth[t];
+			for (unsigned int i = 0; i < SHADOW_TRIANGLE_LIST_SIZE; i++, vertex++)
+			{
+				const unsigned int v = SHADOW_TRIANGLE_LIST[i];
+				vertex->pos = Vector3(m_outX[v * numShadows + t], m_outY[v * numShadows + t], z);
+				vertex->texCoord = Vector2(SHADOW_VERTEX_X[v], SHADOW_VERTEX_Y[v]);
+				vertex->color = m_colors[t];
+			}
+		}
+		shadowSprite->DrawTriangles(&m_vertices[0], static_cast<unsigned int>(m_vertices.size()));
+	}
+
+	video->SetPixelShader(pixelShader);
+	video->SetAlphaMode(alphaMode);
+	Clear();
+}
+
+unsigned int ETHProjShadowBatch::GetNumShadows() const
+{
+	return static_cast<unsigned int>(m_lightIndices.size());
+}
+
+void ETHProjShadowBatch::Clear()
+{
+	m_lights.clear();
+	m_lightIndices.clear();
+	m_posX.clear();
+	m_posY.clear();
+	m_width.clear();
+	m_length.clear();
+	m_entityZ.clear();
+	m_shadowZ.clear();
+	m_lightX.clear();
+	m_lightY.clear();
+	m_cos.clear();
+	m_sin.clear();
+	m_depth.clear();
+	m_colors.clear();
+	m_boundsMin.clear();
+	m_boundsMax.clear();
+}
@@ -0,0 +1,113 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#ifndef ETH_PROJ_SHADOW_BATCH_H_
+#define ETH_PROJ_SHADOW_BATCH_H_
+
+#include "../Entity/ETHRenderEntity.h"
+
+#include "../Resource/ETHResourceProvider.h"
+
+#include <vector>
+
+/// Gathers the projected shadows of caster and light pairs and draws them with one triangle
+/// list per light, instead of one shaded quad per shadow. The shadow vertex shader's
+/// projection runs on the CPU, over all pending shadows in a single loop. The renderer
+/// must flush the batch before drawing anything that Overlaps() the pending shadows, so
+/// the frame looks as if each shadow had been drawn right after its caster's light pass.
+/// Falls back to per-shadow drawing when the video backend can't draw triangle lists
+class ETHProjShadowBatch
+{
+public:
+	ETHProjShadowBatch(const ETHResourceProviderPtr& provider);
+
+	/// Returns false if shadows must be drawn one by one
+	bool IsEnabled();
+
+	void Add(
+		ETHRenderEntity* entity,
+		const ETHLight* light,
+		const ETHSceneProperties& props,
+		const float maxHeight,
+		const float minHeight);
+
+	/// Draws and clears the batch. Call it before the light list is cleared
+	void Flush();
+
+	/// Returns true if any pending shadow may cover the screen-space rect
+	bool Overlaps(const Vector2& min, const Vector2& max) const;
+
+	unsigned int GetNumShadows() const;
+
+	/// Projects the shadow quads exactly as the shadow vertex shader does, in render target
+	/// pixels. The output arrays hold SHADOW_VERTEX_COUNT rows of numShadows values each,
+	/// one row per quad vertex
+	static void ProjectShadows(
+		const std::size_t numShadows,
+		const float* posX,
+		const float* posY,
+		const float* width,
+		const float* length,
+		const float* entityZ,
+		const float* shadowZ,
+		const float* lightX,
+		const float* lightY,
+		const float* cosAngle,
+		const float* sinAngle,
+		const Vector2& cameraPos,
+		float* ETH_RESTRICT outX,
+		float* ETH_RESTRICT outY);
+
+	static const unsigned int SHADOW_VERTEX_COUNT = 5;
+
+private:
+	void Clear();
+
+	ETHResourceProviderPtr m_provider;
+	bool m_probed;
+	bool m_enabled;
+
+	std::vector<const ETHLight*> m_lights;
+
+	// one entry per shadow
+	std::vector<unsigned int> m_lightIndices;
+	std::vector<float> m_posX, m_posY;
+	std::vector<float> m_width, m_length;
+	std::vector<float> m_entityZ, m_shadowZ;
+	std::vector<float> m_lightX, m_lightY;
+	std::vector<float> m_cos, m_sin;
+	std::vector<float> m_depth;
+	std::vector<Color> m_colors;
+
+	// conservative screen-space bounds of each pending shadow, and of all of them
+	std::vector<Vector2> m_boundsMin, m_boundsMax;
+	Vector2 m_totalMin, m_totalMax;
+
+	// scratch buffers
+	std::vector<float> m_outX, m_outY;
+	std::vector<unsigned int> m_order;
+	std::vector<unsigned int> m_lightStart;
+	std::vector<unsigned int> m_lightCursor;
+	std::vector<Sprite::SCREEN_VERTEX> m_vertices;
+};
+
+#endif
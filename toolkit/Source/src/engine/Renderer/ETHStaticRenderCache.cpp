@@ -0,0 +1,414 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#include "ETHStaticRenderCache.h"
+
+#include "ETHEntityRenderingManager.h"
+#include "ETHEntitySpriteRenderer.h"
+#include "ETHEntityHaloRenderer.h"
+
+#include <algorithm>
+
+ETHStaticRenderCache::RENDER_KEY::RENDER_KEY() :
+	angle(0.0f),
+	layerDepth(0.0f),
+	type(ETHEntityProperties::ET_HORIZONTAL),
+	hidden(false),
+	isStatic(false),
+	hasLight(false),
+	hasHalo(false),
+	hasParticles(false),
+	hasCallback(false)
+{
+}
+
+ETHStaticRenderCache::RENDER_KEY::RENDER_KEY(ETHRenderEntity* entity) :
+	pos(entity->GetPosition()),
+	size(entity->GetCurrentSize()),
+	angle(entity->GetAngle()),
+	layerDepth(entity->GetLayerDepth()),
+	type(entity->GetType()),
+	hidden(entity->IsHidden()),
+	isStatic(entity->IsStatic()),
+	hasLight(entity->HasLightSource()),
+	hasHalo(entity->HasHalo()),
+	hasParticles(entity->HasParticleSystems()),
+	hasCallback(entity->HasAnyCallbackFunction())
+{
+}
+
+bool ETHStaticRenderCache::RENDER_KEY::operator == (const RENDER_KEY& other) const
+{
+	return (pos == other.pos
+		&& size == other.size
+		&& angle == other.angle
+		&& layerDepth == other.layerDepth
+		&& type == other.type
+		&& hidden == other.hidden
+		&& isStatic == other.isStatic
+		&& hasLight == other.hasLight
+		&& hasHalo == other.hasHalo
+		&& hasParticles == other.hasParticles
+		&& hasCallback == other.hasCallback);
+}
+
+ETHStaticRenderCache::BUCKET::BUCKET() :
+	revision(0),
+	built(false),
+	piecesReady(false),
+	minHeight(0.0f),
+	maxHeight(0.0f),
+	numVisibleStatics(0)
+{
+}
+
+ETHStaticRenderCache::SETTINGS::SETTINGS() :
+	lightmapsEnabled(false),
+	realTimeShadowsEnabled(false),
+	parallaxIntensity(0.0f)
+{
+}
+
+bool ETHStaticRenderCache::SETTINGS::operator == (const SETTINGS& other) const
+{
+	return (lightmapsEnabled == other.lightmapsEnabled
+		&& realTimeShadowsEnabled == other.realTimeShadowsEnabled
+		&& screenSize == other.screenSize
+		&& bufferSize == other.bufferSize
+		&& zAxisDirection == other.zAxisDirection
+		&& parallaxIntensity == other.parallaxIntensity);
+}
+
+ETHStaticRenderCache::ETHStaticRenderCache() :
+	m_minHeight(0.0f),
+	m_maxHeight(0.0f),
+	m_runDirty(true),
+	m_numRebuiltBuckets(0)
+{
+}
+
+void ETHStaticRenderCache::BeginFrame(
+	const ETHSpan<Vector2>& visibleBuckets,
+	const VideoPtr& video,
+	const ETHBackBufferTargetManagerPtr& backBuffer,
+	const ETHResourceProviderPtr& provider,
+	const ETHSceneProperties& props)
+{
+	m_numRebuiltBuckets = 0;
+
+	// sprite pieces capture these when they are created, so any change invalidates everything
+	SETTINGS settings;
+	settings.lightmapsEnabled = provider->AreLightmapsEnabled();
+	settings.realTimeShadowsEnabled = provider->AreRealTimeShadowsEnabled();
+	settings.screenSize = video->GetScreenSizeF();
+	settings.bufferSize = backBuffer->GetBufferSize();
+	settings.zAxisDirection = props.zAxisDirection;
+	settings.parallaxIntensity = provider->GetShaderManager()->GetParallaxIntensity();
+	if (!(settings == m_settings))
+	{
+		Clear();
+		m_settings = settings;
+	}
+
+	if (visibleBuckets.size() == m_visibleBuckets.size()
+		&& std::equal(visibleBuckets.begin(), visibleBuckets.end(), m_visibleBuckets.begin()))
+	{
+		return;
+	}
+
+	m_visibleBuckets.assign(visibleBuckets.begin(), visibleBuckets.end());
+	m_runDirty = true;
+
+	// buckets that left the screen release their pieces, and with them the entity references
+	for (BucketCacheMap::iterator iter = m_buckets.begin(); iter != m_buckets.end();)
+	{
+		if (std::find(m_visibleBuckets.begin(), m_visibleBuckets.end(), iter->first) == m_visibleBuckets.end())
+		{
+			iter = m_buckets.erase(iter);
+		}
+		else
+		{
+			++iter;
+		}
+	}
+}
+
+const ETHStaticRenderCache::BUCKET& ETHStaticRenderCache::ValidateBucket(
+	const Vector2& bucketPos,
+	const ETHEntityList& entities,
+	const unsigned int revision)
+{
+	BUCKET& bucket = m_buckets[bucketPos];
+
+	bool valid = (bucket.built && bucket.revision == revision);
+	for (std::size_t t = 0; valid && t < bucket.statics.size(); t++)
+	{
+		const STATIC_ENTITY& staticEntity = bucket.statics[t];
+		valid = (RENDER_KEY(staticEntity.entity) == staticEntity.key);
+	}
+
+	if (!valid)
+	{
+		BuildBucket(bucket, entities, revision);
+		m_runDirty = true;
+		++m_numRebuiltBuckets;
+	}
+	return bucket;
+}
+
+void ETHStaticRenderCache::BuildBucket(BUCKET& bucket, const ETHEntityList& entities, const unsigned int revision)
+{
+	bucket.revision = revision;
+	bucket.built = true;
+	bucket.piecesReady = false;
+	bucket.numVisibleStatics = 0;
+	bucket.statics.clear();
+	bucket.dynamics.clear();
+	bucket.updatable.clear();
+	bucket.particles.clear();
+	bucket.lights.clear();
+	bucket.renderers.clear();
+	bucket.pieces.clear();
+
+	for (ETHEntityList::const_iterator iter = entities.begin(); iter != entities.end(); ++iter)
+	{
+		ETHRenderEntity* entity = (*iter);
+		if (!entity->IsStatic())
+		{
+			bucket.dynamics.push_back(entity);
+			continue;
+		}
+
+		STATIC_ENTITY staticEntity;
+		staticEntity.entity = entity;
+		staticEntity.key = RENDER_KEY(entity);
+		bucket.statics.push_back(staticEntity);
+
+		// scene bounding for depth buffer also counts hidden entities
+		if (bucket.statics.size() == 1)
+		{
+			bucket.maxHeight = entity->GetMaxHeight();
+			bucket.minHeight = entity->GetMinHeight();
+		}
+		else
+		{
+			bucket.maxHeight = Max(bucket.maxHeight, entity->GetMaxHeight());
+			bucket.minHeight = Min(bucket.minHeight, entity->GetMinHeight());
+		}
+
+		if (staticEntity.key.hidden)
+			continue;
+
+		++bucket.numVisibleStatics;
+
+		// Update() on a static entity only moves particles and runs callbacks
+		if (staticEntity.key.hasCallback || staticEntity.key.hasParticles)
+			bucket.updatable.push_back(entity);
+		if (staticEntity.key.hasParticles)
+			bucket.particles.push_back(entity);
+		if (staticEntity.key.hasLight)
+			bucket.lights.push_back(entity);
+	}
+}
+
+void ETHStaticRenderCache::BuildPieces(
+	BUCKET& bucket,
+	const ETHEntityRenderingManager& renderingManager,
+	const VideoPtr& video,
+	const ETHResourceProviderPtr& provider,
+	std::list<ETHLight>* lights,
+	ETHProjShadowBatch* shadowBatch,
+	const float minHeight,
+	const float maxHeight)
+{
+	const ETHShaderManagerPtr& shaderManager = provider->GetShaderManager();
+
+	// vertical entities are hashed relative to the camera; store the hash for a camera at the origin
+	const float cameraShift = video->GetCameraPos().y / video->GetScreenSizeF().y;
+
+	bucket.renderers.clear();
+	bucket.pieces.clear();
+	for (std::size_t t = 0; t < bucket.statics.size(); t++)
+	{
+		const STATIC_ENTITY& staticEntity = bucket.statics[t];
+		if (staticEntity.key.hidden)
+			continue;
+
+		ETHRenderEntity* entity = staticEntity.entity;
+
+		PIECE piece;
+		piece.entity = entity;
+		piece.vertical = (staticEntity.key.type == ETHEntityProperties::ET_VERTICAL);
+		piece.visible = true;
+
+		// sprite
+		{
+			ETHEntityPieceRendererPtr spritePiece(
+				new ETHEntitySpriteRenderer(
+					entity,
+					shaderManager,
+					video,
+					m_settings.lightmapsEnabled,
+					m_settings.realTimeShadowsEnabled,
+					lights,
+					shadowBatch));
+
+			const float depth = entity->ComputeDepth(maxHeight, minHeight);
+			piece.hash = renderingManager.ComputeDrawHash(video, depth, entity);
+			piece.baseHash = piece.vertical ? (piece.hash + cameraShift) : piece.hash;
+			piece.cullable = true;
+			piece.renderer = spritePiece.get();
+			bucket.renderers.push_back(spritePiece);
+			bucket.pieces.push_back(piece);
+		}
+
+		// halo
+		if (staticEntity.key.hasLight && entity->GetHalo())
+		{
+			const float haloZ = entity->GetPositionZ() + (piece.vertical ? entity->GetCurrentSize().y : 0.0f);
+			const float depth = ETHEntity::ComputeDepth(haloZ, maxHeight, minHeight);
+
+			ETHEntityPieceRendererPtr haloPiece(new ETHEntityHaloRenderer(entity, shaderManager, depth));
+
+			piece.hash = renderingManager.ComputeDrawHash(video, depth, entity);
+			piece.baseHash = piece.vertical ? (piece.hash + cameraShift) : piece.hash;
+			piece.cullable = false;
+			piece.renderer = haloPiece.get();
+			bucket.renderers.push_back(haloPiece);
+			bucket.pieces.push_back(piece);
+		}
+	}
+	bucket.piecesReady = true;
+}
+
+void ETHStaticRenderCache::EndFrame(
+	const ETHEntityRenderingManager& renderingManager,
+	const VideoPtr& video,
+	const ETHBackBufferTargetManagerPtr& backBuffer,
+	const ETHResourceProviderPtr& provider,
+	std::list<ETHLight>* lights,
+	ETHProjShadowBatch* shadowBatch,
+	const ETHSceneProperties& props,
+	const float minHeight,
+	const float maxHeight)
+{
+	// depth depends on the scene height range, which only grows once the scene is running
+	if (minHeight != m_minHeight || maxHeight != m_maxHeight)
+	{
+		m_minHeight = minHeight;
+		m_maxHeight = maxHeight;
+		for (BucketCacheMap::iterator iter = m_buckets.begin(); iter != m_buckets.end(); ++iter)
+		{
+			iter->second.piecesReady = false;
+		}
+	}
+
+	for (BucketCacheMap::iterator iter = m_buckets.begin(); iter != m_buckets.end(); ++iter)
+	{
+		BUCKET& bucket = iter->second;
+		if (bucket.built && !bucket.piecesReady)
+		{
+			BuildPieces(bucket, renderingManager, video, provider, lights, shadowBatch, minHeight, maxHeight);
+			m_runDirty = true;
+		}
+	}
+
+	UpdateRun(video->GetCameraPos(), video->GetScreenSizeF().y, backBuffer, props);
+}
+
+void ETHStaticRenderCache::UpdateRun(
+	const Vector2& cameraPos,
+	const float screenHeight,
+	const ETHBackBufferTargetManagerPtr& backBuffer,
+	const ETHSceneProperties& props)
+{
+	bool fullSort = false;
+	if (m_runDirty)
+	{
+		m_run.clear();
+		for (std::vector<Vector2>::const_iterator iter = m_visibleBuckets.begin(); iter != m_visibleBuckets.end(); ++iter)
+		{
+			BucketCacheMap::const_iterator bucketIter = m_buckets.find(*iter);
+			if (bucketIter == m_buckets.end())
+				continue;
+			const std::vector<PIECE>& pieces = bucketIter->second.pieces;
+			m_run.insert(m_run.end(), pieces.begin(), pieces.end());
+		}
+		m_runDirty = false;
+		fullSort = true;
+	}
+	else if (cameraPos == m_lastCameraPos)
+	{
+		// nothing moved, the run from the last frame is still valid
+		return;
+	}
+
+	const bool cameraMovedVertically = (cameraPos.y != m_lastCameraPos.y);
+	m_lastCameraPos = cameraPos;
+
+	const float cameraShift = cameraPos.y / screenHeight;
+	for (std::size_t t = 0; t < m_run.size(); t++)
+	{
+		PIECE& piece = m_run[t];
+		piece.hash = piece.vertical ? (piece.baseHash - cameraShift) : piece.baseHash;
+		if (piece.cullable)
+			piece.visible = piece.entity->IsSpriteVisible(props, backBuffer);
+	}
+
+	if (fullSort)
+	{
+		std::stable_sort(m_run.begin(), m_run.end());
+	}
+	else if (cameraMovedVertically)
+	{
+		// a camera move only shifts vertical entities against the rest, so the run is
+		// nearly sorted already and an insertion sort is close to linear
+		for (std::size_t t = 1; t < m_run.size(); t++)
+		{
+			const PIECE piece = m_run[t];
+			std::size_t u = t;
+			for (; u > 0 && piece < m_run[u - 1]; --u)
+			{
+				m_run[u] = m_run[u - 1];
+			}
+			m_run[u] = piece;
+		}
+	}
+}
+
+const ETHStaticRenderCache::PIECE_RUN& ETHStaticRenderCache::GetRun() const
+{
+	return m_run;
+}
+
+void ETHStaticRenderCache::Clear()
+{
+	m_buckets.clear();
+	m_visibleBuckets.clear();
+	m_run.clear();
+	m_runDirty = true;
+}
+
+unsigned int ETHStaticRenderCache::GetNumRebuiltBuckets() const
+{
+	return m_numRebuiltBuckets;
+}
@@ -0,0 +1,170 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#ifndef ETH_STATIC_RENDER_CACHE_H_
+#define ETH_STATIC_RENDER_CACHE_H_
+
+#include "ETHEntityPieceRenderer.h"
+
+#include "../Scene/ETHBucketManager.h"
+
+#include <vector>
+
+class ETHEntityRenderingManager;
+class ETHProjShadowBatch;
+
+/// Keeps the sprite and halo pieces of static entities alive between frames, grouped by
+/// bucket and merged into a single pre-sorted run for the currently visible bucket set.
+/// Buckets are rebuilt only when an entity enters or leaves them or when one of their
+/// static entities changes in a way that affects culling or sorting.
+class ETHStaticRenderCache
+{
+public:
+	struct RENDER_KEY
+	{
+		RENDER_KEY();
+		explicit RENDER_KEY(ETHRenderEntity* entity);
+		bool operator == (const RENDER_KEY& other) const;
+
+		Vector3 pos;
+		Vector2 size;
+		float angle;
+		float layerDepth;
+		ETHEntityProperties::ENTITY_TYPE type;
+		bool hidden;
+		bool isStatic;
+		bool hasLight;
+		bool hasHalo;
+		bool hasParticles;
+		bool hasCallback;
+	};
+
+	struct STATIC_ENTITY
+	{
+		ETHRenderEntity* entity;
+		RENDER_KEY key;
+	};
+
+	struct PIECE
+	{
+		float hash;
+		float baseHash;
+		bool vertical;
+		bool cullable;
+		bool visible;
+		ETHRenderEntity* entity;
+		ETHEntityPieceRenderer* renderer;
+
+		inline bool operator < (const PIECE& other) const { return hash < other.hash; }
+	};
+
+	typedef std::vector<PIECE> PIECE_RUN;
+
+	struct BUCKET
+	{
+		BUCKET();
+		unsigned int revision;
+		bool built;
+		bool piecesReady;
+		float minHeight, maxHeight;
+		unsigned int numVisibleStatics;
+
+		std::vector<STATIC_ENTITY> statics;
+		std::vector<ETHRenderEntity*> dynamics;
+
+		// static entities that still need per-frame work
+		std::vector<ETHRenderEntity*> updatable;
+		std::vector<ETHRenderEntity*> particles;
+		std::vector<ETHRenderEntity*> lights;
+
+		std::vector<ETHEntityPieceRendererPtr> renderers;
+		std::vector<PIECE> pieces;
+	};
+
+	ETHStaticRenderCache();
+
+	/// Drops buckets that are no longer visible and everything if render settings changed
+	void BeginFrame(
+		const ETHSpan<Vector2>& visibleBuckets,
+		const VideoPtr& video,
+		const ETHBackBufferTargetManagerPtr& backBuffer,
+		const ETHResourceProviderPtr& provider,
+		const ETHSceneProperties& props);
+
+	/// Returns the bucket cache, splitting its entities into static and dynamic sets again
+	/// if the bucket or any of its static entities changed since the last frame
+	const BUCKET& ValidateBucket(const Vector2& bucket, const ETHEntityList& entities, const unsigned int revision);
+
+	/// Creates missing pieces and refreshes the run of visible static pieces
+	void EndFrame(
+		const ETHEntityRenderingManager& renderingManager,
+		const VideoPtr& video,
+		const ETHBackBufferTargetManagerPtr& backBuffer,
+		const ETHResourceProviderPtr& provider,
+		std::list<ETHLight>* lights,
+		ETHProjShadowBatch* shadowBatch,
+		const ETHSceneProperties& props,
+		const float minHeight,
+		const float maxHeight);
+
+	const PIECE_RUN& GetRun() const;
+	void Clear();
+
+	unsigned int GetNumRebuiltBuckets() const;
+
+private:
+	struct SETTINGS
+	{
+		SETTINGS();
+		bool operator == (const SETTINGS& other) const;
+		bool lightmapsEnabled;
+		bool realTimeShadowsEnabled;
+		Vector2 screenSize;
+		Vector2 bufferSize;
+		Vector2 zAxisDirection;
+		float parallaxIntensity;
+	};
+
+	void BuildBucket(BUCKET& bucket, const ETHEntityList& entities, const unsigned int revision);
+	void BuildPieces(
+		BUCKET& bucket,
+		const ETHEntityRenderingManager& renderingManager,
+		const VideoPtr& video,
+		const ETHResourceProviderPtr& provider,
+		std::list<ETHLight>* lights,
+		ETHProjShadowBatch* shadowBatch,
+		const float minHeight,
+		const float maxHeight);
+	void UpdateRun(const Vector2& cameraPos, const float screenHeight, const ETHBackBufferTargetManagerPtr& backBuffer, const ETHSceneProperties& props);
+
+	typedef boost::unordered_map<Vector2, BUCKET, boost::hash<Vector2> > BucketCacheMap;
+	BucketCacheMap m_buckets;
+	std::vector<Vector2> m_visibleBuckets;
+	PIECE_RUN m_run;
+	SETTINGS m_settings;
+	Vector2 m_lastCameraPos;
+	float m_minHeight, m_maxHeight;
+	bool m_runDirty;
+	unsigned int m_numRebuiltBuckets;
+};
+
+#endif
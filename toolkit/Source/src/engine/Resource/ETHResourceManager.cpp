@@ -26,6 +26,8 @@
 
 #include "ETHResourceProvider.h"
 
+#include "../Util/ETHAllocationTracker.h"
+
 const gs2d::str_type::string ETHGraphicResourceManager::SD_EXPANSION_FILE_PATH = "com.ethanonengine.expansionFile.path";
 
 static str_type::string RemoveResourceDirectory(
@@ -119,6 +121,7 @@ SpritePtr ETHGraphicResourceManager::AddFile(
 	const bool cutOutBlackPixels,
 	const bool temporary)
 {
+	ETH_ALLOCATION_SCOPE(RESOURCES);
 	str_type::string fileName = Platform::GetFileName(path);
 	{
 		SpritePtr sprite = FindSprite(path, fileName, resourceDirectory);
@@ -262,6 +265,7 @@ AudioSamplePtr ETHAudioResourceManager::AddFile(
 	const str_type::string& path,
 	const Audio::SAMPLE_TYPE type)
 {
+	ETH_ALLOCATION_SCOPE(RESOURCES);
 	if (!m_resource.empty())
 	{
 		str_type::string fileName = Platform::GetFileName(path);
@@ -273,6 +277,7 @@ AudioSamplePtr ETHAudioResourceManager::AddFile(
 	AudioSamplePtr pSample;
 	str_type::string fixedName(path);
 	Platform::FixSlashes(fixedName);
+	const boost::uint64_t liveBytesBefore = ETHAllocationTracker::GetLiveBytes();
 	if (!(pSample = audio->LoadSampleFromFile(fixedName, fileIOHub->GetFileManager(), type)))
 	{
 		pSample.reset();
@@ -283,6 +288,13 @@ AudioSamplePtr ETHAudioResourceManager::AddFile(
 	//#if defined(_DEBUG) || defined(DEBUG)
 	str_type::string fileName = Platform::GetFileName(path);
 	ETH_STREAM_DECL(ss) << GS_L("(Loaded) ") << fileName;
+	if (ETHAllocationTracker::IsEnabled())
+	{
+		// streamed tracks should only keep their decoder and read window resident
+		const boost::uint64_t liveBytesAfter = ETHAllocationTracker::GetLiveBytes();
+		const boost::uint64_t resident = (liveBytesAfter > liveBytesBefore) ? (liveBytesAfter - liveBytesBefore) : 0;
+		ss << GS_L(" [") << (resident / 1024) << GS_L(" KB resident]");
+	}
 	ETHResourceProvider::Log(ss.str(), Platform::Logger::INFO);
 	//#endif
 	m_resource[fileName] = pSample;
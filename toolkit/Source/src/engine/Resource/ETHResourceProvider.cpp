@@ -37,8 +37,8 @@ bool ETHResourceProvider::m_richLighting = true;
 SpritePtr ETHResourceProvider::m_outline;
 SpritePtr ETHResourceProvider::m_invisibleEntSymbol;
 
-Platform::FileLoggerPtr ETHResourceProvider::m_logger(
-	new Platform::FileLogger(Platform::FileLogger::GetLogDirectory() + GS_L("eth.log.txt")));
+Platform::BufferedFileLoggerPtr ETHResourceProvider::m_logger(
+	new Platform::BufferedFileLogger(Platform::FileLogger::GetLogDirectory() + GS_L("eth.log.txt")));
 
 ETHResourceProvider::ETHResourceProvider(
 	ETHGraphicResourceManagerPtr graphicResources,
@@ -73,6 +73,16 @@ void ETHResourceProvider::Log(const str_type::string& str, const Platform::Logge
 	m_logger->Log(str, type);
 }
 
+void ETHResourceProvider::FlushLog()
+{
+	m_logger->Flush();
+}
+
+void ETHResourceProvider::SetLogLevel(const Platform::Logger::TYPE& level)
+{
+	m_logger->SetLevel(level);
+}
+
 ETHGlobalScaleManagerPtr& ETHResourceProvider::GetGlobalScaleManager()
 {
 	return m_globalScaleManager;
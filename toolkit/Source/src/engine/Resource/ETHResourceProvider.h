@@ -30,7 +30,7 @@
 #include "../Platform/ETHPlatform.h"
 
 #include <Platform/Platform.h>
-#include <Platform/FileLogger.h>
+#include <Platform/BufferedFileLogger.h>
 #include <Platform/FileIOHub.h>
 #include <Input.h>
 
@@ -44,7 +44,7 @@ class ETHResourceProvider
 	static VideoPtr m_video;
 	static AudioPtr m_audio;
 	static InputPtr m_input;
-	static Platform::FileLoggerPtr m_logger;
+	static Platform::BufferedFileLoggerPtr m_logger;
 	static ETHGlobalScaleManagerPtr m_globalScaleManager;
 	static Platform::FileIOHubPtr m_fileIOHub;
 
@@ -70,6 +70,8 @@ public:
 		const bool isInEditor);
 
 	static void Log(const str_type::string& str, const Platform::Logger::TYPE& type);
+	static void FlushLog();
+	static void SetLogLevel(const Platform::Logger::TYPE& level);
 
 	bool IsInEditor() const;
 
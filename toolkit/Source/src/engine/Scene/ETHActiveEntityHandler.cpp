@@ -24,8 +24,9 @@
 
 #include "../Entity/ETHRenderEntity.h"
 
-ETHActiveEntityHandler::ETHActiveEntityHandler(ETHResourceProviderPtr provider) :
-	m_provider(provider)
+ETHActiveEntityHandler::ETHActiveEntityHandler(ETHResourceProviderPtr provider, asIScriptContext* pContext) :
+	m_provider(provider),
+	m_callbackDispatcher(pContext)
 {
 }
 
@@ -110,7 +111,12 @@ void ETHActiveEntityHandler::TestEntityLists() const
 	}
 }
 
-void ETHActiveEntityHandler::UpdateAlwaysActiveEntities(const Vector2& zAxisDir, ETHBucketManager& buckets, const float lastFrameElapsedTime)
+void ETHActiveEntityHandler::UpdateAlwaysActiveEntities(
+	const Vector2& zAxisDir,
+	ETHBucketManager& buckets,
+	const float lastFrameElapsedTime,
+	const Vector2& minVisibleBucket,
+	const Vector2& maxVisibleBucket)
 {
 	#if defined(_DEBUG) || defined(DEBUG)
 	TestEntityLists();
@@ -131,15 +137,20 @@ void ETHActiveEntityHandler::UpdateAlwaysActiveEntities(const Vector2& zAxisDir,
 			continue;
 		}
 
-		entity->Update(lastFrameElapsedTime, zAxisDir, buckets);
+		// entities are only drawn from visible buckets, so nobody would see their particles
+		const Vector2 bucket(ETHBucketManager::GetBucket(entity->GetPositionXY(), buckets.GetBucketSize()));
+		const bool particlesVisible = ETHBucketManager::IsBucketInRange(bucket, minVisibleBucket, maxVisibleBucket);
+
+		entity->Update(lastFrameElapsedTime, zAxisDir, buckets, particlesVisible);
 
 		if (entity->HasAnyCallbackFunction())
 		{
-			entity->RunCallbackScript();
+			m_callbackDispatcher.Enqueue(entity);
 		}
 
 		++iter;
 	}
+	m_callbackDispatcher.Dispatch();
 }
 
 void ETHActiveEntityHandler::UpdateCurrentFrameEntities(const Vector2& zAxisDir, ETHBucketManager& buckets, const float lastFrameElapsedTime)
@@ -158,12 +169,13 @@ void ETHActiveEntityHandler::UpdateCurrentFrameEntities(const Vector2& zAxisDir,
 
 			if (entity->HasAnyCallbackFunction())
 			{
-				entity->RunCallbackScript();
+				m_callbackDispatcher.Enqueue(entity);
 			}
 		}
 		entity->Release();
 		iter = m_lastFrameCallbacks.erase(iter);
 	}
+	m_callbackDispatcher.Dispatch();
 }
 
 bool ETHActiveEntityHandler::RemoveFinishedTemporaryEntity(ETHRenderEntity* entity, ETHBucketManager& buckets)
@@ -24,17 +24,23 @@
 #define ETH_TEMP_ENTITY_HANDLER_H_
 
 #include "ETHBucketManager.h"
+#include "ETHEntityCallbackDispatcher.h"
 
 class ETHActiveEntityHandler
 {
 public:
-	ETHActiveEntityHandler(ETHResourceProviderPtr provider);
+	ETHActiveEntityHandler(ETHResourceProviderPtr provider, asIScriptContext* pContext);
 	~ETHActiveEntityHandler();
 
 	bool AddEntityWhenEligible(ETHRenderEntity* entity);
 	bool ShouldEntityBeAlwaysActive(ETHRenderEntity* entity) const;
 
-	void UpdateAlwaysActiveEntities(const Vector2& zAxisDir, ETHBucketManager& buckets, const float lastFrameElapsedTime);
+	void UpdateAlwaysActiveEntities(
+		const Vector2& zAxisDir,
+		ETHBucketManager& buckets,
+		const float lastFrameElapsedTime,
+		const Vector2& minVisibleBucket,
+		const Vector2& maxVisibleBucket);
 	void UpdateCurrentFrameEntities(const Vector2& zAxisDir, ETHBucketManager& buckets, const float lastFrameElapsedTime);
 
 	bool AddStaticCallbackWhenEligible(ETHRenderEntity* entity);
@@ -50,6 +56,8 @@ private:
 
 	ETHResourceProviderPtr m_provider;
 
+	ETHEntityCallbackDispatcher m_callbackDispatcher;
+
 	/*
 	 * This list will hold every temporary or dynamic entity with callbacks or physics.
 	 * It must be kept separetely because these entities will be updated at every,
@@ -49,8 +49,8 @@ Vector2 ETHBucketManager::GetBucket(const Vector2& v2, const Vector2& v2BucketSi
 	return Vector2(floor(v2.x / v2BucketSize.x), floor(v2.y / v2BucketSize.y));
 }
 
-void ETHBucketManager::GetIntersectingBuckets(
-	std::list<Vector2>& outList,
+ETHSpan<Vector2> ETHBucketManager::GetIntersectingBuckets(
+	ETHScratchArena& arena,
 	const Vector2& pos,
 	const Vector2& size,
 	const Vector2& bucketSize,
@@ -58,38 +58,56 @@ void ETHBucketManager::GetIntersectingBuckets(
 	const bool includeLowerSeams)
 {
 	const static std::size_t ETH_MAX_BUCKETS = 512;
-	
-	const Vector2 &min = pos;
-	const Vector2 max(pos + size);
 
+	Vector2 minBucket, maxBucket;
+	GetIntersectingBucketRange(minBucket, maxBucket, pos, size, bucketSize, includeUpperSeams, includeLowerSeams);
+
+	// the whole range is known up front, so the list takes a single allocation
+	const float columns = Max(maxBucket.x - minBucket.x + 1.0f, 0.0f);
+	const float rows = Max(maxBucket.y - minBucket.y + 1.0f, 0.0f);
+	const std::size_t count = static_cast<std::size_t>(Min(columns * rows, static_cast<float>(ETH_MAX_BUCKETS + 1)));
+
+	Vector2* buckets = arena.Allocate<Vector2>(count);
+	std::size_t t = 0;
+	for (float y = minBucket.y; y <= maxBucket.y && t < count; y += 1.0f)
+	{
+		for (float x = minBucket.x; x <= maxBucket.x && t < count; x += 1.0f)
+		{
+			buckets[t++] = Vector2(x, y);
+		}
+	}
+	return ETHSpan<Vector2>(buckets, t);
+}
+
+void ETHBucketManager::GetIntersectingBucketRange(
+	Vector2& outMinBucket,
+	Vector2& outMaxBucket,
+	const Vector2& pos,
+	const Vector2& size,
+	const Vector2& bucketSize,
+	const bool includeUpperSeams,
+	const bool includeLowerSeams)
+{
 	// find minimum and maximum bucket pos (top left and bottom right points in the bucket grid)
-	Vector2 minBucket = GetBucket(min, bucketSize);
-	Vector2 maxBucket = GetBucket(max, bucketSize);
+	outMinBucket = GetBucket(pos, bucketSize);
+	outMaxBucket = GetBucket(pos + size, bucketSize);
 
 	if (includeLowerSeams)
 	{
-		minBucket.x -= 1;
-		minBucket.y -= 1;
+		outMinBucket.x -= 1;
+		outMinBucket.y -= 1;
 	}
 
 	if (includeUpperSeams)
 	{
-		maxBucket.x += 1;
-		maxBucket.y += 1;
+		outMaxBucket.x += 1;
+		outMaxBucket.y += 1;
 	}
+}
 
-	outList.clear();
-	for (float y = minBucket.y; y <= maxBucket.y; y += 1.0f)
-	{
-		for (float x = minBucket.x; x <= maxBucket.x; x += 1.0f)
-		{
-			outList.push_back(Vector2(x, y));
-			if (outList.size() > ETH_MAX_BUCKETS)
-			{
-				return;
-			}
-		}
-	}
+bool ETHBucketManager::IsBucketInRange(const Vector2& bucket, const Vector2& minBucket, const Vector2& maxBucket)
+{
+	return (bucket.x >= minBucket.x && bucket.y >= minBucket.y && bucket.x <= maxBucket.x && bucket.y <= maxBucket.y);
 }
 
 Vector2 ETHBucketManager::ComputeBucketRelativePosition(const Vector2& p, const Vector2& bucketSize)
@@ -102,9 +120,15 @@ Vector2 ETHBucketManager::ComputeBucketRelativePosition(const Vector2& p, const
 	return r;
 }
 
-ETHBucketManager::ETHBucketManager(const ETHResourceProviderPtr& provider, const Vector2& bucketSize, const bool drawingBorderBuckets) :
-	m_bucketSize(bucketSize),
+ETHBucketManager::ETHBucketManager(
+	const ETHResourceProviderPtr& provider,
+	ETHScratchArena& scratch,
+	const Vector2& bucketSize,
+	const bool drawingBorderBuckets) :
 	m_provider(provider),
+	m_scratch(scratch),
+	m_lastRevision(0),
+	m_bucketSize(bucketSize),
 	m_drawingBorderBuckets(drawingBorderBuckets)
 {
 }
@@ -185,9 +209,21 @@ std::size_t ETHBucketManager::GetNumEntities(const Vector2& key) const
 	}
 }
 
+unsigned int ETHBucketManager::GetBucketRevision(const Vector2& key) const
+{
+	boost::unordered_map<Vector2, unsigned int, boost::hash<Vector2> >::const_iterator iter = m_bucketRevisions.find(key);
+	return (iter != m_bucketRevisions.end()) ? iter->second : 0;
+}
+
+void ETHBucketManager::TouchBucket(const Vector2& key)
+{
+	m_bucketRevisions[key] = ++m_lastRevision;
+}
+
 void ETHBucketManager::Add(ETHRenderEntity* entity, const SIDE side)
 {
 	const Vector2 bucket = ETHBucketManager::GetBucket(entity->GetPositionXY(), GetBucketSize());
+	TouchBucket(bucket);
 	if (side == FRONT)
 	{
 		m_entities[bucket].push_front(entity);
@@ -241,6 +277,9 @@ bool ETHBucketManager::MoveEntity(const int id, const Vector2 &currentBucket, co
 		return false;
 	}
 
+	TouchBucket(currentBucket);
+	TouchBucket(destBucket);
+
 	// adds the entity to the destiny bucket
 	if (entity->GetType() == ETHEntityProperties::ET_HORIZONTAL)
 	{
@@ -297,14 +336,13 @@ int ETHBucketManager::SeekEntity(const Vector2& pointAbsPos, ETHEntity** pOutDat
 		return -1;
 	}
 
-	std::list<Vector2> buckets;
-	ETHBucketManager::GetIntersectingBuckets(buckets, pointAbsPos, Vector2(1,1), GetBucketSize(), true, true);
+	ETHScratchArena::Scope scratchScope(m_scratch);
+	const ETHSpan<Vector2> buckets = GetIntersectingBuckets(pointAbsPos, Vector2(1,1), true, true);
 
 	// seeks the closest intersecting entity from behind
-	for (std::list<Vector2>::const_reverse_iterator sceneBucketIter = buckets.rbegin();
-		sceneBucketIter != buckets.rend(); ++sceneBucketIter)
+	for (std::size_t b = buckets.size(); b > 0; b--)
 	{
-		ETHBucketMap::iterator bucketIter = Find(*sceneBucketIter);
+		ETHBucketMap::iterator bucketIter = Find(buckets[b - 1]);
 
 		if (bucketIter == GetLastBucket())
 			continue;
@@ -340,7 +378,7 @@ int ETHBucketManager::SeekEntity(const Vector2& pointAbsPos, ETHEntity** pOutDat
 	}
 
 	// seeks the first intersecting entity from the front
-	for (std::list<Vector2>::const_iterator sceneBucketIter = buckets.begin(); sceneBucketIter != buckets.end(); ++sceneBucketIter)
+	for (ETHSpan<Vector2>::const_iterator sceneBucketIter = buckets.begin(); sceneBucketIter != buckets.end(); ++sceneBucketIter)
 	{
 		ETHBucketMap::iterator bucketIter = Find(*sceneBucketIter);
 
@@ -424,6 +462,7 @@ bool ETHBucketManager::DeleteEntity(const int id)
 				(*iter)->Kill();
 				(*iter)->Release();
 				entityList.erase(iter);
+				TouchBucket(bucketIter->first);
 				return true;
 			}
 		}
@@ -454,6 +493,7 @@ bool ETHBucketManager::DeleteEntity(const int id, const Vector2 &searchBucket)
 				ETHEntityList::iterator i = iter.base();
 				--i;
 				entityList.erase(i);
+				TouchBucket(bucketIter->first);
 				return true;
 			}
 		}
@@ -546,6 +586,25 @@ void ETHBucketManager::GetEntitiesAroundBucket(const Vector2& bucket, ETHEntityA
 	GetEntitiesAroundBucket(bucket, outVector, ETHEntityDefaultChooser());
 }
 
+ETHSpan<ETHRenderEntity*> ETHBucketManager::GetEntitiesAroundBucket(const Vector2& bucket)
+{
+	// same visiting order as the ETHEntityArray version
+	static const float offsets[9][2] = { {0,0}, {1,0}, {1,1}, {0,1}, {-1,1}, {-1,0}, {-1,-1}, {0,-1}, {1,-1} };
+
+	ETHScratchVector<ETHRenderEntity*> entities(m_scratch, 64);
+	for (std::size_t t = 0; t < 9; t++)
+	{
+		ETHBucketMap::const_iterator bucketIter = Find(bucket + Vector2(offsets[t][0], offsets[t][1]));
+		if (bucketIter == GetLastBucket())
+			continue;
+
+		const ETHEntityList& entityList = bucketIter->second;
+		for (ETHEntityList::const_iterator iter = entityList.begin(); iter != entityList.end(); ++iter)
+			entities.push_back(*iter);
+	}
+	return entities.GetSpan();
+}
+
 void ETHBucketManager::GetWhiteListedEntitiesAroundBucket(const Vector2& bucket, ETHEntityArray &outVector, const str_type::string& semicolonSeparatedNames)
 {
 	GetEntitiesAroundBucket(bucket, outVector, ETHEntityNameArrayChooser(semicolonSeparatedNames, false));
@@ -556,24 +615,38 @@ void ETHBucketManager::GetEntitiesAroundBucketWithBlackList(const Vector2& bucke
 	GetEntitiesAroundBucket(bucket, outVector, ETHEntityNameArrayChooser(semicolonSeparatedNames, true));
 }
 
-void ETHBucketManager::GetIntersectingBuckets(
-	std::list<Vector2>& bucketList,
+ETHSpan<Vector2> ETHBucketManager::GetIntersectingBuckets(
 	const Vector2& pos,
 	const Vector2& size,
 	const bool upperSeams,
 	const bool lowerSeams)
 {
-	ETHBucketManager::GetIntersectingBuckets(bucketList, pos, size, GetBucketSize(), upperSeams, lowerSeams);
+	return ETHBucketManager::GetIntersectingBuckets(m_scratch, pos, size, GetBucketSize(), upperSeams, lowerSeams);
+}
+
+ETHScratchArena& ETHBucketManager::GetScratchArena()
+{
+	return m_scratch;
 }
 
 void ETHBucketManager::GetVisibleEntities(ETHEntityArray &outVector)
 {
-	std::list<Vector2> bucketList;
-	GetIntersectingBuckets(bucketList, m_provider->GetVideo()->GetCameraPos(),
-						   m_provider->GetVideo()->GetScreenSizeF(), IsDrawingBorderBuckets(), IsDrawingBorderBuckets());
+	ETHScratchArena::Scope scratchScope(m_scratch);
+	const ETHSpan<ETHRenderEntity*> entities = GetVisibleEntities();
+	for (std::size_t t = 0; t < entities.size(); t++)
+	{
+		outVector.push_back(entities[t]);
+	}
+}
+
+ETHSpan<ETHRenderEntity*> ETHBucketManager::GetVisibleEntities()
+{
+	const ETHSpan<Vector2> bucketList = GetIntersectingBuckets(m_provider->GetVideo()->GetCameraPos(),
+		m_provider->GetVideo()->GetScreenSizeF(), IsDrawingBorderBuckets(), IsDrawingBorderBuckets());
 
 	// Loop through all visible Buckets
-	for (std::list<Vector2>::iterator bucketPositionIter = bucketList.begin();
+	ETHScratchVector<ETHRenderEntity*> entities(m_scratch, 256);
+	for (ETHSpan<Vector2>::const_iterator bucketPositionIter = bucketList.begin();
 		bucketPositionIter != bucketList.end(); ++bucketPositionIter)
 	{
 		ETHBucketMap::const_iterator bucketIter = Find(*bucketPositionIter);
@@ -582,30 +655,38 @@ void ETHBucketManager::GetVisibleEntities(ETHEntityArray &outVector)
 			continue;
 
 		const ETHEntityList& entityList = bucketIter->second;
-		if (entityList.empty())
-			continue;
-
 		ETHEntityList::const_iterator iEnd = entityList.end();
 		for (ETHEntityList::const_iterator iter = entityList.begin(); iter != iEnd; ++iter)
 		{
-			outVector.push_back(*iter);
+			entities.push_back(*iter);
 		}
 	}
+	return entities.GetSpan();
 }
 
 void ETHBucketManager::GetIntersectingEntities(const Vector2 &point, ETHEntityArray &outVector, const bool screenSpace, const ETHSceneProperties& props)
 {
-	ETHEntityArray temp;
+	ETHScratchArena::Scope scratchScope(m_scratch);
+	const ETHSpan<ETHRenderEntity*> entities = GetIntersectingEntities(point, screenSpace, props);
+	for (std::size_t t = 0; t < entities.size(); t++)
+	{
+		outVector.push_back(entities[t]);
+	}
+}
+
+ETHSpan<ETHRenderEntity*> ETHBucketManager::GetIntersectingEntities(const Vector2 &point, const bool screenSpace, const ETHSceneProperties& props)
+{
 	const Vector2 v2Bucket(ETHBucketManager::GetBucket(point, GetBucketSize()));
-	GetEntitiesAroundBucket(v2Bucket, temp);
+	const ETHSpan<ETHRenderEntity*> around = GetEntitiesAroundBucket(v2Bucket);
+	const Vector2 cameraPos = m_provider->GetVideo()->GetCameraPos();
 
-	for (unsigned int t=0; t<temp.size(); t++)
+	ETHScratchVector<ETHRenderEntity*> entities(m_scratch);
+	for (std::size_t t = 0; t < around.size(); t++)
 	{
-		ETHEntityProperties::VIEW_RECT rect = temp[t]->GetScreenRect(props);
+		ETHEntityProperties::VIEW_RECT rect = around[t]->GetScreenRect(props);
 
 		if (!screenSpace)
 		{
-			const Vector2 cameraPos = m_provider->GetVideo()->GetCameraPos();
 			rect.max += cameraPos;
 			rect.min += cameraPos;
 		}
@@ -618,8 +699,9 @@ void ETHBucketManager::GetIntersectingEntities(const Vector2 &point, ETHEntityAr
 			continue;
 		if (point.y > rect.max.y)
 			continue;
-		outVector.push_back(temp[t]);
+		entities.push_back(around[t]);
 	}
+	return entities.GetSpan();
 }
 
 void ETHBucketManager::GetEntityArray(ETHEntityArray &outVector)
@@ -637,11 +719,12 @@ void ETHBucketManager::GetEntityArray(ETHEntityArray &outVector)
 
 void ETHBucketManager::RequestBucketMove(ETHEntity* target, const Vector2& oldPos, const Vector2& newPos)
 {
-	ETHBucketMoveRequestPtr request(new ETHBucketMoveRequest(target, oldPos, newPos, GetBucketSize()));
-	if (request->IsABucketMove())
-	{
-		m_moveRequests.push_back(request);
-	}
+	// most moves stay within the same bucket, so check that before allocating a request
+	const Vector2& bucketSize = GetBucketSize();
+	if (GetBucket(oldPos, bucketSize) == GetBucket(newPos, bucketSize))
+		return;
+
+	m_moveRequests.push_back(ETHBucketMoveRequestPtr(new ETHBucketMoveRequest(target, oldPos, newPos, bucketSize)));
 }
 
 void ETHBucketManager::ResolveMoveRequests()
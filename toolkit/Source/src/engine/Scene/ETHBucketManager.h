@@ -32,6 +32,8 @@ class ETHEntityArray;
 
 #include "../Resource/ETHResourceProvider.h"
 
+#include "../Util/ETHScratchArena.h"
+
 #include <list>
 #include <map>
 
@@ -57,17 +59,35 @@ class ETHBucketManager
 {
 public:
 	static Vector2 GetBucket(const Vector2 &v2, const Vector2 &v2BucketSize);
-	static void GetIntersectingBuckets(
-		std::list<Vector2> &outList,
+
+	/// Buckets covered by the area, row by row. The list is allocated from the arena
+	static ETHSpan<Vector2> GetIntersectingBuckets(
+		ETHScratchArena& arena,
+		const Vector2 &pos,
+		const Vector2 &size,
+		const Vector2 &bucketSize,
+		bool includeUpperSeams = false,
+		bool includeLowerSeams = false);
+
+	/// Top left and bottom right buckets of the area, both inclusive
+	static void GetIntersectingBucketRange(
+		Vector2& outMinBucket,
+		Vector2& outMaxBucket,
 		const Vector2 &pos,
 		const Vector2 &size,
 		const Vector2 &bucketSize,
 		bool includeUpperSeams = false,
 		bool includeLowerSeams = false);
 
+	static bool IsBucketInRange(const Vector2& bucket, const Vector2& minBucket, const Vector2& maxBucket);
+
 	static Vector2 ComputeBucketRelativePosition(const Vector2& p, const Vector2 &bucketSize);
 
-	ETHBucketManager(const ETHResourceProviderPtr& provider, const Vector2& bucketSize, const bool drawingBorderBuckets);
+	ETHBucketManager(
+		const ETHResourceProviderPtr& provider,
+		ETHScratchArena& scratch,
+		const Vector2& bucketSize,
+		const bool drawingBorderBuckets);
 	~ETHBucketManager();
 
 	enum SIDE
@@ -93,8 +113,15 @@ public:
 
 	unsigned int GetNumEntities() const;
 
+	/// Returns a number that changes whenever an entity enters or leaves the bucket
+	unsigned int GetBucketRevision(const Vector2& key) const;
+
 	/// Get the list of visible buckets
-	void GetIntersectingBuckets(std::list<Vector2>& bucketList, const Vector2& pos, const Vector2& size, const bool upperSeams, const bool lowerSeams);
+	ETHSpan<Vector2> GetIntersectingBuckets(const Vector2& pos, const Vector2& size, const bool upperSeams, const bool lowerSeams);
+
+	/// Arena the queries below take their temporaries from. Spans returned by them stay
+	/// valid until the caller's ETHScratchArena::Scope ends or the next frame starts
+	ETHScratchArena& GetScratchArena();
 
 	/// Search for an entity whose location collides with the 'at' point
 	/// It returns the entity ID # and it's further data. If nAfterThisID is greater than
@@ -128,11 +155,15 @@ public:
 	void GetWhiteListedEntitiesAroundBucket(const Vector2& bucket, ETHEntityArray &outVector, const str_type::string& semicolonSeparatedNames);
 	void GetEntitiesAroundBucketWithBlackList(const Vector2& bucket, ETHEntityArray &outVector, const str_type::string& semicolonSeparatedNames);
 
+	ETHSpan<ETHRenderEntity*> GetEntitiesAroundBucket(const Vector2& bucket);
+
 	/// get an array of visible entities
 	void GetVisibleEntities(ETHEntityArray &outVector);
+	ETHSpan<ETHRenderEntity*> GetVisibleEntities();
 
 	/// get an array containing all entities that intersect with the point
 	void GetIntersectingEntities(const Vector2 &point, ETHEntityArray &outVector, const bool screenSpace, const ETHSceneProperties& props);
+	ETHSpan<ETHRenderEntity*> GetIntersectingEntities(const Vector2 &point, const bool screenSpace, const ETHSceneProperties& props);
 
 	/// get an array containing all entities in scene
 	void GetEntityArray(ETHEntityArray &outVector);
@@ -160,12 +191,16 @@ private:
 	typedef boost::shared_ptr<ETHBucketMoveRequest> ETHBucketMoveRequestPtr;
 
 	bool MoveEntity(const int id, const Vector2 &currentBucket, const Vector2 &destBucket);
+	void TouchBucket(const Vector2& key);
 
 	std::list<ETHBucketMoveRequestPtr> m_moveRequests;
 
 	ETHResourceProviderPtr m_provider;
+	ETHScratchArena& m_scratch;
 	ETHBucketManager& operator=(const ETHBucketManager& p);
 	ETHBucketMap m_entities;
+	boost::unordered_map<Vector2, unsigned int, boost::hash<Vector2> > m_bucketRevisions;
+	unsigned int m_lastRevision;
 	const Vector2 m_bucketSize;
 	bool m_drawingBorderBuckets;
 };
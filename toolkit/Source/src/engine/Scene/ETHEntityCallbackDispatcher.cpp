@@ -0,0 +1,144 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#include "ETHEntityCallbackDispatcher.h"
+
+#include "../Entity/ETHEntityArray.h"
+
+ETHEntityCallbackDispatcher::ETHEntityCallbackDispatcher(asIScriptContext* pContext) :
+	m_pContext(pContext)
+{
+}
+
+ETHEntityCallbackDispatcher::~ETHEntityCallbackDispatcher()
+{
+	ReleaseAll();
+}
+
+void ETHEntityCallbackDispatcher::Enqueue(ETHRenderEntity* entity)
+{
+	// constructors must run before anything else gets to see the entity
+	entity->RunConstructorCallbackScript();
+
+	asIScriptFunction* func = entity->GetBatchCallbackFunction();
+	const bool batch = (func != 0);
+	if (!batch)
+	{
+		func = entity->GetCallbackFunction();
+	}
+
+	if (!func)
+		return;
+
+	std::size_t groupIdx;
+	std::map<asIScriptFunction*, std::size_t>::const_iterator iter = m_groupIndices.find(func);
+	if (iter != m_groupIndices.end())
+	{
+		groupIdx = iter->second;
+	}
+	else
+	{
+		groupIdx = m_groups.size();
+		m_groups.push_back(CALLBACK_GROUP());
+		m_groups[groupIdx].func = func;
+		m_groupIndices[func] = groupIdx;
+	}
+
+	CALLBACK_GROUP& group = m_groups[groupIdx];
+	if (group.entities.empty())
+	{
+		// first entity of this group in the current pass
+		group.batch = batch;
+		m_passGroups.push_back(groupIdx);
+	}
+
+	entity->AddRef();
+	group.entities.push_back(entity);
+}
+
+void ETHEntityCallbackDispatcher::Dispatch()
+{
+	for (std::size_t t = 0; t < m_passGroups.size(); t++)
+	{
+		RunGroup(m_groups[m_passGroups[t]]);
+	}
+	ReleaseAll();
+}
+
+void ETHEntityCallbackDispatcher::RunGroup(const CALLBACK_GROUP& group)
+{
+	if (group.batch)
+	{
+		RunBatch(group);
+		return;
+	}
+
+	for (std::size_t t = 0; t < group.entities.size(); t++)
+	{
+		// an earlier callback may have deleted this entity
+		ETHRenderEntity* entity = group.entities[t];
+		if (entity->IsAlive())
+		{
+			ETHGlobal::RunEntityCallback(m_pContext, entity, group.func);
+		}
+	}
+}
+
+void ETHEntityCallbackDispatcher::RunBatch(const CALLBACK_GROUP& group)
+{
+	ETHEntityArray* entities = ETHEntityArrayFactory();
+	for (std::size_t t = 0; t < group.entities.size(); t++)
+	{
+		ETHRenderEntity* entity = group.entities[t];
+		if (entity->IsAlive())
+		{
+			entities->push_back(entity);
+		}
+	}
+
+	if (entities->size() > 0 && m_pContext->Prepare(group.func) >= 0)
+	{
+		if (m_pContext->SetArgObject(0, entities) >= 0)
+		{
+			ETHGlobal::ExecuteContext(m_pContext, group.func, false);
+		}
+	}
+
+	// the script may still hold a handle to the array
+	entities->Release();
+}
+
+void ETHEntityCallbackDispatcher::ReleaseAll()
+{
+	for (std::size_t g = 0; g < m_passGroups.size(); g++)
+	{
+		std::vector<ETHRenderEntity*>& entities = m_groups[m_passGroups[g]].entities;
+		for (std::size_t t = 0; t < entities.size(); t++)
+		{
+			entities[t]->Release();
+		}
+
+		// keeps its capacity so steady-state frames don't allocate
+		entities.clear();
+	}
+	m_passGroups.clear();
+}
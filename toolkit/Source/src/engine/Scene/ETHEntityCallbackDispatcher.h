@@ -0,0 +1,78 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#ifndef ETH_ENTITY_CALLBACK_DISPATCHER_H_
+#define ETH_ENTITY_CALLBACK_DISPATCHER_H_
+
+#include "../Entity/ETHRenderEntity.h"
+
+#include <vector>
+#include <map>
+
+/*
+ * Collects the entities whose callbacks must run in the current update pass and
+ * runs them grouped by script function. Consecutive calls to the same function
+ * let the script context skip most of its Prepare work, and entities whose
+ * template declares an ETHBatchCallback_ function are handed to the script as a
+ * single ETHEntityArray instead of one call each
+ *
+ * Groups run in the order their function first showed up during the pass, and
+ * entities run in update order inside their group, so the result never depends
+ * on where the script functions were allocated.
+ *
+ * Timing: callbacks no longer run right after their own entity updates. Every
+ * entity of the pass is updated first and the callbacks run afterwards, so a
+ * callback sees all entities of that pass already updated for the frame
+ */
+class ETHEntityCallbackDispatcher
+{
+public:
+	ETHEntityCallbackDispatcher(asIScriptContext* pContext);
+	~ETHEntityCallbackDispatcher();
+
+	void Enqueue(ETHRenderEntity* entity);
+	void Dispatch();
+
+private:
+	struct CALLBACK_GROUP
+	{
+		asIScriptFunction* func;
+		bool batch;
+		std::vector<ETHRenderEntity*> entities;
+	};
+
+	void RunGroup(const CALLBACK_GROUP& group);
+	void RunBatch(const CALLBACK_GROUP& group);
+	void ReleaseAll();
+
+	asIScriptContext* m_pContext;
+
+	// one group per function ever seen, kept with its index from pass to pass so
+	// steady-state frames neither allocate groups nor map nodes
+	std::vector<CALLBACK_GROUP> m_groups;
+	std::map<asIScriptFunction*, std::size_t> m_groupIndices;
+
+	// indices of the groups with entities in the current pass, in order of first appearance
+	std::vector<std::size_t> m_passGroups;
+};
+
+#endif
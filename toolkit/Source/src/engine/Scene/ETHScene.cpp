@@ -32,6 +32,8 @@
 
 #include "../Physics/ETHPhysicsSimulator.h"
 
+#include "../Util/ETHAllocationTracker.h"
+
 #include "../../addons/scriptbuilder.h"
 
 #include <Math/Randomizer.h>
@@ -51,8 +53,8 @@ ETHScene::ETHScene(
 	ETHEntityCache& entityCache,
 	const Vector2& v2BucketSize) :
 	m_renderingManager(provider),
-	m_buckets(provider, v2BucketSize, true),
-	m_activeEntityHandler(provider),
+	m_buckets(provider, m_scratch, v2BucketSize, true),
+	m_activeEntityHandler(provider, pContext),
 	m_physicsSimulator(provider->GetGlobalScaleManager(), provider->GetVideo()->GetFPSRate())
 {
 	Init(provider, props, pModule, pContext);
@@ -66,8 +68,8 @@ ETHScene::ETHScene(
 	asIScriptContext *pContext,
 	const Vector2 &v2BucketSize) :
 	m_renderingManager(provider),
-	m_buckets(provider, v2BucketSize, true),
-	m_activeEntityHandler(provider),
+	m_buckets(provider, m_scratch, v2BucketSize, true),
+	m_activeEntityHandler(provider, pContext),
 	m_physicsSimulator(provider->GetGlobalScaleManager(), provider->GetVideo()->GetFPSRate())
 {
 	Init(provider, props, pModule, pContext);
@@ -83,6 +85,7 @@ ETHScene::~ETHScene()
 	m_persistentEntities.clear();
 
 	m_renderingManager.ReleaseMappedPieces();
+	m_renderingManager.ClearStaticCache();
 }
 
 void ETHScene::Init(ETHResourceProviderPtr provider, const ETHSceneProperties& props, asIScriptModule *pModule, asIScriptContext *pContext)
@@ -210,6 +213,8 @@ bool ETHScene::ReadFromXMLFile(
 
 	TiXmlNode *pNode = pRoot->FirstChild(GS_L("EntitiesInScene"));
 
+	// build the broad-phase tree once for the whole scene instead of inserting body by body
+	m_physicsSimulator.BeginBulkLoad();
 	if (pNode)
 	{
 		TiXmlElement *pEntities = pNode->ToElement();
@@ -249,6 +254,7 @@ bool ETHScene::ReadFromXMLFile(
 			}
 		}
 	}
+	m_physicsSimulator.EndBulkLoad();
 	m_provider->GetShaderManager()->SetParallaxIntensity(m_sceneProps.parallaxIntensity);
 
 	if (!ss.str().empty())
@@ -461,13 +467,24 @@ void ETHScene::Update(
 	const ETHBackBufferTargetManagerPtr& backBuffer,
 	asIScriptFunction* onUpdateCallbackFunction)
 {
-	m_physicsSimulator.Update(lastFrameElapsedTime);
+	m_scratch.Reset();
+
+	{
+		ETH_ALLOCATION_SCOPE(PHYSICS);
+		m_physicsSimulator.Update(lastFrameElapsedTime, m_provider->GetVideo());
+	}
+
+	// particle systems of always active entities sleep while their buckets are out of sight
+	Vector2 minVisibleBucket, maxVisibleBucket;
+	GetCurrentlyVisibleBucketRange(minVisibleBucket, maxVisibleBucket, backBuffer);
 
 	// update entities that are always active (dynamic entities with callback or physics and temporary entities)
 	m_activeEntityHandler.UpdateAlwaysActiveEntities(
 		GetZAxisDirection(),
 		m_buckets,
-		lastFrameElapsedTime * m_physicsSimulator.GetTimeStepScale());
+		lastFrameElapsedTime * m_physicsSimulator.GetTimeStepScale(),
+		minVisibleBucket,
+		maxVisibleBucket);
 
 	// Run onSceneUpdate functon
 	if (onUpdateCallbackFunction)
@@ -514,13 +531,23 @@ void ETHScene::RenderScene(const bool roundUp, const ETHBackBufferTargetManagerP
 	video->RoundUpPosition(false);
 }
 
-void ETHScene::FillCurrentlyVisibleBucketList(std::list<Vector2>& bucketList, const ETHBackBufferTargetManagerPtr& backBuffer)
+ETHSpan<Vector2> ETHScene::GetCurrentlyVisibleBuckets(const ETHBackBufferTargetManagerPtr& backBuffer)
 {
 	const VideoPtr& video = m_provider->GetVideo();
 	const Vector2 clearence(GetBucketSize() * m_bucketClearenceFactor);
 	const Vector2 min(video->GetCameraPos() - clearence);
 	const Vector2 max(backBuffer->GetBufferSize() + (clearence * 2.0f));
-	m_buckets.GetIntersectingBuckets(bucketList, min, max, IsDrawingBorderBuckets(), IsDrawingBorderBuckets());
+	return m_buckets.GetIntersectingBuckets(min, max, IsDrawingBorderBuckets(), IsDrawingBorderBuckets());
+}
+
+void ETHScene::GetCurrentlyVisibleBucketRange(Vector2& outMinBucket, Vector2& outMaxBucket, const ETHBackBufferTargetManagerPtr& backBuffer) const
+{
+	const VideoPtr& video = m_provider->GetVideo();
+	const Vector2 clearence(GetBucketSize() * m_bucketClearenceFactor);
+	const Vector2 min(video->GetCameraPos() - clearence);
+	const Vector2 max(backBuffer->GetBufferSize() + (clearence * 2.0f));
+	ETHBucketManager::GetIntersectingBucketRange(
+		outMinBucket, outMaxBucket, min, max, GetBucketSize(), IsDrawingBorderBuckets(), IsDrawingBorderBuckets());
 }
 
 void ETHScene::MapEntitiesToBeRendered(
@@ -539,31 +566,53 @@ void ETHScene::MapEntitiesToBeRendered(
 	assert(bucketSize.x != 0 || bucketSize.y != 0);
 
 	// Gets the list of visible buckets
-	std::list<Vector2> bucketList;
-	FillCurrentlyVisibleBucketList(bucketList, backBuffer);
+	ETHScratchArena::Scope scratchScope(m_scratch);
+	const ETHSpan<Vector2> bucketList = GetCurrentlyVisibleBuckets(backBuffer);
 
 	assert(m_activeEntityHandler.IsCallbackListEmpty());
 
+	// Static entities keep their sprite and halo pieces cached per bucket. Buckets are only
+	// split again when entities enter or leave them, or when a static entity changes
+	m_renderingManager.BeginStaticMapping(bucketList, backBuffer, m_sceneProps);
+	m_mappedBuckets.clear();
+
 	// Loop through all visible Buckets
-	for (std::list<Vector2>::iterator bucketPositionIter = bucketList.begin(); bucketPositionIter != bucketList.end(); ++bucketPositionIter)
+	for (ETHSpan<Vector2>::const_iterator bucketPositionIter = bucketList.begin(); bucketPositionIter != bucketList.end(); ++bucketPositionIter)
 	{
 		ETHBucketMap::iterator bucketIter = m_buckets.Find(*bucketPositionIter);
 
 		if (bucketIter == m_buckets.GetLastBucket())
 			continue;
 
-		ETHEntityList& entityList = bucketIter->second;
-		if (entityList.empty())
-			continue;
+		const ETHStaticRenderCache::BUCKET& bucket = m_renderingManager.ValidateStaticBucket(
+			*bucketPositionIter,
+			bucketIter->second,
+			m_buckets.GetBucketRevision(*bucketPositionIter));
 
-		ETHEntityList::const_iterator iEnd = entityList.end();
-		for (ETHEntityList::iterator iter = entityList.begin(); iter != iEnd; ++iter)
+		// update scene bounding for depth buffer
+		if (!bucket.statics.empty())
 		{
-			ETHRenderEntity *entity = (*iter);
+			maxHeight = Max(maxHeight, bucket.maxHeight);
+			minHeight = Min(minHeight, bucket.minHeight);
+		}
 
-			// update scene bounding for depth buffer
-			maxHeight = Max(maxHeight, entity->GetMaxHeight());
-			minHeight = Min(minHeight, entity->GetMinHeight());
+		for (std::size_t t = 0; t < bucket.dynamics.size(); t++)
+		{
+			maxHeight = Max(maxHeight, bucket.dynamics[t]->GetMaxHeight());
+			minHeight = Min(minHeight, bucket.dynamics[t]->GetMinHeight());
+		}
+		m_mappedBuckets.push_back(&bucket);
+	}
+
+	m_renderingManager.EndStaticMapping(backBuffer, m_sceneProps, minHeight, maxHeight);
+
+	for (std::size_t b = 0; b < m_mappedBuckets.size(); b++)
+	{
+		const ETHStaticRenderCache::BUCKET& bucket = *m_mappedBuckets[b];
+
+		for (std::size_t t = 0; t < bucket.dynamics.size(); t++)
+		{
+			ETHRenderEntity *entity = bucket.dynamics[t];
 
 			if (entity->IsHidden())
 				continue;
@@ -575,6 +624,21 @@ void ETHScene::MapEntitiesToBeRendered(
 
 			m_nRenderedEntities++;
 		}
+
+		// static entities only need per-frame work for particles, callbacks and lights
+		for (std::size_t t = 0; t < bucket.updatable.size(); t++)
+		{
+			m_activeEntityHandler.AddStaticCallbackWhenEligible(bucket.updatable[t]);
+		}
+		for (std::size_t t = 0; t < bucket.particles.size(); t++)
+		{
+			m_renderingManager.AddParticlePieces(bucket.particles[t], minHeight, maxHeight);
+		}
+		for (std::size_t t = 0; t < bucket.lights.size(); t++)
+		{
+			m_renderingManager.AddEntityLight(bucket.lights[t], m_sceneProps);
+		}
+		m_nRenderedEntities += static_cast<int>(bucket.numVisibleStatics);
 	}
 
 	// Add persistent entities (the ones the user wants to force to render)
@@ -654,13 +718,13 @@ bool ETHScene::DrawBucketOutlines(const ETHBackBufferTargetManagerPtr& backBuffe
 	const VideoPtr& video = m_provider->GetVideo();
 
 	// Gets the list of visible buckets
-	std::list<Vector2> bucketList;
-	FillCurrentlyVisibleBucketList(bucketList, backBuffer);
+	ETHScratchArena::Scope scratchScope(m_scratch);
+	const ETHSpan<Vector2> bucketList = GetCurrentlyVisibleBuckets(backBuffer);
 
 	int nVisibleBuckets = 0;
 
 	// Loop through all visible Buckets
-	for (std::list<Vector2>::iterator bucketPositionIter = bucketList.begin(); bucketPositionIter != bucketList.end(); ++bucketPositionIter)
+	for (ETHSpan<Vector2>::const_iterator bucketPositionIter = bucketList.begin(); bucketPositionIter != bucketList.end(); ++bucketPositionIter)
 	{
 		nVisibleBuckets++;
 
@@ -702,21 +766,82 @@ int ETHScene::GetNumRenderedEntities()
 	return m_nRenderedEntities;
 }
 
+std::size_t ETHScene::GetFrameScratchWatermark() const
+{
+	return m_scratch.GetFrameWatermark();
+}
+
+std::size_t ETHScene::GetScratchHighWatermark() const
+{
+	return m_scratch.GetHighWatermark();
+}
+
 bool ETHScene::AssignCallbackScript(ETHSpriteEntity* entity)
 {
-	asIScriptFunction* callbackId = ETHGlobal::FindCallbackFunction(m_pModule, entity, ETH_CALLBACK_PREFIX, *m_provider->GetLogger());
-	asIScriptFunction* constructorCallback = ETHGlobal::FindCallbackFunction(m_pModule, entity, ETH_CONSTRUCTOR_CALLBACK_PREFIX, *m_provider->GetLogger());
-	AssignControllerToEntity(entity, callbackId, constructorCallback);
+	AssignControllerToEntity(entity, FindEntityCallbacks(entity));
 	return true;
 } 
 
-void ETHScene::AssignControllerToEntity(ETHEntity* entity, asIScriptFunction* callback, asIScriptFunction* constructorCallback)
+const ETHScene::ENTITY_CALLBACKS& ETHScene::FindEntityCallbacks(const ETHSpriteEntity* entity)
+{
+	std::map<str_type::string, ENTITY_CALLBACKS>::iterator iter = m_callbackCache.find(entity->GetEntityName());
+	if (iter != m_callbackCache.end())
+		return iter->second;
+
+	const Platform::Logger& logger = *m_provider->GetLogger();
+	ENTITY_CALLBACKS callbacks;
+	callbacks.callback = ETHGlobal::FindCallbackFunction(m_pModule, entity, ETH_CALLBACK_PREFIX, logger);
+	callbacks.constructorCallback = ETHGlobal::FindCallbackFunction(m_pModule, entity, ETH_CONSTRUCTOR_CALLBACK_PREFIX, logger);
+	callbacks.batchCallback = ETHGlobal::FindCallbackFunction(m_pModule, entity, ETH_BATCH_CALLBACK_PREFIX, logger);
+
+	if (callbacks.batchCallback)
+	{
+		if (!IsValidBatchCallback(callbacks.batchCallback))
+		{
+			ETH_STREAM_DECL(ss) << GS_L("Batch callbacks must be declared as void ") << callbacks.batchCallback->GetName()
+				<< GS_L("(ETHEntityArray@). Ignoring it.");
+			m_provider->Log(ss.str(), Platform::Logger::ERROR);
+			callbacks.batchCallback = 0;
+		}
+		else if (callbacks.callback)
+		{
+			// the batch callback replaces the per-entity one
+			ETH_STREAM_DECL(ss) << GS_L("Both ") << callbacks.callback->GetName() << GS_L(" and ")
+				<< callbacks.batchCallback->GetName() << GS_L(" were declared. Only the batch callback will be called.");
+			m_provider->Log(ss.str(), Platform::Logger::WARNING);
+			callbacks.callback = 0;
+		}
+	}
+	return m_callbackCache[entity->GetEntityName()] = callbacks;
+}
+
+bool ETHScene::IsValidBatchCallback(asIScriptFunction* func) const
 {
-	if (callback || constructorCallback)
+	if (func->GetParamCount() != 1)
+		return false;
+	return (func->GetParamTypeId(0) == m_pModule->GetEngine()->GetTypeIdByDecl("ETHEntityArray@"));
+}
+
+void ETHScene::AssignControllerToEntity(ETHEntity* entity, const ENTITY_CALLBACKS& callbacks)
+{
+	asIScriptFunction* callback = callbacks.callback;
+	asIScriptFunction* constructorCallback = callbacks.constructorCallback;
+	asIScriptFunction* batchCallback = callbacks.batchCallback;
+	if (callback || constructorCallback || batchCallback)
 	{
 		ETHEntityControllerPtr currentController(entity->GetController());
-		ETHEntityControllerPtr newController(new ETHRawEntityController(currentController, m_pContext, callback, constructorCallback));
-		entity->SetController(newController);
+		ETHRawEntityControllerPtr rawController = boost::dynamic_pointer_cast<ETHRawEntityController>(currentController);
+
+		// plain controllers (fresh or recycled by the entity pool) just take the callbacks
+		if (rawController && !dynamic_cast<ETHPhysicsEntityController*>(rawController.get()))
+		{
+			rawController->SetCallbacks(m_pContext, callback, constructorCallback, batchCallback);
+		}
+		else
+		{
+			ETHEntityControllerPtr newController(new ETHRawEntityController(currentController, m_pContext, callback, constructorCallback, batchCallback));
+			entity->SetController(newController);
+		}
 	}
 	if (entity->IsBody())
 	{
@@ -921,6 +1046,20 @@ void ETHScene::ResolveJoints()
 	m_physicsSimulator.ResolveJoints(entities);
 }
 
+unsigned int ETHScene::MergeStaticColliders()
+{
+	ETHEntityArray entities;
+	m_buckets.GetEntityArray(entities);
+	m_physicsSimulator.BeginBulkLoad();
+	const unsigned int numFixtures = m_physicsSimulator.MergeStaticColliders(entities, GetBucketSize());
+	m_physicsSimulator.EndBulkLoad();
+	#if defined(_DEBUG) || defined(DEBUG)
+		ETH_STREAM_DECL(ss) << GS_L("Static colliders merged into ") << numFixtures << GS_L(" fixtures");
+		m_provider->Log(ss.str(), Platform::Logger::INFO);
+	#endif
+	return numFixtures;
+}
+
 bool ETHScene::DeleteEntity(ETHEntity *pEntity)
 {
 	return m_buckets.DeleteEntity(pEntity->GetID(), ETHBucketManager::GetBucket(pEntity->GetPositionXY(), GetBucketSize()));
@@ -951,7 +1090,7 @@ void ETHScene::AddEntityToPersistentList(ETHRenderEntity* entity)
 }
 
 void ETHScene::FillMultimapAndClearPersistenList(
-	const std::list<Vector2>& currentBucketList,
+	const ETHSpan<Vector2>& currentBucketList,
 	const ETHBackBufferTargetManagerPtr& backBuffer)
 {
 	if (m_persistentEntities.empty())
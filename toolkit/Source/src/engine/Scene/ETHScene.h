@@ -35,6 +35,8 @@
 
 #include "../Renderer/ETHEntityRenderingManager.h"
 
+#include <map>
+
 class ETHScene
 {
 public:
@@ -117,6 +119,11 @@ public:
 	float GetMinHeight() const;
 	Vector2 GetBucketSize() const;
 	int GetNumRenderedEntities();
+
+	/// Peak scratch memory used by the last frame and since the scene was created
+	std::size_t GetFrameScratchWatermark() const;
+	std::size_t GetScratchHighWatermark() const;
+
 	void ScaleEntities(const float scale, const bool scalePosition);
 
 	ETHBucketManager& GetBucketManager();
@@ -134,6 +141,7 @@ public:
 	ETHPhysicsSimulator& GetSimulator();
 
 	void ResolveJoints();
+	unsigned int MergeStaticColliders();
 
 	void AddEntityToPersistentList(ETHRenderEntity* entity);
 
@@ -152,12 +160,20 @@ private:
 
 	void DrawEntityMultimap(const bool roundUp, const ETHBackBufferTargetManagerPtr& backBuffer);
 
+	struct ENTITY_CALLBACKS
+	{
+		asIScriptFunction* callback;
+		asIScriptFunction* constructorCallback;
+		asIScriptFunction* batchCallback;
+	};
+
 	bool AssignCallbackScript(ETHSpriteEntity* entity);
+	const ENTITY_CALLBACKS& FindEntityCallbacks(const ETHSpriteEntity* entity);
+	bool IsValidBatchCallback(asIScriptFunction* func) const;
 
 	void AssignControllerToEntity(
 		ETHEntity* entity,
-		asIScriptFunction* callback,
-		asIScriptFunction* constructorCallback);
+		const ENTITY_CALLBACKS& callbacks);
 
 	bool DrawBucketOutlines(const ETHBackBufferTargetManagerPtr& backBuffer);
 	bool ReadFromXMLFile(
@@ -166,24 +182,33 @@ private:
 		ETHEntityCache& entityCache,
 		const str_type::string &entityPath);
 
-	void FillCurrentlyVisibleBucketList(std::list<Vector2>& bucketList, const ETHBackBufferTargetManagerPtr& backBuffer);
+	ETHSpan<Vector2> GetCurrentlyVisibleBuckets(const ETHBackBufferTargetManagerPtr& backBuffer);
+	void GetCurrentlyVisibleBucketRange(Vector2& outMinBucket, Vector2& outMaxBucket, const ETHBackBufferTargetManagerPtr& backBuffer) const;
 
 	void FillMultimapAndClearPersistenList(
-		const std::list<Vector2>& currentBucketList,
+		const ETHSpan<Vector2>& currentBucketList,
 		const ETHBackBufferTargetManagerPtr& backBuffer);
 
 	float ComputeDrawHash(const float entityDepth, const ETHSpriteEntity* entity) const;
+
+	// per-frame temporaries of mapping, culling and bucket queries; must be declared before m_buckets
+	ETHScratchArena m_scratch;
 	ETHBucketManager m_buckets;
 	ETHActiveEntityHandler m_activeEntityHandler;
 
 	std::list<ETHRenderEntity*> m_persistentEntities;
 
 	ETHEntityRenderingManager m_renderingManager;
+	std::vector<const ETHStaticRenderCache::BUCKET*> m_mappedBuckets;
 	ETHResourceProviderPtr m_provider;
 	ETHSceneProperties m_sceneProps;
 	ETHPhysicsSimulator m_physicsSimulator;
 	asIScriptModule *m_pModule;
 	asIScriptContext *m_pContext;
+
+	// callback lookups per entity file, so spawning doesn't go through the module's name search every time
+	std::map<str_type::string, ENTITY_CALLBACKS> m_callbackCache;
+
 	float m_maxSceneHeight, m_minSceneHeight;
 	int m_idCounter;
 	unsigned int m_nCurrentLights;
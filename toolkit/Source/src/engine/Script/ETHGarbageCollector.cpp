@@ -0,0 +1,149 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#include "ETHGarbageCollector.h"
+
+#include <Platform/MonotonicClock.h>
+
+#include <algorithm>
+
+const boost::uint64_t ETHGarbageCollector::DEFAULT_FRAME_BUDGET_US(1000);
+const boost::uint64_t ETHGarbageCollector::MIN_IDLE_TIME_US(1000);
+const float ETHGarbageCollector::MAX_BUDGET_SCALE(4.0f);
+
+ETHGarbageCollector::ETHGarbageCollector() :
+	m_frameBudgetUS(DEFAULT_FRAME_BUDGET_US),
+	m_budgetScale(1.0f),
+	m_currentSize(0),
+	m_lastFrameSize(0),
+	m_totalDestroyed(0),
+	m_totalDetected(0),
+	m_lastFrameSteps(0),
+	m_idleTimeSpentUS(0)
+{
+}
+
+void ETHGarbageCollector::SetFrameBudget(const boost::uint64_t budgetUS)
+{
+	m_frameBudgetUS = budgetUS;
+}
+
+boost::uint64_t ETHGarbageCollector::GetFrameBudget() const
+{
+	return m_frameBudgetUS;
+}
+
+void ETHGarbageCollector::ReadStatistics(asIScriptEngine* engine)
+{
+	engine->GetGCStatistics(&m_currentSize, &m_totalDestroyed, &m_totalDetected);
+}
+
+unsigned int ETHGarbageCollector::RunSteps(asIScriptEngine* engine, const boost::uint64_t budgetUS)
+{
+	const boost::uint64_t start = Platform::MonotonicClock::GetCurrentTimeUS();
+	const bool behind = (m_budgetScale > 1.0f);
+	unsigned int steps = 0;
+	do
+	{
+		const int r = engine->GarbageCollect(asGC_ONE_STEP);
+		++steps;
+
+		// a finished cycle ends the frame's work unless the garbage is piling up
+		if (r < 0 || (r == 0 && !behind))
+			break;
+	} while (Platform::MonotonicClock::GetCurrentTimeUS() - start < budgetUS);
+	return steps;
+}
+
+void ETHGarbageCollector::Update(asIScriptEngine* engine)
+{
+	const boost::uint64_t start = Platform::MonotonicClock::GetCurrentTimeUS();
+
+	ReadStatistics(engine);
+	if (m_currentSize > m_lastFrameSize)
+		m_budgetScale = std::min(m_budgetScale * 1.5f, MAX_BUDGET_SCALE);
+	else
+		m_budgetScale = std::max(m_budgetScale * 0.9f, 1.0f);
+	m_lastFrameSize = m_currentSize;
+
+	const boost::uint64_t budget = static_cast<boost::uint64_t>(static_cast<float>(m_frameBudgetUS) * m_budgetScale);
+	m_lastFrameSteps = RunSteps(engine, budget);
+
+	m_timeHistogram.Add(static_cast<float>(Platform::MonotonicClock::GetCurrentTimeUS() - start) / 1000.0f);
+}
+
+void ETHGarbageCollector::CollectDuringIdleTime(asIScriptEngine* engine, const boost::uint64_t idleTimeUS)
+{
+	// a single step may take a while, so leave short gaps alone rather than risk missing the deadline
+	if (idleTimeUS < MIN_IDLE_TIME_US)
+		return;
+
+	ReadStatistics(engine);
+	if (m_currentSize == 0)
+		return;
+
+	const boost::uint64_t start = Platform::MonotonicClock::GetCurrentTimeUS();
+	RunSteps(engine, idleTimeUS - (MIN_IDLE_TIME_US / 2));
+	m_idleTimeSpentUS += Platform::MonotonicClock::GetCurrentTimeUS() - start;
+	ReadStatistics(engine);
+}
+
+unsigned int ETHGarbageCollector::GetObjectCount() const
+{
+	return m_currentSize;
+}
+
+unsigned int ETHGarbageCollector::GetTotalDestroyed() const
+{
+	return m_totalDestroyed;
+}
+
+unsigned int ETHGarbageCollector::GetTotalDetected() const
+{
+	return m_totalDetected;
+}
+
+unsigned int ETHGarbageCollector::GetLastFrameSteps() const
+{
+	return m_lastFrameSteps;
+}
+
+float ETHGarbageCollector::GetBudgetScale() const
+{
+	return m_budgetScale;
+}
+
+const ETHFrameTimeHistogram& ETHGarbageCollector::GetTimeHistogram() const
+{
+	return m_timeHistogram;
+}
+
+boost::uint64_t ETHGarbageCollector::GetIdleTimeSpentUS() const
+{
+	return m_idleTimeSpentUS;
+}
+
+void ETHGarbageCollector::ResetStats()
+{
+	m_timeHistogram.Reset();
+	m_idleTimeSpentUS = 0;
+}
@@ -0,0 +1,90 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#ifndef ETH_GARBAGE_COLLECTOR_H_
+#define ETH_GARBAGE_COLLECTOR_H_
+
+#include "../Util/ETHFrameTimeHistogram.h"
+
+#include "../../angelscript/include/angelscript.h"
+
+#include <boost/cstdint.hpp>
+
+/**
+ * \brief Spreads the AngelScript garbage collection over frames within a time budget
+ *
+ * Each frame runs incremental collection steps until the frame budget is
+ * spent or the current cycle is over. When the number of objects tracked
+ * by the collector keeps growing from one frame to the next, the budget is
+ * scaled up (up to MAX_BUDGET_SCALE times) and finished cycles are chained
+ * until the collector catches up; it decays back to the base budget once
+ * the garbage stops piling up. Frame time left over before the frame
+ * limiter deadline can be given to the collector as well.
+ */
+class ETHGarbageCollector
+{
+public:
+	static const boost::uint64_t DEFAULT_FRAME_BUDGET_US;
+	static const boost::uint64_t MIN_IDLE_TIME_US;
+	static const float MAX_BUDGET_SCALE;
+
+	ETHGarbageCollector();
+
+	/// Sets the base amount of microseconds the collector may take every frame
+	void SetFrameBudget(const boost::uint64_t budgetUS);
+	boost::uint64_t GetFrameBudget() const;
+
+	/// Runs this frame's share of the collection work
+	void Update(asIScriptEngine* engine);
+
+	/// Spends up to idleTimeUS microseconds of otherwise wasted frame time on collection steps
+	void CollectDuringIdleTime(asIScriptEngine* engine, const boost::uint64_t idleTimeUS);
+
+	/// Tracked objects, destroyed and detected garbage as of the last statistics read
+	unsigned int GetObjectCount() const;
+	unsigned int GetTotalDestroyed() const;
+	unsigned int GetTotalDetected() const;
+
+	unsigned int GetLastFrameSteps() const;
+	float GetBudgetScale() const;
+
+	/// Time spent by Update on each frame, in milliseconds. Idle time collection is not included
+	const ETHFrameTimeHistogram& GetTimeHistogram() const;
+	boost::uint64_t GetIdleTimeSpentUS() const;
+	void ResetStats();
+
+private:
+	unsigned int RunSteps(asIScriptEngine* engine, const boost::uint64_t budgetUS);
+	void ReadStatistics(asIScriptEngine* engine);
+
+	boost::uint64_t m_frameBudgetUS;
+	float m_budgetScale;
+	asUINT m_currentSize;
+	asUINT m_lastFrameSize;
+	asUINT m_totalDestroyed;
+	asUINT m_totalDetected;
+	unsigned int m_lastFrameSteps;
+	boost::uint64_t m_idleTimeSpentUS;
+	ETHFrameTimeHistogram m_timeHistogram;
+};
+
+#endif
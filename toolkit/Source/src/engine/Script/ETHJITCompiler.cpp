@@ -0,0 +1,1001 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#include "ETHJITCompiler.h"
+
+#include <Types.h>
+
+#include <vector>
+#include <cstring>
+#include <cstddef>
+
+#ifdef ETH_JIT_X64
+ #include "../../angelscript/source/as_context.h"
+ #include "../../angelscript/source/as_callfunc.h"
+ #ifdef _WIN32
+  #include <windows.h>
+ #else
+  #include <sys/mman.h>
+  #include <unistd.h>
+ #endif
+#endif
+
+#ifdef ETH_JIT_X64
+
+enum X64_REGISTER
+{
+	RAX = 0,
+	RCX = 1,
+	RDX = 2,
+	RBX = 3,
+	RSP = 4,
+	RBP = 5,
+	RSI = 6,
+	RDI = 7
+};
+
+// SSE registers share the same numbering
+enum X64_SSE_REGISTER
+{
+	XMM0 = 0,
+	XMM1 = 1,
+	XMM2 = 2
+};
+
+enum X64_CONDITION
+{
+	CC_ALWAYS = 0x00,
+	CC_B  = 0x82,
+	CC_E  = 0x84,
+	CC_NE = 0x85,
+	CC_A  = 0x87,
+	CC_S  = 0x88,
+	CC_NS = 0x89,
+	CC_P  = 0x8A,
+	CC_NP = 0x8B,
+	CC_L  = 0x8C,
+	CC_GE = 0x8D,
+	CC_LE = 0x8E,
+	CC_G  = 0x8F
+};
+
+/*
+ * Minimal encoder for the handful of instruction forms the translator needs.
+ * Memory operands are always [base + disp32] with RBX or RBP as base, so no SIB byte is ever required
+ */
+class ETHX64Assembler
+{
+public:
+	std::vector<unsigned char> code;
+
+	std::size_t GetPosition() const
+	{
+		return code.size();
+	}
+
+	void Byte(const unsigned char b)
+	{
+		code.push_back(b);
+	}
+
+	void Int32(const asDWORD v)
+	{
+		for (unsigned int t = 0; t < 4; t++)
+			Byte(static_cast<unsigned char>(v >> (t * 8)));
+	}
+
+	void Int64(const asQWORD v)
+	{
+		for (unsigned int t = 0; t < 8; t++)
+			Byte(static_cast<unsigned char>(v >> (t * 8)));
+	}
+
+	// op reg, [base + disp32]
+	void Mem(const unsigned char prefix, const bool wide, const unsigned char op0, const int op1, const int reg, const int base, const int disp)
+	{
+		if (prefix)
+			Byte(prefix);
+		if (wide)
+			Byte(0x48);
+		Byte(op0);
+		if (op1 >= 0)
+			Byte(static_cast<unsigned char>(op1));
+		Byte(static_cast<unsigned char>(0x80 | ((reg & 7) << 3) | (base & 7)));
+		Int32(static_cast<asDWORD>(disp));
+	}
+
+	// op reg, rm
+	void Reg(const unsigned char prefix, const bool wide, const unsigned char op0, const int op1, const int reg, const int rm)
+	{
+		if (prefix)
+			Byte(prefix);
+		if (wide)
+			Byte(0x48);
+		Byte(op0);
+		if (op1 >= 0)
+			Byte(static_cast<unsigned char>(op1));
+		Byte(static_cast<unsigned char>(0xC0 | ((reg & 7) << 3) | (rm & 7)));
+	}
+
+	void MovImm32(const int reg, const asDWORD value)
+	{
+		Byte(static_cast<unsigned char>(0xB8 + reg));
+		Int32(value);
+	}
+
+	void MovImm64(const int reg, const asQWORD value)
+	{
+		Byte(0x48);
+		Byte(static_cast<unsigned char>(0xB8 + reg));
+		Int64(value);
+	}
+
+	// returns the position of the rel32 field
+	std::size_t Jump(const X64_CONDITION cc)
+	{
+		if (cc == CC_ALWAYS)
+		{
+			Byte(0xE9);
+		}
+		else
+		{
+			Byte(0x0F);
+			Byte(static_cast<unsigned char>(cc));
+		}
+		const std::size_t pos = GetPosition();
+		Int32(0);
+		return pos;
+	}
+
+	// short conditional jump over the next 'distance' bytes
+	void JumpShort(const X64_CONDITION cc, const unsigned char distance)
+	{
+		Byte(static_cast<unsigned char>(cc - 0x10));
+		Byte(distance);
+	}
+
+	void Patch(const std::size_t rel32Pos, const std::size_t target)
+	{
+		const asDWORD rel = static_cast<asDWORD>(static_cast<int>(target) - static_cast<int>(rel32Pos + 4));
+		for (unsigned int t = 0; t < 4; t++)
+			code[rel32Pos + t] = static_cast<unsigned char>(rel >> (t * 8));
+	}
+};
+
+/*
+ * Called from the native code for asBC_CALLSYS. Application registered functions go through
+ * the same dispatcher the interpreter uses, so every calling convention (generic ones included)
+ * reads its arguments from the script stack and leaves its result in the registers as usual.
+ * Returns non-zero when the native code must hand over to the interpreter
+ */
+static int ETHJITCallSystemFunction(asSVMRegisters* registers, asDWORD* byteCode)
+{
+	asCContext* context = static_cast<asCContext*>(registers->ctx);
+	registers->programPointer = byteCode;
+	registers->stackPointer += CallSystemFunction(asBC_INTARG(byteCode), context, 0);
+
+	if (!registers->doProcessSuspend)
+		return 0;
+
+	// an exception stops the context by itself; a suspend request takes effect right after the call
+	if (context->m_doSuspend && context->m_status == asEXECUTION_ACTIVE)
+		context->m_status = asEXECUTION_SUSPENDED;
+	return 1;
+}
+
+class ETHBytecodeTranslator
+{
+public:
+	ETHBytecodeTranslator(asDWORD* byteCode, const asUINT length);
+
+	bool Translate();
+	const std::vector<unsigned char>& GetCode() const;
+	void EnableEntries(const unsigned char* nativeCode);
+
+private:
+	struct PENDING_JUMP
+	{
+		std::size_t rel32Pos;
+		asUINT target;
+	};
+
+	static int VarDisp(const short var);
+	static int RegDisp(const std::size_t offset);
+
+	bool TranslateInstruction(const asUINT pos);
+	void EmitExit(const asUINT pos);
+	void AddExit(const std::size_t rel32Pos, const asUINT pos);
+	void AddJump(const std::size_t rel32Pos, const asUINT target);
+
+	void LoadVar(const int reg, const short var, const bool wide = false);
+	void StoreVar(const int reg, const short var, const bool wide = false);
+	void PushSlot(const int dwords);
+	void IntArithmetic(const asDWORD* bc, const bool wide, const unsigned char op0, const int op1);
+	void IntCompareResult(const bool isUnsigned);
+	void FloatCompareResult();
+	void TestResult(const X64_CONDITION cc);
+
+	asDWORD* m_byteCode;
+	asUINT m_length;
+	ETHX64Assembler m_asm;
+	std::vector<std::size_t> m_labels;
+	std::vector<bool> m_translated;
+	std::vector<PENDING_JUMP> m_jumps;
+	std::vector<PENDING_JUMP> m_exits;
+	std::size_t m_epilogue;
+};
+
+ETHBytecodeTranslator::ETHBytecodeTranslator(asDWORD* byteCode, const asUINT length) :
+	m_byteCode(byteCode),
+	m_length(length),
+	m_labels(length + 1, 0),
+	m_translated(length + 1, false),
+	m_epilogue(0)
+{
+}
+
+int ETHBytecodeTranslator::VarDisp(const short var)
+{
+	return -4 * static_cast<int>(var);
+}
+
+int ETHBytecodeTranslator::RegDisp(const std::size_t offset)
+{
+	return static_cast<int>(offset);
+}
+
+void ETHBytecodeTranslator::LoadVar(const int reg, const short var, const bool wide)
+{
+	m_asm.Mem(0, wide, 0x8B, -1, reg, RBP, VarDisp(var));
+}
+
+void ETHBytecodeTranslator::StoreVar(const int reg, const short var, const bool wide)
+{
+	m_asm.Mem(0, wide, 0x89, -1, reg, RBP, VarDisp(var));
+}
+
+// reserves 'dwords' on the script stack and leaves its new top in rcx
+void ETHBytecodeTranslator::PushSlot(const int dwords)
+{
+	const int stackPointer = RegDisp(offsetof(asSVMRegisters, stackPointer));
+	m_asm.Mem(0, true, 0x8B, -1, RCX, RBX, stackPointer);
+	m_asm.Reg(0, true, 0x83, -1, 5, RCX); // sub rcx, imm8
+	m_asm.Byte(static_cast<unsigned char>(dwords * 4));
+	m_asm.Mem(0, true, 0x89, -1, RCX, RBX, stackPointer);
+}
+
+void ETHBytecodeTranslator::AddExit(const std::size_t rel32Pos, const asUINT pos)
+{
+	PENDING_JUMP exit = { rel32Pos, pos };
+	m_exits.push_back(exit);
+}
+
+void ETHBytecodeTranslator::AddJump(const std::size_t rel32Pos, const asUINT target)
+{
+	PENDING_JUMP jump = { rel32Pos, target };
+	m_jumps.push_back(jump);
+}
+
+void ETHBytecodeTranslator::EmitExit(const asUINT pos)
+{
+	// hand the instruction at 'pos' over to the interpreter
+	m_asm.MovImm64(RAX, reinterpret_cast<asQWORD>(m_byteCode + pos));
+	m_asm.Patch(m_asm.Jump(CC_ALWAYS), m_epilogue);
+}
+
+// dst = a (op) b
+void ETHBytecodeTranslator::IntArithmetic(const asDWORD* bc, const bool wide, const unsigned char op0, const int op1)
+{
+	LoadVar(RAX, asBC_SWORDARG1(bc), wide);
+	m_asm.Mem(0, wide, op0, op1, RAX, RBP, VarDisp(asBC_SWORDARG2(bc)));
+	StoreVar(RAX, asBC_SWORDARG0(bc), wide);
+}
+
+// valueRegister = (a > b) - (a < b), flags already set by a cmp
+void ETHBytecodeTranslator::IntCompareResult(const bool isUnsigned)
+{
+	m_asm.Reg(0, false, 0x0F, isUnsigned ? 0x97 : 0x9F, 0, RCX); // seta/setg cl
+	m_asm.Reg(0, false, 0x0F, isUnsigned ? 0x92 : 0x9C, 0, RDX); // setb/setl dl
+	m_asm.Reg(0, false, 0x0F, 0xB6, RCX, RCX); // movzx ecx, cl
+	m_asm.Reg(0, false, 0x0F, 0xB6, RDX, RDX); // movzx edx, dl
+	m_asm.Reg(0, false, 0x29, -1, RDX, RCX);   // sub ecx, edx
+	m_asm.Mem(0, false, 0x89, -1, RCX, RBX, RegDisp(offsetof(asSVMRegisters, valueRegister)));
+}
+
+// same as the interpreter: equal is 0, less is -1, anything else (including NaN) is 1
+void ETHBytecodeTranslator::FloatCompareResult()
+{
+	m_asm.MovImm32(RCX, 1);
+	m_asm.JumpShort(CC_P, 19);
+	m_asm.MovImm32(RCX, 0);
+	m_asm.JumpShort(CC_E, 12);
+	m_asm.MovImm32(RCX, static_cast<asDWORD>(-1));
+	m_asm.JumpShort(CC_B, 5);
+	m_asm.MovImm32(RCX, 1);
+	m_asm.Mem(0, false, 0x89, -1, RCX, RBX, RegDisp(offsetof(asSVMRegisters, valueRegister)));
+}
+
+// valueRegister = (valueRegister (cc) 0) as a full 64-bit boolean
+void ETHBytecodeTranslator::TestResult(const X64_CONDITION cc)
+{
+	const int valueRegister = RegDisp(offsetof(asSVMRegisters, valueRegister));
+	m_asm.Mem(0, false, 0x8B, -1, RAX, RBX, valueRegister);
+	m_asm.Reg(0, false, 0x85, -1, RAX, RAX); // test eax, eax
+	m_asm.Reg(0, false, 0x0F, cc + 0x10, 0, RCX); // setcc cl
+	m_asm.Reg(0, false, 0x0F, 0xB6, RCX, RCX); // movzx ecx, cl
+	m_asm.Mem(0, true, 0x89, -1, RCX, RBX, valueRegister);
+}
+
+bool ETHBytecodeTranslator::TranslateInstruction(const asUINT pos)
+{
+	const asDWORD* bc = m_byteCode + pos;
+	const asEBCInstr op = static_cast<asEBCInstr>(*reinterpret_cast<const asBYTE*>(bc));
+	const asUINT next = pos + asBCTypeSize[asBCInfo[op].type];
+	const int valueRegister = RegDisp(offsetof(asSVMRegisters, valueRegister));
+
+	switch (op)
+	{
+	case asBC_JitEntry:
+		break;
+
+	case asBC_SUSPEND:
+		// let the interpreter deal with line callbacks and suspend requests
+		m_asm.Mem(0, false, 0x80, -1, 7, RBX, RegDisp(offsetof(asSVMRegisters, doProcessSuspend)));
+		m_asm.Byte(0);
+		AddExit(m_asm.Jump(CC_NE), pos);
+		break;
+
+	// branches
+	case asBC_JMP:
+		AddJump(m_asm.Jump(CC_ALWAYS), next + asBC_INTARG(bc));
+		break;
+	case asBC_JZ:
+	case asBC_JNZ:
+	case asBC_JS:
+	case asBC_JNS:
+	case asBC_JP:
+	case asBC_JNP:
+		{
+			X64_CONDITION cc = CC_E;
+			switch (op)
+			{
+			case asBC_JNZ: cc = CC_NE; break;
+			case asBC_JS:  cc = CC_S;  break;
+			case asBC_JNS: cc = CC_NS; break;
+			case asBC_JP:  cc = CC_G;  break;
+			case asBC_JNP: cc = CC_LE; break;
+			default: break;
+			}
+			m_asm.Mem(0, false, 0x8B, -1, RAX, RBX, valueRegister);
+			m_asm.Reg(0, false, 0x85, -1, RAX, RAX);
+			AddJump(m_asm.Jump(cc), next + asBC_INTARG(bc));
+		}
+		break;
+
+	// tests
+	case asBC_TZ:  TestResult(CC_E);  break;
+	case asBC_TNZ: TestResult(CC_NE); break;
+	case asBC_TS:  TestResult(CC_S);  break;
+	case asBC_TNS: TestResult(CC_NS); break;
+	case asBC_TP:  TestResult(CC_G);  break;
+	case asBC_TNP: TestResult(CC_LE); break;
+
+	case asBC_NOT:
+		m_asm.Mem(0, false, 0x80, -1, 7, RBP, VarDisp(asBC_SWORDARG0(bc)));
+		m_asm.Byte(0);
+		m_asm.Reg(0, false, 0x0F, 0x94, 0, RAX); // sete al
+		m_asm.Reg(0, false, 0x0F, 0xB6, RAX, RAX);
+		StoreVar(RAX, asBC_SWORDARG0(bc));
+		break;
+
+	// comparisons
+	case asBC_CMPi:
+	case asBC_CMPu:
+		LoadVar(RAX, asBC_SWORDARG0(bc));
+		m_asm.Mem(0, false, 0x3B, -1, RAX, RBP, VarDisp(asBC_SWORDARG1(bc)));
+		IntCompareResult(op == asBC_CMPu);
+		break;
+	case asBC_CMPi64:
+	case asBC_CMPu64:
+		LoadVar(RAX, asBC_SWORDARG0(bc), true);
+		m_asm.Mem(0, true, 0x3B, -1, RAX, RBP, VarDisp(asBC_SWORDARG1(bc)));
+		IntCompareResult(op == asBC_CMPu64);
+		break;
+	case asBC_CMPIi:
+	case asBC_CMPIu:
+		LoadVar(RAX, asBC_SWORDARG0(bc));
+		m_asm.Byte(0x3D); // cmp eax, imm32
+		m_asm.Int32(asBC_DWORDARG(bc));
+		IntCompareResult(op == asBC_CMPIu);
+		break;
+	case asBC_CMPf:
+		m_asm.Mem(0xF3, false, 0x0F, 0x10, XMM0, RBP, VarDisp(asBC_SWORDARG0(bc)));
+		m_asm.Mem(0, false, 0x0F, 0x2E, XMM0, RBP, VarDisp(asBC_SWORDARG1(bc))); // ucomiss
+		FloatCompareResult();
+		break;
+	case asBC_CMPd:
+		m_asm.Mem(0xF2, false, 0x0F, 0x10, XMM0, RBP, VarDisp(asBC_SWORDARG0(bc)));
+		m_asm.Mem(0x66, false, 0x0F, 0x2E, XMM0, RBP, VarDisp(asBC_SWORDARG1(bc))); // ucomisd
+		FloatCompareResult();
+		break;
+	case asBC_CMPIf:
+		m_asm.Mem(0xF3, false, 0x0F, 0x10, XMM0, RBP, VarDisp(asBC_SWORDARG0(bc)));
+		m_asm.MovImm32(RAX, asBC_DWORDARG(bc));
+		m_asm.Reg(0x66, false, 0x0F, 0x6E, XMM1, RAX); // movd xmm1, eax
+		m_asm.Reg(0, false, 0x0F, 0x2E, XMM0, XMM1);
+		FloatCompareResult();
+		break;
+
+	// variable and register copies
+	case asBC_SetV1:
+	case asBC_SetV2:
+	case asBC_SetV4:
+		m_asm.Mem(0, false, 0xC7, -1, 0, RBP, VarDisp(asBC_SWORDARG0(bc)));
+		m_asm.Int32(asBC_DWORDARG(bc));
+		break;
+	case asBC_SetV8:
+		m_asm.MovImm64(RAX, asBC_QWORDARG(bc));
+		StoreVar(RAX, asBC_SWORDARG0(bc), true);
+		break;
+	case asBC_ClrVPtr:
+		m_asm.Mem(0, true, 0xC7, -1, 0, RBP, VarDisp(asBC_SWORDARG0(bc)));
+		m_asm.Int32(0);
+		break;
+	case asBC_CpyVtoV4:
+		LoadVar(RAX, asBC_SWORDARG1(bc));
+		StoreVar(RAX, asBC_SWORDARG0(bc));
+		break;
+	case asBC_CpyVtoV8:
+		LoadVar(RAX, asBC_SWORDARG1(bc), true);
+		StoreVar(RAX, asBC_SWORDARG0(bc), true);
+		break;
+	case asBC_CpyVtoR4:
+		LoadVar(RAX, asBC_SWORDARG0(bc));
+		m_asm.Mem(0, false, 0x89, -1, RAX, RBX, valueRegister);
+		break;
+	case asBC_CpyVtoR8:
+		LoadVar(RAX, asBC_SWORDARG0(bc), true);
+		m_asm.Mem(0, true, 0x89, -1, RAX, RBX, valueRegister);
+		break;
+	case asBC_CpyRtoV4:
+		m_asm.Mem(0, false, 0x8B, -1, RAX, RBX, valueRegister);
+		StoreVar(RAX, asBC_SWORDARG0(bc));
+		break;
+	case asBC_CpyRtoV8:
+		m_asm.Mem(0, true, 0x8B, -1, RAX, RBX, valueRegister);
+		StoreVar(RAX, asBC_SWORDARG0(bc), true);
+		break;
+
+	// globals, whose addresses are already resolved in the bytecode
+	case asBC_CpyGtoV4:
+		m_asm.MovImm64(RCX, asBC_PTRARG(bc));
+		m_asm.Byte(0x8B);
+		m_asm.Byte(0x01); // mov eax, [rcx]
+		StoreVar(RAX, asBC_SWORDARG0(bc));
+		break;
+	case asBC_CpyVtoG4:
+		m_asm.MovImm64(RCX, asBC_PTRARG(bc));
+		LoadVar(RAX, asBC_SWORDARG0(bc));
+		m_asm.Byte(0x89);
+		m_asm.Byte(0x01); // mov [rcx], eax
+		break;
+	case asBC_SetG4:
+		m_asm.MovImm64(RCX, asBC_PTRARG(bc));
+		m_asm.Byte(0xC7);
+		m_asm.Byte(0x01); // mov dword [rcx], imm32
+		m_asm.Int32(asBC_DWORDARG(bc + AS_PTR_SIZE));
+		break;
+	case asBC_LdGRdR4:
+		m_asm.MovImm64(RCX, asBC_PTRARG(bc));
+		m_asm.Mem(0, true, 0x89, -1, RCX, RBX, valueRegister);
+		m_asm.Byte(0x8B);
+		m_asm.Byte(0x01); // mov eax, [rcx]
+		StoreVar(RAX, asBC_SWORDARG0(bc));
+		break;
+
+	// arguments pushed onto the script stack
+	case asBC_PshC4:
+		PushSlot(1);
+		m_asm.Byte(0xC7);
+		m_asm.Byte(0x01); // mov dword [rcx], imm32
+		m_asm.Int32(asBC_DWORDARG(bc));
+		break;
+	case asBC_PshV4:
+		PushSlot(1);
+		LoadVar(RAX, asBC_SWORDARG0(bc));
+		m_asm.Byte(0x89);
+		m_asm.Byte(0x01); // mov [rcx], eax
+		break;
+	case asBC_PshC8:
+	case asBC_PshV8:
+	case asBC_PshVPtr:
+	case asBC_PshNull:
+	case asBC_PSF:
+	case asBC_PGA:
+		PushSlot(2);
+		switch (op)
+		{
+		case asBC_PshC8:
+			m_asm.MovImm64(RAX, asBC_QWORDARG(bc));
+			break;
+		case asBC_PshNull:
+			m_asm.Reg(0, false, 0x33, -1, RAX, RAX); // xor eax, eax
+			break;
+		case asBC_PSF:
+			m_asm.Mem(0, true, 0x8D, -1, RAX, RBP, VarDisp(asBC_SWORDARG0(bc))); // lea rax, var
+			break;
+		case asBC_PGA:
+			m_asm.MovImm64(RAX, asBC_PTRARG(bc));
+			break;
+		default:
+			LoadVar(RAX, asBC_SWORDARG0(bc), true);
+			break;
+		}
+		m_asm.Byte(0x48);
+		m_asm.Byte(0x89);
+		m_asm.Byte(0x01); // mov [rcx], rax
+		break;
+	case asBC_PopPtr:
+		m_asm.Mem(0, true, 0x83, -1, 0, RBX, RegDisp(offsetof(asSVMRegisters, stackPointer)));
+		m_asm.Byte(AS_PTR_SIZE * 4); // add qword [rbx + stackPointer], imm8
+		break;
+
+	// application registered functions
+	case asBC_CALLSYS:
+		#ifdef _WIN32
+		 m_asm.Reg(0, true, 0x89, -1, RBX, RCX);
+		 m_asm.MovImm64(RDX, reinterpret_cast<asQWORD>(bc));
+		#else
+		 m_asm.Reg(0, true, 0x89, -1, RBX, RDI);
+		 m_asm.MovImm64(RSI, reinterpret_cast<asQWORD>(bc));
+		#endif
+		m_asm.MovImm64(RAX, reinterpret_cast<asQWORD>(&ETHJITCallSystemFunction));
+		m_asm.Reg(0, false, 0xFF, -1, 2, RAX); // call rax
+		m_asm.Reg(0, false, 0x85, -1, RAX, RAX);
+		AddExit(m_asm.Jump(CC_NE), next);
+		break;
+
+	// memory pointed by the value register
+	case asBC_LDV:
+		m_asm.Mem(0, true, 0x8D, -1, RAX, RBP, VarDisp(asBC_SWORDARG0(bc))); // lea rax, var
+		m_asm.Mem(0, true, 0x89, -1, RAX, RBX, valueRegister);
+		break;
+	case asBC_RDR4:
+		m_asm.Mem(0, true, 0x8B, -1, RCX, RBX, valueRegister);
+		m_asm.Byte(0x8B);
+		m_asm.Byte(0x01); // mov eax, [rcx]
+		StoreVar(RAX, asBC_SWORDARG0(bc));
+		break;
+	case asBC_WRTV4:
+		m_asm.Mem(0, true, 0x8B, -1, RCX, RBX, valueRegister);
+		LoadVar(RAX, asBC_SWORDARG0(bc));
+		m_asm.Byte(0x89);
+		m_asm.Byte(0x01); // mov [rcx], eax
+		break;
+	case asBC_INCi:
+	case asBC_DECi:
+		m_asm.Mem(0, true, 0x8B, -1, RCX, RBX, valueRegister);
+		m_asm.Byte(0xFF);
+		m_asm.Byte(op == asBC_INCi ? 0x01 : 0x09); // inc/dec dword [rcx]
+		break;
+
+	// integer math
+	case asBC_ADDi:   IntArithmetic(bc, false, 0x03, -1);   break;
+	case asBC_SUBi:   IntArithmetic(bc, false, 0x2B, -1);   break;
+	case asBC_MULi:   IntArithmetic(bc, false, 0x0F, 0xAF); break;
+	case asBC_BAND:   IntArithmetic(bc, false, 0x23, -1);   break;
+	case asBC_BOR:    IntArithmetic(bc, false, 0x0B, -1);   break;
+	case asBC_BXOR:   IntArithmetic(bc, false, 0x33, -1);   break;
+	case asBC_ADDi64: IntArithmetic(bc, true,  0x03, -1);   break;
+	case asBC_SUBi64: IntArithmetic(bc, true,  0x2B, -1);   break;
+	case asBC_MULi64: IntArithmetic(bc, true,  0x0F, 0xAF); break;
+
+	case asBC_DIVi:
+	case asBC_MODi:
+		// division by zero raises a script exception, so the interpreter must run it
+		LoadVar(RCX, asBC_SWORDARG2(bc));
+		m_asm.Reg(0, false, 0x85, -1, RCX, RCX);
+		AddExit(m_asm.Jump(CC_E), pos);
+		LoadVar(RAX, asBC_SWORDARG1(bc));
+		m_asm.Byte(0x99); // cdq
+		m_asm.Reg(0, false, 0xF7, -1, 7, RCX); // idiv ecx
+		StoreVar((op == asBC_DIVi) ? RAX : RDX, asBC_SWORDARG0(bc));
+		break;
+
+	case asBC_BSLL:
+	case asBC_BSRL:
+	case asBC_BSRA:
+		LoadVar(RCX, asBC_SWORDARG2(bc));
+		LoadVar(RAX, asBC_SWORDARG1(bc));
+		m_asm.Reg(0, false, 0xD3, -1, (op == asBC_BSLL) ? 4 : ((op == asBC_BSRL) ? 5 : 7), RAX);
+		StoreVar(RAX, asBC_SWORDARG0(bc));
+		break;
+
+	case asBC_ADDIi:
+	case asBC_SUBIi:
+	case asBC_MULIi:
+		LoadVar(RAX, asBC_SWORDARG1(bc));
+		if (op == asBC_MULIi)
+			m_asm.Reg(0, false, 0x69, -1, RAX, RAX); // imul eax, eax, imm32
+		else
+			m_asm.Byte((op == asBC_ADDIi) ? 0x05 : 0x2D); // add/sub eax, imm32
+		m_asm.Int32(asBC_DWORDARG(bc + 1));
+		StoreVar(RAX, asBC_SWORDARG0(bc));
+		break;
+
+	case asBC_NEGi:
+		m_asm.Mem(0, false, 0xF7, -1, 3, RBP, VarDisp(asBC_SWORDARG0(bc)));
+		break;
+	case asBC_NEGi64:
+		m_asm.Mem(0, true, 0xF7, -1, 3, RBP, VarDisp(asBC_SWORDARG0(bc)));
+		break;
+	case asBC_BNOT:
+		m_asm.Mem(0, false, 0xF7, -1, 2, RBP, VarDisp(asBC_SWORDARG0(bc)));
+		break;
+	case asBC_IncVi:
+		m_asm.Mem(0, false, 0xFF, -1, 0, RBP, VarDisp(asBC_SWORDARG0(bc)));
+		break;
+	case asBC_DecVi:
+		m_asm.Mem(0, false, 0xFF, -1, 1, RBP, VarDisp(asBC_SWORDARG0(bc)));
+		break;
+
+	// floating point math
+	case asBC_ADDf:
+	case asBC_SUBf:
+	case asBC_MULf:
+	case asBC_ADDd:
+	case asBC_SUBd:
+	case asBC_MULd:
+		{
+			const bool isDouble = (op == asBC_ADDd || op == asBC_SUBd || op == asBC_MULd);
+			const unsigned char prefix = isDouble ? 0xF2 : 0xF3;
+			unsigned char opcode = 0x58;
+			if (op == asBC_SUBf || op == asBC_SUBd) opcode = 0x5C;
+			if (op == asBC_MULf || op == asBC_MULd) opcode = 0x59;
+			m_asm.Mem(prefix, false, 0x0F, 0x10, XMM0, RBP, VarDisp(asBC_SWORDARG1(bc)));
+			m_asm.Mem(prefix, false, 0x0F, opcode, XMM0, RBP, VarDisp(asBC_SWORDARG2(bc)));
+			m_asm.Mem(prefix, false, 0x0F, 0x11, XMM0, RBP, VarDisp(asBC_SWORDARG0(bc)));
+		}
+		break;
+	case asBC_DIVf:
+	case asBC_DIVd:
+		{
+			const bool isDouble = (op == asBC_DIVd);
+			const unsigned char prefix = isDouble ? 0xF2 : 0xF3;
+			m_asm.Mem(prefix, false, 0x0F, 0x10, XMM1, RBP, VarDisp(asBC_SWORDARG2(bc)));
+			m_asm.Reg(isDouble ? 0x66 : 0, false, 0x0F, 0x57, XMM2, XMM2); // xorps/xorpd xmm2, xmm2
+			m_asm.Reg(isDouble ? 0x66 : 0, false, 0x0F, 0x2E, XMM1, XMM2); // ucomiss/ucomisd xmm1, xmm2
+
+			// divider == 0 raises a script exception; NaN doesn't
+			m_asm.JumpShort(CC_P, 6);
+			AddExit(m_asm.Jump(CC_E), pos);
+			m_asm.Mem(prefix, false, 0x0F, 0x10, XMM0, RBP, VarDisp(asBC_SWORDARG1(bc)));
+			m_asm.Reg(prefix, false, 0x0F, 0x5E, XMM0, XMM1);
+			m_asm.Mem(prefix, false, 0x0F, 0x11, XMM0, RBP, VarDisp(asBC_SWORDARG0(bc)));
+		}
+		break;
+	case asBC_ADDIf:
+	case asBC_SUBIf:
+	case asBC_MULIf:
+		{
+			unsigned char opcode = 0x58;
+			if (op == asBC_SUBIf) opcode = 0x5C;
+			if (op == asBC_MULIf) opcode = 0x59;
+			m_asm.Mem(0xF3, false, 0x0F, 0x10, XMM0, RBP, VarDisp(asBC_SWORDARG1(bc)));
+			m_asm.MovImm32(RAX, asBC_DWORDARG(bc + 1));
+			m_asm.Reg(0x66, false, 0x0F, 0x6E, XMM1, RAX);
+			m_asm.Reg(0xF3, false, 0x0F, opcode, XMM0, XMM1);
+			m_asm.Mem(0xF3, false, 0x0F, 0x11, XMM0, RBP, VarDisp(asBC_SWORDARG0(bc)));
+		}
+		break;
+	case asBC_NEGf:
+		// flips the sign bit, just like the compiled interpreter does
+		m_asm.Mem(0, false, 0x81, -1, 6, RBP, VarDisp(asBC_SWORDARG0(bc)));
+		m_asm.Int32(0x80000000);
+		break;
+	case asBC_NEGd:
+		m_asm.Mem(0, false, 0x81, -1, 6, RBP, VarDisp(asBC_SWORDARG0(bc)) + 4);
+		m_asm.Int32(0x80000000);
+		break;
+
+	// conversions
+	case asBC_iTOf:
+		m_asm.Mem(0xF3, false, 0x0F, 0x2A, XMM0, RBP, VarDisp(asBC_SWORDARG0(bc)));
+		m_asm.Mem(0xF3, false, 0x0F, 0x11, XMM0, RBP, VarDisp(asBC_SWORDARG0(bc)));
+		break;
+	case asBC_uTOf:
+		LoadVar(RAX, asBC_SWORDARG0(bc)); // zero extends into rax
+		m_asm.Reg(0xF3, true, 0x0F, 0x2A, XMM0, RAX);
+		m_asm.Mem(0xF3, false, 0x0F, 0x11, XMM0, RBP, VarDisp(asBC_SWORDARG0(bc)));
+		break;
+	case asBC_fTOi:
+	case asBC_fTOu:
+		m_asm.Mem(0xF3, false, 0x0F, 0x2C, RAX, RBP, VarDisp(asBC_SWORDARG0(bc)));
+		StoreVar(RAX, asBC_SWORDARG0(bc));
+		break;
+	case asBC_dTOi:
+	case asBC_dTOu:
+		m_asm.Mem(0xF2, false, 0x0F, 0x2C, RAX, RBP, VarDisp(asBC_SWORDARG1(bc)));
+		StoreVar(RAX, asBC_SWORDARG0(bc));
+		break;
+	case asBC_dTOf:
+		m_asm.Mem(0xF2, false, 0x0F, 0x5A, XMM0, RBP, VarDisp(asBC_SWORDARG1(bc)));
+		m_asm.Mem(0xF3, false, 0x0F, 0x11, XMM0, RBP, VarDisp(asBC_SWORDARG0(bc)));
+		break;
+	case asBC_fTOd:
+		m_asm.Mem(0xF3, false, 0x0F, 0x5A, XMM0, RBP, VarDisp(asBC_SWORDARG1(bc)));
+		m_asm.Mem(0xF2, false, 0x0F, 0x11, XMM0, RBP, VarDisp(asBC_SWORDARG0(bc)));
+		break;
+	case asBC_iTOd:
+		m_asm.Mem(0xF2, false, 0x0F, 0x2A, XMM0, RBP, VarDisp(asBC_SWORDARG1(bc)));
+		m_asm.Mem(0xF2, false, 0x0F, 0x11, XMM0, RBP, VarDisp(asBC_SWORDARG0(bc)));
+		break;
+	case asBC_uTOd:
+		LoadVar(RAX, asBC_SWORDARG1(bc));
+		m_asm.Reg(0xF2, true, 0x0F, 0x2A, XMM0, RAX);
+		m_asm.Mem(0xF2, false, 0x0F, 0x11, XMM0, RBP, VarDisp(asBC_SWORDARG0(bc)));
+		break;
+	case asBC_sbTOi:
+	case asBC_swTOi:
+	case asBC_ubTOi:
+	case asBC_uwTOi:
+	case asBC_iTOb:
+	case asBC_iTOw:
+		{
+			int opcode = 0xB6; // movzx eax, byte
+			if (op == asBC_sbTOi) opcode = 0xBE;
+			if (op == asBC_swTOi) opcode = 0xBF;
+			if (op == asBC_uwTOi || op == asBC_iTOw) opcode = 0xB7;
+			m_asm.Mem(0, false, 0x0F, opcode, RAX, RBP, VarDisp(asBC_SWORDARG0(bc)));
+			StoreVar(RAX, asBC_SWORDARG0(bc));
+		}
+		break;
+	case asBC_i64TOi:
+		LoadVar(RAX, asBC_SWORDARG1(bc));
+		StoreVar(RAX, asBC_SWORDARG0(bc));
+		break;
+	case asBC_iTOi64:
+		m_asm.Mem(0, true, 0x63, -1, RAX, RBP, VarDisp(asBC_SWORDARG1(bc))); // movsxd rax, dword
+		StoreVar(RAX, asBC_SWORDARG0(bc), true);
+		break;
+	case asBC_uTOi64:
+		LoadVar(RAX, asBC_SWORDARG1(bc));
+		StoreVar(RAX, asBC_SWORDARG0(bc), true);
+		break;
+
+	default:
+		return false;
+	}
+	return true;
+}
+
+bool ETHBytecodeTranslator::Translate()
+{
+	// prologue: keep the registers in rbx and the stack frame in rbp, then jump to the entry point in jitArg.
+	// The native stack is left 16 byte aligned, with the shadow space Win64 calls expect
+	m_asm.Byte(0x53); // push rbx
+	m_asm.Byte(0x55); // push rbp
+	m_asm.Reg(0, true, 0x83, -1, 5, RSP);
+	m_asm.Byte(40); // sub rsp, 40
+	#ifdef _WIN32
+	 m_asm.Reg(0, true, 0x89, -1, RCX, RBX);
+	 m_asm.Reg(0, true, 0x89, -1, RDX, RAX);
+	#else
+	 m_asm.Reg(0, true, 0x89, -1, RDI, RBX);
+	 m_asm.Reg(0, true, 0x89, -1, RSI, RAX);
+	#endif
+	m_asm.Mem(0, true, 0x8B, -1, RBP, RBX, RegDisp(offsetof(asSVMRegisters, stackFramePointer)));
+	m_asm.Reg(0, false, 0xFF, -1, 4, RAX); // jmp rax
+
+	// epilogue: rax holds the bytecode address where the interpreter resumes
+	m_epilogue = m_asm.GetPosition();
+	m_asm.Mem(0, true, 0x89, -1, RAX, RBX, RegDisp(offsetof(asSVMRegisters, programPointer)));
+	m_asm.Reg(0, true, 0x83, -1, 0, RSP);
+	m_asm.Byte(40); // add rsp, 40
+	m_asm.Byte(0x5D); // pop rbp
+	m_asm.Byte(0x5B); // pop rbx
+	m_asm.Byte(0xC3); // ret
+
+	for (asUINT pos = 0; pos < m_length;)
+	{
+		const asEBCInstr op = static_cast<asEBCInstr>(*reinterpret_cast<const asBYTE*>(m_byteCode + pos));
+		m_labels[pos] = m_asm.GetPosition();
+		m_translated[pos] = TranslateInstruction(pos);
+		if (!m_translated[pos])
+		{
+			EmitExit(pos);
+		}
+		pos += asBCTypeSize[asBCInfo[op].type];
+	}
+	m_labels[m_length] = m_asm.GetPosition();
+
+	for (std::size_t t = 0; t < m_jumps.size(); t++)
+	{
+		m_asm.Patch(m_jumps[t].rel32Pos, m_labels[m_jumps[t].target]);
+	}
+
+	// conditional bailouts share a stub per instruction
+	for (std::size_t t = 0; t < m_exits.size(); t++)
+	{
+		m_asm.Patch(m_exits[t].rel32Pos, m_asm.GetPosition());
+		EmitExit(m_exits[t].target);
+	}
+
+	// worth it only if some entry point is followed by native code
+	bool hasEntries = false;
+	for (asUINT pos = 0; pos < m_length;)
+	{
+		const asEBCInstr op = static_cast<asEBCInstr>(*reinterpret_cast<const asBYTE*>(m_byteCode + pos));
+		const asUINT next = pos + asBCTypeSize[asBCInfo[op].type];
+		if (op == asBC_JitEntry && next < m_length && m_translated[next])
+		{
+			hasEntries = true;
+			break;
+		}
+		pos = next;
+	}
+	return hasEntries;
+}
+
+const std::vector<unsigned char>& ETHBytecodeTranslator::GetCode() const
+{
+	return m_asm.code;
+}
+
+void ETHBytecodeTranslator::EnableEntries(const unsigned char* nativeCode)
+{
+	// the interpreter only calls the JIT function at JitEntry instructions with a non-zero argument
+	for (asUINT pos = 0; pos < m_length;)
+	{
+		const asEBCInstr op = static_cast<asEBCInstr>(*reinterpret_cast<const asBYTE*>(m_byteCode + pos));
+		const asUINT next = pos + asBCTypeSize[asBCInfo[op].type];
+		if (op == asBC_JitEntry && next < m_length && m_translated[next])
+		{
+			asBC_PTRARG(m_byteCode + pos) = reinterpret_cast<asPWORD>(nativeCode + m_labels[pos]);
+		}
+		pos = next;
+	}
+}
+
+#endif // ETH_JIT_X64
+
+bool ETHJITCompiler::IsSupported()
+{
+	#ifdef ETH_JIT_X64
+	 return true;
+	#else
+	 return false;
+	#endif
+}
+
+ETHJITCompiler::ETHJITCompiler() :
+	m_nativeCodeSize(0)
+{
+}
+
+ETHJITCompiler::~ETHJITCompiler()
+{
+	for (std::map<void*, std::size_t>::iterator iter = m_functions.begin(); iter != m_functions.end(); ++iter)
+	{
+		FreeExecutableMemory(iter->first, iter->second);
+	}
+}
+
+int ETHJITCompiler::CompileFunction(asIScriptFunction *function, asJITFunction *output)
+{
+	#ifdef ETH_JIT_X64
+	if (function->GetFuncType() != asFUNC_SCRIPT)
+		return asNOT_SUPPORTED;
+
+	asUINT length = 0;
+	asDWORD* byteCode = function->GetByteCode(&length);
+	if (!byteCode || length == 0)
+		return asNOT_SUPPORTED;
+
+	ETHBytecodeTranslator translator(byteCode, length);
+	if (!translator.Translate())
+		return asNOT_SUPPORTED;
+
+	const std::vector<unsigned char>& code = translator.GetCode();
+	void* memory = AllocateExecutableMemory(&code[0], code.size());
+	if (!memory)
+		return asOUT_OF_MEMORY;
+
+	translator.EnableEntries(static_cast<const unsigned char*>(memory));
+	m_functions[memory] = code.size();
+	m_nativeCodeSize += code.size();
+	*output = reinterpret_cast<asJITFunction>(memory);
+	return asSUCCESS;
+	#else
+	GS2D_UNUSED_ARGUMENT(function);
+	GS2D_UNUSED_ARGUMENT(output);
+	return asNOT_SUPPORTED;
+	#endif
+}
+
+void ETHJITCompiler::ReleaseJITFunction(asJITFunction func)
+{
+	void* memory = reinterpret_cast<void*>(func);
+	std::map<void*, std::size_t>::iterator iter = m_functions.find(memory);
+	if (iter == m_functions.end())
+		return;
+
+	m_nativeCodeSize -= iter->second;
+	FreeExecutableMemory(iter->first, iter->second);
+	m_functions.erase(iter);
+}
+
+unsigned int ETHJITCompiler::GetNumCompiledFunctions() const
+{
+	return static_cast<unsigned int>(m_functions.size());
+}
+
+std::size_t ETHJITCompiler::GetNativeCodeSize() const
+{
+	return m_nativeCodeSize;
+}
+
+void* ETHJITCompiler::AllocateExecutableMemory(const void* code, const std::size_t size)
+{
+	#if defined(ETH_JIT_X64) && defined(_WIN32)
+	void* memory = VirtualAlloc(0, size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+	if (!memory)
+		return 0;
+	memcpy(memory, code, size);
+	DWORD oldProtection;
+	if (!VirtualProtect(memory, size, PAGE_EXECUTE_READ, &oldProtection))
+	{
+		VirtualFree(memory, 0, MEM_RELEASE);
+		return 0;
+	}
+	FlushInstructionCache(GetCurrentProcess(), memory, size);
+	return memory;
+	#elif defined(ETH_JIT_X64)
+	void* memory = mmap(0, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0);
+	if (memory == MAP_FAILED)
+		return 0;
+	memcpy(memory, code, size);
+	if (mprotect(memory, size, PROT_READ | PROT_EXEC) != 0)
+	{
+		munmap(memory, size);
+		return 0;
+	}
+	return memory;
+	#else
+	GS2D_UNUSED_ARGUMENT(code);
+	GS2D_UNUSED_ARGUMENT(size);
+	return 0;
+	#endif
+}
+
+void ETHJITCompiler::FreeExecutableMemory(void* memory, const std::size_t size)
+{
+	#if defined(ETH_JIT_X64) && defined(_WIN32)
+	GS2D_UNUSED_ARGUMENT(size);
+	VirtualFree(memory, 0, MEM_RELEASE);
+	#elif defined(ETH_JIT_X64)
+	munmap(memory, size);
+	#else
+	GS2D_UNUSED_ARGUMENT(memory);
+	GS2D_UNUSED_ARGUMENT(size);
+	#endif
+}
@@ -0,0 +1,67 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#ifndef ETH_JIT_COMPILER_H_
+#define ETH_JIT_COMPILER_H_
+
+#include "../../angelscript/include/angelscript.h"
+
+#include <boost/shared_ptr.hpp>
+
+#include <map>
+
+#if (defined(__x86_64__) || defined(_M_X64)) && !defined(ANDROID) && !defined(APPLE_IOS)
+ #define ETH_JIT_X64
+#endif
+
+/*
+ * Translates the variable arithmetic, comparisons, conversions, branches, argument
+ * pushes and application registered function calls of script functions into native
+ * x86-64 code. Anything else (script calls, object and handle manipulation,
+ * returns...) is left for the interpreter, which hands the control back to the
+ * native code at the next JitEntry instruction
+ */
+class ETHJITCompiler : public asIJITCompiler
+{
+public:
+	static bool IsSupported();
+
+	ETHJITCompiler();
+	~ETHJITCompiler();
+
+	int CompileFunction(asIScriptFunction *function, asJITFunction *output);
+	void ReleaseJITFunction(asJITFunction func);
+
+	unsigned int GetNumCompiledFunctions() const;
+	std::size_t GetNativeCodeSize() const;
+
+private:
+	static void* AllocateExecutableMemory(const void* code, const std::size_t size);
+	static void FreeExecutableMemory(void* memory, const std::size_t size);
+
+	std::map<void*, std::size_t> m_functions;
+	std::size_t m_nativeCodeSize;
+};
+
+typedef boost::shared_ptr<ETHJITCompiler> ETHJITCompilerPtr;
+
+#endif
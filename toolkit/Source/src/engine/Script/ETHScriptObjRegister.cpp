@@ -100,6 +100,11 @@ ETHDateTime *DateTimeFactory()
 	return new ETHDateTime();
 }
 
+ETHSaveData *SaveDataFactory()
+{
+	return new ETHSaveData();
+}
+
 float GetAngle(const Vector2 &v2)
 {
 	const float r = atan2f(v2.x, v2.y);
@@ -263,6 +268,15 @@ bool RegisterDateTimeObject(asIScriptEngine *pASEngine)
 	return true;
 }
 
+void RegisterSaveDataMethods(asIScriptEngine *pASEngine);
+bool RegisterSaveDataObject(asIScriptEngine *pASEngine)
+{
+	int r;
+	r = pASEngine->RegisterObjectType("saveData", 0, asOBJ_REF); assert(r >= 0);
+	RegisterSaveDataMethods(pASEngine);
+	return true;
+}
+
 void RegisterPhysicsControllerMethods(asIScriptEngine *pASEngine);
 bool RegisterPhysicsControllerObject(asIScriptEngine *pASEngine)
 {
@@ -546,6 +560,7 @@ void RegisterAllObjects(asIScriptEngine *pASEngine)
 	ETHGlobal::RegisterMathObjectsAndFunctions(pASEngine);
 	ETHGlobal::RegisterENMLObject(pASEngine);
 	ETHGlobal::RegisterDateTimeObject(pASEngine);
+	ETHGlobal::RegisterSaveDataObject(pASEngine);
 	ETHGlobal::RegisterRevoluteJointObject(pASEngine);
 	ETHGlobal::RegisterPhysicsControllerObject(pASEngine);
 	ETHGlobal::RegisterEntityObject(pASEngine);
@@ -182,6 +182,20 @@ asDECLARE_METHOD_WRAPPERPR(__clear,              ETHEntityArray, clear,
 asDECLARE_METHOD_WRAPPERPR(__unique,             ETHEntityArray, unique,             (void),            void);
 asDECLARE_METHOD_WRAPPERPR(__removeDeadEntities, ETHEntityArray, removeDeadEntities, (void),            void);
 
+asDECLARE_METHOD_WRAPPERPR(__ArraySetColor,           ETHEntityArray, SetColor,           (const Vector3&),                                       void);
+asDECLARE_METHOD_WRAPPERPR(__ArraySetAlpha,           ETHEntityArray, SetAlpha,           (const float),                                          void);
+asDECLARE_METHOD_WRAPPERPR(__ArrayHide,               ETHEntityArray, Hide,               (const bool),                                           void);
+asDECLARE_METHOD_WRAPPERPR(__ArrayScale,              ETHEntityArray, Scale,              (const float),                                          void);
+asDECLARE_METHOD_WRAPPERPR(__ArraySetScale,           ETHEntityArray, SetScale,           (const Vector2&),                                       void);
+asDECLARE_METHOD_WRAPPERPR(__ArraySetAngle,           ETHEntityArray, SetAngle,           (const float),                                          void);
+asDECLARE_METHOD_WRAPPERPR(__ArrayAddToAngle,         ETHEntityArray, AddToAngle,         (const float),                                          void);
+asDECLARE_METHOD_WRAPPERPR(__ArraySortByDistance,     ETHEntityArray, SortByDistance,     (const Vector2&),                                       void);
+asDECLARE_METHOD_WRAPPERPR(__ArrayFilterByDistance,   ETHEntityArray, FilterByDistance,   (const Vector2&, const float),                          void);
+asDECLARE_METHOD_WRAPPERPR(__ArrayFilterByEntityName, ETHEntityArray, FilterByEntityName, (const str_type::string&),                              void);
+asDECLARE_METHOD_WRAPPERPR(__ArrayFilterByFloat,      ETHEntityArray, FilterByFloat,      (const str_type::string&, const float, const float),    void);
+asDECLARE_METHOD_WRAPPERPR(__ArrayFilterByInt,        ETHEntityArray, FilterByInt,        (const str_type::string&, const int),                   void);
+asDECLARE_METHOD_WRAPPERPR(__ArrayFilterByString,     ETHEntityArray, FilterByString,     (const str_type::string&, const str_type::string&),     void);
+
 void RegisterEntityArrayMethods(asIScriptEngine *pASEngine)
 {
 	int r;
@@ -200,6 +214,21 @@ void RegisterEntityArrayMethods(asIScriptEngine *pASEngine)
 	r = pASEngine->RegisterObjectMethod("ETHEntityArray", "void Unique()",                    asFUNCTION(__unique),             asCALL_GENERIC); assert(r >= 0);
 	r = pASEngine->RegisterObjectMethod("ETHEntityArray", "void RemoveDeadEntities()",        asFUNCTION(__removeDeadEntities), asCALL_GENERIC); assert(r >= 0);
 
+	// bulk operations
+	r = pASEngine->RegisterObjectMethod("ETHEntityArray", "void SetColor(const vector3 &in)",                              asFUNCTION(__ArraySetColor),           asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntityArray", "void SetAlpha(const float)",                                    asFUNCTION(__ArraySetAlpha),           asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntityArray", "void Hide(const bool)",                                         asFUNCTION(__ArrayHide),               asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntityArray", "void Scale(const float)",                                       asFUNCTION(__ArrayScale),              asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntityArray", "void SetScale(const vector2 &in)",                              asFUNCTION(__ArraySetScale),           asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntityArray", "void SetAngle(const float)",                                    asFUNCTION(__ArraySetAngle),           asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntityArray", "void AddToAngle(const float)",                                  asFUNCTION(__ArrayAddToAngle),         asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntityArray", "void SortByDistance(const vector2 &in)",                        asFUNCTION(__ArraySortByDistance),     asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntityArray", "void FilterByDistance(const vector2 &in, const float)",         asFUNCTION(__ArrayFilterByDistance),   asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntityArray", "void FilterByEntityName(const string &in)",                     asFUNCTION(__ArrayFilterByEntityName), asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntityArray", "void FilterByFloat(const string &in, const float, const float)", asFUNCTION(__ArrayFilterByFloat),     asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntityArray", "void FilterByInt(const string &in, const int)",                 asFUNCTION(__ArrayFilterByInt),        asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntityArray", "void FilterByString(const string &in, const string &in)",       asFUNCTION(__ArrayFilterByString),     asCALL_GENERIC); assert(r >= 0);
+
 	#ifdef ETH_DEFINE_DEPRECATED_SIGNATURES_FROM_0_9_5
 	{
 		r = pASEngine->RegisterObjectMethod("ETHEntityArray", "void push_back(const ETHEntity &in)", asFUNCTION(__push_back),          asCALL_GENERIC); assert(r >= 0);
@@ -551,6 +580,59 @@ void RegisterDateTimeMethods(asIScriptEngine *pASEngine)
 	r = pASEngine->RegisterObjectMethod("dateTime", "uint getSeconds() const", asFUNCTION(__getSeconds), asCALL_GENERIC); assert(r >= 0);
 }
 
+asDECLARE_FUNCTION_WRAPPER(__SaveDataFactory, SaveDataFactory);
+
+asDECLARE_METHOD_WRAPPERPR(__addRefSaveData,  ETHSaveData, AddRef,  (void), void);
+asDECLARE_METHOD_WRAPPERPR(__releaseSaveData, ETHSaveData, Release, (void), void);
+
+asDECLARE_METHOD_WRAPPERPR(__loadSaveData,         ETHSaveData, Load,                (const str_type::string&),                                                      bool);
+asDECLARE_METHOD_WRAPPERPR(__saveSaveData,         ETHSaveData, Save,                (const str_type::string&),                                                      bool);
+asDECLARE_METHOD_WRAPPERPR(__isSaving,             ETHSaveData, IsSaving,            (void) const,                                                                   bool);
+asDECLARE_METHOD_WRAPPERPR(__hasSaveFailed,        ETHSaveData, HasSaveFailed,       (void) const,                                                                   bool);
+asDECLARE_METHOD_WRAPPERPR(__waitForSave,          ETHSaveData, WaitForSave,         (void),                                                                         void);
+asDECLARE_METHOD_WRAPPERPR(__setSaveData,          ETHSaveData, Set,                 (const str_type::string&, const str_type::string&, const str_type::string&),    void);
+asDECLARE_METHOD_WRAPPERPR(__getSaveData,          ETHSaveData, Get,                 (const str_type::string&, const str_type::string&) const,                       str_type::string);
+asDECLARE_METHOD_WRAPPERPR(__getIntSaveData,       ETHSaveData, GetInt,              (const str_type::string&, const str_type::string&, int*) const,                 bool);
+asDECLARE_METHOD_WRAPPERPR(__getUIntSaveData,      ETHSaveData, GetUInt,             (const str_type::string&, const str_type::string&, unsigned int*) const,        bool);
+asDECLARE_METHOD_WRAPPERPR(__getFloatSaveData,     ETHSaveData, GetFloat,            (const str_type::string&, const str_type::string&, float*) const,               bool);
+asDECLARE_METHOD_WRAPPERPR(__getDoubleSaveData,    ETHSaveData, GetDouble,           (const str_type::string&, const str_type::string&, double*) const,              bool);
+asDECLARE_METHOD_WRAPPERPR(__existsSaveData,       ETHSaveData, Exists,              (const str_type::string&) const,                                                bool);
+asDECLARE_METHOD_WRAPPERPR(__removeSection,        ETHSaveData, RemoveSection,       (const str_type::string&),                                                      void);
+asDECLARE_METHOD_WRAPPERPR(__clearSaveData,        ETHSaveData, Clear,               (void),                                                                         void);
+asDECLARE_METHOD_WRAPPERPR(__getSectionNames,      ETHSaveData, GetSectionNames,     (void) const,                                                                   str_type::string);
+asDECLARE_METHOD_WRAPPERPR(__getKeyNames,          ETHSaveData, GetKeyNames,         (const str_type::string&) const,                                                str_type::string);
+asDECLARE_METHOD_WRAPPERPR(__importEnml,           ETHSaveData, ImportEnml,          (const enml::File&),                                                            void);
+asDECLARE_METHOD_WRAPPERPR(__importEnmlFile,       ETHSaveData, ImportEnmlFile,      (const str_type::string&),                                                      bool);
+asDECLARE_METHOD_WRAPPERPR(__generateEnmlString,   ETHSaveData, GenerateEnmlString,  (void) const,                                                                   str_type::string);
+
+void RegisterSaveDataMethods(asIScriptEngine *pASEngine)
+{
+	int r;
+	r = pASEngine->RegisterObjectBehaviour("saveData", asBEHAVE_FACTORY, "saveData@ f()", asFUNCTION(__SaveDataFactory), asCALL_GENERIC); assert( r >= 0 );
+	r = pASEngine->RegisterObjectBehaviour("saveData", asBEHAVE_ADDREF,  "void f()",      asFUNCTION(__addRefSaveData),  asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectBehaviour("saveData", asBEHAVE_RELEASE, "void f()",      asFUNCTION(__releaseSaveData), asCALL_GENERIC); assert(r >= 0);
+
+	r = pASEngine->RegisterObjectMethod("saveData", "bool load(const string &in)",                                        asFUNCTION(__loadSaveData),       asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("saveData", "bool save(const string &in)",                                        asFUNCTION(__saveSaveData),       asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("saveData", "bool isSaving() const",                                              asFUNCTION(__isSaving),           asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("saveData", "bool hasSaveFailed() const",                                         asFUNCTION(__hasSaveFailed),      asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("saveData", "void waitForSave()",                                                 asFUNCTION(__waitForSave),        asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("saveData", "void set(const string &in, const string &in, const string &in)",     asFUNCTION(__setSaveData),        asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("saveData", "string get(const string &in, const string &in) const",               asFUNCTION(__getSaveData),        asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("saveData", "bool getInt(const string &in, const string &in, int &out) const",     asFUNCTION(__getIntSaveData),     asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("saveData", "bool getUInt(const string &in, const string &in, uint &out) const",   asFUNCTION(__getUIntSaveData),    asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("saveData", "bool getFloat(const string &in, const string &in, float &out) const", asFUNCTION(__getFloatSaveData),   asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("saveData", "bool getDouble(const string &in, const string &in, double &out) const", asFUNCTION(__getDoubleSaveData), asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("saveData", "bool exists(const string &in) const",                                asFUNCTION(__existsSaveData),     asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("saveData", "void removeSection(const string &in)",                               asFUNCTION(__removeSection),      asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("saveData", "void clear()",                                                       asFUNCTION(__clearSaveData),      asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("saveData", "string getSectionNames() const",                                     asFUNCTION(__getSectionNames),    asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("saveData", "string getKeyNames(const string &in) const",                         asFUNCTION(__getKeyNames),        asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("saveData", "void importEnml(const enmlFile &in)",                                asFUNCTION(__importEnml),         asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("saveData", "bool importEnmlFile(const string &in)",                              asFUNCTION(__importEnmlFile),     asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("saveData", "string generateEnmlString() const",                                  asFUNCTION(__generateEnmlString), asCALL_GENERIC); assert(r >= 0);
+}
+
 asDECLARE_METHOD_WRAPPERPR(__AddRefPC,  ETHPhysicsController, AddRef,  (void), void);
 asDECLARE_METHOD_WRAPPERPR(__ReleasePC, ETHPhysicsController, Release, (void), void);
 
@@ -25,6 +25,7 @@
 
 #include "../Scene/ETHScene.h"
 #include "../Util/ETHDateTime.h"
+#include "../Util/ETHSaveData.h"
 #include <ostream>
 #include <string>
 #include <Enml/Enml.h>
@@ -33,6 +34,7 @@ namespace ETHGlobal
 {
 	void DateTimeConstructor(ETHDateTime *self);
 	ETHDateTime *DateTimeFactory();
+	ETHSaveData *SaveDataFactory();
 	float Matrix4x4Getter(const unsigned int i, const unsigned int j, Matrix4x4 *p);
 	void Matrix4x4Setter(const unsigned int i, const unsigned int j, const float value, Matrix4x4 *p);
 	void Matrix4x4DefaultConstructor(Matrix4x4 *self);
@@ -56,6 +58,7 @@ namespace ETHGlobal
 	void RegisterGlobalProperties(asIScriptEngine *pASEngine);
 	bool RegisterVideoModeObject(asIScriptEngine *pASEngine);
 	bool RegisterDateTimeObject(asIScriptEngine *pASEngine);
+	bool RegisterSaveDataObject(asIScriptEngine *pASEngine);
 
 	void RegisterAllObjects(asIScriptEngine *pASEngine);
 }
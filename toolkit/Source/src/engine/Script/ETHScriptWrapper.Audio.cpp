@@ -194,6 +194,67 @@ bool ETHScriptWrapper::IsSamplePlaying(const str_type::string &file)
 	return pSample->IsPlaying();
 }
 
+bool ETHScriptWrapper::PlaySampleVoice(const str_type::string &file, const float volume, const float pan, const float speed)
+{
+	Platform::FileIOHubPtr fileIOHub = m_provider->GetFileIOHub();
+
+	AudioSamplePtr pSample =
+		m_provider->GetAudioResourceManager()->GetPointer(m_provider->GetAudio(), fileIOHub, file, GS_L(""), Audio::UNKNOWN_TYPE);
+
+	if (!pSample)
+	{
+		ShowMessage(GS_L("File not found: ") + file, ETH_ERROR, false);
+		return false;
+	}
+	return pSample->PlayVoice(volume, pan, speed);
+}
+
+bool ETHScriptWrapper::SetSampleMaxVoices(const str_type::string &file, const unsigned int maxVoices)
+{
+	Platform::FileIOHubPtr fileIOHub = m_provider->GetFileIOHub();
+
+	AudioSamplePtr pSample =
+		m_provider->GetAudioResourceManager()->GetPointer(m_provider->GetAudio(), fileIOHub, file, GS_L(""), Audio::UNKNOWN_TYPE);
+
+	if (!pSample)
+	{
+		ShowMessage(GS_L("File not found: ") + file, ETH_ERROR, false);
+		return false;
+	}
+	pSample->SetMaxVoices(maxVoices);
+	return true;
+}
+
+unsigned int ETHScriptWrapper::GetSampleMaxVoices(const str_type::string &file)
+{
+	Platform::FileIOHubPtr fileIOHub = m_provider->GetFileIOHub();
+
+	AudioSamplePtr pSample =
+		m_provider->GetAudioResourceManager()->GetPointer(m_provider->GetAudio(), fileIOHub, file, GS_L(""), Audio::UNKNOWN_TYPE);
+
+	if (!pSample)
+	{
+		ShowMessage(GS_L("File not found: ") + file, ETH_ERROR, false);
+		return 0;
+	}
+	return pSample->GetMaxVoices();
+}
+
+unsigned int ETHScriptWrapper::GetNumSampleVoices(const str_type::string &file)
+{
+	Platform::FileIOHubPtr fileIOHub = m_provider->GetFileIOHub();
+
+	AudioSamplePtr pSample =
+		m_provider->GetAudioResourceManager()->GetPointer(m_provider->GetAudio(), fileIOHub, file, GS_L(""), Audio::UNKNOWN_TYPE);
+
+	if (!pSample)
+	{
+		ShowMessage(GS_L("File not found: ") + file, ETH_ERROR, false);
+		return 0;
+	}
+	return pSample->GetNumActiveVoices();
+}
+
 void ETHScriptWrapper::SetGlobalVolume(const float volume)
 {
 	m_provider->GetAudio()->SetGlobalVolume(volume);
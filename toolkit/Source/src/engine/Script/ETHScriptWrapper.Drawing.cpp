@@ -22,6 +22,7 @@
 
 #include "ETHScriptWrapper.h"
 #include "../Drawing/ETHParticleDrawer.h"
+#include "../Resource/ETHDirectories.h"
 
 Vector2 ETHScriptWrapper::ComputeCarretPosition(const str_type::string &font, const str_type::string &text, const unsigned int pos)
 {
@@ -149,13 +150,23 @@ void ETHScriptWrapper::DrawShaped(const str_type::string &name, const Vector2 &v
 
 void ETHScriptWrapper::PlayParticleEffect(const str_type::string& fileName, const Vector2& pos, const float angle, const float scale)
 {
+	const str_type::string fullFilePath =
+		m_provider->GetFileIOHub()->GetResourceDirectory() + ETHDirectories::GetEffectsDirectory() + fileName;
+
+	const ETHParticleEffectPtr effect = m_particleEffectCache.Get(fullFilePath, m_provider->GetFileManager());
+	if (!effect)
+	{
+		ETH_STREAM_DECL(ss) << GS_L("PlayParticleEffect: couldn't load particle effect ") << fileName;
+		m_provider->Log(ss.str(), Platform::Logger::ERROR);
+		return;
+	}
+
 	m_drawableManager.Insert(
 		boost::shared_ptr<ETHDrawable>(
 			new ETHParticleDrawer(
 				m_provider,
-				m_provider->GetGraphicResourceManager(),
 				m_provider->GetShaderManager(),
-				m_provider->GetFileIOHub()->GetResourceDirectory(),
+				effect,
 				fileName,
 				pos,
 				angle,
@@ -0,0 +1,118 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#include "ETHScriptWrapper.h"
+
+#include "../../addons/scriptarray.h"
+
+void ETHScriptWrapper::SetPositionXY(ETHEntityArray *pArray, const Vector2 &v2Pos)
+{
+	ETHBucketManager& buckets = m_pScene->GetBucketManager();
+	for (unsigned int t = 0; t < pArray->size(); t++)
+	{
+		ETHEntity* entity = (*pArray)[t];
+		if (entity->IsAlive())
+			entity->SetPositionXY(v2Pos, buckets);
+	}
+}
+
+void ETHScriptWrapper::AddToPositionXY(ETHEntityArray *pArray, const Vector2 &v2Pos)
+{
+	const Vector2 offset(v2Pos * m_provider->GetGlobalScaleManager()->GetScale());
+	ETHBucketManager& buckets = m_pScene->GetBucketManager();
+	for (unsigned int t = 0; t < pArray->size(); t++)
+	{
+		ETHEntity* entity = (*pArray)[t];
+		if (entity->IsAlive())
+			entity->AddToPositionXY(offset, buckets);
+	}
+}
+
+void ETHScriptWrapper::SetPositionsXY(ETHEntityArray *pArray, const CScriptArray &positions)
+{
+	ETHBucketManager& buckets = m_pScene->GetBucketManager();
+	const unsigned int size = Min(pArray->size(), static_cast<unsigned int>(positions.GetSize()));
+	for (unsigned int t = 0; t < size; t++)
+	{
+		ETHEntity* entity = (*pArray)[t];
+		if (entity->IsAlive())
+			entity->SetPositionXY(*static_cast<const Vector2*>(positions.At(t)), buckets);
+	}
+}
+
+void ETHScriptWrapper::AddToPositionsXY(ETHEntityArray *pArray, const CScriptArray &offsets)
+{
+	const float scale = m_provider->GetGlobalScaleManager()->GetScale();
+	ETHBucketManager& buckets = m_pScene->GetBucketManager();
+	const unsigned int size = Min(pArray->size(), static_cast<unsigned int>(offsets.GetSize()));
+	for (unsigned int t = 0; t < size; t++)
+	{
+		ETHEntity* entity = (*pArray)[t];
+		if (entity->IsAlive())
+			entity->AddToPositionXY(*static_cast<const Vector2*>(offsets.At(t)) * scale, buckets);
+	}
+}
+
+void ETHScriptWrapper::GetPositionsXY(const ETHEntityArray *pArray, CScriptArray &outPositions)
+{
+	outPositions.Resize(pArray->size());
+	for (unsigned int t = 0; t < pArray->size(); t++)
+	{
+		*static_cast<Vector2*>(outPositions.At(t)) = (*pArray)[t]->GetPositionXY();
+	}
+}
+
+void ETHScriptWrapper::GetAngles(const ETHEntityArray *pArray, CScriptArray &outAngles)
+{
+	outAngles.Resize(pArray->size());
+	for (unsigned int t = 0; t < pArray->size(); t++)
+	{
+		*static_cast<float*>(outAngles.At(t)) = (*pArray)[t]->GetAngle();
+	}
+}
+
+void ETHScriptWrapper::GetFloats(const ETHEntityArray *pArray, const str_type::string &name, CScriptArray &outValues)
+{
+	outValues.Resize(pArray->size());
+	for (unsigned int t = 0; t < pArray->size(); t++)
+	{
+		const ETHEntity* entity = (*pArray)[t];
+		*static_cast<float*>(outValues.At(t)) =
+			(entity->CheckCustomData(name) == ETHCustomData::DT_FLOAT) ? entity->GetFloat(name) : 0.0f;
+	}
+}
+
+void ETHScriptWrapper::DeleteEntities(ETHEntityArray *pArray)
+{
+	if (WarnIfRunsInMainFunction(GS_L("DeleteEntities")))
+		return;
+
+	for (unsigned int t = 0; t < pArray->size(); t++)
+	{
+		ETHEntity* entity = (*pArray)[t];
+		if (entity->IsAlive())
+			m_pScene->DeleteEntity(entity);
+	}
+
+	// the array still holds a reference to each deleted entity
+	pArray->clear();
+}
@@ -145,7 +145,20 @@ int ETHScriptWrapper::AddEntity(const str_type::string &file, const Vector3 &v3P
 
 	const float globalScale = m_provider->GetGlobalScaleManager()->GetScale();
 
-	ETHRenderEntity* entity = new ETHRenderEntity(m_provider, *props, angle, scale * globalScale);
+	// recycle an idle instance of the same template when pooling is enabled for it
+	ETHRenderEntity* entity = m_entityPool->Acquire(file);
+	if (entity)
+	{
+		entity->Reuse(*props, angle, scale * globalScale);
+	}
+	else
+	{
+		entity = new ETHRenderEntity(m_provider, *props, angle, scale * globalScale);
+		if (m_entityPool->IsPooled(file))
+		{
+			entity->SetPool(m_entityPool, file);
+		}
+	}
 	entity->SetOrphanPosition(v3Pos);
 	entity->SetAngle(angle);
 
@@ -195,6 +208,71 @@ ETHEntity *ETHScriptWrapper::DeleteEntity(ETHEntity *pEntity)
 	return 0;
 }
 
+void ETHScriptWrapper::SetEntityPoolSize(const str_type::string &file, const unsigned int size)
+{
+	m_entityPool->SetPoolSize(file, size);
+}
+
+unsigned int ETHScriptWrapper::GetEntityPoolSize(const str_type::string &file)
+{
+	return m_entityPool->GetPoolSize(file);
+}
+
+unsigned int ETHScriptWrapper::GetEntityPoolHits(const str_type::string &file)
+{
+	return m_entityPool->GetStats(file).hits;
+}
+
+unsigned int ETHScriptWrapper::GetEntityPoolMisses(const str_type::string &file)
+{
+	return m_entityPool->GetStats(file).misses;
+}
+
+unsigned int ETHScriptWrapper::GetNumIdlePooledEntities(const str_type::string &file)
+{
+	return m_entityPool->GetNumIdleEntities(file);
+}
+
+void ETHScriptWrapper::ClearEntityPool()
+{
+	#if defined(_DEBUG) || defined(DEBUG)
+	const ETHEntityPool::STATS stats = m_entityPool->GetTotalStats();
+	if (stats.hits > 0 || stats.misses > 0)
+	{
+		ETH_STREAM_DECL(ss) << GS_L("Entity pool: ") << stats.hits << GS_L(" hits, ") << stats.misses << GS_L(" misses, ")
+			<< stats.recycled << GS_L(" recycled, ") << stats.discarded << GS_L(" discarded");
+		m_provider->Log(ss.str(), Platform::Logger::INFO);
+	}
+	#endif
+	m_entityPool->Clear();
+}
+
+unsigned int ETHScriptWrapper::GetParticleEffectRecycledSpawns()
+{
+	return m_particleEffectCache.GetStats().recycledSpawns;
+}
+
+unsigned int ETHScriptWrapper::GetParticleEffectAllocatedManagers()
+{
+	return m_particleEffectCache.GetStats().allocatedManagers;
+}
+
+void ETHScriptWrapper::ClearParticleEffectCache()
+{
+	#if defined(_DEBUG) || defined(DEBUG)
+	const ETHParticleEffectCache::STATS stats = m_particleEffectCache.GetStats();
+	if (stats.definitionHits > 0 || stats.definitionMisses > 0)
+	{
+		ETH_STREAM_DECL(ss) << GS_L("Particle effect cache: ") << stats.definitionHits << GS_L(" hits, ")
+			<< stats.definitionMisses << GS_L(" misses, ") << stats.recycledSpawns << GS_L(" recycled spawns, ")
+			<< stats.allocatedManagers << GS_L(" allocated managers");
+		m_provider->Log(ss.str(), Platform::Logger::INFO);
+	}
+	#endif
+	m_drawableManager.Clear();
+	m_particleEffectCache.Clear();
+}
+
 void ETHScriptWrapper::LoadLightmaps()
 {
 	if (m_usePreLoadedLightmapsFromFile)
@@ -541,6 +619,20 @@ int ETHScriptWrapper::GetNumRenderedEntities()
 	return m_pScene->GetNumRenderedEntities();
 }
 
+unsigned int ETHScriptWrapper::GetFrameScratchWatermark()
+{
+	if (WarnIfRunsInMainFunction(GS_L("GetFrameScratchWatermark")))
+		return 0;
+	return static_cast<unsigned int>(m_pScene->GetFrameScratchWatermark());
+}
+
+unsigned int ETHScriptWrapper::GetScratchHighWatermark()
+{
+	if (WarnIfRunsInMainFunction(GS_L("GetScratchHighWatermark")))
+		return 0;
+	return static_cast<unsigned int>(m_pScene->GetScratchHighWatermark());
+}
+
 bool ETHScriptWrapper::SaveScene(const str_type::string &escFile)
 {
 	if (WarnIfRunsInMainFunction(GS_L("SaveScene")))
@@ -555,6 +647,8 @@ bool ETHScriptWrapper::SaveScene(const str_type::string &escFile)
 
 void ETHScriptWrapper::ReleaseResources()
 {
+	// idle particle managers still hold the bitmaps that are about to be released
+	m_particleEffectCache.ClearIdleManagers();
 	m_provider->GetAudioResourceManager()->ReleaseResources();
 	m_provider->GetGraphicResourceManager()->ReleaseResources();
 }
@@ -602,6 +696,8 @@ bool ETHScriptWrapper::LoadScene(const str_type::string &escFile, const Vector2&
 
 	m_pScene->ScaleEntities(m_provider->GetGlobalScaleManager()->GetScale(), true);
 	m_pScene->ResolveJoints();
+	if (m_mergeStaticColliders)
+		m_pScene->MergeStaticColliders();
 	m_drawableManager.Clear();
 	m_sceneFileName = escFile;
 	m_pScene->EnableLightmaps(m_useLightmaps);
@@ -759,6 +855,72 @@ void ETHScriptWrapper::SetFixedTimeStepValue(const float value)
 	m_pScene->GetSimulator().SetFixedTimeStepValue(value);
 }
 
+void ETHScriptWrapper::SetFixedTimeStepInterpolation(const bool enable)
+{
+	if (WarnIfRunsInMainFunction(GS_L("SetFixedTimeStepInterpolation")))
+		return;
+	m_pScene->GetSimulator().SetFixedTimeStepInterpolation(enable);
+}
+
+bool ETHScriptWrapper::IsFixedTimeStepInterpolationEnabled()
+{
+	if (WarnIfRunsInMainFunction(GS_L("IsFixedTimeStepInterpolationEnabled")))
+		return false;
+	return m_pScene->GetSimulator().IsFixedTimeStepInterpolationEnabled();
+}
+
+void ETHScriptWrapper::SetStaticColliderMerging(const bool enable)
+{
+	m_mergeStaticColliders = enable;
+}
+
+bool ETHScriptWrapper::IsStaticColliderMergingEnabled()
+{
+	return m_mergeStaticColliders;
+}
+
+void ETHScriptWrapper::SetMaxPhysicsSubSteps(const unsigned int maxSubSteps)
+{
+	if (WarnIfRunsInMainFunction(GS_L("SetMaxPhysicsSubSteps")))
+		return;
+	m_pScene->GetSimulator().SetMaxSubSteps(maxSubSteps);
+}
+
+unsigned int ETHScriptWrapper::GetMaxPhysicsSubSteps()
+{
+	if (WarnIfRunsInMainFunction(GS_L("GetMaxPhysicsSubSteps")))
+		return 0;
+	return m_pScene->GetSimulator().GetMaxSubSteps();
+}
+
+void ETHScriptWrapper::SetPhysicsSolverThreads(const unsigned int count)
+{
+	if (WarnIfRunsInMainFunction(GS_L("SetPhysicsSolverThreads")))
+		return;
+	m_pScene->GetSimulator().SetSolverThreadCount(count);
+}
+
+unsigned int ETHScriptWrapper::GetPhysicsSolverThreads()
+{
+	if (WarnIfRunsInMainFunction(GS_L("GetPhysicsSolverThreads")))
+		return 1;
+	return m_pScene->GetSimulator().GetSolverThreadCount();
+}
+
+void ETHScriptWrapper::RebuildPhysicsBroadPhase()
+{
+	if (WarnIfRunsInMainFunction(GS_L("RebuildPhysicsBroadPhase")))
+		return;
+	m_pScene->GetSimulator().RebuildBroadPhase();
+}
+
+unsigned int ETHScriptWrapper::GetNumPhysicsStepsLastFrame()
+{
+	if (WarnIfRunsInMainFunction(GS_L("GetNumPhysicsStepsLastFrame")))
+		return 0;
+	return m_pScene->GetSimulator().GetNumStepsLastFrame();
+}
+
 float ETHScriptWrapper::GetCurrentPhysicsTimeStepMS()
 {
 	if (WarnIfRunsInMainFunction(GS_L("GetCurrentPhysicsTimeStepMS")))
@@ -766,6 +928,27 @@ float ETHScriptWrapper::GetCurrentPhysicsTimeStepMS()
 	return m_pScene->GetSimulator().GetCurrentDynamicTimeStepMS();
 }
 
+unsigned int ETHScriptWrapper::GetNumContactEvents()
+{
+	if (WarnIfRunsInMainFunction(GS_L("GetNumContactEvents")))
+		return 0;
+	return m_pScene->GetSimulator().GetNumContactEventsLastStep();
+}
+
+unsigned int ETHScriptWrapper::GetNumContactCallbacks()
+{
+	if (WarnIfRunsInMainFunction(GS_L("GetNumContactCallbacks")))
+		return 0;
+	return m_pScene->GetSimulator().GetNumContactCallbacksLastStep();
+}
+
+float ETHScriptWrapper::GetContactCallbackTimeMS()
+{
+	if (WarnIfRunsInMainFunction(GS_L("GetContactCallbackTimeMS")))
+		return 0.0f;
+	return m_pScene->GetSimulator().GetContactCallbackTimeLastStepMS();
+}
+
 void ETHScriptWrapper::DisableContact()
 {
 	if (WarnIfRunsInMainFunction(GS_L("DisableContact")))
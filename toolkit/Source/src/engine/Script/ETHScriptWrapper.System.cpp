@@ -82,6 +82,12 @@ void ETHScriptWrapper::Print(const str_type::string &str)
 	m_provider->Log(ss.str(), Platform::FileLogger::INFO);
 }
 
+void ETHScriptWrapper::SetLogLevel(const unsigned int level)
+{
+	// 0 = errors only, 1 = errors and warnings, 2 = everything
+	m_provider->SetLogLevel(static_cast<Platform::Logger::TYPE>(Min(level, static_cast<unsigned int>(Platform::Logger::INFO))));
+}
+
 float ETHScriptWrapper::GetTimeF()
 {
 	return m_provider->GetVideo()->GetElapsedTimeF();
@@ -97,16 +103,118 @@ float ETHScriptWrapper::UnitsPerSecond(const float speed)
 	return static_cast<float>(static_cast<double>(m_lastFrameElapsedTime) / 1000.0 * static_cast<double>(speed));
 }
 
-void ETHScriptWrapper::SetLastFrameElapsedTime(const unsigned long lastFrameElapsedTime)
+void ETHScriptWrapper::SetLastFrameElapsedTime(const float lastFrameElapsedTime)
 {
 	m_lastFrameElapsedTime = lastFrameElapsedTime;
 }
 
 unsigned long ETHScriptWrapper::GetLastFrameElapsedTime()
+{
+	return static_cast<unsigned long>(m_lastFrameElapsedTime);
+}
+
+float ETHScriptWrapper::GetLastFrameElapsedTimeF()
 {
 	return m_lastFrameElapsedTime;
 }
 
+void ETHScriptWrapper::SetMaxFrameRate(const float fps)
+{
+	m_frameLimiter.SetMaxFrameRate(fps);
+}
+
+float ETHScriptWrapper::GetMaxFrameRate()
+{
+	return m_frameLimiter.GetMaxFrameRate();
+}
+
+float ETHScriptWrapper::GetFrameTimePercentile(const float percentile)
+{
+	return m_frameTimeHistogram.GetPercentile(percentile);
+}
+
+float ETHScriptWrapper::GetUpdateTimePercentile(const float percentile)
+{
+	return m_updateTimeHistogram.GetPercentile(percentile);
+}
+
+float ETHScriptWrapper::GetRenderTimePercentile(const float percentile)
+{
+	return m_renderTimeHistogram.GetPercentile(percentile);
+}
+
+void ETHScriptWrapper::ResetFrameTimeStats()
+{
+	m_frameTimeHistogram.Reset();
+	m_updateTimeHistogram.Reset();
+	m_renderTimeHistogram.Reset();
+	m_garbageCollector.ResetStats();
+}
+
+void ETHScriptWrapper::LogFrameTimeStats()
+{
+	if (m_frameTimeHistogram.GetNumSamples() == 0)
+		return;
+
+	ETH_STREAM_DECL(ss)
+		<< GS_L("Frame time: ")  << m_frameTimeHistogram.GetSummary()  << std::endl
+		<< GS_L("Update time: ") << m_updateTimeHistogram.GetSummary() << std::endl
+		<< GS_L("Render time: ") << m_renderTimeHistogram.GetSummary();
+	if (m_gcMode == ADAPTIVE)
+	{
+		ss << std::endl << GS_L("GC time: ") << m_garbageCollector.GetTimeHistogram().GetSummary()
+			<< GS_L(" (") << m_garbageCollector.GetObjectCount() << GS_L(" objects tracked, ")
+			<< m_garbageCollector.GetIdleTimeSpentUS() / 1000 << GS_L("ms of idle frame time used)");
+	}
+	m_provider->Log(ss.str(), Platform::Logger::INFO);
+}
+
+bool ETHScriptWrapper::IsAllocationTrackingEnabled()
+{
+	return ETHAllocationTracker::IsEnabled();
+}
+
+unsigned int ETHScriptWrapper::GetFrameAllocationCount()
+{
+	return static_cast<unsigned int>(ETHAllocationTracker::GetFrameNumAllocations());
+}
+
+boost::uint64_t ETHScriptWrapper::GetFrameAllocatedBytes()
+{
+	return ETHAllocationTracker::GetFrameAllocatedBytes();
+}
+
+unsigned int ETHScriptWrapper::GetPeakFrameAllocationCount()
+{
+	return static_cast<unsigned int>(ETHAllocationTracker::GetPeakFrameNumAllocations());
+}
+
+unsigned int ETHScriptWrapper::GetTotalAllocationCount()
+{
+	return static_cast<unsigned int>(ETHAllocationTracker::GetNumAllocations());
+}
+
+boost::uint64_t ETHScriptWrapper::GetLiveAllocatedBytes()
+{
+	return ETHAllocationTracker::GetLiveBytes();
+}
+
+boost::uint64_t ETHScriptWrapper::GetPeakAllocatedBytes()
+{
+	return ETHAllocationTracker::GetPeakLiveBytes();
+}
+
+void ETHScriptWrapper::ResetAllocationStats()
+{
+	ETHAllocationTracker::ResetPeaks();
+}
+
+void ETHScriptWrapper::LogAllocationStats()
+{
+	ETH_STREAM_DECL(ss) << GS_L("Allocations: ") << ETHAllocationTracker::GetSummary();
+	m_provider->Log(ss.str(), Platform::Logger::INFO);
+}
+
 void ETHScriptWrapper::Exit()
 {
 	m_provider->GetVideo()->Quit();
@@ -52,10 +52,18 @@ asIScriptFunction* ETHScriptWrapper::m_onResumeFunction = 0;
 asIScriptContext *ETHScriptWrapper::m_pScriptContext = 0;
 bool ETHScriptWrapper::m_runningMainFunction = false;
 bool ETHScriptWrapper::m_persistentResources = false;
+bool ETHScriptWrapper::m_mergeStaticColliders = true;
 ETHScriptWrapper::Math ETHScriptWrapper::m_math;
-unsigned long ETHScriptWrapper::m_lastFrameElapsedTime = 1;
+float ETHScriptWrapper::m_lastFrameElapsedTime = 1.0f;
 ETHEntityCache ETHScriptWrapper::m_entityCache;
-ETHScriptWrapper::GARBAGE_COLLECT_MODE ETHScriptWrapper::m_gcMode = ETHScriptWrapper::ONE_STEP;
+ETHEntityPoolPtr ETHScriptWrapper::m_entityPool(new ETHEntityPool);
+ETHParticleEffectCache ETHScriptWrapper::m_particleEffectCache;
+Platform::FrameLimiter ETHScriptWrapper::m_frameLimiter;
+ETHFrameTimeHistogram ETHScriptWrapper::m_frameTimeHistogram;
+ETHFrameTimeHistogram ETHScriptWrapper::m_updateTimeHistogram;
+ETHFrameTimeHistogram ETHScriptWrapper::m_renderTimeHistogram;
+ETHScriptWrapper::GARBAGE_COLLECT_MODE ETHScriptWrapper::m_gcMode = ETHScriptWrapper::ADAPTIVE;
+ETHGarbageCollector ETHScriptWrapper::m_garbageCollector;
 
 bool ETHScriptWrapper::RunMainFunction(asIScriptFunction* mainFunc)
 {
@@ -216,6 +224,9 @@ void ETHScriptWrapper::GarbageCollect(const GARBAGE_COLLECT_MODE mode, asIScript
 	case DESTROY_ALL_GARBAGE:
 		engine->GarbageCollect(asGC_FULL_CYCLE);
 		break;
+	case ADAPTIVE:
+		m_garbageCollector.Update(engine);
+		break;
 	}
 }
 
@@ -224,6 +235,37 @@ void ETHScriptWrapper::SetFastGarbageCollector(const bool enable)
 	m_gcMode = enable ? ONE_STEP : FULL_CYCLE;
 }
 
+void ETHScriptWrapper::SetGarbageCollectorBudget(const unsigned int budgetUS)
+{
+	m_garbageCollector.SetFrameBudget(budgetUS);
+	m_gcMode = ADAPTIVE;
+}
+
+unsigned int ETHScriptWrapper::GetGarbageCollectorBudget()
+{
+	return static_cast<unsigned int>(m_garbageCollector.GetFrameBudget());
+}
+
+unsigned int ETHScriptWrapper::GetGCObjectCount()
+{
+	return m_garbageCollector.GetObjectCount();
+}
+
+unsigned int ETHScriptWrapper::GetGCDestroyedCount()
+{
+	return m_garbageCollector.GetTotalDestroyed();
+}
+
+unsigned int ETHScriptWrapper::GetGCDetectedCount()
+{
+	return m_garbageCollector.GetTotalDetected();
+}
+
+float ETHScriptWrapper::GetGCTimePercentile(const float percentile)
+{
+	return m_garbageCollector.GetTimeHistogram().GetPercentile(percentile);
+}
+
 void ETHScriptWrapper::SetHighEndDevice(const bool highEnd)
 {
 	m_highEndDevice = highEnd;
@@ -37,18 +37,27 @@ asDECLARE_FUNCTION_WRAPPER(__HideCursor,           ETHScriptWrapper::HideCursor)
 //asDECLARE_FUNCTION_OBJ_WRAPPER(wrapper_name,func,objfirst)
 
 asDECLARE_FUNCTION_OBJ_WRAPPER(__SetPosition,         ETHScriptWrapper::SetPosition, true);
-asDECLARE_FUNCTION_OBJ_WRAPPER(__SetPositionXY,       ETHScriptWrapper::SetPositionXY, true);
+asDECLARE_FUNCTION_OBJ_WRAPPERPR(__SetPositionXY,     ETHScriptWrapper::SetPositionXY, true, (ETHEntity*, const Vector2&), void);
 asDECLARE_FUNCTION_OBJ_WRAPPER(__SetPositionX,        ETHScriptWrapper::SetPositionX, true);
 asDECLARE_FUNCTION_OBJ_WRAPPER(__SetPositionY,        ETHScriptWrapper::SetPositionY, true);
 asDECLARE_FUNCTION_OBJ_WRAPPER(__SetPositionZ,        ETHScriptWrapper::SetPositionZ, true);
 asDECLARE_FUNCTION_OBJ_WRAPPER(__AddToPosition,       ETHScriptWrapper::AddToPosition, true);
-asDECLARE_FUNCTION_OBJ_WRAPPER(__AddToPositionXY,     ETHScriptWrapper::AddToPositionXY, true);
+asDECLARE_FUNCTION_OBJ_WRAPPERPR(__AddToPositionXY,   ETHScriptWrapper::AddToPositionXY, true, (ETHEntity*, const Vector2&), void);
 asDECLARE_FUNCTION_OBJ_WRAPPER(__AddToPositionX,      ETHScriptWrapper::AddToPositionX, true);
 asDECLARE_FUNCTION_OBJ_WRAPPER(__AddToPositionY,      ETHScriptWrapper::AddToPositionY, true);
 asDECLARE_FUNCTION_OBJ_WRAPPER(__AddToPositionZ,      ETHScriptWrapper::AddToPositionZ, true);
 asDECLARE_FUNCTION_OBJ_WRAPPER(__PlayParticleSystem,  ETHScriptWrapper::PlayParticleSystem, true);
 asDECLARE_FUNCTION_OBJ_WRAPPER(__ResolveEntityJoints, ETHScriptWrapper::ResolveEntityJoints, true);
 
+asDECLARE_FUNCTION_OBJ_WRAPPERPR(__ArraySetPositionXY,   ETHScriptWrapper::SetPositionXY,   true, (ETHEntityArray*, const Vector2&), void);
+asDECLARE_FUNCTION_OBJ_WRAPPERPR(__ArrayAddToPositionXY, ETHScriptWrapper::AddToPositionXY, true, (ETHEntityArray*, const Vector2&), void);
+asDECLARE_FUNCTION_OBJ_WRAPPER(__ArraySetPositionsXY,    ETHScriptWrapper::SetPositionsXY,   true);
+asDECLARE_FUNCTION_OBJ_WRAPPER(__ArrayAddToPositionsXY,  ETHScriptWrapper::AddToPositionsXY, true);
+asDECLARE_FUNCTION_OBJ_WRAPPER(__ArrayGetPositionsXY,    ETHScriptWrapper::GetPositionsXY,   true);
+asDECLARE_FUNCTION_OBJ_WRAPPER(__ArrayGetAngles,         ETHScriptWrapper::GetAngles,        true);
+asDECLARE_FUNCTION_OBJ_WRAPPER(__ArrayGetFloats,         ETHScriptWrapper::GetFloats,        true);
+asDECLARE_FUNCTION_OBJ_WRAPPER(__ArrayDeleteEntities,    ETHScriptWrapper::DeleteEntities,   true);
+
 asDECLARE_FUNCTION_WRAPPERPR(__SeekEntityStr,   ETHScriptWrapper::SeekEntity, (const str_type::string&), ETHEntity *);
 asDECLARE_FUNCTION_WRAPPERPR(__SeekEntityInt,   ETHScriptWrapper::SeekEntity, (const int), ETHEntity *);
 
@@ -70,6 +79,23 @@ asDECLARE_FUNCTION_WRAPPER(__GetTime,        ETHScriptWrapper::GetTime);
 asDECLARE_FUNCTION_WRAPPER(__UnitsPerSecond, ETHScriptWrapper::UnitsPerSecond);
 asDECLARE_FUNCTION_WRAPPER(__Exit,           ETHScriptWrapper::Exit);
 asDECLARE_FUNCTION_WRAPPER(__GetLastFrameElapsedTime, ETHScriptWrapper::GetLastFrameElapsedTime);
+asDECLARE_FUNCTION_WRAPPER(__GetLastFrameElapsedTimeF, ETHScriptWrapper::GetLastFrameElapsedTimeF);
+asDECLARE_FUNCTION_WRAPPER(__SetMaxFrameRate,         ETHScriptWrapper::SetMaxFrameRate);
+asDECLARE_FUNCTION_WRAPPER(__GetMaxFrameRate,         ETHScriptWrapper::GetMaxFrameRate);
+asDECLARE_FUNCTION_WRAPPER(__GetFrameTimePercentile,  ETHScriptWrapper::GetFrameTimePercentile);
+asDECLARE_FUNCTION_WRAPPER(__GetUpdateTimePercentile, ETHScriptWrapper::GetUpdateTimePercentile);
+asDECLARE_FUNCTION_WRAPPER(__GetRenderTimePercentile, ETHScriptWrapper::GetRenderTimePercentile);
+asDECLARE_FUNCTION_WRAPPER(__ResetFrameTimeStats,     ETHScriptWrapper::ResetFrameTimeStats);
+asDECLARE_FUNCTION_WRAPPER(__LogFrameTimeStats,       ETHScriptWrapper::LogFrameTimeStats);
+asDECLARE_FUNCTION_WRAPPER(__IsAllocationTrackingEnabled, ETHScriptWrapper::IsAllocationTrackingEnabled);
+asDECLARE_FUNCTION_WRAPPER(__GetFrameAllocationCount,     ETHScriptWrapper::GetFrameAllocationCount);
+asDECLARE_FUNCTION_WRAPPER(__GetFrameAllocatedBytes,      ETHScriptWrapper::GetFrameAllocatedBytes);
+asDECLARE_FUNCTION_WRAPPER(__GetPeakFrameAllocationCount, ETHScriptWrapper::GetPeakFrameAllocationCount);
+asDECLARE_FUNCTION_WRAPPER(__GetTotalAllocationCount,     ETHScriptWrapper::GetTotalAllocationCount);
+asDECLARE_FUNCTION_WRAPPER(__GetLiveAllocatedBytes,       ETHScriptWrapper::GetLiveAllocatedBytes);
+asDECLARE_FUNCTION_WRAPPER(__GetPeakAllocatedBytes,       ETHScriptWrapper::GetPeakAllocatedBytes);
+asDECLARE_FUNCTION_WRAPPER(__ResetAllocationStats,        ETHScriptWrapper::ResetAllocationStats);
+asDECLARE_FUNCTION_WRAPPER(__LogAllocationStats,          ETHScriptWrapper::LogAllocationStats);
 
 asDECLARE_FUNCTION_WRAPPERPR(__AddEntityA, ETHScriptWrapper::AddEntity,       (const str_type::string&, const Vector3&, const float), int);
 asDECLARE_FUNCTION_WRAPPERPR(__AddEntityR, ETHScriptWrapper::AddEntity,       (const str_type::string&, const Vector3&, ETHEntity**), int);
@@ -79,6 +105,14 @@ asDECLARE_FUNCTION_WRAPPERPR(__AddEntitySR,ETHScriptWrapper::AddScaledEntity, (c
 asDECLARE_FUNCTION_WRAPPERPR(__AddEntityF, ETHScriptWrapper::AddEntity,       (const str_type::string&, const Vector3&, const float, ETHEntity**, const str_type::string&, const float), int);
 
 //asDECLARE_FUNCTION_WRAPPER(__DeleteEntity,      ETHScriptWrapper::DeleteEntity);
+asDECLARE_FUNCTION_WRAPPER(__SetEntityPoolSize,        ETHScriptWrapper::SetEntityPoolSize);
+asDECLARE_FUNCTION_WRAPPER(__GetEntityPoolSize,        ETHScriptWrapper::GetEntityPoolSize);
+asDECLARE_FUNCTION_WRAPPER(__GetEntityPoolHits,        ETHScriptWrapper::GetEntityPoolHits);
+asDECLARE_FUNCTION_WRAPPER(__GetEntityPoolMisses,      ETHScriptWrapper::GetEntityPoolMisses);
+asDECLARE_FUNCTION_WRAPPER(__GetNumIdlePooledEntities, ETHScriptWrapper::GetNumIdlePooledEntities);
+asDECLARE_FUNCTION_WRAPPER(__ClearEntityPool,          ETHScriptWrapper::ClearEntityPool);
+asDECLARE_FUNCTION_WRAPPER(__GetParticleEffectRecycledSpawns,    ETHScriptWrapper::GetParticleEffectRecycledSpawns);
+asDECLARE_FUNCTION_WRAPPER(__GetParticleEffectAllocatedManagers, ETHScriptWrapper::GetParticleEffectAllocatedManagers);
 asDECLARE_FUNCTION_WRAPPER(__GenerateLightmaps, ETHScriptWrapper::GenerateLightmaps);
 asDECLARE_FUNCTION_WRAPPER(__AddLight,   ETHScriptWrapper::AddLight);
 
@@ -125,6 +159,10 @@ asDECLARE_FUNCTION_WRAPPER(__SetSampleSpeed,  ETHScriptWrapper::SetSampleSpeed);
 asDECLARE_FUNCTION_WRAPPER(__SetSamplePan,    ETHScriptWrapper::SetSamplePan);
 asDECLARE_FUNCTION_WRAPPER(__SampleExists,    ETHScriptWrapper::SampleExists);
 asDECLARE_FUNCTION_WRAPPER(__IsSamplePlaying, ETHScriptWrapper::IsSamplePlaying);
+asDECLARE_FUNCTION_WRAPPER(__PlaySampleVoice,    ETHScriptWrapper::PlaySampleVoice);
+asDECLARE_FUNCTION_WRAPPER(__SetSampleMaxVoices, ETHScriptWrapper::SetSampleMaxVoices);
+asDECLARE_FUNCTION_WRAPPER(__GetSampleMaxVoices, ETHScriptWrapper::GetSampleMaxVoices);
+asDECLARE_FUNCTION_WRAPPER(__GetNumSampleVoices, ETHScriptWrapper::GetNumSampleVoices);
 asDECLARE_FUNCTION_WRAPPER(__SetGlobalVolume, ETHScriptWrapper::SetGlobalVolume);
 asDECLARE_FUNCTION_WRAPPER(__GetGlobalVolume, ETHScriptWrapper::GetGlobalVolume);
 
@@ -197,6 +235,8 @@ asDECLARE_FUNCTION_WRAPPER(__GetGlobalExternalStoragePath, ETHScriptWrapper::Get
 asDECLARE_FUNCTION_WRAPPER(__GetAbsolutePath,              ETHScriptWrapper::GetAbsolutePath);
 asDECLARE_FUNCTION_WRAPPER(__GetLastCameraPos,             ETHScriptWrapper::GetLastCameraPos);
 asDECLARE_FUNCTION_WRAPPER(__GetNumRenderedEntities,       ETHScriptWrapper::GetNumRenderedEntities);
+asDECLARE_FUNCTION_WRAPPER(__GetFrameScratchWatermark,     ETHScriptWrapper::GetFrameScratchWatermark);
+asDECLARE_FUNCTION_WRAPPER(__GetScratchHighWatermark,      ETHScriptWrapper::GetScratchHighWatermark);
 asDECLARE_FUNCTION_WRAPPER(__ParseInt,                     ETHGlobal::ParseIntStd);
 asDECLARE_FUNCTION_WRAPPER(__ParseUInt,                    ETHGlobal::ParseUIntStd);
 asDECLARE_FUNCTION_WRAPPER(__ParseFloat,                   ETHGlobal::ParseFloatStd);
@@ -213,6 +253,13 @@ asDECLARE_FUNCTION_WRAPPER(__ArePersistentResourcesEnabled, ETHScriptWrapper::Ar
 asDECLARE_FUNCTION_WRAPPER(__ReleaseResources,              ETHScriptWrapper::ReleaseResources);
 asDECLARE_FUNCTION_WRAPPER(__ResolveJoints,                 ETHScriptWrapper::ResolveJoints);
 asDECLARE_FUNCTION_WRAPPER(__SetFastGarbageCollector,       ETHScriptWrapper::SetFastGarbageCollector);
+asDECLARE_FUNCTION_WRAPPER(__SetGarbageCollectorBudget,     ETHScriptWrapper::SetGarbageCollectorBudget);
+asDECLARE_FUNCTION_WRAPPER(__GetGarbageCollectorBudget,     ETHScriptWrapper::GetGarbageCollectorBudget);
+asDECLARE_FUNCTION_WRAPPER(__GetGCObjectCount,              ETHScriptWrapper::GetGCObjectCount);
+asDECLARE_FUNCTION_WRAPPER(__GetGCDestroyedCount,           ETHScriptWrapper::GetGCDestroyedCount);
+asDECLARE_FUNCTION_WRAPPER(__GetGCDetectedCount,            ETHScriptWrapper::GetGCDetectedCount);
+asDECLARE_FUNCTION_WRAPPER(__GetGCTimePercentile,           ETHScriptWrapper::GetGCTimePercentile);
+asDECLARE_FUNCTION_WRAPPER(__SetLogLevel,                   ETHScriptWrapper::SetLogLevel);
 asDECLARE_FUNCTION_WRAPPER(__GetStringFromFileInPackage,    ETHScriptWrapper::GetStringFromFileInPackage);
 asDECLARE_FUNCTION_WRAPPER(__FileInPackageExists,           ETHScriptWrapper::FileInPackageExists);
 asDECLARE_FUNCTION_WRAPPER(__FileExists,                    ETHScriptWrapper::FileExists);
@@ -243,7 +290,20 @@ asDECLARE_FUNCTION_WRAPPER(__IsFixedTimeStep,				ETHScriptWrapper::IsFixedTimeSt
 asDECLARE_FUNCTION_WRAPPER(__GetFixedTimeStepValue,			ETHScriptWrapper::GetFixedTimeStepValue);
 asDECLARE_FUNCTION_WRAPPER(__SetFixedTimeStep,				ETHScriptWrapper::SetFixedTimeStep);
 asDECLARE_FUNCTION_WRAPPER(__SetFixedTimeStepValue,			ETHScriptWrapper::SetFixedTimeStepValue);
+asDECLARE_FUNCTION_WRAPPER(__SetFixedTimeStepInterpolation,		ETHScriptWrapper::SetFixedTimeStepInterpolation);
+asDECLARE_FUNCTION_WRAPPER(__IsFixedTimeStepInterpolationEnabled,	ETHScriptWrapper::IsFixedTimeStepInterpolationEnabled);
+asDECLARE_FUNCTION_WRAPPER(__SetStaticColliderMerging,		ETHScriptWrapper::SetStaticColliderMerging);
+asDECLARE_FUNCTION_WRAPPER(__IsStaticColliderMergingEnabled,	ETHScriptWrapper::IsStaticColliderMergingEnabled);
+asDECLARE_FUNCTION_WRAPPER(__SetMaxPhysicsSubSteps,			ETHScriptWrapper::SetMaxPhysicsSubSteps);
+asDECLARE_FUNCTION_WRAPPER(__GetMaxPhysicsSubSteps,			ETHScriptWrapper::GetMaxPhysicsSubSteps);
+asDECLARE_FUNCTION_WRAPPER(__SetPhysicsSolverThreads,		ETHScriptWrapper::SetPhysicsSolverThreads);
+asDECLARE_FUNCTION_WRAPPER(__GetPhysicsSolverThreads,		ETHScriptWrapper::GetPhysicsSolverThreads);
+asDECLARE_FUNCTION_WRAPPER(__RebuildPhysicsBroadPhase,		ETHScriptWrapper::RebuildPhysicsBroadPhase);
+asDECLARE_FUNCTION_WRAPPER(__GetNumPhysicsStepsLastFrame,	ETHScriptWrapper::GetNumPhysicsStepsLastFrame);
 asDECLARE_FUNCTION_WRAPPER(__GetCurrentPhysicsTimeStepMS,	ETHScriptWrapper::GetCurrentPhysicsTimeStepMS);
+asDECLARE_FUNCTION_WRAPPER(__GetNumContactEvents,			ETHScriptWrapper::GetNumContactEvents);
+asDECLARE_FUNCTION_WRAPPER(__GetNumContactCallbacks,		ETHScriptWrapper::GetNumContactCallbacks);
+asDECLARE_FUNCTION_WRAPPER(__GetContactCallbackTimeMS,		ETHScriptWrapper::GetContactCallbackTimeMS);
 
 asDECLARE_FUNCTION_WRAPPER(__SetFixedHeight, ETHScriptWrapper::SetFixedHeight);
 asDECLARE_FUNCTION_WRAPPER(__SetFixedWidth,  ETHScriptWrapper::SetFixedWidth);
@@ -301,6 +361,16 @@ void ETHScriptWrapper::RegisterGlobalFunctions(asIScriptEngine *pASEngine)
 	r = pASEngine->RegisterObjectMethod("ETHEntity", "void PlayParticleSystem(const uint)",     asFUNCTION(__PlayParticleSystem), asCALL_GENERIC); assert(r >= 0);
 	r = pASEngine->RegisterObjectMethod("ETHEntity", "void ResolveJoints()",                    asFUNCTION(__ResolveEntityJoints), asCALL_GENERIC); assert(r >= 0);
 
+	// ETHEntityArray bulk methods that depend on the scene
+	r = pASEngine->RegisterObjectMethod("ETHEntityArray", "void SetPositionXY(const vector2 &in)",                  asFUNCTION(__ArraySetPositionXY),   asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntityArray", "void AddToPositionXY(const vector2 &in)",                asFUNCTION(__ArrayAddToPositionXY), asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntityArray", "void SetPositionsXY(const vector2[] &in)",               asFUNCTION(__ArraySetPositionsXY),   asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntityArray", "void AddToPositionsXY(const vector2[] &in)",             asFUNCTION(__ArrayAddToPositionsXY), asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntityArray", "void GetPositionsXY(vector2[] &) const",                 asFUNCTION(__ArrayGetPositionsXY),   asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntityArray", "void GetAngles(float[] &) const",                        asFUNCTION(__ArrayGetAngles),        asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntityArray", "void GetFloats(const string &in, float[] &) const",      asFUNCTION(__ArrayGetFloats),        asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterObjectMethod("ETHEntityArray", "void DeleteEntities()",                                  asFUNCTION(__ArrayDeleteEntities),   asCALL_GENERIC); assert(r >= 0);
+
 	r = pASEngine->RegisterGlobalFunction("ETHEntity @SeekEntity(const string &in)", asFUNCTION(__SeekEntityStr), asCALL_GENERIC); assert(r >= 0);
 	r = pASEngine->RegisterGlobalFunction("ETHEntity @SeekEntity(const int)",        asFUNCTION(__SeekEntityInt), asCALL_GENERIC); assert(r >= 0);
 
@@ -321,6 +391,24 @@ void ETHScriptWrapper::RegisterGlobalFunctions(asIScriptEngine *pASEngine)
 	r = pASEngine->RegisterGlobalFunction("float UnitsPerSecond(const float)", asFUNCTION(__UnitsPerSecond), asCALL_GENERIC); assert(r >= 0);
 	r = pASEngine->RegisterGlobalFunction("void Exit()",                       asFUNCTION(__Exit),           asCALL_GENERIC); assert(r >= 0);
 	r = pASEngine->RegisterGlobalFunction("uint GetLastFrameElapsedTime()",    asFUNCTION(__GetLastFrameElapsedTime), asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("float GetLastFrameElapsedTimeF()",  asFUNCTION(__GetLastFrameElapsedTimeF), asCALL_GENERIC); assert(r >= 0);
+
+	r = pASEngine->RegisterGlobalFunction("void SetMaxFrameRate(const float)",         asFUNCTION(__SetMaxFrameRate),         asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("float GetMaxFrameRate()",                   asFUNCTION(__GetMaxFrameRate),         asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("float GetFrameTimePercentile(const float)",  asFUNCTION(__GetFrameTimePercentile),  asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("float GetUpdateTimePercentile(const float)", asFUNCTION(__GetUpdateTimePercentile), asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("float GetRenderTimePercentile(const float)", asFUNCTION(__GetRenderTimePercentile), asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("void ResetFrameTimeStats()",                asFUNCTION(__ResetFrameTimeStats),     asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("void LogFrameTimeStats()",                  asFUNCTION(__LogFrameTimeStats),       asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("bool IsAllocationTrackingEnabled()",        asFUNCTION(__IsAllocationTrackingEnabled), asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("uint GetFrameAllocationCount()",            asFUNCTION(__GetFrameAllocationCount),     asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("uint64 GetFrameAllocatedBytes()",           asFUNCTION(__GetFrameAllocatedBytes),      asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("uint GetPeakFrameAllocationCount()",        asFUNCTION(__GetPeakFrameAllocationCount), asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("uint GetTotalAllocationCount()",            asFUNCTION(__GetTotalAllocationCount),     asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("uint64 GetLiveAllocatedBytes()",            asFUNCTION(__GetLiveAllocatedBytes),       asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("uint64 GetPeakAllocatedBytes()",            asFUNCTION(__GetPeakAllocatedBytes),       asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("void ResetAllocationStats()",               asFUNCTION(__ResetAllocationStats),        asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("void LogAllocationStats()",                 asFUNCTION(__LogAllocationStats),          asCALL_GENERIC); assert(r >= 0);
 
 	r = pASEngine->RegisterGlobalFunction("int AddEntity(const string &in, const vector3 &in, const float angle = 0.0f)", asFUNCTION(__AddEntityA), asCALL_GENERIC); assert(r >= 0);
 	r = pASEngine->RegisterGlobalFunction("int AddEntity(const string &in, const vector3 &in, ETHEntity@ &out)",    asFUNCTION(__AddEntityR), asCALL_GENERIC); assert(r >= 0);
@@ -330,6 +418,15 @@ void ETHScriptWrapper::RegisterGlobalFunctions(asIScriptEngine *pASEngine)
 	r = pASEngine->RegisterGlobalFunction("int AddEntity(const string &in, const vector3 &in, const float, ETHEntity@ &out, const string &in, const float)", asFUNCTION(__AddEntityF), asCALL_GENERIC); assert(r >= 0);
 
 	r = pASEngine->RegisterGlobalFunction("ETHEntity@ DeleteEntity(ETHEntity@)",										  asFUNCTION(__DeleteEntity),      asCALL_GENERIC); assert(r >= 0);
+
+	r = pASEngine->RegisterGlobalFunction("void SetEntityPoolSize(const string &in, const uint)",  asFUNCTION(__SetEntityPoolSize),        asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("uint GetEntityPoolSize(const string &in)",              asFUNCTION(__GetEntityPoolSize),        asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("uint GetEntityPoolHits(const string &in)",              asFUNCTION(__GetEntityPoolHits),        asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("uint GetEntityPoolMisses(const string &in)",            asFUNCTION(__GetEntityPoolMisses),      asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("uint GetNumIdlePooledEntities(const string &in)",       asFUNCTION(__GetNumIdlePooledEntities), asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("void ClearEntityPool()",                                asFUNCTION(__ClearEntityPool),          asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("uint GetParticleEffectRecycledSpawns()",                asFUNCTION(__GetParticleEffectRecycledSpawns),    asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("uint GetParticleEffectAllocatedManagers()",             asFUNCTION(__GetParticleEffectAllocatedManagers), asCALL_GENERIC); assert(r >= 0);
 	r = pASEngine->RegisterGlobalFunction("bool GenerateLightmaps()",													  asFUNCTION(__GenerateLightmaps), asCALL_GENERIC); assert(r >= 0);
 	r = pASEngine->RegisterGlobalFunction("void AddLight(const vector3 &in, const vector3 &in, const float, const bool)", asFUNCTION(__AddLight),          asCALL_GENERIC); assert(r >= 0);
 
@@ -381,6 +478,10 @@ void ETHScriptWrapper::RegisterGlobalFunctions(asIScriptEngine *pASEngine)
 	r = pASEngine->RegisterGlobalFunction("bool SetSampleSpeed(const string &in, const float)",  asFUNCTION(__SetSampleSpeed),  asCALL_GENERIC); assert(r >= 0);
 	r = pASEngine->RegisterGlobalFunction("bool SampleExists(const string &in)",                 asFUNCTION(__SampleExists),    asCALL_GENERIC); assert(r >= 0);
 	r = pASEngine->RegisterGlobalFunction("bool IsSamplePlaying(const string &in)",              asFUNCTION(__IsSamplePlaying), asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("bool PlaySampleVoice(const string &in, const float volume = 1.0f, const float pan = 0.0f, const float speed = 1.0f)", asFUNCTION(__PlaySampleVoice), asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("bool SetSampleMaxVoices(const string &in, const uint)", asFUNCTION(__SetSampleMaxVoices), asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("uint GetSampleMaxVoices(const string &in)",             asFUNCTION(__GetSampleMaxVoices), asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("uint GetNumSampleVoices(const string &in)",             asFUNCTION(__GetNumSampleVoices), asCALL_GENERIC); assert(r >= 0);
 	r = pASEngine->RegisterGlobalFunction("void SetGlobalVolume(const float)",                   asFUNCTION(__SetGlobalVolume), asCALL_GENERIC); assert(r >= 0);
 	r = pASEngine->RegisterGlobalFunction("float GetGlobalVolume()",							 asFUNCTION(__GetGlobalVolume), asCALL_GENERIC); assert(r >= 0);
 
@@ -451,6 +552,8 @@ void ETHScriptWrapper::RegisterGlobalFunctions(asIScriptEngine *pASEngine)
 	r = pASEngine->RegisterGlobalFunction("string GetAbsolutePath(const string &in)",   asFUNCTION(__GetAbsolutePath),               asCALL_GENERIC); assert(r >= 0);
 	r = pASEngine->RegisterGlobalFunction("vector2 GetLastCameraPos()",                 asFUNCTION(__GetLastCameraPos),              asCALL_GENERIC); assert(r >= 0);
 	r = pASEngine->RegisterGlobalFunction("int GetNumRenderedEntities()",               asFUNCTION(__GetNumRenderedEntities),        asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("uint GetFrameScratchWatermark()",           asFUNCTION(__GetFrameScratchWatermark),      asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("uint GetScratchHighWatermark()",            asFUNCTION(__GetScratchHighWatermark),       asCALL_GENERIC); assert(r >= 0);
 	r = pASEngine->RegisterGlobalFunction("int parseInt(const string &in)",             asFUNCTION(__ParseInt),                      asCALL_GENERIC); assert(r >= 0);
 	r = pASEngine->RegisterGlobalFunction("uint parseUInt(const string &in)",           asFUNCTION(__ParseUInt),                     asCALL_GENERIC); assert(r >= 0);
 	r = pASEngine->RegisterGlobalFunction("float parseFloat(const string &in)",         asFUNCTION(__ParseFloat),                    asCALL_GENERIC); assert(r >= 0);
@@ -478,6 +581,13 @@ void ETHScriptWrapper::RegisterGlobalFunctions(asIScriptEngine *pASEngine)
 	r = pASEngine->RegisterGlobalFunction("void ReleaseResources()",                  asFUNCTION(__ReleaseResources),              asCALL_GENERIC); assert(r >= 0);
 	r = pASEngine->RegisterGlobalFunction("void ResolveJoints()",                     asFUNCTION(__ResolveJoints),                 asCALL_GENERIC); assert(r >= 0);
 	r = pASEngine->RegisterGlobalFunction("void SetFastGarbageCollector(const bool)", asFUNCTION(__SetFastGarbageCollector),       asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("void SetGarbageCollectorBudget(const uint)", asFUNCTION(__SetGarbageCollectorBudget),   asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("uint GetGarbageCollectorBudget()",         asFUNCTION(__GetGarbageCollectorBudget),     asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("uint GetGCObjectCount()",                  asFUNCTION(__GetGCObjectCount),              asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("uint GetGCDestroyedCount()",               asFUNCTION(__GetGCDestroyedCount),           asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("uint GetGCDetectedCount()",                asFUNCTION(__GetGCDetectedCount),            asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("float GetGCTimePercentile(const float)",   asFUNCTION(__GetGCTimePercentile),           asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("void SetLogLevel(const uint)",             asFUNCTION(__SetLogLevel),                   asCALL_GENERIC); assert(r >= 0);
 	r = pASEngine->RegisterGlobalFunction("bool IsHighEndDevice()",                   asFUNCTION(__IsHighEndDevice),               asCALL_GENERIC); assert(r >= 0);
 	r = pASEngine->RegisterGlobalFunction("string GetPlatformName()",                 asFUNCTION(__GetPlatformName),               asCALL_GENERIC); assert(r >= 0);
 
@@ -509,7 +619,20 @@ void ETHScriptWrapper::RegisterGlobalFunctions(asIScriptEngine *pASEngine)
 	r = pASEngine->RegisterGlobalFunction("float GetFixedTimeStepValue()",			 asFUNCTION(__GetFixedTimeStepValue),	    asCALL_GENERIC); assert(r >= 0);
 	r = pASEngine->RegisterGlobalFunction("void SetFixedTimeStep(const bool)",		 asFUNCTION(__SetFixedTimeStep),			asCALL_GENERIC); assert(r >= 0);
 	r = pASEngine->RegisterGlobalFunction("void SetFixedTimeStepValue(const float)", asFUNCTION(__SetFixedTimeStepValue),       asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("void SetFixedTimeStepInterpolation(const bool)", asFUNCTION(__SetFixedTimeStepInterpolation),       asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("bool IsFixedTimeStepInterpolationEnabled()",     asFUNCTION(__IsFixedTimeStepInterpolationEnabled), asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("void SetStaticColliderMerging(const bool)",      asFUNCTION(__SetStaticColliderMerging),            asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("bool IsStaticColliderMergingEnabled()",          asFUNCTION(__IsStaticColliderMergingEnabled),      asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("void SetMaxPhysicsSubSteps(const uint)",         asFUNCTION(__SetMaxPhysicsSubSteps),               asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("uint GetMaxPhysicsSubSteps()",                   asFUNCTION(__GetMaxPhysicsSubSteps),               asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("void SetPhysicsSolverThreads(const uint)",       asFUNCTION(__SetPhysicsSolverThreads),             asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("uint GetPhysicsSolverThreads()",                 asFUNCTION(__GetPhysicsSolverThreads),             asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("void RebuildPhysicsBroadPhase()",                asFUNCTION(__RebuildPhysicsBroadPhase),            asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("uint GetNumPhysicsStepsLastFrame()",             asFUNCTION(__GetNumPhysicsStepsLastFrame),         asCALL_GENERIC); assert(r >= 0);
 	r = pASEngine->RegisterGlobalFunction("float GetCurrentPhysicsTimeStepMS()",	 asFUNCTION(__GetCurrentPhysicsTimeStepMS), asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("uint GetNumContactEvents()",			 asFUNCTION(__GetNumContactEvents),         asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("uint GetNumContactCallbacks()",		 asFUNCTION(__GetNumContactCallbacks),      asCALL_GENERIC); assert(r >= 0);
+	r = pASEngine->RegisterGlobalFunction("float GetContactCallbackTimeMS()",	 asFUNCTION(__GetContactCallbackTimeMS),    asCALL_GENERIC); assert(r >= 0);
 
 	r = pASEngine->RegisterGlobalFunction("void SetFixedHeight(const float)", asFUNCTION(__SetFixedHeight), asCALL_GENERIC); assert(r >= 0);
 	r = pASEngine->RegisterGlobalFunction("void SetFixedWidth(const float)",  asFUNCTION(__SetFixedWidth),  asCALL_GENERIC); assert(r >= 0);
@@ -27,8 +27,14 @@
 
 #include "../Util/ETHInput.h"
 #include "../Util/ETHSpeedTimer.h"
+#include "../Util/ETHFrameTimeHistogram.h"
+#include "../Util/ETHAllocationTracker.h"
+
+#include "ETHGarbageCollector.h"
 
 #include "../Entity/ETHEntityCache.h"
+#include "../Entity/ETHEntityPool.h"
+#include "../Particles/ETHParticleEffectCache.h"
 
 #include "../Drawing/ETHDrawableManager.h"
 
@@ -36,25 +42,29 @@
 
 #include "../../angelscript/include/angelscript.h"
 
+class CScriptArray;
+
 class ETHScriptWrapper
 {
 	static str_type::string m_sceneFileName;
 	static bool m_roundUpPosition;
 	static bool m_runningMainFunction;
 	static bool m_persistentResources;
-	static unsigned long m_lastFrameElapsedTime;
+	static bool m_mergeStaticColliders;
+	static float m_lastFrameElapsedTime;
 	
 protected:
 	static Platform::FileManagerPtr m_expansionFileManager;
 
-	static void SetLastFrameElapsedTime(const unsigned long lastFrameElapsedTime);
+	static void SetLastFrameElapsedTime(const float lastFrameElapsedTime);
 
 	enum GARBAGE_COLLECT_MODE
 	{
-		ONE_STEP = 0, DESTROY_ALL_GARBAGE = 1, FULL_CYCLE = 2
+		ONE_STEP = 0, DESTROY_ALL_GARBAGE = 1, FULL_CYCLE = 2, ADAPTIVE = 3
 	};
 
 	static GARBAGE_COLLECT_MODE m_gcMode;
+	static ETHGarbageCollector m_garbageCollector;
 
 	static void DrawBlackCurtain();
 
@@ -102,6 +112,13 @@ public:
 	static asIScriptFunction* m_onResumeFunction;
 
 	static ETHEntityCache m_entityCache;
+	static ETHEntityPoolPtr m_entityPool;
+	static ETHParticleEffectCache m_particleEffectCache;
+
+	static Platform::FrameLimiter m_frameLimiter;
+	static ETHFrameTimeHistogram m_frameTimeHistogram;
+	static ETHFrameTimeHistogram m_updateTimeHistogram;
+	static ETHFrameTimeHistogram m_renderTimeHistogram;
 
 	class ETH_NEXT_SCENE
 	{
@@ -190,6 +207,16 @@ public:
 	static Vector2 GetCurrentBucket(ETHEntity *pEntity);
 	static void PlayParticleSystem(ETHEntity *pEntity, const unsigned int n);
 
+	// ETHEntityArray bulk operations that depend on the scene
+	static void SetPositionXY(ETHEntityArray *pArray, const Vector2 &v2Pos);
+	static void AddToPositionXY(ETHEntityArray *pArray, const Vector2 &v2Pos);
+	static void SetPositionsXY(ETHEntityArray *pArray, const CScriptArray &positions);
+	static void AddToPositionsXY(ETHEntityArray *pArray, const CScriptArray &offsets);
+	static void GetPositionsXY(const ETHEntityArray *pArray, CScriptArray &outPositions);
+	static void GetAngles(const ETHEntityArray *pArray, CScriptArray &outAngles);
+	static void GetFloats(const ETHEntityArray *pArray, const str_type::string &name, CScriptArray &outValues);
+	static void DeleteEntities(ETHEntityArray *pArray);
+
 	static void SetPositionX(ETHEntity *pEntity, const float v);
 	static void SetPositionY(ETHEntity *pEntity, const float v);
 	static void SetPositionZ(ETHEntity *pEntity, const float v);
@@ -243,6 +270,15 @@ public:
 	static int AddEntity(const str_type::string &file, const Vector3 &v3Pos, ETHEntity **ppOutEntity);
 	static int AddEntity(const str_type::string &file, const Vector3 &v3Pos, const str_type::string &alternativeName);
 	static ETHEntity *DeleteEntity(ETHEntity *pEntity);
+	static void SetEntityPoolSize(const str_type::string &file, const unsigned int size);
+	static unsigned int GetEntityPoolSize(const str_type::string &file);
+	static unsigned int GetEntityPoolHits(const str_type::string &file);
+	static unsigned int GetEntityPoolMisses(const str_type::string &file);
+	static unsigned int GetNumIdlePooledEntities(const str_type::string &file);
+	static void ClearEntityPool();
+	static unsigned int GetParticleEffectRecycledSpawns();
+	static unsigned int GetParticleEffectAllocatedManagers();
+	static void ClearParticleEffectCache();
 	static bool GenerateLightmaps();
 	static void ReadLightmapsFromBitmapFiles();
 	static void LoadLightmaps();
@@ -259,6 +295,10 @@ public:
 	static bool SetSampleSpeed(const str_type::string &file, const float speed);
 	static bool SampleExists(const str_type::string &file);
 	static bool IsSamplePlaying(const str_type::string &file);
+	static bool PlaySampleVoice(const str_type::string &file, const float volume, const float pan, const float speed);
+	static bool SetSampleMaxVoices(const str_type::string &file, const unsigned int maxVoices);
+	static unsigned int GetSampleMaxVoices(const str_type::string &file);
+	static unsigned int GetNumSampleVoices(const str_type::string &file);
 	static void SetGlobalVolume(const float volume);
 	static float GetGlobalVolume();
 	static unsigned int GetNumEntities();
@@ -316,6 +356,8 @@ public:
 	static void GetVisibleEntities(ETHEntityArray &entityArray);
 	static void GetIntersectingEntities(const Vector2 &v2Here, ETHEntityArray &outVector, const bool screenSpace);
 	static int GetNumRenderedEntities();
+	static unsigned int GetFrameScratchWatermark();
+	static unsigned int GetScratchHighWatermark();
 	static void SetBorderBucketsDrawing(const bool enable);
 	static bool IsDrawingBorderBuckets();
 	static int GetArgc();
@@ -334,6 +376,13 @@ public:
 
 	static void GarbageCollect(const GARBAGE_COLLECT_MODE mode, asIScriptEngine* engine);
 	static void SetFastGarbageCollector(const bool enable);
+	static void SetGarbageCollectorBudget(const unsigned int budgetUS);
+	static unsigned int GetGarbageCollectorBudget();
+	static unsigned int GetGCObjectCount();
+	static unsigned int GetGCDestroyedCount();
+	static unsigned int GetGCDetectedCount();
+	static float GetGCTimePercentile(const float percentile);
+	static void SetLogLevel(const unsigned int level);
 
 	static bool EnablePackLoading(const str_type::string& packFileName, const str_type::string& password);
 	static bool IsPackLoadingEnabled();
@@ -367,6 +416,23 @@ public:
 	static void PrintInt(const int n);
 	static void PrintUInt(const unsigned int n);
 	static unsigned long GetLastFrameElapsedTime();
+	static float GetLastFrameElapsedTimeF();
+	static void SetMaxFrameRate(const float fps);
+	static float GetMaxFrameRate();
+	static float GetFrameTimePercentile(const float percentile);
+	static float GetUpdateTimePercentile(const float percentile);
+	static float GetRenderTimePercentile(const float percentile);
+	static void ResetFrameTimeStats();
+	static void LogFrameTimeStats();
+	static bool IsAllocationTrackingEnabled();
+	static unsigned int GetFrameAllocationCount();
+	static boost::uint64_t GetFrameAllocatedBytes();
+	static unsigned int GetPeakFrameAllocationCount();
+	static unsigned int GetTotalAllocationCount();
+	static boost::uint64_t GetLiveAllocatedBytes();
+	static boost::uint64_t GetPeakAllocatedBytes();
+	static void ResetAllocationStats();
+	static void LogAllocationStats();
 	static str_type::string GetStringFromFileInPackage(const str_type::string& fileName);
 	static bool FileInPackageExists(const str_type::string& fileName);
 	static bool FileExists(const str_type::string& fileName);
@@ -381,7 +447,20 @@ public:
 	static float GetFixedTimeStepValue();
 	static void SetFixedTimeStep(const bool enable);
 	static void SetFixedTimeStepValue(const float value);
+	static void SetFixedTimeStepInterpolation(const bool enable);
+	static bool IsFixedTimeStepInterpolationEnabled();
+	static void SetStaticColliderMerging(const bool enable);
+	static bool IsStaticColliderMergingEnabled();
+	static void SetMaxPhysicsSubSteps(const unsigned int maxSubSteps);
+	static unsigned int GetMaxPhysicsSubSteps();
+	static void SetPhysicsSolverThreads(const unsigned int count);
+	static unsigned int GetPhysicsSolverThreads();
+	static void RebuildPhysicsBroadPhase();
+	static unsigned int GetNumPhysicsStepsLastFrame();
 	static float GetCurrentPhysicsTimeStepMS();
+	static unsigned int GetNumContactEvents();
+	static unsigned int GetNumContactCallbacks();
+	static float GetContactCallbackTimeMS();
 	static void DisableContact();
 
 	static ETHEntity* GetClosestContact(const Vector2& a, const Vector2& b, Vector2& point, Vector2& normal);
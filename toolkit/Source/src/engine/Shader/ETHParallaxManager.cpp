@@ -68,6 +68,10 @@ float ETHParallaxManager::GetIntensity() const
 void ETHParallaxManager::SetShaderParameters(const VideoConstPtr& video, const ShaderPtr& shader, const Vector3& entityPos,
 											 const float& individualParallaxIntensity, const bool drawToTarget) const
 {
+	static const Shader::CONSTANT_HANDLE ENTITY_POS_3D_HANDLE = Shader::GetConstantHandle(GS_L("entityPos3D"));
+	static const Shader::CONSTANT_HANDLE PARALLAX_INTENSITY_HANDLE = Shader::GetConstantHandle(GS_L("parallaxIntensity"));
+	static const Shader::CONSTANT_HANDLE PARALLAX_ORIGIN_VERTICAL_INTENSITY_HANDLE = Shader::GetConstantHandle(GS_L("parallaxOrigin_verticalIntensity"));
+
 	const float parallaxIntensity = (drawToTarget) ? 0.0f : (GetIntensity() * individualParallaxIntensity);
 	const Vector2 origin(GetInScreenOrigin(video));
 	const float verticalIntensity = GetVerticalIntensity();
@@ -80,9 +84,9 @@ void ETHParallaxManager::SetShaderParameters(const VideoConstPtr& video, const S
 		params[3] = Vector2(verticalIntensity, verticalIntensity);
 		GLES2Sprite::AttachParametersToOptimalRenderer(params);
 	#else
-		shader->SetConstant(GS_L("entityPos3D"), entityPos);
-		shader->SetConstant(GS_L("parallaxIntensity"), parallaxIntensity);
-		shader->SetConstant(GS_L("parallaxOrigin_verticalIntensity"), Vector3(origin, verticalIntensity));
+		shader->SetConstant(ENTITY_POS_3D_HANDLE, entityPos);
+		shader->SetConstant(PARALLAX_INTENSITY_HANDLE, parallaxIntensity);
+		shader->SetConstant(PARALLAX_ORIGIN_VERTICAL_INTENSITY_HANDLE, Vector3(origin, verticalIntensity));
 	#endif
 }
 
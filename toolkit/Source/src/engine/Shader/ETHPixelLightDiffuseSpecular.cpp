@@ -53,6 +53,15 @@ ETHPixelLightDiffuseSpecular::ETHPixelLightDiffuseSpecular(
 bool ETHPixelLightDiffuseSpecular::BeginLightPass(ETHSpriteEntity *pRender, Vector3 &v3LightPos, const Vector2 &v2Size,
 	const ETHLight* light, const float maxHeight, const float minHeight, const float lightIntensity, const bool drawToTarget)
 {
+	static const Shader::CONSTANT_HANDLE SPECULAR_POWER_HANDLE = Shader::GetConstantHandle(GS_L("specularPower"));
+	static const Shader::CONSTANT_HANDLE SPECULAR_BRIGHTNESS_HANDLE = Shader::GetConstantHandle(GS_L("specularBrightness"));
+	static const Shader::CONSTANT_HANDLE FAKE_EYE_POS_HANDLE = Shader::GetConstantHandle(GS_L("fakeEyePos"));
+	static const Shader::CONSTANT_HANDLE SPACE_LENGTH_HANDLE = Shader::GetConstantHandle(GS_L("spaceLength"));
+	static const Shader::CONSTANT_HANDLE TOP_LEFT_3D_POS_HANDLE = Shader::GetConstantHandle(GS_L("topLeft3DPos"));
+	static const Shader::CONSTANT_HANDLE LIGHT_POS_HANDLE = Shader::GetConstantHandle(GS_L("lightPos"));
+	static const Shader::CONSTANT_HANDLE SQUARED_RANGE_HANDLE = Shader::GetConstantHandle(GS_L("squaredRange"));
+	static const Shader::CONSTANT_HANDLE LIGHT_COLOR_HANDLE = Shader::GetConstantHandle(GS_L("lightColor"));
+
 	const Vector2 &v2Origin = pRender->ComputeAbsoluteOrigin(v2Size);
 	const Vector3 &v3EntityPos = pRender->GetPosition();
 
@@ -85,10 +94,10 @@ bool ETHPixelLightDiffuseSpecular::BeginLightPass(ETHSpriteEntity *pRender, Vect
 	// if it has a gloss map, send specular data to shader
 	if (hasGloss)
 	{
-		pLightShader->SetConstant(GS_L("specularPower"), pRender->GetSpecularPower());
-		pLightShader->SetConstant(GS_L("specularBrightness"), pRender->GetSpecularBrightness());
+		pLightShader->SetConstant(SPECULAR_POWER_HANDLE, pRender->GetSpecularPower());
+		pLightShader->SetConstant(SPECULAR_BRIGHTNESS_HANDLE, pRender->GetSpecularBrightness());
 		pLightShader->SetTexture(GS_L("glossMap"), pRender->GetGloss()->GetTexture());
-		pLightShader->SetConstant(GS_L("fakeEyePos"), m_fakeEyeManager->ComputeFakeEyePosition(m_video, pLightShader, drawToTarget, v3LightPos, pRender->GetAngle()));
+		pLightShader->SetConstant(FAKE_EYE_POS_HANDLE, m_fakeEyeManager->ComputeFakeEyePosition(m_video, pLightShader, drawToTarget, v3LightPos, pRender->GetAngle()));
 	}
 
 	// choose which normalmap to use
@@ -105,13 +114,13 @@ bool ETHPixelLightDiffuseSpecular::BeginLightPass(ETHSpriteEntity *pRender, Vect
 	// sets spatial information to the shader
 	if (pRender->GetType() == ETHEntityProperties::ET_VERTICAL)
 	{
-		m_vPixelLightVS->SetConstant(GS_L("spaceLength"), (maxHeight-minHeight));
-		m_vPixelLightVS->SetConstant(GS_L("topLeft3DPos"), v3EntityPos-(Vector3(v2Origin.x,0,-v2Origin.y)));
+		m_vPixelLightVS->SetConstant(SPACE_LENGTH_HANDLE, (maxHeight-minHeight));
+		m_vPixelLightVS->SetConstant(TOP_LEFT_3D_POS_HANDLE, v3EntityPos-(Vector3(v2Origin.x,0,-v2Origin.y)));
 		m_video->SetVertexShader(m_vPixelLightVS);
 	}
 	else
 	{
-		m_hPixelLightVS->SetConstant(GS_L("topLeft3DPos"), v3EntityPos-Vector3(v2Origin,0));
+		m_hPixelLightVS->SetConstant(TOP_LEFT_3D_POS_HANDLE, v3EntityPos-Vector3(v2Origin,0));
 		m_video->SetVertexShader(m_hPixelLightVS);
 	}
 
@@ -139,11 +148,11 @@ bool ETHPixelLightDiffuseSpecular::BeginLightPass(ETHSpriteEntity *pRender, Vect
 	 	lightPrecisionDownScale = LIGHT_PRECISION_DOWNSCALE;
  	#endif
 
-	pLightShader->SetConstant(GS_L("lightPos"), v3LightPos * lightPrecisionDownScale);
+	pLightShader->SetConstant(LIGHT_POS_HANDLE, v3LightPos * lightPrecisionDownScale);
 
 	const float scaledRange = (light->range * lightPrecisionDownScale);
-	pLightShader->SetConstant(GS_L("squaredRange"), scaledRange * scaledRange);
-	pLightShader->SetConstant(GS_L("lightColor"), Vector4(light->color, 1.0f) * lightIntensity);
+	pLightShader->SetConstant(SQUARED_RANGE_HANDLE, scaledRange * scaledRange);
+	pLightShader->SetConstant(LIGHT_COLOR_HANDLE, Vector4(light->color, 1.0f) * lightIntensity);
 
 	return true;
 }
@@ -99,17 +99,20 @@ SpritePtr ETHShaderManager::GetProjShadow()
 
 bool ETHShaderManager::BeginAmbientPass(const ETHSpriteEntity *pRender, const float maxHeight, const float minHeight)
 {
+	static const Shader::CONSTANT_HANDLE HIGHLIGHT_HANDLE = Shader::GetConstantHandle(GS_L("highlight"));
+	static const Shader::CONSTANT_HANDLE SPACE_LENGTH_HANDLE = Shader::GetConstantHandle(GS_L("spaceLength"));
+
 	const bool shouldUseHighlightPS = pRender->ShouldUseHighlightPixelShader();
 	m_video->SetPixelShader(shouldUseHighlightPS ? m_highlightPS : ShaderPtr());
 
 	if (shouldUseHighlightPS)
 	{
-		m_highlightPS->SetConstant(GS_L("highlight"), pRender->GetColorARGB());
+		m_highlightPS->SetConstant(HIGHLIGHT_HANDLE, pRender->GetColorARGB());
 	}
 
 	if (pRender->GetType() == ETHEntityProperties::ET_VERTICAL)
 	{
-		m_verticalStaticAmbientVS->SetConstant(GS_L("spaceLength"), (maxHeight-minHeight));
+		m_verticalStaticAmbientVS->SetConstant(SPACE_LENGTH_HANDLE, (maxHeight-minHeight));
 		m_video->SetVertexShader(m_verticalStaticAmbientVS);
 	}
 	else
@@ -171,6 +174,8 @@ bool ETHShaderManager::EndLightPass()
 
 bool ETHShaderManager::BeginShadowPass(const ETHSpriteEntity *pRender, const ETHLight* light, const float maxHeight, const float minHeight)
 {
+	static const Shader::CONSTANT_HANDLE LIGHT_RANGE_HANDLE = Shader::GetConstantHandle(GS_L("lightRange"));
+
 	if (!light || !light->castShadows || !pRender->IsCastShadow()/* || pRender->GetType() != ETH_VERTICAL*/)
 		return false;
 
@@ -178,7 +183,7 @@ bool ETHShaderManager::BeginShadowPass(const ETHSpriteEntity *pRender, const ETH
 	m_video->SetAlphaMode(Video::AM_PIXEL);
 	m_video->SetVertexShader(m_shadowVS);
 
-	m_shadowVS->SetConstant(GS_L("lightRange"), light->range);
+	m_shadowVS->SetConstant(LIGHT_RANGE_HANDLE, light->range);
 	m_video->SetSpriteDepth(((pRender->GetPosition().z + ETH_SMALL_NUMBER - minHeight) / (maxHeight - minHeight)));
 	m_video->SetPixelShader(ShaderPtr());
 	return true;
@@ -46,6 +46,14 @@ bool ETHVertexLightDiffuse::BeginLightPass(
 	const float lightIntensity,
 	const bool drawToTarget)
 {
+	static const Shader::CONSTANT_HANDLE SPACE_LENGTH_HANDLE = Shader::GetConstantHandle(GS_L("spaceLength"));
+	static const Shader::CONSTANT_HANDLE TOP_LEFT_3D_POS_HANDLE = Shader::GetConstantHandle(GS_L("topLeft3DPos"));
+	static const Shader::CONSTANT_HANDLE PIVOT_ADJUST_HANDLE = Shader::GetConstantHandle(GS_L("pivotAdjust"));
+	static const Shader::CONSTANT_HANDLE LIGHT_POS_HANDLE = Shader::GetConstantHandle(GS_L("lightPos"));
+	static const Shader::CONSTANT_HANDLE LIGHT_RANGE_HANDLE = Shader::GetConstantHandle(GS_L("lightRange"));
+	static const Shader::CONSTANT_HANDLE LIGHT_COLOR_HANDLE = Shader::GetConstantHandle(GS_L("lightColor"));
+	static const Shader::CONSTANT_HANDLE LIGHT_INTENSITY_HANDLE = Shader::GetConstantHandle(GS_L("lightIntensity"));
+
 	GS2D_UNUSED_ARGUMENT(drawToTarget);
 	const Vector2 &v2Origin = pRender->ComputeAbsoluteOrigin(v2Size);
 	const Vector3 &v3EntityPos = pRender->GetPosition();
@@ -56,13 +64,13 @@ bool ETHVertexLightDiffuse::BeginLightPass(
 
 	if (pRender->GetType() == ETHEntityProperties::ET_VERTICAL)
 	{
-		m_vVertexLightVS->SetConstant(GS_L("spaceLength"), (maxHeight-minHeight));
-		m_vVertexLightVS->SetConstant(GS_L("topLeft3DPos"), v3EntityPos-(Vector3(v2Origin.x, 0, -v2Origin.y)));
+		m_vVertexLightVS->SetConstant(SPACE_LENGTH_HANDLE, (maxHeight-minHeight));
+		m_vVertexLightVS->SetConstant(TOP_LEFT_3D_POS_HANDLE, v3EntityPos-(Vector3(v2Origin.x, 0, -v2Origin.y)));
 		pLightShader = m_vVertexLightVS;
 	}
 	else
 	{
-		m_hVertexLightVS->SetConstant(GS_L("topLeft3DPos"), v3EntityPos-Vector3(v2Origin, 0));
+		m_hVertexLightVS->SetConstant(TOP_LEFT_3D_POS_HANDLE, v3EntityPos-Vector3(v2Origin, 0));
 		pLightShader = m_hVertexLightVS;
 	}
 	m_video->SetVertexShader(pLightShader);
@@ -73,11 +81,11 @@ bool ETHVertexLightDiffuse::BeginLightPass(
 	// Set a depth value depending on the entity type
 	pRender->SetDepth(maxHeight, minHeight);
  
-	pLightShader->SetConstant(GS_L("pivotAdjust"), pRender->GetProperties()->pivotAdjust);
-	pLightShader->SetConstant(GS_L("lightPos"), v3LightPos);
-	pLightShader->SetConstant(GS_L("lightRange"), light->range);
-	pLightShader->SetConstant(GS_L("lightColor"), light->color);
-	pLightShader->SetConstant(GS_L("lightIntensity"), lightIntensity);
+	pLightShader->SetConstant(PIVOT_ADJUST_HANDLE, pRender->GetProperties()->pivotAdjust);
+	pLightShader->SetConstant(LIGHT_POS_HANDLE, v3LightPos);
+	pLightShader->SetConstant(LIGHT_RANGE_HANDLE, light->range);
+	pLightShader->SetConstant(LIGHT_COLOR_HANDLE, light->color);
+	pLightShader->SetConstant(LIGHT_INTENSITY_HANDLE, lightIntensity);
 	return true;
 }
 
@@ -25,12 +25,14 @@
 #include <iostream>
 
 #include "../Resource/ETHResourceProvider.h"
+#include "ETHAllocationTracker.h"
 
 #include "../addons/scriptbuilder.h"
 
 namespace ETHGlobal {
 void ExecuteContext(asIScriptContext *pContext, asIScriptFunction* func, const bool prepare)
 {
+	ETH_ALLOCATION_SCOPE(SCRIPT);
 	if (prepare)
 	{
 		if (pContext->Prepare(func) < 0)
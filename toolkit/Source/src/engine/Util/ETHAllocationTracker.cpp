@@ -0,0 +1,361 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#include "ETHAllocationTracker.h"
+
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+#ifdef WIN32
+ #include <windows.h>
+#endif
+
+namespace {
+
+#ifdef ETH_ALLOCATION_TRACKING
+
+inline boost::int64_t AtomicAdd(volatile boost::int64_t* target, const boost::int64_t value)
+{
+	#ifdef WIN32
+		return InterlockedExchangeAdd64(reinterpret_cast<volatile LONGLONG*>(target), value) + value;
+	#else
+		return __sync_add_and_fetch(target, value);
+	#endif
+}
+
+volatile long g_currentTag = ETHAllocationTracker::UNTAGGED;
+volatile boost::int64_t g_numAllocations = 0;
+volatile boost::int64_t g_liveBytes = 0;
+volatile boost::int64_t g_peakLiveBytes = 0;
+volatile boost::int64_t g_frameAllocations[ETHAllocationTracker::NUM_TAGS] = { 0 };
+volatile boost::int64_t g_frameBytes[ETHAllocationTracker::NUM_TAGS] = { 0 };
+
+// only ever touched by its own thread, so ZeroAllocationScope ignores the logger, audio and save threads
+#ifdef _MSC_VER
+ __declspec(thread) boost::uint64_t g_threadNumAllocations = 0;
+#else
+ __thread boost::uint64_t g_threadNumAllocations = 0;
+#endif
+
+#endif
+
+// only touched by the main thread in BeginFrame
+boost::uint64_t g_lastFrameAllocations[ETHAllocationTracker::NUM_TAGS] = { 0 };
+boost::uint64_t g_lastFrameBytes[ETHAllocationTracker::NUM_TAGS] = { 0 };
+boost::uint64_t g_peakFrameAllocations = 0;
+boost::uint64_t g_peakFrameBytes = 0;
+
+} // namespace
+
+#ifdef ETH_ALLOCATION_TRACKING
+
+namespace {
+
+// keeps the returned block aligned for any type
+const std::size_t HEADER_SIZE = 16;
+
+struct BlockHeader
+{
+	std::size_t size;
+};
+
+void* TrackedAllocate(const std::size_t size)
+{
+	unsigned char* block = static_cast<unsigned char*>(std::malloc(size + HEADER_SIZE));
+	if (!block)
+		return 0;
+
+	reinterpret_cast<BlockHeader*>(block)->size = size;
+
+	const long tag = g_currentTag;
+	const boost::int64_t bytes = static_cast<boost::int64_t>(size);
+	AtomicAdd(&g_numAllocations, 1);
+	++g_threadNumAllocations;
+	AtomicAdd(&g_frameAllocations[tag], 1);
+	AtomicAdd(&g_frameBytes[tag], bytes);
+
+	// the peak is diagnostic: a lost update between threads is harmless
+	const boost::int64_t liveBytes = AtomicAdd(&g_liveBytes, bytes);
+	if (liveBytes > g_peakLiveBytes)
+		g_peakLiveBytes = liveBytes;
+
+	return block + HEADER_SIZE;
+}
+
+void TrackedFree(void* p)
+{
+	if (!p)
+		return;
+
+	unsigned char* block = static_cast<unsigned char*>(p) - HEADER_SIZE;
+	AtomicAdd(&g_liveBytes,-static_cast<boost::int64_t>(reinterpret_cast<BlockHeader*>(block)->size));
+	std::free(block);
+}
+
+void* TrackedNew(const std::size_t size)
+{
+	void* p = TrackedAllocate(size);
+	if (!p)
+		throw std::bad_alloc();
+	return p;
+}
+
+} // namespace
+
+#if __cplusplus >= 201103L
+ #define ETH_NEW_THROW_SPEC
+ #define ETH_DELETE_THROW_SPEC noexcept
+#else
+ #define ETH_NEW_THROW_SPEC throw(std::bad_alloc)
+ #define ETH_DELETE_THROW_SPEC throw()
+#endif
+
+void* operator new(std::size_t size) ETH_NEW_THROW_SPEC
+{
+	return TrackedNew(size);
+}
+
+void* operator new[](std::size_t size) ETH_NEW_THROW_SPEC
+{
+	return TrackedNew(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) throw()
+{
+	return TrackedAllocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) throw()
+{
+	return TrackedAllocate(size);
+}
+
+void operator delete(void* p) ETH_DELETE_THROW_SPEC
+{
+	TrackedFree(p);
+}
+
+void operator delete[](void* p) ETH_DELETE_THROW_SPEC
+{
+	TrackedFree(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) throw()
+{
+	TrackedFree(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) throw()
+{
+	TrackedFree(p);
+}
+
+#endif
+
+ETHAllocationTracker::Scope::Scope(const TAG tag) :
+	m_previous(SetCurrentTag(tag))
+{
+}
+
+ETHAllocationTracker::Scope::~Scope()
+{
+	SetCurrentTag(m_previous);
+}
+
+ETHAllocationTracker::ZeroAllocationScope::ZeroAllocationScope(const char* name) :
+	m_start(ETHAllocationTracker::GetThreadNumAllocations()),
+	m_name(name)
+{
+}
+
+ETHAllocationTracker::ZeroAllocationScope::~ZeroAllocationScope()
+{
+	#if defined(_DEBUG) || defined(DEBUG)
+	if (GetNumAllocations() != 0)
+	{
+		GS2D_CERR << GS_L("ZeroAllocationScope: ") << m_name << GS_L(" allocated ") << GetNumAllocations() << GS_L(" times") << std::endl;
+		assert(false);
+	}
+	#endif
+}
+
+boost::uint64_t ETHAllocationTracker::ZeroAllocationScope::GetNumAllocations() const
+{
+	return ETHAllocationTracker::GetThreadNumAllocations() - m_start;
+}
+
+bool ETHAllocationTracker::IsEnabled()
+{
+	#ifdef ETH_ALLOCATION_TRACKING
+		return true;
+	#else
+		return false;
+	#endif
+}
+
+ETHAllocationTracker::TAG ETHAllocationTracker::SetCurrentTag(const TAG tag)
+{
+	#ifdef ETH_ALLOCATION_TRACKING
+		const TAG previous = static_cast<TAG>(g_currentTag);
+		g_currentTag = tag;
+		return previous;
+	#else
+		return tag;
+	#endif
+}
+
+const char* ETHAllocationTracker::GetTagName(const TAG tag)
+{
+	switch (tag)
+	{
+	case SCENE:     return "scene";
+	case RENDER:    return "render";
+	case PHYSICS:   return "physics";
+	case SCRIPT:    return "script";
+	case RESOURCES: return "resources";
+	default:        return "untagged";
+	}
+}
+
+void ETHAllocationTracker::BeginFrame()
+{
+	#ifdef ETH_ALLOCATION_TRACKING
+		boost::uint64_t numAllocations = 0, bytes = 0;
+		for (int t = 0; t < NUM_TAGS; t++)
+		{
+			// subtract what was read instead of zeroing, so other threads don't lose counts
+			const boost::int64_t frameAllocations = g_frameAllocations[t];
+			const boost::int64_t frameBytes = g_frameBytes[t];
+			AtomicAdd(&g_frameAllocations[t],-frameAllocations);
+			AtomicAdd(&g_frameBytes[t],-frameBytes);
+			g_lastFrameAllocations[t] = static_cast<boost::uint64_t>(frameAllocations);
+			g_lastFrameBytes[t] = static_cast<boost::uint64_t>(frameBytes);
+			numAllocations += g_lastFrameAllocations[t];
+			bytes += g_lastFrameBytes[t];
+		}
+		if (numAllocations > g_peakFrameAllocations)
+			g_peakFrameAllocations = numAllocations;
+		if (bytes > g_peakFrameBytes)
+			g_peakFrameBytes = bytes;
+	#endif
+}
+
+void ETHAllocationTracker::ResetPeaks()
+{
+	g_peakFrameAllocations = 0;
+	g_peakFrameBytes = 0;
+	#ifdef ETH_ALLOCATION_TRACKING
+		g_peakLiveBytes = g_liveBytes;
+	#endif
+}
+
+boost::uint64_t ETHAllocationTracker::GetNumAllocations()
+{
+	#ifdef ETH_ALLOCATION_TRACKING
+		return static_cast<boost::uint64_t>(g_numAllocations);
+	#else
+		return 0;
+	#endif
+}
+
+boost::uint64_t ETHAllocationTracker::GetThreadNumAllocations()
+{
+	#ifdef ETH_ALLOCATION_TRACKING
+		return g_threadNumAllocations;
+	#else
+		return 0;
+	#endif
+}
+
+boost::uint64_t ETHAllocationTracker::GetLiveBytes()
+{
+	#ifdef ETH_ALLOCATION_TRACKING
+		return static_cast<boost::uint64_t>(g_liveBytes);
+	#else
+		return 0;
+	#endif
+}
+
+boost::uint64_t ETHAllocationTracker::GetPeakLiveBytes()
+{
+	#ifdef ETH_ALLOCATION_TRACKING
+		return static_cast<boost::uint64_t>(g_peakLiveBytes);
+	#else
+		return 0;
+	#endif
+}
+
+boost::uint64_t ETHAllocationTracker::GetFrameNumAllocations()
+{
+	boost::uint64_t r = 0;
+	for (int t = 0; t < NUM_TAGS; t++)
+		r += g_lastFrameAllocations[t];
+	return r;
+}
+
+boost::uint64_t ETHAllocationTracker::GetFrameNumAllocations(const TAG tag)
+{
+	return g_lastFrameAllocations[tag];
+}
+
+boost::uint64_t ETHAllocationTracker::GetFrameAllocatedBytes()
+{
+	boost::uint64_t r = 0;
+	for (int t = 0; t < NUM_TAGS; t++)
+		r += g_lastFrameBytes[t];
+	return r;
+}
+
+boost::uint64_t ETHAllocationTracker::GetFrameAllocatedBytes(const TAG tag)
+{
+	return g_lastFrameBytes[tag];
+}
+
+boost::uint64_t ETHAllocationTracker::GetPeakFrameNumAllocations()
+{
+	return g_peakFrameAllocations;
+}
+
+boost::uint64_t ETHAllocationTracker::GetPeakFrameAllocatedBytes()
+{
+	return g_peakFrameBytes;
+}
+
+gs2d::str_type::string ETHAllocationTracker::GetSummary()
+{
+	if (!IsEnabled())
+		return GS_L("allocation tracking disabled (build with ETH_ALLOCATION_TRACKING)");
+
+	gs2d::str_type::stringstream ss;
+	ss << GS_L("last frame: ") << GetFrameNumAllocations() << GS_L(" allocations, ") << GetFrameAllocatedBytes() << GS_L(" bytes (");
+	for (int t = 0; t < NUM_TAGS; t++)
+	{
+		ss << ((t > 0) ? GS_L(", ") : GS_L("")) << GetTagName(static_cast<TAG>(t)) << GS_L(" ") << g_lastFrameAllocations[t];
+	}
+	ss << GS_L(")") << std::endl
+		<< GS_L("peak frame: ") << GetPeakFrameNumAllocations() << GS_L(" allocations, ") << GetPeakFrameAllocatedBytes() << GS_L(" bytes") << std::endl
+		<< GS_L("live: ") << GetLiveBytes() << GS_L(" bytes, peak ") << GetPeakLiveBytes() << GS_L(" bytes, ")
+		<< GetNumAllocations() << GS_L(" allocations in total");
+	return ss.str();
+}
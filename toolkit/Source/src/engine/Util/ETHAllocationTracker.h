@@ -0,0 +1,108 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#ifndef ETH_ALLOCATION_TRACKER_H_
+#define ETH_ALLOCATION_TRACKER_H_
+
+#include <Types.h>
+
+#include <boost/cstdint.hpp>
+
+/**
+ * \brief Opt-in heap allocation instrumentation
+ *
+ * When the engine is built with ETH_ALLOCATION_TRACKING defined, the global operator
+ * new/delete are replaced with versions that count every allocation, tagged with the
+ * subsystem that was running when it happened. Without the define nothing is hooked,
+ * the scopes compile to nothing and every counter reads zero.
+ *
+ * Counters are updated atomically, so allocations from audio or loader threads are
+ * counted too, but they are tagged with whatever the main thread is doing. They are
+ * 64 bits wide so byte totals don't wrap at 2 GB where long is 32 bits.
+ */
+class ETHAllocationTracker
+{
+public:
+	enum TAG
+	{
+		UNTAGGED = 0,
+		SCENE,
+		RENDER,
+		PHYSICS,
+		SCRIPT,
+		RESOURCES,
+		NUM_TAGS
+	};
+
+	/// Tags every allocation made during its lifetime, restoring the previous tag when it ends
+	class Scope
+	{
+		TAG m_previous;
+	public:
+		Scope(const TAG tag);
+		~Scope();
+	};
+
+	/// Asserts (on debug builds) that the thread that created it allocated nothing before it goes out of scope
+	class ZeroAllocationScope
+	{
+		boost::uint64_t m_start;
+		const char* m_name;
+	public:
+		ZeroAllocationScope(const char* name);
+		~ZeroAllocationScope();
+		boost::uint64_t GetNumAllocations() const;
+	};
+
+	static bool IsEnabled();
+	static TAG SetCurrentTag(const TAG tag);
+	static const char* GetTagName(const TAG tag);
+
+	/// Closes the current frame's counters and starts a new frame. Call once per frame from the main thread
+	static void BeginFrame();
+	static void ResetPeaks();
+
+	static boost::uint64_t GetNumAllocations();
+	/// Allocations made so far by the calling thread only
+	static boost::uint64_t GetThreadNumAllocations();
+	static boost::uint64_t GetLiveBytes();
+	static boost::uint64_t GetPeakLiveBytes();
+
+	// counters of the last complete frame
+	static boost::uint64_t GetFrameNumAllocations();
+	static boost::uint64_t GetFrameNumAllocations(const TAG tag);
+	static boost::uint64_t GetFrameAllocatedBytes();
+	static boost::uint64_t GetFrameAllocatedBytes(const TAG tag);
+	static boost::uint64_t GetPeakFrameNumAllocations();
+	static boost::uint64_t GetPeakFrameAllocatedBytes();
+
+	/// Returns a multi-line report with the last frame's counters per subsystem and the high-water marks
+	static gs2d::str_type::string GetSummary();
+};
+
+#ifdef ETH_ALLOCATION_TRACKING
+ #define ETH_ALLOCATION_SCOPE(tag) ETHAllocationTracker::Scope _ethAllocationScope(ETHAllocationTracker::tag)
+#else
+ #define ETH_ALLOCATION_SCOPE(tag)
+#endif
+
+#endif
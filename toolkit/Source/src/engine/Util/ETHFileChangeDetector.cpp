@@ -22,56 +22,30 @@
 
 #include "ETHFileChangeDetector.h"
 
-const unsigned int ETHFileChangeDetector::m_timeStrideMS(2000);
+ETHFileChangeDetector::ETHFileChangeDetector(const gs2d::str_type::string& filePath) :
+	m_watcher(Platform::FileWatcher::GetSharedInstance()),
+	m_filePath(filePath)
+{
+	m_watch = m_watcher->AddFile(m_filePath);
+}
 
-ETHFileChangeDetector::ETHFileChangeDetector(const gs2d::ApplicationPtr& app, const gs2d::str_type::string& filePath, const ENCODING encoding) :
-	m_filePath(filePath),
-	m_fileChanged(false),
-	m_encoding(encoding),
-	m_app(app),
-	m_lastTime(m_timeStrideMS)
+ETHFileChangeDetector::~ETHFileChangeDetector()
 {
-	m_fileManager = app->GetFileIOHub()->GetFileManager();
-	Update();
-	m_fileChanged = false;
+	m_watcher->RemoveWatch(m_watch);
 }
 
 bool ETHFileChangeDetector::IsValidFile() const
 {
-	return !m_fileContent.empty();
+	Platform::FileWatcher::FILE_STATE state;
+	return (Platform::FileWatcher::GetFileState(m_filePath, state) && state.size > 0);
 }
 
 bool ETHFileChangeDetector::CheckForChange()
 {
-	const bool r = m_fileChanged;
-	m_fileChanged = false;
-	return r;
+	return m_watcher->ConsumeChange(m_watch);
 }
 
 void ETHFileChangeDetector::Update()
 {
-	if ((m_app->GetElapsedTime() - m_lastTime) > m_timeStrideMS)
-	{
-		gs2d::str_type::string newContent;
-		switch (m_encoding)
-		{
-		case ANSI:
-			m_fileManager->GetAnsiFileString(m_filePath, newContent);
-			break;
-		case UTF8_WITH_BOM:
-		case UTF16_WITH_BOM:
-			m_fileManager->GetUTFFileString(m_filePath, newContent);
-			break;
-		}
-		if (newContent.size() != m_fileContent.size())
-		{
-			m_fileChanged = true;
-		}
-		else if (newContent != m_fileContent)
-		{
-			m_fileChanged = true;
-		}
-		m_fileContent = newContent;
-		m_lastTime = m_app->GetElapsedTime();
-	}
+	m_watcher->Update();
 }
@@ -23,35 +23,29 @@
 #ifndef ETH_FILE_CHANGE_DETECTOR_H_
 #define ETH_FILE_CHANGE_DETECTOR_H_
 
-#include <Platform/FileManager.h>
-#include <Application.h>
-
+#include <Platform/FileWatcher.h>
+
+/**
+ * \brief Tells whether a file has been modified by someone else
+ *
+ * All detectors share the application-wide Platform::FileWatcher, so
+ * having many of them around costs nothing while the files are idle.
+ */
 class ETHFileChangeDetector
 {
-	gs2d::ApplicationPtr m_app;
-	Platform::FileManagerPtr m_fileManager;
+	Platform::FileWatcherPtr m_watcher;
+	Platform::FileWatcher::WATCH_ID m_watch;
 	gs2d::str_type::string m_filePath;
-	gs2d::str_type::string m_fileContent;
-	bool m_fileChanged;
-	static const unsigned int m_timeStrideMS;
-	unsigned long m_lastTime;
 
 public:
+	ETHFileChangeDetector(const gs2d::str_type::string& filePath);
+	~ETHFileChangeDetector();
 
-	enum ENCODING
-	{
-		ANSI = 0,
-		UTF8_WITH_BOM = 1,
-		UTF16_WITH_BOM = 2
-	};
-
-	ETHFileChangeDetector(const gs2d::ApplicationPtr& app, const gs2d::str_type::string& filePath, const ENCODING encoding);
 	bool IsValidFile() const;
+
+	/// Returns true once for any number of changes since the last call
 	bool CheckForChange();
 	void Update();
-
-private:
-	ENCODING m_encoding;
 };
 
 typedef boost::shared_ptr<ETHFileChangeDetector> ETHFileChangeDetectorPtr;
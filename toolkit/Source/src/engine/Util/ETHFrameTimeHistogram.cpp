@@ -0,0 +1,105 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#include "ETHFrameTimeHistogram.h"
+
+#include <Math/GameMath.h>
+
+#include <algorithm>
+
+const unsigned int ETHFrameTimeHistogram::NUM_BINS(1000);
+const float ETHFrameTimeHistogram::BIN_WIDTH_MS(0.1f);
+
+ETHFrameTimeHistogram::ETHFrameTimeHistogram() :
+	m_bins(NUM_BINS, 0)
+{
+	Reset();
+}
+
+void ETHFrameTimeHistogram::Add(const float timeMS)
+{
+	const float clampedTime = gs2d::math::Max(timeMS, 0.0f);
+	const unsigned int bin = gs2d::math::Min(static_cast<unsigned int>(clampedTime / BIN_WIDTH_MS), NUM_BINS - 1);
+	++m_bins[bin];
+	++m_numSamples;
+	m_sum += static_cast<double>(clampedTime);
+	m_max = gs2d::math::Max(m_max, clampedTime);
+}
+
+void ETHFrameTimeHistogram::Reset()
+{
+	std::fill(m_bins.begin(), m_bins.end(), 0);
+	m_numSamples = 0;
+	m_sum = 0.0;
+	m_max = 0.0f;
+}
+
+unsigned int ETHFrameTimeHistogram::GetNumSamples() const
+{
+	return m_numSamples;
+}
+
+float ETHFrameTimeHistogram::GetAverage() const
+{
+	return (m_numSamples > 0) ? static_cast<float>(m_sum / static_cast<double>(m_numSamples)) : 0.0f;
+}
+
+float ETHFrameTimeHistogram::GetMax() const
+{
+	return m_max;
+}
+
+float ETHFrameTimeHistogram::GetPercentile(const float percentile) const
+{
+	if (m_numSamples == 0)
+		return 0.0f;
+
+	const double rank = static_cast<double>(gs2d::math::Clamp(percentile, 0.0f, 100.0f)) / 100.0 * static_cast<double>(m_numSamples);
+	unsigned int accumulated = 0;
+	for (unsigned int t = 0; t < NUM_BINS; t++)
+	{
+		if (m_bins[t] == 0)
+			continue;
+
+		const unsigned int next = accumulated + m_bins[t];
+		if (static_cast<double>(next) >= rank)
+		{
+			// interpolate inside the bin assuming its samples are evenly spread
+			const double fraction = (rank - static_cast<double>(accumulated)) / static_cast<double>(m_bins[t]);
+			const float time = (static_cast<float>(t) + static_cast<float>(fraction)) * BIN_WIDTH_MS;
+			return gs2d::math::Min(time, m_max);
+		}
+		accumulated = next;
+	}
+	return m_max;
+}
+
+gs2d::str_type::string ETHFrameTimeHistogram::GetSummary() const
+{
+	gs2d::str_type::stringstream ss;
+	ss << GS_L("avg ") << GetAverage()
+	   << GS_L("ms, p50 ") << GetPercentile(50.0f)
+	   << GS_L("ms, p99 ") << GetPercentile(99.0f)
+	   << GS_L("ms, max ") << GetMax()
+	   << GS_L("ms (") << GetNumSamples() << GS_L(" samples)");
+	return ss.str();
+}
@@ -0,0 +1,64 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#ifndef ETH_FRAME_TIME_HISTOGRAM_H_
+#define ETH_FRAME_TIME_HISTOGRAM_H_
+
+#include <Types.h>
+#include <vector>
+
+/**
+ * \brief Fixed bin histogram of frame times
+ *
+ * Samples are counted in 0.1ms bins up to 100ms; anything slower lands
+ * in the last bin. Adding a sample never allocates, so it's cheap enough
+ * to keep running on every frame of a release build.
+ */
+class ETHFrameTimeHistogram
+{
+public:
+	static const unsigned int NUM_BINS;
+	static const float BIN_WIDTH_MS;
+
+	ETHFrameTimeHistogram();
+
+	void Add(const float timeMS);
+	void Reset();
+
+	unsigned int GetNumSamples() const;
+	float GetAverage() const;
+	float GetMax() const;
+
+	/// Returns the time below which the given percentage (0 to 100) of the samples lie
+	float GetPercentile(const float percentile) const;
+
+	/// Returns a one line summary with the average, median, 99th percentile and worst times
+	gs2d::str_type::string GetSummary() const;
+
+private:
+	std::vector<unsigned int> m_bins;
+	unsigned int m_numSamples;
+	double m_sum;
+	float m_max;
+};
+
+#endif
@@ -0,0 +1,537 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#include "ETHSaveData.h"
+
+#include <cstdio>
+#include <list>
+
+namespace {
+
+const unsigned char FILE_MAGIC[4] = { 'E', 'T', 'H', 'S' };
+const unsigned int FILE_VERSION = 1;
+const std::size_t HEADER_SIZE = 8;
+const std::size_t RECORD_HEADER_SIZE = 8;
+
+// journals smaller than this are never compacted
+const std::size_t MIN_COMPACTION_SIZE = 4096;
+
+enum RECORD_TYPE
+{
+	RECORD_SECTION = 1,
+	RECORD_REMOVE = 2
+};
+
+unsigned int Crc32(const unsigned char* data, const std::size_t size)
+{
+	static unsigned int table[256];
+	static bool tableReady = false;
+	if (!tableReady)
+	{
+		for (unsigned int n = 0; n < 256; n++)
+		{
+			unsigned int c = n;
+			for (unsigned int k = 0; k < 8; k++)
+				c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+			table[n] = c;
+		}
+		tableReady = true;
+	}
+
+	unsigned int crc = 0xFFFFFFFFu;
+	for (std::size_t t = 0; t < size; t++)
+		crc = table[(crc ^ data[t]) & 0xFF] ^ (crc >> 8);
+	return crc ^ 0xFFFFFFFFu;
+}
+
+void PutUInt32(std::vector<unsigned char>& out, const unsigned int value)
+{
+	out.push_back(static_cast<unsigned char>(value));
+	out.push_back(static_cast<unsigned char>(value >> 8));
+	out.push_back(static_cast<unsigned char>(value >> 16));
+	out.push_back(static_cast<unsigned char>(value >> 24));
+}
+
+void SetUInt32(std::vector<unsigned char>& out, const std::size_t pos, const unsigned int value)
+{
+	out[pos + 0] = static_cast<unsigned char>(value);
+	out[pos + 1] = static_cast<unsigned char>(value >> 8);
+	out[pos + 2] = static_cast<unsigned char>(value >> 16);
+	out[pos + 3] = static_cast<unsigned char>(value >> 24);
+}
+
+void PutString(std::vector<unsigned char>& out, const gs2d::str_type::string& str)
+{
+	PutUInt32(out, static_cast<unsigned int>(str.size()));
+	out.insert(out.end(), str.begin(), str.end());
+}
+
+class Reader
+{
+	const unsigned char* m_data;
+	std::size_t m_size;
+	std::size_t m_pos;
+
+public:
+	Reader(const unsigned char* data, const std::size_t size) : m_data(data), m_size(size), m_pos(0) { }
+
+	bool IsAtEnd() const { return m_pos == m_size; }
+
+	bool ReadByte(unsigned char& value)
+	{
+		if (m_pos >= m_size)
+			return false;
+		value = m_data[m_pos++];
+		return true;
+	}
+
+	bool ReadUInt32(unsigned int& value)
+	{
+		if (m_size - m_pos < 4)
+			return false;
+		const unsigned char* p = m_data + m_pos;
+		value = p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<unsigned int>(p[3]) << 24);
+		m_pos += 4;
+		return true;
+	}
+
+	bool ReadString(gs2d::str_type::string& str)
+	{
+		unsigned int length;
+		if (!ReadUInt32(length) || m_size - m_pos < length)
+			return false;
+		str.assign(reinterpret_cast<const char*>(m_data + m_pos), length);
+		m_pos += length;
+		return true;
+	}
+};
+
+template <class T>
+std::size_t GetRecordSize(const gs2d::str_type::string& name, const T& section)
+{
+	std::size_t size = RECORD_HEADER_SIZE + 1 + 4 + name.size() + 4;
+	for (typename T::const_iterator iter = section.begin(); iter != section.end(); ++iter)
+		size += 8 + iter->first.size() + iter->second.size();
+	return size;
+}
+
+std::size_t GetRemovalRecordSize(const gs2d::str_type::string& name)
+{
+	return RECORD_HEADER_SIZE + 1 + 4 + name.size();
+}
+
+// the record header is reserved first and filled in once the payload is known
+std::size_t BeginRecord(std::vector<unsigned char>& out, const RECORD_TYPE type, const gs2d::str_type::string& name)
+{
+	const std::size_t recordPos = out.size();
+	out.resize(recordPos + RECORD_HEADER_SIZE);
+	out.push_back(static_cast<unsigned char>(type));
+	PutString(out, name);
+	return recordPos;
+}
+
+void EndRecord(std::vector<unsigned char>& out, const std::size_t recordPos)
+{
+	const std::size_t payloadPos = recordPos + RECORD_HEADER_SIZE;
+	const std::size_t payloadSize = out.size() - payloadPos;
+	SetUInt32(out, recordPos, static_cast<unsigned int>(payloadSize));
+	SetUInt32(out, recordPos + 4, Crc32(&out[payloadPos], payloadSize));
+}
+
+template <class T>
+void PutSectionRecord(std::vector<unsigned char>& out, const gs2d::str_type::string& name, const T& section)
+{
+	const std::size_t recordPos = BeginRecord(out, RECORD_SECTION, name);
+	PutUInt32(out, static_cast<unsigned int>(section.size()));
+	for (typename T::const_iterator iter = section.begin(); iter != section.end(); ++iter)
+	{
+		PutString(out, iter->first);
+		PutString(out, iter->second);
+	}
+	EndRecord(out, recordPos);
+}
+
+bool IsEnmlName(const gs2d::str_type::string& name)
+{
+	if (name.empty())
+		return false;
+	for (std::size_t t = 0; t < name.size(); t++)
+	{
+		const char c = name[t];
+		if ((c < 'a' || c > 'z') && (c < 'A' || c > 'Z') && (c < '0' || c > '9') && c != '_')
+			return false;
+	}
+	return true;
+}
+
+} // namespace
+
+ETHSaveData::ETHSaveData() :
+	m_fileSize(0),
+	m_rewrite(true),
+	m_ref(1)
+{
+}
+
+ETHSaveData::~ETHSaveData()
+{
+	// pending jobs own their data and finish on their own
+}
+
+void ETHSaveData::AddRef()
+{
+	m_ref++;
+}
+
+void ETHSaveData::Release()
+{
+	if (--m_ref == 0)
+	{
+		delete this;
+	}
+}
+
+bool ETHSaveData::Load(const gs2d::str_type::string& fileName)
+{
+	// make sure queued saves have reached the disk before reading it back
+	ETHSaveDataWriter::Flush();
+
+	Clear();
+	m_fileName = fileName;
+	m_fileSize = 0;
+	m_lastJob.reset();
+
+	FILE* file = fopen(fileName.c_str(), "rb");
+	if (!file)
+		return false;
+
+	std::vector<unsigned char> data;
+	unsigned char buffer[4096];
+	std::size_t read;
+	while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0)
+		data.insert(data.end(), buffer, buffer + read);
+	fclose(file);
+
+	return Decode(data);
+}
+
+bool ETHSaveData::Decode(const std::vector<unsigned char>& data)
+{
+	if (data.size() < HEADER_SIZE)
+		return false;
+
+	Reader header(&data[0], HEADER_SIZE);
+	unsigned int version = 0;
+	for (std::size_t t = 0; t < 4; t++)
+	{
+		unsigned char c;
+		header.ReadByte(c);
+		if (c != FILE_MAGIC[t])
+			return false;
+	}
+	header.ReadUInt32(version);
+	if (version != FILE_VERSION)
+		return false;
+
+	std::size_t pos = HEADER_SIZE;
+	while (data.size() - pos >= RECORD_HEADER_SIZE)
+	{
+		Reader recordHeader(&data[pos], RECORD_HEADER_SIZE);
+		unsigned int payloadSize, crc;
+		recordHeader.ReadUInt32(payloadSize);
+		recordHeader.ReadUInt32(crc);
+
+		const std::size_t payloadPos = pos + RECORD_HEADER_SIZE;
+		if (payloadSize == 0 || data.size() - payloadPos < payloadSize || Crc32(&data[payloadPos], payloadSize) != crc)
+			break;
+
+		Reader payload(&data[payloadPos], payloadSize);
+		unsigned char type;
+		gs2d::str_type::string name;
+		if (!payload.ReadByte(type) || !payload.ReadString(name))
+			break;
+
+		if (type == RECORD_SECTION)
+		{
+			unsigned int count;
+			if (!payload.ReadUInt32(count))
+				break;
+
+			Section section;
+			bool valid = true;
+			for (unsigned int t = 0; t < count && valid; t++)
+			{
+				gs2d::str_type::string key, value;
+				valid = payload.ReadString(key) && payload.ReadString(value);
+				section[key] = value;
+			}
+			if (!valid || !payload.IsAtEnd())
+				break;
+			m_sections[name].swap(section);
+		}
+		else if (type == RECORD_REMOVE)
+		{
+			m_sections.erase(name);
+		}
+		else
+		{
+			break;
+		}
+		pos = payloadPos + payloadSize;
+	}
+
+	m_fileSize = pos;
+
+	// a damaged tail must not be appended to
+	m_rewrite = (pos != data.size());
+	return true;
+}
+
+std::size_t ETHSaveData::GetCompactSize() const
+{
+	std::size_t size = HEADER_SIZE;
+	for (SectionMap::const_iterator iter = m_sections.begin(); iter != m_sections.end(); ++iter)
+		size += GetRecordSize(iter->first, iter->second);
+	return size;
+}
+
+bool ETHSaveData::Save(const gs2d::str_type::string& fileName)
+{
+	if (HasSaveFailed() || fileName != m_fileName)
+		m_rewrite = true;
+
+	if (!m_rewrite && m_dirtySections.empty() && m_removedSections.empty())
+		return true;
+
+	if (!m_rewrite)
+	{
+		std::size_t deltaSize = 0;
+		for (std::set<gs2d::str_type::string>::const_iterator iter = m_removedSections.begin(); iter != m_removedSections.end(); ++iter)
+			deltaSize += GetRemovalRecordSize(*iter);
+		for (std::set<gs2d::str_type::string>::const_iterator iter = m_dirtySections.begin(); iter != m_dirtySections.end(); ++iter)
+			deltaSize += GetRecordSize(*iter, m_sections[*iter]);
+
+		const std::size_t compactSize = GetCompactSize();
+		if (m_fileSize + deltaSize > compactSize * 2 + MIN_COMPACTION_SIZE)
+			m_rewrite = true;
+	}
+
+	const ETHSaveDataWriter::JobPtr job = ETHSaveDataWriter::CreateJob(
+		fileName, m_rewrite ? ETHSaveDataWriter::REPLACE : ETHSaveDataWriter::APPEND, m_fileSize);
+	std::vector<unsigned char>& data = job->GetData();
+
+	if (m_rewrite)
+	{
+		data.reserve(GetCompactSize());
+		data.insert(data.end(), FILE_MAGIC, FILE_MAGIC + 4);
+		PutUInt32(data, FILE_VERSION);
+		for (SectionMap::const_iterator iter = m_sections.begin(); iter != m_sections.end(); ++iter)
+			PutSectionRecord(data, iter->first, iter->second);
+		m_fileSize = data.size();
+	}
+	else
+	{
+		for (std::set<gs2d::str_type::string>::const_iterator iter = m_removedSections.begin(); iter != m_removedSections.end(); ++iter)
+			EndRecord(data, BeginRecord(data, RECORD_REMOVE, *iter));
+		for (std::set<gs2d::str_type::string>::const_iterator iter = m_dirtySections.begin(); iter != m_dirtySections.end(); ++iter)
+			PutSectionRecord(data, *iter, m_sections[*iter]);
+		m_fileSize += data.size();
+	}
+
+	ETHSaveDataWriter::Enqueue(job);
+
+	m_dirtySections.clear();
+	m_removedSections.clear();
+	m_rewrite = false;
+	m_fileName = fileName;
+	m_lastJob = job;
+	return true;
+}
+
+bool ETHSaveData::IsSaving() const
+{
+	return (m_lastJob && ETHSaveDataWriter::GetStatus(m_lastJob) == ETHSaveDataWriter::PENDING);
+}
+
+bool ETHSaveData::HasSaveFailed() const
+{
+	return (m_lastJob && ETHSaveDataWriter::GetStatus(m_lastJob) == ETHSaveDataWriter::FAILED);
+}
+
+void ETHSaveData::WaitForSave()
+{
+	if (m_lastJob)
+		ETHSaveDataWriter::Wait(m_lastJob);
+}
+
+void ETHSaveData::MarkDirty(const gs2d::str_type::string& section)
+{
+	m_dirtySections.insert(section);
+	m_removedSections.erase(section);
+}
+
+void ETHSaveData::Set(const gs2d::str_type::string& section, const gs2d::str_type::string& key, const gs2d::str_type::string& value)
+{
+	SectionMap::iterator sectionIter = m_sections.find(section);
+	if (sectionIter == m_sections.end())
+	{
+		if (value.empty())
+			return;
+		sectionIter = m_sections.insert(SectionMap::value_type(section, Section())).first;
+	}
+
+	Section& values = sectionIter->second;
+	if (value.empty())
+	{
+		if (values.erase(key) > 0)
+			MarkDirty(section);
+		return;
+	}
+
+	Section::iterator iter = values.find(key);
+	if (iter == values.end())
+	{
+		values.insert(Section::value_type(key, value));
+		MarkDirty(section);
+	}
+	else if (iter->second != value)
+	{
+		iter->second = value;
+		MarkDirty(section);
+	}
+}
+
+gs2d::str_type::string ETHSaveData::Get(const gs2d::str_type::string& section, const gs2d::str_type::string& key) const
+{
+	SectionMap::const_iterator sectionIter = m_sections.find(section);
+	if (sectionIter == m_sections.end())
+		return GS_L("");
+	Section::const_iterator iter = sectionIter->second.find(key);
+	return (iter != sectionIter->second.end()) ? iter->second : GS_L("");
+}
+
+bool ETHSaveData::GetInt(const gs2d::str_type::string& section, const gs2d::str_type::string& key, int* p) const
+{
+	const gs2d::str_type::string str = Get(section, key);
+	return (!str.empty() && GS2D_SSCANF(str.c_str(), GS_L("%d"), p) == 1);
+}
+
+bool ETHSaveData::GetUInt(const gs2d::str_type::string& section, const gs2d::str_type::string& key, unsigned int* p) const
+{
+	const gs2d::str_type::string str = Get(section, key);
+	return (!str.empty() && GS2D_SSCANF(str.c_str(), GS_L("%u"), p) == 1);
+}
+
+bool ETHSaveData::GetFloat(const gs2d::str_type::string& section, const gs2d::str_type::string& key, float* p) const
+{
+	const gs2d::str_type::string str = Get(section, key);
+	return (!str.empty() && GS2D_SSCANF(str.c_str(), GS_L("%f"), p) == 1);
+}
+
+bool ETHSaveData::GetDouble(const gs2d::str_type::string& section, const gs2d::str_type::string& key, double* p) const
+{
+	const gs2d::str_type::string str = Get(section, key);
+	return (!str.empty() && GS2D_SSCANF(str.c_str(), GS_L("%lf"), p) == 1);
+}
+
+bool ETHSaveData::Exists(const gs2d::str_type::string& section) const
+{
+	return (m_sections.find(section) != m_sections.end());
+}
+
+void ETHSaveData::RemoveSection(const gs2d::str_type::string& section)
+{
+	if (m_sections.erase(section) > 0)
+	{
+		m_dirtySections.erase(section);
+		m_removedSections.insert(section);
+	}
+}
+
+void ETHSaveData::Clear()
+{
+	m_sections.clear();
+	m_dirtySections.clear();
+	m_removedSections.clear();
+	m_rewrite = true;
+}
+
+gs2d::str_type::string ETHSaveData::GetSectionNames() const
+{
+	gs2d::str_type::stringstream ss;
+	for (SectionMap::const_iterator iter = m_sections.begin(); iter != m_sections.end(); ++iter)
+		ss << (iter == m_sections.begin() ? GS_L("") : GS_L(",")) << iter->first;
+	return ss.str();
+}
+
+gs2d::str_type::string ETHSaveData::GetKeyNames(const gs2d::str_type::string& section) const
+{
+	SectionMap::const_iterator sectionIter = m_sections.find(section);
+	if (sectionIter == m_sections.end())
+		return GS_L("");
+
+	gs2d::str_type::stringstream ss;
+	const Section& values = sectionIter->second;
+	for (Section::const_iterator iter = values.begin(); iter != values.end(); ++iter)
+		ss << (iter == values.begin() ? GS_L("") : GS_L(",")) << iter->first;
+	return ss.str();
+}
+
+void ETHSaveData::ImportEnml(const gs2d::enml::File& file)
+{
+	std::list<gs2d::str_type::string> entityNames;
+	file.GetEntityNameList(entityNames);
+	for (std::list<gs2d::str_type::string>::const_iterator iter = entityNames.begin(); iter != entityNames.end(); ++iter)
+	{
+		const gs2d::enml::Entity* entity = file.GetEntity(*iter);
+		Section section(entity->Begin(), entity->End());
+		m_sections[*iter].swap(section);
+		MarkDirty(*iter);
+	}
+}
+
+bool ETHSaveData::ImportEnmlFile(const gs2d::str_type::string& fileName)
+{
+	gs2d::enml::File file;
+	if (!file.ParseFromFile(fileName))
+		return false;
+	ImportEnml(file);
+	return true;
+}
+
+gs2d::str_type::string ETHSaveData::GenerateEnmlString() const
+{
+	gs2d::enml::File file;
+	for (SectionMap::const_iterator sectionIter = m_sections.begin(); sectionIter != m_sections.end(); ++sectionIter)
+	{
+		if (!IsEnmlName(sectionIter->first))
+			continue;
+
+		const Section& values = sectionIter->second;
+		for (Section::const_iterator iter = values.begin(); iter != values.end(); ++iter)
+		{
+			if (IsEnmlName(iter->first))
+				file.AddValue(sectionIter->first, iter->first, iter->second);
+		}
+	}
+	return file.GenerateString();
+}
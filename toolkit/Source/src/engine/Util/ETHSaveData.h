@@ -0,0 +1,108 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#ifndef ETH_SAVE_DATA_H_
+#define ETH_SAVE_DATA_H_
+
+#include "ETHSaveDataWriter.h"
+
+#include <Enml/Enml.h>
+
+#include <map>
+#include <set>
+
+/// Game progress stored as named sections of key/value pairs.
+///
+/// The file is a binary journal: a short header followed by records, each holding one
+/// whole section (or a section removal) guarded by its length and CRC-32. Save appends
+/// records for the sections changed since the last save only, and later records replace
+/// earlier ones when the file is read. A record torn by a crash fails its checksum and
+/// is dropped along with anything after it, leaving the previous state intact. Once the
+/// journal grows well past the size of its live data, the next save rewrites the whole
+/// file into a temporary one and renames it over the original.
+///
+/// Files are written by ETHSaveDataWriter on a background thread.
+class ETHSaveData
+{
+public:
+	ETHSaveData();
+	~ETHSaveData();
+
+	void AddRef();
+	void Release();
+
+	/// Replaces the current content with the file's. Returns false if the file could not be
+	/// read or is not a save file; a damaged tail is dropped and the rest is kept.
+	bool Load(const gs2d::str_type::string& fileName);
+
+	/// Queues the changes for writing and returns immediately.
+	bool Save(const gs2d::str_type::string& fileName);
+
+	bool IsSaving() const;
+	bool HasSaveFailed() const;
+	void WaitForSave();
+
+	/// Sets a value. An empty value removes the key.
+	void Set(const gs2d::str_type::string& section, const gs2d::str_type::string& key, const gs2d::str_type::string& value);
+	gs2d::str_type::string Get(const gs2d::str_type::string& section, const gs2d::str_type::string& key) const;
+	bool GetInt(const gs2d::str_type::string& section, const gs2d::str_type::string& key, int* p) const;
+	bool GetUInt(const gs2d::str_type::string& section, const gs2d::str_type::string& key, unsigned int* p) const;
+	bool GetFloat(const gs2d::str_type::string& section, const gs2d::str_type::string& key, float* p) const;
+	bool GetDouble(const gs2d::str_type::string& section, const gs2d::str_type::string& key, double* p) const;
+
+	bool Exists(const gs2d::str_type::string& section) const;
+	void RemoveSection(const gs2d::str_type::string& section);
+	void Clear();
+
+	/// Returns comma separated names, like enml::File does.
+	gs2d::str_type::string GetSectionNames() const;
+	gs2d::str_type::string GetKeyNames(const gs2d::str_type::string& section) const;
+
+	/// Imports every enml entity as a section. Existing sections with the same names are replaced.
+	void ImportEnml(const gs2d::enml::File& file);
+	bool ImportEnmlFile(const gs2d::str_type::string& fileName);
+
+	/// Readable enml dump of the content. Names enml can't represent are left out.
+	gs2d::str_type::string GenerateEnmlString() const;
+
+private:
+	typedef std::map<gs2d::str_type::string, gs2d::str_type::string> Section;
+	typedef std::map<gs2d::str_type::string, Section> SectionMap;
+
+	void MarkDirty(const gs2d::str_type::string& section);
+	bool Decode(const std::vector<unsigned char>& data);
+	std::size_t GetCompactSize() const;
+
+	SectionMap m_sections;
+	std::set<gs2d::str_type::string> m_dirtySections;
+	std::set<gs2d::str_type::string> m_removedSections;
+
+	// state of the file last loaded or saved
+	gs2d::str_type::string m_fileName;
+	std::size_t m_fileSize;
+	bool m_rewrite;
+
+	ETHSaveDataWriter::JobPtr m_lastJob;
+	int m_ref;
+};
+
+#endif
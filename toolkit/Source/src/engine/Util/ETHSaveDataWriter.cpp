@@ -0,0 +1,228 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#include "ETHSaveDataWriter.h"
+
+#include <Platform/Thread.h>
+#include <Platform/MonotonicClock.h>
+
+#include <cstdio>
+#include <list>
+
+#ifdef WIN32
+ #define WIN32_LEAN_AND_MEAN
+ #include <windows.h>
+ #include <io.h>
+#else
+ #include <unistd.h>
+#endif
+
+namespace {
+
+struct WriterState
+{
+	WriterState() : stopping(false), busy(false) { }
+	Platform::Lock lock;
+	std::list<ETHSaveDataWriter::JobPtr> queue;
+	Platform::Thread thread;
+	bool stopping;
+	bool busy;
+};
+
+// Never destroyed: a save may still be in flight while static objects go away
+WriterState* g_state = new WriterState;
+
+} // namespace
+
+ETHSaveDataWriter::Job::Job(const gs2d::str_type::string& fileName, const MODE mode, const std::size_t expectedSize) :
+	m_fileName(fileName),
+	m_mode(mode),
+	m_expectedSize(expectedSize),
+	m_status(PENDING)
+{
+}
+
+std::vector<unsigned char>& ETHSaveDataWriter::Job::GetData()
+{
+	return m_data;
+}
+
+const gs2d::str_type::string& ETHSaveDataWriter::Job::GetFileName() const
+{
+	return m_fileName;
+}
+
+// Thread entry point, allowed to reach into the writer's privates
+class ETHSaveDataWriterThread
+{
+public:
+	static void Routine(void*)
+	{
+		ETHSaveDataWriter::RunWorker();
+	}
+};
+
+void ETHSaveDataWriter::RunWorker()
+{
+	WriterState& state = *g_state;
+	Platform::ScopedLock lock(state.lock);
+	for (;;)
+	{
+		while (state.queue.empty() && !state.stopping)
+			state.lock.WaitForSignal();
+		if (state.queue.empty())
+			break;
+
+		JobPtr job = state.queue.front();
+		state.queue.pop_front();
+		state.busy = true;
+
+		state.lock.Release();
+		const bool succeeded = Write(*job);
+		state.lock.Acquire();
+
+		job->m_status = succeeded ? SUCCEEDED : FAILED;
+		state.busy = false;
+	}
+}
+
+static bool Commit(FILE* file)
+{
+	if (fflush(file) != 0)
+		return false;
+#ifdef WIN32
+	return (_commit(_fileno(file)) == 0);
+#else
+	return (fsync(fileno(file)) == 0);
+#endif
+}
+
+static bool ReplaceFile(const gs2d::str_type::string& from, const gs2d::str_type::string& to)
+{
+#ifdef WIN32
+	return (MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != FALSE);
+#else
+	return (rename(from.c_str(), to.c_str()) == 0);
+#endif
+}
+
+bool ETHSaveDataWriter::Write(const Job& job)
+{
+	const unsigned char* data = job.m_data.empty() ? 0 : &job.m_data[0];
+	const std::size_t size = job.m_data.size();
+
+	if (job.m_mode == APPEND)
+	{
+		FILE* file = fopen(job.m_fileName.c_str(), "r+b");
+		if (!file)
+			return false;
+
+		// someone else touched the file since the caller last wrote it: appending
+		// now would continue the record stream from the wrong place
+		bool succeeded = (fseek(file, 0, SEEK_END) == 0 && ftell(file) == static_cast<long>(job.m_expectedSize));
+		succeeded = succeeded && (fwrite(data, 1, size, file) == size) && Commit(file);
+		fclose(file);
+		return succeeded;
+	}
+	else
+	{
+		const gs2d::str_type::string tempFileName = job.m_fileName + GS_L(".tmp");
+		FILE* file = fopen(tempFileName.c_str(), "wb");
+		if (!file)
+			return false;
+
+		bool succeeded = (fwrite(data, 1, size, file) == size) && Commit(file);
+		succeeded = (fclose(file) == 0) && succeeded;
+		succeeded = succeeded && ReplaceFile(tempFileName, job.m_fileName);
+		if (!succeeded)
+			remove(tempFileName.c_str());
+		return succeeded;
+	}
+}
+
+ETHSaveDataWriter::JobPtr ETHSaveDataWriter::CreateJob(const gs2d::str_type::string& fileName, const MODE mode, const std::size_t expectedSize)
+{
+	return JobPtr(new Job(fileName, mode, expectedSize));
+}
+
+void ETHSaveDataWriter::Enqueue(const JobPtr& job)
+{
+	WriterState& state = *g_state;
+	Platform::ScopedLock lock(state.lock);
+	if (!state.thread.IsRunning())
+	{
+		state.stopping = false;
+		state.thread.Start(ETHSaveDataWriterThread::Routine, 0);
+	}
+
+	if (state.thread.IsRunning())
+	{
+		state.queue.push_back(job);
+		state.lock.Signal();
+	}
+	else
+	{
+		// no thread available, write it right away
+		job->m_status = Write(*job) ? SUCCEEDED : FAILED;
+	}
+}
+
+ETHSaveDataWriter::STATUS ETHSaveDataWriter::GetStatus(const JobPtr& job)
+{
+	Platform::ScopedLock lock(g_state->lock);
+	return job->m_status;
+}
+
+void ETHSaveDataWriter::Wait(const JobPtr& job)
+{
+	while (GetStatus(job) == PENDING)
+		Platform::SleepMicroseconds(1000);
+}
+
+void ETHSaveDataWriter::Flush()
+{
+	WriterState& state = *g_state;
+	for (;;)
+	{
+		{
+			Platform::ScopedLock lock(state.lock);
+			if (state.queue.empty() && !state.busy)
+				return;
+		}
+		Platform::SleepMicroseconds(1000);
+	}
+}
+
+void ETHSaveDataWriter::Shutdown()
+{
+	WriterState& state = *g_state;
+	{
+		Platform::ScopedLock lock(state.lock);
+		if (!state.thread.IsRunning())
+			return;
+		state.stopping = true;
+		state.lock.Signal();
+	}
+
+	// the worker drains the queue before it leaves
+	state.thread.Join();
+}
@@ -0,0 +1,89 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#ifndef ETH_SAVE_DATA_WRITER_H_
+#define ETH_SAVE_DATA_WRITER_H_
+
+#include <Types.h>
+
+#include <vector>
+
+/// Writes save files on a background thread, one job at a time and in the order they
+/// were queued. A job owns everything it writes, so the caller may go on changing its
+/// own data as soon as Enqueue returns.
+class ETHSaveDataWriter
+{
+	friend class ETHSaveDataWriterThread;
+
+public:
+	enum STATUS
+	{
+		PENDING = 0,
+		SUCCEEDED = 1,
+		FAILED = 2
+	};
+
+	enum MODE
+	{
+		/// Writes the data to a temporary file and renames it over the target.
+		REPLACE = 0,
+		/// Appends the data, provided the target file still has the expected size.
+		APPEND = 1
+	};
+
+	class Job
+	{
+		friend class ETHSaveDataWriter;
+		Job(const gs2d::str_type::string& fileName, const MODE mode, const std::size_t expectedSize);
+
+		gs2d::str_type::string m_fileName;
+		std::vector<unsigned char> m_data;
+		MODE m_mode;
+		std::size_t m_expectedSize;
+		STATUS m_status;
+
+	public:
+		std::vector<unsigned char>& GetData();
+		const gs2d::str_type::string& GetFileName() const;
+	};
+
+	typedef boost::shared_ptr<Job> JobPtr;
+
+	/// Creates a job. Fill its data and hand it to Enqueue.
+	static JobPtr CreateJob(const gs2d::str_type::string& fileName, const MODE mode, const std::size_t expectedSize = 0);
+	static void Enqueue(const JobPtr& job);
+
+	static STATUS GetStatus(const JobPtr& job);
+	static void Wait(const JobPtr& job);
+
+	/// Blocks until every queued job has been written.
+	static void Flush();
+
+	/// Flushes the queue and stops the worker thread. It is started again by the next job.
+	static void Shutdown();
+
+private:
+	static void RunWorker();
+	static bool Write(const Job& job);
+};
+
+#endif
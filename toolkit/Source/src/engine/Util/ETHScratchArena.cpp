@@ -0,0 +1,196 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#include "ETHScratchArena.h"
+
+#include <cassert>
+
+// enough for any type the engine keeps in the arena, including SIMD vectors
+static const std::size_t ARENA_ALIGNMENT = 16;
+
+static std::size_t AlignUp(const std::size_t size)
+{
+	return (size + (ARENA_ALIGNMENT - 1)) & ~(ARENA_ALIGNMENT - 1);
+}
+
+ETHScratchArena::Scope::Scope(ETHScratchArena& arena) :
+	m_arena(arena),
+	m_marker(arena.GetMarker())
+{
+}
+
+ETHScratchArena::Scope::~Scope()
+{
+	m_arena.Rewind(m_marker);
+}
+
+ETHScratchArena::ETHScratchArena(const std::size_t blockSize) :
+	m_current(0),
+	m_usedBefore(0),
+	m_blockSize(AlignUp(blockSize)),
+	m_frameWatermark(0),
+	m_lastFrameWatermark(0),
+	m_highWatermark(0)
+{
+	AddBlock(m_blockSize);
+}
+
+ETHScratchArena::~ETHScratchArena()
+{
+	FreeBlocks(0);
+}
+
+void ETHScratchArena::AddBlock(const std::size_t minSize)
+{
+	Block block;
+	block.size = (minSize > m_blockSize) ? AlignUp(minSize) : m_blockSize;
+	block.used = 0;
+
+	// new[] only guarantees the alignment of the largest fundamental type
+	block.memory = new unsigned char[block.size + ARENA_ALIGNMENT];
+	block.data = reinterpret_cast<unsigned char*>(AlignUp(reinterpret_cast<std::size_t>(block.memory)));
+	m_blocks.push_back(block);
+}
+
+void ETHScratchArena::FreeBlocks(const std::size_t first)
+{
+	for (std::size_t t = first; t < m_blocks.size(); t++)
+	{
+		delete [] m_blocks[t].memory;
+	}
+	m_blocks.resize(first);
+}
+
+void* ETHScratchArena::Allocate(const std::size_t size)
+{
+	const std::size_t alignedSize = AlignUp(size > 0 ? size : 1);
+	if (m_blocks[m_current].size - m_blocks[m_current].used < alignedSize)
+	{
+		// move on to the next block, chaining a new one if none is left or it is too small
+		const std::size_t next = m_current + 1;
+		if (next < m_blocks.size() && m_blocks[next].size < alignedSize)
+			FreeBlocks(next);
+		if (next == m_blocks.size())
+			AddBlock(alignedSize);
+
+		m_usedBefore += m_blocks[m_current].used;
+		m_current = next;
+	}
+
+	Block& block = m_blocks[m_current];
+	void* r = block.data + block.used;
+	block.used += alignedSize;
+	UpdateWatermark();
+	return r;
+}
+
+bool ETHScratchArena::Extend(void* ptr, const std::size_t oldSize, const std::size_t newSize)
+{
+	Block& block = m_blocks[m_current];
+	const std::size_t oldAligned = AlignUp(oldSize > 0 ? oldSize : 1);
+	if (static_cast<unsigned char*>(ptr) + oldAligned != block.data + block.used)
+		return false;
+
+	const std::size_t newAligned = AlignUp(newSize);
+	const std::size_t start = block.used - oldAligned;
+	if (block.size - start < newAligned)
+		return false;
+
+	block.used = start + newAligned;
+	UpdateWatermark();
+	return true;
+}
+
+ETHScratchArena::Marker ETHScratchArena::GetMarker() const
+{
+	Marker marker;
+	marker.block = m_current;
+	marker.offset = m_blocks[m_current].used;
+	return marker;
+}
+
+void ETHScratchArena::Rewind(const Marker& marker)
+{
+	assert(marker.block <= m_current);
+	while (m_current > marker.block)
+	{
+		m_blocks[m_current].used = 0;
+		--m_current;
+		m_usedBefore -= m_blocks[m_current].used;
+	}
+	assert(marker.offset <= m_blocks[m_current].used);
+	m_blocks[m_current].used = marker.offset;
+}
+
+void ETHScratchArena::Reset()
+{
+	m_lastFrameWatermark = m_frameWatermark;
+	m_frameWatermark = 0;
+
+	if (m_blocks.size() > 1)
+	{
+		std::size_t total = 0;
+		for (std::size_t t = 0; t < m_blocks.size(); t++)
+			total += m_blocks[t].size;
+		FreeBlocks(0);
+		m_blockSize = AlignUp(total);
+		AddBlock(m_blockSize);
+	}
+
+	m_blocks[0].used = 0;
+	m_current = 0;
+	m_usedBefore = 0;
+}
+
+void ETHScratchArena::UpdateWatermark()
+{
+	const std::size_t used = GetUsedBytes();
+	if (used > m_frameWatermark)
+	{
+		m_frameWatermark = used;
+		if (used > m_highWatermark)
+			m_highWatermark = used;
+	}
+}
+
+std::size_t ETHScratchArena::GetUsedBytes() const
+{
+	return m_usedBefore + m_blocks[m_current].used;
+}
+
+std::size_t ETHScratchArena::GetCapacity() const
+{
+	std::size_t capacity = 0;
+	for (std::size_t t = 0; t < m_blocks.size(); t++)
+		capacity += m_blocks[t].size;
+	return capacity;
+}
+
+std::size_t ETHScratchArena::GetFrameWatermark() const
+{
+	return m_lastFrameWatermark;
+}
+
+std::size_t ETHScratchArena::GetHighWatermark() const
+{
+	return m_highWatermark;
+}
@@ -0,0 +1,178 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#ifndef ETH_SCRATCH_ARENA_H_
+#define ETH_SCRATCH_ARENA_H_
+
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+/// Linear allocator for temporaries that never outlive a frame. Allocation bumps a
+/// pointer; nothing is freed individually. Scopes rewind the arena when a query is done
+/// with its temporaries and Reset empties it at the start of each frame. Only types that
+/// need no destructor may live here.
+class ETHScratchArena
+{
+public:
+	/// Position of the arena top, used to rewind it
+	struct Marker
+	{
+		std::size_t block;
+		std::size_t offset;
+	};
+
+	/// Rewinds the arena to where it was when the scope started
+	class Scope
+	{
+		ETHScratchArena& m_arena;
+		const Marker m_marker;
+		Scope& operator=(const Scope&);
+	public:
+		Scope(ETHScratchArena& arena);
+		~Scope();
+	};
+
+	ETHScratchArena(const std::size_t blockSize = 16 * 1024);
+	~ETHScratchArena();
+
+	void* Allocate(const std::size_t size);
+
+	/// Grows the block in place when it is the last allocation made. Returns false otherwise
+	bool Extend(void* block, const std::size_t oldSize, const std::size_t newSize);
+
+	template <class T>
+	T* Allocate(const std::size_t count)
+	{
+		return static_cast<T*>(Allocate(count * sizeof(T)));
+	}
+
+	Marker GetMarker() const;
+	void Rewind(const Marker& marker);
+
+	/// Empties the arena. If the last frame spilled into more blocks, they are
+	/// replaced by a single block that fits all of them
+	void Reset();
+
+	std::size_t GetUsedBytes() const;
+	std::size_t GetCapacity() const;
+
+	/// Peak usage during the last frame
+	std::size_t GetFrameWatermark() const;
+
+	/// Peak usage since the arena was created
+	std::size_t GetHighWatermark() const;
+
+private:
+	ETHScratchArena(const ETHScratchArena&);
+	ETHScratchArena& operator=(const ETHScratchArena&);
+
+	struct Block
+	{
+		unsigned char* memory;
+		unsigned char* data;
+		std::size_t size;
+		std::size_t used;
+	};
+
+	void AddBlock(const std::size_t minSize);
+	void FreeBlocks(const std::size_t first);
+	void UpdateWatermark();
+
+	std::vector<Block> m_blocks;
+	std::size_t m_current;
+
+	// bytes held by the blocks before the current one
+	std::size_t m_usedBefore;
+
+	std::size_t m_blockSize;
+	std::size_t m_frameWatermark;
+	std::size_t m_lastFrameWatermark;
+	std::size_t m_highWatermark;
+};
+
+/// Read-only view of a contiguous run of elements
+template <class T>
+class ETHSpan
+{
+	const T* m_data;
+	std::size_t m_size;
+
+public:
+	typedef const T* const_iterator;
+
+	ETHSpan() : m_data(0), m_size(0) { }
+	ETHSpan(const T* data, const std::size_t size) : m_data(data), m_size(size) { }
+
+	const_iterator begin() const { return m_data; }
+	const_iterator end() const { return m_data + m_size; }
+	std::size_t size() const { return m_size; }
+	bool empty() const { return m_size == 0; }
+	const T& operator[](const std::size_t idx) const { return m_data[idx]; }
+};
+
+/// Growable array living in a scratch arena. Elements are copied bytewise when it grows
+template <class T>
+class ETHScratchVector
+{
+	ETHScratchArena& m_arena;
+	T* m_data;
+	std::size_t m_size;
+	std::size_t m_capacity;
+	ETHScratchVector& operator=(const ETHScratchVector&);
+
+public:
+	ETHScratchVector(ETHScratchArena& arena, const std::size_t capacity = 16) :
+		m_arena(arena),
+		m_data(arena.Allocate<T>(capacity)),
+		m_size(0),
+		m_capacity(capacity)
+	{
+	}
+
+	void push_back(const T& value)
+	{
+		if (m_size == m_capacity)
+		{
+			// a vector created empty must still grow
+			const std::size_t capacity = (m_capacity > 0) ? (m_capacity * 2) : 1;
+			if (!m_arena.Extend(m_data, m_capacity * sizeof(T), capacity * sizeof(T)))
+			{
+				T* data = m_arena.Allocate<T>(capacity);
+				memcpy(data, m_data, m_size * sizeof(T));
+				m_data = data;
+			}
+			m_capacity = capacity;
+		}
+		m_data[m_size++] = value;
+	}
+
+	void clear() { m_size = 0; }
+	std::size_t size() const { return m_size; }
+	bool empty() const { return m_size == 0; }
+	T& operator[](const std::size_t idx) { return m_data[idx]; }
+	const T& operator[](const std::size_t idx) const { return m_data[idx]; }
+
+	ETHSpan<T> GetSpan() const { return ETHSpan<T>(m_data, m_size); }
+};
+
+#endif
@@ -29,8 +29,8 @@ ETHSpeedTimer::ETHSpeedTimer()
 
 double ETHSpeedTimer::CalcLastFrame()
 {
-	m_elapsed = elapsed();
-	restart();
+	m_elapsed = static_cast<double>(m_clock.GetElapsedTimeUS()) / 1000000.0;
+	m_clock.Reset();
 	return m_elapsed;
 }
 
@@ -23,9 +23,11 @@
 #ifndef ETH_SPEED_TIMER_H_
 #define ETH_SPEED_TIMER_H_
 
-#include <boost/timer.hpp>
+#include <Platform/MonotonicClock.h>
 
-class ETHSpeedTimer : public boost::timer
+// boost::timer is based on std::clock, which measures process CPU time rather than
+// wall time and has a coarse resolution on some platforms
+class ETHSpeedTimer
 {
 public:
 	ETHSpeedTimer();
@@ -34,6 +36,7 @@ public:
 	float UnitsPerSecond() const ;
 	double GetElapsedTime() const;
 private:
+	Platform::MonotonicClock m_clock;
 	double m_elapsed;
 };
 
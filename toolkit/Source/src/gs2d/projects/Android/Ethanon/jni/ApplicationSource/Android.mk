@@ -59,17 +59,25 @@ LOCAL_SRC_FILES := \
 	$(ENGINE_PATH)/Resource/ETHResourceProvider.cpp \
 	$(ENGINE_PATH)/Resource/ETHSpriteDensityManager.cpp \
 	$(ENGINE_PATH)/Util/ETHSpeedTimer.cpp \
+	$(ENGINE_PATH)/Util/ETHFrameTimeHistogram.cpp \
+	$(ENGINE_PATH)/Util/ETHAllocationTracker.cpp \
+	$(ENGINE_PATH)/Util/ETHScratchArena.cpp \
 	$(ENGINE_PATH)/Util/ETHASUtil.cpp \
 	$(ENGINE_PATH)/Util/ETHDateTime.cpp \
+	$(ENGINE_PATH)/Util/ETHSaveData.cpp \
+	$(ENGINE_PATH)/Util/ETHSaveDataWriter.cpp \
 	$(ENGINE_PATH)/Util/ETHInput.cpp \
 	$(ENGINE_PATH)/Util/ETHGlobalScaleManager.cpp \
 	$(ENGINE_PATH)/Entity/ETHScriptEntity.cpp \
 	$(ENGINE_PATH)/Entity/ETHRenderEntity.cpp \
+	$(ENGINE_PATH)/Entity/ETHRenderEntity.Shadow.cpp \
 	$(ENGINE_PATH)/Entity/ETHSpriteEntity.cpp \
 	$(ENGINE_PATH)/Entity/ETHEntityArray.cpp \
 	$(ENGINE_PATH)/Entity/ETHEntity.cpp \
 	$(ENGINE_PATH)/Entity/ETHEntityController.cpp \
 	$(ENGINE_PATH)/Entity/ETHEntityCache.cpp \
+	$(ENGINE_PATH)/Entity/ETHEntityTemplateBundle.cpp \
+	$(ENGINE_PATH)/Entity/ETHEntityPool.cpp \
 	$(ENGINE_PATH)/Entity/ETHEntityProperties.cpp \
 	$(ENGINE_PATH)/Entity/ETHCustomDataManager.cpp \
 	$(ENGINE_PATH)/Entity/ETHLight.cpp \
@@ -87,6 +95,7 @@ LOCAL_SRC_FILES := \
 	$(ENGINE_PATH)/Scene/ETHBucketManager.cpp \
 	$(ENGINE_PATH)/Scene/ETHScene.cpp \
 	$(ENGINE_PATH)/Scene/ETHActiveEntityHandler.cpp \
+	$(ENGINE_PATH)/Scene/ETHEntityCallbackDispatcher.cpp \
 	$(ENGINE_PATH)/Scene/ETHSceneProperties.cpp \
 	$(ENGINE_PATH)/Script/ETHScriptWrapper.cpp \
 	$(ENGINE_PATH)/Script/ETHScriptWrapper.Math.cpp \
@@ -95,8 +104,11 @@ LOCAL_SRC_FILES := \
 	$(ENGINE_PATH)/Script/ETHScriptObjRegister.cpp \
 	$(ENGINE_PATH)/Script/ETHScriptObjRegister.generic.cpp \
 	$(ENGINE_PATH)/Script/ETHBinaryStream.cpp \
+	$(ENGINE_PATH)/Script/ETHJITCompiler.cpp \
+	$(ENGINE_PATH)/Script/ETHGarbageCollector.cpp \
 	$(ENGINE_PATH)/Script/ETHScriptWrapper.Audio.cpp \
 	$(ENGINE_PATH)/Script/ETHScriptWrapper.Drawing.cpp \
+	$(ENGINE_PATH)/Script/ETHScriptWrapper.EntityArray.cpp \
 	$(ENGINE_PATH)/Script/ETHScriptWrapper.Scene.cpp \
 	$(ENGINE_PATH)/Script/ETHScriptWrapper.System.cpp \
 	$(ENGINE_PATH)/Script/ETHScriptWrapper.SharedData.cpp \
@@ -111,6 +123,8 @@ LOCAL_SRC_FILES := \
 	$(ENGINE_PATH)/Physics/ETHJoint.cpp \
 	$(ENGINE_PATH)/Physics/ETHPhysicsEntityController.cpp \
 	$(ENGINE_PATH)/Physics/ETHRevoluteJoint.cpp \
+	$(ENGINE_PATH)/Physics/ETHStaticColliderMerger.cpp \
+	$(ENGINE_PATH)/Particles/ETHParticleEffectCache.cpp \
 	$(ENGINE_PATH)/Particles/ETHParticleManager.cpp \
 	$(ENGINE_PATH)/Particles/ETHParticleSystem.cpp \
 	$(ENGINE_PATH)/Drawing/ETHDrawable.cpp \
@@ -121,6 +135,8 @@ LOCAL_SRC_FILES := \
 	$(ENGINE_PATH)/Renderer/ETHEntityPieceRenderer.cpp \
 	$(ENGINE_PATH)/Renderer/ETHEntitySpriteRenderer.cpp \
 	$(ENGINE_PATH)/Renderer/ETHEntityRenderingManager.cpp \
+	$(ENGINE_PATH)/Renderer/ETHProjShadowBatch.cpp \
+	$(ENGINE_PATH)/Renderer/ETHStaticRenderCache.cpp \
 	$(ENGINE_PATH)/Platform/ETHAppEnmlFile.cpp
 
 LOCAL_LDLIBS := -ldl -llog -lGLESv2 -lz
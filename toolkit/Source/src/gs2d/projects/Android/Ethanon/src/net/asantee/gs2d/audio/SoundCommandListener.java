@@ -28,6 +28,8 @@ import android.app.Activity;
 public class SoundCommandListener extends SoundEffectManager implements NativeCommandListener {
 
 	static final String CMD_PLAY_SOUND = "play_sound";
+	static final String CMD_PLAY_VOICE = "play_voice";
+	static final String CMD_LIMIT_VOICES = "limit_voices";
 	static final String CMD_LOAD_SOUND = "load_sound";
 	static final String CMD_DELETE_SOUND = "delete_sound";
 	static final String CMD_SET_GLOBAL_VOLUME = "set_global_volume";
@@ -53,6 +55,16 @@ public class SoundCommandListener extends SoundEffectManager implements NativeCo
 			Float speed = Float.parseFloat(pieces[4]);
 			super.play(pieces[1], volume, speed);
 
+		} else if (pieces[0].equals(CMD_PLAY_VOICE)) {
+			Float volume = Float.parseFloat(pieces[2]);
+			Float pan = Float.parseFloat(pieces[3]);
+			Float speed = Float.parseFloat(pieces[4]);
+			Integer maxVoices = Integer.parseInt(pieces[5]);
+			super.playVoice(pieces[1], volume, pan, speed, maxVoices);
+
+		} else if (pieces[0].equals(CMD_LIMIT_VOICES)) {
+			super.limitVoices(pieces[1], Integer.parseInt(pieces[2]));
+
 		} else if (pieces[0].equals(CMD_DELETE_SOUND)) {
 			super.release(pieces[1]);
 		} else if (pieces[0].equals(CMD_SET_GLOBAL_VOLUME)) {
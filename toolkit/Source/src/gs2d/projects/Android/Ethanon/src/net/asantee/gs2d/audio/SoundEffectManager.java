@@ -23,20 +23,39 @@
 package net.asantee.gs2d.audio;
 
 import java.io.IOException;
+import java.util.ArrayList;
 import java.util.HashMap;
 
 import net.asantee.gs2d.GS2DActivity;
+import net.asantee.gs2d.GS2DJNI;
 import android.app.Activity;
 import android.content.Context;
 import android.content.res.AssetFileDescriptor;
 import android.content.res.AssetManager;
 import android.media.AudioManager;
+import android.media.MediaMetadataRetriever;
 import android.media.SoundPool;
+import android.os.SystemClock;
 import android.util.Log;
 
 public class SoundEffectManager {
 
 	private static final int MAXIMUM_SIMULTANEOUS_SFX = 8;
+	private static final String SAMPLE_DURATION_SHARED_DATA_PREFIX = "ethanon.system.sampleDuration.";
+
+	// SoundPool can't tell whether a stream is still playing, so voices are tracked by the
+	// time they are due to end. The native side keeps the same list to count them
+	private static class Voice {
+		Voice(int streamId, long endTime, float volume) {
+			this.streamId = streamId;
+			this.endTime = endTime;
+			this.volume = volume;
+		}
+
+		int streamId;
+		long endTime;
+		float volume;
+	}
 
 	public SoundEffectManager(Activity activity) {
 		this.pool = new SoundPool(MAXIMUM_SIMULTANEOUS_SFX, AudioManager.STREAM_MUSIC, 0);
@@ -64,6 +83,10 @@ public class SoundEffectManager {
 			try {
 				afd = assets.openFd(relativeFileName);
 				samples.put(fileName, pool.load(afd, 1));
+
+				final long duration = readDuration(afd);
+				durations.put(fileName, duration);
+				GS2DJNI.setSharedData(SAMPLE_DURATION_SHARED_DATA_PREFIX + fileName, Long.toString(duration));
 				if (afd != null) {
 					try {
 						afd.close();
@@ -79,12 +102,29 @@ public class SoundEffectManager {
 		return true;
 	}
 
-	public void play(String fileName, float volume, float speed) {
+	private static long readDuration(AssetFileDescriptor afd) {
+		MediaMetadataRetriever retriever = new MediaMetadataRetriever();
+		try {
+			retriever.setDataSource(afd.getFileDescriptor(), afd.getStartOffset(), afd.getLength());
+			String duration = retriever.extractMetadata(MediaMetadataRetriever.METADATA_KEY_DURATION);
+			return (duration != null) ? Long.parseLong(duration) : 0;
+		} catch (RuntimeException e) {
+			return 0;
+		} finally {
+			retriever.release();
+		}
+	}
+
+	private float computeStreamVolume(float volume) {
 		float streamVolume = manager.getStreamVolume(AudioManager.STREAM_MUSIC);
 		streamVolume /= manager.getStreamMaxVolume(AudioManager.STREAM_MUSIC);
 		streamVolume *= MediaStreamManager.getGlobalVolume() * volume;
-		streamVolume = Math.min(streamVolume, 0.99f);
-		
+		return Math.min(streamVolume, 0.99f);
+	}
+
+	public void play(String fileName, float volume, float speed) {
+		float streamVolume = computeStreamVolume(volume);
+
 		if (streamVolume > 0) {
 			Integer id = samples.get(fileName);
 			if (id != null) {
@@ -97,10 +137,77 @@ public class SoundEffectManager {
 		}
 	}
 
+	private ArrayList<Voice> getVoices(String fileName) {
+		ArrayList<Voice> sampleVoices = voices.get(fileName);
+		if (sampleVoices == null) {
+			sampleVoices = new ArrayList<Voice>();
+			voices.put(fileName, sampleVoices);
+		}
+
+		final long now = SystemClock.uptimeMillis();
+		for (int t = sampleVoices.size() - 1; t >= 0; t--) {
+			if (sampleVoices.get(t).endTime <= now) {
+				sampleVoices.remove(t);
+			}
+		}
+		return sampleVoices;
+	}
+
+	private void stopQuietestVoice(ArrayList<Voice> sampleVoices) {
+		// the oldest one among equally loud voices
+		int victim = 0;
+		for (int t = 1; t < sampleVoices.size(); t++) {
+			if (sampleVoices.get(t).volume < sampleVoices.get(victim).volume) {
+				victim = t;
+			}
+		}
+		pool.stop(sampleVoices.get(victim).streamId);
+		sampleVoices.remove(victim);
+	}
+
+	public void playVoice(String fileName, float volume, float pan, float speed, int maxVoices) {
+		Integer id = samples.get(fileName);
+		if (id == null) {
+			Log.w("GS2DError", fileName + " playback failed. file has not been loaded yet. It might be just a concurrency issue");
+			return;
+		}
+
+		ArrayList<Voice> sampleVoices = getVoices(fileName);
+		if (maxVoices <= 0) {
+			return;
+		}
+		if (sampleVoices.size() >= maxVoices) {
+			stopQuietestVoice(sampleVoices);
+		}
+
+		// silent voices are still played and tracked, so both sides count the same voices
+		final float streamVolume = computeStreamVolume(volume);
+		final float left = streamVolume * Math.min(1.0f, 1.0f - pan);
+		final float right = streamVolume * Math.min(1.0f, 1.0f + pan);
+		final float rate = Math.max(Math.min(2.0f, speed), 0.5f);
+		final int streamId = pool.play(id, left, right, 1, 0, rate);
+		if (streamId == 0) {
+			Log.e("GS2DError", fileName + " voice playback failed");
+		}
+
+		Long duration = durations.get(fileName);
+		long endTime = SystemClock.uptimeMillis() + (long) (((duration != null) ? duration : 0) / rate);
+		sampleVoices.add(new Voice(streamId, endTime, volume));
+	}
+
+	public void limitVoices(String fileName, int maxVoices) {
+		ArrayList<Voice> sampleVoices = getVoices(fileName);
+		while (sampleVoices.size() > Math.max(0, maxVoices)) {
+			stopQuietestVoice(sampleVoices);
+		}
+	}
+
 	public boolean release(String fileName) {
 		Integer id = samples.get(fileName);
 		if (id != null) {
 			samples.remove(fileName);
+			voices.remove(fileName);
+			durations.remove(fileName);
 			return pool.unload(id);
 		} else {
 			return false;
@@ -110,6 +217,8 @@ public class SoundEffectManager {
 	public void clearAll() {
 		pool.release();
 		samples.clear();
+		voices.clear();
+		durations.clear();
 	}
 
 	public static String PREFIX = "assets/";
@@ -117,5 +226,7 @@ public class SoundEffectManager {
 	private SoundPool pool;
 	private AudioManager manager;
 	private HashMap<String, Integer> samples = new HashMap<String, Integer>();
+	private HashMap<String, Long> durations = new HashMap<String, Long>();
+	private HashMap<String, ArrayList<Voice>> voices = new HashMap<String, ArrayList<Voice>>();
 	private AssetManager assets;
 }
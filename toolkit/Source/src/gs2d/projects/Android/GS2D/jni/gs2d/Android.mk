@@ -27,6 +27,7 @@ LOCAL_SRC_FILES := \
 	$(GS2D_SOURCE_RELATIVE_PATH)/Application.cpp \
 	$(GS2D_SOURCE_RELATIVE_PATH)/Math/Randomizer.cpp \
 	$(GS2D_SOURCE_RELATIVE_PATH)/Math/Color.cpp \
+	$(GS2D_SOURCE_RELATIVE_PATH)/Math/GameMath.cpp \
 	$(GS2D_SOURCE_RELATIVE_PATH)/Math/OrientedBoundingBox.cpp \
 	$(GS2D_SOURCE_RELATIVE_PATH)/Video/BitmapFont.cpp \
 	$(GS2D_SOURCE_RELATIVE_PATH)/Video/BitmapFontManager.cpp \
@@ -43,6 +44,10 @@ LOCAL_SRC_FILES := \
 	$(GS2D_SOURCE_RELATIVE_PATH)/Audio/Android/AndroidAudio.cpp \
 	$(GS2D_SOURCE_RELATIVE_PATH)/Platform/Platform.cpp \
 	$(GS2D_SOURCE_RELATIVE_PATH)/Platform/Logger.cpp \
+	$(GS2D_SOURCE_RELATIVE_PATH)/Platform/MonotonicClock.cpp \
+	$(GS2D_SOURCE_RELATIVE_PATH)/Platform/FileWatcher.cpp \
+	$(GS2D_SOURCE_RELATIVE_PATH)/Platform/Thread.cpp \
+	$(GS2D_SOURCE_RELATIVE_PATH)/Platform/BufferedFileLogger.cpp \
 	$(GS2D_SOURCE_RELATIVE_PATH)/Platform/FileLogger.cpp \
 	$(GS2D_SOURCE_RELATIVE_PATH)/Platform/FileIOHub.cpp \
 	$(GS2D_SOURCE_RELATIVE_PATH)/Platform/android/Platform.android.cpp \
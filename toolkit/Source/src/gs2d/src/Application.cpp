@@ -35,19 +35,21 @@ GS2D_API unsigned long ComputeElapsedTime(ApplicationPtr app)
 
 GS2D_API float ComputeElapsedTimeF(ApplicationPtr app)
 {
-	static float lastTime = 0;
-	const float currentTime = app->GetElapsedTimeF(Application::TU_SECONDS);
-	float elapsedTime = currentTime - lastTime;
+	// the millisecond timers rounded frame deltas to whole milliseconds, which
+	// made motion visibly uneven on high refresh rate displays (6.94ms frames at 144Hz)
+	static boost::uint64_t lastTime = 0;
+	const boost::uint64_t currentTime = app->GetElapsedTimeUS();
 
-	// if the timer had been reset, the elapsed time will be negative,
-	// since it can't be, lets set it to an acceptable value
-	if (elapsedTime <= 0.0f)
+	// the first frame has no previous reference, so lets set it to an acceptable value
+	if (lastTime == 0 || currentTime <= lastTime)
 	{
-		elapsedTime = 1.0f / 60.0f;
+		lastTime = currentTime;
+		return 1000.0f / 60.0f;
 	}
 
+	const boost::uint64_t elapsedTime = currentTime - lastTime;
 	lastTime = currentTime;
-	return elapsedTime * 1000.0f;
+	return static_cast<float>(static_cast<double>(elapsedTime) / 1000.0);
 }
 
 void ShowMessage(const str_type::string& str, const GS_MESSAGE_TYPE type)
@@ -57,6 +59,11 @@ void ShowMessage(const str_type::string& str, const GS_MESSAGE_TYPE type)
 	ShowMessage(ss, type);
 }
 
+boost::uint64_t Application::GetElapsedTimeUS() const
+{
+	return m_monotonicClock.GetElapsedTimeUS();
+}
+
 void Application::SetScreenSizeChangeListener(const ScreenSizeChangeListenerPtr& listener)
 {
 	m_screenSizeChangeListener = listener;
@@ -28,6 +28,7 @@
 #include "Math/GameMath.h"
 
 #include "Platform/FileIOHub.h"
+#include "Platform/MonotonicClock.h"
 #include "Platform/SharedData/SharedDataManager.h"
 
 namespace gs2d {
@@ -109,6 +110,11 @@ public:
 	 */
 	virtual float GetElapsedTimeF(const TIME_UNITY unity = TU_MILLISECONDS) const = 0;
 
+	/** \brief Returns the time elapsed since the application started, in microseconds.
+	 * \details Read from a monotonic clock, so it is unaffected by ResetTimer() and system time changes.
+	 */
+	virtual boost::uint64_t GetElapsedTimeUS() const;
+
 	/// Resets the application timer
 	virtual void ResetTimer() = 0;
 
@@ -125,6 +131,7 @@ public:
 protected:
 	ScreenSizeChangeListenerWeakPtr m_screenSizeChangeListener;
 	FileOpenListenerPtr m_fileOpenListener;
+	Platform::MonotonicClock m_monotonicClock;
 
 	virtual bool StartApplication(
 		const unsigned int width,
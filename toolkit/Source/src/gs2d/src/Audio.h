@@ -89,6 +89,8 @@ public:
 class AudioSample
 {
 public:
+	static const unsigned int DEFAULT_MAX_VOICES = 8;
+
 	virtual bool LoadSampleFromFile(
 		AudioWeakPtr audio,
 		const str_type::string& fileName,
@@ -122,6 +124,28 @@ public:
 
 	virtual bool SetPan(const float pan) = 0;
 	virtual float GetPan() const = 0;
+
+	/**
+	 * \brief Plays an independent copy of a sound effect and forgets about it
+	 *
+	 * The copy has its own volume, pan and speed and does not change the state
+	 * of the sample itself. Samples that are streamed from disk have no copies;
+	 * for those this is the same as Play().
+	 */
+	virtual bool PlayVoice(const float volume, const float pan, const float speed) = 0;
+
+	/**
+	 * \brief Limits how many copies started by PlayVoice may sound at once
+	 *
+	 * Once the limit is reached the quietest copy is cut to make room, the
+	 * oldest one if several are equally loud. Android's SoundPool also caps
+	 * how many effects of all samples may sound at once.
+	 */
+	virtual void SetMaxVoices(const unsigned int maxVoices) = 0;
+	virtual unsigned int GetMaxVoices() const = 0;
+
+	/// Android can't query its SoundPool, so there voices count until the effect's length has passed
+	virtual unsigned int GetNumActiveVoices() = 0;
 };
 
 /// Instantiates an Input object
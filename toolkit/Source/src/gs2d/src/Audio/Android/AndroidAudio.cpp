@@ -23,6 +23,8 @@
 #include "AndroidAudio.h"
 #include <exception>
 #include "../../Platform/android/Platform.android.h"
+#include "../../Platform/MonotonicClock.h"
+#include "../../Application.h"
 
 namespace gs2d {
 
@@ -122,11 +124,13 @@ float AndroidAudioContext::GetGlobalVolume() const
 // Audio sample
 
 Platform::FileLogger AndroidAudioSample::m_logger(Platform::FileLogger::GetLogDirectory() + "AndroidAudioSample.log.txt");
+const str_type::string AndroidAudioSample::SAMPLE_DURATION_SHARED_DATA_PREFIX = "ethanon.system.sampleDuration.";
 
 AndroidAudioSample::AndroidAudioSample() :
 	m_volume(1.0f),
 	m_speed(1.0f),
-	m_loop(false)
+	m_loop(false),
+	m_maxVoices(DEFAULT_MAX_VOICES)
 {
 }
 
@@ -268,4 +272,92 @@ float AndroidAudioSample::GetPan() const
 	return 0.0f;
 }
 
+boost::uint64_t AndroidAudioSample::GetVoiceDurationUS(const float speed) const
+{
+	// reported in milliseconds by the Java side once the effect is loaded
+	str_type::stringstream ss;
+	ss << Application::SharedData.Get(SAMPLE_DURATION_SHARED_DATA_PREFIX + m_fileName);
+	double durationMS = 0.0;
+	if (!(ss >> durationMS))
+		return 0;
+
+	// SoundPool clamps the playback rate to the same range
+	const double rate = math::Max(0.5f, math::Min(2.0f, speed));
+	return static_cast<boost::uint64_t>(durationMS * 1000.0 / rate);
+}
+
+void AndroidAudioSample::ReleaseFinishedVoices()
+{
+	const boost::uint64_t now = Platform::MonotonicClock::GetCurrentTimeUS();
+	for (std::size_t t = 0; t < m_voices.size();)
+	{
+		if (m_voices[t].endTimeUS <= now)
+			m_voices.erase(m_voices.begin() + t);
+		else
+			++t;
+	}
+}
+
+std::size_t AndroidAudioSample::FindVoiceToSteal() const
+{
+	// the quietest voice goes first, the oldest one among equally loud voices
+	std::size_t victim = 0;
+	for (std::size_t t = 1; t < m_voices.size(); t++)
+	{
+		if (m_voices[t].volume < m_voices[victim].volume)
+			victim = t;
+	}
+	return victim;
+}
+
+bool AndroidAudioSample::PlayVoice(const float volume, const float pan, const float speed)
+{
+	if (AndroidAudioContext::IsStreamable(m_type))
+	{
+		return Play();
+	}
+
+	if (m_maxVoices == 0)
+		return false;
+
+	// the Java side steals the same voice when it receives the command
+	ReleaseFinishedVoices();
+	if (m_voices.size() >= m_maxVoices)
+		m_voices.erase(m_voices.begin() + FindVoiceToSteal());
+
+	m_audio->Command(Platform::NativeCommandAssembler::PlayVoice(m_fileName, volume, pan, speed, m_maxVoices));
+
+	Voice voice;
+	voice.endTimeUS = Platform::MonotonicClock::GetCurrentTimeUS() + GetVoiceDurationUS(speed);
+	voice.volume = volume;
+	m_voices.push_back(voice);
+	return true;
+}
+
+void AndroidAudioSample::SetMaxVoices(const unsigned int maxVoices)
+{
+	m_maxVoices = maxVoices;
+	if (AndroidAudioContext::IsStreamable(m_type))
+		return;
+
+	ReleaseFinishedVoices();
+	if (m_voices.size() > m_maxVoices)
+	{
+		while (m_voices.size() > m_maxVoices)
+			m_voices.erase(m_voices.begin() + FindVoiceToSteal());
+		m_audio->Command(Platform::NativeCommandAssembler::LimitVoices(m_fileName, m_maxVoices));
+	}
+}
+
+unsigned int AndroidAudioSample::GetMaxVoices() const
+{
+	return m_maxVoices;
+}
+
+unsigned int AndroidAudioSample::GetNumActiveVoices()
+{
+	ReleaseFinishedVoices();
+	return static_cast<unsigned int>(m_voices.size());
+}
+
 } // namespace gs2d
@@ -27,6 +27,10 @@
 #include "../../Platform/FileLogger.h"
 #include "../../Platform/android/Platform.android.h"
 
+#include <boost/cstdint.hpp>
+
+#include <vector>
+
 namespace gs2d {
 
 class AndroidAudioContext : public Audio, public Platform::NativeCommandForwarder
@@ -66,15 +70,33 @@ typedef boost::shared_ptr<AndroidAudioContext> AndroidAudioContextWeakPtr;
 
 class AndroidAudioSample : public AudioSample
 {
+	// the Java SoundPool can't be queried, so voices are tracked by the time they are
+	// due to end. The Java side keeps the same list for the stream ids it has to stop
+	struct Voice
+	{
+		boost::uint64_t endTimeUS;
+		float volume;
+	};
+
 	AndroidAudioContext* m_audio;
 
 	str_type::string m_fileName;
 	float m_volume, m_speed;
 	bool m_loop;
+	unsigned int m_maxVoices;
 	Audio::SAMPLE_TYPE m_type;
 	static Platform::FileLogger m_logger;
 
+	// kept in the order they were started
+	std::vector<Voice> m_voices;
+
+	boost::uint64_t GetVoiceDurationUS(const float speed) const;
+	void ReleaseFinishedVoices();
+	std::size_t FindVoiceToSteal() const;
+
 public:
+	static const str_type::string SAMPLE_DURATION_SHARED_DATA_PREFIX;
+
 	AndroidAudioSample();
 	~AndroidAudioSample();
 
@@ -111,6 +133,11 @@ public:
 
 	bool SetPan(const float pan);
 	float GetPan() const;
+
+	bool PlayVoice(const float volume, const float pan, const float speed);
+	void SetMaxVoices(const unsigned int maxVoices);
+	unsigned int GetMaxVoices() const;
+	unsigned int GetNumActiveVoices();
 };
 
 } // namespace gs2d
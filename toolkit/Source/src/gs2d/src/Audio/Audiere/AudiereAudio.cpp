@@ -21,6 +21,7 @@
 --------------------------------------------------------------------------------------*/
 
 #include "AudiereAudio.h"
+#include "AudiereFileStream.h"
 
 #include "../../Math/GameMath.h"
 
@@ -85,7 +86,9 @@ AudioSamplePtr AudiereContext::LoadSampleFromFileInMemory(
 
 bool AudiereContext::CreateAudioDevice(boost::any data)
 {
-	m_device = audiere::OpenDevice();
+	// an Audiere device name, such as "null", may be requested through data
+	const char* const* deviceName = boost::any_cast<const char*>(&data);
+	m_device = audiere::OpenDevice(deviceName ? *deviceName : 0);
 	if (!m_device)
 	{
 		ShowMessage(GS_L("Audiere initialization failed - AudiereContext::CreateAudioDevice"));
@@ -132,13 +135,25 @@ bool AudiereSample::LoadSampleFromFile(
 	const Platform::FileManagerPtr& fileManager,
 	const Audio::SAMPLE_TYPE type)
 {
-	Platform::FileBuffer out;
-	fileManager->GetFileBuffer(fileName, out);
 	bool r = false;
 
-	if (out)
+	if (IsStreamable(type))
 	{
-		r = LoadSampleFromFileInMemory(audio, out->GetAddress(), out->GetBufferSize(), type);
+		// decode while playing instead of keeping the whole file resident
+		Platform::FileStreamPtr stream = fileManager->OpenFileStream(fileName);
+		if (stream)
+		{
+			r = LoadSample(audio, new AudiereFileStream(stream), type);
+		}
+	}
+	else
+	{
+		Platform::FileBuffer out;
+		fileManager->GetFileBuffer(fileName, out);
+		if (out)
+		{
+			r = LoadSampleFromFileInMemory(audio, out->GetAddress(), out->GetBufferSize(), type);
+		}
 	}
 
 	if (!r)
@@ -157,23 +172,33 @@ bool AudiereSample::LoadSampleFromFileInMemory(
 	const unsigned int bufferLength,
 	const Audio::SAMPLE_TYPE type)
 {
-	m_audio = audio;
-	m_type = type;
+	return LoadSample(audio, audiere::CreateMemoryFile(pBuffer, bufferLength), type);
+}
 
-	bool stream;
-	switch (m_type)
+bool AudiereSample::IsStreamable(const Audio::SAMPLE_TYPE type)
+{
+	switch (type)
 	{
 	case Audio::MUSIC:
 	case Audio::AMBIENT_SFX:
 	case Audio::SOUNDTRACK:
-		stream = true;
-		break;
+		return true;
 	case Audio::SOUND_EFFECT:
 	case Audio::UNKNOWN_TYPE:
 	default:
-		stream = false;
-		break;
+		return false;
 	};
+}
+
+bool AudiereSample::LoadSample(
+	AudioWeakPtr audio,
+	const audiere::FilePtr& file,
+	const Audio::SAMPLE_TYPE type)
+{
+	m_audio = audio;
+	m_type = type;
+
+	const bool stream = IsStreamable(m_type);
 
 	audiere::AudioDevicePtr device;
 	try
@@ -185,8 +210,26 @@ bool AudiereSample::LoadSampleFromFileInMemory(
 		return false;
 	}
 
-	audiere::FilePtr file = audiere::CreateMemoryFile(pBuffer, bufferLength);
-	m_output = audiere::OpenSound(device, file, stream);
+	audiere::SampleSourcePtr source = audiere::OpenSampleSource(file);
+	if (!source)
+	{
+		return false;
+	}
+
+	// sound effects are decoded once; the sample and all its voices share the buffer
+	if (!stream && source->isSeekable())
+	{
+		audiere::SampleBufferPtr buffer = audiere::CreateSampleBuffer(source);
+		if (buffer)
+		{
+			m_output = device->openStream(buffer->openStream());
+			m_voicePool = boost::shared_ptr<AudiereVoicePool>(new AudiereVoicePool(device, buffer));
+		}
+	}
+	else
+	{
+		m_output = device->openStream(source.get());
+	}
 
 	if (!m_output)
 	{
@@ -299,4 +342,38 @@ float AudiereSample::GetVolume() const
 	return m_volume;
 }
 
+bool AudiereSample::PlayVoice(const float volume, const float pan, const float speed)
+{
+	if (!m_voicePool)
+	{
+		return Play();
+	}
+	return m_voicePool->Play(
+		math::Min(math::Max(volume, 0.0f), 1.0f) * m_audio.lock().get()->GetGlobalVolume(),
+		math::Min(math::Max(pan, -1.0f), 1.0f),
+		math::Min(math::Max(speed, 0.5f), 2.0f));
+}
+
+void AudiereSample::SetMaxVoices(const unsigned int maxVoices)
+{
+	if (m_voicePool)
+	{
+		m_voicePool->SetMaxVoices(maxVoices);
+	}
+}
+
+unsigned int AudiereSample::GetMaxVoices() const
+{
+	return m_voicePool ? m_voicePool->GetMaxVoices() : 1;
+}
+
+unsigned int AudiereSample::GetNumActiveVoices()
+{
+	if (m_voicePool)
+	{
+		return m_voicePool->GetNumActiveVoices();
+	}
+	return IsPlaying() ? 1 : 0;
+}
+
 } // namespace gs2d
@@ -24,7 +24,7 @@
 #define GS2D_AUDIERE_H_
 
 #include "../../Audio.h"
-#include "audiere/src/audiere.h"
+#include "AudiereVoicePool.h"
 
 namespace gs2d {
 
@@ -63,6 +63,7 @@ typedef boost::shared_ptr<AudiereContext> AudiereContextPtr;
 class AudiereSample : public AudioSample
 {
 	audiere::OutputStreamPtr m_output;
+	boost::shared_ptr<AudiereVoicePool> m_voicePool;
 	int m_position;
 	Audio::SAMPLE_STATUS m_status;
 	float m_volume;
@@ -82,6 +83,13 @@ class AudiereSample : public AudioSample
 		const unsigned int bufferLength,
 		const Audio::SAMPLE_TYPE type = Audio::UNKNOWN_TYPE);
 
+	bool LoadSample(
+		AudioWeakPtr audio,
+		const audiere::FilePtr& file,
+		const Audio::SAMPLE_TYPE type);
+
+	static bool IsStreamable(const Audio::SAMPLE_TYPE type);
+
 public:
 	AudiereSample();
 	~AudiereSample();
@@ -107,6 +115,11 @@ public:
 
 	bool SetPan(const float pan);
 	float GetPan() const;
+
+	bool PlayVoice(const float volume, const float pan, const float speed);
+	void SetMaxVoices(const unsigned int maxVoices);
+	unsigned int GetMaxVoices() const;
+	unsigned int GetNumActiveVoices();
 };
 
 } // namespace gs2d
@@ -0,0 +1,122 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#include "AudiereFileStream.h"
+
+#include <string.h>
+
+namespace gs2d {
+
+AudiereFileStream::AudiereFileStream(const Platform::FileStreamPtr& stream) :
+	m_stream(stream),
+	m_window(new unsigned char [WINDOW_SIZE]),
+	m_windowStart(0),
+	m_windowLength(0),
+	m_position(0)
+{
+}
+
+AudiereFileStream::~AudiereFileStream()
+{
+	delete [] m_window;
+}
+
+bool AudiereFileStream::FillWindow()
+{
+	const unsigned long windowEnd = m_windowStart + m_windowLength;
+	unsigned long kept = 0;
+	if (m_position == windowEnd && m_windowLength > KEEP_BEHIND)
+	{
+		// sequential read: slide the tail of the window to the front and read on
+		kept = KEEP_BEHIND;
+		memmove(m_window, m_window + m_windowLength - kept, kept);
+		m_windowStart = windowEnd - kept;
+	}
+	else
+	{
+		m_windowStart = (m_position > KEEP_BEHIND) ? (m_position - KEEP_BEHIND) : 0;
+		if (m_stream->Tell() != m_windowStart
+			&& !m_stream->Seek(static_cast<long>(m_windowStart), Platform::FileStream::FROM_BEGIN))
+		{
+			m_windowLength = 0;
+			return false;
+		}
+	}
+
+	const unsigned long read = m_stream->Read(m_window + kept, WINDOW_SIZE - kept);
+	m_windowLength = kept + read;
+	return (m_position < m_windowStart + m_windowLength);
+}
+
+int AudiereFileStream::read(void* buffer, int size)
+{
+	unsigned char* out = static_cast<unsigned char*>(buffer);
+	int done = 0;
+	while (done < size)
+	{
+		if (m_position < m_windowStart || m_position >= m_windowStart + m_windowLength)
+		{
+			if (!FillWindow())
+				break;
+		}
+
+		const unsigned long offset = m_position - m_windowStart;
+		const unsigned long available = m_windowLength - offset;
+		const unsigned long wanted = static_cast<unsigned long>(size - done);
+		const unsigned long count = (wanted < available) ? wanted : available;
+		memcpy(out + done, m_window + offset, count);
+		m_position += count;
+		done += static_cast<int>(count);
+	}
+	return done;
+}
+
+bool AudiereFileStream::seek(int position, SeekMode mode)
+{
+	long base = 0;
+	switch (mode)
+	{
+	case CURRENT:
+		base = static_cast<long>(m_position);
+		break;
+	case END:
+		base = static_cast<long>(m_stream->GetSize());
+		break;
+	default:
+		break;
+	};
+
+	const long target = base + position;
+	if (target < 0 || target > static_cast<long>(m_stream->GetSize()))
+		return false;
+
+	// the actual seek is deferred until a read falls outside the window
+	m_position = static_cast<unsigned long>(target);
+	return true;
+}
+
+int AudiereFileStream::tell()
+{
+	return static_cast<int>(m_position);
+}
+
+} // namespace gs2d
@@ -0,0 +1,65 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#ifndef GS2D_AUDIERE_FILE_STREAM_H_
+#define GS2D_AUDIERE_FILE_STREAM_H_
+
+#include "../../Platform/FileManager.h"
+#include "audiere/src/audiere.h"
+
+namespace gs2d {
+
+/**
+ * \brief Lets Audiere decode straight from a FileManager stream
+ *
+ * Reads go through a small window that also keeps the last few KB behind
+ * the read position, since decoders often step back a little while parsing
+ * and backward seeks are expensive on compressed zip entries.
+ */
+class AudiereFileStream : public audiere::RefImplementation<audiere::File>
+{
+	enum
+	{
+		WINDOW_SIZE = 64 * 1024,
+		KEEP_BEHIND = 16 * 1024
+	};
+
+	Platform::FileStreamPtr m_stream;
+	unsigned char* m_window;
+	unsigned long m_windowStart;
+	unsigned long m_windowLength;
+	unsigned long m_position;
+
+	bool FillWindow();
+
+public:
+	AudiereFileStream(const Platform::FileStreamPtr& stream);
+	~AudiereFileStream();
+
+	int ADR_CALL read(void* buffer, int size);
+	bool ADR_CALL seek(int position, SeekMode mode);
+	int ADR_CALL tell();
+};
+
+} // namespace gs2d
+
+#endif
@@ -0,0 +1,141 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#include "AudiereVoicePool.h"
+
+namespace gs2d {
+
+AudiereVoicePool::AudiereVoicePool(const audiere::AudioDevicePtr& device, const audiere::SampleBufferPtr& buffer) :
+	m_device(device),
+	m_buffer(buffer),
+	m_maxVoices(AudioSample::DEFAULT_MAX_VOICES),
+	m_playCount(0)
+{
+}
+
+AudiereVoicePool::~AudiereVoicePool()
+{
+	StopAll();
+}
+
+std::size_t AudiereVoicePool::FindIdleVoice() const
+{
+	for (std::size_t t = 0; t < m_voices.size(); t++)
+	{
+		if (!m_voices[t].output->isPlaying())
+			return t;
+	}
+	return m_voices.size();
+}
+
+std::size_t AudiereVoicePool::FindVoiceToSteal() const
+{
+	// the quietest voice goes first, the oldest one among equally loud voices
+	std::size_t victim = 0;
+	for (std::size_t t = 1; t < m_voices.size(); t++)
+	{
+		const Voice& voice = m_voices[t];
+		const Voice& current = m_voices[victim];
+		if (voice.volume < current.volume
+			|| (voice.volume == current.volume && voice.startedAt < current.startedAt))
+		{
+			victim = t;
+		}
+	}
+	return victim;
+}
+
+bool AudiereVoicePool::Play(const float volume, const float pan, const float speed)
+{
+	if (m_maxVoices == 0)
+		return false;
+
+	std::size_t index = FindIdleVoice();
+	if (index == m_voices.size())
+	{
+		if (m_voices.size() < m_maxVoices)
+		{
+			Voice voice;
+			voice.output = m_device->openStream(m_buffer->openStream());
+			if (!voice.output)
+				return false;
+			voice.volume = 0.0f;
+			voice.startedAt = 0;
+			m_voices.push_back(voice);
+		}
+		else
+		{
+			index = FindVoiceToSteal();
+			m_voices[index].output->stop();
+		}
+	}
+
+	Voice& voice = m_voices[index];
+	voice.volume = volume;
+	voice.startedAt = ++m_playCount;
+	voice.output->reset();
+	voice.output->setVolume(volume);
+	voice.output->setPan(pan);
+	voice.output->setPitchShift(speed);
+	voice.output->play();
+	return true;
+}
+
+void AudiereVoicePool::StopAll()
+{
+	for (std::size_t t = 0; t < m_voices.size(); t++)
+	{
+		m_voices[t].output->stop();
+	}
+}
+
+void AudiereVoicePool::SetMaxVoices(const unsigned int maxVoices)
+{
+	m_maxVoices = maxVoices;
+	while (m_voices.size() > m_maxVoices)
+	{
+		std::size_t index = FindIdleVoice();
+		if (index == m_voices.size())
+			index = FindVoiceToSteal();
+
+		m_voices[index].output->stop();
+		m_voices.erase(m_voices.begin() + index);
+	}
+}
+
+unsigned int AudiereVoicePool::GetMaxVoices() const
+{
+	return m_maxVoices;
+}
+
+unsigned int AudiereVoicePool::GetNumActiveVoices() const
+{
+	unsigned int count = 0;
+	for (std::size_t t = 0; t < m_voices.size(); t++)
+	{
+		if (m_voices[t].output->isPlaying())
+			++count;
+	}
+	return count;
+}
+
+} // namespace gs2d
@@ -0,0 +1,74 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#ifndef GS2D_AUDIERE_VOICE_POOL_H_
+#define GS2D_AUDIERE_VOICE_POOL_H_
+
+#include "../../Audio.h"
+#include "audiere/src/audiere.h"
+
+#include <vector>
+
+namespace gs2d {
+
+/**
+ * \brief Plays overlapping copies of a decoded sound effect
+ *
+ * All voices read from the same immutable SampleBuffer, so the effect is
+ * decoded once no matter how many copies of it are sounding. Voices are
+ * created on demand up to the limit and reused once they finish.
+ */
+class AudiereVoicePool
+{
+	friend class AudiereVoicePoolTest;
+
+	struct Voice
+	{
+		audiere::OutputStreamPtr output;
+		float volume;
+		unsigned long startedAt;
+	};
+
+	audiere::AudioDevicePtr m_device;
+	audiere::SampleBufferPtr m_buffer;
+	std::vector<Voice> m_voices;
+	unsigned int m_maxVoices;
+	unsigned long m_playCount;
+
+	std::size_t FindIdleVoice() const;
+	std::size_t FindVoiceToSteal() const;
+
+public:
+	AudiereVoicePool(const audiere::AudioDevicePtr& device, const audiere::SampleBufferPtr& buffer);
+	~AudiereVoicePool();
+
+	bool Play(const float volume, const float pan, const float speed);
+	void StopAll();
+
+	void SetMaxVoices(const unsigned int maxVoices);
+	unsigned int GetMaxVoices() const;
+	unsigned int GetNumActiveVoices() const;
+};
+
+} // namespace gs2d
+
+#endif
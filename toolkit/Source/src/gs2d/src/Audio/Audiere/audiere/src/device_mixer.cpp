@@ -8,11 +8,114 @@
 #include "resampler.h"
 #include "utility.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #define ADR_MIXER_SSE2
+  #include <emmintrin.h>
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+  #define ADR_MIXER_NEON
+  #include <arm_neon.h>
+#endif
+
 
 namespace audiere {
 
+  // The mix is accumulated in 32-bit ints (not s32, which is a long and so
+  // 64 bits wide on LP64 targets).  Each voice is scaled with the same
+  // integer arithmetic as the original mixer, truncating every sample on
+  // its own, so the output does not depend on the kernel used.
+
+  enum { FULL_VOLUME = 255 * 255 };
+
+  /// mix += in * (volume_l, volume_r) / FULL_VOLUME, for interleaved stereo frames
+  static void MixStereo(
+    const s16* in, int frame_count,
+    int volume_l, int volume_r,
+    int* mix)
+  {
+    const int sample_count = frame_count * 2;
+    int i = 0;
+
+    if (volume_l == FULL_VOLUME && volume_r == FULL_VOLUME) {
+      // the most common case: the samples go through unchanged
+#if defined(ADR_MIXER_SSE2)
+      for (; i + 8 <= sample_count; i += 8) {
+        const __m128i x = _mm_loadu_si128((const __m128i*)(in + i));
+        const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16);
+        const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16);
+        _mm_storeu_si128((__m128i*)(mix + i),
+          _mm_add_epi32(_mm_loadu_si128((const __m128i*)(mix + i)), lo));
+        _mm_storeu_si128((__m128i*)(mix + i + 4),
+          _mm_add_epi32(_mm_loadu_si128((const __m128i*)(mix + i + 4)), hi));
+      }
+#elif defined(ADR_MIXER_NEON)
+      for (; i + 8 <= sample_count; i += 8) {
+        const int16x8_t x = vld1q_s16(in + i);
+        vst1q_s32(mix + i,     vaddw_s16(vld1q_s32(mix + i),     vget_low_s16(x)));
+        vst1q_s32(mix + i + 4, vaddw_s16(vld1q_s32(mix + i + 4), vget_high_s16(x)));
+      }
+#endif
+      for (; i < sample_count; ++i) {
+        mix[i] += in[i];
+      }
+      return;
+    }
+
+    // the division truncates toward zero, exactly as the original mixer did
+    for (; i < sample_count; i += 2) {
+      mix[i]     += in[i]     * volume_l / 255 / 255;
+      mix[i + 1] += in[i + 1] * volume_r / 255 / 255;
+    }
+  }
+
+
+  /// mix += (l, r) for every frame; used to hold the last sample of a voice
+  static void MixConstantStereo(int frame_count, int l, int r, int* mix) {
+    for (int i = 0; i < frame_count; ++i) {
+      *mix++ += l;
+      *mix++ += r;
+    }
+  }
+
+
+  /// Saturate the mix buffer to s16.
+  static void ClampToS16(const int* mix, int sample_count, s16* out) {
+    int i = 0;
+
+#if defined(ADR_MIXER_SSE2)
+    for (; i + 8 <= sample_count; i += 8) {
+      const __m128i a = _mm_loadu_si128((const __m128i*)(mix + i));
+      const __m128i b = _mm_loadu_si128((const __m128i*)(mix + i + 4));
+      _mm_storeu_si128((__m128i*)(out + i), _mm_packs_epi32(a, b));
+    }
+#elif defined(ADR_MIXER_NEON)
+    for (; i + 8 <= sample_count; i += 8) {
+      const int16x4_t a = vqmovn_s32(vld1q_s32(mix + i));
+      const int16x4_t b = vqmovn_s32(vld1q_s32(mix + i + 4));
+      vst1q_s16(out + i, vcombine_s16(a, b));
+    }
+#endif
+
+    for (; i < sample_count; ++i) {
+      int mixed = mix[i];
+      if (mixed < -32768) {
+        mixed = -32768;
+      } else if (mixed > 32767) {
+        mixed = 32767;
+      }
+      out[i] = (s16)mixed;
+    }
+  }
+
+
   MixerDevice::MixerDevice(int rate) {
     m_rate = rate;
+    m_removing = 0;
+
+    for (int i = 0; i < COMMAND_QUEUE_SIZE; ++i) {
+      m_commands[i].sequence = i;
+    }
+    m_command_write = 0;
+    m_command_read = 0;
   }
 
 
@@ -41,15 +144,14 @@ namespace audiere {
 
 //    ADR_LOG("done locking mixer device");
 
+    processCommands();
+
     // are any sources playing?
     bool any_playing = false;
-    for (std::list<MixerStream*>::iterator i = m_streams.begin();
-         i != m_streams.end();
-         ++i)
-    {
-      any_playing |= (*i)->m_is_playing;
+    for (size_t i = 0; i < m_voices.size(); ++i) {
+      any_playing |= m_voices[i].is_playing;
     }
-  
+
     // if not, return zeroed samples
     if (!any_playing) {
       memset(samples, 0, 4 * sample_count);
@@ -58,42 +160,23 @@ namespace audiere {
 
     ADR_LOG("at least one stream is playing");
 
-    // buffer in which to mix the audio
-    static const int BUFFER_SIZE = 4096;
-
     // mix the output in chunks of BUFFER_SIZE samples
     s16* out = (s16*)samples;
     int left = sample_count;
     while (left > 0) {
-      int to_mix = std::min(BUFFER_SIZE, left);
-
-      s32 mix_buffer[BUFFER_SIZE];
-      memset(mix_buffer, 0, sizeof(mix_buffer));
-    
-      for (std::list<MixerStream*>::iterator s = m_streams.begin();
-           s != m_streams.end();
-           ++s)
-      {
-        if ((*s)->m_is_playing) {
-          s16 stream_buffer[BUFFER_SIZE * 2];
-          (*s)->read(to_mix, stream_buffer);
-          for (int i = 0; i < to_mix * 2; ++i) {
-            mix_buffer[i] += stream_buffer[i];
-          }
-        }
-      }
+      int to_mix = std::min(int(BUFFER_SIZE), left);
+
+      memset(m_mix_buffer, 0, to_mix * 2 * sizeof(int));
 
-      // clamp each value in the buffer to the valid s16 range
-      for (int i = 0; i < to_mix * 2; ++i) {
-        s32 mixed = mix_buffer[i];
-        if (mixed < -32768) {
-          mixed = -32768;
-        } else if (mixed > 32767) {
-          mixed = 32767;
+      for (size_t i = 0; i < m_voices.size(); ++i) {
+        if (m_voices[i].is_playing) {
+          mixVoice(m_voices[i], to_mix);
         }
-        *out++ = (s16)mixed;
       }
 
+      ClampToS16(m_mix_buffer, to_mix * 2, out);
+      out += to_mix * 2;
+
       left -= to_mix;
     }
 
@@ -101,6 +184,181 @@ namespace audiere {
   }
 
 
+  void
+  MixerDevice::postCommand(
+    MixerStream* stream, CommandType type,
+    float a, float b)
+  {
+    Command command;
+    command.stream = stream;
+    command.type   = type;
+    command.a      = a;
+    command.b      = b;
+
+    // If the mixer has not drained the queue in a long while (e.g. the
+    // device is not being updated), apply the pending commands ourselves.
+    while (!tryPostCommand(command)) {
+      SYNCHRONIZED(this);
+      processCommands();
+    }
+  }
+
+
+  bool
+  MixerDevice::tryPostCommand(const Command& command) {
+    for (;;) {
+      const unsigned pos = unsigned(AI_AtomicLoad(&m_command_write));
+      CommandCell& cell = m_commands[pos & (COMMAND_QUEUE_SIZE - 1)];
+      const unsigned sequence = unsigned(AI_AtomicLoad(&cell.sequence));
+      const int diff = int(sequence - pos);
+      if (diff == 0) {
+        // the cell is free; claim it
+        if (AI_AtomicCompareExchange(
+              &m_command_write, int(pos + 1), int(pos)) == int(pos))
+        {
+          cell.command = command;
+          AI_AtomicStore(&cell.sequence, int(pos + 1));
+          return true;
+        }
+      } else if (diff < 0) {
+        // full
+        return false;
+      }
+      // another producer got here first, try the next cell
+    }
+  }
+
+
+  void
+  MixerDevice::processCommands() {
+    for (;;) {
+      CommandCell& cell = m_commands[m_command_read & (COMMAND_QUEUE_SIZE - 1)];
+      const unsigned sequence = unsigned(AI_AtomicLoad(&cell.sequence));
+      if (int(sequence - (m_command_read + 1)) < 0) {
+        // empty, or the next command is still being written
+        return;
+      }
+
+      const Command command = cell.command;
+      AI_AtomicStore(&cell.sequence, int(m_command_read + COMMAND_QUEUE_SIZE));
+      ++m_command_read;
+
+      applyCommand(command);
+    }
+  }
+
+
+  void
+  MixerDevice::applyCommand(const Command& command) {
+    MixerStream* stream = command.stream;
+    Voice& voice = m_voices[stream->m_voice];
+
+    switch (command.type) {
+      case CMD_PLAY:
+        voice.is_playing = true;
+        AI_AtomicStore(&stream->m_is_playing, 1);
+        break;
+
+      case CMD_STOP:
+        AI_AtomicStore(&stream->m_is_playing, 0);
+        if (voice.is_playing) {
+          voice.is_playing = false;
+          // a stream being destroyed can't be handed to the event thread
+          if (stream != m_removing) {
+            fireStopEvent(stream, StopEvent::STOP_CALLED);
+          }
+        }
+        break;
+
+      case CMD_VOLUME_PAN: {
+        // small integers survive the round trip through float exactly
+        const int volume = int(command.a);
+        const int pan    = int(command.b);
+        if (pan < 0) {
+          voice.volume_l = 255 * volume;
+          voice.volume_r = (255 + pan) * volume;
+        } else {
+          voice.volume_l = (255 - pan) * volume;
+          voice.volume_r = 255 * volume;
+        }
+        break;
+      }
+
+      case CMD_PITCH_SHIFT:
+        voice.source->setPitchShift(command.a);
+        break;
+    }
+  }
+
+
+  void
+  MixerDevice::addVoice(MixerStream* stream) {
+    Voice voice;
+    voice.stream     = stream;
+    voice.source     = stream->m_source.get();
+    voice.volume_l   = FULL_VOLUME;
+    voice.volume_r   = FULL_VOLUME;
+    voice.last_l     = 0;
+    voice.last_r     = 0;
+    voice.is_playing = false;
+
+    stream->m_voice = int(m_voices.size());
+    m_voices.push_back(voice);
+  }
+
+
+  void
+  MixerDevice::removeVoice(MixerStream* stream) {
+    // commands still in flight may refer to this stream
+    m_removing = stream;
+    processCommands();
+    m_removing = 0;
+
+    const size_t index = stream->m_voice;
+    if (index + 1 != m_voices.size()) {
+      m_voices[index] = m_voices.back();
+      m_voices[index].stream->m_voice = int(index);
+    }
+    m_voices.pop_back();
+  }
+
+
+  void
+  MixerDevice::mixVoice(Voice& voice, int frame_count) {
+    const int read = voice.source->read(frame_count, m_stream_buffer);
+
+    // if we are done with the sample source, stop and reset it
+    if (read == 0) {
+      voice.source->reset();
+      voice.is_playing = false;
+      AI_AtomicStore(&voice.stream->m_is_playing, 0);
+      // let subscribers know that the sound was stopped
+      fireStopEvent(voice.stream, StopEvent::STREAM_ENDED);
+    } else if (voice.volume_l != 0 || voice.volume_r != 0) {
+      MixStereo(m_stream_buffer, read, voice.volume_l, voice.volume_r,
+                m_mix_buffer);
+    }
+
+    // if we ready any frames, we can replace the old values
+    // for the last left and right channel states
+    int new_l = voice.last_l;
+    int new_r = voice.last_r;
+    if (read > 0) {
+      new_l = m_stream_buffer[read * 2 - 2] * voice.volume_l / 255 / 255;
+      new_r = m_stream_buffer[read * 2 - 1] * voice.volume_r / 255 / 255;
+    }
+
+    // and apply the last state to the rest of the buffer
+    if (read < frame_count && (voice.last_l != 0 || voice.last_r != 0)) {
+      MixConstantStereo(frame_count - read, voice.last_l, voice.last_r,
+                        m_mix_buffer + read * 2);
+    }
+
+    voice.last_l = new_l;
+    voice.last_r = new_r;
+  }
+
+
   MixerStream::MixerStream(
     MixerDevice* device,
     SampleSource* source,
@@ -108,46 +366,42 @@ namespace audiere {
   {
     m_device     = device;
     m_source     = new Resampler(source, rate);
-    m_last_l     = 0;
-    m_last_r     = 0;
-    m_is_playing = false;
+    m_voice      = -1;
+    m_is_playing = 0;
     m_volume     = 255;
     m_pan        = 0;
+    m_shift      = 1.0f;
 
     SYNCHRONIZED(m_device.get());
-    m_device->m_streams.push_back(this);
+    m_device->addVoice(this);
   }
 
 
   MixerStream::~MixerStream() {
     SYNCHRONIZED(m_device.get());
-    m_device->m_streams.remove(this);
+    m_device->removeVoice(this);
   }
 
 
   void
   MixerStream::play() {
-    SYNCHRONIZED(m_device.get());
-    m_is_playing = true;
+    AI_AtomicStore(&m_is_playing, 1);
+    m_device->postCommand(this, MixerDevice::CMD_PLAY);
   }
 
 
   void
   MixerStream::stop() {
-    SYNCHRONIZED(m_device.get());
-    if (m_is_playing) {
-      m_is_playing = false;
-      m_device->fireStopEvent(this, StopEvent::STOP_CALLED);
-    } else {
-      m_is_playing = false;
-    }
+    // the mixer fires STOP_CALLED if the voice was still playing when the
+    // command arrives; otherwise it already fired STREAM_ENDED
+    AI_AtomicStore(&m_is_playing, 0);
+    m_device->postCommand(this, MixerDevice::CMD_STOP);
   }
 
 
   bool
   MixerStream::isPlaying() {
-    SYNCHRONIZED(m_device.get());
-    return m_is_playing;
+    return (AI_AtomicLoad(&m_is_playing) != 0);
   }
 
 
@@ -174,43 +428,42 @@ namespace audiere {
 
   void
   MixerStream::setVolume(float volume) {
-    SYNCHRONIZED(m_device.get());
     m_volume = int(volume * 255.0f + 0.5f);
+    m_device->postCommand(this, MixerDevice::CMD_VOLUME_PAN,
+                          float(m_volume), float(m_pan));
   }
 
 
   float
   MixerStream::getVolume() {
-    SYNCHRONIZED(m_device.get());
     return (m_volume / 255.0f);
   }
 
 
   void
   MixerStream::setPan(float pan) {
-    SYNCHRONIZED(m_device.get());
     m_pan = int(pan * 255.0f);
+    m_device->postCommand(this, MixerDevice::CMD_VOLUME_PAN,
+                          float(m_volume), float(m_pan));
   }
 
 
   float
   MixerStream::getPan() {
-    SYNCHRONIZED(m_device.get());
     return m_pan / 255.0f;
   }
 
 
   void
   MixerStream::setPitchShift(float shift) {
-    SYNCHRONIZED(m_device.get());
-    m_source->setPitchShift(shift);
+    m_shift = shift;
+    m_device->postCommand(this, MixerDevice::CMD_PITCH_SHIFT, shift);
   }
 
 
   float
   MixerStream::getPitchShift() {
-    SYNCHRONIZED(m_device.get());
-    return m_source->getPitchShift();
+    return m_shift;
   }
 
 
@@ -239,61 +492,4 @@ namespace audiere {
     return m_source->getPosition();
   }
 
-
-  void
-  MixerStream::read(int frame_count, s16* buffer) {
-    unsigned read = m_source->read(frame_count, buffer);
-    s16* out = buffer;
-
-    // if we are done with the sample source, stop and reset it
-    if (read == 0) {
-      m_source->reset();
-      if (m_is_playing) {
-        m_is_playing = false;
-        // let subscribers know that the sound was stopped
-        m_device->fireStopEvent(this, StopEvent::STREAM_ENDED);
-      } else {
-        m_is_playing = false;
-      }
-    } else {
-      // do panning and volume normalization
-      int l_volume, r_volume;
-      if (m_pan < 0) {
-        l_volume = 255;
-        r_volume = 255 + m_pan;
-      } else {
-        l_volume = 255 - m_pan;
-        r_volume = 255;
-      }
-
-      l_volume *= m_volume;
-      r_volume *= m_volume;
-
-      for (unsigned i = 0; i < read; ++i) {
-        *out = *out * l_volume / 255 / 255;
-        ++out;
-        *out = *out * r_volume / 255 / 255;
-        ++out;
-      }
-    }
-
-    // if we ready any frames, we can replace the old values
-    // for the last left and right channel states
-    int new_l = m_last_l;
-    int new_r = m_last_r;
-    if (read > 0) {
-      new_l = out[-2];
-      new_r = out[-1];
-    }
-
-    // and apply the last state to the rest of the buffer
-    for (int i = read; i < frame_count; ++i) {
-      *out++ = m_last_l;
-      *out++ = m_last_r;
-    }
-
-    m_last_l = new_l;
-    m_last_r = new_r;
-  }
-
 }
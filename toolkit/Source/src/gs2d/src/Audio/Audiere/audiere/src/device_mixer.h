@@ -7,7 +7,7 @@
 #endif
 
 
-#include <list>
+#include <vector>
 #include "audiere.h"
 #include "device.h"
 #include "resampler.h"
@@ -21,7 +21,18 @@ namespace audiere {
   class MixerStream;
 
 
-  /// Always produce 16-bit, stereo audio at the specified rate.
+  /**
+   * Always produce 16-bit, stereo audio at the specified rate.
+   *
+   * Every stream owns a voice in a contiguous array that is only walked by
+   * the mixing thread.  play(), stop(), setVolume(), setPan() and
+   * setPitchShift() are posted through a lock-free command queue, so they
+   * never wait for a mix in progress.  The device lock still guards the
+   * voice array and the sample sources, which are not thread-safe.
+   *
+   * Voices only start and stop while the queue is drained or a mix runs,
+   * so the stop events are all fired from there, once per playback.
+   */
   class MixerDevice : public AbstractDevice, public Mutex {
   public:
     MixerDevice(int rate);
@@ -42,9 +53,65 @@ namespace audiere {
     int read(int sample_count, void* samples);
 
   private:
-    std::list<MixerStream*> m_streams;
+    enum CommandType {
+      CMD_PLAY,
+      CMD_STOP,
+      CMD_VOLUME_PAN,
+      CMD_PITCH_SHIFT
+    };
+
+    struct Command {
+      MixerStream* stream;
+      CommandType type;
+      float a;
+      float b;
+    };
+
+    struct CommandCell {
+      volatile int sequence;
+      Command command;
+    };
+
+    struct Voice {
+      MixerStream* stream;
+      Resampler* source;
+      int volume_l;  // 0 - 255 * 255
+      int volume_r;
+      int last_l;
+      int last_r;
+      bool is_playing;
+    };
+
+    // may be called from any thread; CMD_VOLUME_PAN takes the 8-bit
+    // volume and pan as a and b
+    void postCommand(MixerStream* stream, CommandType type,
+                     float a = 0.0f, float b = 0.0f);
+    bool tryPostCommand(const Command& command);
+
+    // the device lock must be held
+    void processCommands();
+    void applyCommand(const Command& command);
+    void addVoice(MixerStream* stream);
+    void removeVoice(MixerStream* stream);
+    void mixVoice(Voice& voice, int frame_count);
+
+  private:
+    // bounded multi-producer, single-consumer ring; must be a power of two
+    enum { COMMAND_QUEUE_SIZE = 1024 };
+    CommandCell m_commands[COMMAND_QUEUE_SIZE];
+    volatile int m_command_write;
+    unsigned m_command_read;
+
+    std::vector<Voice> m_voices;
     int m_rate;
 
+    // the stream being destroyed, which must not be referenced by events
+    MixerStream* m_removing;
+
+    enum { BUFFER_SIZE = 4096 };
+    int m_mix_buffer[BUFFER_SIZE * 2];
+    s16 m_stream_buffer[BUFFER_SIZE * 2];
+
     friend class MixerStream;
   };
 
@@ -73,18 +140,20 @@ namespace audiere {
     void ADR_CALL setPosition(int position);
     int  ADR_CALL getPosition();
 
-  private:
-    void read(int frame_count, s16* buffer);
-
   private:
     RefPtr<MixerDevice> m_device;
 
     RefPtr<Resampler> m_source;
-    s16 m_last_l;
-    s16 m_last_r;
-    bool m_is_playing;
-    int m_volume;
-    int m_pan;
+
+    // index into the device's voice array, guarded by the device lock
+    int m_voice;
+
+    // game-side view of the playback state; the mixer writes
+    // m_is_playing back when a stream ends
+    volatile int m_is_playing;
+    int m_volume;  // 0 - 255
+    int m_pan;     // -255 - 255
+    float m_shift;
 
     friend class MixerDevice;
   };
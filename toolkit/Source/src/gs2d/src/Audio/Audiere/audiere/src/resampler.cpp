@@ -30,6 +30,11 @@ namespace audiere {
 
   int
   Resampler::read(const int frame_count, void* buffer) {
+    // most sound effects already play at the device rate, unshifted
+    if (m_native_sample_rate == m_rate && m_shift == 1) {
+      return readUnity(frame_count, (s16*)buffer);
+    }
+
     s16* out = (s16*)buffer;
     int left = frame_count;
     sample_t tmp_l[BUFFER_SIZE];
@@ -77,6 +82,50 @@ namespace audiere {
     return frame_count;
   }
 
+  /**
+   * Copies the native buffers straight to the output, skipping the
+   * interpolator.  The resamplers are left as if just reset at the current
+   * position, so a later pitch shift picks up where this left off.
+   */
+  int
+  Resampler::readUnity(const int frame_count, s16* out) {
+    // a primed resampler runs two samples behind its read position
+    long pos = m_resampler_l.pos;
+    if (m_resampler_l.overshot >= 0) {
+      pos = std::max(0L, pos - 2);
+    }
+
+    int left = frame_count;
+    while (left > 0) {
+      if (pos >= m_buffer_length) {
+        fillBuffers();
+        pos = 0;
+        if (m_buffer_length == 0) {
+          break;
+        }
+      }
+
+      const int transfer = std::min(left, int(m_buffer_length - pos));
+      const sample_t* in_l = m_native_buffer_l + pos;
+      const sample_t* in_r =
+        (m_native_channel_count == 2 ? m_native_buffer_r : m_native_buffer_l) + pos;
+      for (int i = 0; i < transfer; ++i) {
+        out[0] = s16(in_l[i]);
+        out[1] = s16(in_r[i]);
+        out += 2;
+      }
+
+      pos  += transfer;
+      left -= transfer;
+    }
+
+    dumb_reset_resampler(&m_resampler_l, m_native_buffer_l, pos, 0,
+                         m_buffer_length);
+    dumb_reset_resampler(&m_resampler_r, m_native_buffer_r, pos, 0,
+                         m_buffer_length);
+    return frame_count - left;
+  }
+
   void
   Resampler::reset() {
     m_source->reset();
@@ -41,6 +41,7 @@ namespace audiere {
     float getPitchShift();
 
   private:
+    int readUnity(int frame_count, s16* out);
     void fillBuffers();
     void resetState();
 
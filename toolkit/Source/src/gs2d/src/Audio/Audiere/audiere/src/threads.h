@@ -21,6 +21,11 @@ namespace audiere {
   // waiting
   void AI_Sleep(unsigned milliseconds);
 
+  // atomics (full memory barrier semantics)
+  int  AI_AtomicCompareExchange(volatile int* dest, int exchange, int comparand);
+  int  AI_AtomicLoad(volatile int* src);
+  void AI_AtomicStore(volatile int* dest, int value);
+
 
   class Mutex {
   public:
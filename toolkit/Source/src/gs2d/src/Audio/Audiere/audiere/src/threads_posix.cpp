@@ -86,6 +86,24 @@ namespace audiere {
   }
 
 
+  int AI_AtomicCompareExchange(volatile int* dest, int exchange, int comparand) {
+    return __sync_val_compare_and_swap(dest, comparand, exchange);
+  }
+
+  int AI_AtomicLoad(volatile int* src) {
+    __sync_synchronize();
+    const int value = *src;
+    __sync_synchronize();
+    return value;
+  }
+
+  void AI_AtomicStore(volatile int* dest, int value) {
+    __sync_synchronize();
+    *dest = value;
+    __sync_synchronize();
+  }
+
+
   struct Mutex::Impl {
     pthread_mutex_t mutex;
   };
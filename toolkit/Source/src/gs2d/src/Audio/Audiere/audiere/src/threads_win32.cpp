@@ -84,6 +84,19 @@ namespace audiere {
   }
 
 
+  int AI_AtomicCompareExchange(volatile int* dest, int exchange, int comparand) {
+    return InterlockedCompareExchange((volatile LONG*)dest, exchange, comparand);
+  }
+
+  int AI_AtomicLoad(volatile int* src) {
+    return InterlockedCompareExchange((volatile LONG*)src, 0, 0);
+  }
+
+  void AI_AtomicStore(volatile int* dest, int value) {
+    InterlockedExchange((volatile LONG*)dest, value);
+  }
+
+
   struct Mutex::Impl {
     CRITICAL_SECTION cs;
   };
@@ -27,19 +27,38 @@
 
 #include "CDAudioContext.h"
 
+#include <vector>
+
 namespace gs2d {
 
 class CDAudioSample : public AudioSample
 {
+	// an OpenAL source and the buffer it was playing when the voice started, since
+	// CocosDenshion hands the same sources over to other effects once they are free
+	struct Voice
+	{
+		unsigned int source;
+		int buffer;
+		float volume;
+	};
+
 	CDAudioContext* m_audio;
 
 	str_type::string m_fileName;
 	static str_type::string m_currentStreamableTrack;
 	float m_volume, m_speed, m_pan;
 	bool m_loop;
+	unsigned int m_maxVoices;
 	Audio::SAMPLE_TYPE m_type;
 	static Platform::FileLogger m_logger;
 
+	// kept in the order they were started
+	std::vector<Voice> m_voices;
+
+	void ReleaseFinishedVoices();
+	std::size_t FindVoiceToSteal() const;
+	void StopVoice(const std::size_t index);
+
 public:
 	CDAudioSample();
 	~CDAudioSample();
@@ -77,6 +96,11 @@ public:
 
 	bool SetPan(const float pan);
 	float GetPan() const;
+
+	bool PlayVoice(const float volume, const float pan, const float speed);
+	void SetMaxVoices(const unsigned int maxVoices);
+	unsigned int GetMaxVoices() const;
+	unsigned int GetNumActiveVoices();
 };
 
 } // namespace gs2d
@@ -51,7 +51,8 @@ CDAudioSample::CDAudioSample() :
 	m_volume(1.0f),
 	m_speed(1.0f),
 	m_loop(false),
-	m_pan(0.0f)
+	m_pan(0.0f),
+	m_maxVoices(DEFAULT_MAX_VOICES)
 {
 }
 
@@ -222,4 +223,86 @@ float CDAudioSample::GetPan() const
 	return m_pan;
 }
 
+void CDAudioSample::ReleaseFinishedVoices()
+{
+	for (std::size_t t = 0; t < m_voices.size();)
+	{
+		ALint state, buffer;
+		alGetSourcei(m_voices[t].source, AL_SOURCE_STATE, &state);
+		alGetSourcei(m_voices[t].source, AL_BUFFER, &buffer);
+		if (state != AL_PLAYING || buffer != m_voices[t].buffer)
+			m_voices.erase(m_voices.begin() + t);
+		else
+			++t;
+	}
+}
+
+std::size_t CDAudioSample::FindVoiceToSteal() const
+{
+	// the quietest voice goes first, the oldest one among equally loud voices
+	std::size_t victim = 0;
+	for (std::size_t t = 1; t < m_voices.size(); t++)
+	{
+		if (m_voices[t].volume < m_voices[victim].volume)
+			victim = t;
+	}
+	return victim;
+}
+
+void CDAudioSample::StopVoice(const std::size_t index)
+{
+	[[SimpleAudioEngine sharedEngine] stopEffect:m_voices[index].source];
+	m_voices.erase(m_voices.begin() + index);
+}
+
+bool CDAudioSample::PlayVoice(const float volume, const float pan, const float speed)
+{
+	if (CDAudioContext::IsStreamable(m_type))
+	{
+		return Play();
+	}
+
+	if (m_maxVoices == 0)
+		return false;
+
+	ReleaseFinishedVoices();
+	if (m_voices.size() >= m_maxVoices)
+		StopVoice(FindVoiceToSteal());
+
+	// SimpleAudioEngine plays every effect on its own OpenAL source
+	NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+	NSString* fileName = [NSString stringWithUTF8String:m_fileName.c_str()];
+	const ALuint source = [[SimpleAudioEngine sharedEngine] playEffect:fileName pitch:speed pan:pan gain:volume];
+	[pool release];
+
+	if (source == CD_MUTE || source == CD_NO_SOURCE)
+		return false;
+
+	Voice voice;
+	voice.source = source;
+	alGetSourcei(source, AL_BUFFER, &voice.buffer);
+	voice.volume = volume;
+	m_voices.push_back(voice);
+	return true;
+}
+
+void CDAudioSample::SetMaxVoices(const unsigned int maxVoices)
+{
+	m_maxVoices = maxVoices;
+	ReleaseFinishedVoices();
+	while (m_voices.size() > m_maxVoices)
+		StopVoice(FindVoiceToSteal());
+}
+
+unsigned int CDAudioSample::GetMaxVoices() const
+{
+	return m_maxVoices;
+}
+
+unsigned int CDAudioSample::GetNumActiveVoices()
+{
+	ReleaseFinishedVoices();
+	return static_cast<unsigned int>(m_voices.size());
+}
+
 } // namespace gs2d
@@ -37,12 +37,16 @@ IrrKlangAudioSample::IrrKlangAudioSample() :
 	m_sound(0),
 	m_loop(false),
 	m_speed(1.0f),
-	m_pan(0.0f)
+	m_pan(0.0f),
+	m_maxVoices(DEFAULT_MAX_VOICES)
 {
 }
 
 IrrKlangAudioSample::~IrrKlangAudioSample()
 {
+	while (!m_voices.empty())
+		StopVoice(m_voices.size() - 1);
+
 	if (m_engine && m_source)
 		m_engine->removeSoundSource(m_source);
 
@@ -204,4 +208,84 @@ float IrrKlangAudioSample::GetPan() const
 	return m_sound->getPan();
 }
 
+void IrrKlangAudioSample::ReleaseFinishedVoices()
+{
+	for (std::size_t t = 0; t < m_voices.size();)
+	{
+		if (m_voices[t].sound->isFinished())
+		{
+			m_voices[t].sound->drop();
+			m_voices.erase(m_voices.begin() + t);
+		}
+		else
+		{
+			++t;
+		}
+	}
+}
+
+std::size_t IrrKlangAudioSample::FindVoiceToSteal() const
+{
+	// the quietest voice goes first, the oldest one among equally loud voices
+	std::size_t victim = 0;
+	for (std::size_t t = 1; t < m_voices.size(); t++)
+	{
+		if (m_voices[t].volume < m_voices[victim].volume)
+			victim = t;
+	}
+	return victim;
+}
+
+void IrrKlangAudioSample::StopVoice(const std::size_t index)
+{
+	m_voices[index].sound->stop();
+	m_voices[index].sound->drop();
+	m_voices.erase(m_voices.begin() + index);
+}
+
+bool IrrKlangAudioSample::PlayVoice(const float volume, const float pan, const float speed)
+{
+	if (m_maxVoices == 0)
+		return false;
+
+	ReleaseFinishedVoices();
+	if (m_voices.size() >= m_maxVoices)
+		StopVoice(FindVoiceToSteal());
+
+	// irrKlang mixes every play2D call as a separate sound, the returned handle is kept to track it
+	irrklang::ISound* sound = m_engine->play2D(m_source, false, true, true);
+	if (!sound)
+		return false;
+
+	sound->setVolume(volume);
+	sound->setPan(pan);
+	sound->setPlaybackSpeed(math::Max(0.5f,(math::Min(2.0f, speed))));
+	sound->setIsPaused(false);
+
+	Voice voice;
+	voice.sound = sound;
+	voice.volume = volume;
+	m_voices.push_back(voice);
+	return true;
+}
+
+void IrrKlangAudioSample::SetMaxVoices(const unsigned int maxVoices)
+{
+	m_maxVoices = maxVoices;
+	ReleaseFinishedVoices();
+	while (m_voices.size() > m_maxVoices)
+		StopVoice(FindVoiceToSteal());
+}
+
+unsigned int IrrKlangAudioSample::GetMaxVoices() const
+{
+	return m_maxVoices;
+}
+
+unsigned int IrrKlangAudioSample::GetNumActiveVoices()
+{
+	ReleaseFinishedVoices();
+	return static_cast<unsigned int>(m_voices.size());
+}
+
 } // namespace gs2d
@@ -27,10 +27,18 @@
 
 #include <irrKlang.h>
 
+#include <vector>
+
 namespace gs2d {
 
 class IrrKlangAudioSample : public AudioSample
 {
+	struct Voice
+	{
+		irrklang::ISound* sound;
+		float volume;
+	};
+
 	irrklang::ISoundEngine* m_engine;
 	irrklang::ISoundSource* m_source;
 	irrklang::ISound* m_sound;
@@ -40,6 +48,14 @@ class IrrKlangAudioSample : public AudioSample
 
 	bool m_loop;
 	float m_speed, m_pan;
+	unsigned int m_maxVoices;
+
+	// kept in the order they were started
+	std::vector<Voice> m_voices;
+
+	void ReleaseFinishedVoices();
+	std::size_t FindVoiceToSteal() const;
+	void StopVoice(const std::size_t index);
 
 public:
 	IrrKlangAudioSample();
@@ -78,6 +94,11 @@ public:
 
 	bool SetPan(const float pan);
 	float GetPan() const;
+
+	bool PlayVoice(const float volume, const float pan, const float speed);
+	void SetMaxVoices(const unsigned int maxVoices);
+	unsigned int GetMaxVoices() const;
+	unsigned int GetNumActiveVoices();
 };
 
 typedef boost::shared_ptr<IrrKlangAudioSample> IrrKlangAudioSamplePtr;
@@ -250,6 +250,12 @@ Entity* File::GetEntity(const str_type::string &key)
 	}
 }
 
+const Entity* File::GetEntity(const str_type::string &key) const
+{
+	std::map<str_type::string, Entity>::const_iterator iter = m_entities.find(key);
+	return (iter != m_entities.end()) ? &(iter->second) : 0;
+}
+
 void File::AddEntity(const str_type::string &key, const Entity &entity)
 {
 	assert(IsValid(key) == RV_VALID);
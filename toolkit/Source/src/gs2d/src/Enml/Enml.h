@@ -130,6 +130,9 @@ public:
 	/// Returns a copy of the requested entity.
 	Entity* GetEntity(const str_type::string &key);
 
+	/// Returns the requested entity or 0 if there is no entity with that name.
+	const Entity* GetEntity(const str_type::string &key) const;
+
 	/// Adds an Entity object to the file. Overwrites existing entities.
 	void AddEntity(const str_type::string &key, const Entity &entity);
 
@@ -18,4 +18,59 @@
 	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
 	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
 	OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
---------------------------------------------------------------------------------------*/
\ No newline at end of file
+--------------------------------------------------------------------------------------*/
+#include "GameMath.h"
+
+namespace gs2d {
+namespace math {
+
+void RotateAndScale(
+	const Vector2* in,
+	Vector2* out,
+	const std::size_t count,
+	const float radianAngle,
+	const Vector2& scale,
+	const Vector2& translate)
+{
+	const float c = cosf(radianAngle);
+	const float s = sinf(radianAngle);
+
+	std::size_t t = 0;
+#if defined(__ARM_NEON__)
+	const float scaleValues[4]     = { scale.x, scale.y, scale.x, scale.y };
+	const float sinValues[4]       = {-s, s,-s, s };
+	const float translateValues[4] = { translate.x, translate.y, translate.x, translate.y };
+	const float32x4_t vScale     = vld1q_f32(scaleValues);
+	const float32x4_t vCos       = vdupq_n_f32(c);
+	const float32x4_t vSin       = vld1q_f32(sinValues);
+	const float32x4_t vTranslate = vld1q_f32(translateValues);
+	for (; t + 2 <= count; t += 2)
+	{
+		const float32x4_t v = vmulq_f32(vld1q_f32(&in[t].x), vScale);
+		const float32x4_t r = vaddq_f32(vmulq_f32(v, vCos), vmulq_f32(vrev64q_f32(v), vSin));
+		vst1q_f32(&out[t].x, vaddq_f32(r, vTranslate));
+	}
+#elif defined(GS2D_MATH_SSE)
+	const __m128 vScale     = _mm_setr_ps(scale.x, scale.y, scale.x, scale.y);
+	const __m128 vCos       = _mm_set1_ps(c);
+	const __m128 vSin       = _mm_setr_ps(-s, s,-s, s);
+	const __m128 vTranslate = _mm_setr_ps(translate.x, translate.y, translate.x, translate.y);
+	for (; t + 2 <= count; t += 2)
+	{
+		const __m128 v = _mm_mul_ps(_mm_loadu_ps(&in[t].x), vScale);
+		const __m128 swapped = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+		const __m128 r = _mm_add_ps(_mm_mul_ps(v, vCos), _mm_mul_ps(swapped, vSin));
+		_mm_storeu_ps(&out[t].x, _mm_add_ps(r, vTranslate));
+	}
+#endif
+	for (; t < count; t++)
+	{
+		const float x = in[t].x * scale.x;
+		const float y = in[t].y * scale.y;
+		out[t].x = ((x * c) + (y * -s)) + translate.x;
+		out[t].y = ((y * c) + (x * s)) + translate.y;
+	}
+}
+
+} // namespace math
+} // namespace gs2d
@@ -27,9 +27,13 @@
 
 #if defined(__ARM_NEON__)
 #include <arm_neon.h>
+#elif defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define GS2D_MATH_SSE
+#include <xmmintrin.h>
 #endif
 
 #include <math.h>
+#include <cstddef>
 
 namespace gs2d {
 namespace math {
@@ -840,6 +844,34 @@ inline Matrix4x4 RotateZ(const float theta)
 inline Matrix4x4 Multiply(const Matrix4x4& m1, const Matrix4x4& m2)
 {
 	Matrix4x4 r;
+#if defined(__ARM_NEON__)
+	const float32x4_t row0 = vld1q_f32(m2.m[0]);
+	const float32x4_t row1 = vld1q_f32(m2.m[1]);
+	const float32x4_t row2 = vld1q_f32(m2.m[2]);
+	const float32x4_t row3 = vld1q_f32(m2.m[3]);
+	for (int i = 0; i < 4; i++)
+	{
+		// multiply and add separately (no vmla) so results match the scalar path
+		float32x4_t v = vmulq_n_f32(row0, m1.m[i][0]);
+		v = vaddq_f32(v, vmulq_n_f32(row1, m1.m[i][1]));
+		v = vaddq_f32(v, vmulq_n_f32(row2, m1.m[i][2]));
+		v = vaddq_f32(v, vmulq_n_f32(row3, m1.m[i][3]));
+		vst1q_f32(r.m[i], v);
+	}
+#elif defined(GS2D_MATH_SSE)
+	const __m128 row0 = _mm_loadu_ps(m2.m[0]);
+	const __m128 row1 = _mm_loadu_ps(m2.m[1]);
+	const __m128 row2 = _mm_loadu_ps(m2.m[2]);
+	const __m128 row3 = _mm_loadu_ps(m2.m[3]);
+	for (int i = 0; i < 4; i++)
+	{
+		__m128 v = _mm_mul_ps(_mm_set1_ps(m1.m[i][0]), row0);
+		v = _mm_add_ps(v, _mm_mul_ps(_mm_set1_ps(m1.m[i][1]), row1));
+		v = _mm_add_ps(v, _mm_mul_ps(_mm_set1_ps(m1.m[i][2]), row2));
+		v = _mm_add_ps(v, _mm_mul_ps(_mm_set1_ps(m1.m[i][3]), row3));
+		_mm_storeu_ps(r.m[i], v);
+	}
+#else
 	for (int i = 0; i < 4; i++)
 	{
 		for (int j = 0; j < 4; j++)
@@ -851,6 +883,7 @@ inline Matrix4x4 Multiply(const Matrix4x4& m1, const Matrix4x4& m2)
 			}
 		}
 	}
+#endif
 	return r;
 }
 
@@ -904,6 +937,21 @@ inline Vector2 Multiply(const Vector2 &v2, const Matrix4x4 &mat)
 		v2.y * mat.mat.a22);
 }
 
+/**
+ * \brief Scales, rotates and translates 'count' positions at once
+ *
+ * Each output is (p.x * c - p.y * s, p.x * s + p.y * c) + translate, where p is
+ * the input position multiplied by 'scale', c = cos(radianAngle) and s = sin(radianAngle).
+ * 'in' and 'out' may point to the same array.
+ */
+void RotateAndScale(
+	const Vector2* in,
+	Vector2* out,
+	const std::size_t count,
+	const float radianAngle,
+	const Vector2& scale,
+	const Vector2& translate);
+
 inline void Orthogonal(Matrix4x4 &out, const float w, const float h, const float zn, const float zf)
 {
 	out.Identity();
@@ -27,16 +27,14 @@ namespace math {
 
 OrientedBoundingBox::OrientedBoundingBox(const Vector2& center, const Vector2& size, const float angle)
 {
-	Vector2 x( cosf(angle), sinf(angle));
-	Vector2 y(-sinf(angle), cosf(angle));
-
-	x *= size.x / 2;
-	y *= size.y / 2;
-
-	corner[0] = center - x - y;
-	corner[1] = center + x - y;
-	corner[2] = center + x + y;
-	corner[3] = center - x + y;
+	static const Vector2 unitCorners[4] =
+	{
+		Vector2(-1.0f,-1.0f),
+		Vector2( 1.0f,-1.0f),
+		Vector2( 1.0f, 1.0f),
+		Vector2(-1.0f, 1.0f)
+	};
+	RotateAndScale(unitCorners, corner, 4, angle, size * 0.5f, center);
 
 	ComputeAxes();
 }
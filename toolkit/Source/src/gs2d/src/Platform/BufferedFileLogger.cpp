@@ -0,0 +1,471 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#include "BufferedFileLogger.h"
+#include "MonotonicClock.h"
+
+#include <fstream>
+#include <exception>
+#include <algorithm>
+
+#include <signal.h>
+
+#ifdef WIN32
+ #define WIN32_LEAN_AND_MEAN
+ #define NOGDI
+ #include <windows.h>
+#endif
+
+namespace Platform {
+
+const std::size_t BufferedFileLogger::DEFAULT_CAPACITY = 1024;
+const unsigned int BufferedFileLogger::FLUSH_INTERVAL_MS = 100;
+const unsigned int BufferedFileLogger::DEFAULT_RATE_LIMIT = 10;
+const unsigned int BufferedFileLogger::DEFAULT_RATE_WINDOW_MS = 1000;
+
+namespace {
+
+// Live loggers, for the crash handlers. Never destroyed, since a crash may come in while
+// static objects are going away
+struct LOGGER_REGISTRY
+{
+	LOGGER_REGISTRY() : handlersInstalled(false) { }
+	Lock lock;
+	std::vector<const BufferedFileLogger*> loggers;
+	bool handlersInstalled;
+};
+
+LOGGER_REGISTRY* g_registry = new LOGGER_REGISTRY;
+
+// The handlers below write the files with the regular, not async-signal-safe, code: the
+// process is going down anyway, and getting the last messages out is worth the risk
+
+const int CRASH_SIGNALS[] = { SIGSEGV, SIGABRT, SIGFPE, SIGILL,
+#ifndef WIN32
+	SIGBUS
+#endif
+};
+const std::size_t NUM_CRASH_SIGNALS = sizeof(CRASH_SIGNALS) / sizeof(CRASH_SIGNALS[0]);
+
+#ifdef WIN32
+typedef void (*SIGNAL_HANDLER)(int);
+SIGNAL_HANDLER g_previousSignalHandlers[NUM_CRASH_SIGNALS];
+LPTOP_LEVEL_EXCEPTION_FILTER g_previousExceptionFilter = 0;
+#else
+struct sigaction g_previousSignalActions[NUM_CRASH_SIGNALS];
+#endif
+std::terminate_handler g_previousTerminateHandler = 0;
+
+void HandleCrashSignal(int signalNumber)
+{
+	BufferedFileLogger::FlushAll();
+
+	// hand the signal over to whoever was handling it before, or to the default action,
+	// which runs as soon as this handler returns
+	for (std::size_t t = 0; t < NUM_CRASH_SIGNALS; t++)
+	{
+		if (CRASH_SIGNALS[t] != signalNumber)
+			continue;
+	#ifdef WIN32
+		signal(signalNumber, g_previousSignalHandlers[t]);
+	#else
+		sigaction(signalNumber, &g_previousSignalActions[t], 0);
+	#endif
+	}
+	raise(signalNumber);
+}
+
+#ifdef WIN32
+LONG WINAPI HandleUnhandledException(EXCEPTION_POINTERS* exception)
+{
+	BufferedFileLogger::FlushAll();
+	return (g_previousExceptionFilter) ? g_previousExceptionFilter(exception) : EXCEPTION_CONTINUE_SEARCH;
+}
+#endif
+
+void HandleTerminate()
+{
+	BufferedFileLogger::FlushAll();
+	if (g_previousTerminateHandler)
+		g_previousTerminateHandler();
+	abort();
+}
+
+void InstallCrashHandlers()
+{
+	for (std::size_t t = 0; t < NUM_CRASH_SIGNALS; t++)
+	{
+	#ifdef WIN32
+		g_previousSignalHandlers[t] = signal(CRASH_SIGNALS[t], HandleCrashSignal);
+	#else
+		struct sigaction action;
+		action.sa_handler = HandleCrashSignal;
+		sigemptyset(&action.sa_mask);
+		action.sa_flags = 0;
+		sigaction(CRASH_SIGNALS[t], &action, &g_previousSignalActions[t]);
+	#endif
+	}
+#ifdef WIN32
+	g_previousExceptionFilter = SetUnhandledExceptionFilter(HandleUnhandledException);
+#endif
+	g_previousTerminateHandler = std::set_terminate(HandleTerminate);
+}
+
+} // namespace
+
+// Thread entry point, allowed to reach into the logger's privates
+struct BufferedFileLoggerThread
+{
+	static void Run(void* arg)
+	{
+		const BufferedFileLogger* logger = static_cast<const BufferedFileLogger*>(arg);
+		logger->m_wakeLock.Acquire();
+		while (!AtomicLoad(const_cast<volatile long*>(&logger->m_stopping)))
+		{
+			logger->m_wakeLock.WaitForSignal(BufferedFileLogger::FLUSH_INTERVAL_MS);
+			logger->m_wakeLock.Release();
+			logger->Flush();
+			logger->m_wakeLock.Acquire();
+		}
+		logger->m_wakeLock.Release();
+	}
+};
+
+BufferedFileLogger::MESSAGE::MESSAGE() :
+	sequence(0),
+	type(INFO),
+	timeUS(0)
+{
+}
+
+BufferedFileLogger::RATE_WINDOW::RATE_WINDOW() :
+	startUS(0),
+	count(0),
+	suppressed(0)
+{
+}
+
+BufferedFileLogger::BufferedFileLogger(const gs2d::str_type::string& fileName, const std::size_t capacity) :
+	FileLogger(fileName),
+	m_enqueuePosition(0),
+	m_dequeuePosition(0),
+	m_numDiscarded(0),
+	m_level(INFO),
+	m_stopping(0),
+	m_rateLimit(DEFAULT_RATE_LIMIT),
+	m_rateWindowMS(DEFAULT_RATE_WINDOW_MS)
+{
+	std::size_t size = 2;
+	while (size < capacity)
+		size *= 2;
+
+	// each slot's sequence tells whose turn it is: it equals the position a producer may
+	// claim while the slot is free, and that position plus one once the message is ready
+	m_ring.resize(size);
+	for (std::size_t t = 0; t < size; t++)
+		m_ring[t].sequence = static_cast<long>(t);
+	m_mask = static_cast<long>(size - 1);
+
+	{
+		ScopedLock lock(g_registry->lock);
+		g_registry->loggers.push_back(this);
+		if (!g_registry->handlersInstalled)
+		{
+			InstallCrashHandlers();
+			g_registry->handlersInstalled = true;
+		}
+	}
+
+	m_flushThread.Start(BufferedFileLoggerThread::Run, this);
+}
+
+BufferedFileLogger::~BufferedFileLogger()
+{
+	{
+		ScopedLock lock(g_registry->lock);
+		std::vector<const BufferedFileLogger*>& loggers = g_registry->loggers;
+		loggers.erase(std::remove(loggers.begin(), loggers.end(), this), loggers.end());
+	}
+
+	{
+		ScopedLock lock(m_wakeLock);
+		AtomicStore(&m_stopping, 1);
+		m_wakeLock.Signal();
+	}
+	m_flushThread.Join();
+
+	ScopedLock lock(m_drainLock);
+	FlushLocked(true);
+}
+
+bool BufferedFileLogger::Log(const gs2d::str_type::string& str, const TYPE& type) const
+{
+	return Log(str, type, gs2d::str_type::string());
+}
+
+bool BufferedFileLogger::Log(const gs2d::str_type::string& str, const TYPE& type, const gs2d::str_type::string& key) const
+{
+	if (type > AtomicLoad(const_cast<volatile long*>(&m_level)))
+	{
+		AtomicIncrement(&m_numDiscarded);
+		return true;
+	}
+
+	while (!Push(str, type, key))
+	{
+		// the ring is full: drain it from this thread rather than lose the message. The drain
+		// stops at a slot another producer has claimed but not written yet, so wait for it
+		Flush();
+		if (Push(str, type, key))
+			break;
+		SleepMicroseconds(100);
+	}
+
+	// errors may precede a crash, so they must reach the disk right away
+	if (type == ERROR || !m_flushThread.IsRunning())
+		return Flush();
+
+	if (type == WARNING)
+		m_wakeLock.Signal();
+	return true;
+}
+
+bool BufferedFileLogger::Push(const gs2d::str_type::string& str, const TYPE& type, const gs2d::str_type::string& key) const
+{
+	long position = AtomicLoad(&m_enqueuePosition);
+	for (;;)
+	{
+		MESSAGE& slot = m_ring[position & m_mask];
+		const long difference = static_cast<long>(static_cast<unsigned long>(AtomicLoad(&slot.sequence)) - static_cast<unsigned long>(position));
+		if (difference == 0)
+		{
+			// the slot is free for this position: try to claim it
+			const long previous = AtomicCompareAndSwap(&m_enqueuePosition, position, position + 1);
+			if (previous == position)
+				break;
+			position = previous;
+		}
+		else if (difference < 0)
+		{
+			// the consumer hasn't freed the slot since the last lap: the ring is full
+			return false;
+		}
+		else
+		{
+			// another producer claimed this position first
+			position = AtomicLoad(&m_enqueuePosition);
+		}
+	}
+
+	MESSAGE& slot = m_ring[position & m_mask];
+	slot.text = str;
+	slot.key = key;
+	slot.type = type;
+	slot.timeUS = MonotonicClock::GetCurrentTimeUS();
+	AtomicStore(&slot.sequence, position + 1);
+	return true;
+}
+
+bool BufferedFileLogger::Pop(MESSAGE& message) const
+{
+	MESSAGE& slot = m_ring[m_dequeuePosition & m_mask];
+	if (AtomicLoad(&slot.sequence) != m_dequeuePosition + 1)
+		return false;
+
+	message.text.swap(slot.text);
+	message.key.swap(slot.key);
+	message.type = slot.type;
+	message.timeUS = slot.timeUS;
+
+	// free the slot for the producer that comes around on the next lap
+	AtomicStore(&slot.sequence, m_dequeuePosition + static_cast<long>(m_ring.size()));
+	++m_dequeuePosition;
+	return true;
+}
+
+bool BufferedFileLogger::Flush() const
+{
+	ScopedLock lock(m_drainLock);
+	return FlushLocked(false);
+}
+
+bool BufferedFileLogger::FlushLocked(const bool closeAllWindows) const
+{
+	MESSAGE message;
+	while (Pop(message))
+	{
+		Accept(message);
+	}
+	CloseRateWindows(MonotonicClock::GetCurrentTimeUS(), closeAllWindows);
+	return WriteBuffer();
+}
+
+void BufferedFileLogger::Accept(const MESSAGE& message) const
+{
+	const gs2d::str_type::string key = message.key.empty() ? MakeKey(message.text) : message.key;
+	RATE_WINDOW& window = m_rateWindows[key];
+
+	const boost::uint64_t windowUS = static_cast<boost::uint64_t>(m_rateWindowMS) * 1000;
+	if (window.count == 0 || message.timeUS - window.startUS >= windowUS)
+	{
+		AppendSummary(key, window.suppressed);
+		window.startUS = message.timeUS;
+		window.count = 0;
+		window.suppressed = 0;
+	}
+
+	if (window.count >= m_rateLimit)
+	{
+		++window.suppressed;
+		AtomicIncrement(&m_numDiscarded);
+		return;
+	}
+
+	++window.count;
+	WriteToSecondaryOutputs(message.text, message.type);
+	Append(message.text);
+}
+
+void BufferedFileLogger::CloseRateWindows(const boost::uint64_t nowUS, const bool closeAll) const
+{
+	// summarize what each finished window cut, and forget it so the map stays small
+	const boost::uint64_t windowUS = static_cast<boost::uint64_t>(m_rateWindowMS) * 1000;
+	std::map<gs2d::str_type::string, RATE_WINDOW>::iterator iter = m_rateWindows.begin();
+	while (iter != m_rateWindows.end())
+	{
+		if (closeAll || nowUS - iter->second.startUS >= windowUS)
+		{
+			AppendSummary(iter->first, iter->second.suppressed);
+			m_rateWindows.erase(iter++);
+		}
+		else
+		{
+			++iter;
+		}
+	}
+}
+
+void BufferedFileLogger::AppendSummary(const gs2d::str_type::string& key, const unsigned int suppressed) const
+{
+	if (suppressed == 0)
+		return;
+
+	gs2d::str_type::stringstream ss;
+	ss << GS_L("(") << suppressed << GS_L(" more messages like \"") << key << GS_L("\" were suppressed)");
+	Append(ss.str());
+}
+
+void BufferedFileLogger::Append(const gs2d::str_type::string& str) const
+{
+	m_buffer.append(str);
+	m_buffer.append(GS_L("\n"));
+}
+
+bool BufferedFileLogger::WriteBuffer() const
+{
+	if (m_buffer.empty())
+		return true;
+
+	gs2d::str_type::ofstream ofs(GetFileName().c_str(), std::ios::out | std::ios::app);
+	const bool succeeded = ofs.is_open() && (ofs << m_buffer);
+
+	// drop the text even if the file can't be written, so the buffer doesn't grow forever
+	m_buffer.clear();
+	return succeeded;
+}
+
+gs2d::str_type::string BufferedFileLogger::MakeKey(const gs2d::str_type::string& str)
+{
+	gs2d::str_type::string key;
+	key.reserve(str.size());
+	for (std::size_t t = 0; t < str.size(); t++)
+	{
+		if (str[t] >= GS_L('0') && str[t] <= GS_L('9'))
+		{
+			if (key.empty() || key[key.size() - 1] != GS_L('#'))
+				key.push_back(GS_L('#'));
+		}
+		else
+		{
+			key.push_back(str[t]);
+		}
+	}
+	return key;
+}
+
+void BufferedFileLogger::FlushAll()
+{
+	// a crashing thread may hold any of these locks, so give up on a lock instead of waiting forever
+	LOGGER_REGISTRY& registry = *g_registry;
+	if (!registry.lock.TryAcquire())
+		return;
+
+	for (std::size_t t = 0; t < registry.loggers.size(); t++)
+	{
+		const BufferedFileLogger* logger = registry.loggers[t];
+		for (int attempt = 0; attempt < 50; attempt++)
+		{
+			if (logger->m_drainLock.TryAcquire())
+			{
+				logger->FlushLocked(true);
+				logger->m_drainLock.Release();
+				break;
+			}
+			SleepMicroseconds(1000);
+		}
+	}
+	registry.lock.Release();
+}
+
+void BufferedFileLogger::SetLevel(const TYPE& level)
+{
+	AtomicStore(&m_level, level);
+}
+
+Logger::TYPE BufferedFileLogger::GetLevel() const
+{
+	return static_cast<TYPE>(AtomicLoad(const_cast<volatile long*>(&m_level)));
+}
+
+void BufferedFileLogger::SetRateLimit(const unsigned int maxMessages, const unsigned int windowMS)
+{
+	ScopedLock lock(m_drainLock);
+	m_rateLimit = maxMessages;
+	m_rateWindowMS = windowMS;
+}
+
+unsigned int BufferedFileLogger::GetRateLimit() const
+{
+	return m_rateLimit;
+}
+
+unsigned int BufferedFileLogger::GetRateWindow() const
+{
+	return m_rateWindowMS;
+}
+
+unsigned int BufferedFileLogger::GetNumDiscardedMessages() const
+{
+	return static_cast<unsigned int>(AtomicLoad(&m_numDiscarded));
+}
+
+} // namespace Platform
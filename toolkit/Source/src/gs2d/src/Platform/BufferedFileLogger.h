@@ -0,0 +1,140 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#ifndef BUFFERED_FILE_LOGGER_H_
+#define BUFFERED_FILE_LOGGER_H_
+
+#include "FileLogger.h"
+#include "Thread.h"
+
+#include <boost/cstdint.hpp>
+
+#include <map>
+#include <vector>
+
+namespace Platform {
+
+/**
+ * \brief File logger that hands messages to a background thread through a lock-free ring buffer
+ *
+ * FileLogger opens and closes its file once per message, which dominates scene loading
+ * when INFO messages are enabled. Here Log() only copies the message into a slot of a
+ * fixed size ring that any number of threads may write to without locking. A flush
+ * thread drains the ring every few milliseconds, or as soon as a warning is logged, and
+ * appends everything to the file in a single write. Errors reach the file before Log()
+ * returns. If the ring is full, the logging thread drains it itself instead of dropping
+ * the message. When the process crashes, aborts or calls terminate, every live logger
+ * writes out what it holds before the process goes down.
+ *
+ * Messages less severe than the current level are discarded. Messages with the same key
+ * are written at most GetRateLimit() times per rate window, and the rest are counted and
+ * summarized once the window is over. The key is the message with its numbers masked,
+ * so "entity 12 not found" and "entity 40 not found" count together, unless the caller
+ * passes one.
+ */
+class BufferedFileLogger : public FileLogger
+{
+public:
+	static const std::size_t DEFAULT_CAPACITY;
+	static const unsigned int FLUSH_INTERVAL_MS;
+	static const unsigned int DEFAULT_RATE_LIMIT;
+	static const unsigned int DEFAULT_RATE_WINDOW_MS;
+
+	/// capacity is how many messages the ring holds, rounded up to a power of two
+	BufferedFileLogger(const gs2d::str_type::string& fileName, const std::size_t capacity = DEFAULT_CAPACITY);
+	~BufferedFileLogger();
+
+	bool Log(const gs2d::str_type::string& str, const TYPE& type) const;
+	bool Log(const gs2d::str_type::string& str, const TYPE& type, const gs2d::str_type::string& key) const;
+
+	/// Blocks until every message logged so far is in the file
+	bool Flush() const;
+
+	void SetLevel(const TYPE& level);
+	TYPE GetLevel() const;
+
+	/// Writes at most maxMessages messages with the same key every windowMS milliseconds
+	void SetRateLimit(const unsigned int maxMessages, const unsigned int windowMS);
+	unsigned int GetRateLimit() const;
+	unsigned int GetRateWindow() const;
+
+	/// Counts messages filtered by level or cut by the rate limit
+	unsigned int GetNumDiscardedMessages() const;
+
+	/// Writes out whatever every live logger holds. This is what runs when the process crashes
+	static void FlushAll();
+
+private:
+	struct MESSAGE
+	{
+		MESSAGE();
+		volatile long sequence;
+		gs2d::str_type::string text;
+		gs2d::str_type::string key;
+		TYPE type;
+		boost::uint64_t timeUS;
+	};
+
+	struct RATE_WINDOW
+	{
+		RATE_WINDOW();
+		boost::uint64_t startUS;
+		unsigned int count;
+		unsigned int suppressed;
+	};
+
+	friend struct BufferedFileLoggerThread;
+
+	bool Push(const gs2d::str_type::string& str, const TYPE& type, const gs2d::str_type::string& key) const;
+	bool Pop(MESSAGE& message) const;
+	bool FlushLocked(const bool closeAllWindows) const;
+	void Accept(const MESSAGE& message) const;
+	void CloseRateWindows(const boost::uint64_t nowUS, const bool closeAll) const;
+	void AppendSummary(const gs2d::str_type::string& key, const unsigned int suppressed) const;
+	void Append(const gs2d::str_type::string& str) const;
+	bool WriteBuffer() const;
+	static gs2d::str_type::string MakeKey(const gs2d::str_type::string& str);
+
+	mutable std::vector<MESSAGE> m_ring;
+	long m_mask;
+	mutable volatile long m_enqueuePosition;
+	mutable long m_dequeuePosition;
+	mutable volatile long m_numDiscarded;
+	volatile long m_level;
+	volatile long m_stopping;
+
+	// held by whoever drains the ring, so the rate windows and the text buffer need no other lock
+	mutable Lock m_drainLock;
+	mutable Lock m_wakeLock;
+	Thread m_flushThread;
+
+	mutable gs2d::str_type::string m_buffer;
+	mutable std::map<gs2d::str_type::string, RATE_WINDOW> m_rateWindows;
+	unsigned int m_rateLimit;
+	unsigned int m_rateWindowMS;
+};
+
+typedef boost::shared_ptr<BufferedFileLogger> BufferedFileLoggerPtr;
+
+} // namespace Platform
+
+#endif
@@ -90,6 +90,12 @@ void FileLogger::WriteToWarningLog(const gs2d::str_type::string& str)
 }
 
 bool FileLogger::Log(const gs2d::str_type::string& str, const TYPE& type) const
+{
+	WriteToSecondaryOutputs(str, type);
+	return AppendToFile(m_fileName, str);
+}
+
+void FileLogger::WriteToSecondaryOutputs(const gs2d::str_type::string& str, const TYPE& type) const
 {
 	#if defined(WIN32) || defined(APPLE_IOS) || defined(MACOSX)
 	GS2D_COUT << str << std::endl;
@@ -111,7 +117,11 @@ bool FileLogger::Log(const gs2d::str_type::string& str, const TYPE& type) const
 			LOGI(str.c_str());
 		}
 	#endif
-	return AppendToFile(m_fileName, str);
+}
+
+const gs2d::str_type::string& FileLogger::GetFileName() const
+{
+	return m_fileName;
 }
 
 gs2d::str_type::string FileLogger::GetErrorLogFileDirectory()
@@ -33,6 +33,11 @@ public:
 	FileLogger(const gs2d::str_type::string& fileName);
 	bool Log(const gs2d::str_type::string& str, const TYPE& type) const;
 	static gs2d::str_type::string GetLogDirectory();
+
+protected:
+	void WriteToSecondaryOutputs(const gs2d::str_type::string& str, const TYPE& type) const;
+	const gs2d::str_type::string& GetFileName() const;
+
 private:
 	static gs2d::str_type::string GetWarningLogFileDirectory();
 	static gs2d::str_type::string GetErrorLogFileDirectory();
@@ -23,6 +23,7 @@
 #include "FileManager.h"
 
 #include <fstream>
+#include <string.h>
 
 #include "../Unicode/utf8/utf8.h"
 
@@ -32,6 +33,69 @@ namespace Platform {
 
 const unsigned short FileManager::UTF16LE_BOM = 0xFEFF;
 
+class BufferFileStream : public FileStream
+{
+	FileBuffer m_buffer;
+	unsigned long m_position;
+
+public:
+	BufferFileStream(const FileBuffer& buffer) :
+		m_buffer(buffer),
+		m_position(0)
+	{
+	}
+
+	unsigned long Read(void* buffer, const unsigned long size)
+	{
+		const unsigned long available = m_buffer->GetBufferSize() - m_position;
+		const unsigned long count = (size < available) ? size : available;
+		memcpy(buffer, m_buffer->GetAddress() + m_position, count);
+		m_position += count;
+		return count;
+	}
+
+	bool Seek(const long offset, const SEEK_ORIGIN origin)
+	{
+		long base = 0;
+		switch (origin)
+		{
+		case FROM_CURRENT:
+			base = static_cast<long>(m_position);
+			break;
+		case FROM_END:
+			base = static_cast<long>(m_buffer->GetBufferSize());
+			break;
+		default:
+			break;
+		};
+
+		const long position = base + offset;
+		if (position < 0 || position > static_cast<long>(m_buffer->GetBufferSize()))
+			return false;
+
+		m_position = static_cast<unsigned long>(position);
+		return true;
+	}
+
+	unsigned long Tell() const
+	{
+		return m_position;
+	}
+
+	unsigned long GetSize() const
+	{
+		return m_buffer->GetBufferSize();
+	}
+};
+
+FileStreamPtr FileManager::OpenFileStream(const gs2d::str_type::string& fileName)
+{
+	FileBuffer buffer;
+	if (!GetFileBuffer(fileName, buffer) || !buffer)
+		return FileStreamPtr();
+	return FileStreamPtr(new BufferFileStream(buffer));
+}
+
 bool FileManager::GetUTF8FileString(const FileBuffer& buffer, gs2d::str_type::string &out)
 {
 	str_type::stringstream ss;
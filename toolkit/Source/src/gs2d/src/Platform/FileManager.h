@@ -71,6 +71,33 @@ T *_FileBuffer<T>::GetAddress()
 	return m_buffer;
 }
 
+/**
+ * \brief Reads a file a piece at a time instead of loading all of it in memory
+ *
+ * Each stream has its own file handle, so it may be read from a thread
+ * other than the one that opened it.
+ */
+class FileStream
+{
+public:
+	enum SEEK_ORIGIN
+	{
+		FROM_BEGIN = 0,
+		FROM_CURRENT = 1,
+		FROM_END = 2
+	};
+
+	virtual ~FileStream() {}
+
+	/// Returns the number of bytes actually read
+	virtual unsigned long Read(void* buffer, const unsigned long size) = 0;
+	virtual bool Seek(const long offset, const SEEK_ORIGIN origin) = 0;
+	virtual unsigned long Tell() const = 0;
+	virtual unsigned long GetSize() const = 0;
+};
+
+typedef boost::shared_ptr<FileStream> FileStreamPtr;
+
 class FileManager
 {
 	virtual bool GetUTF8FileString(const FileBuffer& buffer, gs2d::str_type::string &out);
@@ -81,6 +108,9 @@ public:
 	virtual bool IsLoaded() const = 0;
 	virtual bool GetFileBuffer(const gs2d::str_type::string& fileName, FileBuffer &out) = 0;
 
+	/// The default implementation loads the whole file with GetFileBuffer and streams from memory
+	virtual FileStreamPtr OpenFileStream(const gs2d::str_type::string& fileName);
+
 	virtual bool GetAnsiFileString(const gs2d::str_type::string& fileName, gs2d::str_type::string &out);
 	virtual bool GetUTF8FileString(const gs2d::str_type::string& fileName, gs2d::str_type::string &out);
 	virtual bool GetUTF16FileString(const gs2d::str_type::string& fileName, gs2d::str_type::string &out);
@@ -0,0 +1,456 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#include "FileWatcher.h"
+#include "Platform.h"
+#include "MonotonicClock.h"
+
+#include <algorithm>
+
+#if defined(WIN32)
+ #include <windows.h>
+#else
+ #include <sys/types.h>
+ #include <sys/stat.h>
+ #include <dirent.h>
+#endif
+
+#ifdef GS2D_USE_INOTIFY
+ #include <sys/inotify.h>
+ #include <unistd.h>
+ #include <fcntl.h>
+ #include <errno.h>
+#endif
+
+namespace Platform {
+
+const FileWatcher::WATCH_ID FileWatcher::INVALID_WATCH(0);
+const boost::uint64_t FileWatcher::DEFAULT_POLL_INTERVAL_US(1000000);
+
+#ifdef GS2D_USE_INOTIFY
+static const uint32_t NATIVE_EVENT_MASK =
+	IN_MODIFY | IN_ATTRIB | IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF;
+#endif
+
+#if defined(WIN32)
+static boost::int64_t MakeInt64(const DWORD high, const DWORD low)
+{
+	return static_cast<boost::int64_t>((static_cast<boost::uint64_t>(high) << 32) | static_cast<boost::uint64_t>(low));
+}
+#endif
+
+FileWatcher::FILE_STATE::FILE_STATE() :
+	exists(false),
+	modificationTime(0),
+	size(0)
+{
+}
+
+bool FileWatcher::FILE_STATE::operator==(const FILE_STATE& other) const
+{
+	return (exists == other.exists && modificationTime == other.modificationTime && size == other.size);
+}
+
+bool FileWatcher::FILE_STATE::operator!=(const FILE_STATE& other) const
+{
+	return !(*this == other);
+}
+
+FileWatcherPtr FileWatcher::GetSharedInstance()
+{
+	static FileWatcherPtr instance(new FileWatcher);
+	return instance;
+}
+
+bool FileWatcher::GetFileState(const gs2d::str_type::string& path, FILE_STATE& state)
+{
+	state = FILE_STATE();
+	#if defined(WIN32)
+		WIN32_FILE_ATTRIBUTE_DATA data;
+		if (!GetFileAttributesExA(path.c_str(), GetFileExInfoStandard, &data))
+			return false;
+		state.modificationTime = MakeInt64(data.ftLastWriteTime.dwHighDateTime, data.ftLastWriteTime.dwLowDateTime);
+		state.size = MakeInt64(data.nFileSizeHigh, data.nFileSizeLow);
+	#else
+		struct stat info;
+		if (stat(path.c_str(), &info) != 0)
+			return false;
+
+		// whole seconds aren't enough to tell apart two saves in a row
+		#if defined(__APPLE__)
+			state.modificationTime = static_cast<boost::int64_t>(info.st_mtimespec.tv_sec) * 1000000000 + info.st_mtimespec.tv_nsec;
+		#elif defined(__linux__)
+			state.modificationTime = static_cast<boost::int64_t>(info.st_mtim.tv_sec) * 1000000000 + info.st_mtim.tv_nsec;
+		#else
+			state.modificationTime = static_cast<boost::int64_t>(info.st_mtime) * 1000000000;
+		#endif
+		state.size = static_cast<boost::int64_t>(info.st_size);
+	#endif
+	state.exists = true;
+	return true;
+}
+
+void FileWatcher::ReadDirectoryState(const gs2d::str_type::string& directory, std::map<gs2d::str_type::string, FILE_STATE>& entries)
+{
+	entries.clear();
+	#if defined(WIN32)
+		WIN32_FIND_DATAA data;
+		const HANDLE handle = FindFirstFileA((directory + "*").c_str(), &data);
+		if (handle == INVALID_HANDLE_VALUE)
+			return;
+		do
+		{
+			const gs2d::str_type::string name(data.cFileName);
+			if (name == "." || name == "..")
+				continue;
+
+			FILE_STATE& state = entries[name];
+			state.exists = true;
+			state.modificationTime = MakeInt64(data.ftLastWriteTime.dwHighDateTime, data.ftLastWriteTime.dwLowDateTime);
+			state.size = MakeInt64(data.nFileSizeHigh, data.nFileSizeLow);
+		} while (FindNextFileA(handle, &data));
+		FindClose(handle);
+	#else
+		DIR* dir = opendir(directory.c_str());
+		if (!dir)
+			return;
+		while (const dirent* entry = readdir(dir))
+		{
+			const gs2d::str_type::string name(entry->d_name);
+			if (name == "." || name == "..")
+				continue;
+			GetFileState(directory + name, entries[name]);
+		}
+		closedir(dir);
+	#endif
+}
+
+FileWatcher::FileWatcher() :
+	m_nextId(INVALID_WATCH + 1),
+	m_notifyDescriptor(-1),
+	m_numPolledWatches(0),
+	m_pollIntervalUS(DEFAULT_POLL_INTERVAL_US),
+	m_lastPollTimeUS(0)
+{
+	#ifdef GS2D_USE_INOTIFY
+		// inotify_init1 would save the fcntl calls, but older Android versions don't have it
+		m_notifyDescriptor = inotify_init();
+		if (m_notifyDescriptor >= 0)
+			fcntl(m_notifyDescriptor, F_SETFL, fcntl(m_notifyDescriptor, F_GETFL) | O_NONBLOCK);
+	#endif
+}
+
+FileWatcher::~FileWatcher()
+{
+	#ifdef GS2D_USE_INOTIFY
+		if (m_notifyDescriptor >= 0)
+			close(m_notifyDescriptor);
+	#endif
+}
+
+FileWatcher::WATCH_ID FileWatcher::AddFile(const gs2d::str_type::string& path)
+{
+	return AddWatch(path, false);
+}
+
+FileWatcher::WATCH_ID FileWatcher::AddDirectory(const gs2d::str_type::string& path)
+{
+	return AddWatch(path, true);
+}
+
+FileWatcher::WATCH_ID FileWatcher::AddWatch(const gs2d::str_type::string& path, const bool isDirectory)
+{
+	if (path.empty())
+		return INVALID_WATCH;
+
+	// whatever the kernel has queued so far belongs to the watches that already exist
+	ReadNativeEvents();
+
+	WATCH watch;
+	watch.path = path;
+	FixSlashes(watch.path);
+	watch.isDirectory = isDirectory;
+	watch.polled = false;
+	watch.changed = false;
+	if (isDirectory)
+	{
+		watch.directory = AddLastSlash(watch.path);
+	}
+	else
+	{
+		watch.fileName = GetFileName(watch.path);
+		watch.directory = (watch.fileName == watch.path)
+			? (gs2d::str_type::string(".") + GetDirectorySlashA()) : GetFileDirectory(watch.path.c_str());
+	}
+
+	const WATCH_ID id = m_nextId++;
+	m_watches[id] = watch;
+	WATCH& stored = m_watches[id];
+
+	if (!AttachToDirectory(id, stored.directory))
+	{
+		if (m_numPolledWatches++ == 0)
+			m_lastPollTimeUS = MonotonicClock::GetCurrentTimeUS();
+		stored.polled = true;
+		GetFileState(stored.path, stored.state);
+		if (isDirectory)
+			ReadDirectoryState(stored.directory, stored.entries);
+	}
+	return id;
+}
+
+void FileWatcher::RemoveWatch(const WATCH_ID id)
+{
+	std::map<WATCH_ID, WATCH>::iterator iter = m_watches.find(id);
+	if (iter == m_watches.end())
+		return;
+
+	if (iter->second.polled)
+		--m_numPolledWatches;
+	else
+		DetachFromDirectory(id, iter->second.directory);
+	m_watches.erase(iter);
+}
+
+bool FileWatcher::AttachToDirectory(const WATCH_ID id, gs2d::str_type::string& directory)
+{
+	#ifdef GS2D_USE_INOTIFY
+		if (m_notifyDescriptor < 0)
+			return false;
+
+		std::map<gs2d::str_type::string, DIRECTORY>::iterator iter = m_directories.find(directory);
+		if (iter == m_directories.end())
+		{
+			const int descriptor = inotify_add_watch(m_notifyDescriptor, directory.c_str(), NATIVE_EVENT_MASK);
+			if (descriptor < 0)
+				return false;
+
+			// two different spellings of the same directory share the kernel watch
+			std::map<int, gs2d::str_type::string>::iterator known = m_descriptorDirectories.find(descriptor);
+			if (known != m_descriptorDirectories.end())
+			{
+				directory = known->second;
+				iter = m_directories.find(directory);
+			}
+			else
+			{
+				DIRECTORY newDirectory;
+				newDirectory.descriptor = descriptor;
+				iter = m_directories.insert(std::make_pair(directory, newDirectory)).first;
+				m_descriptorDirectories[descriptor] = directory;
+			}
+		}
+		iter->second.watches.push_back(id);
+		return true;
+	#else
+		(void)id;
+		(void)directory;
+		return false;
+	#endif
+}
+
+void FileWatcher::DetachFromDirectory(const WATCH_ID id, const gs2d::str_type::string& directory)
+{
+	std::map<gs2d::str_type::string, DIRECTORY>::iterator iter = m_directories.find(directory);
+	if (iter == m_directories.end())
+		return;
+
+	std::vector<WATCH_ID>& watches = iter->second.watches;
+	watches.erase(std::remove(watches.begin(), watches.end(), id), watches.end());
+	if (watches.empty())
+	{
+		#ifdef GS2D_USE_INOTIFY
+			inotify_rm_watch(m_notifyDescriptor, iter->second.descriptor);
+		#endif
+		m_descriptorDirectories.erase(iter->second.descriptor);
+		m_directories.erase(iter);
+	}
+}
+
+void FileWatcher::Update()
+{
+	ReadNativeEvents();
+
+	if (m_numPolledWatches > 0)
+	{
+		const boost::uint64_t now = MonotonicClock::GetCurrentTimeUS();
+		if (now - m_lastPollTimeUS >= m_pollIntervalUS)
+		{
+			PollWatches();
+			m_lastPollTimeUS = now;
+		}
+	}
+}
+
+void FileWatcher::ReadNativeEvents()
+{
+	#ifdef GS2D_USE_INOTIFY
+		if (m_notifyDescriptor < 0)
+			return;
+
+		char buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+		for (;;)
+		{
+			const ssize_t length = read(m_notifyDescriptor, buffer, sizeof(buffer));
+			if (length < 0 && errno == EINTR)
+				continue;
+
+			// EAGAIN: the queue is empty
+			if (length <= 0)
+				break;
+
+			for (const char* ptr = buffer; ptr < buffer + length;)
+			{
+				const inotify_event* event = reinterpret_cast<const inotify_event*>(ptr);
+				ptr += sizeof(inotify_event) + event->len;
+
+				if (event->mask & IN_Q_OVERFLOW)
+				{
+					// events were dropped, so anything might have changed
+					for (std::map<WATCH_ID, WATCH>::iterator iter = m_watches.begin(); iter != m_watches.end(); ++iter)
+						if (!iter->second.polled)
+							iter->second.changed = true;
+				}
+				else if (event->mask & IN_IGNORED)
+				{
+					FallBackToPolling(event->wd);
+				}
+				else
+				{
+					const gs2d::str_type::string name((event->len > 0) ? event->name : "");
+					DispatchEvent(event->wd, name, (event->mask & (IN_DELETE_SELF | IN_MOVE_SELF)) != 0);
+				}
+			}
+		}
+	#endif
+}
+
+void FileWatcher::DispatchEvent(const int descriptor, const gs2d::str_type::string& name, const bool selfEvent)
+{
+	std::map<int, gs2d::str_type::string>::iterator known = m_descriptorDirectories.find(descriptor);
+	if (known == m_descriptorDirectories.end())
+		return;
+
+	const std::vector<WATCH_ID>& watches = m_directories[known->second].watches;
+	for (std::size_t t = 0; t < watches.size(); t++)
+	{
+		WATCH& watch = m_watches[watches[t]];
+		if (selfEvent || watch.isDirectory || watch.fileName == name)
+			watch.changed = true;
+	}
+}
+
+void FileWatcher::FallBackToPolling(const int descriptor)
+{
+	// the kernel drops the watch when its directory is deleted or unmounted. Watches
+	// we removed ourselves are no longer in the map, so they end up here harmlessly
+	std::map<int, gs2d::str_type::string>::iterator known = m_descriptorDirectories.find(descriptor);
+	if (known == m_descriptorDirectories.end())
+		return;
+
+	std::map<gs2d::str_type::string, DIRECTORY>::iterator iter = m_directories.find(known->second);
+	const std::vector<WATCH_ID>& watches = iter->second.watches;
+	for (std::size_t t = 0; t < watches.size(); t++)
+	{
+		WATCH& watch = m_watches[watches[t]];
+		if (m_numPolledWatches++ == 0)
+			m_lastPollTimeUS = MonotonicClock::GetCurrentTimeUS();
+		watch.polled = true;
+		GetFileState(watch.path, watch.state);
+		if (watch.isDirectory)
+			ReadDirectoryState(watch.directory, watch.entries);
+	}
+	m_directories.erase(iter);
+	m_descriptorDirectories.erase(known);
+}
+
+void FileWatcher::PollWatches()
+{
+	for (std::map<WATCH_ID, WATCH>::iterator iter = m_watches.begin(); iter != m_watches.end(); ++iter)
+	{
+		WATCH& watch = iter->second;
+		if (!watch.polled)
+			continue;
+
+		FILE_STATE state;
+		GetFileState(watch.path, state);
+		if (watch.isDirectory)
+		{
+			std::map<gs2d::str_type::string, FILE_STATE> entries;
+			ReadDirectoryState(watch.directory, entries);
+			if (state.exists != watch.state.exists || entries != watch.entries)
+			{
+				watch.changed = true;
+				watch.entries.swap(entries);
+			}
+		}
+		else if (state != watch.state)
+		{
+			watch.changed = true;
+		}
+		watch.state = state;
+	}
+}
+
+bool FileWatcher::ConsumeChange(const WATCH_ID id)
+{
+	std::map<WATCH_ID, WATCH>::iterator iter = m_watches.find(id);
+	if (iter == m_watches.end() || !iter->second.changed)
+		return false;
+
+	iter->second.changed = false;
+	return true;
+}
+
+void FileWatcher::ConsumeChanges(std::vector<WATCH_ID>& changes)
+{
+	for (std::map<WATCH_ID, WATCH>::iterator iter = m_watches.begin(); iter != m_watches.end(); ++iter)
+	{
+		if (iter->second.changed)
+		{
+			changes.push_back(iter->first);
+			iter->second.changed = false;
+		}
+	}
+}
+
+void FileWatcher::SetPollInterval(const boost::uint64_t intervalUS)
+{
+	m_pollIntervalUS = intervalUS;
+}
+
+boost::uint64_t FileWatcher::GetPollInterval() const
+{
+	return m_pollIntervalUS;
+}
+
+bool FileWatcher::IsUsingNativeNotifications() const
+{
+	return (m_notifyDescriptor >= 0);
+}
+
+std::size_t FileWatcher::GetNumWatches() const
+{
+	return m_watches.size();
+}
+
+} // namespace Platform
@@ -0,0 +1,146 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#ifndef FILE_WATCHER_H_
+#define FILE_WATCHER_H_
+
+#include "../Types.h"
+
+#include <boost/cstdint.hpp>
+
+#include <map>
+#include <vector>
+
+#if defined(__linux__) && !defined(GS2D_NO_INOTIFY)
+ #define GS2D_USE_INOTIFY
+#endif
+
+namespace Platform {
+
+class FileWatcher;
+typedef boost::shared_ptr<FileWatcher> FileWatcherPtr;
+
+/**
+ * \brief Watches many files and directories for changes with a single service
+ *
+ * On Linux every watched directory (or the parent directory of a watched
+ * file) gets one inotify watch, and Update() only drains whatever the kernel
+ * queued, so idle watches cost nothing. Watching the parent directory
+ * instead of the file itself also catches editors that save by writing a
+ * temporary file and renaming it over the original. Everywhere else, and
+ * for paths inotify refuses, the modification time and size of the watched
+ * paths are polled every GetPollInterval() microseconds.
+ *
+ * Notifications are coalesced: no matter how many writes hit a path between
+ * two calls, its watch is reported as changed only once.
+ */
+class FileWatcher
+{
+public:
+	typedef unsigned int WATCH_ID;
+	static const WATCH_ID INVALID_WATCH;
+	static const boost::uint64_t DEFAULT_POLL_INTERVAL_US;
+
+	struct FILE_STATE
+	{
+		FILE_STATE();
+		bool operator==(const FILE_STATE& other) const;
+		bool operator!=(const FILE_STATE& other) const;
+		bool exists;
+		boost::int64_t modificationTime;
+		boost::int64_t size;
+	};
+
+	/// Returns the watcher shared by the whole application
+	static FileWatcherPtr GetSharedInstance();
+
+	static bool GetFileState(const gs2d::str_type::string& path, FILE_STATE& state);
+
+	/// Lists the entries directly inside directory, which must end with a slash, sorted by name
+	static void ReadDirectoryState(const gs2d::str_type::string& directory, std::map<gs2d::str_type::string, FILE_STATE>& entries);
+
+	FileWatcher();
+	~FileWatcher();
+
+	/// The file doesn't have to exist yet: its creation is reported as a change
+	WATCH_ID AddFile(const gs2d::str_type::string& path);
+
+	/// Changes to any file directly inside the directory are reported on its watch
+	WATCH_ID AddDirectory(const gs2d::str_type::string& path);
+
+	void RemoveWatch(const WATCH_ID id);
+
+	/// Collects the pending notifications. Never blocks
+	void Update();
+
+	/// Returns whether the watch changed since the last call, and clears its flag
+	bool ConsumeChange(const WATCH_ID id);
+
+	/// Appends every changed watch to changes, and clears their flags
+	void ConsumeChanges(std::vector<WATCH_ID>& changes);
+
+	void SetPollInterval(const boost::uint64_t intervalUS);
+	boost::uint64_t GetPollInterval() const;
+
+	bool IsUsingNativeNotifications() const;
+	std::size_t GetNumWatches() const;
+
+private:
+	struct WATCH
+	{
+		gs2d::str_type::string path;
+		gs2d::str_type::string directory;
+		gs2d::str_type::string fileName;
+		bool isDirectory;
+		bool polled;
+		bool changed;
+		FILE_STATE state;
+		std::map<gs2d::str_type::string, FILE_STATE> entries;
+	};
+
+	struct DIRECTORY
+	{
+		int descriptor;
+		std::vector<WATCH_ID> watches;
+	};
+
+	WATCH_ID AddWatch(const gs2d::str_type::string& path, const bool isDirectory);
+	bool AttachToDirectory(const WATCH_ID id, gs2d::str_type::string& directory);
+	void DetachFromDirectory(const WATCH_ID id, const gs2d::str_type::string& directory);
+	void ReadNativeEvents();
+	void DispatchEvent(const int descriptor, const gs2d::str_type::string& name, const bool selfEvent);
+	void FallBackToPolling(const int descriptor);
+	void PollWatches();
+
+	std::map<WATCH_ID, WATCH> m_watches;
+	std::map<gs2d::str_type::string, DIRECTORY> m_directories;
+	std::map<int, gs2d::str_type::string> m_descriptorDirectories;
+	WATCH_ID m_nextId;
+	int m_notifyDescriptor;
+	std::size_t m_numPolledWatches;
+	boost::uint64_t m_pollIntervalUS;
+	boost::uint64_t m_lastPollTimeUS;
+};
+
+} // namespace Platform
+
+#endif
@@ -0,0 +1,218 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#include "MonotonicClock.h"
+
+#if defined(WIN32)
+ #include <windows.h>
+ #include <mmsystem.h>
+#elif defined(APPLE_IOS) || defined(MACOSX)
+ #include <mach/mach_time.h>
+ #include <time.h>
+#else
+ #include <time.h>
+ #include <errno.h>
+#endif
+
+namespace Platform {
+
+MonotonicClock::MonotonicClock()
+{
+	Reset();
+}
+
+void MonotonicClock::Reset()
+{
+	m_origin = GetCurrentTimeUS();
+}
+
+boost::uint64_t MonotonicClock::GetElapsedTimeUS() const
+{
+	return GetCurrentTimeUS() - m_origin;
+}
+
+double MonotonicClock::GetElapsedTimeMS() const
+{
+	return static_cast<double>(GetElapsedTimeUS()) / 1000.0;
+}
+
+#if defined(WIN32)
+
+boost::uint64_t MonotonicClock::GetCurrentTimeUS()
+{
+	static LARGE_INTEGER frequency = { 0 };
+	if (frequency.QuadPart == 0)
+		QueryPerformanceFrequency(&frequency);
+
+	LARGE_INTEGER counter;
+	QueryPerformanceCounter(&counter);
+
+	// split the division to avoid overflowing the intermediate product
+	const boost::uint64_t ticks = static_cast<boost::uint64_t>(counter.QuadPart);
+	const boost::uint64_t freq = static_cast<boost::uint64_t>(frequency.QuadPart);
+	return ((ticks / freq) * 1000000) + (((ticks % freq) * 1000000) / freq);
+}
+
+void SleepMicroseconds(const boost::uint64_t microseconds)
+{
+	Sleep(static_cast<DWORD>(microseconds / 1000));
+}
+
+#elif defined(APPLE_IOS) || defined(MACOSX)
+
+boost::uint64_t MonotonicClock::GetCurrentTimeUS()
+{
+	static mach_timebase_info_data_t timebase = { 0, 0 };
+	if (timebase.denom == 0)
+		mach_timebase_info(&timebase);
+	const boost::uint64_t nanoseconds = (mach_absolute_time() / timebase.denom) * timebase.numer;
+	return nanoseconds / 1000;
+}
+
+void SleepMicroseconds(const boost::uint64_t microseconds)
+{
+	timespec request;
+	request.tv_sec = static_cast<time_t>(microseconds / 1000000);
+	request.tv_nsec = static_cast<long>((microseconds % 1000000) * 1000);
+	nanosleep(&request, 0);
+}
+
+#else
+
+boost::uint64_t MonotonicClock::GetCurrentTimeUS()
+{
+	timespec current;
+	clock_gettime(CLOCK_MONOTONIC, &current);
+	return (static_cast<boost::uint64_t>(current.tv_sec) * 1000000) + (static_cast<boost::uint64_t>(current.tv_nsec) / 1000);
+}
+
+void SleepMicroseconds(const boost::uint64_t microseconds)
+{
+	timespec request, remaining;
+	request.tv_sec = static_cast<time_t>(microseconds / 1000000);
+	request.tv_nsec = static_cast<long>((microseconds % 1000000) * 1000);
+
+	// resume the sleep if a signal interrupts it
+	while (nanosleep(&request, &remaining) == -1 && errno == EINTR)
+		request = remaining;
+}
+
+#endif
+
+// spinning for the last half millisecond absorbs the scheduler jitter
+const boost::uint64_t FrameLimiter::SPIN_MARGIN_US(500);
+
+FrameLimiter::FrameLimiter() :
+	m_maxFrameRate(0.0f),
+	m_periodUS(0),
+	m_nextFrameTimeUS(0),
+	m_sleepOvershootUS(0),
+	m_highTimerResolution(false)
+{
+}
+
+FrameLimiter::~FrameLimiter()
+{
+	SetHighTimerResolution(false);
+}
+
+void FrameLimiter::SetHighTimerResolution(const bool enable)
+{
+	if (enable == m_highTimerResolution)
+		return;
+
+	// the default Windows scheduler granularity is 15.6ms, which is useless for frame pacing
+	#if defined(WIN32)
+	if (enable)
+		timeBeginPeriod(1);
+	else
+		timeEndPeriod(1);
+	#endif
+	m_highTimerResolution = enable;
+}
+
+void FrameLimiter::SetMaxFrameRate(const float fps)
+{
+	m_maxFrameRate = (fps > 0.0f) ? fps : 0.0f;
+	m_periodUS = (fps > 0.0f) ? static_cast<boost::uint64_t>(1000000.0 / static_cast<double>(fps)) : 0;
+	SetHighTimerResolution(m_periodUS > 0);
+	Reset();
+}
+
+float FrameLimiter::GetMaxFrameRate() const
+{
+	return m_maxFrameRate;
+}
+
+void FrameLimiter::Reset()
+{
+	m_nextFrameTimeUS = MonotonicClock::GetCurrentTimeUS() + m_periodUS;
+}
+
+boost::uint64_t FrameLimiter::GetTimeLeftUS() const
+{
+	if (m_periodUS == 0)
+		return 0;
+
+	const boost::uint64_t now = MonotonicClock::GetCurrentTimeUS();
+	return (now < m_nextFrameTimeUS) ? (m_nextFrameTimeUS - now) : 0;
+}
+
+boost::uint64_t FrameLimiter::Wait()
+{
+	if (m_periodUS == 0)
+		return 0;
+
+	const boost::uint64_t start = MonotonicClock::GetCurrentTimeUS();
+
+	// if the frame is late by more than one whole period, don't try to
+	// catch up with a burst of unlimited frames: restart the cadence instead
+	if (start >= m_nextFrameTimeUS)
+	{
+		m_nextFrameTimeUS = (start - m_nextFrameTimeUS < m_periodUS) ? (m_nextFrameTimeUS + m_periodUS) : (start + m_periodUS);
+		return 0;
+	}
+
+	const boost::uint64_t remaining = m_nextFrameTimeUS - start;
+	if (remaining > SPIN_MARGIN_US + m_sleepOvershootUS)
+	{
+		const boost::uint64_t requested = remaining - SPIN_MARGIN_US - m_sleepOvershootUS;
+		SleepMicroseconds(requested);
+
+		const boost::uint64_t slept = MonotonicClock::GetCurrentTimeUS() - start;
+		const boost::uint64_t overshoot = (slept > requested) ? (slept - requested) : 0;
+
+		// running average, so a single preempted frame won't make the limiter spin for too long
+		m_sleepOvershootUS = ((m_sleepOvershootUS * 7) + overshoot) / 8;
+	}
+
+	boost::uint64_t now = MonotonicClock::GetCurrentTimeUS();
+	while (now < m_nextFrameTimeUS)
+	{
+		now = MonotonicClock::GetCurrentTimeUS();
+	}
+
+	m_nextFrameTimeUS += m_periodUS;
+	return now - start;
+}
+
+} // namespace Platform
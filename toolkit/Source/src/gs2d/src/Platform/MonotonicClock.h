@@ -0,0 +1,103 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#ifndef MONOTONIC_CLOCK_H_
+#define MONOTONIC_CLOCK_H_
+
+#include <boost/cstdint.hpp>
+
+namespace Platform {
+
+/**
+ * \brief Microsecond resolution clock that never goes backwards
+ *
+ * Backed by QueryPerformanceCounter on Windows, mach_absolute_time on
+ * Apple platforms and CLOCK_MONOTONIC everywhere else. Unlike the
+ * wall clock, it is not affected by system time adjustments.
+ */
+class MonotonicClock
+{
+public:
+	MonotonicClock();
+
+	/// Moves the clock origin to the current time
+	void Reset();
+
+	/// Returns the time elapsed since the clock was created or last reset, in microseconds
+	boost::uint64_t GetElapsedTimeUS() const;
+
+	/// Returns the time elapsed since the clock was created or last reset, in milliseconds
+	double GetElapsedTimeMS() const;
+
+	/// Returns the current value of the system monotonic clock, in microseconds
+	static boost::uint64_t GetCurrentTimeUS();
+
+private:
+	boost::uint64_t m_origin;
+};
+
+/// Suspends the calling thread for at least the given amount of microseconds
+void SleepMicroseconds(const boost::uint64_t microseconds);
+
+/**
+ * \brief Caps the frame rate without relying on vsync
+ *
+ * Wait() must be called once per frame. It sleeps through the bulk of
+ * the remaining frame period and spins only for the last fraction of a
+ * millisecond, so the frame rate stays steady without burning a whole
+ * core. The sleep overshoot of the platform scheduler is measured on the
+ * fly and subtracted from subsequent sleeps.
+ */
+class FrameLimiter
+{
+public:
+	FrameLimiter();
+	~FrameLimiter();
+
+	/// Sets the maximum frame rate. Zero disables the limiter
+	void SetMaxFrameRate(const float fps);
+	float GetMaxFrameRate() const;
+
+	/// Blocks until the current frame period is over. Returns the amount of microseconds waited
+	boost::uint64_t Wait();
+
+	/// Returns how many microseconds are left before the current frame period is over, zero if uncapped or late
+	boost::uint64_t GetTimeLeftUS() const;
+
+	/// Restarts the frame cadence from the current time
+	void Reset();
+
+private:
+	static const boost::uint64_t SPIN_MARGIN_US;
+
+	void SetHighTimerResolution(const bool enable);
+
+	float m_maxFrameRate;
+	boost::uint64_t m_periodUS;
+	boost::uint64_t m_nextFrameTimeUS;
+	boost::uint64_t m_sleepOvershootUS;
+	bool m_highTimerResolution;
+};
+
+} // namespace Platform
+
+#endif
@@ -27,6 +27,8 @@ namespace Platform {
 using namespace gs2d;
 
 const str_type::string NativeCommandAssembler::CMD_PLAY_SOUND = "play_sound";
+const str_type::string NativeCommandAssembler::CMD_PLAY_VOICE = "play_voice";
+const str_type::string NativeCommandAssembler::CMD_LIMIT_VOICES = "limit_voices";
 const str_type::string NativeCommandAssembler::CMD_PLAY_MUSIC = "play_music";
 const str_type::string NativeCommandAssembler::CMD_LOAD_SOUND = "load_sound";
 const str_type::string NativeCommandAssembler::CMD_LOAD_MUSIC = "load_music";
@@ -82,6 +84,20 @@ str_type::string NativeCommandAssembler::PlaySound(const str_type::string& fileN
 	return ss.str();
 }
 
+str_type::string NativeCommandAssembler::PlayVoice(const str_type::string& fileName, const float volume, const float pan, const float speed, const unsigned int maxVoices)
+{
+	str_type::stringstream ss;
+	ss << CMD_PLAY_VOICE << " " << fileName << " " << volume << " " << pan << " " << speed << " " << maxVoices;
+	return ss.str();
+}
+
+str_type::string NativeCommandAssembler::LimitVoices(const str_type::string& fileName, const unsigned int maxVoices)
+{
+	str_type::stringstream ss;
+	ss << CMD_LIMIT_VOICES << " " << fileName << " " << maxVoices;
+	return ss.str();
+}
+
 str_type::string NativeCommandAssembler::PlayMusic(const str_type::string& fileName, const float volume, const bool loop, const float speed)
 {
 	str_type::stringstream ss;
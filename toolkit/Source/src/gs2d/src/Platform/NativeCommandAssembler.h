@@ -31,6 +31,8 @@ class NativeCommandAssembler
 {
 public:
 	static const gs2d::str_type::string CMD_PLAY_SOUND;
+	static const gs2d::str_type::string CMD_PLAY_VOICE;
+	static const gs2d::str_type::string CMD_LIMIT_VOICES;
 	static const gs2d::str_type::string CMD_LOAD_SOUND;
 	static const gs2d::str_type::string CMD_PLAY_MUSIC;
 	static const gs2d::str_type::string CMD_LOAD_MUSIC;
@@ -44,6 +46,8 @@ public:
 	/*
 	load_sound <string:sample_name>
 	play_sound <string:sample_name> <float:volume> <int:loop> <float:speed>
+	play_voice <string:sample_name> <float:volume> <float:pan> <float:speed> <int:max_voices>
+	limit_voices <string:sample_name> <int:max_voices>
 	delete_sound <string:sample_name>
 	*/
 
@@ -54,6 +58,8 @@ public:
 	static gs2d::str_type::string DeleteSound(const gs2d::str_type::string& fileName);
 	static gs2d::str_type::string DeleteMusic(const gs2d::str_type::string& fileName);
 	static gs2d::str_type::string PlaySound(const gs2d::str_type::string& fileName, const float volume, const bool loop, const float speed);
+	static gs2d::str_type::string PlayVoice(const gs2d::str_type::string& fileName, const float volume, const float pan, const float speed, const unsigned int maxVoices);
+	static gs2d::str_type::string LimitVoices(const gs2d::str_type::string& fileName, const unsigned int maxVoices);
 	static gs2d::str_type::string PlayMusic(const gs2d::str_type::string& fileName, const float volume, const bool loop, const float speed);
 	static gs2d::str_type::string StopMusic(const gs2d::str_type::string& fileName);
 	static gs2d::str_type::string SetGlobalVolume(const float volume);
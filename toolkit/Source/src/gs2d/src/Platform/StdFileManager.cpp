@@ -63,6 +63,57 @@ bool StdFileManager::GetFileBuffer(const str_type::string &fileName, FileBuffer
 	return true;
 }
 
+class StdFileStream : public FileStream
+{
+	FILE* m_file;
+	unsigned long m_size;
+
+public:
+	StdFileStream(FILE* file) :
+		m_file(file)
+	{
+		fseek(m_file, 0, SEEK_END);
+		m_size = static_cast<unsigned long>(ftell(m_file));
+		fseek(m_file, 0, SEEK_SET);
+	}
+
+	~StdFileStream()
+	{
+		fclose(m_file);
+	}
+
+	unsigned long Read(void* buffer, const unsigned long size)
+	{
+		return static_cast<unsigned long>(fread(buffer, 1, size, m_file));
+	}
+
+	bool Seek(const long offset, const SEEK_ORIGIN origin)
+	{
+		static const int origins[] = { SEEK_SET, SEEK_CUR, SEEK_END };
+		return (fseek(m_file, offset, origins[origin]) == 0);
+	}
+
+	unsigned long Tell() const
+	{
+		return static_cast<unsigned long>(ftell(m_file));
+	}
+
+	unsigned long GetSize() const
+	{
+		return m_size;
+	}
+};
+
+FileStreamPtr StdFileManager::OpenFileStream(const gs2d::str_type::string& fileName)
+{
+	FILE* file = LoadFile(fileName);
+	if (!file)
+	{
+		return FileStreamPtr();
+	}
+	return FileStreamPtr(new StdFileStream(file));
+}
+
 bool StdFileManager::FileExists(const gs2d::str_type::string& fileName) const
 {
 	FILE* file = LoadFile(fileName);
@@ -32,6 +32,7 @@ class StdFileManager : public FileManager
 public:
 	bool IsLoaded() const;
 	bool GetFileBuffer(const gs2d::str_type::string &fileName, FileBuffer &out);
+	FileStreamPtr OpenFileStream(const gs2d::str_type::string& fileName);
 	bool FileExists(const gs2d::str_type::string& fileName) const;
 	bool IsPacked() const;
 };
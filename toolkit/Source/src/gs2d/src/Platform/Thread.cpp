@@ -0,0 +1,268 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#include "Thread.h"
+
+#ifdef WIN32
+ #define WIN32_LEAN_AND_MEAN
+ #include <windows.h>
+#else
+ #include <sys/time.h>
+#endif
+
+namespace Platform {
+
+#ifdef WIN32
+
+Lock::Lock() :
+	m_section(new CRITICAL_SECTION)
+{
+	InitializeCriticalSection(static_cast<CRITICAL_SECTION*>(m_section));
+	m_event = CreateEvent(NULL, FALSE, FALSE, NULL);
+}
+
+Lock::~Lock()
+{
+	CloseHandle(static_cast<HANDLE>(m_event));
+	DeleteCriticalSection(static_cast<CRITICAL_SECTION*>(m_section));
+	delete static_cast<CRITICAL_SECTION*>(m_section);
+}
+
+void Lock::Acquire()
+{
+	EnterCriticalSection(static_cast<CRITICAL_SECTION*>(m_section));
+}
+
+bool Lock::TryAcquire()
+{
+	return (TryEnterCriticalSection(static_cast<CRITICAL_SECTION*>(m_section)) != FALSE);
+}
+
+void Lock::Release()
+{
+	LeaveCriticalSection(static_cast<CRITICAL_SECTION*>(m_section));
+}
+
+void Lock::Signal()
+{
+	SetEvent(static_cast<HANDLE>(m_event));
+}
+
+void Lock::WaitForSignal()
+{
+	Release();
+	WaitForSingleObject(static_cast<HANDLE>(m_event), INFINITE);
+	Acquire();
+}
+
+void Lock::WaitForSignal(const unsigned int timeoutMS)
+{
+	Release();
+	WaitForSingleObject(static_cast<HANDLE>(m_event), timeoutMS);
+	Acquire();
+}
+
+#else
+
+Lock::Lock()
+{
+	pthread_mutex_init(&m_mutex, 0);
+	pthread_cond_init(&m_condition, 0);
+}
+
+Lock::~Lock()
+{
+	pthread_cond_destroy(&m_condition);
+	pthread_mutex_destroy(&m_mutex);
+}
+
+void Lock::Acquire()
+{
+	pthread_mutex_lock(&m_mutex);
+}
+
+bool Lock::TryAcquire()
+{
+	return (pthread_mutex_trylock(&m_mutex) == 0);
+}
+
+void Lock::Release()
+{
+	pthread_mutex_unlock(&m_mutex);
+}
+
+void Lock::Signal()
+{
+	pthread_cond_broadcast(&m_condition);
+}
+
+void Lock::WaitForSignal()
+{
+	pthread_cond_wait(&m_condition, &m_mutex);
+}
+
+void Lock::WaitForSignal(const unsigned int timeoutMS)
+{
+	timeval now;
+	gettimeofday(&now, 0);
+
+	const long nanoseconds = now.tv_usec * 1000L + static_cast<long>(timeoutMS % 1000) * 1000000L;
+	timespec deadline;
+	deadline.tv_sec = now.tv_sec + timeoutMS / 1000 + nanoseconds / 1000000000L;
+	deadline.tv_nsec = nanoseconds % 1000000000L;
+	pthread_cond_timedwait(&m_condition, &m_mutex, &deadline);
+}
+
+#endif
+
+ScopedLock::ScopedLock(Lock& lock) :
+	m_lock(lock)
+{
+	m_lock.Acquire();
+}
+
+ScopedLock::~ScopedLock()
+{
+	m_lock.Release();
+}
+
+// thread entry points, allowed to reach into Thread's privates
+struct ThreadEntry
+{
+#ifdef WIN32
+	static DWORD WINAPI Run(LPVOID thread)
+#else
+	static void* Run(void* thread)
+#endif
+	{
+		Thread* self = static_cast<Thread*>(thread);
+		self->m_routine(self->m_arg);
+		return 0;
+	}
+};
+
+Thread::Thread() :
+	m_routine(0),
+	m_arg(0),
+	m_running(false)
+{
+}
+
+#ifdef WIN32
+
+bool Thread::Start(ROUTINE routine, void* arg)
+{
+	if (m_running)
+		return false;
+
+	m_routine = routine;
+	m_arg = arg;
+	m_handle = CreateThread(NULL, 0, ThreadEntry::Run, this, 0, NULL);
+	m_running = (m_handle != NULL);
+	return m_running;
+}
+
+void Thread::Join()
+{
+	if (!m_running)
+		return;
+
+	WaitForSingleObject(static_cast<HANDLE>(m_handle), INFINITE);
+	CloseHandle(static_cast<HANDLE>(m_handle));
+	m_running = false;
+}
+
+long AtomicCompareAndSwap(volatile long* dest, const long comparand, const long exchange)
+{
+	return InterlockedCompareExchange(dest, exchange, comparand);
+}
+
+long AtomicIncrement(volatile long* value)
+{
+	return InterlockedIncrement(value);
+}
+
+long AtomicLoad(volatile long* src)
+{
+	return InterlockedCompareExchange(src, 0, 0);
+}
+
+void AtomicStore(volatile long* dest, const long value)
+{
+	InterlockedExchange(dest, value);
+}
+
+#else
+
+bool Thread::Start(ROUTINE routine, void* arg)
+{
+	if (m_running)
+		return false;
+
+	m_routine = routine;
+	m_arg = arg;
+	m_running = (pthread_create(&m_handle, 0, ThreadEntry::Run, this) == 0);
+	return m_running;
+}
+
+void Thread::Join()
+{
+	if (!m_running)
+		return;
+
+	pthread_join(m_handle, 0);
+	m_running = false;
+}
+
+long AtomicCompareAndSwap(volatile long* dest, const long comparand, const long exchange)
+{
+	return __sync_val_compare_and_swap(dest, comparand, exchange);
+}
+
+long AtomicIncrement(volatile long* value)
+{
+	return __sync_add_and_fetch(value, 1);
+}
+
+long AtomicLoad(volatile long* src)
+{
+	__sync_synchronize();
+	const long value = *src;
+	__sync_synchronize();
+	return value;
+}
+
+void AtomicStore(volatile long* dest, const long value)
+{
+	__sync_synchronize();
+	*dest = value;
+	__sync_synchronize();
+}
+
+#endif
+
+bool Thread::IsRunning() const
+{
+	return m_running;
+}
+
+} // namespace Platform
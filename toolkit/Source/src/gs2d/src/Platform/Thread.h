@@ -0,0 +1,128 @@
+/*--------------------------------------------------------------------------------------
+ Ethanon Engine (C) Copyright 2008-2013 Andre Santee
+ http://ethanonengine.com/
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+    software and associated documentation files (the "Software"), to deal in the
+    Software without restriction, including without limitation the rights to use, copy,
+    modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so, subject to the
+    following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+    CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+    OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------------*/
+
+#ifndef PLATFORM_THREAD_H_
+#define PLATFORM_THREAD_H_
+
+#ifndef WIN32
+ #include <pthread.h>
+#endif
+
+namespace Platform {
+
+/**
+ * \brief Mutex paired with a condition other threads can wait on
+ *
+ * Win32 and pthreads are used directly, as Audiere does, so gs2d needs no
+ * threading library. On Win32 the condition is an auto-reset event, so
+ * Signal wakes a single waiter.
+ */
+class Lock
+{
+public:
+	Lock();
+	~Lock();
+
+	void Acquire();
+	bool TryAcquire();
+	void Release();
+
+	/// May be called with or without the lock held
+	void Signal();
+
+	/// Must be called with the lock held, and returns with it held again
+	void WaitForSignal();
+
+	/// Same as WaitForSignal(), but gives up after timeoutMS milliseconds
+	void WaitForSignal(const unsigned int timeoutMS);
+
+private:
+	Lock(const Lock&);
+	Lock& operator=(const Lock&);
+
+#ifdef WIN32
+	// CRITICAL_SECTION and HANDLE, kept opaque so windows.h macros stay out of the headers
+	void* m_section;
+	void* m_event;
+#else
+	pthread_mutex_t m_mutex;
+	pthread_cond_t m_condition;
+#endif
+};
+
+class ScopedLock
+{
+public:
+	ScopedLock(Lock& lock);
+	~ScopedLock();
+
+private:
+	Lock& m_lock;
+};
+
+/// Runs a function on a thread of its own
+class Thread
+{
+public:
+	typedef void (*ROUTINE)(void* arg);
+
+	Thread();
+
+	/// Returns false if the system refused to create the thread
+	bool Start(ROUTINE routine, void* arg);
+
+	/// Blocks until the routine returns
+	void Join();
+
+	bool IsRunning() const;
+
+private:
+	Thread(const Thread&);
+	Thread& operator=(const Thread&);
+
+	friend struct ThreadEntry;
+
+#ifdef WIN32
+	void* m_handle;
+#else
+	pthread_t m_handle;
+#endif
+	ROUTINE m_routine;
+	void* m_arg;
+	bool m_running;
+};
+
+/// Sets dest to exchange if it holds comparand. Returns the value dest held before the call
+long AtomicCompareAndSwap(volatile long* dest, const long comparand, const long exchange);
+
+/// Returns the incremented value
+long AtomicIncrement(volatile long* value);
+
+/// Reads a value written by another thread, and whatever that thread wrote before it
+long AtomicLoad(volatile long* src);
+
+/// Writes a value so that whatever was written before it is visible to the thread that loads it
+void AtomicStore(volatile long* dest, const long value);
+
+} // namespace Platform
+
+#endif
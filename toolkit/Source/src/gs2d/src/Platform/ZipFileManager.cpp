@@ -35,7 +35,9 @@ using namespace gs2d;
 
 namespace Platform {
 
-ZipFileManager::ZipFileManager(const str_type::char_t *filePath, const gs2d::str_type::char_t* password)
+ZipFileManager::ZipFileManager(const str_type::char_t *filePath, const gs2d::str_type::char_t* password) :
+	m_filePath(filePath),
+	m_password(password ? password : GS_L(""))
 {
 	m_archive = zip_open(filePath, 0, NULL);
 	if (m_archive == NULL)
@@ -95,6 +97,144 @@ bool ZipFileManager::GetFileBuffer(const str_type::string &fileName, FileBuffer
 	return true;
 }
 
+/**
+ * Compressed zip entries can't be seeked directly: seeking forward decompresses and
+ * discards the bytes in between, seeking backward reopens the entry and skips from
+ * the beginning. Callers should buffer whatever they may need to read again.
+ */
+class ZipFileStream : public FileStream
+{
+	zip *m_archive;
+	zip_file *m_file;
+	str_type::string m_fileName;
+	unsigned long m_size;
+	unsigned long m_position;
+
+	bool Rewind()
+	{
+		if (m_file)
+			zip_fclose(m_file);
+		m_file = zip_fopen(m_archive, m_fileName.c_str(), 0);
+		m_position = 0;
+		return (m_file != NULL);
+	}
+
+	bool Skip(unsigned long count)
+	{
+		unsigned char scratch[4096];
+		while (count > 0)
+		{
+			const unsigned long chunk = (count < sizeof(scratch)) ? count : sizeof(scratch);
+			const zip_int64_t read = zip_fread(m_file, scratch, chunk);
+			if (read <= 0)
+				return false;
+			m_position += static_cast<unsigned long>(read);
+			count -= static_cast<unsigned long>(read);
+		}
+		return true;
+	}
+
+public:
+	ZipFileStream(zip *archive, zip_file *file, const str_type::string& fileName, const unsigned long size) :
+		m_archive(archive),
+		m_file(file),
+		m_fileName(fileName),
+		m_size(size),
+		m_position(0)
+	{
+	}
+
+	~ZipFileStream()
+	{
+		if (m_file)
+			zip_fclose(m_file);
+		zip_close(m_archive);
+	}
+
+	unsigned long Read(void* buffer, const unsigned long size)
+	{
+		if (!m_file)
+			return 0;
+
+		const zip_int64_t read = zip_fread(m_file, buffer, size);
+		if (read <= 0)
+			return 0;
+
+		m_position += static_cast<unsigned long>(read);
+		return static_cast<unsigned long>(read);
+	}
+
+	bool Seek(const long offset, const SEEK_ORIGIN origin)
+	{
+		long base = 0;
+		switch (origin)
+		{
+		case FROM_CURRENT:
+			base = static_cast<long>(m_position);
+			break;
+		case FROM_END:
+			base = static_cast<long>(m_size);
+			break;
+		default:
+			break;
+		};
+
+		const long position = base + offset;
+		if (position < 0 || position > static_cast<long>(m_size))
+			return false;
+
+		const unsigned long target = static_cast<unsigned long>(position);
+		if (!m_file || target < m_position)
+		{
+			if (!Rewind())
+				return false;
+		}
+		return Skip(target - m_position);
+	}
+
+	unsigned long Tell() const
+	{
+		return m_position;
+	}
+
+	unsigned long GetSize() const
+	{
+		return m_size;
+	}
+};
+
+FileStreamPtr ZipFileManager::OpenFileStream(const str_type::string& fileName)
+{
+	if (!IsLoaded())
+		return FileStreamPtr();
+
+	str_type::string fixedPath = fileName;
+	FixSlashesForUnix(fixedPath);
+
+	// the stream gets its own archive handle, so it can be read from another
+	// thread while this manager keeps loading files
+	zip *archive = zip_open(m_filePath.c_str(), 0, NULL);
+	if (archive == NULL)
+		return FileStreamPtr();
+
+	#ifndef ANDROID
+		if (m_password != GS_L(""))
+			zip_set_default_password(archive, m_password.c_str());
+	#endif
+
+	struct zip_stat stat;
+	zip_file *file = zip_fopen(archive, fixedPath.c_str(), 0);
+	if (file == NULL || zip_stat(archive, fixedPath.c_str(), 0, &stat) != 0)
+	{
+		if (file)
+			zip_fclose(file);
+		zip_close(archive);
+		return FileStreamPtr();
+	}
+
+	return FileStreamPtr(new ZipFileStream(archive, file, fixedPath, static_cast<unsigned long>(stat.size)));
+}
+
 bool ZipFileManager::FileExists(const gs2d::str_type::string& fileName) const
 {
 	if (!IsLoaded())
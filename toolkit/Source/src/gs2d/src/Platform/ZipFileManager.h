@@ -37,12 +37,15 @@ public:
 
 	bool IsLoaded() const;
 	bool GetFileBuffer(const gs2d::str_type::string &fileName, FileBuffer &out);
+	FileStreamPtr OpenFileStream(const gs2d::str_type::string& fileName);
 	bool FileExists(const gs2d::str_type::string& fileName) const;
 	bool IsPacked() const;
 	zip *GetZip();
 
 private:
 	zip *m_archive;
+	gs2d::str_type::string m_filePath;
+	gs2d::str_type::string m_password;
 };
 
 typedef boost::shared_ptr<ZipFileManager> ZipFileManagerPtr;
@@ -27,6 +27,9 @@
 #include "Math/Color.h"
 #include <boost/shared_array.hpp>
 
+#include <map>
+#include <vector>
+
 namespace gs2d {
 
 class Video;
@@ -67,6 +70,63 @@ public:
 		SF_NONE = 2
 	};
 
+	/**
+	 * \brief Integer alias for a constant name
+	 *
+	 * Handles are global: the same handle addresses the constant with that name in every shader,
+	 * so callers can resolve it once (e.g. into a function-level static) and skip the name lookup
+	 * on every SetConstant call. Each backend resolves the handle to its own location lazily.
+	 */
+	typedef unsigned int CONSTANT_HANDLE;
+
+	/// Counters used to measure how much constant traffic reaches the backend
+	struct CONSTANT_STATS
+	{
+		CONSTANT_STATS() : setCalls(0), nameLookups(0), uploads(0), bytesUploaded(0) {}
+		unsigned long setCalls;      ///< calls to SetConstant, SetMatrixConstant and SetConstantArray
+		unsigned long nameLookups;   ///< string-to-location searches done by the backends
+		unsigned long uploads;       ///< values actually sent to the graphics API
+		unsigned long bytesUploaded; ///< amount of constant data actually sent to the graphics API
+	};
+
+	/// Last value written to a constant, used by the backends to drop redundant uploads
+	struct CONSTANT_SHADOW
+	{
+		enum { MAX_FLOATS = 16 };
+		CONSTANT_SHADOW() : numFloats(0) {}
+
+		/// Stores the value and returns true if it differs from the previous one
+		inline bool Update(const float* data, const unsigned int count)
+		{
+			if (count > MAX_FLOATS)
+			{
+				numFloats = 0;
+				return true;
+			}
+			bool changed = (count != numFloats);
+			for (unsigned int t = 0; t < count; t++)
+			{
+				if (values[t] != data[t])
+				{
+					values[t] = data[t];
+					changed = true;
+				}
+			}
+			numFloats = count;
+			return changed;
+		}
+
+		inline void Invalidate() { numFloats = 0; }
+
+		float values[MAX_FLOATS];
+		unsigned int numFloats;
+	};
+
+	static CONSTANT_HANDLE GetConstantHandle(const str_type::string& name);
+	static const str_type::string& GetConstantName(const CONSTANT_HANDLE handle);
+	static CONSTANT_STATS& GetConstantStats();
+	static void ResetConstantStats();
+
 	virtual bool LoadShaderFromFile(
 		ShaderContextPtr context,
 		const str_type::string& fileName,
@@ -96,13 +156,64 @@ public:
 	virtual bool SetMatrixConstant(const str_type::string& name, const math::Matrix4x4 &matrix) = 0;
 	virtual bool SetTexture(const str_type::string& name, TextureWeakPtr pTexture) = 0;
 
+	virtual bool ConstantExist(const CONSTANT_HANDLE handle) = 0;
+	virtual bool SetConstant(const CONSTANT_HANDLE handle, const Color& dw) = 0;
+	virtual bool SetConstant(const CONSTANT_HANDLE handle, const math::Vector4 &v) = 0;
+	virtual bool SetConstant(const CONSTANT_HANDLE handle, const math::Vector3 &v) = 0;
+	virtual bool SetConstant(const CONSTANT_HANDLE handle, const math::Vector2 &v) = 0;
+	virtual bool SetConstant(const CONSTANT_HANDLE handle, const float x) = 0;
+	virtual bool SetMatrixConstant(const CONSTANT_HANDLE handle, const math::Matrix4x4 &matrix) = 0;
+
 	virtual bool SetShader() = 0;
 	virtual SHADER_FOCUS GetShaderFocus() const = 0;
 	virtual SHADER_PROFILE GetShaderProfile() const = 0;
 	virtual void UnbindShader() = 0;
 
+private:
+	struct CONSTANT_REGISTRY
+	{
+		std::map<str_type::string, CONSTANT_HANDLE> handles;
+		std::vector<str_type::string> names;
+	};
+
+	static CONSTANT_REGISTRY& GetConstantRegistry();
 };
 
+inline Shader::CONSTANT_REGISTRY& Shader::GetConstantRegistry()
+{
+	static CONSTANT_REGISTRY registry;
+	return registry;
+}
+
+inline Shader::CONSTANT_HANDLE Shader::GetConstantHandle(const str_type::string& name)
+{
+	CONSTANT_REGISTRY& registry = GetConstantRegistry();
+	std::map<str_type::string, CONSTANT_HANDLE>::iterator iter = registry.handles.find(name);
+	if (iter != registry.handles.end())
+		return iter->second;
+
+	const CONSTANT_HANDLE handle = static_cast<CONSTANT_HANDLE>(registry.names.size());
+	registry.names.push_back(name);
+	registry.handles[name] = handle;
+	return handle;
+}
+
+inline const str_type::string& Shader::GetConstantName(const CONSTANT_HANDLE handle)
+{
+	return GetConstantRegistry().names[handle];
+}
+
+inline Shader::CONSTANT_STATS& Shader::GetConstantStats()
+{
+	static CONSTANT_STATS stats;
+	return stats;
+}
+
+inline void Shader::ResetConstantStats()
+{
+	GetConstantStats() = CONSTANT_STATS();
+}
+
 typedef boost::shared_ptr<Shader> ShaderPtr;
 
 } // namespace gs2d
@@ -289,4 +289,11 @@ Vector2 Sprite::GetScroll() const
 	return m_scroll;
 }
 
+bool Sprite::DrawTriangles(const SCREEN_VERTEX* vertices, const unsigned int numVertices)
+{
+	GS2D_UNUSED_ARGUMENT(vertices);
+	GS2D_UNUSED_ARGUMENT(numVertices);
+	return false;
+}
+
 } // namespace gs2d
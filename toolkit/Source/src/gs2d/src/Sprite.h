@@ -66,6 +66,14 @@ public:
 		RM_FOUR_TRIANGLES,
 	};
 
+	/// Vertex already projected to render target pixels, measured like sprite positions. pos.z is the depth buffer value
+	struct SCREEN_VERTEX
+	{
+		math::Vector3 pos;
+		math::Vector2 texCoord;
+		Color color;
+	};
+
 	Sprite();
 
 	void GetFlipShaderParameters(math::Vector2& flipAdd, math::Vector2& flipMul) const;
@@ -180,6 +188,10 @@ public:
 	virtual void SetOrigin(const math::Vector2& v2Custom);
 	virtual math::Vector2 GetOrigin() const;
 
+	/// Draws a triangle list with this texture in a single call, bypassing the current vertex shader.
+	/// Returns false, drawing nothing, if the video backend does not support it
+	virtual bool DrawTriangles(const SCREEN_VERTEX* vertices, const unsigned int numVertices);
+
 protected:
 	unsigned int  m_currentRect;
 	boost::shared_array<math::Rect2Df> m_rects;
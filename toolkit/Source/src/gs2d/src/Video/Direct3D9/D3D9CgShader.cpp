@@ -118,6 +118,7 @@ D3D9CgShader::D3D9CgShader()
 
 inline CGparameter SeekParameter(const str_type::string &name, std::map<str_type::string, CGparameter> &m_mParam)
 {
+	Shader::GetConstantStats().nameLookups++;
 	std::map<str_type::string, CGparameter>::iterator iter = m_mParam.find(name);
 	if (iter != m_mParam.end())
 		return iter->second;	
@@ -177,80 +178,122 @@ bool D3D9CgShader::SetConstant(const str_type::string& name, const float x, cons
 	return SetConstant(name, Vector2(x,y));
 }
 
+static Shader::CONSTANT_HANDLE LookUpHandle(const str_type::string& name)
+{
+	Shader::GetConstantStats().nameLookups++;
+	return Shader::GetConstantHandle(name);
+}
+
 bool D3D9CgShader::SetConstant(const str_type::string& name, const Vector4 &v)
 {
-	CGparameter param = SeekParameter(name, m_mParam);
+	return SetConstant(LookUpHandle(name), v);
+}
 
-	if (!param)
-	{
-		str_type::string message = GS_L("D3D9CgShader::Set(*) invalid parameter: ");
-		message += name;
-		ShowMessage(message);
-		return false;
-	}
+bool D3D9CgShader::SetConstant(const str_type::string& name, const Vector3 &v)
+{
+	return SetConstant(LookUpHandle(name), v);
+}
 
-	cgSetParameter4fv(param, (float*)&v);
-	if (CheckForError(GS_L("D3D9CgShader::SetConstant4F setting parameter"), m_shaderName))
-		return false;
-	return true;
+bool D3D9CgShader::SetConstant(const str_type::string& name, const Vector2 &v)
+{
+	return SetConstant(LookUpHandle(name), v);
 }
 
-bool D3D9CgShader::SetConstant(const str_type::string& name, const Vector3 &v)
+bool D3D9CgShader::SetConstant(const str_type::string& name, const float value)
 {
-	CGparameter param = SeekParameter(name, m_mParam);
+	return SetConstant(LookUpHandle(name), value);
+}
 
-	if (!param)
+D3D9CgShader::CONSTANT_SLOT* D3D9CgShader::GetSlot(const CONSTANT_HANDLE handle)
+{
+	if (handle >= m_slots.size())
 	{
-		str_type::string message = GS_L("D3D9CgShader::Set(*) invalid parameter: ");
-		message += name;
-		ShowMessage(message);
-		return false;
+		m_slots.resize(handle + 1);
 	}
 
-	cgSetParameter3fv(param, (float*)&v);
-	if (CheckForError(GS_L("D3D9CgShader::SetConstant3F setting parameter"), m_shaderName))
-		return false;
-	return true;
+	CONSTANT_SLOT& slot = m_slots[handle];
+	if (!slot.resolved)
+	{
+		slot.param = SeekParameter(GetConstantName(handle), m_mParam);
+		slot.resolved = true;
+	}
+	return (slot.param) ? &slot : 0;
 }
 
-bool D3D9CgShader::SetConstant(const str_type::string& name, const Vector2 &v)
+bool D3D9CgShader::SetConstantValue(
+	const CONSTANT_HANDLE handle,
+	const float* data,
+	const unsigned int numFloats,
+	CG_SET_PARAMETER_FUNC setFunc,
+	const str_type::string& situation)
 {
-	CGparameter param = SeekParameter(name, m_mParam);
+	GetConstantStats().setCalls++;
+	CONSTANT_SLOT* slot = GetSlot(handle);
 
-	if (!param)
+	if (!slot)
 	{
 		str_type::string message = GS_L("D3D9CgShader::Set(*) invalid parameter: ");
-		message += name;
+		message += GetConstantName(handle);
 		ShowMessage(message);
 		return false;
 	}
 
-	cgSetParameter2fv(param, (float*)&v);
-	if (CheckForError(GS_L("D3D9CgShader::SetConstant2F setting parameter"), m_shaderName))
+	// the Cg runtime keeps the value around, so there's nothing to do if it hasn't changed
+	if (!slot->shadow.Update(data, numFloats))
+		return true;
+
+	setFunc(slot->param, data);
+	GetConstantStats().uploads++;
+	GetConstantStats().bytesUploaded += numFloats * sizeof(float);
+
+	if (CheckForError(situation, m_shaderName))
+	{
+		slot->shadow.Invalidate();
 		return false;
+	}
 	return true;
 }
 
-bool D3D9CgShader::SetConstant(const str_type::string& name, const float value)
+bool D3D9CgShader::ConstantExist(const CONSTANT_HANDLE handle)
 {
-	CGparameter param = SeekParameter(name, m_mParam);
-	
-	if (!param)
-	{
-		str_type::string message = GS_L("D3D9CgShader::Set(*) invalid parameter: ");
-		message += name;
-		ShowMessage(message);
-		return false;
-	}
+	return (GetSlot(handle) != 0);
+}
 
-	cgSetParameter1f(param, value);
-	if (CheckForError(GS_L("D3D9CgShader::SetConstant1F setting parameter"), m_shaderName))
-		return false;
-	return true;
+bool D3D9CgShader::SetConstant(const CONSTANT_HANDLE handle, const Color& dw)
+{
+	Vector4 v;
+	v.SetColor(dw);
+	return SetConstant(handle, v);
+}
+
+bool D3D9CgShader::SetConstant(const CONSTANT_HANDLE handle, const Vector4 &v)
+{
+	return SetConstantValue(handle, &v.x, 4, cgSetParameter4fv, GS_L("D3D9CgShader::SetConstant4F setting parameter"));
+}
+
+bool D3D9CgShader::SetConstant(const CONSTANT_HANDLE handle, const Vector3 &v)
+{
+	return SetConstantValue(handle, &v.x, 3, cgSetParameter3fv, GS_L("D3D9CgShader::SetConstant3F setting parameter"));
+}
+
+bool D3D9CgShader::SetConstant(const CONSTANT_HANDLE handle, const Vector2 &v)
+{
+	return SetConstantValue(handle, &v.x, 2, cgSetParameter2fv, GS_L("D3D9CgShader::SetConstant2F setting parameter"));
+}
+
+bool D3D9CgShader::SetConstant(const CONSTANT_HANDLE handle, const float x)
+{
+	return SetConstantValue(handle, &x, 1, cgSetParameter1fv, GS_L("D3D9CgShader::SetConstant1F setting parameter"));
+}
+
+bool D3D9CgShader::SetMatrixConstant(const CONSTANT_HANDLE handle, const Matrix4x4 &matrix)
+{
+	return SetConstantValue(handle, matrix.e, 16, cgSetMatrixParameterfr, GS_L("D3D9CgShader::SetMatrixConstantF setting parameter"));
 }
 
 bool D3D9CgShader::SetConstant(const str_type::string& name, const int n)
 {
+	GetConstantStats().setCalls++;
 	CGparameter param = SeekParameter(name, m_mParam);
 	
 	if (!param)
@@ -262,6 +305,8 @@ bool D3D9CgShader::SetConstant(const str_type::string& name, const int n)
 	}
 
 	cgSetParameter1i(param, n);
+	GetConstantStats().uploads++;
+	GetConstantStats().bytesUploaded += sizeof(int);
 	if (CheckForError(GS_L("D3D9CgShader::SetConstant1I setting parameter"), m_shaderName))
 		return false;
 	return true;
@@ -269,24 +314,12 @@ bool D3D9CgShader::SetConstant(const str_type::string& name, const int n)
 
 bool D3D9CgShader::SetMatrixConstant(const str_type::string& name, const Matrix4x4 &matrix)
 {
-	CGparameter param = SeekParameter(name, m_mParam);
-
-	if (!param)
-	{
-		str_type::string message = GS_L("D3D9CgShader::Set(*) invalid parameter: ");
-		message += name;
-		ShowMessage(message);
-		return false;
-	}
-
-	cgSetMatrixParameterfr(param, (float*)&matrix);
-	if (CheckForError(GS_L("D3D9CgShader::SetMatrixConstantF setting parameter"), m_shaderName))
-		return false;
-	return true;
+	return SetMatrixConstant(LookUpHandle(name), matrix);
 }
 
 bool D3D9CgShader::SetConstantArray(const str_type::string& name, unsigned int nElements, const boost::shared_array<const math::Vector2>& v)
 {
+	GetConstantStats().setCalls++;
 	CGparameter param = SeekParameter(name, m_mParam);
 
 	if (!param)
@@ -299,6 +332,8 @@ bool D3D9CgShader::SetConstantArray(const str_type::string& name, unsigned int n
 
 	//cgSetArraySize(param, nElements);
 	cgD3D9SetUniformArray(param, 0, (DWORD)nElements, &(v.get()->x));
+	GetConstantStats().uploads++;
+	GetConstantStats().bytesUploaded += nElements * sizeof(math::Vector2);
 	if (CheckForError(GS_L("D3D9CgShader::SetConstantArrayF setting parameter"), m_shaderName))
 		return false;
 	return true;
@@ -349,6 +384,7 @@ bool D3D9CgShader::SetTexture(const str_type::string& name, TextureWeakPtr pText
 
 bool D3D9CgShader::SetupParameters()
 {
+	m_slots.clear();
 	CGparameter param = cgGetFirstParameter(m_cgProgram, CG_GLOBAL);
 	while (param)
 	{
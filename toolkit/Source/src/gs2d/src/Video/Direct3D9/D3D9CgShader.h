@@ -33,6 +33,7 @@
 #include <Cg/cg.h>
 #include <Cg/cgD3D9.h>
 #include <map>
+#include <vector>
 
 namespace gs2d {
 
@@ -68,6 +69,23 @@ class D3D9CgShader : public Shader
 	CGprofile m_cgLatestProfile;
 	std::map<str_type::string, CGparameter> m_mParam;
 
+	struct CONSTANT_SLOT
+	{
+		CONSTANT_SLOT() : resolved(false), param(0) {}
+		bool resolved;
+		CGparameter param;
+		CONSTANT_SHADOW shadow;
+	};
+
+	/// Per-handle parameter cache, indexed by CONSTANT_HANDLE and filled on first use
+	std::vector<CONSTANT_SLOT> m_slots;
+
+	typedef void (CGENTRY *CG_SET_PARAMETER_FUNC)(CGparameter, const float*);
+
+	CONSTANT_SLOT* GetSlot(const CONSTANT_HANDLE handle);
+	bool SetConstantValue(const CONSTANT_HANDLE handle, const float* data, const unsigned int numFloats,
+		CG_SET_PARAMETER_FUNC setFunc, const str_type::string& situation);
+
 	bool SetupParameters();
 	SHADER_FOCUS m_focus;
 	SHADER_PROFILE m_profile;
@@ -94,6 +112,14 @@ public:
 	bool SetMatrixConstant(const str_type::string& name, const math::Matrix4x4 &matrix);
 	bool SetTexture(const str_type::string& name, TextureWeakPtr pTexture);
 
+	bool ConstantExist(const CONSTANT_HANDLE handle);
+	bool SetConstant(const CONSTANT_HANDLE handle, const Color& dw);
+	bool SetConstant(const CONSTANT_HANDLE handle, const math::Vector4 &v);
+	bool SetConstant(const CONSTANT_HANDLE handle, const math::Vector3 &v);
+	bool SetConstant(const CONSTANT_HANDLE handle, const math::Vector2 &v);
+	bool SetConstant(const CONSTANT_HANDLE handle, const float x);
+	bool SetMatrixConstant(const CONSTANT_HANDLE handle, const math::Matrix4x4 &matrix);
+
 	bool CompileShader();
 	bool SetShader();
 	SHADER_FOCUS GetShaderFocus() const;
@@ -382,6 +382,24 @@ bool D3D9Sprite::DrawShaped(
 	const math::Vector4& color3,
 	const float angle)
 {
+	static const Shader::CONSTANT_HANDLE ROTATION_MATRIX_HANDLE = Shader::GetConstantHandle(GS_L("rotationMatrix"));
+	static const Shader::CONSTANT_HANDLE SIZE_HANDLE = Shader::GetConstantHandle(GS_L("size"));
+	static const Shader::CONSTANT_HANDLE ENTITY_POS_HANDLE = Shader::GetConstantHandle(GS_L("entityPos"));
+	static const Shader::CONSTANT_HANDLE CENTER_HANDLE = Shader::GetConstantHandle(GS_L("center"));
+	static const Shader::CONSTANT_HANDLE FLIP_MUL_HANDLE = Shader::GetConstantHandle(GS_L("flipMul"));
+	static const Shader::CONSTANT_HANDLE FLIP_ADD_HANDLE = Shader::GetConstantHandle(GS_L("flipAdd"));
+	static const Shader::CONSTANT_HANDLE BITMAP_SIZE_HANDLE = Shader::GetConstantHandle(GS_L("bitmapSize"));
+	static const Shader::CONSTANT_HANDLE SCROLL_HANDLE = Shader::GetConstantHandle(GS_L("scroll"));
+	static const Shader::CONSTANT_HANDLE MULTIPLY_HANDLE = Shader::GetConstantHandle(GS_L("multiply"));
+	static const Shader::CONSTANT_HANDLE CAMERA_POS_HANDLE = Shader::GetConstantHandle(GS_L("cameraPos"));
+	static const Shader::CONSTANT_HANDLE RECT_SIZE_HANDLE = Shader::GetConstantHandle(GS_L("rectSize"));
+	static const Shader::CONSTANT_HANDLE RECT_POS_HANDLE = Shader::GetConstantHandle(GS_L("rectPos"));
+	static const Shader::CONSTANT_HANDLE COLOR0_HANDLE = Shader::GetConstantHandle(GS_L("color0"));
+	static const Shader::CONSTANT_HANDLE COLOR1_HANDLE = Shader::GetConstantHandle(GS_L("color1"));
+	static const Shader::CONSTANT_HANDLE COLOR2_HANDLE = Shader::GetConstantHandle(GS_L("color2"));
+	static const Shader::CONSTANT_HANDLE COLOR3_HANDLE = Shader::GetConstantHandle(GS_L("color3"));
+	static const Shader::CONSTANT_HANDLE DEPTH_HANDLE = Shader::GetConstantHandle(GS_L("depth"));
+
 	if (v2Size == Vector2(0,0))
 	{
 		return true;
@@ -400,7 +418,7 @@ bool D3D9Sprite::DrawShaped(
 	Matrix4x4 mRot;
 	if (angle != 0.0f)
 		mRot = RotateZ(DegreeToRadian(angle));
-	pCurrentVS->SetMatrixConstant(GS_L("rotationMatrix"), mRot);
+	pCurrentVS->SetMatrixConstant(ROTATION_MATRIX_HANDLE, mRot);
 
 	// rounds up the final position to avoid alpha distortion
 	Vector2 v2FinalPos;
@@ -417,37 +435,37 @@ bool D3D9Sprite::DrawShaped(
 	// subtract 0.5 to align pixel-texel
 	v2FinalPos -= math::constant::HALF_VECTOR2;
 
-	pCurrentVS->SetConstant(GS_L("size"), v2Size);
-	pCurrentVS->SetConstant(GS_L("entityPos"), v2FinalPos);
-	pCurrentVS->SetConstant(GS_L("center"), v2Center);
-	pCurrentVS->SetConstant(GS_L("flipMul"), flipMul);
-	pCurrentVS->SetConstant(GS_L("flipAdd"), flipAdd);
-	pCurrentVS->SetConstant(GS_L("bitmapSize"), GetBitmapSizeF());
-	pCurrentVS->SetConstant(GS_L("scroll"), GetScroll());
-	pCurrentVS->SetConstant(GS_L("multiply"), GetMultiply());
+	pCurrentVS->SetConstant(SIZE_HANDLE, v2Size);
+	pCurrentVS->SetConstant(ENTITY_POS_HANDLE, v2FinalPos);
+	pCurrentVS->SetConstant(CENTER_HANDLE, v2Center);
+	pCurrentVS->SetConstant(FLIP_MUL_HANDLE, flipMul);
+	pCurrentVS->SetConstant(FLIP_ADD_HANDLE, flipAdd);
+	pCurrentVS->SetConstant(BITMAP_SIZE_HANDLE, GetBitmapSizeF());
+	pCurrentVS->SetConstant(SCROLL_HANDLE, GetScroll());
+	pCurrentVS->SetConstant(MULTIPLY_HANDLE, GetMultiply());
 
-	const bool setCameraPos = pCurrentVS->ConstantExist(GS_L("cameraPos"));
+	const bool setCameraPos = pCurrentVS->ConstantExist(CAMERA_POS_HANDLE);
 	if (setCameraPos)
-		pCurrentVS->SetConstant(GS_L("cameraPos"), video->GetCameraPos());
+		pCurrentVS->SetConstant(CAMERA_POS_HANDLE, video->GetCameraPos());
 
 	if (m_rect.size.x == 0 || m_rect.size.y == 0)
 	{
-		pCurrentVS->SetConstant(GS_L("rectSize"), GetBitmapSizeF());
-		pCurrentVS->SetConstant(GS_L("rectPos"), 0, 0);
+		pCurrentVS->SetConstant(RECT_SIZE_HANDLE, GetBitmapSizeF());
+		pCurrentVS->SetConstant(RECT_POS_HANDLE, Vector2(0, 0));
 	}
 	else
 	{
-		pCurrentVS->SetConstant(GS_L("rectSize"), m_rect.size);
-		pCurrentVS->SetConstant(GS_L("rectPos"), m_rect.pos);
+		pCurrentVS->SetConstant(RECT_SIZE_HANDLE, m_rect.size);
+		pCurrentVS->SetConstant(RECT_POS_HANDLE, m_rect.pos);
 	}
 
-	pCurrentVS->SetConstant(GS_L("color0"), color0);
-	pCurrentVS->SetConstant(GS_L("color1"), color1);
-	pCurrentVS->SetConstant(GS_L("color2"), color2);
-	pCurrentVS->SetConstant(GS_L("color3"), color3);
+	pCurrentVS->SetConstant(COLOR0_HANDLE, color0);
+	pCurrentVS->SetConstant(COLOR1_HANDLE, color1);
+	pCurrentVS->SetConstant(COLOR2_HANDLE, color2);
+	pCurrentVS->SetConstant(COLOR3_HANDLE, color3);
 
-	if (pCurrentVS->ConstantExist(GS_L("depth")))
-		pCurrentVS->SetConstant(GS_L("depth"), video->GetSpriteDepth());
+	if (pCurrentVS->ConstantExist(DEPTH_HANDLE))
+		pCurrentVS->SetConstant(DEPTH_HANDLE, video->GetSpriteDepth());
 
 	pCurrentVS->SetShader();
 
@@ -475,10 +493,12 @@ bool D3D9Sprite::DrawShaped(
 
 void D3D9Sprite::BeginFastRendering()
 {
+	static const Shader::CONSTANT_HANDLE BITMAP_SIZE_HANDLE = Shader::GetConstantHandle(GS_L("bitmapSize"));
+
 	Video* video = m_video.lock().get();
 	video->SetVertexShader(video->GetFontShader());
 	ShaderPtr pCurrentVS = video->GetVertexShader();
-	pCurrentVS->SetConstant(GS_L("bitmapSize"), GetBitmapSizeF());
+	pCurrentVS->SetConstant(BITMAP_SIZE_HANDLE, GetBitmapSizeF());
 
 	// apply textures according to the rendering mode (pixel shaded or not)
 	ShaderPtr pCurrentPS = video->GetPixelShader();
@@ -502,8 +522,57 @@ void D3D9Sprite::EndFastRendering()
 	m_pDevice->SetVertexShader(NULL);
 }
 
+bool D3D9Sprite::DrawTriangles(const SCREEN_VERTEX* vertices, const unsigned int numVertices)
+{
+	if (numVertices < 3)
+	{
+		return true;
+	}
+
+	m_screenVertices.resize(numVertices);
+	for (unsigned int t = 0; t < numVertices; t++)
+	{
+		D3D9VideoInfo::VERTEX& vertex = m_screenVertices[t];
+		// subtract 0.5 to align pixel-texel, as DrawShaped does
+		vertex.pos.x = vertices[t].pos.x - 0.5f;
+		vertex.pos.y = vertices[t].pos.y - 0.5f;
+		vertex.pos.z = vertices[t].pos.z;
+		vertex.rhw = 1.0f;
+		vertex.color = vertices[t].color;
+		vertex.t0 = vertices[t].texCoord;
+	}
+
+	// pre-transformed vertices skip the vertex shader
+	m_pDevice->SetVertexShader(NULL);
+	m_pDevice->SetFVF(D3DFVF_XYZRHW | D3DFVF_DIFFUSE | D3DFVF_TEX1);
+
+	ShaderPtr pCurrentPS = m_video.lock()->GetPixelShader();
+	if (!pCurrentPS)
+	{
+		m_pDevice->SetTexture(0, m_pTexture);
+	}
+	else
+	{
+		pCurrentPS->SetShader();
+		pCurrentPS->SetTexture(GS_L("diffuse"), GetTexture());
+	}
+
+	if (FAILED(m_pDevice->DrawPrimitiveUP(D3DPT_TRIANGLELIST, numVertices / 3, &m_screenVertices[0], sizeof(D3D9VideoInfo::VERTEX))))
+	{
+		m_video.lock()->Message(GS_L("Rendering failed - D3D9Sprite::DrawTriangles"));
+		return false;
+	}
+	return true;
+}
+
 bool D3D9Sprite::DrawShapedFast(const Vector2 &v2Pos, const Vector2 &v2Size, const math::Vector4& color)
 {
+	static const Shader::CONSTANT_HANDLE SIZE_HANDLE = Shader::GetConstantHandle(GS_L("size"));
+	static const Shader::CONSTANT_HANDLE ENTITY_POS_HANDLE = Shader::GetConstantHandle(GS_L("entityPos"));
+	static const Shader::CONSTANT_HANDLE COLOR0_HANDLE = Shader::GetConstantHandle(GS_L("color0"));
+	static const Shader::CONSTANT_HANDLE RECT_SIZE_HANDLE = Shader::GetConstantHandle(GS_L("rectSize"));
+	static const Shader::CONSTANT_HANDLE RECT_POS_HANDLE = Shader::GetConstantHandle(GS_L("rectPos"));
+
 	if (v2Size == Vector2(0,0))
 	{
 		return true;
@@ -527,19 +596,19 @@ bool D3D9Sprite::DrawShapedFast(const Vector2 &v2Pos, const Vector2 &v2Size, con
 	// subtract 0.5 to align pixel-texel
 	v2FinalPos -= math::constant::HALF_VECTOR2;
 
-	pCurrentVS->SetConstant(GS_L("size"), v2Size);
-	pCurrentVS->SetConstant(GS_L("entityPos"), v2FinalPos);
-	pCurrentVS->SetConstant(GS_L("color0"), color);
+	pCurrentVS->SetConstant(SIZE_HANDLE, v2Size);
+	pCurrentVS->SetConstant(ENTITY_POS_HANDLE, v2FinalPos);
+	pCurrentVS->SetConstant(COLOR0_HANDLE, color);
 
 	if (m_rect.size.x == 0 || m_rect.size.y == 0)
 	{
-		pCurrentVS->SetConstant(GS_L("rectSize"), GetBitmapSizeF());
-		pCurrentVS->SetConstant(GS_L("rectPos"), 0, 0);
+		pCurrentVS->SetConstant(RECT_SIZE_HANDLE, GetBitmapSizeF());
+		pCurrentVS->SetConstant(RECT_POS_HANDLE, Vector2(0, 0));
 	}
 	else
 	{
-		pCurrentVS->SetConstant(GS_L("rectSize"), m_rect.size);
-		pCurrentVS->SetConstant(GS_L("rectPos"), m_rect.pos);
+		pCurrentVS->SetConstant(RECT_SIZE_HANDLE, m_rect.size);
+		pCurrentVS->SetConstant(RECT_POS_HANDLE, m_rect.pos);
 	}
 
 	pCurrentVS->SetShader();
@@ -63,6 +63,7 @@ class D3D9Sprite : public Sprite
 	IDirect3DTexture9 *m_pTexture;
 	IDirect3DDevice9 *m_pDevice;
 	D3D9VideoInfoPtr m_pVideoInfo;
+	std::vector<D3D9VideoInfo::VERTEX> m_screenVertices;
 
 	void Init();
 	bool GetInternalData();
@@ -101,6 +102,8 @@ public:
 	void BeginFastRendering();
 	void EndFastRendering();
 
+	bool DrawTriangles(const SCREEN_VERTEX* vertices, const unsigned int numVertices);
+
 	TextureWeakPtr GetTexture();
 
 	Texture::PROFILE GetProfile() const;
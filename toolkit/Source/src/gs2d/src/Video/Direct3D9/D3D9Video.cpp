@@ -89,6 +89,9 @@ void ShowMessage(str_type::stringstream &stream, const GS_MESSAGE_TYPE type)
 /// Set all view matrices to the shaders
 void SetupShaderViewData(IDirect3DDevice9 *pDevice, ShaderPtr pCurrentVS, ShaderPtr pRectVS, ShaderPtr pFontVS)
 {
+	static const Shader::CONSTANT_HANDLE VIEW_MATRIX_HANDLE = Shader::GetConstantHandle(GS_L("viewMatrix"));
+	static const Shader::CONSTANT_HANDLE SCREEN_SIZE_HANDLE = Shader::GetConstantHandle(GS_L("screenSize"));
+
 	D3DSURFACE_DESC desc;
 	IDirect3DSurface9 *pSurface = NULL;
 
@@ -100,14 +103,14 @@ void SetupShaderViewData(IDirect3DDevice9 *pDevice, ShaderPtr pCurrentVS, Shader
 	Matrix4x4 ortho;
 	Orthogonal(ortho, width, height, D3D9Video::ZNEAR, D3D9Video::ZFAR);
 
-	pCurrentVS->SetMatrixConstant(GS_L("viewMatrix"), ortho);
-	pCurrentVS->SetConstant(GS_L("screenSize"), Vector2(width, height));
+	pCurrentVS->SetMatrixConstant(VIEW_MATRIX_HANDLE, ortho);
+	pCurrentVS->SetConstant(SCREEN_SIZE_HANDLE, Vector2(width, height));
 
-	pRectVS->SetMatrixConstant(GS_L("viewMatrix"), ortho);
-	pRectVS->SetConstant(GS_L("screenSize"), Vector2(width, height));
+	pRectVS->SetMatrixConstant(VIEW_MATRIX_HANDLE, ortho);
+	pRectVS->SetConstant(SCREEN_SIZE_HANDLE, Vector2(width, height));
 
-	pFontVS->SetMatrixConstant(GS_L("viewMatrix"), ortho);
-	pFontVS->SetConstant(GS_L("screenSize"), Vector2(width, height));
+	pFontVS->SetMatrixConstant(VIEW_MATRIX_HANDLE, ortho);
+	pFontVS->SetConstant(SCREEN_SIZE_HANDLE, Vector2(width, height));
 	pSurface->Release();
 }
 
@@ -1255,6 +1258,15 @@ bool D3D9Video::DrawRectangle(const Vector2 &v2Pos, const Vector2 &v2Size,
 						const Color& color0, const Color& color1, const Color& color2, const Color& color3,
 						const float angle, const Sprite::ENTITY_ORIGIN origin)
 {
+	static const Shader::CONSTANT_HANDLE ROTATION_MATRIX_HANDLE = Shader::GetConstantHandle(GS_L("rotationMatrix"));
+	static const Shader::CONSTANT_HANDLE SIZE_HANDLE = Shader::GetConstantHandle(GS_L("size"));
+	static const Shader::CONSTANT_HANDLE ENTITY_POS_HANDLE = Shader::GetConstantHandle(GS_L("entityPos"));
+	static const Shader::CONSTANT_HANDLE CENTER_HANDLE = Shader::GetConstantHandle(GS_L("center"));
+	static const Shader::CONSTANT_HANDLE COLOR0_HANDLE = Shader::GetConstantHandle(GS_L("color0"));
+	static const Shader::CONSTANT_HANDLE COLOR1_HANDLE = Shader::GetConstantHandle(GS_L("color1"));
+	static const Shader::CONSTANT_HANDLE COLOR2_HANDLE = Shader::GetConstantHandle(GS_L("color2"));
+	static const Shader::CONSTANT_HANDLE COLOR3_HANDLE = Shader::GetConstantHandle(GS_L("color3"));
+
 	if (v2Size == Vector2(0,0))
 	{
 		return true;
@@ -1288,14 +1300,14 @@ bool D3D9Video::DrawRectangle(const Vector2 &v2Pos, const Vector2 &v2Size,
 	Matrix4x4 mRot;
 	if (angle != 0.0f)
 		mRot = RotateZ(DegreeToRadian(angle));
-	m_rectVS->SetMatrixConstant(GS_L("rotationMatrix"), mRot);
-	m_rectVS->SetConstant(GS_L("size"), v2Size);
-	m_rectVS->SetConstant(GS_L("entityPos"), v2Pos);
-	m_rectVS->SetConstant(GS_L("center"), v2Center);
-	m_rectVS->SetConstant(GS_L("color0"), color0);
-	m_rectVS->SetConstant(GS_L("color1"), color1);
-	m_rectVS->SetConstant(GS_L("color2"), color2);
-	m_rectVS->SetConstant(GS_L("color3"), color3);
+	m_rectVS->SetMatrixConstant(ROTATION_MATRIX_HANDLE, mRot);
+	m_rectVS->SetConstant(SIZE_HANDLE, v2Size);
+	m_rectVS->SetConstant(ENTITY_POS_HANDLE, v2Pos);
+	m_rectVS->SetConstant(CENTER_HANDLE, v2Center);
+	m_rectVS->SetConstant(COLOR0_HANDLE, color0);
+	m_rectVS->SetConstant(COLOR1_HANDLE, color1);
+	m_rectVS->SetConstant(COLOR2_HANDLE, color2);
+	m_rectVS->SetConstant(COLOR3_HANDLE, color3);
 
 	ShaderPtr vertexShader = GetVertexShader(), pixelShader = GetPixelShader();
 
@@ -1350,6 +1362,8 @@ bool D3D9Video::StartApplication(const unsigned int width, const unsigned int he
 								const str_type::string& winTitle, const bool windowed,
 								const bool sync, const Texture::PIXEL_FORMAT pfBB, const bool maximizable)
 {
+	static const Shader::CONSTANT_HANDLE CAMERA_POS_HANDLE = Shader::GetConstantHandle(GS_L("cameraPos"));
+
 	if (!m_pD3D)
 	{
 		if ((m_pD3D = CreateAPI()) == NULL)
@@ -1564,7 +1578,7 @@ bool D3D9Video::StartApplication(const unsigned int width, const unsigned int he
 	m_rectVS = LoadShaderFromString(GS_L("rectShader"), gs2dglobal::defaultVSCode, Shader::SF_VERTEX, Shader::SP_MODEL_2, "rectangle");
 	m_fastVS = LoadShaderFromString(GS_L("fastShader"), gs2dglobal::fastSimpleVSCode, Shader::SF_VERTEX, Shader::SP_MODEL_2, "fast");
 	m_pCurrentVS = m_defaultVS;
-	m_defaultVS->SetConstant(GS_L("cameraPos"), GetCameraPos());
+	m_defaultVS->SetConstant(CAMERA_POS_HANDLE, GetCameraPos());
 
 	Orthogonal(m_videoInfo->m_orthoMatrix, GetScreenSizeF().x, GetScreenSizeF().y, ZNEAR, ZFAR);
 	SetBGColor(gs2d::constant::BLACK);
@@ -35,6 +35,7 @@ namespace gs2d {
 
 CGparameter SeekParameter(const std::string& name, std::map<std::string, CGparameter>& params)
 {
+	Shader::GetConstantStats().nameLookups++;
 	std::map<std::string, CGparameter>::iterator iter = params.find(name);
 	if (iter != params.end())
 		return iter->second;
@@ -236,6 +237,9 @@ bool GLCgShader::CreateCgProgram()
 	if (CheckForError("GS_SHADER::CompileShader loading the program", m_shaderName))
 		return false;
 
+	// the parameters of the previous program are gone after a recovery
+	m_params.clear();
+	m_slots.clear();
 	FillParameters(CG_GLOBAL);
 	FillParameters(CG_PROGRAM);
 	return true;
@@ -273,54 +277,113 @@ static bool ShowInvalidParameterWarning(const str_type::string& shaderName, cons
 	return false;
 }
 
-bool GLCgShader::SetConstant(const str_type::string& name, const math::Vector4 &v)
+static Shader::CONSTANT_HANDLE LookUpHandle(const str_type::string& name)
 {
-	CGparameter param = SeekParameter(name, m_params);
-	if (!param)
-		return ShowInvalidParameterWarning(m_shaderName, name);
+	Shader::GetConstantStats().nameLookups++;
+	return Shader::GetConstantHandle(name);
+}
 
-	cgSetParameter4fv(param, (float*)&v);
-	if (CheckForError("Shader::SetConstant4F setting parameter", m_shaderName))
-		return false;
-	return true;
+bool GLCgShader::SetConstant(const str_type::string& name, const math::Vector4 &v)
+{
+	return SetConstant(LookUpHandle(name), v);
 }
 
 bool GLCgShader::SetConstant(const str_type::string& name, const math::Vector3 &v)
 {
-	CGparameter param = SeekParameter(name, m_params);
-	if (!param)
-		return ShowInvalidParameterWarning(m_shaderName, name);
-
-	cgSetParameter3fv(param, (float*)&v);
-	if (CheckForError("Shader::SetConstant3F setting parameter", m_shaderName))
-		return false;
-	return true;
+	return SetConstant(LookUpHandle(name), v);
 }
 
 bool GLCgShader::SetConstant(const str_type::string& name, const math::Vector2 &v)
 {
-	CGparameter param = SeekParameter(name, m_params);
-	if (!param)
-		return ShowInvalidParameterWarning(m_shaderName, name);
-
-	cgSetParameter2fv(param, (float*)&v);
-	if (CheckForError("Shader::SetConstant2F setting parameter", m_shaderName))
-		return false;
-	return true;
+	return SetConstant(LookUpHandle(name), v);
 }
 
 bool GLCgShader::SetConstant(const str_type::string& name, const float x)
 {
-	CGparameter param = SeekParameter(name, m_params);
-	if (!param)
-		return ShowInvalidParameterWarning(m_shaderName, name);
+	return SetConstant(LookUpHandle(name), x);
+}
+
+GLCgShader::CONSTANT_SLOT* GLCgShader::GetSlot(const CONSTANT_HANDLE handle)
+{
+	if (handle >= m_slots.size())
+	{
+		m_slots.resize(handle + 1);
+	}
+
+	CONSTANT_SLOT& slot = m_slots[handle];
+	if (!slot.resolved)
+	{
+		slot.param = SeekParameter(GetConstantName(handle), m_params);
+		slot.resolved = true;
+	}
+	return (slot.param) ? &slot : 0;
+}
+
+bool GLCgShader::SetConstantValue(
+	const CONSTANT_HANDLE handle,
+	const float* data,
+	const unsigned int numFloats,
+	CG_SET_PARAMETER_FUNC setFunc,
+	const std::string& situation)
+{
+	GetConstantStats().setCalls++;
+	CONSTANT_SLOT* slot = GetSlot(handle);
+	if (!slot)
+		return ShowInvalidParameterWarning(m_shaderName, GetConstantName(handle));
 
-	cgSetParameter1f(param, x);
-	if (CheckForError("Shader::SetConstant1F setting parameter", m_shaderName))
+	// the Cg runtime keeps the value around, so there's nothing to do if it hasn't changed
+	if (!slot->shadow.Update(data, numFloats))
+		return true;
+
+	setFunc(slot->param, data);
+	GetConstantStats().uploads++;
+	GetConstantStats().bytesUploaded += numFloats * sizeof(float);
+
+	if (CheckForError(situation, m_shaderName))
+	{
+		slot->shadow.Invalidate();
 		return false;
+	}
 	return true;
 }
 
+bool GLCgShader::ConstantExist(const CONSTANT_HANDLE handle)
+{
+	return (GetSlot(handle) != 0);
+}
+
+bool GLCgShader::SetConstant(const CONSTANT_HANDLE handle, const Color& dw)
+{
+	math::Vector4 v;
+	v.SetColor(dw);
+	return SetConstant(handle, v);
+}
+
+bool GLCgShader::SetConstant(const CONSTANT_HANDLE handle, const math::Vector4 &v)
+{
+	return SetConstantValue(handle, &v.x, 4, cgSetParameter4fv, "Shader::SetConstant4F setting parameter");
+}
+
+bool GLCgShader::SetConstant(const CONSTANT_HANDLE handle, const math::Vector3 &v)
+{
+	return SetConstantValue(handle, &v.x, 3, cgSetParameter3fv, "Shader::SetConstant3F setting parameter");
+}
+
+bool GLCgShader::SetConstant(const CONSTANT_HANDLE handle, const math::Vector2 &v)
+{
+	return SetConstantValue(handle, &v.x, 2, cgSetParameter2fv, "Shader::SetConstant2F setting parameter");
+}
+
+bool GLCgShader::SetConstant(const CONSTANT_HANDLE handle, const float x)
+{
+	return SetConstantValue(handle, &x, 1, cgSetParameter1fv, "Shader::SetConstant1F setting parameter");
+}
+
+bool GLCgShader::SetMatrixConstant(const CONSTANT_HANDLE handle, const math::Matrix4x4 &matrix)
+{
+	return SetConstantValue(handle, matrix.e, 16, cgSetMatrixParameterfr, "Shader::SetMatrixConstant setting parameter");
+}
+
 bool GLCgShader::SetConstant(const str_type::string& name, const Color& dw)
 {
 	math::Vector4 v;
@@ -345,11 +408,14 @@ bool GLCgShader::SetConstant(const str_type::string& name, const float x, const
 
 bool GLCgShader::SetConstant(const str_type::string& name, const int n)
 {
+	GetConstantStats().setCalls++;
 	CGparameter param = SeekParameter(name, m_params);
 	if (!param)
 		return ShowInvalidParameterWarning(m_shaderName, name);
 
 	cgSetParameter1i(param, n);
+	GetConstantStats().uploads++;
+	GetConstantStats().bytesUploaded += sizeof(int);
 	if (CheckForError("Shader::SetConstant1I setting parameter", m_shaderName))
 		return false;
 	return true;
@@ -357,23 +423,19 @@ bool GLCgShader::SetConstant(const str_type::string& name, const int n)
 
 bool GLCgShader::SetMatrixConstant(const str_type::string& name, const math::Matrix4x4 &matrix)
 {
-	CGparameter param = SeekParameter(name, m_params);
-	if (!param)
-		return ShowInvalidParameterWarning(m_shaderName, name);
-
-	cgSetMatrixParameterfr(param, (float*)&matrix);
-	if (CheckForError("Shader::SetMatrixConstant setting parameter", m_shaderName))
-		return false;
-	return true;
+	return SetMatrixConstant(LookUpHandle(name), matrix);
 }
 
 bool GLCgShader::SetConstantArray(const str_type::string& name, unsigned int nElements, const boost::shared_array<const math::Vector2>& v)
 {
+	GetConstantStats().setCalls++;
 	CGparameter param = SeekParameter(name, m_params);
 	if (!param)
 		return ShowInvalidParameterWarning(m_shaderName, name);
 
 	cgGLSetParameterArray2f(param, 0, (long)nElements, (float*)v.get());
+	GetConstantStats().uploads++;
+	GetConstantStats().bytesUploaded += nElements * sizeof(math::Vector2);
 	if (CheckForError("Shader::SetConstantArrayF setting parameter", m_shaderName))
 		return false;
 	return true;
@@ -30,6 +30,7 @@
 
 #include <map>
 #include <list>
+#include <vector>
 
 #include "../../../Utilities/RecoverableResource.h"
 
@@ -40,6 +41,23 @@ class GLVideo;
 class GLCgShader : public Shader, RecoverableResource
 {
 	std::map<std::string, CGparameter> m_params;
+
+	struct CONSTANT_SLOT
+	{
+		CONSTANT_SLOT() : resolved(false), param(NULL) {}
+		bool resolved;
+		CGparameter param;
+		CONSTANT_SHADOW shadow;
+	};
+
+	/// Per-handle parameter cache, indexed by CONSTANT_HANDLE and filled on first use
+	std::vector<CONSTANT_SLOT> m_slots;
+
+	typedef void (CGENTRY *CG_SET_PARAMETER_FUNC)(CGparameter, const float*);
+
+	CONSTANT_SLOT* GetSlot(const CONSTANT_HANDLE handle);
+	bool SetConstantValue(const CONSTANT_HANDLE handle, const float* data, const unsigned int numFloats,
+		CG_SET_PARAMETER_FUNC setFunc, const std::string& situation);
 	CGprogram m_cgProgam;
 	CGprofile m_cgProfile;
 
@@ -100,6 +118,14 @@ public:
 	bool SetMatrixConstant(const str_type::string& name, const math::Matrix4x4 &matrix);
 	bool SetTexture(const str_type::string& name, TextureWeakPtr pTexture);
 
+	bool ConstantExist(const CONSTANT_HANDLE handle);
+	bool SetConstant(const CONSTANT_HANDLE handle, const Color& dw);
+	bool SetConstant(const CONSTANT_HANDLE handle, const math::Vector4 &v);
+	bool SetConstant(const CONSTANT_HANDLE handle, const math::Vector3 &v);
+	bool SetConstant(const CONSTANT_HANDLE handle, const math::Vector2 &v);
+	bool SetConstant(const CONSTANT_HANDLE handle, const float x);
+	bool SetMatrixConstant(const CONSTANT_HANDLE handle, const math::Matrix4x4 &matrix);
+
 	bool SetShader();
 	SHADER_FOCUS GetShaderFocus() const;
 	SHADER_PROFILE GetShaderProfile() const;
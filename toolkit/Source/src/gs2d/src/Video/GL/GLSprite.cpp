@@ -120,6 +120,24 @@ bool GLSprite::DrawShaped(
 	const math::Vector4& color3,
 	const float angle)
 {
+	static const Shader::CONSTANT_HANDLE ROTATION_MATRIX_HANDLE = Shader::GetConstantHandle("rotationMatrix");
+	static const Shader::CONSTANT_HANDLE SIZE_HANDLE = Shader::GetConstantHandle("size");
+	static const Shader::CONSTANT_HANDLE ENTITY_POS_HANDLE = Shader::GetConstantHandle("entityPos");
+	static const Shader::CONSTANT_HANDLE CENTER_HANDLE = Shader::GetConstantHandle("center");
+	static const Shader::CONSTANT_HANDLE FLIP_MUL_HANDLE = Shader::GetConstantHandle("flipMul");
+	static const Shader::CONSTANT_HANDLE FLIP_ADD_HANDLE = Shader::GetConstantHandle("flipAdd");
+	static const Shader::CONSTANT_HANDLE BITMAP_SIZE_HANDLE = Shader::GetConstantHandle("bitmapSize");
+	static const Shader::CONSTANT_HANDLE SCROLL_HANDLE = Shader::GetConstantHandle("scroll");
+	static const Shader::CONSTANT_HANDLE MULTIPLY_HANDLE = Shader::GetConstantHandle("multiply");
+	static const Shader::CONSTANT_HANDLE CAMERA_POS_HANDLE = Shader::GetConstantHandle("cameraPos");
+	static const Shader::CONSTANT_HANDLE RECT_SIZE_HANDLE = Shader::GetConstantHandle("rectSize");
+	static const Shader::CONSTANT_HANDLE RECT_POS_HANDLE = Shader::GetConstantHandle("rectPos");
+	static const Shader::CONSTANT_HANDLE COLOR0_HANDLE = Shader::GetConstantHandle("color0");
+	static const Shader::CONSTANT_HANDLE COLOR1_HANDLE = Shader::GetConstantHandle("color1");
+	static const Shader::CONSTANT_HANDLE COLOR2_HANDLE = Shader::GetConstantHandle("color2");
+	static const Shader::CONSTANT_HANDLE COLOR3_HANDLE = Shader::GetConstantHandle("color3");
+	static const Shader::CONSTANT_HANDLE DEPTH_HANDLE = Shader::GetConstantHandle("depth");
+
 	if (v2Size == math::Vector2(0,0))
 	{
 		return true;
@@ -138,7 +156,7 @@ bool GLSprite::DrawShaped(
 	math::Matrix4x4 mRot;
 	if (angle != 0.0f)
 		mRot = math::RotateZ(math::DegreeToRadian(angle));
-	pCurrentVS->SetMatrixConstant("rotationMatrix", mRot);
+	pCurrentVS->SetMatrixConstant(ROTATION_MATRIX_HANDLE, mRot);
 
 	// rounds up the final position to avoid alpha distortion
 	math::Vector2 v2FinalPos;
@@ -152,37 +170,37 @@ bool GLSprite::DrawShaped(
 		v2FinalPos = v2Pos;
 	}
 
-	pCurrentVS->SetConstant("size", v2Size);
-	pCurrentVS->SetConstant("entityPos", v2FinalPos);
-	pCurrentVS->SetConstant("center", v2Center);
-	pCurrentVS->SetConstant("flipMul", flipMul);
-	pCurrentVS->SetConstant("flipAdd", flipAdd);
-	pCurrentVS->SetConstant("bitmapSize", GetBitmapSizeF());
-	pCurrentVS->SetConstant("scroll", GetScroll());
-	pCurrentVS->SetConstant("multiply", GetMultiply());
+	pCurrentVS->SetConstant(SIZE_HANDLE, v2Size);
+	pCurrentVS->SetConstant(ENTITY_POS_HANDLE, v2FinalPos);
+	pCurrentVS->SetConstant(CENTER_HANDLE, v2Center);
+	pCurrentVS->SetConstant(FLIP_MUL_HANDLE, flipMul);
+	pCurrentVS->SetConstant(FLIP_ADD_HANDLE, flipAdd);
+	pCurrentVS->SetConstant(BITMAP_SIZE_HANDLE, GetBitmapSizeF());
+	pCurrentVS->SetConstant(SCROLL_HANDLE, GetScroll());
+	pCurrentVS->SetConstant(MULTIPLY_HANDLE, GetMultiply());
 
-	const bool setCameraPos = pCurrentVS->ConstantExist("cameraPos");
+	const bool setCameraPos = pCurrentVS->ConstantExist(CAMERA_POS_HANDLE);
 	if (setCameraPos)
-		pCurrentVS->SetConstant("cameraPos", video->GetCameraPos());
+		pCurrentVS->SetConstant(CAMERA_POS_HANDLE, video->GetCameraPos());
 
 	if (m_rect.size.x == 0 || m_rect.size.y == 0)
 	{
-		pCurrentVS->SetConstant("rectSize", GetBitmapSizeF());
-		pCurrentVS->SetConstant("rectPos", 0, 0);
+		pCurrentVS->SetConstant(RECT_SIZE_HANDLE, GetBitmapSizeF());
+		pCurrentVS->SetConstant(RECT_POS_HANDLE, math::Vector2(0, 0));
 	}
 	else
 	{
-		pCurrentVS->SetConstant("rectSize", m_rect.size);
-		pCurrentVS->SetConstant("rectPos", m_rect.pos);
+		pCurrentVS->SetConstant(RECT_SIZE_HANDLE, m_rect.size);
+		pCurrentVS->SetConstant(RECT_POS_HANDLE, m_rect.pos);
 	}
 
-	pCurrentVS->SetConstant("color0", color0);
-	pCurrentVS->SetConstant("color1", color1);
-	pCurrentVS->SetConstant("color2", color2);
-	pCurrentVS->SetConstant("color3", color3);
+	pCurrentVS->SetConstant(COLOR0_HANDLE, color0);
+	pCurrentVS->SetConstant(COLOR1_HANDLE, color1);
+	pCurrentVS->SetConstant(COLOR2_HANDLE, color2);
+	pCurrentVS->SetConstant(COLOR3_HANDLE, color3);
 
-	if (pCurrentVS->ConstantExist("depth"))
-		pCurrentVS->SetConstant("depth", video->GetSpriteDepth());
+	if (pCurrentVS->ConstantExist(DEPTH_HANDLE))
+		pCurrentVS->SetConstant(DEPTH_HANDLE, video->GetSpriteDepth());
 
 	// apply textures according to the rendering mode (pixel shaded or not)
 	ShaderPtr pCurrentPS = video->GetPixelShader();
@@ -239,10 +257,12 @@ boost::any GLSprite::GetTextureObject()
 
 void GLSprite::BeginFastRendering()
 {
+	static const Shader::CONSTANT_HANDLE BITMAP_SIZE_HANDLE = Shader::GetConstantHandle("bitmapSize");
+
 	GLVideo* video = m_video.lock().get();
 	video->SetVertexShader(video->GetFontShader());
 	ShaderPtr pCurrentVS = video->GetVertexShader();
-	pCurrentVS->SetConstant("bitmapSize", GetBitmapSizeF());
+	pCurrentVS->SetConstant(BITMAP_SIZE_HANDLE, GetBitmapSizeF());
 
 	// apply textures according to the rendering mode (pixel shaded or not)
 	ShaderPtr pCurrentPS = video->GetPixelShader();
@@ -252,6 +272,12 @@ void GLSprite::BeginFastRendering()
 
 bool GLSprite::DrawShapedFast(const math::Vector2 &v2Pos, const math::Vector2 &v2Size, const math::Vector4& color)
 {
+	static const Shader::CONSTANT_HANDLE SIZE_HANDLE = Shader::GetConstantHandle("size");
+	static const Shader::CONSTANT_HANDLE ENTITY_POS_HANDLE = Shader::GetConstantHandle("entityPos");
+	static const Shader::CONSTANT_HANDLE COLOR0_HANDLE = Shader::GetConstantHandle("color0");
+	static const Shader::CONSTANT_HANDLE RECT_SIZE_HANDLE = Shader::GetConstantHandle("rectSize");
+	static const Shader::CONSTANT_HANDLE RECT_POS_HANDLE = Shader::GetConstantHandle("rectPos");
+
 	if (v2Size == math::Vector2(0,0))
 	{
 		return true;
@@ -272,19 +298,19 @@ bool GLSprite::DrawShapedFast(const math::Vector2 &v2Pos, const math::Vector2 &v
 		v2FinalPos = v2Pos;
 	}
 
-	pCurrentVS->SetConstant("size", v2Size);
-	pCurrentVS->SetConstant("entityPos", v2FinalPos);
-	pCurrentVS->SetConstant("color0", color);
+	pCurrentVS->SetConstant(SIZE_HANDLE, v2Size);
+	pCurrentVS->SetConstant(ENTITY_POS_HANDLE, v2FinalPos);
+	pCurrentVS->SetConstant(COLOR0_HANDLE, color);
 
 	if (m_rect.size.x == 0 || m_rect.size.y == 0)
 	{
-		pCurrentVS->SetConstant("rectSize", GetBitmapSizeF());
-		pCurrentVS->SetConstant("rectPos", 0, 0);
+		pCurrentVS->SetConstant(RECT_SIZE_HANDLE, GetBitmapSizeF());
+		pCurrentVS->SetConstant(RECT_POS_HANDLE, math::Vector2(0, 0));
 	}
 	else
 	{
-		pCurrentVS->SetConstant("rectSize", m_rect.size);
-		pCurrentVS->SetConstant("rectPos", m_rect.pos);
+		pCurrentVS->SetConstant(RECT_SIZE_HANDLE, m_rect.size);
+		pCurrentVS->SetConstant(RECT_POS_HANDLE, m_rect.pos);
 	}
 
 	pCurrentVS->SetShader();
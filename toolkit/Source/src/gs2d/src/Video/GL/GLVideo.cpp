@@ -118,8 +118,11 @@ void GLVideo::UpdateViewMatrix(const math::Vector2& screenSize, math::Matrix4x4&
 
 void GLVideo::UpdateShaderViewData(const ShaderPtr& shader, const math::Vector2& screenSize, const math::Matrix4x4& ortho)
 {
-	shader->SetConstant("screenSize", screenSize);
-	shader->SetMatrixConstant("viewMatrix", ortho);
+	static const Shader::CONSTANT_HANDLE SCREEN_SIZE_HANDLE = Shader::GetConstantHandle("screenSize");
+	static const Shader::CONSTANT_HANDLE VIEW_MATRIX_HANDLE = Shader::GetConstantHandle("viewMatrix");
+
+	shader->SetConstant(SCREEN_SIZE_HANDLE, screenSize);
+	shader->SetMatrixConstant(VIEW_MATRIX_HANDLE, ortho);
 }
 
 void GLVideo::Enable2DStates()
@@ -448,6 +451,15 @@ bool GLVideo::DrawRectangle(
 	const float angle,
 	const Sprite::ENTITY_ORIGIN origin)
 {
+	static const Shader::CONSTANT_HANDLE ROTATION_MATRIX_HANDLE = Shader::GetConstantHandle("rotationMatrix");
+	static const Shader::CONSTANT_HANDLE SIZE_HANDLE = Shader::GetConstantHandle("size");
+	static const Shader::CONSTANT_HANDLE ENTITY_POS_HANDLE = Shader::GetConstantHandle("entityPos");
+	static const Shader::CONSTANT_HANDLE CENTER_HANDLE = Shader::GetConstantHandle("center");
+	static const Shader::CONSTANT_HANDLE COLOR0_HANDLE = Shader::GetConstantHandle("color0");
+	static const Shader::CONSTANT_HANDLE COLOR1_HANDLE = Shader::GetConstantHandle("color1");
+	static const Shader::CONSTANT_HANDLE COLOR2_HANDLE = Shader::GetConstantHandle("color2");
+	static const Shader::CONSTANT_HANDLE COLOR3_HANDLE = Shader::GetConstantHandle("color3");
+
 	if (v2Size == math::Vector2(0,0))
 	{
 		return true;
@@ -482,14 +494,14 @@ bool GLVideo::DrawRectangle(
 	math::Matrix4x4 mRot;
 	if (angle != 0.0f)
 		mRot = math::RotateZ(math::DegreeToRadian(angle));
-	m_rectVS->SetMatrixConstant("rotationMatrix", mRot);
-	m_rectVS->SetConstant("size", v2Size);
-	m_rectVS->SetConstant("entityPos", v2Pos);
-	m_rectVS->SetConstant("center", v2Center);
-	m_rectVS->SetConstant("color0", color0);
-	m_rectVS->SetConstant("color1", color1);
-	m_rectVS->SetConstant("color2", color2);
-	m_rectVS->SetConstant("color3", color3);
+	m_rectVS->SetMatrixConstant(ROTATION_MATRIX_HANDLE, mRot);
+	m_rectVS->SetConstant(SIZE_HANDLE, v2Size);
+	m_rectVS->SetConstant(ENTITY_POS_HANDLE, v2Pos);
+	m_rectVS->SetConstant(CENTER_HANDLE, v2Center);
+	m_rectVS->SetConstant(COLOR0_HANDLE, color0);
+	m_rectVS->SetConstant(COLOR1_HANDLE, color1);
+	m_rectVS->SetConstant(COLOR2_HANDLE, color2);
+	m_rectVS->SetConstant(COLOR3_HANDLE, color3);
 
 	ShaderPtr prevVertexShader = GetVertexShader(), prevPixelShader = GetPixelShader();
 
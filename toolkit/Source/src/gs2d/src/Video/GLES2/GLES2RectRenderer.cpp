@@ -115,6 +115,11 @@ void GLES2RectRenderer::SetPositionLocations(const int positionLocation, const i
 	}
 }
 
+void GLES2RectRenderer::InvalidatePositionLocations() const
+{
+	m_latestLocations = LatestLocations();
+}
+
 void GLES2RectRenderer::Draw(const int positionLocation, const int texCoordLocation, const Sprite::RECT_MODE mode, const Platform::FileLogger& logger) const
 {
 	SetPositionLocations(positionLocation, texCoordLocation, logger);
@@ -61,6 +61,9 @@ public:
 	void FastDraw(const Platform::FileLogger& logger) const;
 	void EndFastDraw(const Platform::FileLogger& logger) const;
 	void SetPositionLocations(const int positionLocation, const int texCoordLocation, const Platform::FileLogger& logger) const;
+
+	/// Must be called after vertex attributes are pointed elsewhere so the next Draw rebinds them
+	void InvalidatePositionLocations() const;
 	void Draw(const int positionLocation, const int texCoordLocation, const Sprite::RECT_MODE mode, const Platform::FileLogger& logger) const;
 
 	void BeginFastDrawFromClientMem(const int positionLocation, const int texCoordLocation, const Platform::FileLogger& logger) const;
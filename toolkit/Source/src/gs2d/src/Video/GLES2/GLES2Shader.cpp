@@ -133,6 +133,7 @@ bool GLES2ShaderContext::FindLocations(const GLuint program)
 {
 	m_vertexPosLocations[program] = glGetAttribLocation(program, "vPosition");
 	m_texCoordLocations[program] = glGetAttribLocation(program, "vTexCoord");
+	m_colorLocations[program] = glGetAttribLocation(program, "vColor");
 	return !CheckForError("GLES2ShaderContext::FindLocations - glGetAttribLocation");
 }
 
@@ -202,6 +203,52 @@ void GLES2ShaderContext::FastDraw()
 	m_rectRenderer.FastDraw(m_logger);
 }
 
+bool GLES2ShaderContext::DrawTriangles(GLES2ShaderPtr vs, const Sprite::SCREEN_VERTEX* vertices, const unsigned int numVertices)
+{
+	const GLES2ShaderPtr previousVS = m_currentVS;
+	SetShader(vs);
+	CreateProgram();
+
+	std::map<GLuint, int>::const_iterator iterPos = m_vertexPosLocations.find(m_currentProgram);
+	std::map<GLuint, int>::const_iterator iterTex = m_texCoordLocations.find(m_currentProgram);
+	std::map<GLuint, int>::const_iterator iterColor = m_colorLocations.find(m_currentProgram);
+	if (iterPos == m_vertexPosLocations.end() || iterTex == m_texCoordLocations.end() || iterColor == m_colorLocations.end()
+		|| iterPos->second == INVALID_ATTRIB_LOCATION || iterTex->second == INVALID_ATTRIB_LOCATION
+		|| iterColor->second == INVALID_ATTRIB_LOCATION)
+	{
+		m_logger.Log("DrawTriangles - could not find the triangle program attribs", Platform::FileLogger::ERROR);
+		SetShader(previousVS);
+		return false;
+	}
+
+	static const Shader::CONSTANT_HANDLE VIEW_MATRIX = Shader::GetConstantHandle("viewMatrix");
+	static const Shader::CONSTANT_HANDLE SCREEN_SIZE = Shader::GetConstantHandle("screenSize");
+	vs->SetMatrixConstant(VIEW_MATRIX, m_ortho);
+	vs->SetConstant(SCREEN_SIZE, m_screenSize);
+	SetUniformParametersFromCurrentProgram(m_currentVS);
+	SetUniformParametersFromCurrentProgram(m_currentPS);
+
+	// the vertices come from client memory, so the rect renderer's buffer must be unbound
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	const GLsizei stride = sizeof(Sprite::SCREEN_VERTEX);
+	glVertexAttribPointer(iterPos->second, 3, GL_FLOAT, GL_FALSE, stride, &vertices[0].pos);
+	glEnableVertexAttribArray(iterPos->second);
+	glVertexAttribPointer(iterTex->second, 2, GL_FLOAT, GL_FALSE, stride, &vertices[0].texCoord);
+	glEnableVertexAttribArray(iterTex->second);
+	glVertexAttribPointer(iterColor->second, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, &vertices[0].color);
+	glEnableVertexAttribArray(iterColor->second);
+
+	glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(numVertices));
+	const bool failed = CheckForError("GLES2ShaderContext::DrawTriangles - glDrawArrays");
+
+	glDisableVertexAttribArray(iterColor->second);
+	m_rectRenderer.InvalidatePositionLocations();
+
+	// the sprite programs never read vColor, so the previous vertex shader needs no other restoring
+	SetShader(previousVS);
+	return !failed;
+}
+
 bool GLES2ShaderContext::CheckForError(const str_type::string& situation)
 {
 	bool r = false;
@@ -294,8 +341,10 @@ void GLES2ShaderContext::SetShader(GLES2ShaderPtr vs, GLES2ShaderPtr ps, const m
 
 void GLES2ShaderContext::ResetViewConstants(const math::Matrix4x4 &ortho, const math::Vector2& screenSize)
 {
+	static const Shader::CONSTANT_HANDLE VIEW_MATRIX = Shader::GetConstantHandle("viewMatrix");
+	m_ortho = ortho;
 	m_screenSize = screenSize;
-	m_currentVS->SetMatrixConstant("viewMatrix", ortho);
+	m_currentVS->SetMatrixConstant(VIEW_MATRIX, ortho);
 }
 
 math::Vector2 GLES2ShaderContext::GetScreenSize() const
@@ -498,63 +547,113 @@ bool GLES2Shader::SetConstant(const str_type::string& name, const Color& dw)
 	return SetConstant(name, v);
 }
 
-inline void SetParameter(
-	const std::size_t nameHash,
-	const GLES2UniformParameterPtr& param,
-	std::map<std::size_t, GLES2UniformParameterPtr>& parameters)
+GLES2UniformParameterPtr& GLES2Shader::GetParameter(const std::size_t nameHash)
 {
-	std::map<std::size_t, GLES2UniformParameterPtr>::iterator iter = parameters.find(nameHash);
-	if (iter != parameters.end())
+	GetConstantStats().nameLookups++;
+	return m_parameters[nameHash];
+}
+
+GLES2UniformParameterPtr& GLES2Shader::GetParameter(const CONSTANT_HANDLE handle)
+{
+	if (handle >= m_handleParameters.size())
+	{
+		m_handleParameters.resize(handle + 1, 0);
+	}
+
+	GLES2UniformParameterPtr*& param = m_handleParameters[handle];
+	if (!param)
 	{
-		param->SetLocations(iter->second->GetLocations());
-		iter->second = param;
+		// map nodes never move, so the entry can be addressed directly from now on
+		param = &GetParameter(fastHash(GetConstantName(handle)));
+	}
+	return *param;
+}
+
+/*
+ * Writes the value into the existing parameter object so its per-program upload state survives.
+ * A new object is only created the first time the constant is set or if its type changes.
+ */
+template <class PARAMETER_T, class VALUE_T>
+inline void UpdateParameter(
+	GLES2UniformParameterPtr& param,
+	const PARAMETER_TYPE type,
+	const VALUE_T& v,
+	const str_type::string& shaderName,
+	const str_type::string& name)
+{
+	Shader::GetConstantStats().setCalls++;
+	if (param && param->GetType() == type)
+	{
+		static_cast<PARAMETER_T*>(param.get())->Set(v);
 	}
 	else
 	{
-		parameters[nameHash] = param;
+		GLES2UniformParameterPtr newParam(new PARAMETER_T(v, shaderName, name));
+		if (param)
+		{
+			newParam->SetLocations(param->GetLocations());
+		}
+		param = newParam;
 	}
 }
 
-inline void SetParameter(const str_type::string& name, const GLES2UniformParameterPtr& param,
-						 std::map<std::size_t, GLES2UniformParameterPtr>& parameters)
+inline void UpdateArrayParameter(
+	GLES2UniformParameterPtr& param,
+	const math::Vector2* v,
+	const unsigned int count,
+	const str_type::string& shaderName,
+	const str_type::string& name)
 {
-	SetParameter(fastHash(name), param, parameters);
+	Shader::GetConstantStats().setCalls++;
+	if (param && param->GetType() == PT_VECTOR2_ARRAY)
+	{
+		static_cast<GLES2UPVec2Array*>(param.get())->Set(v, count);
+	}
+	else
+	{
+		GLES2UniformParameterPtr newParam(new GLES2UPVec2Array(v, count, shaderName, name));
+		if (param)
+		{
+			newParam->SetLocations(param->GetLocations());
+		}
+		param = newParam;
+	}
 }
 
 bool GLES2Shader::SetConstant(const std::size_t nameHash, const str_type::string& name, const math::Vector4 &v)
 {
-	SetParameter(nameHash, GLES2UPVec4Ptr(new GLES2UPVec4(v, m_shaderName, name)), m_parameters);
+	UpdateParameter<GLES2UPVec4>(GetParameter(nameHash), PT_VECTOR4, v, m_shaderName, name);
 	return true;
 }
 
 bool GLES2Shader::SetConstant(const std::size_t nameHash, const str_type::string& name, const math::Vector3 &v)
 {
-	SetParameter(nameHash, GLES2UPVec3Ptr(new GLES2UPVec3(v, m_shaderName, name)), m_parameters);
+	UpdateParameter<GLES2UPVec3>(GetParameter(nameHash), PT_VECTOR3, v, m_shaderName, name);
 	return true;
 }
 
 bool GLES2Shader::SetConstant(const std::size_t nameHash, const str_type::string& name, const math::Vector2 &v)
 {
-	SetParameter(nameHash, GLES2UPVec2Ptr(new GLES2UPVec2(v, m_shaderName, name)), m_parameters);
+	UpdateParameter<GLES2UPVec2>(GetParameter(nameHash), PT_VECTOR2, v, m_shaderName, name);
 	return true;
 }
 
 bool GLES2Shader::SetConstant(const std::size_t nameHash, const str_type::string& name, const float x)
 {
-	SetParameter(nameHash, GLES2UPVec1Ptr(new GLES2UPVec1(x, m_shaderName, name)), m_parameters);
+	UpdateParameter<GLES2UPVec1>(GetParameter(nameHash), PT_FLOAT, x, m_shaderName, name);
 	return true;
 }
 
 bool GLES2Shader::SetMatrixConstant(const std::size_t nameHash, const str_type::string& name, const math::Matrix4x4 &matrix)
 {
-	SetParameter(nameHash, GLES2UPMat4x4Ptr(new GLES2UPMat4x4(matrix, m_shaderName, name)), m_parameters);
+	UpdateParameter<GLES2UPMat4x4>(GetParameter(nameHash), PT_M4X4, matrix, m_shaderName, name);
 	return true;
 }
 
 bool GLES2Shader::SetConstantArray(const std::size_t nameHash, const str_type::string& name, unsigned int nElements,
 								   const boost::shared_array<const math::Vector2>& v)
 {
-	SetParameter(nameHash, GLES2UPVec2ArrayPtr(new GLES2UPVec2Array(v, nElements, m_shaderName, name)), m_parameters);
+	UpdateArrayParameter(GetParameter(nameHash), v.get(), nElements, m_shaderName, name);
 	return true;
 }
 
@@ -567,20 +666,17 @@ bool GLES2Shader::SetConstant(const std::size_t nameHash, const str_type::string
 
 bool GLES2Shader::SetConstant(const str_type::string& name, const math::Vector4 &v)
 {
-	SetParameter(name, GLES2UPVec4Ptr(new GLES2UPVec4(v, m_shaderName, name)), m_parameters);
-	return true;
+	return SetConstant(fastHash(name), name, v);
 }
 
 bool GLES2Shader::SetConstant(const str_type::string& name, const math::Vector3 &v)
 {
-	SetParameter(name, GLES2UPVec3Ptr(new GLES2UPVec3(v, m_shaderName, name)), m_parameters);
-	return true;
+	return SetConstant(fastHash(name), name, v);
 }
 
 bool GLES2Shader::SetConstant(const str_type::string& name, const math::Vector2 &v)
 {
-	SetParameter(name, GLES2UPVec2Ptr(new GLES2UPVec2(v, m_shaderName, name)), m_parameters);
-	return true;
+	return SetConstant(fastHash(name), name, v);
 }
 
 bool GLES2Shader::SetConstant(const str_type::string& name, const float x, const float y, const float z, const float w)
@@ -600,8 +696,7 @@ bool GLES2Shader::SetConstant(const str_type::string& name, const float x, const
 
 bool GLES2Shader::SetConstant(const str_type::string& name, const float x)
 {
-	SetParameter(name, GLES2UPVec1Ptr(new GLES2UPVec1(x, m_shaderName, name)), m_parameters);
-	return true;
+	return SetConstant(fastHash(name), name, x);
 }
 
 bool GLES2Shader::SetConstant(const str_type::string& name, const int n)
@@ -612,13 +707,53 @@ bool GLES2Shader::SetConstant(const str_type::string& name, const int n)
 
 bool GLES2Shader::SetConstantArray(const str_type::string& name, unsigned int nElements, const boost::shared_array<const math::Vector2>& v)
 {
-	SetParameter(name, GLES2UPVec2ArrayPtr(new GLES2UPVec2Array(v, nElements, m_shaderName, name)), m_parameters);
-	return true;
+	return SetConstantArray(fastHash(name), name, nElements, v);
 }
 
 bool GLES2Shader::SetMatrixConstant(const str_type::string& name, const math::Matrix4x4 &matrix)
 {
-	SetParameter(name, GLES2UPMat4x4Ptr(new GLES2UPMat4x4(matrix, m_shaderName, name)), m_parameters);
+	return SetMatrixConstant(fastHash(name), name, matrix);
+}
+
+bool GLES2Shader::ConstantExist(const CONSTANT_HANDLE handle)
+{
+	return ConstantExist(GetConstantName(handle));
+}
+
+bool GLES2Shader::SetConstant(const CONSTANT_HANDLE handle, const Color& dw)
+{
+	math::Vector4 v;
+	v.SetColor(dw);
+	return SetConstant(handle, v);
+}
+
+bool GLES2Shader::SetConstant(const CONSTANT_HANDLE handle, const math::Vector4 &v)
+{
+	UpdateParameter<GLES2UPVec4>(GetParameter(handle), PT_VECTOR4, v, m_shaderName, GetConstantName(handle));
+	return true;
+}
+
+bool GLES2Shader::SetConstant(const CONSTANT_HANDLE handle, const math::Vector3 &v)
+{
+	UpdateParameter<GLES2UPVec3>(GetParameter(handle), PT_VECTOR3, v, m_shaderName, GetConstantName(handle));
+	return true;
+}
+
+bool GLES2Shader::SetConstant(const CONSTANT_HANDLE handle, const math::Vector2 &v)
+{
+	UpdateParameter<GLES2UPVec2>(GetParameter(handle), PT_VECTOR2, v, m_shaderName, GetConstantName(handle));
+	return true;
+}
+
+bool GLES2Shader::SetConstant(const CONSTANT_HANDLE handle, const float x)
+{
+	UpdateParameter<GLES2UPVec1>(GetParameter(handle), PT_FLOAT, x, m_shaderName, GetConstantName(handle));
+	return true;
+}
+
+bool GLES2Shader::SetMatrixConstant(const CONSTANT_HANDLE handle, const math::Matrix4x4 &matrix)
+{
+	UpdateParameter<GLES2UPMat4x4>(GetParameter(handle), PT_M4X4, matrix, m_shaderName, GetConstantName(handle));
 	return true;
 }
 
@@ -636,15 +771,25 @@ bool GLES2Shader::SetTexture(const str_type::string& name, TextureWeakPtr pTextu
 	GLES2Texture* tex = static_cast<GLES2Texture*>(pTexture.lock().get());
 	if (tex)
 	{
-		SetParameter(
-			name,
-			GLES2UPTexturePtr(new GLES2UPTexture(
+		GLES2UniformParameterPtr& param = GetParameter(fastHash(name));
+		if (param && param->GetType() == PT_TEXTURE)
+		{
+			static_cast<GLES2UPTexture*>(param.get())->Set(GetEquivalentTexturePass(pass), tex->GetTextureID(), pass);
+		}
+		else
+		{
+			GLES2UniformParameterPtr newParam(new GLES2UPTexture(
 				GetEquivalentTexturePass(pass),
 				tex->GetTextureID(),
 				pass,
 				m_shaderName,
-				name)),
-			m_parameters);
+				name));
+			if (param)
+			{
+				newParam->SetLocations(param->GetLocations());
+			}
+			param = newParam;
+		}
 		return true;
 	}
 	else
@@ -32,6 +32,7 @@
 #include "GLES2UniformParameter.h"
 
 #include <map>
+#include <vector>
 
 namespace gs2d {
 
@@ -67,6 +68,9 @@ public:
 	void FastDraw();
 	void EndFastDraw();
 
+	/// Draws screen-space triangles with the given vertex shader and the current pixel shader
+	bool DrawTriangles(GLES2ShaderPtr vs, const Sprite::SCREEN_VERTEX* vertices, const unsigned int numVertices);
+
 	void Log(const str_type::string& str, const Platform::FileLogger::TYPE& type) const;
 
 	void ResetViewConstants(const math::Matrix4x4 &ortho, const math::Vector2& screenSize);
@@ -87,6 +91,7 @@ protected:
 	std::map<std::size_t, GLuint> m_programs;
 	std::map<GLuint, int> m_vertexPosLocations;
 	std::map<GLuint, int> m_texCoordLocations;
+	std::map<GLuint, int> m_colorLocations;
 	bool CheckForError(const str_type::string& situation);
 	GLES2RectRenderer m_rectRenderer;
 
@@ -128,6 +133,12 @@ private:
 	Shader::SHADER_FOCUS m_shaderFocus;
 	std::map<std::size_t, GLES2UniformParameterPtr> m_parameters;
 	const str_type::string DIFFUSE_TEXTURE_NAME;
+
+	/// Points to the m_parameters entries, indexed by CONSTANT_HANDLE and filled on first use
+	std::vector<GLES2UniformParameterPtr*> m_handleParameters;
+
+	GLES2UniformParameterPtr& GetParameter(const std::size_t nameHash);
+	GLES2UniformParameterPtr& GetParameter(const CONSTANT_HANDLE handle);
 	
 	std::map<str_type::string, GLint> m_texturePasses;
 	GLint m_texturePassCounter;
@@ -180,6 +191,14 @@ public:
 	bool SetMatrixConstant(const str_type::string& name, const math::Matrix4x4 &matrix);
 	bool SetTexture(const str_type::string& name, TextureWeakPtr pTexture);
 
+	bool ConstantExist(const CONSTANT_HANDLE handle);
+	bool SetConstant(const CONSTANT_HANDLE handle, const Color& dw);
+	bool SetConstant(const CONSTANT_HANDLE handle, const math::Vector4 &v);
+	bool SetConstant(const CONSTANT_HANDLE handle, const math::Vector3 &v);
+	bool SetConstant(const CONSTANT_HANDLE handle, const math::Vector2 &v);
+	bool SetConstant(const CONSTANT_HANDLE handle, const float x);
+	bool SetMatrixConstant(const CONSTANT_HANDLE handle, const math::Matrix4x4 &matrix);
+
 	bool SetShader();
 	Shader::SHADER_FOCUS GetShaderFocus() const;
 	Shader::SHADER_PROFILE GetShaderProfile() const;
@@ -184,59 +184,59 @@ bool GLES2Sprite::DrawShaped(
 		center.y = floor(center.y);
 	}
 
-	static const std::size_t ROTATION_MATRIX_HASH = fastHash("rotationMatrix");
-	static const std::size_t RECT_SIZE_HASH = fastHash("rectSize");
-	static const std::size_t RECT_POS_HASH = fastHash("rectPos");
-	static const std::size_t BITMAP_SIZE_HASH = fastHash("bitmapSize");
-	static const std::size_t ENTITY_POS_HASH = fastHash("entityPos");
-	static const std::size_t CENTER_HASH = fastHash("center");
-	static const std::size_t SIZE_HASH = fastHash("size");
-	static const std::size_t COLOR0_HASH = fastHash("color0");
-	static const std::size_t COLOR1_HASH = fastHash("color1");
-	static const std::size_t COLOR2_HASH = fastHash("color2");
-	static const std::size_t COLOR3_HASH = fastHash("color3");
-	static const std::size_t CAMERA_POS_HASH = fastHash("cameraPos");
-	static const std::size_t DEPTH_HASH = fastHash("depth");
-	static const std::size_t FLIP_MUL = fastHash("flipMul");
-	static const std::size_t FLIP_ADD = fastHash("flipAdd");
-	static const std::size_t SCREEN_SIZE = fastHash("screenSize");
+	static const Shader::CONSTANT_HANDLE ROTATION_MATRIX_HANDLE = Shader::GetConstantHandle("rotationMatrix");
+	static const Shader::CONSTANT_HANDLE RECT_SIZE_HANDLE = Shader::GetConstantHandle("rectSize");
+	static const Shader::CONSTANT_HANDLE RECT_POS_HANDLE = Shader::GetConstantHandle("rectPos");
+	static const Shader::CONSTANT_HANDLE BITMAP_SIZE_HANDLE = Shader::GetConstantHandle("bitmapSize");
+	static const Shader::CONSTANT_HANDLE ENTITY_POS_HANDLE = Shader::GetConstantHandle("entityPos");
+	static const Shader::CONSTANT_HANDLE CENTER_HANDLE = Shader::GetConstantHandle("center");
+	static const Shader::CONSTANT_HANDLE SIZE_HANDLE = Shader::GetConstantHandle("size");
+	static const Shader::CONSTANT_HANDLE COLOR0_HANDLE = Shader::GetConstantHandle("color0");
+	static const Shader::CONSTANT_HANDLE COLOR1_HANDLE = Shader::GetConstantHandle("color1");
+	static const Shader::CONSTANT_HANDLE COLOR2_HANDLE = Shader::GetConstantHandle("color2");
+	static const Shader::CONSTANT_HANDLE COLOR3_HANDLE = Shader::GetConstantHandle("color3");
+	static const Shader::CONSTANT_HANDLE CAMERA_POS_HANDLE = Shader::GetConstantHandle("cameraPos");
+	static const Shader::CONSTANT_HANDLE DEPTH_HANDLE = Shader::GetConstantHandle("depth");
+	static const Shader::CONSTANT_HANDLE FLIP_MUL_HANDLE = Shader::GetConstantHandle("flipMul");
+	static const Shader::CONSTANT_HANDLE FLIP_ADD_HANDLE = Shader::GetConstantHandle("flipAdd");
+	static const Shader::CONSTANT_HANDLE SCREEN_SIZE_HANDLE = Shader::GetConstantHandle("screenSize");
 
 	Matrix4x4 mRot;
 	if (angle != 0.0f)
 	{
 		mRot = RotateZ(DegreeToRadian(-angle)); 
 	}
-	vs->SetMatrixConstant(ROTATION_MATRIX_HASH, "rotationMatrix", mRot);
+	vs->SetMatrixConstant(ROTATION_MATRIX_HANDLE, mRot);
 
 	ps->SetTexture("diffuse", m_texture);
 	
 	if (m_rect.size.x == 0 || m_rect.size.y == 0)
 	{
-		vs->SetConstant(RECT_SIZE_HASH, "rectSize", GetBitmapSizeF());
-		vs->SetConstant(RECT_POS_HASH, "rectPos", Vector2(0, 0));
+		vs->SetConstant(RECT_SIZE_HANDLE, GetBitmapSizeF());
+		vs->SetConstant(RECT_POS_HANDLE, Vector2(0, 0));
 	}
 	else
 	{
-		vs->SetConstant(RECT_SIZE_HASH, "rectSize", m_rect.size);
-		vs->SetConstant(RECT_POS_HASH, "rectPos", m_rect.pos);
+		vs->SetConstant(RECT_SIZE_HANDLE, m_rect.size);
+		vs->SetConstant(RECT_POS_HANDLE, m_rect.pos);
 	}
 
 	Vector2 flipAdd, flipMul;
 	GetFlipShaderParameters(flipAdd, flipMul);
 
-	vs->SetConstant(SCREEN_SIZE, "screenSize", m_shaderContext->GetScreenSize());
-	vs->SetConstant(BITMAP_SIZE_HASH, "bitmapSize", m_bitmapSize);
-	vs->SetConstant(ENTITY_POS_HASH, "entityPos", pos);
-	vs->SetConstant(CENTER_HASH, "center", center);
-	vs->SetConstant(SIZE_HASH, "size", v2Size);
-	vs->SetConstant(COLOR0_HASH, "color0", color0);
-	vs->SetConstant(COLOR1_HASH, "color1", color1);
-	vs->SetConstant(COLOR2_HASH, "color2", color2);
-	vs->SetConstant(COLOR3_HASH, "color3", color3);
-	vs->SetConstant(FLIP_ADD, "flipAdd", flipAdd);
-	vs->SetConstant(FLIP_MUL, "flipMul", flipMul);
-	vs->SetConstant(CAMERA_POS_HASH, "cameraPos", camPos);
-	vs->SetConstant(DEPTH_HASH, "depth", m_video->GetSpriteDepth());
+	vs->SetConstant(SCREEN_SIZE_HANDLE, m_shaderContext->GetScreenSize());
+	vs->SetConstant(BITMAP_SIZE_HANDLE, m_bitmapSize);
+	vs->SetConstant(ENTITY_POS_HANDLE, pos);
+	vs->SetConstant(CENTER_HANDLE, center);
+	vs->SetConstant(SIZE_HANDLE, v2Size);
+	vs->SetConstant(COLOR0_HANDLE, color0);
+	vs->SetConstant(COLOR1_HANDLE, color1);
+	vs->SetConstant(COLOR2_HANDLE, color2);
+	vs->SetConstant(COLOR3_HANDLE, color3);
+	vs->SetConstant(FLIP_ADD_HANDLE, flipAdd);
+	vs->SetConstant(FLIP_MUL_HANDLE, flipMul);
+	vs->SetConstant(CAMERA_POS_HANDLE, camPos);
+	vs->SetConstant(DEPTH_HANDLE, m_video->GetSpriteDepth());
 	m_shaderContext->DrawRect(m_rectMode);
 	return true;
 }
@@ -261,7 +261,7 @@ bool GLES2Sprite::DrawOptimal(const math::Vector2 &v2Pos, const Vector4& color,
 		center.y = floor(center.y);
 	}
 
-	static const std::size_t ROTATION_MATRIX_HASH = fastHash("rotationMatrix");
+	static const Shader::CONSTANT_HANDLE ROTATION_MATRIX_HANDLE = Shader::GetConstantHandle("rotationMatrix");
 	static const std::size_t PARAMS_HASH = fastHash("params");
 
 	Matrix4x4 mRot;
@@ -309,7 +309,7 @@ bool GLES2Sprite::DrawOptimal(const math::Vector2 &v2Pos, const Vector4& color,
 		params[t + first] = m_attachedParameters[t];
 	}
 
-	vs->SetMatrixConstant(ROTATION_MATRIX_HASH, "rotationMatrix", mRot);
+	vs->SetMatrixConstant(ROTATION_MATRIX_HANDLE, mRot);
 	vs->SetConstantArray(PARAMS_HASH, "params", numParams, boost::shared_array<const math::Vector2>(params));
 	m_shaderContext->DrawRect(m_rectMode);
 	m_attachedParameters.clear();
@@ -376,6 +376,17 @@ void GLES2Sprite::EndFastRendering()
 	m_video->SetVertexShader(ShaderPtr());
 }
 
+bool GLES2Sprite::DrawTriangles(const SCREEN_VERTEX* vertices, const unsigned int numVertices)
+{
+	if (numVertices < 3)
+	{
+		return true;
+	}
+
+	m_shaderContext->GetCurrentPS()->SetTexture("diffuse", m_texture);
+	return m_shaderContext->DrawTriangles(static_cast<GLES2Video*>(m_video)->GetScreenTrianglesVS(), vertices, numVertices);
+}
+
 TextureWeakPtr GLES2Sprite::GetTexture()
 {
 	return m_texture;
@@ -99,6 +99,8 @@ public:
 	void BeginFastRendering();
 	void EndFastRendering();
 
+	bool DrawTriangles(const SCREEN_VERTEX* vertices, const unsigned int numVertices);
+
 	TextureWeakPtr GetTexture();
 
 	Texture::PROFILE GetProfile() const;
@@ -23,6 +23,8 @@
 #include "GLES2UniformParameter.h"
 #include "GLES2Shader.h"
 
+#include <algorithm>
+
 namespace gs2d {
 
 int counter = 1;
@@ -30,7 +32,10 @@ int counter = 1;
 GLES2UniformParameter::GLES2UniformParameter(const str_type::string& shaderName, const str_type::string& parameterName) :
 	m_locations(new LocationMap),
 	m_parameterName(parameterName),
-	m_shaderName(shaderName)
+	m_shaderName(shaderName),
+	m_version(1),
+	m_lastProgram(0),
+	m_lastLocation(0)
 {
 }
 
@@ -47,15 +52,30 @@ const str_type::string& GLES2UniformParameter::GetParameterName() const
 void GLES2UniformParameter::SetLocations(const LocationMapPtr& locations)
 {
 	m_locations = locations;
+	m_lastProgram = 0;
+	m_lastLocation = 0;
+
+	// the versions stored there belong to the parameter being replaced
+	for (LocationMap::iterator iter = m_locations->begin(); iter != m_locations->end(); ++iter)
+	{
+		iter->second.uploadedVersion = 0;
+	}
 }
 
-inline int GLES2UniformParameter::GetLocation(const GLuint program, const Platform::FileLogger& logger)
+UNIFORM_LOCATION* GLES2UniformParameter::GetLocation(const GLuint program, const Platform::FileLogger& logger)
 {
+	if (m_lastLocation && m_lastProgram == program)
+	{
+		return m_lastLocation;
+	}
+
 	LocationMap& locations = *m_locations.get();
-	std::map<GLuint, int>::iterator iter = locations.find(program);
+	LocationMap::iterator iter = locations.find(program);
 	if (iter != locations.end())
 	{
-		return iter->second;
+		m_lastProgram = program;
+		m_lastLocation = &iter->second;
+		return m_lastLocation;
 	}
 	else
 	{
@@ -68,8 +88,11 @@ inline int GLES2UniformParameter::GetLocation(const GLuint program, const Platfo
 		{
 			ss << "Location obtained successfully [" << name << "] " << counter++ << ": " << location;
 			logger.Log(ss.str(), Platform::FileLogger::INFO);
-			locations[program] = location;
-			return location;
+			UNIFORM_LOCATION& entry = locations[program];
+			entry.location = location;
+			m_lastProgram = program;
+			m_lastLocation = &entry;
+			return m_lastLocation;
 		}
 		else
 		{
@@ -78,54 +101,40 @@ inline int GLES2UniformParameter::GetLocation(const GLuint program, const Platfo
 			ss << "Couldn't get location for parameter " << name << " on shader " << m_shaderName
 			   << " (current: " << currentProgram << " / " << "should be " << program << ")";
 			logger.Log(ss.str(), Platform::FileLogger::ERROR);
-			return -1;
+			return 0;
 		}
 	}
 }
 
-std::map<GLuint, std::map<int, boost::shared_ptr<GLES2UniformParameter> > > GLES2UniformParameter::m_params;
-GLenum GLES2UniformParameter::m_activatedTexture = 0xF0000000;
-GLenum GLES2UniformParameter::m_boundTexture2D   = 0xF0000000;
-
-void GLES2UniformParameter::AddParam(const GLuint& program, const int& location, const boost::shared_ptr<GLES2UniformParameter>& param)
+bool GLES2UniformParameter::PrepareUpload(const GLuint program, const Platform::FileLogger& logger, int& location)
 {
-	std::map<GLuint, std::map<int, boost::shared_ptr<GLES2UniformParameter> > >::iterator mapIter = m_params.find(program);
-	if (mapIter == m_params.end())
+	UNIFORM_LOCATION* entry = GetLocation(program, logger);
+	if (!entry || entry->uploadedVersion == m_version)
 	{
-		m_params[program];
-		mapIter = m_params.find(program);
+		return false;
 	}
-	mapIter->second.insert(std::pair<int, boost::shared_ptr<GLES2UniformParameter> >(location, param));
 
+	entry->uploadedVersion = m_version;
+	location = entry->location;
+
+	// -1 means the uniform was optimized out of this program
+	return (location != -1);
 }
-	
-bool GLES2UniformParameter::IsEqualToAlreadyDefinedParam(const GLuint& program, const int& location,
-														 const GLES2UniformParameter* param,
-														 const Platform::FileLogger& logger)
+
+void GLES2UniformParameter::CountUpload(const std::size_t bytes)
 {
-	GS2D_UNUSED_ARGUMENT(logger);
-	std::map<GLuint, std::map<int, boost::shared_ptr<GLES2UniformParameter> > >::iterator mapIter = m_params.find(program);
-	if (mapIter != m_params.end())
-	{
-		std::map<int, boost::shared_ptr<GLES2UniformParameter> >::iterator iter = mapIter->second.find(location);
-		if (iter != mapIter->second.end())
-		{
-			return param->IsEqual((iter->second).get());
-		}
-		else
-		{
-			return false;
-		}
-	}
-	else
-	{
-		return false;
-	}
+	Shader::CONSTANT_STATS& stats = Shader::GetConstantStats();
+	stats.uploads++;
+	stats.bytesUploaded += static_cast<unsigned long>(bytes);
 }
 
+GLenum GLES2UniformParameter::m_activatedTexture = 0xF0000000;
+GLenum GLES2UniformParameter::m_boundTexture2D   = 0xF0000000;
+
 void GLES2UniformParameter::ClearParams()
 {
-	m_params.clear();
+	m_activatedTexture = 0xF0000000;
+	m_boundTexture2D   = 0xF0000000;
 }
 	
 void GLES2UniformParameter::BindTexture2D(const GLenum& texture)
@@ -151,10 +160,24 @@ GLES2UPVec1::GLES2UPVec1(const float v, const str_type::string& shaderName, cons
 {
 	this->v = v;
 }
+
+void GLES2UPVec1::Set(const float v)
+{
+	if (this->v != v)
+	{
+		this->v = v;
+		Touch();
+	}
+}
+
 bool GLES2UPVec1::SetParameter(const GLuint program, const Platform::FileLogger& logger)
 {
-	const int location = GetLocation(program, logger);
-	glUniform1f(location, v);
+	int location;
+	if (PrepareUpload(program, logger, location))
+	{
+		glUniform1f(location, v);
+		CountUpload(sizeof(v));
+	}
 	return true;
 }
 
@@ -163,27 +186,29 @@ PARAMETER_TYPE GLES2UPVec1::GetType() const
 	return PT_FLOAT;
 }
 
-bool GLES2UPVec1::IsEqual(const gs2d::GLES2UniformParameter *other) const
-{
-	if (other->GetType() == GetType())
-	{
-		if (v == static_cast<const GLES2UPVec1*>(other)->v)
-		{
-			return  true;
-		}
-	}
-	return false;
-}
-
 GLES2UPVec2::GLES2UPVec2(const math::Vector2& v, const str_type::string& shaderName, const str_type::string& parameterName) :
 	GLES2UniformParameter(shaderName, parameterName)
 {
 	this->v = v;
 }
+
+void GLES2UPVec2::Set(const math::Vector2& v)
+{
+	if (this->v != v)
+	{
+		this->v = v;
+		Touch();
+	}
+}
+
 bool GLES2UPVec2::SetParameter(const GLuint program, const Platform::FileLogger& logger)
 {
-	const int location = GetLocation(program, logger);
-	glUniform2fv(location, 1, &v.x);
+	int location;
+	if (PrepareUpload(program, logger, location))
+	{
+		glUniform2fv(location, 1, &v.x);
+		CountUpload(sizeof(v));
+	}
 	return true;
 }
 	
@@ -192,27 +217,29 @@ PARAMETER_TYPE GLES2UPVec2::GetType() const
 	return PT_VECTOR2;
 }
 
-bool GLES2UPVec2::IsEqual(const gs2d::GLES2UniformParameter *other) const
-{
-	if (other->GetType() == GetType())
-	{
-		if (v == static_cast<const GLES2UPVec2*>(other)->v)
-		{
-			return true;
-		}
-	}
-	return false;
-}
-
 GLES2UPVec3::GLES2UPVec3(const math::Vector3& v, const str_type::string& shaderName, const str_type::string& parameterName) :
 	GLES2UniformParameter(shaderName, parameterName)
 {
 	this->v = v;
 }
+
+void GLES2UPVec3::Set(const math::Vector3& v)
+{
+	if (this->v != v)
+	{
+		this->v = v;
+		Touch();
+	}
+}
+
 bool GLES2UPVec3::SetParameter(const GLuint program, const Platform::FileLogger& logger)
 {
-	const int location = GetLocation(program, logger);
-	glUniform3fv(location, 1, &v.x);
+	int location;
+	if (PrepareUpload(program, logger, location))
+	{
+		glUniform3fv(location, 1, &v.x);
+		CountUpload(sizeof(v));
+	}
 	return true;
 }
 
@@ -221,27 +248,29 @@ PARAMETER_TYPE GLES2UPVec3::GetType() const
 	return PT_VECTOR3;
 }
 
-bool GLES2UPVec3::IsEqual(const gs2d::GLES2UniformParameter *other) const
-{
-	if (other->GetType() == GetType())
-	{
-		if (v == static_cast<const GLES2UPVec3*>(other)->v)
-		{
-			return true;
-		}
-	}
-	return false;
-}
-	
 GLES2UPVec4::GLES2UPVec4(const math::Vector4& v, const str_type::string& shaderName, const str_type::string& parameterName) :
 	GLES2UniformParameter(shaderName, parameterName)
 {
 	this->v = v;
 }
+
+void GLES2UPVec4::Set(const math::Vector4& v)
+{
+	if (this->v != v)
+	{
+		this->v = v;
+		Touch();
+	}
+}
+
 bool GLES2UPVec4::SetParameter(const GLuint program, const Platform::FileLogger& logger)
 {
-	const int location = GetLocation(program, logger);
-	glUniform4fv(location, 1, &v.x);
+	int location;
+	if (PrepareUpload(program, logger, location))
+	{
+		glUniform4fv(location, 1, &v.x);
+		CountUpload(sizeof(v));
+	}
 	return true;
 }
 
@@ -250,27 +279,29 @@ PARAMETER_TYPE GLES2UPVec4::GetType() const
 	return PT_VECTOR4;
 }
 
-bool GLES2UPVec4::IsEqual(const gs2d::GLES2UniformParameter *other) const
-{
-	if (other->GetType() == GetType())
-	{
-		if (v == static_cast<const GLES2UPVec4*>(other)->v)
-		{
-			return  true;
-		}
-	}
-	return false;
-}
-
 GLES2UPMat4x4::GLES2UPMat4x4(const math::Matrix4x4& v, const str_type::string& shaderName, const str_type::string& parameterName) :
 	GLES2UniformParameter(shaderName, parameterName)
 {
 	this->v = v;
 }
+
+void GLES2UPMat4x4::Set(const math::Matrix4x4& v)
+{
+	if (!(this->v == v))
+	{
+		this->v = v;
+		Touch();
+	}
+}
+
 bool GLES2UPMat4x4::SetParameter(const GLuint program, const Platform::FileLogger& logger)
 {
-	const int location = GetLocation(program, logger);
-	glUniformMatrix4fv(location, 1, GL_FALSE, (GLfloat*)&v.m[0][0]);
+	int location;
+	if (PrepareUpload(program, logger, location))
+	{
+		glUniformMatrix4fv(location, 1, GL_FALSE, (GLfloat*)&v.m[0][0]);
+		CountUpload(sizeof(v.m));
+	}
 	return true;
 }
 
@@ -279,18 +310,6 @@ PARAMETER_TYPE GLES2UPMat4x4::GetType() const
 	return PT_M4X4;
 }
 
-bool GLES2UPMat4x4::IsEqual(const gs2d::GLES2UniformParameter *other) const
-{
-	if (other->GetType() == GetType())
-	{
-		if (v == static_cast<const GLES2UPMat4x4*>(other)->v)
-		{
-			return true;
-		}
-	}
-	return false;
-}
-	
 GLES2UPTexture::GLES2UPTexture(
 	const GLenum texturePass,
 	GLuint texture,
@@ -303,12 +322,29 @@ GLES2UPTexture::GLES2UPTexture(
 	this->texture = texture;
 	this->unit = unit;
 }
+
+void GLES2UPTexture::Set(const GLenum texturePass, GLuint texture, const GLint unit)
+{
+	this->texturePass = texturePass;
+	this->texture = texture;
+	if (this->unit != unit)
+	{
+		this->unit = unit;
+		Touch();
+	}
+}
+
 bool GLES2UPTexture::SetParameter(const GLuint program, const Platform::FileLogger& logger)
 {
+	// the texture binding is global state, only the sampler unit is stored in the program
 	ActiveTexture(texturePass);
 	BindTexture2D(texture);
-	const int location = GetLocation(program, logger);
-	glUniform1i(location, unit);
+	int location;
+	if (PrepareUpload(program, logger, location))
+	{
+		glUniform1i(location, unit);
+		CountUpload(sizeof(unit));
+	}
 	return true;
 }
 
@@ -317,34 +353,34 @@ PARAMETER_TYPE GLES2UPTexture::GetType() const
 	return PT_TEXTURE;
 }
 
-bool GLES2UPTexture::IsEqual(const gs2d::GLES2UniformParameter *other) const
-{
-	if (other->GetType() == GetType())
-	{
-		const bool unitChanged = (unit != static_cast<const GLES2UPTexture*>(other)->unit);
-		return !unitChanged;
-	}
-	else
-	{
-		return false;
-	}
-}
-	
 GLES2UPVec2Array::GLES2UPVec2Array(
-	const boost::shared_array<const gs2d::math::Vector2>& v,
+	const math::Vector2* v,
 	const unsigned int count,
 	const str_type::string& shaderName,
 	const str_type::string& parameterName) :
 	GLES2UniformParameter(shaderName, parameterName),
-	count(static_cast<GLsizei>(count))
+	va(v, v + count)
 {
-	this->va = v;
+}
+
+void GLES2UPVec2Array::Set(const math::Vector2* v, const unsigned int count)
+{
+	if (va.size() == count && std::equal(va.begin(), va.end(), v))
+	{
+		return;
+	}
+	va.assign(v, v + count);
+	Touch();
 }
 
 bool GLES2UPVec2Array::SetParameter(const GLuint program, const Platform::FileLogger& logger)
 {
-	const int location = GetLocation(program, logger);
-	glUniform2fv(location, count, &(va.get()->x));
+	int location;
+	if (!va.empty() && PrepareUpload(program, logger, location))
+	{
+		glUniform2fv(location, static_cast<GLsizei>(va.size()), &va[0].x);
+		CountUpload(va.size() * sizeof(math::Vector2));
+	}
 	return true;
 }
 
@@ -353,19 +389,4 @@ PARAMETER_TYPE GLES2UPVec2Array::GetType() const
 	return PT_VECTOR2_ARRAY;
 }
 
-bool GLES2UPVec2Array::IsEqual(const gs2d::GLES2UniformParameter *other) const
-{
-	if (other->GetType() == GetType())
-	{
-		for (GLsizei t = 0; t < count; t++)
-		{
-			if (va[t] != static_cast<const GLES2UPVec2Array*>(other)->va[t])
-			{
-				return false;
-			}
-		}
-	}
-	return true;
-}
-
 } // namespace gs2d
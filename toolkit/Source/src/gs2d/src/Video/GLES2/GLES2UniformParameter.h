@@ -36,10 +36,24 @@
 #endif
 
 #include <map>
+#include <vector>
 
 namespace gs2d {
 
-typedef std::map<GLuint, int> LocationMap;
+/**
+ * \brief Location of a uniform in one program and the version of the value last uploaded to it
+ *
+ * GLSL programs keep their uniform values, so a parameter only has to be sent again
+ * to a program when its value changed since the last time that program received it.
+ */
+struct UNIFORM_LOCATION
+{
+	UNIFORM_LOCATION() : location(-1), uploadedVersion(0) {}
+	int location;
+	unsigned int uploadedVersion;
+};
+
+typedef std::map<GLuint, UNIFORM_LOCATION> LocationMap;
 typedef boost::shared_ptr<LocationMap> LocationMapPtr;
 
 enum PARAMETER_TYPE
@@ -60,24 +74,32 @@ class GLES2UniformParameter
 	LocationMapPtr m_locations;
 	str_type::string m_parameterName;
 	str_type::string m_shaderName;
+	unsigned int m_version;
+	GLuint m_lastProgram;
+	UNIFORM_LOCATION* m_lastLocation;
 	static GLenum m_activatedTexture;
 	static GLenum m_boundTexture2D;
 
+	UNIFORM_LOCATION* GetLocation(const GLuint program, const Platform::FileLogger& logger);
+
 protected:
 	static void ClearParams();
-	static std::map<GLuint, std::map<int, boost::shared_ptr<GLES2UniformParameter> > > m_params;
-	static bool IsEqualToAlreadyDefinedParam(const GLuint& program, const int& location, const GLES2UniformParameter* param, const Platform::FileLogger& logger);
-	static void AddParam(const GLuint& program, const int& location, const boost::shared_ptr<GLES2UniformParameter>& param);
 	static void BindTexture2D(const GLenum& texture);
 	static void ActiveTexture(const GLenum& texture);
+	static void CountUpload(const std::size_t bytes);
+
+	/// Marks the value as changed so it gets uploaded to every program again
+	inline void Touch() { ++m_version; }
+
+	/// Returns false if the program already holds the current value
+	bool PrepareUpload(const GLuint program, const Platform::FileLogger& logger, int& location);
+
 public:
 	const str_type::string& GetParameterName() const;
 	GLES2UniformParameter(const str_type::string& shaderName, const str_type::string& parameterName);
 	void SetLocations(const LocationMapPtr& locations);
 	LocationMapPtr GetLocations();
-	inline int GetLocation(const GLuint program, const Platform::FileLogger& logger);
 	virtual bool SetParameter(const GLuint program, const Platform::FileLogger& logger) = 0;
-	virtual bool IsEqual(const GLES2UniformParameter* other) const = 0;
 	virtual PARAMETER_TYPE GetType() const = 0;
 };
 
@@ -86,9 +108,9 @@ class GLES2UPVec1 : public GLES2UniformParameter
 	GLfloat v;
 public:
 	GLES2UPVec1(const float v, const str_type::string& shaderName, const str_type::string& parameterName);
+	void Set(const float v);
 	bool SetParameter(const GLuint program, const Platform::FileLogger& logger);
 	PARAMETER_TYPE GetType() const;
-	bool IsEqual(const GLES2UniformParameter* other) const;
 };
 
 class GLES2UPVec2 : public GLES2UniformParameter
@@ -96,9 +118,9 @@ class GLES2UPVec2 : public GLES2UniformParameter
 	math::Vector2 v;
 public:
 	GLES2UPVec2(const math::Vector2& v, const str_type::string& shaderName, const str_type::string& parameterName);
+	void Set(const math::Vector2& v);
 	bool SetParameter(const GLuint program, const Platform::FileLogger& logger);
 	PARAMETER_TYPE GetType() const;
-	bool IsEqual(const GLES2UniformParameter* other) const;
 };
 
 class GLES2UPVec3 : public GLES2UniformParameter
@@ -106,9 +128,9 @@ class GLES2UPVec3 : public GLES2UniformParameter
 	math::Vector3 v;
 public:
 	GLES2UPVec3(const math::Vector3& v, const str_type::string& shaderName, const str_type::string& parameterName);
+	void Set(const math::Vector3& v);
 	bool SetParameter(const GLuint program, const Platform::FileLogger& logger);
 	PARAMETER_TYPE GetType() const;
-	bool IsEqual(const GLES2UniformParameter* other) const;
 };
 
 class GLES2UPVec4 : public GLES2UniformParameter
@@ -116,9 +138,9 @@ class GLES2UPVec4 : public GLES2UniformParameter
 	math::Vector4 v;
 public:
 	GLES2UPVec4(const math::Vector4& v, const str_type::string& shaderName, const str_type::string& parameterName);
+	void Set(const math::Vector4& v);
 	bool SetParameter(const GLuint program, const Platform::FileLogger& logger);
 	PARAMETER_TYPE GetType() const;
-	bool IsEqual(const GLES2UniformParameter* other) const;
 };
 
 class GLES2UPMat4x4 : public GLES2UniformParameter
@@ -126,9 +148,9 @@ class GLES2UPMat4x4 : public GLES2UniformParameter
 	math::Matrix4x4 v;
 public:
 	GLES2UPMat4x4(const math::Matrix4x4& v, const str_type::string& shaderName, const str_type::string& parameterName);
+	void Set(const math::Matrix4x4& v);
 	bool SetParameter(const GLuint program, const Platform::FileLogger& logger);
 	PARAMETER_TYPE GetType() const;
-	bool IsEqual(const GLES2UniformParameter* other) const;
 };
 
 class GLES2UPTexture : public GLES2UniformParameter
@@ -138,20 +160,19 @@ class GLES2UPTexture : public GLES2UniformParameter
 	GLint unit;
 public:
 	GLES2UPTexture(const GLenum texturePass, GLuint texture, const GLint unit, const str_type::string& shaderName, const str_type::string& parameterName);
+	void Set(const GLenum texturePass, GLuint texture, const GLint unit);
 	bool SetParameter(const GLuint program, const Platform::FileLogger& logger);
 	PARAMETER_TYPE GetType() const;
-	bool IsEqual(const GLES2UniformParameter* other) const;
 };
 
 class GLES2UPVec2Array : public GLES2UniformParameter
 {
-	boost::shared_array<const math::Vector2> va;
-	GLsizei count;
+	std::vector<math::Vector2> va;
 public:
-	GLES2UPVec2Array(const boost::shared_array<const math::Vector2>& v, const unsigned int count, const str_type::string& shaderName, const str_type::string& parameterName);
+	GLES2UPVec2Array(const math::Vector2* v, const unsigned int count, const str_type::string& shaderName, const str_type::string& parameterName);
+	void Set(const math::Vector2* v, const unsigned int count);
 	bool SetParameter(const GLuint program, const Platform::FileLogger& logger);
 	PARAMETER_TYPE GetType() const;
-	bool IsEqual(const GLES2UniformParameter* other) const;
 };
 
 typedef boost::shared_ptr<GLES2UniformParameter> GLES2UniformParameterPtr;
@@ -151,6 +151,7 @@ bool GLES2Video::StartApplication(
 	m_optimalVS =    LoadInternalShader(this, "optimal.vs",    gs2dshaders::GLSL_default_optimal_vs, Shader::SF_VERTEX);
 	m_modulate1 =    LoadInternalShader(this, "modulate1.ps",  gs2dshaders::GLSL_default_modulate1_ps, Shader::SF_PIXEL);
 	m_add1 =         LoadInternalShader(this, "add1.ps",       gs2dshaders::GLSL_default_add1_ps, Shader::SF_PIXEL);
+	m_screenTrianglesVS = LoadInternalShader(this, "screenTriangles.vs", gs2dshaders::GLSL_default_screenTriangles_vs, Shader::SF_VERTEX);
 
 	// forces shader pre-load to avoid runtime lag
 	m_shaderContext->SetShader(m_defaultVS,		m_defaultPS, m_orthoMatrix, GetScreenSizeF());
@@ -159,6 +160,7 @@ bool GLES2Video::StartApplication(
 	m_shaderContext->SetShader(m_fastRenderVS,	m_defaultPS, m_orthoMatrix, GetScreenSizeF());
 	m_shaderContext->SetShader(m_optimalVS,		m_modulate1, m_orthoMatrix, GetScreenSizeF());
 	m_shaderContext->SetShader(m_optimalVS,		m_add1,      m_orthoMatrix, GetScreenSizeF());
+	m_shaderContext->SetShader(m_screenTrianglesVS, m_defaultPS, m_orthoMatrix, GetScreenSizeF());
 	m_shaderContext->SetShader(m_optimalVS,		m_defaultPS, m_orthoMatrix, GetScreenSizeF());
 
 	LogFragmentShaderMaximumPrecision(m_logger);
@@ -361,6 +363,11 @@ GLES2ShaderPtr GLES2Video::GetDefaultPS()
 	return m_defaultPS;
 }
 
+GLES2ShaderPtr GLES2Video::GetScreenTrianglesVS()
+{
+	return m_screenTrianglesVS;
+}
+
 ShaderPtr GLES2Video::GetPixelShader()
 {
 	return m_shaderContext->GetCurrentPS();
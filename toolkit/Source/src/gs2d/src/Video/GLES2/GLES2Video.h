@@ -132,6 +132,7 @@ public:
 	ShaderPtr GetVertexShader();
 
 	GLES2ShaderPtr GetDefaultPS();
+	GLES2ShaderPtr GetScreenTrianglesVS();
 
 	ShaderPtr GetPixelShader();
 	ShaderContextPtr GetShaderContext();
@@ -277,7 +278,7 @@ protected:
 	Platform::FileLogger m_logger;
 	GLES2ShaderContextPtr m_shaderContext;
 	GLES2ShaderPtr m_defaultVS, m_defaultPS,
-		m_fastRenderVS, m_optimalVS, m_modulate1, m_add1;
+		m_fastRenderVS, m_optimalVS, m_modulate1, m_add1, m_screenTrianglesVS;
 	math::Matrix4x4 m_orthoMatrix;
 	float m_fpsRate;
 
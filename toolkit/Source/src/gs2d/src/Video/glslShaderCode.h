@@ -12,6 +12,7 @@ GLSL/default/default.vs         ->     GLSL_default_default_vs
 GLSL/default/fastRender.vs      ->     GLSL_default_fastRender_vs
 GLSL/default/modulate1.ps       ->     GLSL_default_modulate1_ps
 GLSL/default/optimal.vs         ->     GLSL_default_optimal_vs
+GLSL/default/screenTriangles.vs ->     GLSL_default_screenTriangles_vs
 */
 
 namespace gs2dshaders {
@@ -227,6 +228,28 @@ const std::string GLSL_default_optimal_vs =
 "}\n" \
 "\n";
 
+const std::string GLSL_default_screenTriangles_vs = 
+"attribute vec4 vPosition;\n" \
+"attribute vec2 vTexCoord;\n" \
+"attribute vec4 vColor;\n" \
+"\n" \
+"varying vec4 v_color;\n" \
+"varying vec2 v_texCoord;\n" \
+"\n" \
+"uniform mat4 viewMatrix;\n" \
+"uniform vec2 screenSize;\n" \
+"\n" \
+"void main()\n" \
+"{\n" \
+"	vec4 newPos = vec4(vPosition.xyz, 1.0) - vec4(screenSize / 2.0, 0.0, 0.0);\n" \
+"	newPos *= vec4(1.0, -1.0, 1.0, 1.0);\n" \
+"	gl_Position = viewMatrix * newPos;\n" \
+"	gl_Position.z = vPosition.z;\n" \
+"	v_color = vColor.bgra;\n" \
+"	v_texCoord = vTexCoord;\n" \
+"}\n" \
+"\n";
+
 
 }
 
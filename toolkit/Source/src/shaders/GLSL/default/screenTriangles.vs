@@ -0,0 +1,19 @@
+attribute vec4 vPosition;
+attribute vec2 vTexCoord;
+attribute vec4 vColor;
+
+varying vec4 v_color;
+varying vec2 v_texCoord;
+
+uniform mat4 viewMatrix;
+uniform vec2 screenSize;
+
+void main()
+{
+	vec4 newPos = vec4(vPosition.xyz, 1.0) - vec4(screenSize / 2.0, 0.0, 0.0);
+	newPos *= vec4(1.0, -1.0, 1.0, 1.0);
+	gl_Position = viewMatrix * newPos;
+	gl_Position.z = vPosition.z;
+	v_color = vColor.bgra;
+	v_texCoord = vTexCoord;
+}